@@ -0,0 +1,302 @@
+#include "embeddedData.hpp"
+// Enum representation
+String META_Repr(AddressGenType val){
+  switch(val){
+    case AddressGenType_MEM : {
+      return String("AddressGenType_MEM");;
+    } break;
+    case AddressGenType_READ : {
+      return String("AddressGenType_READ");;
+    } break;
+    case AddressGenType_GEN : {
+      return String("AddressGenType_GEN");;
+    } break;
+  }
+  Assert(false);
+  return {};
+}
+String META_Repr(MergeModifier val){
+  switch(val){
+    case MergeModifier_NONE : {
+      return String("MergeModifier_NONE");;
+    } break;
+    case MergeModifier_NO_UNIT_MERGED : {
+      return String("MergeModifier_NO_UNIT_MERGED");;
+    } break;
+  }
+  Assert(false);
+  return {};
+}
+String META_Repr(ConstructType val){
+  switch(val){
+    case ConstructType_MODULE : {
+      return String("ConstructType_MODULE");;
+    } break;
+    case ConstructType_MERGE : {
+      return String("ConstructType_MERGE");;
+    } break;
+    case ConstructType_ITERATIVE : {
+      return String("ConstructType_ITERATIVE");;
+    } break;
+    case ConstructType_ADDRESSGEN : {
+      return String("ConstructType_ADDRESSGEN");;
+    } break;
+  }
+  Assert(false);
+  return {};
+}
+String META_Repr(VersatRegister val){
+  switch(val){
+    case VersatRegister_Control : {
+      return String("VersatRegister_Control");;
+    } break;
+    case VersatRegister_DmaInternalAddress : {
+      return String("VersatRegister_DmaInternalAddress");;
+    } break;
+    case VersatRegister_DmaExternalAddress : {
+      return String("VersatRegister_DmaExternalAddress");;
+    } break;
+    case VersatRegister_DmaTransferLength : {
+      return String("VersatRegister_DmaTransferLength");;
+    } break;
+    case VersatRegister_DmaControl : {
+      return String("VersatRegister_DmaControl");;
+    } break;
+    case VersatRegister_Debug : {
+      return String("VersatRegister_Debug");;
+    } break;
+    case VersatRegister_ProfileControl : {
+      return String("VersatRegister_ProfileControl");;
+    } break;
+    case VersatRegister_ProfileRunCount : {
+      return String("VersatRegister_ProfileRunCount");;
+    } break;
+    case VersatRegister_ProfileRunCount2 : {
+      return String("VersatRegister_ProfileRunCount2");;
+    } break;
+    case VersatRegister_ProfileCyclesSinceLastReset : {
+      return String("VersatRegister_ProfileCyclesSinceLastReset");;
+    } break;
+    case VersatRegister_ProfileCyclesSinceLastReset2 : {
+      return String("VersatRegister_ProfileCyclesSinceLastReset2");;
+    } break;
+    case VersatRegister_ProfileRunningCycles : {
+      return String("VersatRegister_ProfileRunningCycles");;
+    } break;
+    case VersatRegister_ProfileRunningCycles2 : {
+      return String("VersatRegister_ProfileRunningCycles2");;
+    } break;
+    case VersatRegister_ProfileDatabusValid : {
+      return String("VersatRegister_ProfileDatabusValid");;
+    } break;
+    case VersatRegister_ProfileDatabusValid2 : {
+      return String("VersatRegister_ProfileDatabusValid2");;
+    } break;
+    case VersatRegister_ProfileDatabusValidAndReady : {
+      return String("VersatRegister_ProfileDatabusValidAndReady");;
+    } break;
+    case VersatRegister_ProfileDatabusValidAndReady2 : {
+      return String("VersatRegister_ProfileDatabusValidAndReady2");;
+    } break;
+    case VersatRegister_ProfileConfigurationsSet : {
+      return String("VersatRegister_ProfileConfigurationsSet");;
+    } break;
+    case VersatRegister_ProfileConfigurationsSet2 : {
+      return String("VersatRegister_ProfileConfigurationsSet2");;
+    } break;
+    case VersatRegister_ProfileConfigurationsSetWhileRunning : {
+      return String("VersatRegister_ProfileConfigurationsSetWhileRunning");;
+    } break;
+    case VersatRegister_ProfileConfigurationsSetWhileRunning2 : {
+      return String("VersatRegister_ProfileConfigurationsSetWhileRunning2");;
+    } break;
+  }
+  Assert(false);
+  return {};
+}
+// Raw c array auxiliary to Struct data
+static String AddressGenBaseParameters_MemberNames[] = {String("start"),String("duty"),String("per"),String("incr"),String("iter"),String("shift")};
+static String AddressVParameters_MemberNames[] = {String("ext_addr"),String("length"),String("amount_minus_one"),String("extra_delay"),String("addr_shift"),String("enabled"),String("pingPong"),String("start"),String("duty"),String("per"),String("incr"),String("iter"),String("shift")};
+static String AddressMemParameters_MemberNames[] = {String("iterA"),String("perA"),String("dutyA"),String("startA"),String("shiftA"),String("incrA"),String("reverseA"),String("extA"),String("in0_wr"),String("iterB"),String("perB"),String("dutyB"),String("startB"),String("shiftB"),String("incrB"),String("reverseB"),String("extB"),String("in1_wr")};
+// Struct data
+Array<String> META_AddressGenBaseParameters_Members = {AddressGenBaseParameters_MemberNames,ARRAY_SIZE(AddressGenBaseParameters_MemberNames)};
+Array<String> META_AddressVParameters_Members = {AddressVParameters_MemberNames,ARRAY_SIZE(AddressVParameters_MemberNames)};
+Array<String> META_AddressMemParameters_Members = {AddressMemParameters_MemberNames,ARRAY_SIZE(AddressMemParameters_MemberNames)};
+// Raw C array auxiliary to tables
+String AddressGenWireNames_names_aux0[] = {String("iterA"),String("perA"),String("dutyA"),String("startA"),String("shiftA"),String("incrA"),String("reverseA"),String("extA"),String("in0_wr"),String("iterB"),String("perB"),String("dutyB"),String("startB"),String("shiftB"),String("incrB"),String("reverseB"),String("extB"),String("in1_wr")};
+String AddressGenWireNames_names_aux1[] = {String("start"),String("duty"),String("per"),String("incr"),String("iter"),String("shift")};
+String AddressGenWireNames_names_aux2[] = {String("ext_addr"),String("length"),String("amount_minus_one"),String("extra_delay"),String("addr_shift"),String("enabled"),String("pingPong"),String("start"),String("duty"),String("per"),String("incr"),String("iter"),String("shift")};
+// Raw C array Arrays
+static String AddressGenExtraFormat_Raw[] = {String("per%d"),String("incr%d"),String("iter%d"),String("shift%d")};
+Array<String> AddressGenExtraFormat = {AddressGenExtraFormat_Raw,ARRAY_SIZE(AddressGenExtraFormat_Raw)};
+static String AddressGenMemExtraFormat_Raw[] = {String("per%dA"),String("incr%dA"),String("iter%dA"),String("shift%dA"),String("per%dB"),String("incr%dB"),String("iter%dB"),String("shift%dB")};
+Array<String> AddressGenMemExtraFormat = {AddressGenMemExtraFormat_Raw,ARRAY_SIZE(AddressGenMemExtraFormat_Raw)};
+// Raw C array Tables
+static AddressGenWireNames_GenType AddressGenWireNames_Raw[] = {  {AddressGenType_MEM,  {AddressGenWireNames_names_aux0,ARRAY_SIZE(AddressGenWireNames_names_aux0)}},  {AddressGenType_GEN,  {AddressGenWireNames_names_aux1,ARRAY_SIZE(AddressGenWireNames_names_aux1)}},  {AddressGenType_READ,  {AddressGenWireNames_names_aux2,ARRAY_SIZE(AddressGenWireNames_names_aux2)}}};
+static ProfilingVersatRegisters_GenType ProfilingVersatRegisters_Raw[] = {  {VersatRegister_ProfileControl},  {VersatRegister_ProfileRunCount},  {VersatRegister_ProfileRunCount2},  {VersatRegister_ProfileCyclesSinceLastReset},  {VersatRegister_ProfileCyclesSinceLastReset2},  {VersatRegister_ProfileRunningCycles},  {VersatRegister_ProfileRunningCycles2},  {VersatRegister_ProfileDatabusValid},  {VersatRegister_ProfileDatabusValid2},  {VersatRegister_ProfileDatabusValidAndReady},  {VersatRegister_ProfileDatabusValidAndReady2},  {VersatRegister_ProfileConfigurationsSet},  {VersatRegister_ProfileConfigurationsSet2},  {VersatRegister_ProfileConfigurationsSetWhileRunning},  {VersatRegister_ProfileConfigurationsSetWhileRunning2}};
+// Tables
+Array<AddressGenWireNames_GenType> AddressGenWireNames = {AddressGenWireNames_Raw,ARRAY_SIZE(AddressGenWireNames_Raw)};
+Array<ProfilingVersatRegisters_GenType> ProfilingVersatRegisters = {ProfilingVersatRegisters_Raw,ARRAY_SIZE(ProfilingVersatRegisters_Raw)};
+// Define Maps arrays
+static String possibleAttributes_Raw[] = {VERSAT_LATENCY,VERSAT_STATIC,VERSAT_STAGE};
+Array<String> possibleAttributes = {possibleAttributes_Raw,ARRAY_SIZE(possibleAttributes_Raw)};
+// Normal Maps
+Opt<String> META_addressGenType_Map(AddressGenType val){
+  switch(val){
+    case AddressGenType_MEM : {
+      return String("Mem");
+    } break;
+    case AddressGenType_READ : {
+      return String("Read");
+    } break;
+    case AddressGenType_GEN : {
+      return String("Gen");
+    } break;
+  }
+  return {};
+}
+Opt<AddressGenType> META_addressGenType_ReverseMap(String val){
+  if(val == String("Mem")){
+    return AddressGenType_MEM;
+  } 
+  if(val == String("Read")){
+    return AddressGenType_READ;
+  } 
+  if(val == String("Gen")){
+    return AddressGenType_GEN;
+  } 
+  return {};
+}
+Opt<String> META_mergeModifiers_Map(MergeModifier val){
+  switch(val){
+    case MergeModifier_NO_UNIT_MERGED : {
+      return String("NoUnitMerged");
+    } break;
+  }
+  return {};
+}
+Opt<MergeModifier> META_mergeModifiers_ReverseMap(String val){
+  if(val == String("NoUnitMerged")){
+    return MergeModifier_NO_UNIT_MERGED;
+  } 
+  return {};
+}
+// Embedded Files
+String META_ExtractVerilatedSignals_Content = {String("#!/usr/bin/env python3\n\nimport sys\n\ncontent = None\nwith open(sys.argv[1],\"r\") as file:\n   content = file.readlines()\n\nprint(f\"#pragma once\")\nfor line in content:\n   if(not \"VL\" in line):\n      continue\n\n   splitted = line.split(\"(\")\n   if(len(splitted) < 2):\n      continue\n\n   splitted2 = splitted[1].split(')')\n   if(len(splitted2) < 2):\n      continue\n\n   VLType = splitted[0].strip()\n   argTotal = splitted2[0].split(',')\n\n   # Needs to have at least name, msb and lsb\n   if(len(argTotal) < 3):\n      continue\n\n   namePtr = argTotal[0]\n\n   if(namePtr[0] != '&'):\n      continue\n\n   name = namePtr[1:]\n   msb = argTotal[1]\n   lsb = argTotal[2]\n\n   print(f\"#define UNIT_MSB_{name} {msb}\")\n   print(f\"#define UNIT_LSB_{name} {lsb}\")\n")};
+String META_GetVerilatorRoot_Content = {String("#!/bin/bash\nTEMP_DIR=$(mktemp -d)\n\npushd $TEMP_DIR &> /dev/null\n\necho \"module Test(); endmodule\" > Test.v\nverilator --cc Test.v &> /dev/null\n\npushd ./obj_dir &> /dev/null\nVERILATOR_ROOT=$(awk '\"VERILATOR_ROOT\" == $1 { print $3}' VTest.mk)\nrm -r $TEMP_DIR\n\necho $VERILATOR_ROOT")};
+String META_HeaderTemplate_Content = {String("// This file has been auto-generated\n\n#ifndef INCLUDED_VERSAT_ACCELERATOR_HEADER\n#define INCLUDED_VERSAT_ACCELERATOR_HEADER\n\n#ifdef __cplusplus\n#include <cstdint>\n#else\n#include \"stdbool.h\"\n#include \"stdint.h\"\n#endif\n\ntypedef intptr_t iptr;\n\n// Config\n@{configStructs}\n\n// State\n@{stateStructs}\n\n@{acceleratorState}\n\n// Address\n@{addrStructs}\n\n@{acceleratorConfig}\n\n@{acceleratorStatic}\n\n@{acceleratorDelay}\n\n// NOTE: The address for memory mapped units depends on the address of\n//       the accelerator.  Because of this, the full address can only\n//       be calculated after calling versat_init(iptr), which is the\n//       function that sets the versat_base variable.  It is for this\n//       reason that the address info for every unit is a define. Addr\n//       variables must be instantiated only after calling\n//       versat_init.\n\n// Base address for each memory mapped unit\n\n@{memMappedAddresses}\n\nextern iptr versat_base;\n\n#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n// Always call first before calling any other function.\nvoid versat_init(int base);\n\n// Versat runtime does not provide any output unless provided with a printf like function by the user.\ntypedef int (*VersatPrintf)(const char* format,...);\nvoid SetVersatDebugPrintfFunction(VersatPrintf function);\n\n// In pc-emul provides a low bound on performance.\n// In sim-run refines the lower bound but still likely to be smaller than reality due to memory delays that are only present in real circuits.\nint GetAcceleratorCyclesElapsed();\n\nvoid RunAccelerator(int times); // Runs accelerator n times and waits for it to finish before ending. Mostly used to flush the final computations and for simple invocations\nvoid StartAccelerator(); // Also waits for previous run to end if accelerator is still running\nvoid EndAccelerator(); // Ensure the accelerator as finished running\nvoid ResetAccelerator();\n\n// Runs the accelerator once for each configuration and stores the state it ends with. The accelerator is left with the configuration of the last run.\n// Precondition: runs must be independent, no run can read memory written by another run of the batch. pc-emul runs them in worker processes forked at the call or, when it cannot fork, one after the other like embedded. Memory written by the units is only seen by the caller in the latter case, so it must be treated as undefined after the call\nvoid VersatRunBatch(const @{typeName}Config* configs,@{typeName}State* states,int amount);\nvoid ConfigBatchWorkers(int workers); // Processes used by VersatRunBatch in pc-emul, zero (default) uses one per processor\n\n// Fast data movement using internal Versat DMA if possible, otherwise regular memcpy style functions\nvoid VersatMemoryCopy(volatile void* dest,volatile const void* data,int byteSize);\nvoid VersatUnitWrite(volatile const void* baseaddr,int index,int val);\nint VersatUnitRead(volatile const void* baseaddr,int index);\nfloat VersatUnitReadFloat(volatile const void* baseaddr,int index);\n\nvoid SignalLoop();\nvoid VersatLoadDelay(volatile const unsigned int* delayBuffer);\n\n// ======================================\n// Debug facilities\n\n// TODO: Only generate this if the flag is set.\n\ntypedef struct{\n  bool databusIsActive;\n} VersatDebugState;\n\ntypedef struct{\n  uint64_t runCount;\n  uint64_t cyclesSinceLastReset;\n  uint64_t runningCycles;\n  uint64_t databusValid;\n  uint64_t databusValidAndReady;\n  uint64_t configurationsSet;\n  uint64_t configurationsSetWhileRunning;\n} VersatProfile;\n\n// Databus usage of a single unit interface. Only pc-emul tracks these, embedded reports no interfaces\ntypedef struct{\n  const char* unitName;\n  uint64_t databusValid;\n  uint64_t databusValidAndReady;\n  uint64_t bytesTransferred;\n} VersatDatabusProfile;\n\nvoid             DebugRunAccelerator(int times, int maxCycles); // Mainly for cases where the accelerator is hanging, we put a upper bound in the amount of cycles that we wait for.\nVersatDebugState VersatDebugGetState();\nVersatProfile    VersatProfileGet();\nvoid             VersatProfileReset();\nvoid             VersatPrintProfile(VersatProfile profile);\n\nint                  VersatProfileDatabusInterfaces();\nVersatDatabusProfile VersatProfileGetDatabus(int index);\n\n// PC-Emul side functions that allow to enable or disable certain portions of the emulation\n// Their embedded counterparts simply do nothing\nvoid ConfigEnableDMA(bool value);\nvoid ConfigCreateVCD(bool value);\nvoid ConfigAsyncAccelerator(bool value); // StartAccelerator returns right away and a background thread simulates the run until EndAccelerator, like in hardware. Firmware accesses to the accelerator are interleaved with its cycles\nvoid ConfigSimulateDatabus(bool value); \nvoid ConfigCrossCheckAddressGen(bool value); // Simulate functions also run the Verilated SuperAddress unit and report any difference\n\n// Timing of the memory behind the databus when it is simulated. Disabled by default, in which case every unit gets one transfer per cycle as soon as it asks\ntypedef struct{\n  bool enabled;\n  int burstLatency; // Cycles from a burst being issued to its first transfer\n  int cyclesPerBeat; // Shared bandwidth, cycles between transfers of the data bus\n  int maxOutstanding; // Bursts in flight at once for reads and for writes (max 16)\n  bool halfDuplex; // Reads and writes share the data bus, like DRAM, instead of having separate channels like AXI\n  int banks; // Zero disables the bank and row model (max 64)\n  int rowBytes;\n  int rowHitLatency; // Added to burstLatency when the row of the bank is open\n  int rowMissLatency; // Added to burstLatency when the bank must open another row\n} VersatMemoryModel;\n\nvoid ConfigMemoryModel(VersatMemoryModel model);\nVersatMemoryModel VersatTypicalMemoryModel(); // Rough values for a DDR memory behind an AXI interconnect\n\n// Waveform capture windows (only when the model was verilated with trace enabled). Every cycle is traced by default, each window set only keeps the cycles inside it\nvoid ConfigTraceCycles(int start,int end); // Trace cycles in [start,end), negative end means until the end\nvoid ConfigTraceRuns(int first,int end); // Trace from the start of accelerator run first (zero based) until the start of run end, negative end means until the end\nbool ConfigTraceTrigger(const char* expression,int cycles); // \"signal\" or \"signal op value\" (op: == != < <= > >=) on a top level signal. Traces cycles after it first holds, negative cycles means until the end. Returns false if the expression is invalid\nvoid ConfigTraceRing(int cycles); // Only keep the last traced cycles (at least cycles of them). They are split in data only segments that must be appended to the first file, which holds the header. The files are reported when the program exits\n\n@{AddressStruct}\n\n// PC-Emul side function only that allow us to simulate what addresses a V unit would access, instead of having to run the accelerator and having to inspect the VCD file, we can simulate it at pc-emul.\ntypedef struct{\n  int amountOfExternalValuesRead;\n  int amountOfInternalValuesUsed; // Repeated values are only counted once. The VRead is simulated in order to calculate this.\n} SimulateVReadResult;\n\nint SimulateAddressGen(iptr* arrayToFill,int arraySize,AddressVArguments args);\nSimulateVReadResult SimulateVRead(AddressVArguments args);\nvoid SimulateAndPrintAddressGen(AddressVArguments args);\n\n#ifdef __cplusplus\n} // extern \"C\"\n#endif\n\n// These value must match the same parameter used to instantiate the Versat hardware unit.\n// Bad things will happen if a mismatch occurs\n#ifndef VERSAT_AXI_DATA_W\n  #define VERSAT_AXI_DATA_W @{databusDataSize}\n#endif\n#ifndef VERSAT_DATA_W\n  #define VERSAT_DATA_W 32 // TODO: Techically Versat could support non 32 datapaths, but no attempt or test has been performed. It will most likely fail, especially the units which almost always expect 32 bits.\n#endif\n\n#define VERSAT_DIFF_W (VERSAT_AXI_DATA_W / VERSAT_DATA_W)\n\n// Needed by PC-EMUL to correctly simulate the design, embedded compiler should remove these symbols from firmware because not used by them \nstatic const char* acceleratorTypeName = \"@{typeName}\";\nstatic bool isSimpleAccelerator = @{isSimple};\nstatic bool acceleratorSupportsDMA = @{useDMA};\n\nstatic const int memMappedStart = @{memMappedStart};\nstatic const int versatAddressSpace = @{versatAddressSpace};\n\n#define ACCELERATOR_TOP_ADDR_INIT @{addrBlock}\nstatic unsigned int delayBuffer[] = @{delayBlock};\nstatic AcceleratorDelay accelDelay = @{delayBlock};\n\nstatic const int staticStart = @{staticStart} * sizeof(iptr);\nstatic const int delayStart = @{delayStart} * sizeof(iptr);\nstatic const int configStart = @{configStart} * sizeof(iptr);\nstatic const int stateStart = @{stateStart} * sizeof(int);\n\nstatic const unsigned int AcceleratorConfigSize = sizeof(@{typeName}Config);\n\nextern volatile @{typeName}Config* accelConfig; // @{nConfigs}\nextern volatile @{typeName}State* accelState; // @{nStates}\n\nstatic inline iptr ALIGN(iptr base,iptr alignment){\n  // TODO: Because alignment is power of 2 (unless we want to support weird AXI_DATA_W values), we can use a faster implementation here.\n  iptr diff = base % alignment;\n  if(diff == 0){\n    return base;\n  }\n\n  iptr result = (base - diff + alignment);\n  return result;\n}\n\n// Same as ALIGN but usable inside constant initializers (precomputed address gen configurations)\n#define VERSAT_ALIGN(base,alignment) ((((base) + (alignment) - 1) / (alignment)) * (alignment))\n\n// Bus cycles lost per AXI burst (address handshake and read latency)\n#ifndef VERSAT_AXI_BURST_OVERHEAD\n  #define VERSAT_AXI_BURST_OVERHEAD 8\n#endif\n\n// Predicted bus cycles of an external access made of amount transfers of lengthBytes each. Bursts contain at most 256 beats and never cross a 4KB boundary. Used to choose between the single and double loop versions of an address gen.\nstatic inline iptr VersatExternalAccessCost(iptr lengthBytes,iptr amount){\n  iptr beatBytes = VERSAT_AXI_DATA_W / 8;\n  iptr maxBurstBytes = (256 * beatBytes < 4096) ? 256 * beatBytes : 4096;\n\n  iptr beats = (lengthBytes + beatBytes - 1) / beatBytes;\n  iptr bursts = (lengthBytes + maxBurstBytes - 1) / maxBurstBytes;\n\n  return amount * (bursts * VERSAT_AXI_BURST_OVERHEAD + beats);\n}\n\nextern volatile AcceleratorStatic* accelStatic;\n\n@{allStaticDefines}\n\n@{simpleStuff}\n\n@{mergeStuff}\n\nstatic bool forceDoubleLoop = false;\nstatic bool forceSingleLoop = false;\n\n@{allAddrGen}\n\n#endif // INCLUDED_VERSAT_ACCELERATOR_HEADER\n\n")};
+String META_MakefileTemplate_Content = {String("TYPE_NAME := @{typeName}\n\nVSIM_HEADER := @{simLoopHeader}\nHARDWARE_FOLDER := @{hardwareFolder}\nVHEADER := V$(TYPE_NAME).h pcEmulDefs.h\nSOFTWARE_FOLDER := .\nHARDWARE_SRC := @{hardwareUnits}\nHARDWARE_SRC += @{moduleUnits}\nVERILATOR_ROOT?=$(shell ./GetVerilatorRoot.sh)\nINCLUDE := -I$(HARDWARE_FOLDER)\n\n# Build acceleration, defaults given by the versat --verilator-* flags.\n# Link with -pthread, the wrapper simulates asynchronous runs in a thread and so do multithreaded models (VERILATOR_THREADS > 1).\nVERILATOR_THREADS ?= @{verilatorThreads}\nBUILD_JOBS ?= @{buildJobs}\nOUTPUT_SPLIT ?= @{outputSplit}\nCCACHE ?= @{ccache}\nOPT_FLAGS ?= @{optimizationFlags}\nBENCHMARK_CYCLES ?= 1000000\n\n# Profile guided optimization stage, set by the pgo.stamp target (generate or use)\nPGO ?=\nPGO_DIR := $(abspath ./pgo_data)\nifeq ($(PGO),generate)\nPGO_FLAGS := -fprofile-generate=$(PGO_DIR)\nendif\nifeq ($(PGO),use)\nPGO_FLAGS := -fprofile-use=$(PGO_DIR) -fprofile-partial-training -Wno-missing-profile\nendif\n\nCXX_FLAGS := -march=native $(OPT_FLAGS) $(PGO_FLAGS)\n\nVERILATOR_COMMON_ARGS := --report-unoptflat -GLEN_W=20 -CFLAGS \"$(CXX_FLAGS)\" $(INCLUDE)\nVERILATOR_COMMON_ARGS += -GAXI_ADDR_W=$(shell getconf LONG_BIT)\nVERILATOR_COMMON_ARGS += -GAXI_DATA_W=@{databusDataSize}\nVERILATOR_COMMON_ARGS += -GDATA_W=32\nVERILATOR_COMMON_ARGS += -GDELAY_W=20\nVERILATOR_COMMON_ARGS += -GLEN_W=20\nVERILATOR_COMMON_ARGS += @{traceType}\n\nifneq ($(OUTPUT_SPLIT),0)\nVERILATOR_COMMON_ARGS += --output-split $(OUTPUT_SPLIT) --output-split-cfuncs $(OUTPUT_SPLIT)\nendif\n\nVERILATOR_SUPERADDRESS_ARGS := $(filter-out -GAXI_DATA_W=%, $(VERILATOR_COMMON_ARGS))\n\n# Only the accelerator model is big enough to gain from threads and profiling\nVERILATOR_TOP_ARGS :=\nifneq ($(VERILATOR_THREADS),1)\nVERILATOR_TOP_ARGS += --threads $(VERILATOR_THREADS)\nendif\nifeq ($(PGO),generate)\nVERILATOR_TOP_ARGS += --prof-pgo\nendif\nifeq ($(PGO),use)\nVERILATOR_TOP_ARGS += $(wildcard profile.vlt)\nendif\n\n# Verilator generated makefiles compile with OPT_FAST/OPT_SLOW/OPT_GLOBAL and prefix the compiler with OBJCACHE\nVERILATOR_MAKE_ARGS := -j$(BUILD_JOBS) OBJCACHE=\"$(CCACHE)\" OPT_FAST=\"$(OPT_FLAGS)\" OPT_SLOW=\"$(OPT_FLAGS)\" OPT_GLOBAL=\"$(OPT_FLAGS)\"\n\nall: @{defaultTarget}\n\n# Joins wrapper with verilator object files into a library\nlibaccel.a: $(VHEADER) wrapper.o createVerilatorObjects $(VSIM_HEADER)\n\tar -rcs libaccel.a wrapper.o $(wildcard ./obj_dir/*.o)\n\ncreateVerilatorObjects: $(VHEADER) wrapper.o $(VSIM_HEADER)\n\t$(MAKE) verilatorObjects\n\nVUnitWireInfo.h: $(VHEADER)\n\t./ExtractVerilatedSignals.py $(VHEADER) > VUnitWireInfo.h\n\n$(VHEADER): $(HARDWARE_SRC)\n\tverilator $(VERILATOR_COMMON_ARGS) $(VERILATOR_TOP_ARGS) -GADDR_W=@{addressSize} --cc $(HARDWARE_SRC) --top-module $(TYPE_NAME)\n\t$(MAKE) $(VERILATOR_MAKE_ARGS) -C ./obj_dir -f V$(TYPE_NAME).mk\n\tcp ./obj_dir/*.h ./\n\nVSuperAddress.h: $(HARDWARE_SRC)\n\tverilator $(VERILATOR_SUPERADDRESS_ARGS) -GADDR_W=32 --cc $(HARDWARE_FOLDER)/SuperAddress.v --top-module SuperAddress\n\t$(MAKE) $(VERILATOR_MAKE_ARGS) -C ./obj_dir -f VSuperAddress.mk\n\tcp ./obj_dir/*.h ./\n\nwrapper.o: $(VHEADER) VUnitWireInfo.h wrapper.cpp $(VSIM_HEADER)\n\t$(CCACHE) g++ -std=c++17 $(CXX_FLAGS) -g -c -o wrapper.o -I $(VERILATOR_ROOT)/include $(abspath wrapper.cpp)\n\n# Created after calling verilator. Need to recall make to have access to the variables\n-include ./obj_dir/V$(TYPE_NAME)_classes.mk\n\nVERILATOR_SOURCE_DIR:=$(VERILATOR_ROOT)/include\nALL_VERILATOR_FILES:=$(VM_GLOBAL_FAST) $(VM_GLOBAL_SLOW)\nifneq ($(VERILATOR_THREADS),1)\nALL_VERILATOR_FILES:=$(sort $(ALL_VERILATOR_FILES) verilated_threads)\nendif\nALL_VERILATOR_O:=$(patsubst %,./obj_dir/%.o,$(ALL_VERILATOR_FILES))\n\n./obj_dir/%.o: $(VERILATOR_SOURCE_DIR)/%.cpp\n\t$(CCACHE) g++ -w $(CXX_FLAGS) -c -o $@ $< -I$(VERILATOR_ROOT)/include\n\nverilatorObjects: $(ALL_VERILATOR_O)\n\n# Runs the accelerator model on its own, without firmware, and reports the simulated cycles per second\nbenchmark: versat_benchmark\n\t./versat_benchmark $(BENCHMARK_CYCLES)\n\nversat_benchmark: libaccel.a\n\t$(CCACHE) g++ -std=c++17 $(CXX_FLAGS) -g -DVERSAT_BENCHMARK -o versat_benchmark -I $(VERILATOR_ROOT)/include $(abspath wrapper.cpp) $(wildcard ./obj_dir/*.o) -pthread\n\n# Profile guided build: an instrumented model is trained by the benchmark and then rebuilt using the profile.\n# Verilator uses the profile (profile.vlt) to balance threads and g++ uses it (PGO_DIR) to optimize the code.\npgo.stamp: $(HARDWARE_SRC) wrapper.cpp\n\t$(MAKE) clean-build\n\trm -rf $(PGO_DIR) profile.vlt\n\t$(MAKE) PGO=generate benchmark\n\t$(MAKE) clean-build\n\t$(MAKE) PGO=use libaccel.a\n\ttouch pgo.stamp\n\npgo:\n\trm -f pgo.stamp\n\t$(MAKE) pgo.stamp\n\nclean-build:\n\trm -rf ./obj_dir wrapper.o libaccel.a versat_benchmark V$(TYPE_NAME).h VSuperAddress.h VUnitWireInfo.h\n\n.PHONY: all createVerilatorObjects verilatorObjects benchmark pgo clean-build\n")};
+String META_TopInstanceTemplate_Content = {String("`timescale 1ns / 1ps\n\n`include \"versat_defs.vh\"\n\nmodule versat_instance #(\n      parameter ADDR_W = 32,\n      parameter DATA_W = 32,\n      parameter AXI_ADDR_W = 32,\n      parameter AXI_DATA_W = @{databusDataSize},\n      parameter LEN_W = 20,\n      parameter DELAY_W = 10\n   )\n   (\n   // Databus master interface\n`ifdef VERSAT_IO\n   input  [`nIO-1:0]                m_databus_ready,\n   output [`nIO-1:0]                m_databus_valid,\n   output [`nIO*AXI_ADDR_W-1:0]     m_databus_addr,\n   input  [AXI_DATA_W-1:0]          m_databus_rdata,\n   output [`nIO*AXI_DATA_W-1:0]     m_databus_wdata,\n   output [`nIO*(AXI_DATA_W/8)-1:0] m_databus_wstrb,\n   output [`nIO*LEN_W-1:0]          m_databus_len,\n   input  [`nIO-1:0]                m_databus_last,\n`endif\n\n// data/control interface\n   input                           csr_valid,\n   input [ADDR_W-1:0]              csr_addr,\n   input [DATA_W/8-1:0]            csr_wstrb,\n   input [DATA_W-1:0]              csr_wdata,\n   output                          csr_rvalid,\n   output reg [DATA_W-1:0]         csr_rdata,\n\n@{externalMemPorts}\n\n@{inAndOuts}\n\n   input                           clk,\n   input                           rst\n   );\n\n@{wireDecls}\n\n// This interface is the result of joining the csr or the dma interface\n// Any logic that can interact with the DMA must use this interface.\nwire data_valid;\nwire [ADDR_W-1:0] data_address;\nwire [DATA_W-1:0] data_data;\nwire [(DATA_W/8)-1:0] data_wstrb;\n\nreg running;\n\nreg [DATA_W-1:0] stateRead;\n\nwire we = (|csr_wstrb);\nwire memoryMappedAddr = @{memoryConfigDecisionExpr};\n\n// Versat registers and memory access\nreg versat_rvalid;\nreg [DATA_W-1:0] versat_rdata;\n\nreg soft_reset,signal_loop; // Self resetting \n\nwire done = &unitDone;\nwire canRun = done;\nwire rst_int = (rst | soft_reset);\n\nreg startRunPulse;\nreg run;\n\nwire pre_run_pulse = canRun && startRunPulse;\n\nalways @(posedge clk,posedge rst)\nbegin\n   if(rst) begin\n       run <= 0;\n   end else if(pre_run_pulse) begin\n       run <= 1'b1;\n   end else begin\n       run <= 1'b0;\n   end\nend\n\nwire dma_running; // TODO: Emit this only if we have DMA enabled.\n\n@{emitIO}\n\nalways @(posedge clk,posedge rst)\nbegin\n   if(rst) begin\n      running <= 0;\n   end else if(run) begin\n      running <= 1;\n   end else if(running && done) begin\n      running <= 0;\n   end\nend\n\n@{dmaInstantiation}\n\n@{profilingStuff}\n\n// Control interface write portion\n@{controlWriteInterface}\n\n// Control interface read portion\n@{controlReadInterface}\n\n@{unitsMappedDecl}\n\n@{connections}\n\n@{configurationDecl}\n\n@{stateDecl}\n\n@{combOperations}\n\n@{instanciateUnits}\n\n@{assignOuts}\n\nendmodule\n\n`include \"versat_undefs.vh\"\n")};
+String META_WrapperTemplate_Content = {String("// File generated by template engine for the versat_wrapper.tpl template\n// Do not make changes, versat will overwrite\n\n#include <new>\n\n#include <cstdint>\n#include <cstdio>\n#include <cassert>\n#include <atomic>\n#include <mutex>\n#include <thread>\n#define Assert(x) assert(x)\n\n#include \"versat_accel.h\" // TODO: Is this needed? We technically have all the data that we need to not depend on this header and removing this dependency could simplify the build process. Take a look later\n\n#define ALIGN_UP(val,size) (((val) + (size - 1)) & ~(size - 1))\n#define ALIGN_DOWN(val,size) (val & (~(size - 1)))\n\n#include \"verilated.h\"\n\n// Needed to obtain the wire size of the unit from the verilated code.\n// Since the verilated code is an \"instantiation\" of the unit, we do not have to bother with the possibility of wire not being concrete (because they depend on parameters). We can just use the values directly.\n#include \"VUnitWireInfo.h\"\n#include \"pcEmulDefs.h\"\n\n@{defines}\n\n@{memoryWireInfo}\n\ninline void CopyFromMemory(void* output,void* memory,int address,int memoryDataSize){\n   char* memoryAsChar = (char*) memory;\n   int trueAddress = ALIGN_DOWN(address,memoryDataSize);\n\n   // TODO: Check if we are not writing/reading outside the boundary\n   //Assert(trueAddress <= );\n   memcpy(output,&memoryAsChar[trueAddress],memoryDataSize);\n};\n\ninline void CopyToMemory(void* input,void* memory,int address,int memoryDataSize){\n   char* memoryAsChar = (char*) memory;\n   int trueAddress = ALIGN_DOWN(address,memoryDataSize);\n   \n   // TODO: Check if we are not writing/reading outside the boundary\n   memcpy(&memoryAsChar[trueAddress],input,memoryDataSize);\n}\n\n#ifdef TRACE\n\nVerilatedContext* contextp = new VerilatedContext;\n\n#ifdef TRACE_FST\n#include \"verilated_fst_c.h\"\nstatic VerilatedFstC* tfp = NULL;\n#else\n#include \"verilated_vcd_c.h\"\nstatic VerilatedVcdC* tfp = NULL;\n#endif\n\n#endif // TRACE\n\n#include \"V@{typeName}.h\"\n#ifdef SIMULATE_LOOPS\n#include \"VSuperAddress.h\"\n#endif\n\ntemplate<typename T>\nclass ArrayIterator{\npublic:\n   T* ptr;\n\n   inline bool operator!=(const ArrayIterator<T>& iter){return ptr != iter.ptr;};\n   inline ArrayIterator<T>& operator++(){++ptr; return *this;};\n   inline T& operator*(){return *ptr;};\n};\n\ntemplate<typename T>\nstruct Array{\n  T* data;\n  int size;\n\n  inline T& operator[](int index) const {Assert(index >= 0);Assert(index < size); return data[index];}\n  ArrayIterator<T> begin() const{return ArrayIterator<T>{data};};\n  ArrayIterator<T> end() const{return ArrayIterator<T>{data + size};};\n};\n\nstruct DatabusAccess{\n   int counter;\n   int latencyCounter;\n   bool beatAllowed; // Set by the memory model every cycle\n};\n\nstruct DatabusRequest{\n   bool valid;\n   bool write;\n   iptr address;\n};\n\n// ============================================================================\n// Global data \n\nstatic V@{typeName}* dut = NULL;\n\nVersatPrintf versatPrintf;\nbool CreateVCD;\nbool SimulateDatabus;\nbool CrossCheckAddressGen;\nbool versatInitialized;\n\nstatic @{typeName}Config configBuffer = {};\nstatic @{typeName}State stateBuffer = {};\nstatic AcceleratorStatic staticBuffer = {};\nstatic DatabusAccess databusBuffer[@{nIOs}] = {}; \n\nvolatile @{typeName}Config* accelConfig = (volatile @{typeName}Config*) &configBuffer;\nvolatile @{typeName}State* accelState = (volatile @{typeName}State*) &stateBuffer;\nvolatile AcceleratorStatic* accelStatic = (volatile AcceleratorStatic*) &staticBuffer;\n\nstatic int cyclesDone = 0;\nstatic int runsStarted = 0;\n\n// Profiling counters, equivalent to the registers inserted by --profile but computed from the simulation\nstatic VersatProfile profile = {};\nstatic VersatDatabusProfile databusProfile[@{nIOs}] = {};\nstatic iptr configSnapshot[sizeof(configBuffer) / sizeof(iptr)] = {};\n\n@{databusOwners}\n\n// Asynchronous runs (ConfigAsyncAccelerator) are simulated by simThread, which holds simMutex while it simulates and hands it over in between cycles whenever the firmware is waiting to access the model\nstatic bool asyncAccelerator = false;\nstatic std::thread* simThread = NULL;\nstatic std::mutex simMutex;\nstatic std::atomic<int> firmwareWaiting(0);\n\nstruct FirmwareAccess{\n  FirmwareAccess(){\n    firmwareWaiting += 1;\n    simMutex.lock();\n    firmwareWaiting -= 1;\n  }\n  ~FirmwareAccess(){\n    simMutex.unlock();\n  }\n};\n\n// ============================================================================\n// Waveform capture\n\n// Every cycle is traced by default. Each window that is set further restricts which cycles are dumped. Cycles that are not dumped only pay for eval, the trace state is decided once per cycle by UpdateTraceState.\nenum TraceCompare{\n  TraceCompare_NOT_ZERO,\n  TraceCompare_EQUAL,\n  TraceCompare_DIFFERENT,\n  TraceCompare_LESS,\n  TraceCompare_LESS_EQUAL,\n  TraceCompare_GREATER,\n  TraceCompare_GREATER_EQUAL\n};\n\nstruct TraceControl{\n  int startCycle;\n  int endCycle; // Exclusive, negative means no end\n\n  bool runWindow;\n  int startRun;\n  int endRun; // Exclusive, negative means no end\n\n  int triggerSignal; // Index into traceSignalNames, negative when there is no trigger\n  TraceCompare triggerCompare;\n  long long triggerValue;\n  int triggerCycles; // Negative means until the end\n  int triggeredAt; // Negative while the trigger has not fired\n\n  int ringCycles; // Zero means no ring buffer\n  int ringSegment; // Segment being written, zero is the file opened first\n  int ringSegmentCycles; // Accelerator cycles dumped into the current segment\n};\n\nstatic TraceControl traceControl = {0,-1,false,0,-1,-1,TraceCompare_NOT_ZERO,0,-1,-1,0,0,0};\nstatic bool traceDumping = false;\n\ntemplate<typename T>\nstatic long long TraceSignalToInt(const T& value){\n  return (long long) value;\n}\n\n// Wide signals only compare their lower bits\ntemplate<typename T,size_t N>\nstatic long long TraceSignalToInt(const T (&value)[N]){\n  return (long long) value[0];\n}\n\ntemplate<size_t N>\nstatic long long TraceSignalToInt(const VlWide<N>& value){\n  return (long long) value[0];\n}\n\n@{traceSignals}\n\n// ============================================================================\n// Utilities\n\n#define PRINT(...) if(versatPrintf){versatPrintf(__VA_ARGS__);}\n\n// TODO: Maybe this should not exist. There should exist one update function and every other function that needs to update stuff should just call that function. UPDATE as it stands should only be called inside the update function. Instead of having macros that call UPDATE, we should just call the update function directly inside the RESET macro and the START_RUN macro and so one. Everything depends on the update function and the UPDATE macro is removed and replaced inside the function. The only problem is that I do not know if the RESET macro can call the update function without something. Nonetheless, every \"update\" should go trough the update function and none should go through this macro.\n#ifdef TRACE\n#define UPDATE(unit) \\\n   unit->clk = 0; \\\n   unit->eval(); \\\n   if(traceDumping) tfp->dump(contextp->time()); \\\n   contextp->timeInc(2); \\\n   unit->clk = 1; \\\n   unit->eval();\n#else\n#define UPDATE(unit) \\\n   unit->clk = 0; \\\n   unit->eval(); \\\n   unit->clk = 1; \\\n   unit->eval();\n#endif\n\nstatic char* Bin(unsigned int value){\n   static char buffer[33];\n   buffer[32] = '\\0';\n\n   unsigned int val = value;\n   for(int i = 31; i >= 0; i--){\n      buffer[i] = '0' + (val & 0x1);\n      val >>= 1;\n   }\n\n   return buffer;\n}\n\nstatic const int INITIAL_MEMORY_LATENCY = 5;\nstatic const int MEMORY_LATENCY = 0;\n\n// ============================================================================\n// Memory model\n\n// Without a memory model every master gets one beat per cycle, independently of the others (the ideal model, using the latencies above).\n// With a memory model, reads and writes have a channel each, like the MuxNative joining the databus masters. Channels issue at most one burst per cycle, picking requesting masters in round robin, and keep up to maxOutstanding bursts in flight. Bursts wait their latency in parallel but transfer data in issue order, sharing the bandwidth given by cyclesPerBeat.\n\n#define MAX_OUTSTANDING 16\n#define MAX_BANKS 64\n\nstruct MemoryChannel{\n   int master[MAX_OUTSTANDING]; // Issue order, first is the one transferring data\n   int latency[MAX_OUTSTANDING];\n   int size;\n   int lastIssued;\n};\n\nstatic VersatMemoryModel memoryModel = {};\nstatic MemoryChannel memoryChannels[2]; // Read and write\nstatic iptr openRow[MAX_BANKS];\nstatic int beatWait; // Cycles until the shared data bus can transfer again\nstatic int lastDataChannel;\n\nstatic void ResetMemoryModel(){\n  for(MemoryChannel& channel : memoryChannels){\n    channel.size = 0;\n  }\n  beatWait = 0;\n}\n\nstatic int IssueLatency(iptr address){\n  VersatMemoryModel* m = &memoryModel;\n  int latency = m->burstLatency;\n\n  if(m->banks > 0 && m->rowBytes > 0){\n    int banks = (m->banks < MAX_BANKS ? m->banks : MAX_BANKS);\n    iptr rowIndex = address / m->rowBytes;\n    int bank = (int) (rowIndex % banks);\n    iptr row = rowIndex / banks;\n\n    if(openRow[bank] == row){\n      latency += m->rowHitLatency;\n    } else {\n      latency += m->rowMissLatency;\n      openRow[bank] = row;\n    }\n  }\n\n  return latency;\n}\n\nstatic void SimulateMemoryModel(DatabusRequest* requests,int amount){\n  for(int i = 0; i < amount; i++){\n    databusBuffer[i].beatAllowed = false;\n  }\n\n  if(!memoryModel.enabled){\n    for(int i = 0; i < amount; i++){\n      DatabusAccess* access = &databusBuffer[i];\n      if(!requests[i].valid){\n        continue;\n      }\n\n      if(access->latencyCounter > 0){\n        access->latencyCounter -= 1;\n      } else {\n        access->beatAllowed = true;\n        access->latencyCounter = MEMORY_LATENCY;\n      }\n    }\n    return;\n  }\n\n  int maxOutstanding = memoryModel.maxOutstanding;\n  maxOutstanding = (maxOutstanding < 1 ? 1 : (maxOutstanding > MAX_OUTSTANDING ? MAX_OUTSTANDING : maxOutstanding));\n\n  bool dataReady[2] = {};\n  for(int c = 0; c < 2; c++){\n    MemoryChannel* channel = &memoryChannels[c];\n    bool isWrite = (c == 1);\n\n    // Bursts already in flight keep counting\n    for(int q = 0; q < channel->size; q++){\n      if(channel->latency[q] > 0){\n        channel->latency[q] -= 1;\n      }\n    }\n\n    if(channel->size < maxOutstanding){\n      for(int k = 1; k <= amount; k++){\n        int m = (channel->lastIssued + k) % amount;\n        DatabusRequest req = requests[m];\n        if(!req.valid || req.write != isWrite){\n          continue;\n        }\n\n        bool inFlight = false;\n        for(int q = 0; q < channel->size; q++){\n          inFlight |= (channel->master[q] == m);\n        }\n        if(inFlight){\n          continue;\n        }\n\n        channel->master[channel->size] = m;\n        channel->latency[channel->size] = IssueLatency(req.address);\n        channel->size += 1;\n        channel->lastIssued = m;\n        break;\n      }\n    }\n\n    dataReady[c] = (channel->size > 0 && channel->latency[0] == 0 && requests[channel->master[0]].valid);\n  }\n\n  if(beatWait > 0){\n    beatWait -= 1;\n    return;\n  }\n\n  bool granted = false;\n  if(memoryModel.halfDuplex){\n    // A single data bus, alternate between reads and writes when both are ready\n    int first = 1 - lastDataChannel;\n    for(int k = 0; k < 2; k++){\n      int c = (first + k) % 2;\n      if(dataReady[c]){\n        databusBuffer[memoryChannels[c].master[0]].beatAllowed = true;\n        lastDataChannel = c;\n        granted = true;\n        break;\n      }\n    }\n  } else {\n    for(int c = 0; c < 2; c++){\n      if(dataReady[c]){\n        databusBuffer[memoryChannels[c].master[0]].beatAllowed = true;\n        granted = true;\n      }\n    }\n  }\n\n  if(granted && memoryModel.cyclesPerBeat > 1){\n    beatWait = memoryModel.cyclesPerBeat - 1;\n  }\n}\n\nstatic void MemoryModelBurstDone(int master){\n  if(!memoryModel.enabled){\n    return;\n  }\n\n  for(MemoryChannel& channel : memoryChannels){\n    if(channel.size > 0 && channel.master[0] == master){\n      for(int q = 1; q < channel.size; q++){\n        channel.master[q - 1] = channel.master[q];\n        channel.latency[q - 1] = channel.latency[q];\n      }\n      channel.size -= 1;\n      return;\n    }\n  }\n}\n\ntypedef char Byte;\n\n// Everything is statically allocated\n\n@{declareExternalMemory}\n\nextern \"C\" void InitializeVerilator(){\n#ifdef TRACE\n  Verilated::traceEverOn(true);\n#endif\n}\n\n#ifdef TRACE_FST\n#define TRACE_EXTENSION \"fst\"\n#else\n#define TRACE_EXTENSION \"vcd\"\n#endif\n\n#ifdef TRACE\n// The ring buffer splits the waveform into segments of ringCycles cycles with openNext. Only the file opened first has the header, the segments after it are data only and are named by Verilator with a four digit counter.\nstatic void RingSegmentName(char* buffer,int size,int segment){\n  if(segment == 0){\n    snprintf(buffer,size,\"system.\" TRACE_EXTENSION);\n  } else {\n    snprintf(buffer,size,\"system_cat%04d.\" TRACE_EXTENSION,(segment - 1) % 10000);\n  }\n}\n#endif\n\nstatic void CloseWaveform(){\n  // Exiting in the middle of an asynchronous run, let it finish before closing the file it is writing\n  if(simThread && simThread->get_id() != std::this_thread::get_id()){\n    simThread->join();\n    delete simThread;\n    simThread = NULL;\n  }\n\n#ifdef TRACE\n  if(CreateVCD && tfp){\n    tfp->close();\n\n    TraceControl* t = &traceControl;\n    if(t->ringCycles > 0 && t->ringSegment > 0){\n      char last[64];\n      RingSegmentName(last,sizeof(last),t->ringSegment);\n\n      // Before the second rotation the older segment is the first file\n      if(t->ringSegment > 1){\n        char previous[64];\n        RingSegmentName(previous,sizeof(previous),t->ringSegment - 1);\n        PRINT(\"Last traced cycles are in %s followed by %s, append them to system.\" TRACE_EXTENSION \" which holds the header\\n\",previous,last);\n      } else {\n        PRINT(\"Last traced cycles are in system.\" TRACE_EXTENSION \" followed by %s\\n\",last);\n      }\n    }\n  }\n#endif\n}\n\n// Only the VCD writer supports openNext, ConfigTraceRing does not enable the ring buffer for FST\n#if defined(TRACE) && !defined(TRACE_FST)\n// The first file is kept for its header. Otherwise only the last two segments are kept, which always contain the last ringCycles cycles at least.\nstatic void OpenRingSegment(){\n  TraceControl* t = &traceControl;\n\n  tfp->openNext(true);\n\n  t->ringSegment += 1;\n  t->ringSegmentCycles = 0;\n\n  if(t->ringSegment >= 3){\n    char filename[64];\n    RingSegmentName(filename,sizeof(filename),t->ringSegment - 2);\n    remove(filename);\n  }\n}\n#endif\n\nstatic bool TraceTriggerHolds(V@{typeName}* self){\n  TraceControl* t = &traceControl;\n  long long value = TraceSignalRead(self,t->triggerSignal);\n\n  switch(t->triggerCompare){\n  case TraceCompare_NOT_ZERO: return value != 0;\n  case TraceCompare_EQUAL: return value == t->triggerValue;\n  case TraceCompare_DIFFERENT: return value != t->triggerValue;\n  case TraceCompare_LESS: return value < t->triggerValue;\n  case TraceCompare_LESS_EQUAL: return value <= t->triggerValue;\n  case TraceCompare_GREATER: return value > t->triggerValue;\n  case TraceCompare_GREATER_EQUAL: return value >= t->triggerValue;\n  }\n  return false;\n}\n\n// Called when the accelerator state changes. Only new cycles count towards the ring buffer segments\nstatic void UpdateTraceState(bool newCycle){\n#ifdef TRACE\n  bool canTrace = (CreateVCD && tfp);\n#else\n  bool canTrace = false;\n#endif\n\n  if(!canTrace){\n    traceDumping = false;\n    return;\n  }\n\n  TraceControl* t = &traceControl;\n\n  int cycle = cyclesDone;\n  int run = runsStarted - 1;\n\n  bool dump = (cycle >= t->startCycle && (t->endCycle < 0 || cycle < t->endCycle));\n  if(t->runWindow){\n    dump = dump && (run >= t->startRun && (t->endRun < 0 || run < t->endRun));\n  }\n\n  if(dump && t->triggerSignal >= 0){\n    if(t->triggeredAt < 0 && TraceTriggerHolds(dut)){\n      t->triggeredAt = cycle;\n      PRINT(\"Trace trigger fired at cycle %d\\n\",cycle);\n    }\n\n    dump = (t->triggeredAt >= 0 && (t->triggerCycles < 0 || cycle < t->triggeredAt + t->triggerCycles));\n  }\n\n#if defined(TRACE) && !defined(TRACE_FST)\n  if(dump && newCycle && t->ringCycles > 0){\n    if(t->ringSegmentCycles >= t->ringCycles){\n      OpenRingSegment();\n    }\n    t->ringSegmentCycles += 1;\n  }\n#endif\n\n  traceDumping = dump;\n}\n\nstatic void FillMemoryWithGarbage(){\n  // Need to select a value that is not likely to appear and that the user can quickly identify as a \"garbage\" value.\n  int unlikelyValue = 0xBA;\n  memset(externalMemory,unlikelyValue,totalExternalMemory);\n}\n\nextern \"C\" void VersatAcceleratorCreate(){\n#ifdef TRACE\n   if(CreateVCD){\n   #ifdef TRACE_FST\n      tfp = new VerilatedFstC;\n   #else\n      tfp = new VerilatedVcdC;\n   #endif\n   }\n#endif\n   V@{typeName}* self = new V@{typeName}();\n\n   if(dut){\n      PRINT(\"Initialize function is being called multiple times\\n\");\n      exit(-1);\n   }\n\n   // In order to properly test memories, we fill them with a value different than zero. \n   FillMemoryWithGarbage();\n\n   dut = self;\n\n#ifdef TRACE\n  if(CreateVCD){\n    self->trace(tfp, 99);\n      \n    #ifdef TRACE_FST\n    tfp->open(\"system.fst\");\n    #else\n    tfp->open(\"system.vcd\");\n    #endif\n\n    atexit(CloseWaveform);\n  }\n  UpdateTraceState(false);\n#endif\n\n  self->run = 0;\n  self->clk = 0;\n  self->rst = 0;\n  self->running = 0;\n\n@{inStart}\n\n   self->rst = 1;\n   UPDATE(self);\n   self->rst = 0;\n\n#ifdef TRACE\n   if(traceDumping) tfp->dump(contextp->time());\n   contextp->timeInc(1);\n   if(traceDumping) tfp->dump(contextp->time());\n   contextp->timeInc(1);\n#endif\n}\n\nstatic void InternalUpdateAccelerator(){\n   int baseAddress = 0;\n\n   cyclesDone += 1;\n   UpdateTraceState(true);\n\n   int sizeOfData = (@{databusDataSize} / 8);\n\n   V@{typeName}* self = dut;\n\n   // Databus must be updated before memories because databus could drive memories but memories \"cannot\" drive databus (in the sense that databus acts like a master if connected directly to memories but memories do not act like a master when connected to a databus. The unit logic is the one that acts like a master)\n\n@{databusSim}\n\n   profile.cyclesSinceLastReset += 1;\n   if(self->running){\n      profile.runningCycles += 1;\n   }\n\n   {\n      bool anyValid = false;\n      bool anyReady = false;\n@{databusProfile}\n      profile.databusValid += (anyValid ? 1 : 0);\n      profile.databusValidAndReady += (anyValid && anyReady ? 1 : 0);\n   }\n   \n   baseAddress = 0;\n\n@{saveExternal}\n\n   self->eval();\n   UPDATE(self); // This line causes posedge clk events to activate\n   \n   // Memory Read\n{\n   baseAddress = 0;\n\n@{memoryRead}\n\n   self->eval();\n}\n\n// Memory write\n{\n  baseAddress = 0;\n\n@{memoryWrite}\n\n  self->eval();\n}\n\n#ifdef TRACE\n   if(traceDumping) tfp->dump(contextp->time());\n   contextp->timeInc(2);\n#endif\n\n// TODO: Technically only need to do this at the end of an accelerator run, do not need to do this every single update\n@{saveState}\n}\n\nstatic bool IsDone(){\n   V@{typeName}* self = dut;\n       \n  return @{done};\n}\n\nstruct Once{};\nstruct _OnceTag{};\ntemplate<typename F>\nOnce operator+(_OnceTag t,F&& f){\n  f();\n  return Once{};\n}\n\n#define TEMP__once(LINE) TEMPonce_ ## LINE\n#define TEMP_once(LINE) TEMP__once( LINE )\n#define once static Once TEMP_once(__LINE__) = _OnceTag() + [&]()\n\n@{declareExtraConfigs}\n\nextern \"C\" void VersatReset(){\n  FirmwareAccess access;\n  FillMemoryWithGarbage();\n  @{resetExtraConfigs}\n}\n\n// Config writes go directly to memory in pc-emul, so configurations set are counted as the config words that changed since the last check\nstatic void ProfileConfigurationChanges(bool running){\n  // Asynchronous runs end in the simulation thread while the firmware might be writing a config, like the registers in hardware\n  volatile iptr* config = (volatile iptr*) &configBuffer;\n\n  for(int i = 0; i < (int) (sizeof(configSnapshot) / sizeof(iptr)); i++){\n    if(config[i] != configSnapshot[i]){\n      profile.configurationsSet += 1;\n      if(running){\n        profile.configurationsSetWhileRunning += 1;\n      }\n      configSnapshot[i] = config[i];\n    }\n  }\n}\n\nstatic void InternalStartAccelerator(){\n  V@{typeName}* self = dut;\n\n  runsStarted += 1;\n  UpdateTraceState(false);\n\n  profile.runCount += 1;\n  ProfileConfigurationChanges(false);\n\n  // Runs only end after every burst finishes, nothing is in flight. Open rows are kept\n  ResetMemoryModel();\n\n@{internalStart}\n\n  self->run = 1;\n  UPDATE(self);\n  self->running = 1;\n  self->run = 0;\n\n#ifdef TRACE\n  if(traceDumping) tfp->dump(contextp->time());\n  contextp->timeInc(1);\n  if(traceDumping) tfp->dump(contextp->time());\n  contextp->timeInc(1);\n#endif\n}\n\nstatic void InternalEndAccelerator(){\n  V@{typeName}* self = dut;\n\n  // Anything that changed since the start was written while the accelerator was running\n  ProfileConfigurationChanges(true);\n\n  self->running = 0;\n\n  // TODO: Is this update call needed?\n  InternalUpdateAccelerator();\n\n  // TODO: We could put the copy of state variables here\n}\n\nextern \"C\" int VersatAcceleratorCyclesElapsed(){\n  FirmwareAccess access;\n  return cyclesDone;\n}\n\nvoid SimulateVUnits();\n\n// Must hold simMutex\nstatic void SimulateUntilDone(){\n  for(int i = 0; !IsDone() ; i++){\n    InternalUpdateAccelerator();\n\n    if(i >= 10000000){\n      PRINT(\"Accelerator simulation has surpassed 10000000 cycles for a single run\\n\");\n      PRINT(\"Assuming that the accelerator is stuck in a never ending loop\\n\");\n      PRINT(\"Terminating simulation\\n\");\n      fflush(stdout);\n      exit(-1);\n    }   \n\n    // Only happens in asynchronous runs. The firmware access takes place in between this cycle and the next\n    if(firmwareWaiting > 0){\n      simMutex.unlock();\n      while(firmwareWaiting > 0){\n        std::this_thread::yield();\n      }\n      simMutex.lock();\n    }\n  }\n}\n\nextern \"C\" void VersatAcceleratorSimulate(){\n  std::lock_guard<std::mutex> guard(simMutex);\n\n  InternalStartAccelerator();\n\n  if(debugging){\n    SimulateVUnits();\n  }\n\n  SimulateUntilDone();\n\n  InternalEndAccelerator();\n}\n\nstatic void SimulationThread(){\n  std::lock_guard<std::mutex> guard(simMutex);\n\n  SimulateUntilDone();\n  InternalEndAccelerator();\n}\n\nextern \"C\" void VersatAcceleratorWait(){\n  if(simThread){\n    simThread->join();\n    delete simThread;\n    simThread = NULL;\n  }\n}\n\n// The run is started by the caller so that the config is copied into the model before returning\nextern \"C\" void VersatAcceleratorStartAsync(){\n  VersatAcceleratorWait();\n\n  {\n    std::lock_guard<std::mutex> guard(simMutex);\n\n    InternalStartAccelerator();\n\n    if(debugging){\n      SimulateVUnits();\n    }\n  }\n\n  simThread = new std::thread(SimulationThread);\n}\n\nextern \"C\" int MemoryAccess(int address,int value,int write){\n  FirmwareAccess access;\n  V@{typeName}* self = dut;\n\n@{memoryAccessDefines}\n\n#ifdef HAS_MEMORY_MAP\n  if(write){\n    self->valid = 1;\n    self->wstrb = 0xf;\n\n    #ifdef MEMORY_MAP_BITS\n      self->addr = address;\n    #endif\n      self->wdata = value;\n\n      //while(!self->ready){ For now we assume all writes have no delay \n          InternalUpdateAccelerator();\n      //}\n\n      self->valid = 0;\n      self->wstrb = 0x00;\n    #ifdef MEMORY_MAP_BITS\n      self->addr = 0x00000000;\n    #endif\n      self->wdata = 0x00000000;\n\n      InternalUpdateAccelerator();\n                \n      return 0;\n   } else {\n      self->valid = 1;\n      self->wstrb = 0x0;\n    #ifdef MEMORY_MAP_BITS\n      self->addr = address;\n    #endif\n\n      self->eval();\n\n      while(!self->rvalid){\n          InternalUpdateAccelerator();\n      }\n\n      int res = self->rdata;\n\n      self->valid = 0;\n    #ifdef MEMORY_MAP_BITS\n      self->addr = 0;\n    #endif\n\n      self->eval();\n      while(self->rvalid){\n          InternalUpdateAccelerator();\n      }\n\n      return res;\n   }\n#endif\n   return 0;\n}\n\nextern \"C\" void VersatSignalLoop(){\n   FirmwareAccess access;\n   V@{typeName}* self = dut;\n\n#ifdef SIGNAL_LOOP\n   self->signal_loop = 1;\n   InternalUpdateAccelerator();\n   self->signal_loop = 0;\n   self->eval();\n#endif\n}\n\nextern \"C\" void VersatLoadDelay(volatile const unsigned int* delayBuffer){\n  FirmwareAccess access;\n  V@{typeName}* self = dut;\n\n@{setDelays}\n}\n\niptr SimulateAddressPosition(iptr start_address,iptr amount_minus_one,iptr length,iptr addr_shift,int index){\n  iptr address = start_address;\n  iptr lengthAsTransfers = length / 4; // size of AXI_DATA_W;\n  int current = index;\n\n  //PRINT(\"A: %p %ld %ld %ld %d\\n\",start_address,amount_minus_one,length,addr_shift,index);\n\n  for(int i = 0; i < amount_minus_one + 1; i++){\n     if(current < lengthAsTransfers){\n       iptr actualAddress = (address + 4 * current);\n       return actualAddress;\n     } else {\n       address += addr_shift;\n       current -= lengthAsTransfers;\n     }\n  }\n\n  PRINT(\"SimulateAddressPosition reached a not possible state\\n\");\n  return 0;\n}\n\n// Native model of the address side of SuperAddress, with the same inputs that the Verilator path drives (no delay, no ignore first, always ready).\n// Calls Store with the address (in DATA_W units) of every cycle where store_o is asserted, in the same order as the hardware.\n// Widths must match the parameters used to verilate SuperAddress: ADDR_W=32, DATA_W=32 and the default PERIOD_W.\n#define SUPER_ADDRESS_OFFSET_W 2\n#define SUPER_ADDRESS_PERIOD_MASK ((1 << 10) - 1)\n\ntemplate<typename StoreFunction>\nstatic void ForEachSuperAddressStore(AddressVArguments args,StoreFunction Store){\n   uint32_t duty = args.duty & SUPER_ADDRESS_PERIOD_MASK;\n   uint32_t perI = args.per & SUPER_ADDRESS_PERIOD_MASK;\n   uint32_t per2I = args.per2 & SUPER_ADDRESS_PERIOD_MASK;\n   uint32_t per3I = args.per3 & SUPER_ADDRESS_PERIOD_MASK;\n   uint32_t iterI = (uint32_t) args.iter;\n   uint32_t iter2I = (uint32_t) args.iter2;\n   uint32_t iter3I = (uint32_t) args.iter3;\n\n   uint32_t incr = (uint32_t) args.incr << SUPER_ADDRESS_OFFSET_W;\n   uint32_t shift = (uint32_t) args.shift << SUPER_ADDRESS_OFFSET_W;\n   uint32_t incr2 = (uint32_t) args.incr2 << SUPER_ADDRESS_OFFSET_W;\n   uint32_t shift2 = (uint32_t) args.shift2 << SUPER_ADDRESS_OFFSET_W;\n   uint32_t incr3 = (uint32_t) args.incr3 << SUPER_ADDRESS_OFFSET_W;\n   uint32_t shift3 = (uint32_t) args.shift3 << SUPER_ADDRESS_OFFSET_W;\n\n   uint32_t addr = (uint32_t) args.start << SUPER_ADDRESS_OFFSET_W;\n   uint32_t addr2 = addr;\n   uint32_t addr3 = addr;\n   uint32_t per = 0,per2 = 0,per3 = 0;\n   uint32_t iter = 0,iter2 = 0,iter3 = 0;\n\n   while(1){\n      if(per < duty){\n        Store((iptr) (addr / 4));\n      }\n\n      bool perCond = ((per + 1) == perI || perI == 0);\n      bool iterCond = ((iter + 1) == iterI || iterI == 0);\n      bool per2Cond = ((per2 + 1) == per2I || per2I == 0);\n      bool iter2Cond = ((iter2 + 1) == iter2I || iter2I == 0);\n      bool per3Cond = ((per3 + 1) == per3I || per3I == 0);\n      bool iter3Cond = ((iter3 + 1) == iter3I || iter3I == 0);\n\n      if(!perCond){\n        if(per < duty){\n          addr += incr;\n        }\n        per = (per + 1) & SUPER_ADDRESS_PERIOD_MASK;\n      } else if(!iterCond){\n        addr += shift;\n        per = 0;\n        iter += 1;\n      } else if(!per2Cond){\n        addr2 += incr2;\n        addr = addr2;\n        per = iter = 0;\n        per2 = (per2 + 1) & SUPER_ADDRESS_PERIOD_MASK;\n      } else if(!iter2Cond){\n        addr2 += shift2;\n        addr = addr2;\n        per = iter = per2 = 0;\n        iter2 += 1;\n      } else if(!per3Cond){\n        addr3 += incr3;\n        addr = addr2 = addr3;\n        per = iter = per2 = iter2 = 0;\n        per3 = (per3 + 1) & SUPER_ADDRESS_PERIOD_MASK;\n      } else if(!iter3Cond){\n        addr3 += shift3;\n        addr = addr2 = addr3;\n        per = iter = per2 = iter2 = per3 = 0;\n        iter3 += 1;\n      } else {\n        break;\n      }\n   }\n}\n\nstatic SimulateVReadResult NativeSimulateVRead(AddressVArguments args){\n   SimulateVReadResult result = {};\n\n   result.amountOfExternalValuesRead = ((args.length) / sizeof(float)) * (args.amount_minus_one + 1);\n\n   bool* seen = (bool*) calloc(result.amountOfExternalValuesRead,sizeof(bool));\n   ForEachSuperAddressStore(args,[&](iptr addr){\n      if(addr < result.amountOfExternalValuesRead){\n        seen[addr] = true;\n      }\n   });\n\n   int amountSeen = 0;\n   for(int i = 0; i < result.amountOfExternalValuesRead; i++){\n      if(seen[i]){\n         amountSeen += 1;\n      }\n   }\n\n   free(seen);\n   result.amountOfInternalValuesUsed = amountSeen;\n\n   return result;\n}\n\nstatic int NativeSimulateAddressGen(iptr* arrayToFill,int arraySize,AddressVArguments args){\n   int arrayIndex = 0;\n   ForEachSuperAddressStore(args,[&](iptr addr){\n      if(arrayIndex < arraySize){\n        arrayToFill[arrayIndex++] = SimulateAddressPosition(args.ext_addr,args.amount_minus_one,args.length,args.addr_shift,addr);\n      }\n   });\n\n   return arrayIndex;\n}\n\nstatic SimulateVReadResult VerilatorSimulateVRead(AddressVArguments args){\n   SimulateVReadResult result = {};\n\n   result.amountOfExternalValuesRead = ((args.length) / sizeof(float)) * (args.amount_minus_one + 1);\n\n   // TODO: Bitfield to save memory?\n   bool* seen = (bool*) malloc(result.amountOfExternalValuesRead);\n   memset(seen,false,result.amountOfExternalValuesRead);\n\n   static VSuperAddress* self = nullptr;\n\n   Verilated::traceEverOn(true);\n\n   // Could also create and destroy everytime to make sure that we start fresh.\n   if(self == nullptr){\n      self = new VSuperAddress();\n   }\n   \n   VerilatedVcdC* tfp = new VerilatedVcdC;\n   self->trace(tfp, 99);\n   tfp->open(\"simulate.vcd\");\n\n   bool doTrace = false;\n   \n#define DO_TRACE() self->eval(); \\\n   if(doTrace) {tfp->dump(contextp->time());} \\\n   contextp->timeInc(2);\n\n#define UP() self->clk_i = 1; \\\n    DO_TRACE(); \\\n    self->clk_i = 0; \\\n    DO_TRACE();\n\n   // These wires can always be set to these value.\n   self->delay_i = 0;\n   self->ignore_first_i = 0;\n   self->data_ready_i = 1;\n   self->data_valid_i = 1;\n   self->reading = 1; // TODO: Does this make a difference? Also not like this existing in hardware either\n   self->databus_ready = 1;\n   self->ready_i = 1;\n\n   self->run_i = 0;\n   self->clk_i = 0;\n   self->rst_i = 0;\n\n   self->start_i = 0;\n   self->duty_i = args.duty;\n   self->per_i = args.per;\n   self->incr_i = args.incr;\n   self->iter_i = args.iter;\n   self->shift_i = args.shift;\n   self->per2_i = args.per2;\n   self->incr2_i = args.incr2;\n   self->iter2_i = args.iter2;\n   self->shift2_i = args.shift2;\n   self->per3_i = args.per3;\n   self->incr3_i = args.incr3;\n   self->iter3_i = args.iter3;\n   self->shift3_i = args.shift3;\n\n   self->databus_length = 0;\n   self->start_address_i = 0;\n   self->address_shift_i = 0;\n   self->count_i = 0;\n\n   DO_TRACE();\n\n   self->clk_i = 1;\n   DO_TRACE();\n\n   self->clk_i = 0;\n   self->run_i = 1;\n\n   DO_TRACE();\n\n   self->clk_i = 1;\n \n   DO_TRACE();\n\n   self->run_i = 0;\n   self->databus_last = 0;\n\n   self->clk_i = 0;\n   DO_TRACE();\n\n   // Maybe waiting for the databus is not needed.\n   int loops = 0;\n   int arrayIndex = 0;\n   while(!self->doneAddress){\n      while(!self->valid_o){\n          UP();\n          loops += 1;\n          if(loops > 10000){\n            PRINT(\"Failed on A\\n\");\n            goto end;\n          }\n      }\n      \n      if(self->store_o){\n        iptr addr = self->addr_o / 4; // DATA_W \n        //PRINT(\"%d\\n\",addr);\n        seen[addr] = true;\n      }\n\n      UP();\n   }\n\nend:\n\n   UP();\n   UP();\n   UP();\n   UP();\n   UP();\n\n   int amountSeen = 0;\n   for(int i = 0; i < result.amountOfExternalValuesRead; i++){\n      if(seen[i]){\n         amountSeen += 1;\n      }\n   }\n\n   free(seen);\n   result.amountOfInternalValuesUsed = amountSeen;\n\n   return result;\n}\n\nstatic int VerilatorSimulateAddressGen(iptr* arrayToFill,int arraySize,AddressVArguments args){\n   static VSuperAddress* self = nullptr;\n\n   Verilated::traceEverOn(true);\n\n   // Could also create and destroy everytime to make sure that we start fresh.\n   if(self == nullptr){\n      self = new VSuperAddress();\n   }\n   \n   VerilatedVcdC* tfp = new VerilatedVcdC;\n   self->trace(tfp, 99);\n   tfp->open(\"simulate.vcd\");\n\n   bool doTrace = false;\n   \n#define DO_TRACE() self->eval(); \\\n   if(doTrace) {tfp->dump(contextp->time());} \\\n   contextp->timeInc(2);\n\n#define UP() self->clk_i = 1; \\\n    DO_TRACE(); \\\n    self->clk_i = 0; \\\n    DO_TRACE();\n\n   // These wires can always be set to these value.\n   self->delay_i = 0;\n   self->ignore_first_i = 0;\n   self->data_ready_i = 1;\n   self->data_valid_i = 1;\n   self->reading = 1; // TODO: Does this make a difference? Also not like this existing in hardware either\n   self->databus_ready = 1;\n   self->ready_i = 1;\n\n   self->run_i = 0;\n   self->clk_i = 0;\n   self->rst_i = 0;\n\n   self->start_i = 0;\n   self->duty_i = args.duty;\n   self->per_i = args.per;\n   self->incr_i = args.incr;\n   self->iter_i = args.iter;\n   self->shift_i = args.shift;\n   self->per2_i = args.per2;\n   self->incr2_i = args.incr2;\n   self->iter2_i = args.iter2;\n   self->shift2_i = args.shift2;\n   self->per3_i = args.per3;\n   self->incr3_i = args.incr3;\n   self->iter3_i = args.iter3;\n   self->shift3_i = args.shift3;\n\n   self->databus_length = 0;\n   self->start_address_i = 0;\n   self->address_shift_i = 0;\n   self->count_i = 0;\n\n   DO_TRACE();\n\n   self->clk_i = 1;\n   DO_TRACE();\n\n   self->clk_i = 0;\n   self->run_i = 1;\n\n   DO_TRACE();\n\n   self->clk_i = 1;\n \n   DO_TRACE();\n\n   self->run_i = 0;\n   self->databus_last = 0;\n\n   self->clk_i = 0;\n   DO_TRACE();\n\n   // Maybe waiting for the databus is not needed.\n   int loops = 0;\n   int arrayIndex = 0;\n   while(!self->doneAddress){\n      while(!self->valid_o){\n          UP();\n          loops += 1;\n          if(loops > 10000){\n            PRINT(\"Failed on A\\n\");\n            goto end;\n          }\n      }\n      \n      if(self->store_o){\n        iptr addr = self->addr_o / 4; // DATA_W \n        if(arrayIndex < arraySize){\n          arrayToFill[arrayIndex++] = SimulateAddressPosition(args.ext_addr,args.amount_minus_one,args.length,args.addr_shift,addr);\n        }\n      }\n\n      UP();\n   }\n\nend:\n\n   UP();\n   UP();\n   UP();\n   UP();\n   UP();\n\n   return arrayIndex;\n}\n\nstatic void VerilatorSimulateAndPrintAddressGen(AddressVArguments args){\n   static VSuperAddress* self = nullptr;\n\n   Verilated::traceEverOn(true);\n\n   // Could also create and destroy everytime to make sure that we start fresh.\n   if(self == nullptr){\n      self = new VSuperAddress();\n   }\n   \n#ifdef TRACE_FST\n   VerilatedFstC* tfp = new VerilatedFstC;\n#else\n   VerilatedVcdC* tfp = new VerilatedVcdC;\n#endif\n\n   self->trace(tfp, 99);\n   tfp->open(\"simulate.vcd\");\n\n   bool doTrace = true;\n   \n#define DO_TRACE() self->eval(); \\\n   if(doTrace) {tfp->dump(contextp->time());} \\\n   contextp->timeInc(2);\n\n#define UP() self->clk_i = 1; \\\n    DO_TRACE(); \\\n    self->clk_i = 0; \\\n    DO_TRACE();\n\n   // These wires can always be set to these value.\n   self->delay_i = 0;\n   self->ignore_first_i = 0;\n   self->data_ready_i = 1;\n   self->data_valid_i = 1;\n   self->reading = 1; // TODO: Does this make a difference? Also not like this existing in hardware either\n   self->databus_ready = 1;\n   self->ready_i = 1;\n\n   self->run_i = 0;\n   self->clk_i = 0;\n   self->rst_i = 0;\n\n   self->start_i = 0;\n   self->duty_i = args.duty;\n   self->per_i = args.per;\n   self->incr_i = args.incr;\n   self->iter_i = args.iter;\n   self->shift_i = args.shift;\n   self->per2_i = args.per2;\n   self->incr2_i = args.incr2;\n   self->iter2_i = args.iter2;\n   self->shift2_i = args.shift2;\n   self->per3_i = args.per3;\n   self->incr3_i = args.incr3;\n   self->iter3_i = args.iter3;\n   self->shift3_i = args.shift3;\n\n   self->databus_length = 0;\n   self->start_address_i = 0;\n   self->address_shift_i = 0;\n   self->count_i = 0;\n\n   DO_TRACE();\n\n   self->clk_i = 1;\n   DO_TRACE();\n\n   self->clk_i = 0;\n   self->run_i = 1;\n\n   DO_TRACE();\n\n   self->clk_i = 1;\n \n   DO_TRACE();\n\n   self->run_i = 0;\n   self->databus_last = 0;\n\n   self->clk_i = 0;\n   DO_TRACE();\n\n   // Maybe waiting for the databus is not needed.\n   int loops = 0;\n   int totalIndex = 0;\n   PRINT(\"LoopIndex : Index of position being accessed\\n\");\n   while(!self->doneAddress){\n      while(!self->valid_o){\n          UP();\n          loops += 1;\n          if(loops > 10000){\n            PRINT(\"Failed on A\\n\");\n            goto end;\n          }\n      }\n      \n      if(self->store_o){\n        iptr addr = self->addr_o / 4; // DATA_W \n        iptr address = SimulateAddressPosition(args.ext_addr,args.amount_minus_one,args.length,args.addr_shift,addr);\n\n        PRINT(\"%d : %ld\\n\",totalIndex++,(address - args.ext_addr) / 4);\n      }\n\n      UP();\n   }\n\nend:\n\n   UP();\n   UP();\n   UP();\n   UP();\n   UP();\n\n   tfp->close();\n}\n\nSimulateVReadResult SimulateVRead(AddressVArguments args){\n   SimulateVReadResult result = NativeSimulateVRead(args);\n\n   if(CrossCheckAddressGen){\n      SimulateVReadResult expected = VerilatorSimulateVRead(args);\n      if(expected.amountOfExternalValuesRead != result.amountOfExternalValuesRead || expected.amountOfInternalValuesUsed != result.amountOfInternalValuesUsed){\n         PRINT(\"SimulateVRead mismatch. Native: %d %d Verilator: %d %d\\n\",result.amountOfExternalValuesRead,result.amountOfInternalValuesUsed,expected.amountOfExternalValuesRead,expected.amountOfInternalValuesUsed);\n      }\n      return expected;\n   }\n\n   return result;\n}\n\nint SimulateAddressGen(iptr* arrayToFill,int arraySize,AddressVArguments args){\n   int amount = NativeSimulateAddressGen(arrayToFill,arraySize,args);\n\n   if(CrossCheckAddressGen){\n      iptr* expected = (iptr*) calloc(arraySize,sizeof(iptr));\n      int expectedAmount = VerilatorSimulateAddressGen(expected,arraySize,args);\n\n      bool equal = (amount == expectedAmount);\n      for(int i = 0; equal && i < amount; i++){\n         equal = (arrayToFill[i] == expected[i]);\n      }\n      if(!equal){\n         PRINT(\"SimulateAddressGen mismatch between native and Verilator simulation\\n\");\n         memcpy(arrayToFill,expected,sizeof(iptr) * expectedAmount);\n         amount = expectedAmount;\n      }\n\n      free(expected);\n   }\n\n   return amount;\n}\n\nvoid SimulateAndPrintAddressGen(AddressVArguments args){\n   // The Verilator path also dumps the waveform of the unit to simulate.vcd\n   if(CrossCheckAddressGen){\n      VerilatorSimulateAndPrintAddressGen(args);\n      return;\n   }\n\n   int totalIndex = 0;\n   PRINT(\"LoopIndex : Index of position being accessed\\n\");\n   ForEachSuperAddressStore(args,[&](iptr addr){\n      iptr address = SimulateAddressPosition(args.ext_addr,args.amount_minus_one,args.length,args.addr_shift,addr);\n      PRINT(\"%d : %ld\\n\",totalIndex++,(address - args.ext_addr) / 4);\n   });\n}\n\n#undef UPDATE\n\nstruct VUnitInfo{\n  const char* unitName;\n  int mergeIndex;\n  iptr ext_addr;\n  iptr pingPong;\n  iptr amount_minus_one;\n  iptr length;\n  iptr addr_shift;\n  iptr enabled;\n  iptr iter;\n  iptr per;\n  iptr duty;\n  iptr start;\n  iptr shift;\n  iptr incr;\n  iptr iter2;\n  iptr per2;\n  iptr shift2;\n  iptr incr2;\n  iptr iter3;\n  iptr per3;\n  iptr shift3;\n  iptr incr3;\n  iptr extra_delay;\n  iptr ignore_first;\n};\n\n@{simulationStuff}\n\n\n// ============================================================================\n// Start of Versat public interface\n\n#if 1\n#include \"versat_accel.h\"\n\n#ifdef __cplusplus\n#include <cstdio>\n#include <cstdlib>\n#include <cstring>\n#else\n#define nullptr 0\n#include <stdio.h>\n#include <stdlib.h>\n#include <string.h>\n#include <stdbool.h>\n#endif\n\n#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof(arr[0]))\n\niptr versat_base;\n\n#ifdef __cplusplus\nextern \"C\"{\n#endif\n\n// Functions exported by wrapper that allow the accelerator to be simulated\nint VersatAcceleratorCyclesElapsed();\nvoid VersatReset();\nvoid InitializeVerilator();\nvoid VersatAcceleratorCreate();\nvoid VersatAcceleratorSimulate();\nvoid VersatAcceleratorStartAsync();\nvoid VersatAcceleratorWait();\nvoid VersatSignalLoop();\nint MemoryAccess(int address,int value,int write);\n\nint GetAcceleratorCyclesElapsed();\n\n#ifdef __cplusplus\n  }\n#endif\n\nvoid ConfigEnableDMA(bool value){\n}\n\nvoid ConfigCreateVCD(bool value){\n  CreateVCD = value;\n}\n\nvoid ConfigAsyncAccelerator(bool value){\n  VersatAcceleratorWait();\n  asyncAccelerator = value;\n}\n\nvoid ConfigTraceCycles(int start,int end){\n  traceControl.startCycle = start;\n  traceControl.endCycle = end;\n}\n\nvoid ConfigTraceRuns(int first,int end){\n  traceControl.runWindow = true;\n  traceControl.startRun = first;\n  traceControl.endRun = end;\n}\n\nbool ConfigTraceTrigger(const char* expression,int cycles){\n  char name[128] = {};\n  char op[3] = {};\n  long long value = 0;\n\n  int matched = sscanf(expression,\" %127[A-Za-z0-9_] %2[=!<>] %lli\",name,op,&value);\n\n  TraceCompare compare = TraceCompare_NOT_ZERO;\n  if(matched == 3){\n    if(strcmp(op,\"==\") == 0){\n      compare = TraceCompare_EQUAL;\n    } else if(strcmp(op,\"!=\") == 0){\n      compare = TraceCompare_DIFFERENT;\n    } else if(strcmp(op,\"<\") == 0){\n      compare = TraceCompare_LESS;\n    } else if(strcmp(op,\"<=\") == 0){\n      compare = TraceCompare_LESS_EQUAL;\n    } else if(strcmp(op,\">\") == 0){\n      compare = TraceCompare_GREATER;\n    } else if(strcmp(op,\">=\") == 0){\n      compare = TraceCompare_GREATER_EQUAL;\n    } else {\n      PRINT(\"Trace trigger: unknown operator '%s' in '%s'\\n\",op,expression);\n      return false;\n    }\n  } else if(matched != 1){\n    PRINT(\"Trace trigger: expected 'signal' or 'signal op value', got '%s'\\n\",expression);\n    return false;\n  }\n\n  int signal = -1;\n  for(int i = 0; i < (int) ARRAY_SIZE(traceSignalNames); i++){\n    if(strcmp(traceSignalNames[i],name) == 0){\n      signal = i;\n      break;\n    }\n  }\n\n  if(signal < 0){\n    PRINT(\"Trace trigger: '%s' is not a top level signal. Available signals:\\n\",name);\n    for(const char* available : traceSignalNames){\n      PRINT(\"  %s\\n\",available);\n    }\n    return false;\n  }\n\n  traceControl.triggerSignal = signal;\n  traceControl.triggerCompare = compare;\n  traceControl.triggerValue = value;\n  traceControl.triggerCycles = cycles;\n  traceControl.triggeredAt = -1;\n\n  return true;\n}\n\nvoid ConfigTraceRing(int cycles){\n#ifdef TRACE_FST\n  // Splitting the waveform with openNext is only supported by the VCD writer\n  PRINT(\"Trace ring buffer requires VCD output, tracing every cycle instead\\n\");\n  return;\n#endif\n\n  // The current segment starts over, segments already written are kept\n  traceControl.ringCycles = (cycles > 0 ? cycles : 0);\n  traceControl.ringSegmentCycles = 0;\n}\n\nvoid ConfigSimulateDatabus(bool value){\n  SimulateDatabus = value;\n}\n\nvoid ConfigCrossCheckAddressGen(bool value){\n  CrossCheckAddressGen = value;\n}\n\nvoid ConfigMemoryModel(VersatMemoryModel model){\n  memoryModel = model;\n  ResetMemoryModel();\n\n  for(iptr& row : openRow){\n    row = -1;\n  }\n}\n\nVersatMemoryModel VersatTypicalMemoryModel(){\n  VersatMemoryModel model = {};\n  model.enabled = true;\n  model.burstLatency = 20;\n  model.cyclesPerBeat = 1;\n  model.maxOutstanding = 4;\n  model.halfDuplex = true;\n  model.banks = 8;\n  model.rowBytes = 2048;\n  model.rowHitLatency = 0;\n  model.rowMissLatency = 10;\n  return model;\n}\n\nvoid versat_init(int base){\n  versatInitialized = true;\n  CreateVCD = true;\n  SimulateDatabus = true;\n  versat_base = base;\n\n  InitializeVerilator();\n  VersatAcceleratorCreate();\n\n  VersatLoadDelay(delayBuffer);\n  \n  accelStatic = &staticBuffer;\n}\n\nvoid SetVersatDebugPrintfFunction(VersatPrintf function){\n  versatPrintf = function;\n}\n\nstatic void CheckVersatInitialized(){\n  if(!versatInitialized){\n    printf(\"Versat has not been initialized\\n\");\n    fflush(stdout);\n    exit(-1);\n  }\n}\n\nvoid ResetAccelerator(){\n  VersatAcceleratorWait();\n  VersatReset();\n  VersatLoadDelay(delayBuffer);\n}\n\nvoid SignalLoop(){\n  VersatSignalLoop();\n}\n\nint GetAcceleratorCyclesElapsed(){\n  return VersatAcceleratorCyclesElapsed();\n}\n\nvoid RunAccelerator(int times){\n  CheckVersatInitialized();\n\n  VersatAcceleratorWait();\n  for(int i = 0; i < times; i++){\n    VersatAcceleratorSimulate();\n  }\n}\n\nvoid StartAccelerator(){\n  CheckVersatInitialized();\n\n  if(asyncAccelerator){\n    VersatAcceleratorStartAsync();\n  } else {\n    VersatAcceleratorSimulate();\n  }\n}\n\nvoid EndAccelerator(){\n  // Only asynchronous runs can still be running, otherwise start accelerator does everything\n  VersatAcceleratorWait();\n}\n\n// ======================================\n// Batch runs\n\n#include <sys/mman.h>\n#include <sys/wait.h>\n#include <unistd.h>\n\n#define MAX_BATCH_WORKERS 256\n\nstatic int batchWorkers = 0;\n\nvoid ConfigBatchWorkers(int workers){\n  batchWorkers = workers;\n}\n\n// Written by the worker processes, lives in memory shared with the caller\nstruct BatchResult{\n  @{typeName}State state;\n  int cycles;\n  VersatProfile profile; // Counters added by the run\n  VersatDatabusProfile databusProfile[@{nIOs}];\n  bool done;\n};\n\nstatic void AddProfile(VersatProfile* profile,VersatProfile other){\n  profile->runCount += other.runCount;\n  profile->cyclesSinceLastReset += other.cyclesSinceLastReset;\n  profile->runningCycles += other.runningCycles;\n  profile->databusValid += other.databusValid;\n  profile->databusValidAndReady += other.databusValidAndReady;\n  profile->configurationsSet += other.configurationsSet;\n  profile->configurationsSetWhileRunning += other.configurationsSetWhileRunning;\n}\n\nstatic void AddDatabusProfile(VersatDatabusProfile* profile,VersatDatabusProfile other){\n  profile->databusValid += other.databusValid;\n  profile->databusValidAndReady += other.databusValidAndReady;\n  profile->bytesTransferred += other.bytesTransferred;\n}\n\nstatic void RunBatchEntry(const @{typeName}Config* config,@{typeName}State* state){\n  configBuffer = *config;\n  VersatAcceleratorSimulate();\n  *state = stateBuffer;\n}\n\n// Every worker is a fork of the whole simulation (model, buffers and memories) taken at the call, which is what keeps the runs independent without the wrapper having to be reentrant.\n// Multithreaded models run the batch in the calling process instead, the Verilator thread pool does not survive a fork. Which path is taken must not change the results, hence the precondition in the header.\n// Workers return the states, cycles and profile counters of their runs. Like embedded, the accelerator ends with the configuration of the last run.\nvoid VersatRunBatch(const @{typeName}Config* configs,@{typeName}State* states,int amount){\n  CheckVersatInitialized();\n\n  VersatAcceleratorWait(); // Forking with the simulation thread running would copy the model mid cycle\n\n  if(amount <= 0){\n    return;\n  }\n\n  int workers = batchWorkers;\n  if(workers <= 0){\n    workers = (int) sysconf(_SC_NPROCESSORS_ONLN);\n  }\n  if(workers > amount){\n    workers = amount;\n  }\n  if(workers > MAX_BATCH_WORKERS){\n    workers = MAX_BATCH_WORKERS;\n  }\n\n  size_t resultsSize = sizeof(BatchResult) * amount;\n  BatchResult* results = NULL;\n  if(workers > 1 && dut->contextp()->threads() <= 1){\n    void* mem = mmap(NULL,resultsSize,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_ANONYMOUS,-1,0);\n    if(mem != MAP_FAILED){\n      results = (BatchResult*) mem;\n    }\n  }\n\n  if(!results){\n    for(int i = 0; i < amount; i++){\n      RunBatchEntry(&configs[i],&states[i]);\n    }\n    return;\n  }\n\n  // Otherwise buffered output would be printed by every worker\n  fflush(stdout);\n  fflush(stderr);\n\n  pid_t pids[MAX_BATCH_WORKERS];\n  for(int w = 0; w < workers; w++){\n    pids[w] = fork();\n\n    if(pids[w] == 0){\n      CreateVCD = false; // Waveforms belong to the caller\n\n      for(int i = w; i < amount; i += workers){\n        BatchResult* res = &results[i];\n        int start = cyclesDone;\n\n        // Counters of the worker are not used after it exits, they only count the run\n        profile = (VersatProfile){};\n        for(VersatDatabusProfile& d : databusProfile){\n          d = (VersatDatabusProfile){};\n        }\n\n        RunBatchEntry(&configs[i],&res->state);\n\n        res->cycles = cyclesDone - start;\n        res->profile = profile;\n        for(int k = 0; k < @{nIOs}; k++){\n          res->databusProfile[k] = databusProfile[k];\n        }\n        res->done = true;\n      }\n\n      fflush(stdout);\n      _exit(0); // Skip atexit handlers, the caller still owns everything else\n    }\n  }\n\n  for(int w = 0; w < workers; w++){\n    if(pids[w] > 0){\n      waitpid(pids[w],NULL,0);\n    }\n  }\n\n  for(int i = 0; i < amount; i++){\n    if(results[i].done){\n      states[i] = results[i].state;\n      cyclesDone += results[i].cycles;\n      AddProfile(&profile,results[i].profile);\n      for(int k = 0; k < @{nIOs}; k++){\n        AddDatabusProfile(&databusProfile[k],results[i].databusProfile[k]);\n      }\n    } else {\n      // Worker could not be forked or died before reaching this run\n      RunBatchEntry(&configs[i],&states[i]);\n    }\n  }\n\n  munmap(results,resultsSize);\n\n  // The last run already counted its configuration changes\n  configBuffer = configs[amount - 1];\n  memcpy(configSnapshot,&configBuffer,sizeof(configSnapshot));\n}\n\nvoid VersatMemoryCopy(volatile void* dest,volatile const void* data,int size){\n  CheckVersatInitialized();\n\n  char* byteViewDest = (char*) dest;\n  char* configView = (char*) accelConfig;\n  int* view = (int*) data;\n\n  bool destInsideConfig = (byteViewDest >= configView && byteViewDest < configView + AcceleratorConfigSize);\n  bool destEndOutsideConfig = destInsideConfig && (byteViewDest + size > configView + AcceleratorConfigSize);\n\n  if(destEndOutsideConfig){\n    printf(\"VersatMemoryCopy: Destination starts inside config and ends outside\\n\");\n    printf(\"This is most likely an error, no transfer is being made\\n\");\n    return;\n  }\n  \n  if(destInsideConfig){\n    memcpy((void*) dest,(void*) data,size);\n  } else {\n    for(int i = 0; i < (size / 4); i++){\n      VersatUnitWrite(dest,i,view[i]);\n    }\n  }\n}\n\nvoid VersatUnitWrite(volatile const void* baseaddr,int index,int val){\n  CheckVersatInitialized();\n\n  iptr addr = (iptr) baseaddr + (index * sizeof(int)) - (versat_base + memMappedStart); // Convert back to zero based address\n  MemoryAccess(addr,val,1);\n}\n\nint VersatUnitRead(volatile const void* baseaddr,int index){\n  CheckVersatInitialized();\n\n  iptr addr = (iptr) baseaddr + (index * sizeof(int)) - (versat_base + memMappedStart); // Convert back to zero based byte space address\n  int res = MemoryAccess(addr,0,0);\n  return res;\n}\n\nfloat VersatUnitReadFloat(volatile const void* base,int index){\n  int res = VersatUnitRead(base,index);\n  float* view = (float*) &res;\n  return *view;\n}\n\n// ======================================\n// Debug stuff currently disabled for pc-emul, altough we could do something in here to provide some data back.\n\nvoid DebugRunAccelerator(int times, int maxCycles){\n  RunAccelerator(times);\n} \n\nVersatDebugState VersatDebugGetState(){\n  return (VersatDebugState){};\n}\n\nVersatProfile VersatProfileGet(){\n  FirmwareAccess access;\n  return profile;\n}\n\nint VersatProfileDatabusInterfaces(){\n  return @{nIOs};\n}\n\nVersatDatabusProfile VersatProfileGetDatabus(int index){\n  if(index < 0 || index >= @{nIOs}){\n    return (VersatDatabusProfile){};\n  }\n\n  FirmwareAccess access;\n  VersatDatabusProfile res = databusProfile[index];\n  res.unitName = databusOwnerNames[index];\n  return res;\n}\n\n// 0 to 100\nstatic unsigned long long Percentage(uint64_t smaller,uint64_t bigger){\n  if(bigger == 0){\n    return 0;\n  }\n\n  return (unsigned long long) ((smaller * 100) / bigger);\n}\n\nvoid VersatPrintProfile(VersatProfile p){\n  PRINT(\"Runs profiled:%llu\\n\",(unsigned long long) p.runCount);\n  PRINT(\"Total cycles:%llu\\n\",(unsigned long long) p.cyclesSinceLastReset);\n  PRINT(\"  Cycles with accelerator running: %llu (%llu%%)\\n\",(unsigned long long) p.runningCycles,\n        Percentage(p.runningCycles,p.cyclesSinceLastReset));\n  PRINT(\"    Cycles databus valid: %llu (%llu%%)\\n\",(unsigned long long) p.databusValid,\n        Percentage(p.databusValid,p.runningCycles));\n  PRINT(\"    Cycles databus valid and ready: %llu (%llu%%)\\n\",(unsigned long long) p.databusValidAndReady,\n        Percentage(p.databusValidAndReady,p.runningCycles));\n  PRINT(\"      Databus efficiency: %llu%%\\n\",\n        Percentage(p.databusValidAndReady,p.databusValid));\n\n  // Per unit breakdown always reflects the current counters\n  for(int i = 0; i < VersatProfileDatabusInterfaces(); i++){\n    VersatDatabusProfile d = VersatProfileGetDatabus(i);\n    PRINT(\"      %s: valid %llu, valid and ready %llu (%llu%% efficiency), %llu bytes\\n\",d.unitName,\n          (unsigned long long) d.databusValid,(unsigned long long) d.databusValidAndReady,\n          Percentage(d.databusValidAndReady,d.databusValid),(unsigned long long) d.bytesTransferred);\n  }\n\n  PRINT(\"Configurations set: %llu\\n\",(unsigned long long) p.configurationsSet);\n  PRINT(\"  Configurations set while accel running: %llu\\n\",\n        (unsigned long long) p.configurationsSetWhileRunning);\n  PRINT(\"  Configurations efficiency: %llu%%\\n\",\n        Percentage(p.configurationsSetWhileRunning,p.configurationsSet));\n}\n\nvoid VersatProfileReset(){\n  FirmwareAccess access;\n  profile = (VersatProfile){};\n  for(VersatDatabusProfile& d : databusProfile){\n    d = (VersatDatabusProfile){};\n  }\n}\n\n#endif\n\n#ifdef VERSAT_BENCHMARK\n#include <chrono>\n\n// Built by the benchmark target of the generated makefile. Keeps the accelerator running with the default configuration and reports how fast the model simulates, without any firmware overhead.\nint main(int argc,const char* argv[]){\n  int cycles = 1000000;\n  if(argc > 1){\n    cycles = atoi(argv[1]);\n  }\n\n  versatInitialized = true;\n  InitializeVerilator();\n  VersatAcceleratorCreate();\n  VersatLoadDelay(delayBuffer);\n\n  int runs = 0;\n  int startCycles = cyclesDone;\n  auto start = std::chrono::steady_clock::now();\n  while(cyclesDone - startCycles < cycles){\n    InternalStartAccelerator();\n    while(!IsDone() && cyclesDone - startCycles < cycles){\n      InternalUpdateAccelerator();\n    }\n    InternalEndAccelerator();\n    runs += 1;\n  }\n  auto end = std::chrono::steady_clock::now();\n\n  int simulated = cyclesDone - startCycles;\n  double seconds = std::chrono::duration<double>(end - start).count();\n  printf(\"Simulated %d cycles (%d runs) in %.3f seconds: %.0f cycles per second\\n\",simulated,runs,seconds,simulated / seconds);\n\n  // Verilator writes the profile of --prof-pgo builds when the model is finalized\n  dut->final();\n  delete dut;\n  dut = NULL;\n\n  return 0;\n}\n#endif // VERSAT_BENCHMARK")};
+String META_VersatTemplate_Content = {String("`timescale 1ns / 1ps\n\n`include \"versat_defs.vh\"\n\nmodule iob_versat #(  //the below parameters are used in cpu if includes below\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter AXI_LEN_W  = 8,\n   parameter AXI_ID_W   = 1,\n   parameter ADDR_W     = 26,\n   parameter DATA_W     = 32,\n   parameter WDATA_W    = 32,\n   parameter MEM_ADDR_OFFSET = 0\n) (\n   input                   @{prefix}iob_valid_i,\n   input  [    ADDR_W-1:0] @{prefix}iob_addr_i,\n   input  [    DATA_W-1:0] @{prefix}iob_wdata_i,\n   input  [(DATA_W/8)-1:0] @{prefix}iob_wstrb_i,\n   output                  @{prefix}iob_rvalid_o,\n   output [    DATA_W-1:0] @{prefix}iob_rdata_o,\n   output                  @{prefix}iob_ready_o,\n   @{extraIob}     \n\n`ifdef VERSAT_EXTERNAL_MEMORY\n`ifdef VERSAT_EXPORT_EXTERNAL_MEMORY\n   `include \"versat_external_memory_port.vh\"\n`endif\n`endif\n\n`ifdef VERSAT_IO\n   output [AXI_ID_W-1:0] axi_awid_o,\n   output [AXI_ADDR_W-1:0] axi_awaddr_o,\n   output [AXI_LEN_W-1:0] axi_awlen_o,\n   output [3-1:0] axi_awsize_o,\n   output [2-1:0] axi_awburst_o,\n   output [2-1:0] axi_awlock_o,\n   output [4-1:0] axi_awcache_o,\n   output [3-1:0] axi_awprot_o,\n   output [4-1:0] axi_awqos_o,\n   output [1-1:0] axi_awvalid_o,\n   input [1-1:0] axi_awready_i,\n   output [AXI_DATA_W-1:0] axi_wdata_o,\n   output [(AXI_DATA_W/8)-1:0] axi_wstrb_o,\n   output [1-1:0] axi_wlast_o,\n   output [1-1:0] axi_wvalid_o,\n   input [1-1:0] axi_wready_i,\n   input [AXI_ID_W-1:0] axi_bid_i,\n   input [2-1:0] axi_bresp_i,\n   input [1-1:0] axi_bvalid_i,\n   output [1-1:0] axi_bready_o,\n   output [AXI_ID_W-1:0] axi_arid_o,\n   output [AXI_ADDR_W-1:0] axi_araddr_o,\n   output [AXI_LEN_W-1:0] axi_arlen_o,\n   output [3-1:0] axi_arsize_o,\n   output [2-1:0] axi_arburst_o,\n   output [2-1:0] axi_arlock_o,\n   output [4-1:0] axi_arcache_o,\n   output [3-1:0] axi_arprot_o,\n   output [4-1:0] axi_arqos_o,\n   output [1-1:0] axi_arvalid_o,\n   input [1-1:0] axi_arready_i,\n   input [AXI_ID_W-1:0] axi_rid_i,\n   input [AXI_DATA_W-1:0] axi_rdata_i,\n   input [2-1:0] axi_rresp_i,\n   input [1-1:0] axi_rlast_i,\n   input [1-1:0] axi_rvalid_i,\n   output [1-1:0] axi_rready_o,\n`endif\n\n`ifdef EXTERNAL_PORTS\n   input  [31:0] in0_i,\n   input  [31:0] in1_i,\n   output [31:0] out0_o,\n`endif\n\n   input cke_i,\n   input clk_i,\n   input arst_i\n);\n\n   assign @{prefix}iob_ready_o = 1'b1;\n\n   localparam LEN_W = `LEN_W;\n   localparam IO = `nIO;\n\n`ifdef VERSAT_IO\n   wire [               IO-1:0] m_databus_ready;\n   wire [               IO-1:0] m_databus_valid;\n   wire [    IO*AXI_ADDR_W-1:0] m_databus_addr;\n   wire [       AXI_DATA_W-1:0] m_databus_rdata;\n   wire [    IO*AXI_DATA_W-1:0] m_databus_wdata;\n   wire [IO*(AXI_DATA_W/8)-1:0] m_databus_wstrb;\n   wire [         IO*LEN_W-1:0] m_databus_len;\n   wire [               IO-1:0] m_databus_last;\n\n   wire w_ready, w_valid;\n   wire [  AXI_ADDR_W-1:0] w_addr;\n   wire [  AXI_DATA_W-1:0] w_data;\n   wire [AXI_DATA_W/8-1:0] w_strb;\n   wire [       LEN_W-1:0] w_len;\n\n   wire r_ready, r_valid;\n   wire [AXI_ADDR_W-1:0] r_addr;\n   wire [AXI_DATA_W-1:0] r_data;\n   wire [     LEN_W-1:0] r_len;\n\n   wire w_last, r_last;\n\n   // TODO: To improve performance in later stages, it would be helpful to further separate into current master being served and next master to be served.\n   //       That way, the SimpleAXItoAXI module could be changed to pipeline the transfer calculations for the next master while servicing the current master.\n   MuxNative #(\n      .N_SLAVES(IO),\n      .ADDR_W  (AXI_ADDR_W),\n      .DATA_W  (AXI_DATA_W),\n      .LEN_W   (LEN_W)\n   ) merge (\n      .s_valid_i(m_databus_valid),\n      .s_ready_o(m_databus_ready),\n      .s_last_o (m_databus_last),\n      .s_addr_i (m_databus_addr),\n      .s_wdata_i(m_databus_wdata),\n      .s_wstrb_i(m_databus_wstrb),\n      .s_rdata_o(m_databus_rdata),\n      .s_len_i  (m_databus_len),\n\n      .m_wvalid_o(w_valid),\n      .m_wready_i(w_ready),\n      .m_waddr_o (w_addr),\n      .m_wdata_o (w_data),\n      .m_wstrb_o (w_strb),\n      .m_wlen_o  (w_len),\n      .m_wlast_i (w_last),\n\n      .m_rvalid_o(r_valid),\n      .m_rready_i(r_ready),\n      .m_raddr_o (r_addr),\n      .m_rdata_i (r_data),\n      .m_rlen_o  (r_len),\n      .m_rlast_i (r_last),\n\n      .clk_i(clk_i),\n      .rst_i(arst_i)\n   );\n\nwire [AXI_ADDR_W-1:0] temp_axi_awaddr_o;\nwire [AXI_ADDR_W-1:0] temp_axi_araddr_o;\n\n@{AXIAddr}\n\n   SimpleAXItoAXI #(\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .AXI_DATA_W(AXI_DATA_W),\n      .AXI_ID_W  (AXI_ID_W),\n      .AXI_LEN_W (AXI_LEN_W),\n      .LEN_W     (LEN_W)\n   ) simpleToAxi (\n      .m_wvalid_i(w_valid),\n      .m_wready_o(w_ready),\n      .m_wdata_i (w_data),\n      .m_wstrb_i (w_strb),\n      .m_wlen_i  (w_len),\n      .m_wlast_o (w_last),\n\n      .m_rvalid_i(r_valid),\n      .m_rready_o(r_ready),\n      .m_rdata_o (r_data),\n      .m_rlen_i  (r_len),\n      .m_rlast_o (r_last),\n\n      .m_waddr_i(w_addr + MEM_ADDR_OFFSET),\n      .m_raddr_i(r_addr + MEM_ADDR_OFFSET),\n\n      .axi_awid_o(axi_awid_o), //Address write channel ID.\n      .axi_awaddr_o(temp_axi_awaddr_o), //Address write channel address.\n      .axi_awlen_o(axi_awlen_o), //Address write channel burst length.\n      .axi_awsize_o(axi_awsize_o), //Address write channel burst size. This signal indicates the size of each transfer in the burst.\n      .axi_awburst_o(axi_awburst_o), //Address write channel burst type.\n      .axi_awlock_o(axi_awlock_o), //Address write channel lock type.\n      .axi_awcache_o(axi_awcache_o), //Address write channel memory type. Set to 0000 if master output; ignored if slave input.\n      .axi_awprot_o(axi_awprot_o), //Address write channel protection type. Set to 000 if master output; ignored if slave input.\n      .axi_awqos_o(axi_awqos_o), //Address write channel quality of service.\n      .axi_awvalid_o(axi_awvalid_o), //Address write channel valid.\n      .axi_awready_i(axi_awready_i), //Address write channel ready.\n      .axi_wdata_o(axi_wdata_o), //Write channel data.\n      .axi_wstrb_o(axi_wstrb_o), //Write channel write strobe.\n      .axi_wlast_o(axi_wlast_o), //Write channel last word flag.\n      .axi_wvalid_o(axi_wvalid_o), //Write channel valid.\n      .axi_wready_i(axi_wready_i), //Write channel ready.\n      .axi_bid_i(axi_bid_i), //Write response channel ID.\n      .axi_bresp_i(axi_bresp_i), //Write response channel response.\n      .axi_bvalid_i(axi_bvalid_i), //Write response channel valid.\n      .axi_bready_o(axi_bready_o), //Write response channel ready.\n      .axi_arid_o(axi_arid_o), //Address read channel ID.\n      .axi_araddr_o(temp_axi_araddr_o), //Address read channel address.\n      .axi_arlen_o(axi_arlen_o), //Address read channel burst length.\n      .axi_arsize_o(axi_arsize_o), //Address read channel burst size. This signal indicates the size of each transfer in the burst.\n      .axi_arburst_o(axi_arburst_o), //Address read channel burst type.\n      .axi_arlock_o(axi_arlock_o), //Address read channel lock type.\n      .axi_arcache_o(axi_arcache_o), //Address read channel memory type. Set to 0000 if master output; ignored if slave input.\n      .axi_arprot_o(axi_arprot_o), //Address read channel protection type. Set to 000 if master output; ignored if slave input.\n      .axi_arqos_o(axi_arqos_o), //Address read channel quality of service.\n      .axi_arvalid_o(axi_arvalid_o), //Address read channel valid.\n      .axi_arready_i(axi_arready_i), //Address read channel ready.\n      .axi_rid_i(axi_rid_i), //Read channel ID.\n      .axi_rdata_i(axi_rdata_i), //Read channel data.\n      .axi_rresp_i(axi_rresp_i), //Read channel response.\n      .axi_rlast_i(axi_rlast_i), //Read channel last word.\n      .axi_rvalid_i(axi_rvalid_i), //Read channel valid.\n      .axi_rready_o(axi_rready_o), //Read channel ready.\n\n      .clk_i(clk_i),\n      .rst_i(arst_i)\n   );\n\n`endif\n\n`ifdef VERSAT_EXTERNAL_MEMORY\n`ifndef VERSAT_EXPORT_EXTERNAL_MEMORY\n   `include \"versat_internal_memory_wires.vh\"\n   `include \"versat_external_memory_inst.vh\"\n`endif\n`endif\n   \n   // For now keep the versat_instance using old names (no _i or _o)\n   versat_instance #(\n      .ADDR_W    (ADDR_W),\n      .DATA_W    (DATA_W),\n      .AXI_DATA_W(AXI_DATA_W),\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .LEN_W     (LEN_W)\n   ) xversat (\n      .csr_valid (@{prefix}iob_valid_i),\n      .csr_wstrb (@{prefix}iob_wstrb_i),\n\n      @{addr}\n\n      .csr_wdata (@{prefix}iob_wdata_i),\n      .csr_rdata (@{prefix}iob_rdata_o),\n      .csr_rvalid(@{prefix}iob_rvalid_o),\n\n`ifdef VERSAT_EXTERNAL_MEMORY\n      `include \"versat_external_memory_internal_portmap.vh\"\n`endif\n\n`ifdef VERSAT_IO\n      .m_databus_ready(m_databus_ready),\n      .m_databus_valid(m_databus_valid),\n      .m_databus_addr (m_databus_addr),\n      .m_databus_rdata(m_databus_rdata),\n      .m_databus_wdata(m_databus_wdata),\n      .m_databus_wstrb(m_databus_wstrb),\n      .m_databus_len  (m_databus_len),\n      .m_databus_last (m_databus_last),\n`endif\n\n`ifdef EXTERNAL_PORTS\n      .in0 (in0_i),\n      .in1 (in1_i),\n      .out0(out0_o),\n`endif\n\n      .clk(clk_i),\n      .rst(arst_i)\n   );\n\nendmodule  // iob_versat\n\n`include \"versat_undefs.vh\"\n")};
+String META_FirmwareTemplate_Content = {String("#include \"versat_accel.h\"\n\n#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof(arr[0]))\n#define TIME_IT(...) ((void)0)\n  \n#define MEMSET(base, location, value) (*((volatile int*) (base + (sizeof(int)) * location)) = (int) value)\n#define MEMGET(base, location)        (*((volatile int*) (base + (sizeof(int)) * location)))\n\n#ifdef __cplusplus\nextern \"C\"{\n#endif\n\n#ifdef __cplusplus\n  }\n#endif\n\n#ifdef __cplusplus\n#include <cstdint>\n#else\n#include \"stdint.h\"\n#include \"stdbool.h\"\n#endif\n\ntypedef uint64_t uint64;\n\niptr versat_base;\nVersatPrintf versatPrintf;\n\n// NOTE: Use PRINT instead of versatPrintf, since versatPrintf is not required to be set.\n// NOTE: This is mostly a debug tool that should not be built upon. We want to use pc-emul to report errors to user, we do not want to polute embedded with error checkings that waste precious cpu cycles.\n#define PRINT(...) if(versatPrintf){versatPrintf(__VA_ARGS__);}\n\nstatic bool enableDMA;\n\n// TODO: Need to dephase typeof, it is a gnu extension, not valid C until version C23 which is recent to support\ntypeof(accelConfig) accelConfig  = 0;\ntypeof(accelState)  accelState   = 0;\ntypeof(accelStatic) accelStatic = 0;\n\n@{registerLocation}\n\nvoid versat_init(int base){\n  versat_base = (iptr) base;\n  enableDMA = false; // It is more problematic for the general case if we start enabled. More error prone, especially when integrating with linux.\n\n  // TODO: Need to receive a printf like function from outside to enable this, I do not want to tie the implementation to IObSoC.\n  //PRINT(\"Embedded Versat\\n\");\n\n  MEMSET(versat_base,VersatRegister_Control,0x80000000); // Soft reset\n\n  accelConfig = (typeof(accelConfig)) (versat_base + configStart);\n  accelState  = (typeof(accelState))  (versat_base + stateStart);\n  accelStatic = (volatile AcceleratorStatic*)  (versat_base + staticStart);\n\n  VersatLoadDelay(delayBuffer);\n}\n\nvoid SetVersatDebugPrintfFunction(VersatPrintf function){\n  versatPrintf = function;\n  PRINT(\"Versat successfully set print function\\n\");\n}\n\nvoid EndAccelerator(){\n  //PRINT(\"End accelerator\\n\");\n  while(1){\n    volatile int val = MEMGET(versat_base,VersatRegister_Control);\n    if(val){\n      return;\n    }\n  } \n}\n\nvoid StartAccelerator(){\n  EndAccelerator();\n  MEMSET(versat_base,VersatRegister_Control,1);\n}\n\nvoid ResetAccelerator(){\n  MEMSET(versat_base,VersatRegister_Control,0x80000000); // Soft reset\n  VersatLoadDelay(delayBuffer);\n}\n\nvoid RunAccelerator(int times){\n  for(int i = 0; i < times; i++){\n    StartAccelerator();\n  } \n  EndAccelerator();\n}\n\nvoid SignalLoop(){\n  MEMSET(versat_base,VersatRegister_Control,0x40000000);\n}\n\n// There is only one accelerator, so the batch runs one after the other. The configuration registers cannot be read back, accelConfig keeps the one of the last run\nvoid VersatRunBatch(const @{typeName}Config* configs,@{typeName}State* states,int amount){\n  for(int i = 0; i < amount; i++){\n    VersatMemoryCopy(accelConfig,&configs[i],sizeof(configs[i]));\n    RunAccelerator(1);\n\n    volatile int* stateView = (volatile int*) accelState;\n    int* out = (int*) &states[i];\n    for(int k = 0; k < (int) (sizeof(states[i]) / sizeof(int)); k++){\n      out[k] = stateView[k];\n    }\n  }\n}\n\nvoid ConfigBatchWorkers(int workers){}\n\nvoid VersatMemoryCopy(volatile void* dest,volatile const void* data,int size){\n  if(size <= 0){\n    return;\n  }\n\n  iptr destInt = (iptr) dest;\n  iptr dataInt = (iptr) data;\n\n  bool destInsideVersat = false;\n  bool dataInsideVersat = false;\n\n  if(destInt >= versat_base && (destInt < versat_base + versatAddressSpace)){\n    destInsideVersat = true;\n  }\n\n  if(dataInt >= versat_base && (dataInt < versat_base + versatAddressSpace)){\n    dataInsideVersat = true;\n  }\n\n  if(dataInsideVersat == destInsideVersat){\n    if(dataInsideVersat){\n      //PRINT(\"Warning, Versat currently cannot DMA between two memory regions inside itself\\n\");\n    } else {\n      //PRINT(\"Warning, Versat cannot use its DMA when both regions are outside its address space\\n\");\n    }\n    //PRINT(\"Using a simple copy loop for now\\n\");\n  }\n\n@{dmaStuff}\n}\n\nvoid VersatUnitWrite(volatile const void* baseaddr,int index,int val){\n  iptr base = (iptr) baseaddr;\n\n  MEMSET(base,index,val);\n}\n\nint VersatUnitRead(volatile const void* baseaddr,int index){\n  iptr base = (iptr) baseaddr;\n  return MEMGET(base,index);\n}\n\nfloat VersatUnitReadFloat(volatile const void* baseaddr,int index){\n  iptr base = (iptr) baseaddr;\n  int val = MEMGET(base,index);\n  float* ptr = (float*) &val;\n  return *ptr;\n}\n\nvoid ConfigEnableDMA(bool value){\n  enableDMA = value;\n}\n\nvoid ConfigCreateVCD(bool value){}\nvoid ConfigAsyncAccelerator(bool value){}\nvoid ConfigSimulateDatabus(bool value){}\nvoid ConfigCrossCheckAddressGen(bool value){}\nvoid ConfigTraceCycles(int start,int end){}\nvoid ConfigTraceRuns(int first,int end){}\nbool ConfigTraceTrigger(const char* expression,int cycles){return false;}\nvoid ConfigTraceRing(int cycles){}\nvoid ConfigMemoryModel(VersatMemoryModel model){}\nVersatMemoryModel VersatTypicalMemoryModel(){return (VersatMemoryModel){};}\nint VersatProfileDatabusInterfaces(){return 0;}\nVersatDatabusProfile VersatProfileGetDatabus(int index){return (VersatDatabusProfile){};}\nint SimulateAddressGen(iptr* arrayToFill,int arraySize,AddressVArguments args){return 0;}\nSimulateVReadResult SimulateVRead(AddressVArguments args){return (SimulateVReadResult){};}\n\nvoid VersatLoadDelay(volatile const unsigned int* buffer){\n  volatile void* delayBase = (void*) (versat_base + delayStart);\n  VersatMemoryCopy(delayBase,buffer,sizeof(int) * ARRAY_SIZE(delayBuffer));\n}\n\n@{debugStuff}\n\n@{profileStuff}")};
+// Embed File Groups
+String temp_0_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Const #(\n   parameter DATA_W = 32\n) (\n\n   output [DATA_W-1:0] out0,\n\n   input [DATA_W-1:0] constant  // config\n);\n\n   assign out0 = constant;\n\nendmodule\n")};
+String temp_1_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule LookupTableRead #(\n   parameter DATA_W     = 32,\n   parameter ADDR_W     = 16,\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter DELAY_W    = 20,\n   parameter LEN_W      = 8\n) (\n   //databus interface\n   input                         databus_ready_0,\n   output                        databus_valid_0,\n   output reg [  AXI_ADDR_W-1:0] databus_addr_0,\n   input      [  AXI_DATA_W-1:0] databus_rdata_0,\n   output     [  AXI_DATA_W-1:0] databus_wdata_0,\n   output     [AXI_DATA_W/8-1:0] databus_wstrb_0,\n   output     [       LEN_W-1:0] databus_len_0,\n   input                         databus_last_0,\n\n   output reg done,\n\n   input [ADDR_W-3:0] in0,\n\n   (* versat_latency = 2 *) output [DATA_W-1:0] out0,\n\n   // Used by lookup table\n   output reg [    ADDR_W-1:0] ext_dp_addr_0_port_0,\n   output     [AXI_DATA_W-1:0] ext_dp_out_0_port_0,\n   input      [AXI_DATA_W-1:0] ext_dp_in_0_port_0,\n   output                      ext_dp_enable_0_port_0,\n   output                      ext_dp_write_0_port_0,\n\n   // Used to write data into lookup table\n   output [    ADDR_W-1:0] ext_dp_addr_0_port_1,\n   output [AXI_DATA_W-1:0] ext_dp_out_0_port_1,\n   output                  ext_dp_enable_0_port_1,\n   input  [AXI_DATA_W-1:0] ext_dp_in_0_port_1,\n   output                  ext_dp_write_0_port_1,\n\n   // configurations\n   input [AXI_ADDR_W-1:0] ext_addr,\n   input [    ADDR_W-1:0] iterA,\n   input [    ADDR_W-1:0] perA,\n   input [    ADDR_W-1:0] dutyA,\n   input [    ADDR_W-1:0] shiftA,\n   input [    ADDR_W-1:0] incrA,\n   input [     LEN_W-1:0] length,\n   input                  pingPong,\n\n   input disabled,\n\n   input running,\n   input clk,\n   input rst,\n   input run\n);\n\n   assign ext_dp_out_0_port_0 = 0;\n\n   localparam DIFF = AXI_DATA_W / DATA_W;\n   localparam DECISION_BIT_W = $clog2(DIFF);\n\n   /*\n   function [ADDR_W-DECISION_BIT_W-1:0] symbolSpaceConvert(input [ADDR_W-1:0] in);\n      reg [ADDR_W-1:0] shiftRes;\n      begin\n         shiftRes = in >> DECISION_BIT_W;\n         symbolSpaceConvert = shiftRes[ADDR_W-DECISION_BIT_W-1:0];\n      end\n   endfunction\n   */\n\n   reg              pingPongState;\n\n   reg [ADDR_W-1:0] addr_0;\n   always @* begin\n      addr_0 = {in0[ADDR_W-3:0], 2'b0};\n      addr_0[ADDR_W-1] = pingPong && (!pingPongState);\n   end\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) ext_dp_addr_0_port_0 <= 0;\n      else ext_dp_addr_0_port_0 <= addr_0;\n   end\n\n   generate\n      if (AXI_DATA_W > DATA_W) begin\n         // Byte selector needs to be saved to later indicate which lane to output (for 64)\n         reg [DECISION_BIT_W-1:0] sel_0;  // Matches addr_0_port_0\n         reg [DECISION_BIT_W-1:0] sel_1;  // Matches rdata_0_port_0\n         always @(posedge clk, posedge rst) begin\n            if (rst) begin\n               sel_0 <= 0;\n               sel_1 <= 0;\n            end else begin\n               sel_0 <= in0[DECISION_BIT_W-1:0];\n               sel_1 <= sel_0;\n            end\n         end\n\n         WideAdapter #(\n            .INPUT_W (AXI_DATA_W),\n            .OUTPUT_W(DATA_W)\n         ) adapter (\n            .sel_i(sel_1),\n            .in_i (ext_dp_in_0_port_0),\n            .out_o(out0)\n         );\n      end else begin\n         assign out0 = ext_dp_in_0_port_0;\n      end\n   endgenerate\n\n   assign ext_dp_enable_0_port_0 = 1'b1;\n   assign ext_dp_write_0_port_0  = 1'b0;\n\n   assign databus_wdata_0        = 0;\n   assign databus_wstrb_0        = 0;\n   assign databus_len_0          = length;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         done <= 1'b1;\n      end else if (run && !disabled) begin\n         done <= 1'b0;\n      end else begin\n         if (databus_valid_0 && databus_ready_0 && databus_last_0) done <= 1'b1;\n      end\n   end\n\n   // Ping pong \n   always @(posedge clk, posedge rst) begin\n      if (rst) pingPongState <= 0;\n      else if (run)  // && !disabled\n         pingPongState <= pingPong ? (!pingPongState) : 1'b0;\n   end\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) databus_addr_0 <= 0;\n      else if (run && !disabled) databus_addr_0 <= ext_addr;\n   end\n\n   wire [ADDR_W-1:0] startA = 0;\n   wire [DELAY_W-1:0] delayA = 0;\n\n   wire              gen_ready;\n   wire [ADDR_W-1:0] gen_addr;\n\n   AddressGen #(\n      .ADDR_W  (ADDR_W),\n      .DATA_W  (AXI_DATA_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(ADDR_W)\n   ) addrgenA (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .iter_i(iterA),\n      .per_i    (perA),\n      .duty_i      (dutyA),\n      .delay_i     (delayA),\n      .start_i     (startA),\n      .shift_i     (shiftA),\n      .incr_i      (incrA),\n\n      //outputs \n      .valid_o(),\n      .ready_i(gen_ready),\n      .addr_o (gen_addr),\n      .store_o(),\n\n      .done_o ()\n   );\n\n   wire                  write_en;\n   wire [    ADDR_W-1:0] write_addr;\n   wire [AXI_DATA_W-1:0] write_data;\n\n   reg                   gen_valid;\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         gen_valid <= 1'b0;\n      end else if (run) begin\n         gen_valid <= !disabled;\n      end else if (running) begin\n         if (databus_valid_0 && databus_ready_0 && databus_last_0) begin\n            gen_valid <= 1'b0;\n         end\n      end\n   end\n\n   wire result_ready_int = ~rst;\n\n   JoinTwoHandshakes #(\n      .FIRST_DATA_W(ADDR_W),\n      .SECOND_DATA_W(AXI_DATA_W)\n   ) writer (\n      .first_valid_i(gen_valid),\n      .first_ready_o(gen_ready),\n      .first_data_i(gen_addr),\n\n      .second_valid_i(databus_ready_0),\n      .second_ready_o(databus_valid_0),\n      .second_data_i(databus_rdata_0),\n\n      .result_valid_o(write_en),\n      .result_ready_i(result_ready_int),\n      .result_first_data_o(write_addr),\n      .result_second_data_o(write_data),\n\n      .forceReset(!running),\n\n      .clk_i(clk),\n      .rst_i(rst)\n   );\n\n   assign ext_dp_addr_0_port_1 = pingPong ? {(pingPongState) ^ write_addr[ADDR_W-1],write_addr[ADDR_W-2:0]} : write_addr;\n   assign ext_dp_enable_0_port_1 = write_en;\n   assign ext_dp_write_0_port_1 = 1'b1;\n   assign ext_dp_out_0_port_1 = write_data;\n\n\nendmodule\n")};
+String temp_2_CONTENT = {String("`timescale 1ns / 1ps\n\n`define COMPLEX_INTERFACE\n\n// Probably could be implemented using Mem.v but for now simplify\n(* source *) module ReadWriteMem #(\n   parameter DATA_W        = 32,\n   parameter DELAY_W       = 7,\n   parameter SIZE_W        = 32,\n   parameter ADDR_W        = 12,\n   parameter PERIOD_W      = 10\n) (\n   //control\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n   input  disabled,\n\n   //databus interface\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  ADDR_W-1:0] addr,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output reg                rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   //input / output data\n                            input  [DATA_W-1:0] in0,\n   (* versat_latency = 3 *) output [DATA_W-1:0] out0,\n\n   // External memory\n   output [ADDR_W-1:0] ext_dp_addr_0_port_0,\n   output [DATA_W-1:0] ext_dp_out_0_port_0,\n   input  [DATA_W-1:0] ext_dp_in_0_port_0,\n   output              ext_dp_enable_0_port_0,\n   output              ext_dp_write_0_port_0,\n\n   output [ADDR_W-1:0] ext_dp_addr_0_port_1,\n   output [DATA_W-1:0] ext_dp_out_0_port_1,\n   input  [DATA_W-1:0] ext_dp_in_0_port_1,\n   output              ext_dp_enable_0_port_1,\n   output              ext_dp_write_0_port_1,\n\n   input [DELAY_W-1:0] delay0,\n\n   // Configuration\n   // Input config\n   input [ADDR_W-1:0] iterA,\n   input [PERIOD_W-1:0] perA,\n   input [PERIOD_W-1:0] dutyA,\n   input [ADDR_W-1:0] startA,\n   input [ADDR_W-1:0] shiftA,\n   input [ADDR_W-1:0] incrA,\n   input              reverseA,\n   input              extA,\n   input              in0_wr,\n\n   // Output config\n   input [ADDR_W-1:0] iterB,\n   input [PERIOD_W-1:0] perB,\n   input [PERIOD_W-1:0] dutyB,\n   input [ADDR_W-1:0] startB,\n   input [ADDR_W-1:0] shiftB,\n   input [ADDR_W-1:0] incrB,\n   //input [    32-1:0] delay1,\n   input              reverseB\n);\n\n   wire we = |wstrb;\n\n   wire doneA, doneB;\n   wire ready_int = ~rst;\n\n   //output databus\n   reg [DATA_W-1:0] out_reg;\n\n   assign out0 = (running ? out_reg : 0);\n   assign done = (doneA & doneB);\n\n   //function to reverse bits\n   function [ADDR_W-1:0] reverseBits;\n      input [ADDR_W-1:0] word;\n      integer i;\n\n      begin\n         for (i = 0; i < ADDR_W; i = i + 1) reverseBits[i] = word[ADDR_W-1-i];\n      end\n   endfunction\n\n   //mem enables output by addr gen\n   wire enA_int;\n   wire enA = enA_int | valid;\n\n   //write enables\n   wire wrA = valid ? we : (enA_int & in0_wr & ~extA); //addrgen on & input on & input isn't address\n\n   //port addresses and enables\n   wire [ADDR_W-1:0] addrA, addrA_int, addrA_int2;\n   wire [ADDR_W-1:0] addrB, addrB_int, addrB_int2;\n\n   //data inputs\n   wire [DATA_W-1:0] data_to_wrA = valid ? wdata : in0;\n\n   //address generators\n\n   AddressGen #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(SIZE_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenA (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .per_i(perA),\n      .start_i (startA),\n      .incr_i  (incrA),\n      .delay_i (delay0),\n\n`ifdef COMPLEX_INTERFACE\n      .iter_i(iterA),\n      .duty_i      (dutyA),\n      .shift_i     (shiftA),\n`endif\n\n      //outputs \n      .valid_o(enA_int),\n      .ready_i(ready_int),\n      .addr_o (addrA_int),\n      .store_o(), // TODO: Handle duty\n\n      .done_o (doneA)\n   );\n\n   AddressGen #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(SIZE_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenB (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .per_i(perB),\n      .start_i (startB),\n      .incr_i  (incrB),\n      .delay_i (0),\n\n`ifdef COMPLEX_INTERFACE\n      .iter_i(iterB),\n      .duty_i      (dutyB),\n      .shift_i     (shiftB),\n`endif\n\n      //outputs \n      .valid_o(),\n      .ready_i(ready_int),\n      .addr_o (addrB_int),\n      .store_o(), // TODO: Handle duty\n\n      .done_o (doneB)\n   );\n\n   //define addresses based on ext and rvrs\n   assign addrA      = valid ? addr[ADDR_W-1:0] : (extA ? in0[ADDR_W-1:0] : addrA_int2[ADDR_W-1:0]);\n   assign addrB      = valid ? addr[ADDR_W-1:0] : addrB_int2[ADDR_W-1:0];\n   assign addrA_int2 = reverseA ? reverseBits(addrA_int) : addrA_int;\n   assign addrB_int2 = reverseB ? reverseBits(addrB_int) : addrB_int;\n\n   //register mem inputs\n   reg [DATA_W-1:0] data_a_reg;\n   reg [ADDR_W-1:0] addr_a_reg, addr_b_reg;\n   reg en_a_reg, en_b_reg, we_a_reg;\n   always @(posedge clk) begin\n      data_a_reg <= data_to_wrA;\n      addr_a_reg <= addrA;\n      addr_b_reg <= addrB;\n      en_a_reg   <= enA;\n      en_b_reg   <= (valid && !we);\n      we_a_reg   <= wrA;\n   end\n\n   // Read \n   assign rdata = (rvalid ? out_reg : 32'h0);\n\n   // Delay by a cycle to match memory read latency\n   reg readCounter[1:0];\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         rvalid         <= 1'b0;\n         readCounter[0] <= 1'b0;\n         readCounter[1] <= 1'b0;\n      end else begin\n         if (rvalid) begin\n            rvalid         <= 1'b0;\n            readCounter[0] <= 1'b0;\n            readCounter[1] <= 1'b0;\n         end else begin\n            // Write\n            //if(valid && we)\n            //   ready <= 1'b1;\n\n            // Read\n            rvalid         <= readCounter[0];\n            readCounter[0] <= readCounter[1];\n            if (wstrb == 0) readCounter[1] <= valid;\n         end\n      end\n   end\n\n   assign ext_dp_addr_0_port_0   = addr_a_reg;\n   assign ext_dp_out_0_port_0    = data_a_reg;\n   assign ext_dp_enable_0_port_0 = en_a_reg;\n   assign ext_dp_write_0_port_0  = we_a_reg;\n\n   assign ext_dp_addr_0_port_1   = addr_b_reg;\n   assign ext_dp_out_0_port_1    = 0;\n   assign ext_dp_enable_0_port_1 = en_b_reg || running;\n   assign ext_dp_write_0_port_1  = 1'b0;\n\n   //register mem outputs\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out_reg <= 0;\n      end else if (run) begin\n         out_reg <= 0;\n      end else begin\n         out_reg <= ext_dp_in_0_port_1;\n      end\n   end\n\nendmodule\n\n`undef COMPLEX_INTERFACE\n")};
+String temp_3_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule PipelineRegister #(\n   parameter DATA_W = 32\n) (\n   input running,\n\n   input [DATA_W-1:0] in0,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input clk,\n   input rst\n);\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0 <= {DATA_W{1'b0}};\n      end else if (running) begin\n         out0 <= in0;\n      end else begin\n         out0 <= {DATA_W{1'b0}};\n      end\n   end\n\nendmodule\n")};
+String temp_4_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Merge2 #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //input / output data\n                             input [DATA_W-1:0] in0,\n   (* versat_latency = 1 *)  input [DATA_W-1:0] in1,\n   (* versat_latency = 2 *)  input [DATA_W-1:0] in2,\n   (* versat_latency = 3 *)  input [DATA_W-1:0] in3,\n   (* versat_latency = 4 *)  input [DATA_W-1:0] in4,\n   (* versat_latency = 5 *)  input [DATA_W-1:0] in5,\n   (* versat_latency = 6 *)  input [DATA_W-1:0] in6,\n   (* versat_latency = 7 *)  input [DATA_W-1:0] in7,\n   (* versat_latency = 8 *)  input [DATA_W-1:0] in8,\n   (* versat_latency = 9 *)  input [DATA_W-1:0] in9,\n   (* versat_latency = 10 *) input [DATA_W-1:0] in10,\n   (* versat_latency = 11 *) input [DATA_W-1:0] in11,\n   (* versat_latency = 12 *) input [DATA_W-1:0] in12,\n   (* versat_latency = 13 *) input [DATA_W-1:0] in13,\n   (* versat_latency = 14 *) input [DATA_W-1:0] in14,\n   (* versat_latency = 15 *) input [DATA_W-1:0] in15,\n   (* versat_latency = 16 *) input [DATA_W-1:0] in16,\n   (* versat_latency = 17 *) input [DATA_W-1:0] in17,\n   (* versat_latency = 18 *) input [DATA_W-1:0] in18,\n   (* versat_latency = 19 *) input [DATA_W-1:0] in19,\n   (* versat_latency = 20 *) input [DATA_W-1:0] in20,\n   (* versat_latency = 21 *) input [DATA_W-1:0] in21,\n   (* versat_latency = 22 *) input [DATA_W-1:0] in22,\n   (* versat_latency = 23 *) input [DATA_W-1:0] in23,\n   (* versat_latency = 24 *) input [DATA_W-1:0] in24,\n   (* versat_latency = 25 *) input [DATA_W-1:0] in25,\n   (* versat_latency = 26 *) input [DATA_W-1:0] in26,\n   (* versat_latency = 27 *) input [DATA_W-1:0] in27,\n   (* versat_latency = 28 *) input [DATA_W-1:0] in28,\n   (* versat_latency = 29 *) input [DATA_W-1:0] in29,\n   (* versat_latency = 30 *) input [DATA_W-1:0] in30,\n   (* versat_latency = 31 *) input [DATA_W-1:0] in31,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] delay0\n);\n\n   reg  [DELAY_W-1:0] delay;\n\n   wire [ DATA_W-1:0] select[31:0];\n\n   assign select[0]  = in0;\n   assign select[1]  = in1;\n   assign select[2]  = in2;\n   assign select[3]  = in3;\n   assign select[4]  = in4;\n   assign select[5]  = in5;\n   assign select[6]  = in6;\n   assign select[7]  = in7;\n   assign select[8]  = in8;\n   assign select[9]  = in9;\n   assign select[10] = in10;\n   assign select[11] = in11;\n   assign select[12] = in12;\n   assign select[13] = in13;\n   assign select[14] = in14;\n   assign select[15] = in15;\n   assign select[16] = in16;\n   assign select[17] = in17;\n   assign select[18] = in18;\n   assign select[19] = in19;\n   assign select[20] = in20;\n   assign select[21] = in21;\n   assign select[22] = in22;\n   assign select[23] = in23;\n   assign select[24] = in24;\n   assign select[25] = in25;\n   assign select[26] = in26;\n   assign select[27] = in27;\n   assign select[28] = in28;\n   assign select[29] = in29;\n   assign select[30] = in30;\n   assign select[31] = in31;\n\n   reg [4:0] counter;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         delay   <= {DELAY_W{1'b0}};\n         counter <= 5'b0;\n      end else if (run) begin\n         delay   <= delay0;\n         counter <= 5'b0;\n      end else if (running) begin\n         if (|delay) begin\n            delay <= delay - 1;\n         end\n\n         if (delay == 0) begin\n            counter <= counter + 1;\n         end\n\n         out0 <= select[counter];\n      end else begin\n         delay   <= delay;\n         counter <= counter;\n      end\n   end\n\nendmodule\n")};
+String temp_5_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule DebugReadMem #(\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter LEN_W      = 8\n) (\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output reg done,\n\n   // Databus interface\n   input                     databus_ready_0,\n   output reg                databus_valid_0,\n   output [  AXI_ADDR_W-1:0] databus_addr_0,\n   input  [  AXI_DATA_W-1:0] databus_rdata_0,\n   output [  AXI_DATA_W-1:0] databus_wdata_0,\n   output [AXI_DATA_W/8-1:0] databus_wstrb_0,\n   output [       LEN_W-1:0] databus_len_0,\n   input                     databus_last_0,\n\n   input [AXI_ADDR_W-1:0]    address,\n\n   output reg [AXI_DATA_W-1:0] lastRead\n);\n\n   assign databus_addr_0  = address;\n   assign databus_wstrb_0 = {(AXI_DATA_W/8){1'b0}};\n   assign databus_len_0   = 4;\n   assign databus_wdata_0 = {AXI_DATA_W{1'b0}};\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         databus_valid_0 <= 1'b0;\n         lastRead <= {AXI_DATA_W{1'b0}};\n         done <= 1'b1;\n      end else if (run) begin\n         databus_valid_0 <= 1'b1;\n         lastRead <= {AXI_DATA_W{1'b0}};\n         done <= 1'b0;\n      end else if (running) begin\n         if(databus_ready_0) begin\n            databus_valid_0 <= 1'b0;\n            lastRead <= databus_rdata_0;\n            done <= 1'b1;\n         end\n      end\n   end\n\nendmodule  // DebugReadMem\n\n")};
+String temp_6_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule CombMux8 #(\n   parameter DATA_W = 32\n) (\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n   input [DATA_W-1:0] in2,\n   input [DATA_W-1:0] in3,\n   input [DATA_W-1:0] in4,\n   input [DATA_W-1:0] in5,\n   input [DATA_W-1:0] in6,\n   input [DATA_W-1:0] in7,\n\n   (* versat_latency = 0 *) output reg [DATA_W-1:0] out0,\n\n   input [2:0] sel\n);\n\n   always @* begin\n      case (sel)\n         3'b000: out0 = in0;\n         3'b001: out0 = in1;\n         3'b010: out0 = in2;\n         3'b011: out0 = in3;\n         3'b100: out0 = in4;\n         3'b101: out0 = in5;\n         3'b110: out0 = in6;\n         3'b111: out0 = in7;\n      endcase\n   end\n\nendmodule\n")};
+String temp_7_CONTENT = {String("`timescale 1ns / 1ps\n\n`define COMPLEX_INTERFACE\n\n(* source *) module Mem #(\n   parameter DATA_W        = 32,\n   parameter SIZE_W        = 32,\n   parameter DELAY_W       = 7,\n   parameter ADDR_W        = 12,\n   parameter PERIOD_W      = 10\n) (\n   //control\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n   input  disabled,\n\n   //databus interface\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  ADDR_W-1:0] addr,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output reg                rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   //input / output data\n                            input  [DATA_W-1:0] in0,\n                            input  [DATA_W-1:0] in1,\n   (* versat_latency = 3 *) output [DATA_W-1:0] out0,\n   (* versat_latency = 3 *) output [DATA_W-1:0] out1,\n\n   // External memory\n   output [ADDR_W-1:0] ext_dp_addr_0_port_0,\n   output [DATA_W-1:0] ext_dp_out_0_port_0,\n   input  [DATA_W-1:0] ext_dp_in_0_port_0,\n   output              ext_dp_enable_0_port_0,\n   output              ext_dp_write_0_port_0,\n\n   output [ADDR_W-1:0] ext_dp_addr_0_port_1,\n   output [DATA_W-1:0] ext_dp_out_0_port_1,\n   input  [DATA_W-1:0] ext_dp_in_0_port_1,\n   output              ext_dp_enable_0_port_1,\n   output              ext_dp_write_0_port_1,\n\n   // Configuration\n   input [ADDR_W-1:0] iterA,\n   input [PERIOD_W-1:0] perA,\n   input [PERIOD_W-1:0] dutyA,\n   input [ADDR_W-1:0] startA,\n   input [ADDR_W-1:0] shiftA,\n   input [ADDR_W-1:0] incrA,\n   input              reverseA,\n   input              extA,\n   input              in0_wr,\n\n   input [ADDR_W-1:0] iterB,\n   input [PERIOD_W-1:0] perB,\n   input [PERIOD_W-1:0] dutyB,\n   input [ADDR_W-1:0] startB,\n   input [ADDR_W-1:0] shiftB,\n   input [ADDR_W-1:0] incrB,\n   input              reverseB,\n   input              extB,\n   input              in1_wr,\n\n   input [DELAY_W-1:0] delay0,\n   input [DELAY_W-1:0] delay1\n);\n\n   wire we = |wstrb;\n\n   wire doneA, doneB;\n   wire ready_int = ~rst;\n\n   //output databus\n   reg [DATA_W-1:0] outA_reg, outB_reg;\n\n   reg [DELAY_W-1:0] testDelay0;\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         testDelay0 <= 0;\n      end else if (run) begin\n         testDelay0 <= delay0 + 3;\n      end else if (|testDelay0) begin\n         testDelay0 <= testDelay0 - 1;\n      end\n   end\n\n   reg [DELAY_W-1:0] testDelay1;\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         testDelay1 <= 0;\n      end else if (run) begin\n         testDelay1 <= delay1 + 3;\n      end else if (|testDelay1) begin\n         testDelay1 <= testDelay1 - 1;\n      end\n   end\n\n   assign out0 = (running & (|testDelay0) == 0) ? outA_reg : 0;\n   assign out1 = (running & (|testDelay1) == 0) ? outB_reg : 0;\n\n   // Delay done by 3 cycles so that pc-emul matches simulation\n   // since pc-emul external memories stop working when the accelerator stops running in pc-emul.\n   reg doneA_1,doneB_1;\n   reg doneA_2,doneB_2;\n   reg doneA_3,doneB_3;\n   always @(posedge clk,posedge rst)\n   begin\n      if(rst) begin\n         doneA_1 <= 0;\n         doneA_2 <= 0;\n         doneB_1 <= 0;\n         doneB_2 <= 0;\n      end else begin\n         doneA_1 <= doneA;\n         doneA_2 <= doneA_1;\n         doneA_3 <= doneA_2;\n         doneB_1 <= doneB;\n         doneB_2 <= doneB_1;\n         doneB_3 <= doneB_2;\n      end\n   end\n   assign done = (doneA & doneB & doneA_2 & doneB_2 & doneA_3 & doneB_3);\n\n   //assign done = (doneA & doneB);\n\n   //function to reverse bits\n   function [ADDR_W-1:0] reverseBits;\n      input [ADDR_W-1:0] word;\n      integer i;\n\n      begin\n         for (i = 0; i < ADDR_W; i = i + 1) reverseBits[i] = word[ADDR_W-1-i];\n      end\n   endfunction\n\n   //mem enables output by addr gen\n   wire enA_int;\n   wire enA = enA_int | valid;\n   wire enB;\n\n   //write enables\n   wire wrA = valid? we : (enA_int & in0_wr & ~extA); //addrgen on & input on & input isn't address\n   wire wrB = (enB & in1_wr & ~extB);\n\n   //port addresses and enables\n   wire [ADDR_W-1:0] addrA, addrA_int, addrA_int2;\n   wire [ADDR_W-1:0] addrB, addrB_int, addrB_int2;\n\n   //data inputs\n   wire [DATA_W-1:0] data_to_wrA = valid ? wdata : in0;\n\n   //address generators\n\n   AddressGen #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(SIZE_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenA (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .per_i(perA),\n      .start_i (startA),\n      .incr_i  (incrA),\n      .delay_i (delay0),\n\n`ifdef COMPLEX_INTERFACE\n      .iter_i(iterA),\n      .duty_i      (dutyA),\n      .shift_i     (shiftA),\n`endif\n\n      //outputs \n      .valid_o(enA_int),\n      .ready_i(ready_int),\n      .addr_o (addrA_int),\n      .store_o(),\n\n      .done_o (doneA)\n   );\n\n   AddressGen #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(SIZE_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenB (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .per_i(perB),\n      .start_i (startB),\n      .incr_i  (incrB),\n      .delay_i (delay1),\n\n`ifdef COMPLEX_INTERFACE\n      .iter_i(iterB),\n      .duty_i      (dutyB),\n      .shift_i     (shiftB),\n`endif\n\n      //outputs \n      .valid_o(enB),\n      .ready_i(ready_int),\n      .addr_o (addrB_int),\n      .store_o(),\n\n      .done_o (doneB)\n   );\n\n   //define addresses based on ext and rvrs\n   assign addrA      = valid ? addr[ADDR_W-1:0] : (extA ? in0[ADDR_W-1:0] : addrA_int2[ADDR_W-1:0]);\n   assign addrB      = (extB ? in1[ADDR_W-1:0] : addrB_int2[ADDR_W-1:0]);\n   assign addrA_int2 = reverseA ? reverseBits(addrA_int) : addrA_int;\n   assign addrB_int2 = reverseB ? reverseBits(addrB_int) : addrB_int;\n\n   //register mem inputs\n   reg [DATA_W-1:0] data_a_reg, data_b_reg;\n   reg [ADDR_W-1:0] addr_a_reg, addr_b_reg;\n   reg en_a_reg, en_b_reg, we_a_reg, we_b_reg;\n   always @(posedge clk) begin\n      data_a_reg <= data_to_wrA;\n      data_b_reg <= in1;\n      addr_a_reg <= addrA;\n      addr_b_reg <= addrB;\n      en_a_reg   <= enA;\n      en_b_reg   <= enB;\n      we_a_reg   <= wrA;\n      we_b_reg   <= wrB;\n   end\n\n   // Read \n   assign rdata = (rvalid ? outA_reg : {DATA_W{1'b0}});\n\n   // Delay by a cycle to match memory read latency\n   reg readCounter[1:0];\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         rvalid         <= 1'b0;\n         readCounter[0] <= 1'b0;\n         readCounter[1] <= 1'b0;\n      end else begin\n         if (rvalid) begin\n            rvalid         <= 1'b0;\n            readCounter[0] <= 1'b0;\n            readCounter[1] <= 1'b0;\n         end else begin\n            // Write\n            //if(valid && we)\n            //   ready <= 1'b1;\n\n            // Read\n            rvalid         <= readCounter[0];\n            readCounter[0] <= readCounter[1];\n            if (wstrb == 0) readCounter[1] <= valid;\n         end\n      end\n   end\n\n   assign ext_dp_addr_0_port_0   = addr_a_reg;\n   assign ext_dp_out_0_port_0    = data_a_reg;\n   assign ext_dp_enable_0_port_0 = en_a_reg;\n   assign ext_dp_write_0_port_0  = we_a_reg;\n\n   assign ext_dp_addr_0_port_1   = addr_b_reg;\n   assign ext_dp_out_0_port_1    = data_b_reg;\n   assign ext_dp_enable_0_port_1 = en_b_reg;\n   assign ext_dp_write_0_port_1  = we_b_reg;\n\n   //register mem outputs\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         outA_reg <= 0;\n         outB_reg <= 0;\n      end else if (run) begin\n         outA_reg <= 0;\n         outB_reg <= 0;\n      end else begin\n         outA_reg <= ext_dp_in_0_port_0;  //outA;\n         outB_reg <= ext_dp_in_0_port_1;\n      end\n   end\n\nendmodule\n\n`undef COMPLEX_INTERFACE\n")};
+String temp_8_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Mux8 #(\n   parameter DATA_W = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n   input [DATA_W-1:0] in2,\n   input [DATA_W-1:0] in3,\n   input [DATA_W-1:0] in4,\n   input [DATA_W-1:0] in5,\n   input [DATA_W-1:0] in6,\n   input [DATA_W-1:0] in7,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [2:0] sel\n);\n\n   reg [DATA_W-1:0] out;\n   always @* begin\n      case (sel)\n         3'b000: out = in0;\n         3'b001: out = in1;\n         3'b010: out = in2;\n         3'b011: out = in3;\n         3'b100: out = in4;\n         3'b101: out = in5;\n         3'b110: out = in6;\n         3'b111: out = in7;\n      endcase\n   end\n\n   always @(posedge clk,posedge rst) begin\n      if(rst) begin\n         out0 <= 0;\n      end else if (running) begin\n         out0 <= out;         \n      end else begin\n        out0 <= 0;\n      end\n   end\n\nendmodule\n")};
+String temp_9_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Generator #(\n    parameter PERIOD_W = 16,\n    parameter DELAY_W  = 7,\n    parameter ADDR_W   = 32\n) (\n    input clk,\n    input rst,\n\n    input running,\n    input run,\n\n    //configurations \n    input [ADDR_W-1:0] iter,\n    input [ADDR_W-1:0] shift,\n\n    input [PERIOD_W - 1:0] per,\n    input [ADDR_W-1:0] incr,\n\n    input [ADDR_W-1:0] iter2,\n    input [ADDR_W-1:0] shift2,\n\n    input [PERIOD_W - 1:0] per2,\n    input [ADDR_W-1:0] incr2,\n\n    input [ADDR_W-1:0] iter3,\n    input [ADDR_W-1:0] shift3,\n\n    input [PERIOD_W - 1:0] per3,\n    input [ADDR_W-1:0] incr3,\n\n    input [PERIOD_W - 1:0] duty,\n    input [ADDR_W-1:0] start,\n\n    input [DELAY_W-1:0] delay0,\n\n    //outputs \n    (* versat_latency = 0 *)\n    output [ADDR_W-1:0] out0 // Latency zero because Address Gen is one cycle ahead in providing the address\n);\n\n  wire [ADDR_W-1:0] genOut;\n\n  assign out0 = genOut;  //done ? off_value : genOut;\n\n  AddressGen3 #(\n      .ADDR_W  (ADDR_W),\n      .DATA_W  (8),\n      .DELAY_W (DELAY_W),\n      .PERIOD_W(PERIOD_W)\n  ) addrGen (\n      .clk_i(clk),\n      .rst_i(rst),\n\n      .run_i(run),\n\n      .ignore_first_i(1'b0),\n\n      //configurations \n      .duty_i (duty),\n      .start_i(start),\n\n      .per_i (per),\n      .incr_i(incr),\n\n      .iter_i (iter),\n      .shift_i(shift),\n\n      .per2_i (per2),\n      .incr2_i(incr2),\n\n      .iter2_i (iter2),\n      .shift2_i(shift2),\n\n      .per3_i (per3),\n      .incr3_i(incr3),\n\n      .iter3_i (iter3),\n      .shift3_i(shift3),\n\n      .delay_i(delay0),\n\n      //outputs \n      .valid_o(),\n      .ready_i(running),\n      .addr_o (genOut),\n      .store_o(),\n\n      .done_o()\n  );\n\nendmodule\n")};
+String temp_10_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule SwapEndian #(\n   parameter DATA_W = 32\n) (\n   input running,\n\n   (* versat_latency = 0 *) input [DATA_W-1:0] in0,\n\n   //input / output data\n   (* versat_latency = 0 *) output reg [DATA_W-1:0] out0,\n\n   input enabled\n);\n\n   always @* begin\n      out0 = {DATA_W{1'b0}};\n      if (running) begin\n          out0 = in0;\n          if (enabled) begin\n             out0[0+:8]  = in0[24+:8];\n             out0[8+:8]  = in0[16+:8];\n             out0[16+:8] = in0[8+:8];\n             out0[24+:8] = in0[0+:8];\n          end\n      end\n   end\n\n   integer i;\n   always @* begin\n      out0 = {DATA_W{1'b0}};\n      if (running) begin\n          out0 = in0;\n          if (enabled) begin\n            for(i=0; i<DATA_W; i=i+8) begin\n               out0[i +: 8] = in0[(DATA_W-8-i) +: 8];\n            end\n          end\n      end\n   end\n\nendmodule\n")};
+String temp_11_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Buffer #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] amount\n);\n\n   wire [  DELAY_W:0] occupancy;\n\n   wire               aboveOrEqual = (occupancy >= {1'b0, amount});\n   wire               belowOrEqual = (occupancy <= {1'b0, amount});\n\n   wire               read_en = (running && aboveOrEqual);\n   wire               write_en = (running && belowOrEqual);\n\n   wire               ext_2p_write;\n   wire [DELAY_W-1:0] ext_2p_addr_out;\n   wire [ DATA_W-1:0] ext_2p_data_out;\n\n   wire               ext_2p_read;\n   wire [DELAY_W-1:0] ext_2p_addr_in;\n   wire [ DATA_W-1:0] ext_2p_data_in;\n\n   my_2p_asym_ram #(\n      .W_DATA_W(DATA_W),\n      .R_DATA_W(DATA_W),\n      .ADDR_W  (DELAY_W)\n   ) ext_2p (\n      // Writting port\n      .w_en_i  (ext_2p_write),\n      .w_addr_i(ext_2p_addr_out),\n      .w_data_i(ext_2p_data_out),\n\n      // Reading port\n      .r_en_i  (ext_2p_read),\n      .r_addr_i(ext_2p_addr_in),\n      .r_data_o(ext_2p_data_in),\n\n      .clk_i(clk)\n   );\n\n   reg  [DATA_W-1:0] inData;\n   wire [DATA_W-1:0] fifo_data;\n   iob_fifo_sync #(\n      .W_DATA_W(DATA_W),\n      .R_DATA_W(DATA_W),\n      .ADDR_W  (DELAY_W)\n   ) fifo (\n      .rst_i (rst),\n      .clk_i (clk),\n      .cke_i (1'b1),\n      .arst_i(1'b0),\n\n      .level_o(occupancy),\n\n      //read port\n      .r_data_o (fifo_data),\n      .r_empty_o(),\n      .r_en_i   (read_en),\n\n      //write port\n      .w_data_i(in0),\n      .w_full_o(),\n      .w_en_i  (write_en),\n\n      //write port\n      .ext_mem_clk_o   (),\n      .ext_mem_w_en_o  (ext_2p_write),\n      .ext_mem_w_addr_o(ext_2p_addr_out),\n      .ext_mem_w_data_o(ext_2p_data_out),\n      //read port\n      .ext_mem_r_en_o  (ext_2p_read),\n      .ext_mem_r_addr_o(ext_2p_addr_in),\n      .ext_mem_r_data_i(ext_2p_data_in)\n   );\n\n   always @(posedge clk) begin\n      if (rst) inData <= 0;\n      else inData <= in0;\n   end\n\n   always @* begin\n      out0 = 0;\n\n      if (amount == 0) out0 = inData;\n      else out0 = fifo_data;\n   end\n\nendmodule\n")};
+String temp_12_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule TestConst #(\n   parameter DATA_W = 32,\n   parameter DELAY_W = 7\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //input / output data\n   output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] delay0,\n\n   input [DATA_W-1:0] constant\n);\n\n   reg [DELAY_W-1:0] delay;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0 <= {DATA_W{1'b0}};\n      end else if (run) begin\n         if (delay0 == 0) begin\n            out0 <= constant;\n         end\n         delay <= delay0;\n      end else if (running & (|delay)) begin\n         delay <= delay - 1;\n         if (delay == 1) begin\n             out0 <= constant;\n         end\n      end else begin\n         out0 <= {DATA_W{1'b0}};\n      end\n   end\n\nendmodule\n")};
+String temp_13_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule DebugWriteMem #(\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter LEN_W      = 8\n) (\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output reg done,\n\n   // Databus interface\n   input                     databus_ready_0,\n   output reg                databus_valid_0,\n   output [  AXI_ADDR_W-1:0] databus_addr_0,\n   input  [  AXI_DATA_W-1:0] databus_rdata_0,\n   output [  AXI_DATA_W-1:0] databus_wdata_0,\n   output [AXI_DATA_W/8-1:0] databus_wstrb_0,\n   output [       LEN_W-1:0] databus_len_0,\n   input                     databus_last_0,\n\n   input [AXI_ADDR_W-1:0]    address,\n   input [31:0]              content,\n   input [LEN_W-1:0]         length\n);\n\n   assign databus_addr_0  = address;\n   assign databus_wstrb_0 = {(AXI_DATA_W/8){1'b1}};\n   assign databus_len_0   = length;\n   assign databus_wdata_0 = content;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         databus_valid_0 <= 1'b0;\n         done <= 1'b1;\n      end else if (run && length != 0) begin\n         databus_valid_0 <= 1'b1;\n         done <= 1'b0;\n      end else if (running) begin\n         if(databus_ready_0 && databus_last_0) begin\n            databus_valid_0 <= 1'b0;\n            done <= 1'b1;\n         end\n      end\n   end\n\nendmodule  // DebugReadMem")};
+String temp_14_CONTENT = {String("`timescale 1ns / 1ps\n\n(* source *) module Reg #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n\n   // native interface \n   input      [         1:0] addr,\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output reg                rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   output reg [DATA_W-1:0]       out0, /* technically should have versat_latency 1 but since it's not a computing unit, output is only used to start a datapath, we save 1 cycle */\n\n   input [DELAY_W-1:0] delay0,\n   input disabled,\n\n   output [DATA_W-1:0] currentValue\n);\n\n   wire lastCycle;\n\n   DelayCalc #(.DELAY_W(DELAY_W)) delay_inst (\n   .clk(clk),\n   .rst(rst),\n\n   .running(running),\n   .run(run),\n   .done(done),\n\n   .lastCycle(lastCycle),\n\n   .delay0(delay0)\n   );\n\n   assign rdata        = (rvalid ? out0 : 0);\n   assign currentValue = out0;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0   <= {DATA_W{1'b0}};\n         rvalid <= 1'b0;\n      end else begin\n         // Native interface\n         rvalid <= 1'b0;\n\n         if (valid & (|wstrb)) begin\n            out0 <= wdata;\n         end\n         if (lastCycle && !disabled) begin\n            out0 <= in0;\n         end\n\n         if (valid & (wstrb == 0)) begin\n            rvalid <= 1'b1;\n         end\n\n      end\n   end\n\nendmodule\n")};
+String temp_15_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule StridedMerge #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //input / output data\n                             input [DATA_W-1:0] in0,\n   (* versat_latency = 1 *)  input [DATA_W-1:0] in1,\n   (* versat_latency = 2 *)  input [DATA_W-1:0] in2,\n   (* versat_latency = 3 *)  input [DATA_W-1:0] in3,\n   (* versat_latency = 4 *)  input [DATA_W-1:0] in4,\n   (* versat_latency = 5 *)  input [DATA_W-1:0] in5,\n   (* versat_latency = 6 *)  input [DATA_W-1:0] in6,\n   (* versat_latency = 7 *)  input [DATA_W-1:0] in7,\n   (* versat_latency = 8 *)  input [DATA_W-1:0] in8,\n   (* versat_latency = 9 *)  input [DATA_W-1:0] in9,\n   (* versat_latency = 10 *) input [DATA_W-1:0] in10,\n   (* versat_latency = 11 *) input [DATA_W-1:0] in11,\n   (* versat_latency = 12 *) input [DATA_W-1:0] in12,\n   (* versat_latency = 13 *) input [DATA_W-1:0] in13,\n   (* versat_latency = 14 *) input [DATA_W-1:0] in14,\n   (* versat_latency = 15 *) input [DATA_W-1:0] in15,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] delay0,\n   input [DELAY_W-1:0] stride\n);\n\n   reg  [DELAY_W-1:0] delay;\n   reg  [DELAY_W-1:0] delay2;\n\n   wire [ DATA_W-1:0] select [15:0];\n\n   assign select[0]  = in0;\n   assign select[1]  = in1;\n   assign select[2]  = in2;\n   assign select[3]  = in3;\n   assign select[4]  = in4;\n   assign select[5]  = in5;\n   assign select[6]  = in6;\n   assign select[7]  = in7;\n   assign select[8]  = in8;\n   assign select[9]  = in9;\n   assign select[10] = in10;\n   assign select[11] = in11;\n   assign select[12] = in12;\n   assign select[13] = in13;\n   assign select[14] = in14;\n   assign select[15] = in15;\n\n   reg [3:0] counter;\n\n   //assign out0 = running ? select[counter] : 0;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         delay   <= 0;\n         counter <= 0;\n      end else if (run) begin\n         delay   <= delay0;\n         counter <= 0;\n         delay2  <= stride;\n      end else if (running) begin\n         if (|delay) begin\n            delay <= delay - 1;\n            if (delay == 1) begin\n               delay2 <= stride;\n            end\n         end else begin\n            if (|delay2) begin\n               delay2 <= delay2 - 1;\n            end\n\n            if (delay2 == 0) begin\n               counter <= counter + 1;\n               delay2  <= stride;\n            end\n         end\n\n\n         out0 <= select[counter];\n      end\n   end\n\nendmodule\n")};
+String temp_16_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Equality #(\n   parameter DATA_W = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0\n);\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0 <= {DATA_W{1'b0}};\n      end else if (running) begin\n         out0 <= (in0 == in1) ? {DATA_W{1'b1}} : {DATA_W{1'b0}};\n      end else begin\n         out0 <= {DATA_W{1'b0}};\n      end\n   end\n\nendmodule\n")};
+String temp_17_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Counter (\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //configurations \n   input [          31:0] start,\n\n   //outputs \n   (* versat_latency = 0 *) output reg [31:0] out0\n);\n\n   always @(posedge clk,posedge rst) begin\n      if(rst) begin\n         out0 <= 0;\n      end else if(run) begin\n         out0 <= start;\n      end else if(running) begin\n         out0 <= out0 + 1;\n      end\n   end\n\nendmodule\n")};
+String temp_18_CONTENT = {String("`timescale 1ns / 1ps\n\n`define MULADD_MACC 1'b0\n\n/*\n\n Description: multiply (accumulate) functions\n\n */\n\nmodule Muladd #(\n   parameter DELAY_W = 7,\n   parameter DATA_W = 32,\n   parameter LOOP_W = 10\n) (\n   input      rst,\n   input      clk,\n   input      run,\n   input      running,\n   output reg done,\n\n                            input  [DATA_W-1:0] in0,\n                            input  [DATA_W-1:0] in1,\n   (* versat_latency = 3 *) output [DATA_W-1:0] out0,\n\n   // config interface\n   input       opcode,\n   input [LOOP_W-1:0] iter,\n   input [LOOP_W-1:0] period,\n\n   input [DELAY_W-1:0] delay0\n);\n\n   reg [DELAY_W-1:0] delay;\n   reg [LOOP_W-1:0] currentIteration;\n   reg [LOOP_W-1:0] currentPeriod;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         done             <= 1'b0;\n         delay            <= {DELAY_W{1'b0}};\n         currentIteration <= {LOOP_W{1'b0}};\n         currentPeriod    <= {LOOP_W{1'b0}};\n      end else if (run) begin\n         delay <= delay0 + 2; // Add 2 because it takes 2 cycles for the accumulator to start working and this whole logic is just the control for the accumulator\n         done <= 1'b0;\n      end else if (running) begin\n         if (|delay) begin\n            delay <= delay - 1;\n            if (iter == 0) begin\n               done <= 1'b1;\n            end\n            currentIteration <= 0;\n            currentPeriod    <= 0;\n         end else if (!done) begin\n            currentPeriod <= currentPeriod + 1;\n\n            if ((currentPeriod + 1) >= period) begin\n               currentPeriod    <= 0;\n\n               currentIteration <= currentIteration + 1;\n               if ((currentIteration + 1) >= iter) begin\n                  done <= 1'b1;\n               end\n            end\n         end\n      end\n   end\n\n   // select multiplier statically\n   reg signed [DATA_W-1:0] in0_reg, in1_reg, dsp_out0;\n   reg signed [2*DATA_W-1:0] acc, result_mult_reg;\n   //DSP48E template\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         in0_reg  <= {DATA_W{1'b0}};\n         in1_reg  <= {DATA_W{1'b0}};\n         dsp_out0 <= {DATA_W{1'b0}};\n         acc      <= {2*DATA_W{1'b0}};\n      end else if (running) begin\n         in0_reg         <= in0;\n         in1_reg         <= in1;\n         result_mult_reg <= in0_reg * in1_reg;\n\n         if (currentPeriod == 0) begin\n            acc <= result_mult_reg;\n         end else begin\n            if (opcode == `MULADD_MACC) acc <= acc + result_mult_reg;\n            else acc <= acc - result_mult_reg;\n         end\n\n         dsp_out0 <= acc[DATA_W-1:0];\n      end\n   end\n\n   assign out0 = dsp_out0;\n\nendmodule\n")};
+String temp_19_CONTENT = {String("`timescale 1ns / 1ps\n\n(* source *) module RegFile #(\n   parameter DELAY_W = 7,\n   parameter ADDR_W  = 6, // 2 + $CLOG(NUMBER_REGS)\n   parameter DATA_W  = 32,\n   parameter AXI_DATA_W = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input      running,\n   input      run,\n   output     done,\n\n   output [    ADDR_W-1:0] ext_2p_addr_out_0,\n   output [    ADDR_W-1:0] ext_2p_addr_in_0,\n   output                  ext_2p_write_0,\n   output                  ext_2p_read_0,\n   input  [AXI_DATA_W-1:0] ext_2p_data_in_0,\n   output [AXI_DATA_W-1:0] ext_2p_data_out_0,\n\n   output [    ADDR_W-1:0] ext_2p_addr_out_1,\n   output [    ADDR_W-1:0] ext_2p_addr_in_1,\n   output                  ext_2p_write_1,\n   output                  ext_2p_read_1,\n   input  [AXI_DATA_W-1:0] ext_2p_data_in_1,\n   output [AXI_DATA_W-1:0] ext_2p_data_out_1,\n\n   // native interface \n   input      [  ADDR_W-1:0] addr,\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output                    rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   (* versat_latency = 2 *) output [DATA_W-1:0] out0,\n   (* versat_latency = 2 *) output [DATA_W-1:0] out1,\n\n   input [3:0]         selectedInput,\n   input [3:0]         selectedOutput0,\n   input [3:0]         selectedOutput1,\n   input disabled,\n   \n   input [DELAY_W-1:0] delay0\n);\n\nwire lastCycle;\nreg ext_read_en;\n\n   DelayCalc #(\n       .DELAY_W(DELAY_W)\n   ) delay_inst (\n   .clk(clk),\n   .rst(rst),\n\n   .running(running),\n   .run(run),\n   .done(done),\n\n   .lastCycle(lastCycle),\n\n   .delay0(delay0)\n   );\n\nreg [ADDR_W-1:0] address0,address1,addressWrite;\nreg write,read;\n\nassign ext_2p_addr_out_0 = addressWrite;\nassign ext_2p_addr_out_1 = addressWrite;\n\nassign ext_2p_addr_in_0 = address0;\nassign ext_2p_addr_in_1 = address1;\n\nassign ext_2p_write_0 = write;\nassign ext_2p_write_1 = write;\n\nassign ext_2p_read_0 = ext_read_en; //read;\nassign ext_2p_read_1 = ext_read_en; //read;\n\nassign out0 = ext_2p_data_in_0;\nassign out1 = ext_2p_data_in_1;\n\nreg [DATA_W-1:0] dataToWrite;\n\nassign ext_2p_data_out_0 = dataToWrite;\nassign ext_2p_data_out_1 = dataToWrite;\n\nreg read_reg,write_reg;\n\nassign rvalid = read_reg | write_reg;\nassign rdata = (rvalid ? ext_2p_data_in_0 : 0);\n\nalways @(posedge clk,posedge rst) begin\n   if(rst) begin\n      write <= 1'b0;\n      read <= 1'b0;\n      read_reg <= 1'b0;\n      write_reg <= 0;\n      dataToWrite <= 0;\n      address0 <= 0;\n      address1 <= 0;\n      ext_read_en <= 1'b0;\n   end else begin\n      write <= 1'b0;\n      read <= 1'b0;\n      read_reg <= read;\n      write_reg <= 0;\n      ext_read_en <= 1'b1;\n\n      address0 <= {selectedOutput0,2'b00};\n      address1 <= {selectedOutput1,2'b00};\n\n      if(lastCycle && !disabled) begin\n         dataToWrite <= in0;\n         addressWrite <= {selectedInput,2'b00};\n         write <= 1'b1;\n      end\n\n      if (valid & (|wstrb)) begin\n         dataToWrite <= wdata;\n         addressWrite <= addr;\n         write <= 1'b1;\n      end\n      if (valid & (wstrb == 0)) begin\n         write_reg <= 1'b1;\n         address0 <= addr;\n         address1 <= addr;\n         read <= 1'b1;\n      end\n   end\nend\n\nendmodule\n")};
+String temp_20_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Merge #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //input / output data\n                             input [DATA_W-1:0] in0,\n   (* versat_latency = 1 *)  input [DATA_W-1:0] in1,\n   (* versat_latency = 2 *)  input [DATA_W-1:0] in2,\n   (* versat_latency = 3 *)  input [DATA_W-1:0] in3,\n   (* versat_latency = 4 *)  input [DATA_W-1:0] in4,\n   (* versat_latency = 5 *)  input [DATA_W-1:0] in5,\n   (* versat_latency = 6 *)  input [DATA_W-1:0] in6,\n   (* versat_latency = 7 *)  input [DATA_W-1:0] in7,\n   (* versat_latency = 8 *)  input [DATA_W-1:0] in8,\n   (* versat_latency = 9 *)  input [DATA_W-1:0] in9,\n   (* versat_latency = 10 *) input [DATA_W-1:0] in10,\n   (* versat_latency = 11 *) input [DATA_W-1:0] in11,\n   (* versat_latency = 12 *) input [DATA_W-1:0] in12,\n   (* versat_latency = 13 *) input [DATA_W-1:0] in13,\n   (* versat_latency = 14 *) input [DATA_W-1:0] in14,\n   (* versat_latency = 15 *) input [DATA_W-1:0] in15,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] delay0\n);\n\n   reg  [DELAY_W-1:0] delay;\n\n   wire [ DATA_W-1:0] select[15:0];\n\n   assign select[0]  = in0;\n   assign select[1]  = in1;\n   assign select[2]  = in2;\n   assign select[3]  = in3;\n   assign select[4]  = in4;\n   assign select[5]  = in5;\n   assign select[6]  = in6;\n   assign select[7]  = in7;\n   assign select[8]  = in8;\n   assign select[9]  = in9;\n   assign select[10] = in10;\n   assign select[11] = in11;\n   assign select[12] = in12;\n   assign select[13] = in13;\n   assign select[14] = in14;\n   assign select[15] = in15;\n\n   reg [3:0] counter;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         delay   <= {DELAY_W{1'b0}};\n         counter <= 4'b0;\n      end else if (run) begin\n         delay   <= delay0;\n         counter <= 4'b0;\n      end else if (running) begin\n         if (|delay) begin\n            delay <= delay - 1;\n         end\n\n         if (delay == 0) begin\n            counter <= counter + 1;\n         end\n\n         out0 <= select[counter];\n      end\n   end\n\nendmodule\n")};
+String temp_21_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule CombMux4 #(\n   parameter DATA_W = 32\n) (\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n   input [DATA_W-1:0] in2,\n   input [DATA_W-1:0] in3,\n\n   (* versat_latency = 0 *) output reg [DATA_W-1:0] out0,\n\n   input [1:0] sel\n);\n\n   always @* begin\n      case (sel)\n         2'b00: out0 = in0;\n         2'b01: out0 = in1;\n         2'b10: out0 = in2;\n         2'b11: out0 = in3;\n      endcase\n   end\n\nendmodule\n")};
+String temp_22_CONTENT = {String("`timescale 1ns / 1ps\n\n/*\n\n Description: multiply functions\n\n */\n\nmodule Mul #(\n   parameter DATA_W = 32\n) (\n   input rst,\n   input clk,\n   input running,\n\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 4 *) output [DATA_W-1:0] out0\n\n);\n\n   // select multiplier statically\n   reg signed [DATA_W-1:0] in0_reg, in1_reg, dsp_out0, acc, result_mult_reg;\n   //DSP48E template\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         in0_reg         <= {DATA_W{1'b0}};\n         in1_reg         <= {DATA_W{1'b0}};\n         dsp_out0        <= {DATA_W{1'b0}};\n         result_mult_reg <= {DATA_W{1'b0}};\n         acc             <= {DATA_W{1'b0}};\n      end else if (running) begin\n         in0_reg         <= in0;\n         in1_reg         <= in1;\n         result_mult_reg <= in0_reg * in1_reg;\n         acc             <= result_mult_reg;\n         dsp_out0        <= acc;\n      end\n   end\n\n   assign out0 = dsp_out0;\n\nendmodule\n")};
+String temp_23_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Mux2 #(\n   parameter DATA_W = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input sel\n);\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0 <= {DATA_W{1'b0}};\n      end else if (running) begin\n        if (sel) begin\n           out0 <= in1;\n        end else begin\n           out0 <= in0;\n        end\n      end\n   end\n\nendmodule\n")};
+String temp_24_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule DoneCycle #(\n    parameter DATA_W = 32\n\n) (\n   //control\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n\n   input [DATA_W-1:0] amount\n);\n\n   reg [DATA_W-1:0] counter;\n\n   assign done = (counter == {DATA_W{1'b0}});\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         counter <= 0;\n      end else if (run) begin\n         counter <= amount;\n      end else if (running & (|counter)) begin\n         counter <= counter - 1;\n      end else begin\n         counter <= counter;\n      end\n   end\n\nendmodule\n")};
+String temp_25_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Store #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input      running,\n   input      run,\n   output reg done,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n\n   input [DELAY_W-1:0] delay0,  // delay\n\n   output reg [DATA_W-1:0] currentValue  // state\n);\n\n   reg [DELAY_W-1:0] delay;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         currentValue <= {DATA_W{1'b0}};\n         delay        <= {DELAY_W{1'b0}};\n         done         <= 1'b1;\n      end else if (run) begin\n         done  <= 1'b0;\n         delay <= delay0;\n      end else if (running) begin\n         if (|delay) delay <= delay - 1;\n\n         if (delay == 0) begin\n            currentValue <= in0;\n            done         <= 1'b1;\n         end\n      end\n   end\n\nendmodule\n\n\n\n\n\n")};
+String temp_26_CONTENT = {String("`timescale 1ns / 1ps\n\n`define COMPLEX_INTERFACE\n\nmodule OnlyOutputMem #(\n   parameter DATA_W        = 32,\n   parameter SIZE_W        = 32,\n   parameter DELAY_W       = 7,\n   parameter ADDR_W        = 12,\n   parameter PERIOD_W      = 10\n) (\n   //control\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n   input  disabled,\n\n   //databus interface\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  ADDR_W-1:0] addr,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output reg                rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   //input / output data\n   (* versat_latency = 2 *) output [DATA_W-1:0] out0,\n\n   // External memory\n   output [    ADDR_W-1:0] ext_2p_addr_out_0,\n   output [    ADDR_W-1:0] ext_2p_addr_in_0,\n   output                  ext_2p_write_0,\n   output                  ext_2p_read_0,\n   input  [DATA_W-1:0] ext_2p_data_in_0,\n   output [DATA_W-1:0] ext_2p_data_out_0,\n\n   // Configuration\n   input [ADDR_W-1:0] iterA,\n   input [PERIOD_W-1:0] perA,\n   input [PERIOD_W-1:0] dutyA,\n   input [ADDR_W-1:0] startA,\n   input [ADDR_W-1:0] shiftA,\n   input [ADDR_W-1:0] incrA,\n   input [DELAY_W-1:0] delay0\n);\n\n   wire we = |wstrb;\n\n   wire doneA;\n\n   //output databus\n   reg [DATA_W-1:0] outA_reg;\n\n   assign out0 = running ? outA_reg : 0;\n\n   assign done = doneA;\n\n   //port addresses and enables\n   wire [ADDR_W-1:0] addrA;\n   wire enA;\n   wire ready_int = ~rst;\n\n   //address generators\n\n   AddressGen #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(SIZE_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenA (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .per_i(perA),\n      .start_i (startA),\n      .incr_i  (incrA),\n      .delay_i (delay0),\n\n`ifdef COMPLEX_INTERFACE\n      .iter_i(iterA),\n      .duty_i      (dutyA),\n      .shift_i     (shiftA),\n`endif\n\n      //outputs \n      .valid_o(enA),\n      .ready_i(ready_int),\n      .addr_o (addrA),\n      .store_o(), // TODO: Handle duty\n\n      .done_o (doneA)\n   );\n   \n   //register mem inputs\n   reg [DATA_W-1:0] data_a_reg;\n   reg [ADDR_W-1:0] addr_a_reg;\n   reg we_a_reg;\n   always @(posedge clk,posedge rst) begin\n      if(rst) begin\n         data_a_reg <= 0;\n         addr_a_reg <= 0;\n         we_a_reg   <= 0;\n      end else begin\n         data_a_reg <= wdata;\n         addr_a_reg <= addr;\n         we_a_reg   <= valid & we;\n      end\n   end\n\n   assign ext_2p_addr_out_0 = addr_a_reg;\n   assign ext_2p_write_0    = we_a_reg;\n   assign ext_2p_data_out_0 = data_a_reg;\n\n   assign ext_2p_addr_in_0 = addrA;\n   assign ext_2p_read_0    = enA;\n   \n   //register mem outputs\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         outA_reg <= 0;\n      end else begin\n         outA_reg <= ext_2p_data_in_0;  //outA;\n      end\n   end\n\nendmodule\n\n`undef COMPLEX_INTERFACE\n")};
+String temp_27_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Conditional (\n   input clk,\n   input rst,\n\n   input running,\n\n   input [31:0] in0,  // Selector\n   input [31:0] in1,\n   input [31:0] in2,\n\n   (* versat_latency = 1 *) output reg [31:0] out0\n);\n\nalways @(posedge clk, posedge rst) begin\n   if(rst) begin\n      out0[31:0] <= 0;\n   end else if (running) begin\n      if (|in0) begin\n         out0[31:0] <= in1[31:0];\n      end else begin\n         out0[31:0] <= in2[31:0];\n         end\n   end\nend\n\nendmodule\n")};
+String temp_28_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule TimedMux #(\n   parameter DATA_W = 32,\n   parameter DELAY_W = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] delay0\n);\n\n   reg [DELAY_W-1:0] delay;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         delay <= 0;\n      end else if (run) begin\n         delay <= delay0 + 1;\n      end else if (running && |delay) begin\n         delay <= delay - 1;\n         out0  <= in0;\n      end else if (running) begin\n         out0 <= in1;\n      end\n   end\n\nendmodule\n")};
+String temp_29_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule VWrite #(\n   parameter DATA_W     = 32,  // Internal datapath width\n   parameter ADDR_W     = 16,\n   parameter PERIOD_W   = 14,  // Must be 2 less than ADDR_W (boundary of 4) (for 32 bit DATA_W)\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,  // External databus width\n   parameter DELAY_W    = 7,\n   parameter LEN_W      = 16\n) (\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n\n   // Databus interface\n   input                     databus_ready_0,\n   output                    databus_valid_0,\n   output [  AXI_ADDR_W-1:0] databus_addr_0,\n   input  [  AXI_DATA_W-1:0] databus_rdata_0,\n   output [  AXI_DATA_W-1:0] databus_wdata_0,\n   output [AXI_DATA_W/8-1:0] databus_wstrb_0,\n   output [       LEN_W-1:0] databus_len_0,\n   input                     databus_last_0,\n\n   // input / output data\n   input [DATA_W-1:0] in0,\n\n   // External memory\n   output [    ADDR_W-1:0] ext_2p_addr_out_0,\n   output [    ADDR_W-1:0] ext_2p_addr_in_0,\n   output                  ext_2p_write_0,\n   output                  ext_2p_read_0,\n   input  [AXI_DATA_W-1:0] ext_2p_data_in_0,\n   output [    DATA_W-1:0] ext_2p_data_out_0,\n\n   // configurations\n   (* versat_stage=\"Write\" *) input [AXI_ADDR_W-1:0] ext_addr,\n\n   (* versat_stage=\"Write\" *) input [    ADDR_W-1:0] amount_minus_one,\n   (* versat_stage=\"Write\" *) input [     LEN_W-1:0] length,\n   (* versat_stage=\"Write\" *) input                  enabled,\n   (* versat_stage=\"Write\" *) input [AXI_ADDR_W-1:0] addr_shift,\n\n   input pingPong,\n\n   input [  ADDR_W-1:0] iter,\n   input [PERIOD_W-1:0] per,\n   input [PERIOD_W-1:0] duty,\n   input [  ADDR_W-1:0] start,\n   input [  ADDR_W-1:0] shift,\n   input [  ADDR_W-1:0] incr,\n\n   input [  ADDR_W-1:0] iter2,\n   input [PERIOD_W-1:0] per2,\n   input [  ADDR_W-1:0] shift2,\n   input [  ADDR_W-1:0] incr2,\n\n   input [  ADDR_W-1:0] iter3,\n   input [PERIOD_W-1:0] per3,\n   input [  ADDR_W-1:0] shift3,\n   input [  ADDR_W-1:0] incr3,\n\n   input          ignore_first,\n   input [20-1:0] extra_delay,\n\n   input [DELAY_W-1:0] delay0\n);\n   localparam DELAY_STORE_W = (DELAY_W > 20) ? DELAY_W : 20;\n   localparam EXTRA_DELAY_W = 20;\n\n   //reg  doneWrite; // Databus write part\n   wire transferDone;\n   reg  doneStore;\n   wire doneStore_int;\n   assign done = (transferDone & doneStore);\n\n   wire data_valid, data_ready;\n   wire [   AXI_DATA_W-1:0] data_data;\n   wire [DELAY_STORE_W-1:0] delay_store;\n\n   generate\n      if (DELAY_W < EXTRA_DELAY_W) begin : gen_delay_smaller\n         assign delay_store = {{(EXTRA_DELAY_W - DELAY_W) {1'b0}}, delay0} + extra_delay;\n      end else if (DELAY_W > EXTRA_DELAY_W) begin : gen_delay_bigger\n         assign delay_store = {{(DELAY_W - EXTRA_DELAY_W) {1'b0}}, extra_delay} + delay0;\n      end else begin : gen_delay_equal\n         assign delay_store = delay0 + extra_delay;\n      end\n   endgenerate\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         doneStore <= 1'b1;\n      end else if (run) begin\n         doneStore <= 1'b0;\n      end else if (running) begin\n         doneStore <= doneStore_int;\n      end\n   end\n\n   // Ping pong and related logic for the initial address\n   reg pingPongState;\n\n   // Ping pong \n   always @(posedge clk, posedge rst) begin\n      if (rst) pingPongState <= 0;\n      else if (run) pingPongState <= pingPong ? (!pingPongState) : 1'b0;\n   end\n\n   //wire [ADDR_W-1:0] start = {pingPong && !pingPongState , {(ADDR_W-1){1'b0}}};\n\n   // port addresses and enables\n   wire [ADDR_W-1:0] store_addr_temp;\n\n   // mem enables output by addr gen\n   wire store_en, do_store;\n\n   wire [DATA_W-1:0] store_data = in0;\n\n   reg  [ADDR_W-1:0] gen_addr_temp;\n   reg               gen_valid;\n   wire              gen_ready;\n\n   localparam OFFSET_TEMP = AXI_DATA_W / 8;\n   localparam [ADDR_W-1:0] OFFSET_W = OFFSET_TEMP[ADDR_W-1:0];\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         gen_addr_temp <= 0;\n      end else if(run && enabled && length != 0) begin\n         gen_addr_temp <= 0;\n         gen_valid     <= 1'b1;\n      end else begin\n         if (gen_valid && gen_ready) begin\n            gen_addr_temp <= gen_addr_temp + OFFSET_W;\n         end\n         if (!running) begin\n            gen_valid <= 0;\n         end\n      end\n   end\n\n   wire [ADDR_W-1:0] amount;\n   assign amount = amount_minus_one + 1'b1;\n\n   SuperAddress #(\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .LEN_W     (LEN_W),\n      .COUNT_W   (ADDR_W),\n      .ADDR_W    (ADDR_W),\n      .DATA_W    (DATA_W),\n      .PERIOD_W  (PERIOD_W),\n      .DELAY_W   (1)\n   ) writer (\n      .clk_i (clk),\n      .rst_i (rst),\n      .run_i (run && enabled && (length != 0)),\n      .done_o(transferDone),\n\n      .ignore_first_i(1'b0),\n\n      //configurations \n      .per_i  ({PERIOD_W{1'b0}}),\n      .delay_i(1'b0),\n      //.start_i (0),\n      .start_i(0),\n      .incr_i ({ADDR_W{1'b0}}),\n      .iter_i ({ADDR_W{1'b0}}),\n      .duty_i ({PERIOD_W{1'b0}}),\n      .shift_i({ADDR_W{1'b0}}),\n\n      .per2_i  ({PERIOD_W{1'b0}}),\n      .incr2_i ({ADDR_W{1'b0}}),\n      .iter2_i ({ADDR_W{1'b0}}),\n      .shift2_i({ADDR_W{1'b0}}),\n\n      .per3_i  ({PERIOD_W{1'b0}}),\n      .incr3_i ({ADDR_W{1'b0}}),\n      .iter3_i ({ADDR_W{1'b0}}),\n      .shift3_i({ADDR_W{1'b0}}),\n\n      .doneDatabus(),\n      .doneAddress(),\n\n      .valid_o(),\n      .ready_i(1'b1),\n      .addr_o (),\n      .store_o(),\n\n      .databus_ready(databus_ready_0),\n      .databus_valid(databus_valid_0),\n      .databus_addr (databus_addr_0),\n      .databus_len  (databus_len_0),\n      .databus_last (databus_last_0),\n\n      // Data interface\n      .data_valid_i(data_valid),\n      .data_ready_i(1'b1),\n      .reading     (1'b0),\n\n      .count_i        (amount),\n      .start_address_i(ext_addr),\n      .address_shift_i(addr_shift),\n      .databus_length (length)\n   );\n\n   assign data_ready      = databus_ready_0;\n   assign databus_wstrb_0 = ~0;\n   assign databus_wdata_0 = data_data;\n\n   wire [ADDR_W-1:0] gen_addr = {\n      pingPong ? !pingPongState : gen_addr_temp[ADDR_W-1], gen_addr_temp[ADDR_W-2:0]\n   };\n\n   AddressGen3 #(\n      .ADDR_W  (ADDR_W),\n      .DATA_W  (DATA_W),\n      .DELAY_W (DELAY_STORE_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenStore (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run),\n\n      .ignore_first_i(ignore_first),\n\n      //configurations \n      .per_i  (per),\n      .delay_i(delay_store),\n      .start_i({1'b0, start[ADDR_W-2:0]}),\n      .incr_i (incr),\n\n      .iter_i (iter),\n      .duty_i (duty),\n      .shift_i(shift),\n\n      .per2_i  (per2),\n      .incr2_i (incr2),\n      .iter2_i (iter2),\n      .shift2_i(shift2),\n\n      .per3_i  (per3),\n      .incr3_i (incr3),\n      .iter3_i (iter3),\n      .shift3_i(shift3),\n\n      //outputs \n      .valid_o(store_en),\n      .ready_i(1'b1),\n      .addr_o (store_addr_temp),\n      .store_o(do_store),\n      .done_o (doneStore_int)\n   );\n\n   wire [ADDR_W-1:0] store_addr = {\n      pingPong ? pingPongState : store_addr_temp[ADDR_W-1], store_addr_temp[ADDR_W-2:0]\n   };\n\n   wire read_en;\n   wire [ADDR_W-1:0] read_addr;\n   wire [AXI_DATA_W-1:0] read_data;\n\n   MemoryReader #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(AXI_DATA_W)\n   ) reader (\n      // Slave\n      .s_valid_i(gen_valid),\n      .s_ready_o(gen_ready),\n      .s_addr_i (gen_addr),\n\n      // Master\n      .m_valid_o(data_valid),\n      .m_ready_i(data_ready),\n      .m_addr_o (),\n      .m_data_o (data_data),\n      .m_last_i (1'b0),\n\n      // Connect to memory\n      .mem_enable_o(read_en),\n      .mem_addr_o  (read_addr),\n      .mem_data_i  (read_data),\n\n      .force_reset_i(!running || run),\n\n      .clk_i(clk),\n      .rst_i(rst)\n   );\n\n   assign ext_2p_write_0    = store_en && do_store;\n   assign ext_2p_addr_out_0 = store_addr;\n   assign ext_2p_data_out_0 = store_data;\n\n   assign ext_2p_read_0     = read_en;\n   assign ext_2p_addr_in_0  = read_addr;\n   assign read_data         = ext_2p_data_in_0;\n\n   reg reportedA;\n   reg reportedB;\n   reg reportedC;\n\n   // Reports most common errors\n   always @(posedge clk) begin\n      if (run) begin\n         reportedA <= 1'b0;\n      end else if (pingPong && gen_addr_temp[ADDR_W-1] && reportedA == 1'b0) begin\n         $display(\"%m: Overflow of memory when using PingPong for reading\");\n         reportedA <= 1'b1;\n      end\n   end\n\n   always @(posedge clk) begin\n      if (run) begin\n         reportedB <= 1'b0;\n      end else if (pingPong && store_addr_temp[ADDR_W-1] && reportedB == 1'b0) begin\n         $display(\"%m: Overflow of write memory when using PingPong for outputting\");\n         reportedB <= 1'b1;\n      end\n   end\n\n   always @(posedge clk) begin\n      if (run) begin\n         reportedC <= 1'b0;\n      end else if (pingPong && start[ADDR_W-1] && reportedC == 1'b0) begin\n         $display(\"%m: Last bit of output start ignored when using PingPong\");\n         reportedC <= 1'b1;\n      end\n   end\n\nendmodule  // VWrite\n")};
+String temp_30_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule LookupTable #(\n   parameter DATA_W        = 32,\n   parameter SIZE_W        = 32,\n   parameter ADDR_W        = 8\n) (\n   //databus interface\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  ADDR_W-1:0] addr,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output reg                rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 3 *) output reg [DATA_W-1:0] out0,\n   (* versat_latency = 3 *) output reg [DATA_W-1:0] out1,\n\n   output [ADDR_W-1:0] ext_dp_addr_0_port_0,\n   output [DATA_W-1:0] ext_dp_out_0_port_0,\n   input  [DATA_W-1:0] ext_dp_in_0_port_0,\n   output              ext_dp_enable_0_port_0,\n   output              ext_dp_write_0_port_0,\n\n   output [ADDR_W-1:0] ext_dp_addr_0_port_1,\n   output [DATA_W-1:0] ext_dp_out_0_port_1,\n   input  [DATA_W-1:0] ext_dp_in_0_port_1,\n   output              ext_dp_enable_0_port_1,\n   output              ext_dp_write_0_port_1,\n\n   input running,\n   input clk,\n   input rst\n);\n\n   assign rdata = 0;\n\n   reg [DATA_W-1:0] data;\n   reg              write;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         data     <= {DATA_W{1'b0}};\n         write    <= 1'b0;\n         rvalid   <= 1'b0;\n      end else begin\n         write  <= 1'b0;\n         rvalid <= 1'b0;\n\n         if (valid && wstrb == 0) begin\n            rvalid <= 1'b1;\n         end\n\n         if (valid && |wstrb) begin\n            data     <= wdata;\n            write    <= 1'b1;\n         end\n      end\n   end\n\n   assign ext_dp_out_0_port_0    = data;\n   assign ext_dp_enable_0_port_0 = 1'b1;\n   assign ext_dp_write_0_port_0  = write;\n\n   assign ext_dp_out_0_port_1    = 0;\n   assign ext_dp_enable_0_port_1 = 1'b1;\n   assign ext_dp_write_0_port_1  = 1'b0;\n\n   localparam DIFF = DATA_W / SIZE_W;\n   localparam DECISION_BIT_W = $clog2(DIFF);\n\n   reg [ADDR_W-1:0] addr_0_reg,addr_1_reg;\n\n   always @(posedge clk,posedge rst) begin\n      if(rst) begin\n         addr_0_reg <= 0;\n         addr_1_reg <= 0;\n      end else begin\n         if (valid && |wstrb) begin\n            addr_0_reg <= addr;\n         end else begin\n            addr_0_reg <= in0[ADDR_W-1:0];\n         end\n         addr_1_reg <= in1[ADDR_W-1:0];\n      end\n   end\n\n   assign ext_dp_addr_0_port_0 = addr_0_reg;\n   assign ext_dp_addr_0_port_1 = addr_1_reg;\n\n   wire [DATA_W-1:0] outA_int,outB_int;\n\n   generate\n      if (SIZE_W == DATA_W) begin\n         assign outA_int = ext_dp_in_0_port_0;\n         assign outB_int = ext_dp_in_0_port_1;\n      end else begin\n         reg [DECISION_BIT_W-1:0] sel_A, sel_B;\n         reg [DECISION_BIT_W-1:0] sel_A_reg, sel_B_reg;\n\n         always @(posedge clk, posedge rst) begin\n            if (rst) begin\n               sel_A <= 0;\n               sel_B <= 0;\n            end else begin\n               sel_A_reg <= in0[DECISION_BIT_W-1:0];\n               sel_B_reg <= in1[DECISION_BIT_W-1:0];\n               sel_A <= sel_A_reg;\n               sel_B <= sel_B_reg;\n            end\n         end\n\n         WideAdapter #(\n            .INPUT_W (DATA_W),\n            .SIZE_W  (SIZE_W),\n            .OUTPUT_W(DATA_W)\n         ) adapter_a (\n            .sel_i(sel_A),\n            .in_i (ext_dp_in_0_port_0),\n            .out_o(outA_int)\n         );\n\n         WideAdapter #(\n            .INPUT_W (DATA_W),\n            .SIZE_W  (SIZE_W),\n            .OUTPUT_W(DATA_W)\n         ) adapter_b (\n            .sel_i(sel_B),\n            .in_i (ext_dp_in_0_port_1),\n            .out_o(outB_int)\n         );\n      end\n   endgenerate\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0 <= 0;\n         out1 <= 0;\n      end else if (running) begin\n         out0 <= outA_int;\n         out1 <= outB_int;\n      end else begin\n         out0 <= 0;\n         out1 <= 0;\n      end\n   end\n\nendmodule\n")};
+String temp_31_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule VRead #(\n   parameter DATA_W     = 32,\n   parameter ADDR_W     = 18,\n   parameter PERIOD_W   = 16, // Must be 2 less than ADDR_W (boundary of 4) (for 32 bit DATA_W)\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter DELAY_W    = 7,\n   parameter LEN_W      = 16\n) (\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n\n   // Databus interface\n   input                         databus_ready_0,\n   output                        databus_valid_0,\n   output     [  AXI_ADDR_W-1:0] databus_addr_0,\n   input      [  AXI_DATA_W-1:0] databus_rdata_0,\n   output     [  AXI_DATA_W-1:0] databus_wdata_0,\n   output     [AXI_DATA_W/8-1:0] databus_wstrb_0,\n   output     [       LEN_W-1:0] databus_len_0,\n   input                         databus_last_0,\n\n   // input / output data\n   (* versat_latency = 1 *) output [DATA_W-1:0] out0,\n\n   // External memory\n   output [    ADDR_W-1:0] ext_2p_addr_out_0,\n   output [    ADDR_W-1:0] ext_2p_addr_in_0,\n   output                  ext_2p_write_0,\n   output                  ext_2p_read_0,\n   input  [AXI_DATA_W-1:0] ext_2p_data_in_0,\n   output [AXI_DATA_W-1:0] ext_2p_data_out_0,\n\n   (* versat_stage=\"Read\" *) input [AXI_ADDR_W-1:0] ext_addr,\n   (* versat_stage=\"Read\" *) input                  pingPong,\n\n   (* versat_stage=\"Read\" *) input [    ADDR_W-1:0] amount_minus_one,\n   (* versat_stage=\"Read\" *) input [     LEN_W-1:0] length,\n   (* versat_stage=\"Read\" *) input [AXI_ADDR_W-1:0] addr_shift,\n\n   (* versat_stage=\"Read\" *) input enabled,\n\n   input [  ADDR_W-1:0] iter,\n   input [PERIOD_W-1:0] per,\n   input [PERIOD_W-1:0] duty,\n   input [  ADDR_W-1:0] start,\n   input [  ADDR_W-1:0] shift,\n   input [  ADDR_W-1:0] incr,\n   input [  ADDR_W-1:0] iter2,\n   input [PERIOD_W-1:0] per2,\n   input [  ADDR_W-1:0] shift2,\n   input [  ADDR_W-1:0] incr2,\n   input [  ADDR_W-1:0] iter3,\n   input [PERIOD_W-1:0] per3,\n   input [  ADDR_W-1:0] shift3,\n   input [  ADDR_W-1:0] incr3,\n\n   input [DELAY_W-1:0]  extra_delay,\n   input                ignore_first,\n\n   input [DELAY_W-1:0] delay0\n);\n\n   //assign databus_wdata_0 = 0;\n   //assign databus_wstrb_0 = 0;\n   //assign databus_len_0   = length;\n\n   // output databus\n   wire              transferDone;\n   reg               doneOutput;\n   wire              doneOutput_int;\n\n   assign done = (transferDone  & doneOutput);\n\n   wire data_valid,data_ready;\n   wire [AXI_DATA_W-1:0] data_data;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         doneOutput <= 1'b1;\n      end else if (run) begin\n         doneOutput <= 1'b0;\n      end else begin\n         if (doneOutput_int) doneOutput <= 1'b1;\n      end\n   end\n\n   // Ping pong and related logic for the initial address\n   reg pingPongState;\n\n   // port addresses and enables\n   wire [ADDR_W-1:0] output_addr_temp;\n\n   // Ping pong \n   always @(posedge clk, posedge rst) begin\n      if (rst) pingPongState <= 0;\n      else if (run) pingPongState <= pingPong ? (!pingPongState) : 1'b0;\n   end\n\n   wire [ADDR_W-1:0] amount;\n   assign amount = amount_minus_one + 1'b1;\n   \n   //wire [ADDR_W-1:0] gen_addr_temp;\n   //wire gen_valid, gen_ready;\n\n   reg [ADDR_W-1:0] gen_addr_temp;\n   reg gen_valid;\n   wire gen_ready;\n\n   localparam OFFSET_TEMP = AXI_DATA_W / 8;\n   localparam [ADDR_W-1:0] OFFSET_W = OFFSET_TEMP[ADDR_W-1:0];\n\n   always @(posedge clk,posedge rst) begin\n      if(rst) begin\n         gen_addr_temp <= 0;\n      end else if(run && enabled && length != 0) begin\n         gen_addr_temp <= 0;\n         gen_valid <= 1'b1;\n      end else begin\n         if(gen_valid && gen_ready) begin\n            gen_addr_temp <= gen_addr_temp + OFFSET_W;\n         end\n         if(!running) begin\n            gen_valid <= 0;\n         end\n      end\n   end\n\n   SuperAddress #(\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .LEN_W(LEN_W),\n      .COUNT_W(ADDR_W),\n      .ADDR_W(ADDR_W),\n      .DATA_W(DATA_W),\n      .PERIOD_W(PERIOD_W),\n      .DELAY_W(1)\n      ) reader (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && enabled && length != 0),\n      .done_o(transferDone),\n\n      .ignore_first_i(1'b0),\n\n      .per_i({PERIOD_W{1'b0}}),\n      .delay_i (1'b0),\n      .start_i ({ADDR_W{1'b0}}),\n      .incr_i  ({ADDR_W{1'b0}}),\n\n      .iter_i({ADDR_W{1'b0}}),\n      .duty_i      ({PERIOD_W{1'b0}}),\n      .shift_i     ({ADDR_W{1'b0}}),\n\n      .per2_i({PERIOD_W{1'b0}}),\n      .incr2_i({ADDR_W{1'b0}}),\n      .iter2_i({ADDR_W{1'b0}}),\n      .shift2_i({ADDR_W{1'b0}}),\n\n      .per3_i({PERIOD_W{1'b0}}),\n      .incr3_i({ADDR_W{1'b0}}),\n      .iter3_i({ADDR_W{1'b0}}),\n      .shift3_i({ADDR_W{1'b0}}),\n\n      .doneDatabus(),\n      .doneAddress(),\n\n      //outputs \n      //.valid_o(gen_valid), // gen_valid\n      //.ready_i(gen_ready), // gen_ready\n      //.addr_o (gen_addr_temp), // gen_addr_temp\n\n      .valid_o(),\n      .ready_i(1'b1),\n      .addr_o (),\n\n      .store_o(),\n\n      .databus_ready(databus_ready_0),\n      .databus_valid(databus_valid_0),\n      .databus_addr(databus_addr_0),\n      .databus_len(databus_len_0),\n      .databus_last(databus_last_0),\n\n      // Data interface\n      .data_valid_i(1'b0),\n      .data_ready_i(data_ready),\n      .reading(1'b1),\n\n      .count_i(amount),\n      .start_address_i(ext_addr),\n      .address_shift_i(addr_shift),\n      .databus_length(length)\n   );\n\nassign databus_wdata_0 = 0;\nassign databus_wstrb_0 = 0;\nassign data_valid = databus_ready_0;\nassign data_data = databus_rdata_0;\n\n   wire [ADDR_W-1:0] gen_addr = {pingPong ? !pingPongState : gen_addr_temp[ADDR_W-1],gen_addr_temp[ADDR_W-2:0]};\n\n   // mem enables output by addr gen\n   wire output_enabled;\n\n   AddressGen3 #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(DATA_W),\n      .PERIOD_W(PERIOD_W),\n      .DELAY_W(DELAY_W)\n   ) addrgenOutput (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run),\n\n      .ignore_first_i(ignore_first),\n\n      //configurations \n      .per_i(per),\n      .delay_i (delay0 + extra_delay),\n      .start_i ({1'b0,start[ADDR_W-2:0]}),\n      .incr_i  (incr),\n\n      .iter_i(iter),\n      .duty_i      (duty),\n      .shift_i     (shift),\n\n      .per2_i(per2),\n      .incr2_i(incr2),\n      .iter2_i(iter2),\n      .shift2_i(shift2),\n\n      .per3_i(per3),\n      .incr3_i(incr3),\n      .iter3_i(iter3),\n      .shift3_i(shift3),\n\n      //outputs \n      .valid_o(output_enabled),\n      .ready_i(1'b1),\n      .addr_o (output_addr_temp),\n      .store_o(),\n      .done_o (doneOutput_int)\n   );\n\n   wire [ADDR_W-1:0] true_output_addr = output_addr_temp;\n\n   /*\n      Basically, I need to have VRead simulate a initial loop of 17 but then go back to looping 16.\n\n   */\n\n   wire [ADDR_W-1:0] output_addr = {pingPong ? pingPongState : true_output_addr[ADDR_W-1],true_output_addr[ADDR_W-2:0]};\n\n   wire                  write_en;\n   wire [    ADDR_W-1:0] write_addr;\n   wire [AXI_DATA_W-1:0] write_data;\n\n   JoinTwoHandshakes #(\n      .FIRST_DATA_W(ADDR_W),\n      .SECOND_DATA_W(AXI_DATA_W)\n   ) writer (\n      .first_valid_i(gen_valid),\n      .first_ready_o(gen_ready),\n      .first_data_i(gen_addr),\n\n      .second_valid_i(data_valid),\n      .second_ready_o(data_ready),\n      .second_data_i(data_data),\n\n      .result_valid_o(write_en),\n      .result_ready_i(1'b1),\n      .result_first_data_o(write_addr),\n      .result_second_data_o(write_data),\n\n      .forceReset(!running || run),\n\n      .clk_i(clk),\n      .rst_i(rst)\n   );\n\n   localparam DIFF = AXI_DATA_W / DATA_W;\n   localparam DECISION_BIT_W = $clog2(DIFF);\n   localparam DECISION_BIT_START = $clog2(DATA_W / 8);\n\n   generate\n      if (AXI_DATA_W > DATA_W) begin\n         reg [DECISION_BIT_W-1:0] sel_0;  // Matches addr_0_port_0\n         always @(posedge clk, posedge rst) begin\n            if (rst) begin\n               sel_0 <= 0;\n            end else begin\n               sel_0 <= output_addr[DECISION_BIT_START+:DECISION_BIT_W];\n            end\n         end\n\n         WideAdapter #(\n            .INPUT_W (AXI_DATA_W),\n            .OUTPUT_W(DATA_W),\n            .SIZE_W  (DATA_W)\n         ) adapter (\n            .sel_i(sel_0),\n            .in_i (ext_2p_data_in_0),\n            .out_o(out0)\n         );\n      end else begin\n         assign out0 = ext_2p_data_in_0;\n      end  // if(AXI_DATA_W > DATA_W)\n   endgenerate\n\n   assign ext_2p_write_0    = write_en;\n   assign ext_2p_addr_out_0 = write_addr;\n   assign ext_2p_data_out_0 = write_data;\n\n   assign ext_2p_read_0     = output_enabled;\n   assign ext_2p_addr_in_0  = output_addr;\n\n   reg reportedA;\n   reg reportedB;\n   reg reportedC;\n\n   // Reports most common errors\n   always @(posedge clk) begin\n      if(run) begin\n         reportedA <= 1'b0;\n      end else if(pingPong && gen_addr_temp[ADDR_W-1] && reportedA == 1'b0) begin\n         $display(\"%m: Overflow of memory when using PingPong for reading\");\n         reportedA <= 1'b1;\n      end\n   end\n\n   always @(posedge clk) begin\n      if(run) begin\n         reportedB <= 1'b0;\n      end else if(pingPong && true_output_addr[ADDR_W-1] && reportedB == 1'b0) begin\n         $display(\"%m: Overflow of write memory when using PingPong for outputting\");\n         reportedB <= 1'b1;\n      end\n   end\n\n   always @(posedge clk) begin\n      if(run) begin\n         reportedC <= 1'b0;\n      end else if(pingPong && start[ADDR_W-1] && reportedC == 1'b0) begin\n         $display(\"%m: Last bit of output start ignored when using PingPong\");\n         reportedC <= 1'b1;\n      end\n   end\n\n\nendmodule\n")};
+String temp_32_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule FixedBuffer #(\n   parameter DATA_W = 32,\n   parameter AMOUNT = 0\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0\n);\n\n   generate\n      if (AMOUNT == 0) begin\n         always @(posedge clk, posedge rst) begin\n            if (rst) begin\n               out0 <= {DATA_W{1'b0}};\n            end else if (running) begin\n               out0 <= in0;\n            end else begin\n               out0 <= {DATA_W{1'b0}};\n            end\n         end\n      end else begin\n         integer        i;\n         genvar         ii;\n         reg     [DATA_W-1:0] bufferData[AMOUNT-1:0];\n         reg     [DATA_W-1:0] bufferNextData[AMOUNT-1:0];\n\n         // Looks strange but putting everything inside a always @(posedge clk,posedge rst) block was giving a verilator error in the lines bufferData[i] <= bufferData[i+1].\n         // Somehow putting this logic as a non-delayed assignment and generating AMOUNT always cases seems to be accepted fine by the tools.\n         // NOTE: check verilator documentation about UNOPTFLAT: https://verilator.org/guide/latest/warnings.html?highlight=unoptflat#cmdoption-arg-UNOPTFLAT\n         always @* begin\n            for (i = 0; i < AMOUNT - 1; i = i + 1) begin\n               bufferNextData[i] = bufferData[i+1];\n            end\n            bufferNextData[AMOUNT-1] = in0;\n         end\n\n         for(ii = 0; ii < AMOUNT; ii = ii + 1) begin : bufferAssigns\n            always @(posedge clk,posedge rst) begin\n               if (rst) begin\n                  bufferData[ii] <= {DATA_W{1'b0}};\n               end else if (running) begin\n                  bufferData[ii] <= bufferNextData[ii];\n               end else begin\n                  bufferData[ii] <= {DATA_W{1'b0}};\n               end\n            end\n         end\n\n         always @(posedge clk, posedge rst) begin\n            if (rst) begin\n               out0 <= {DATA_W{1'b0}};\n            end else if (running) begin\n               out0 <= bufferData[0];\n            end else begin\n               out0 <= {DATA_W{1'b0}};\n            end\n         end\n      end\n   endgenerate\n\nendmodule\n")};
+String temp_33_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule CombMux2 #(\n   parameter DATA_W = 32\n) (\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 0 *) output [DATA_W-1:0] out0,\n\n   input sel\n);\n\n   assign out0 = (sel ? in1 : in0);\n\nendmodule\n")};
+FileContent defaultVerilogUnits_Raw[] = {  {String("Const.v"),String("./hardware/src/units"),String(""),temp_0_CONTENT},  {String("LookupTableRead.v"),String("./hardware/src/units"),String(""),temp_1_CONTENT},  {String("ReadWriteMem.v"),String("./hardware/src/units"),String(""),temp_2_CONTENT},  {String("PipelineRegister.v"),String("./hardware/src/units"),String(""),temp_3_CONTENT},  {String("Merge2.v"),String("./hardware/src/units"),String(""),temp_4_CONTENT},  {String("DebugReadMem.v"),String("./hardware/src/units"),String(""),temp_5_CONTENT},  {String("CombMux8.v"),String("./hardware/src/units"),String(""),temp_6_CONTENT},  {String("Mem.v"),String("./hardware/src/units"),String(""),temp_7_CONTENT},  {String("Mux8.v"),String("./hardware/src/units"),String(""),temp_8_CONTENT},  {String("Generator.v"),String("./hardware/src/units"),String(""),temp_9_CONTENT},  {String("SwapEndian.v"),String("./hardware/src/units"),String(""),temp_10_CONTENT},  {String("Buffer.v"),String("./hardware/src/units"),String(""),temp_11_CONTENT},  {String("TestConst.v"),String("./hardware/src/units"),String(""),temp_12_CONTENT},  {String("DebugWriteMem.v"),String("./hardware/src/units"),String(""),temp_13_CONTENT},  {String("Reg.v"),String("./hardware/src/units"),String(""),temp_14_CONTENT},  {String("StridedMerge.v"),String("./hardware/src/units"),String(""),temp_15_CONTENT},  {String("Equality.v"),String("./hardware/src/units"),String(""),temp_16_CONTENT},  {String("Counter.v"),String("./hardware/src/units"),String(""),temp_17_CONTENT},  {String("Muladd.v"),String("./hardware/src/units"),String(""),temp_18_CONTENT},  {String("RegFile.v"),String("./hardware/src/units"),String(""),temp_19_CONTENT},  {String("Merge.v"),String("./hardware/src/units"),String(""),temp_20_CONTENT},  {String("CombMux4.v"),String("./hardware/src/units"),String(""),temp_21_CONTENT},  {String("Mul.v"),String("./hardware/src/units"),String(""),temp_22_CONTENT},  {String("Mux2.v"),String("./hardware/src/units"),String(""),temp_23_CONTENT},  {String("DoneCycle.v"),String("./hardware/src/units"),String(""),temp_24_CONTENT},  {String("Store.v"),String("./hardware/src/units"),String(""),temp_25_CONTENT},  {String("OnlyOutputMem.v"),String("./hardware/src/units"),String(""),temp_26_CONTENT},  {String("Conditional.v"),String("./hardware/src/units"),String(""),temp_27_CONTENT},  {String("TimedMux.v"),String("./hardware/src/units"),String(""),temp_28_CONTENT},  {String("VWrite.v"),String("./hardware/src/units"),String(""),temp_29_CONTENT},  {String("LookupTable.v"),String("./hardware/src/units"),String(""),temp_30_CONTENT},  {String("VRead.v"),String("./hardware/src/units"),String(""),temp_31_CONTENT},  {String("FixedBuffer.v"),String("./hardware/src/units"),String(""),temp_32_CONTENT},  {String("CombMux2.v"),String("./hardware/src/units"),String(""),temp_33_CONTENT}};
+Array<FileContent> defaultVerilogUnits = {defaultVerilogUnits_Raw,ARRAY_SIZE(defaultVerilogUnits_Raw)};
+String temp_34_CONTENT = {String("`timescale 1ns / 1ps\n\n// Given the initial byte offset, this module aligns incoming data\n// Start must be asserted once before the first valid data in a new burst transfer\nmodule BurstAlign #(\n   parameter AXI_DATA_W = 32,\n\n   parameter OFFSET_W = $clog2(AXI_DATA_W / 8)\n) (\n   input [OFFSET_W-1:0] offset_i,\n   input                start_i,\n\n   input                       burst_last_i, // Assert if on the last cycle of a burst. Most likely is gonna be (xvalid && xready && xlast)\n   input transfer_last_i,  // Assert if performing the last transfer of a set of transfers.\n\n   output last_transfer_o,\n   output empty_o,\n\n   // Simple interface for data_in\n   input [AXI_DATA_W-1:0] data_in_i,\n   input                  valid_in_i,\n   //output ready_in,\n\n   // Simple interface for data_out\n   output reg [AXI_DATA_W-1:0] data_out_o,\n   output reg                  valid_out_o,\n   //input      ready_out,\n\n   input clk_i,\n   input rst_i\n);\n\n   reg valid;\n   reg flush;\n\n   assign empty_o = !valid_out_o; // Since we are always trying to flush, empty_o is equal to not having anythig to flush away\n   assign last_transfer_o = flush;\n\n   reg [AXI_DATA_W-1:0] stored_data;\n\n   generate\n      if (AXI_DATA_W == 16) begin\n         always @* begin\n            data_out_o = 0;\n\n            case (offset_i)\n               1'b0: data_out_o = stored_data;\n               1'b1: data_out_o = {data_in_i[7:0], stored_data[15:8]};\n            endcase\n         end\n      end  // if(AXI_DATA_W == 32)\n      if (AXI_DATA_W == 32) begin\n         always @* begin\n            data_out_o = 0;\n\n            case (offset_i)\n               2'b00: data_out_o = stored_data;\n               2'b01: data_out_o = {data_in_i[7:0], stored_data[31:8]};\n               2'b10: data_out_o = {data_in_i[15:0], stored_data[31:16]};\n               2'b11: data_out_o = {data_in_i[23:0], stored_data[31:24]};\n            endcase\n         end\n      end  // if(AXI_DATA_W == 32)\n      if (AXI_DATA_W == 64) begin\n         always @* begin\n            data_out_o = 0;\n\n            case (offset_i)\n               3'b000: data_out_o = stored_data;\n               3'b001: data_out_o = {data_in_i[7:0], stored_data[63:8]};\n               3'b010: data_out_o = {data_in_i[15:0], stored_data[63:16]};\n               3'b011: data_out_o = {data_in_i[23:0], stored_data[63:24]};\n               3'b100: data_out_o = {data_in_i[31:0], stored_data[63:32]};\n               3'b101: data_out_o = {data_in_i[39:0], stored_data[63:40]};\n               3'b110: data_out_o = {data_in_i[47:0], stored_data[63:48]};\n               3'b111: data_out_o = {data_in_i[55:0], stored_data[63:56]};\n            endcase\n         end\n      end  // if(AXI_DATA_W == 64)\n      if (AXI_DATA_W == 128) begin\n         always @* begin\n            data_out_o = 0;\n\n            case (offset_i)\n               4'b0000: data_out_o = stored_data;\n               4'b0001: data_out_o = {data_in_i[7:0], stored_data[127:8]};\n               4'b0010: data_out_o = {data_in_i[15:0], stored_data[127:16]};\n               4'b0011: data_out_o = {data_in_i[23:0], stored_data[127:24]};\n               4'b0100: data_out_o = {data_in_i[31:0], stored_data[127:32]};\n               4'b0101: data_out_o = {data_in_i[39:0], stored_data[127:40]};\n               4'b0110: data_out_o = {data_in_i[47:0], stored_data[127:48]};\n               4'b0111: data_out_o = {data_in_i[55:0], stored_data[127:56]};\n               4'b1000: data_out_o = {data_in_i[63:0], stored_data[127:64]};\n               4'b1001: data_out_o = {data_in_i[71:0], stored_data[127:72]};\n               4'b1010: data_out_o = {data_in_i[79:0], stored_data[127:80]};\n               4'b1011: data_out_o = {data_in_i[87:0], stored_data[127:88]};\n               4'b1100: data_out_o = {data_in_i[95:0], stored_data[127:96]};\n               4'b1101: data_out_o = {data_in_i[103:0], stored_data[127:104]};\n               4'b1110: data_out_o = {data_in_i[111:0], stored_data[127:112]};\n               4'b1111: data_out_o = {data_in_i[119:0], stored_data[127:120]};\n            endcase\n         end\n      end  // if(AXI_DATA_W == 128)\n      if (AXI_DATA_W == 256) begin\n         always @* begin\n            data_out_o = 0;\n\n            case (offset_i)\n               5'b00000: data_out_o = stored_data;\n               5'b00001: data_out_o = {data_in_i[7:0], stored_data[255:8]};\n               5'b00010: data_out_o = {data_in_i[15:0], stored_data[255:16]};\n               5'b00011: data_out_o = {data_in_i[23:0], stored_data[255:24]};\n               5'b00100: data_out_o = {data_in_i[31:0], stored_data[255:32]};\n               5'b00101: data_out_o = {data_in_i[39:0], stored_data[255:40]};\n               5'b00110: data_out_o = {data_in_i[47:0], stored_data[255:48]};\n               5'b00111: data_out_o = {data_in_i[55:0], stored_data[255:56]};\n               5'b01000: data_out_o = {data_in_i[63:0], stored_data[255:64]};\n               5'b01001: data_out_o = {data_in_i[71:0], stored_data[255:72]};\n               5'b01010: data_out_o = {data_in_i[79:0], stored_data[255:80]};\n               5'b01011: data_out_o = {data_in_i[87:0], stored_data[255:88]};\n               5'b01100: data_out_o = {data_in_i[95:0], stored_data[255:96]};\n               5'b01101: data_out_o = {data_in_i[103:0], stored_data[255:104]};\n               5'b01110: data_out_o = {data_in_i[111:0], stored_data[255:112]};\n               5'b01111: data_out_o = {data_in_i[119:0], stored_data[255:120]};\n               5'b10000: data_out_o = {data_in_i[127:0], stored_data[255:128]};\n               5'b10001: data_out_o = {data_in_i[135:0], stored_data[255:136]};\n               5'b10010: data_out_o = {data_in_i[143:0], stored_data[255:144]};\n               5'b10011: data_out_o = {data_in_i[151:0], stored_data[255:152]};\n               5'b10100: data_out_o = {data_in_i[159:0], stored_data[255:160]};\n               5'b10101: data_out_o = {data_in_i[167:0], stored_data[255:168]};\n               5'b10110: data_out_o = {data_in_i[175:0], stored_data[255:176]};\n               5'b10111: data_out_o = {data_in_i[183:0], stored_data[255:184]};\n               5'b11000: data_out_o = {data_in_i[191:0], stored_data[255:192]};\n               5'b11001: data_out_o = {data_in_i[199:0], stored_data[255:200]};\n               5'b11010: data_out_o = {data_in_i[207:0], stored_data[255:208]};\n               5'b11011: data_out_o = {data_in_i[215:0], stored_data[255:216]};\n               5'b11100: data_out_o = {data_in_i[223:0], stored_data[255:224]};\n               5'b11101: data_out_o = {data_in_i[231:0], stored_data[255:232]};\n               5'b11110: data_out_o = {data_in_i[239:0], stored_data[255:240]};\n               5'b11111: data_out_o = {data_in_i[247:0], stored_data[255:248]};\n            endcase\n         end\n      end  // if(AXI_DATA_W == 256)\n      if (AXI_DATA_W == 512) begin\n         always @* begin\n            data_out_o = 0;\n\n            case (offset_i)\n               6'b000000: data_out_o = stored_data;\n               6'b000001: data_out_o = {data_in_i[7:0], stored_data[511:8]};\n               6'b000010: data_out_o = {data_in_i[15:0], stored_data[511:16]};\n               6'b000011: data_out_o = {data_in_i[23:0], stored_data[511:24]};\n               6'b000100: data_out_o = {data_in_i[31:0], stored_data[511:32]};\n               6'b000101: data_out_o = {data_in_i[39:0], stored_data[511:40]};\n               6'b000110: data_out_o = {data_in_i[47:0], stored_data[511:48]};\n               6'b000111: data_out_o = {data_in_i[55:0], stored_data[511:56]};\n               6'b001000: data_out_o = {data_in_i[63:0], stored_data[511:64]};\n               6'b001001: data_out_o = {data_in_i[71:0], stored_data[511:72]};\n               6'b001010: data_out_o = {data_in_i[79:0], stored_data[511:80]};\n               6'b001011: data_out_o = {data_in_i[87:0], stored_data[511:88]};\n               6'b001100: data_out_o = {data_in_i[95:0], stored_data[511:96]};\n               6'b001101: data_out_o = {data_in_i[103:0], stored_data[511:104]};\n               6'b001110: data_out_o = {data_in_i[111:0], stored_data[511:112]};\n               6'b001111: data_out_o = {data_in_i[119:0], stored_data[511:120]};\n               6'b010000: data_out_o = {data_in_i[127:0], stored_data[511:128]};\n               6'b010001: data_out_o = {data_in_i[135:0], stored_data[511:136]};\n               6'b010010: data_out_o = {data_in_i[143:0], stored_data[511:144]};\n               6'b010011: data_out_o = {data_in_i[151:0], stored_data[511:152]};\n               6'b010100: data_out_o = {data_in_i[159:0], stored_data[511:160]};\n               6'b010101: data_out_o = {data_in_i[167:0], stored_data[511:168]};\n               6'b010110: data_out_o = {data_in_i[175:0], stored_data[511:176]};\n               6'b010111: data_out_o = {data_in_i[183:0], stored_data[511:184]};\n               6'b011000: data_out_o = {data_in_i[191:0], stored_data[511:192]};\n               6'b011001: data_out_o = {data_in_i[199:0], stored_data[511:200]};\n               6'b011010: data_out_o = {data_in_i[207:0], stored_data[511:208]};\n               6'b011011: data_out_o = {data_in_i[215:0], stored_data[511:216]};\n               6'b011100: data_out_o = {data_in_i[223:0], stored_data[511:224]};\n               6'b011101: data_out_o = {data_in_i[231:0], stored_data[511:232]};\n               6'b011110: data_out_o = {data_in_i[239:0], stored_data[511:240]};\n               6'b011111: data_out_o = {data_in_i[247:0], stored_data[511:248]};\n               6'b100000: data_out_o = {data_in_i[255:0], stored_data[511:256]};\n               6'b100001: data_out_o = {data_in_i[263:0], stored_data[511:264]};\n               6'b100010: data_out_o = {data_in_i[271:0], stored_data[511:272]};\n               6'b100011: data_out_o = {data_in_i[279:0], stored_data[511:280]};\n               6'b100100: data_out_o = {data_in_i[287:0], stored_data[511:288]};\n               6'b100101: data_out_o = {data_in_i[295:0], stored_data[511:296]};\n               6'b100110: data_out_o = {data_in_i[303:0], stored_data[511:304]};\n               6'b100111: data_out_o = {data_in_i[311:0], stored_data[511:312]};\n               6'b101000: data_out_o = {data_in_i[319:0], stored_data[511:320]};\n               6'b101001: data_out_o = {data_in_i[327:0], stored_data[511:328]};\n               6'b101010: data_out_o = {data_in_i[335:0], stored_data[511:336]};\n               6'b101011: data_out_o = {data_in_i[343:0], stored_data[511:344]};\n               6'b101100: data_out_o = {data_in_i[351:0], stored_data[511:352]};\n               6'b101101: data_out_o = {data_in_i[359:0], stored_data[511:360]};\n               6'b101110: data_out_o = {data_in_i[367:0], stored_data[511:368]};\n               6'b101111: data_out_o = {data_in_i[375:0], stored_data[511:376]};\n               6'b110000: data_out_o = {data_in_i[383:0], stored_data[511:384]};\n               6'b110001: data_out_o = {data_in_i[391:0], stored_data[511:392]};\n               6'b110010: data_out_o = {data_in_i[399:0], stored_data[511:400]};\n               6'b110011: data_out_o = {data_in_i[407:0], stored_data[511:408]};\n               6'b110100: data_out_o = {data_in_i[415:0], stored_data[511:416]};\n               6'b110101: data_out_o = {data_in_i[423:0], stored_data[511:424]};\n               6'b110110: data_out_o = {data_in_i[431:0], stored_data[511:432]};\n               6'b110111: data_out_o = {data_in_i[439:0], stored_data[511:440]};\n               6'b111000: data_out_o = {data_in_i[447:0], stored_data[511:448]};\n               6'b111001: data_out_o = {data_in_i[455:0], stored_data[511:456]};\n               6'b111010: data_out_o = {data_in_i[463:0], stored_data[511:464]};\n               6'b111011: data_out_o = {data_in_i[471:0], stored_data[511:472]};\n               6'b111100: data_out_o = {data_in_i[479:0], stored_data[511:480]};\n               6'b111101: data_out_o = {data_in_i[487:0], stored_data[511:488]};\n               6'b111110: data_out_o = {data_in_i[495:0], stored_data[511:496]};\n               6'b111111: data_out_o = {data_in_i[503:0], stored_data[511:504]};\n            endcase\n         end\n      end  // if(AXI_DATA_W == 256)\n   endgenerate\n\n   // Logic that does not depend on generate\n   always @* begin\n      valid_out_o = 1'b0;\n\n      if (valid & valid_in_i)  // A transfer occured\n         valid_out_o = 1'b1;\n\n      if (flush) valid_out_o = 1'b1;\n   end\n\n   always @(posedge clk_i, posedge rst_i) begin\n      if (rst_i) begin\n         stored_data <= 0;\n         valid       <= 0;\n         flush       <= 0;\n      end else begin\n         flush <= 0;\n\n         if (start_i) valid <= 1'b0;\n\n         if (valid_in_i) valid <= 1'b1;\n\n         if (valid_in_i | (burst_last_i && transfer_last_i)) begin\n            stored_data <= data_in_i;\n         end\n\n         if (burst_last_i && transfer_last_i) flush <= 1'b1;\n      end\n   end\n\nendmodule  // burst_align\n")};
+String temp_35_CONTENT = {String("`timescale 1ns / 1ps\n\n// Since Simple interface expects to write N transfers regardless of anything else (does not care about alignment or axi boundary)\n// it becomes simpler to just have a module that performs N transfers from \nmodule TransferNFromSimpleM #(\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter LEN_W = 8,\n   parameter MAX_TRANSF_W = 32\n   ) (\n      input [MAX_TRANSF_W-1:0] transferCount_i,\n      input                    initiateTransfer_i,\n      output                   done_o,\n\n      // Connect directly to simple axi \n      input                        m_wvalid_i,\n      output                       m_wready_o,\n      input [      AXI_ADDR_W-1:0] m_waddr_i,\n      input [      AXI_DATA_W-1:0] m_wdata_i,\n      input [(AXI_DATA_W / 8)-1:0] m_wstrb_i,\n      input [           LEN_W-1:0] m_wlen_i,\n      output                       m_wlast_o,\n\n      // Data output\n      output                  data_valid_o,\n      output [AXI_DATA_W-1:0] data_o,\n      input                   data_ready_i,\n\n      input rst_i,\n      input clk_i\n   );\n\nreg [MAX_TRANSF_W-1:0] count;\nreg working;\n\nassign done_o = !working;\nassign m_wready_o = working && data_ready_i;\nassign data_valid_o = working && m_wvalid_i;\nassign data_o = m_wdata_i;\n\nassign m_wlast_o = (count == 1);\n\nalways @(posedge clk_i,posedge rst_i) begin\n   if(rst_i) begin\n      count <= 0;\n      working <= 1'b0;\n   end else if(working) begin\n      if(m_wvalid_i && m_wready_o) begin\n         count <= count - 1;\n\n         if(count == 1) begin\n            working <= 1'b0;\n         end\n      end\n   end else if(initiateTransfer_i) begin\n      count <= transferCount_i;\n      working <= 1'b1;\n   end\nend\n\nendmodule\n\nmodule SimpleAXItoAXIWrite #(\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter AXI_LEN_W  = 8,\n   parameter AXI_ID_W   = 4,\n   parameter LEN_W      = 8\n) (\n   input                             m_wvalid_i,\n   output                            m_wready_o,\n   input      [      AXI_ADDR_W-1:0] m_waddr_i,\n   input      [      AXI_DATA_W-1:0] m_wdata_i,\n   input      [(AXI_DATA_W / 8)-1:0] m_wstrb_i,\n   input      [           LEN_W-1:0] m_wlen_i,\n   output                            m_wlast_o,\n\n   output [AXI_ID_W-1:0] axi_awid_o,\n   output [AXI_ADDR_W-1:0] axi_awaddr_o,\n   output [AXI_LEN_W-1:0] axi_awlen_o,\n   output [3-1:0] axi_awsize_o,\n   output [2-1:0] axi_awburst_o,\n   output [2-1:0] axi_awlock_o,\n   output [4-1:0] axi_awcache_o,\n   output [3-1:0] axi_awprot_o,\n   output [4-1:0] axi_awqos_o,\n   output [1-1:0] axi_awvalid_o,\n   input [1-1:0] axi_awready_i,\n   output [AXI_DATA_W-1:0] axi_wdata_o,\n   output [(AXI_DATA_W/8)-1:0] axi_wstrb_o,\n   output [1-1:0] axi_wlast_o,\n   output [1-1:0] axi_wvalid_o,\n   input [1-1:0] axi_wready_i,\n   input [AXI_ID_W-1:0] axi_bid_i,\n   input [2-1:0] axi_bresp_i,\n   input [1-1:0] axi_bvalid_i,\n   output [1-1:0] axi_bready_o,\n\n   input clk_i,\n   input rst_i\n);\n\n   localparam OFFSET_W = $clog2(AXI_DATA_W / 8);\n\n   localparam [2:0] axi_size = ((AXI_DATA_W == 16)   ? 3'b001 : \n                                (AXI_DATA_W == 32)   ? 3'b010 :\n                                (AXI_DATA_W == 64)   ? 3'b011 :\n                                (AXI_DATA_W == 128)  ? 3'b100 :\n                                (AXI_DATA_W == 256)  ? 3'b101 :\n                                (AXI_DATA_W == 512)  ? 3'b110 : \n                                (AXI_DATA_W == 1024) ? 3'b111 : 3'b000);\n\n   reg [2:0] state;\n   wire burst_ready_in;\n\n   reg flush_burst_split;\n   wire data_valid;\n   wire [AXI_DATA_W-1:0] data;\n\n   reg [OFFSET_W-1:0] stored_offset;\n\n   BurstSplit #(\n      .DATA_W(AXI_DATA_W)\n   ) split (\n      .offset_i(stored_offset),\n\n      .data_in_i   (data),\n      .data_valid_i(data_valid),\n\n      // Simple interface for data_out\n      .data_out_o(axi_wdata_o),\n\n      .clk_i(clk_i),\n      .rst_i(rst_i)\n   );\n\n   wire        write_last_transfer;\n   wire        write_last_transfer_next;\n\n   wire [AXI_LEN_W-1:0] true_axi_awlen;\n   reg [AXI_LEN_W-1:0] write_axi_len;\n   assign axi_awlen_o = write_axi_len;\n\n   wire [AXI_ADDR_W-1:0] symbolsToRead;\n\n   wire [(AXI_DATA_W/8)-1:0] initial_strb, final_strb;\n   wire outputOneExtra;\n\n   AXITransferController #(\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .AXI_DATA_W(AXI_DATA_W),\n      .AXI_LEN_W(AXI_LEN_W),\n      .LEN_W     (LEN_W)\n   ) write_controller (\n      .address_i(m_waddr_i),\n      .length_i (m_wlen_i),   // In bytes\n\n      .transfer_start_i(state == 3'h0 && m_wvalid_i),\n      .burst_start_i   (state == 3'h2 && axi_awready_i && axi_awvalid_o),\n\n      .initial_strb_o(initial_strb),\n      .final_strb_o  (final_strb),\n\n      //.symbolsToRead_o(symbolsToRead),\n      .outputOneExtraSymbol_o(outputOneExtra),\n      .sourceSymbolsToRead_o(symbolsToRead),\n      .axiSymbolsTransfers_o(),\n\n      .true_axi_axaddr_o(axi_awaddr_o),\n\n      // TODO: Register these signals to \n      .true_axi_axlen_o    (true_axi_awlen),\n      .last_transfer_o     (write_last_transfer),\n      .last_transfer_next_o(write_last_transfer_next),\n\n      .clk_i(clk_i),\n      .rst_i(rst_i)\n   );\n\n   reg initiateTransfer;\n   wire m_TransferDone;\n\n   TransferNFromSimpleM #(\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .AXI_DATA_W(AXI_DATA_W),\n      .LEN_W(LEN_W)\n   ) transferN (\n      .transferCount_i(symbolsToRead),\n      .initiateTransfer_i(initiateTransfer),\n      .done_o(m_TransferDone),\n\n      // Connect directly to simple axi \n      .m_wvalid_i(m_wvalid_i),\n      .m_wready_o(m_wready_o),\n      .m_waddr_i(m_waddr_i),\n      .m_wdata_i(m_wdata_i),\n      .m_wstrb_i(m_wstrb_i),\n      .m_wlen_i(m_wlen_i),\n      .m_wlast_o(m_wlast_o),\n\n      // Data output\n      .data_valid_o(data_valid),\n      .data_o(data),\n      .data_ready_i(axi_wready_i),\n\n      .rst_i(rst_i),\n      .clk_i(clk_i)\n   );\n\n   // Address write constants\n   assign axi_awid_o    = 0;\n   assign axi_awsize_o  = axi_size;\n   assign axi_awburst_o = 'b01;  // INCR\n   assign axi_awlock_o  = 0;\n   assign axi_awcache_o = 0;\n   assign axi_awprot_o  = 0;\n   assign axi_awqos_o   = 0;\n\n   reg [(AXI_DATA_W/8)-1:0] wstrb;\n   assign axi_wstrb_o  = wstrb;\n\n   assign axi_bready_o = 1'b1;  // We ignore write response\n\n   reg awvalid, wvalid;\n   assign axi_awvalid_o = awvalid;\n   assign axi_wvalid_o  = wvalid;\n\n   reg m_axi_last;\n   assign axi_wlast_o = m_axi_last;\n\n   reg        first_transfer;\n\n   // This contains both the logic for the AXI transfer and the databus transfer.\n   // We first need to decouple this before progressing.\n   reg [AXI_LEN_W-1:0] counter;\n   reg [31:0] full_counter;\n   always @(posedge clk_i, posedge rst_i) begin\n      if (rst_i) begin\n         state          <= 0;\n         awvalid        <= 0;\n         counter        <= 0;\n         full_counter   <= 0;\n         write_axi_len  <= 0;\n         stored_offset  <= 0;\n         first_transfer <= 0;\n         wstrb          <= 0;\n      end else begin\n         case (state)\n            3'h0: begin  // Wait one cycle for transfer controller to calculate things.\n               if (m_wvalid_i) begin\n                  stored_offset  <= m_waddr_i[OFFSET_W-1:0];\n                  state          <= 3'h1;\n                  first_transfer <= 1'b1;\n               end\n            end\n            3'h1: begin  // Save values that change \n               write_axi_len <= true_axi_awlen;\n               awvalid       <= 1'b1;\n               state         <= 3'h2;\n            end\n            3'h2: begin  // Write address set\n               // awvalid is 1 at this point\n               if (axi_awready_i) begin\n                  awvalid <= 1'b0;\n                  state   <= 3'h3;\n                  if (first_transfer) begin\n                     first_transfer <= 1'b0;\n                     wstrb          <= initial_strb;\n                  end else begin\n                     wstrb <= ~0;\n                     if ((write_axi_len == 0) && write_last_transfer_next) begin\n                        wstrb <= final_strb;\n                     end\n                  end\n               end\n            end\n            3'h3: begin\n               if (axi_wvalid_o && axi_wready_i) begin\n                  counter <= counter + 1;\n\n                  if (((counter + 1) == axi_awlen_o) && write_last_transfer) begin\n                     wstrb <= final_strb;\n                  end else begin\n                     wstrb <= ~0;\n                  end\n\n                  full_counter <= full_counter + 1;\n                  if (m_axi_last) begin\n                     counter <= 0;\n                     if (write_last_transfer) begin\n                        full_counter  <= 0;\n                        write_axi_len <= 0;\n                        state         <= 3'h0;\n                     end else begin\n                        state <= 3'h1;\n                     end\n                  end\n               end\n            end\n         endcase\n      end\n   end\n\n   always @* begin\n      flush_burst_split = 1'b0;\n      m_axi_last        = 1'b0;\n      wvalid            = 1'b0;\n      initiateTransfer  = 1'b0;\n\n      if(state == 3'h2 && axi_awready_i) begin\n         initiateTransfer = 1'b1;\n      end\n\n      if (state == 3'h3) begin\n         wvalid     = data_valid || (m_TransferDone && outputOneExtra);\n\n         m_axi_last = (counter == axi_awlen_o);\n      end\n   end\n\nendmodule  // SimpleAXItoAXIWrite\n")};
+String temp_36_CONTENT = {String("`timescale 1ns / 1ps\n\n/*\n\nReceives addresses from an address generator\nReceives data from a data source\nWrites the data to the memory at the given addresses\n\nLike the Memory Reader, not implementing the full interfaces prevents this unit from abstracting away more logic than it could.\nThe VRead unit contains 10 more lines of logic that are not needed if this unit was capable of detecting a m_last\n\n*/\n\nmodule MemoryWriter #(\n   parameter ADDR_W = 32,\n   parameter DATA_W = 32\n) (\n   // Slave connected to address gen\n   input                   gen_valid_i,\n   output reg              gen_ready_o,\n   input      [ADDR_W-1:0] gen_addr_i,\n\n   // Slave connected to data source\n   input                   data_valid_i,\n   output reg              data_ready_o,\n   input      [DATA_W-1:0] data_in_i,\n\n   // Connect to memory\n   output reg              mem_enable_o,\n   output reg [ADDR_W-1:0] mem_addr_o,\n   output reg [DATA_W-1:0] mem_data_o,\n\n   input clk_i,\n   input rst_i\n);\n\n   always @(posedge clk_i, posedge rst_i) begin\n      if (rst_i) begin\n         mem_enable_o <= 0;\n         mem_addr_o   <= 0;\n         mem_data_o   <= 0;\n      end else begin\n         mem_enable_o <= 1'b0;\n\n         if (gen_valid_i && data_valid_i) begin\n            mem_addr_o   <= gen_addr_i;\n            mem_data_o   <= data_in_i;\n            mem_enable_o <= 1'b1;\n         end\n      end\n   end\n\n   always @* begin\n      gen_ready_o  = 1'b0;\n      data_ready_o = 1'b0;\n\n      data_ready_o = gen_valid_i;\n\n      if (data_valid_i) begin\n         gen_ready_o = 1'b1;\n      end\n   end\n\nendmodule  // MemoryWriter\n")};
+String temp_37_CONTENT = {String("`timescale 1ns / 1ps\n\n// A simple DMA mostly used to load memory mapped units and in some cases configuration data.\n\nmodule SimpleDMA #(\n      parameter ADDR_W = 32,\n      parameter DATA_W = 32,\n      parameter AXI_ADDR_W = 32,\n      parameter LEN_W = 20\n   )(\n      // Master interface used to fetch data from memory\n      input                   m_databus_ready,\n      output                  m_databus_valid,\n      output [AXI_ADDR_W-1:0] m_databus_addr,\n      input  [DATA_W-1:0]     m_databus_rdata,\n      output [DATA_W-1:0]     m_databus_wdata,\n      output [(DATA_W/8)-1:0] m_databus_wstrb,\n      output [LEN_W-1:0]      m_databus_len,\n      input                   m_databus_last,      \n\n      // Configuration (set before asserting run)\n      input [ADDR_W-1:0]      addr_internal,\n      input [AXI_ADDR_W-1:0]  addr_read,\n      input [LEN_W-1:0]       length,\n\n      // Run and running status\n      input run,\n      output reg running,\n\n      output                   valid,\n      output reg [ADDR_W-1:0]  address,\n      output [DATA_W-1:0]      data,\n\n      input clk,\n      input rst\n   );\n\nassign m_databus_addr = addr_read;\nassign m_databus_len = length;\nassign m_databus_wdata = 0;\nassign m_databus_wstrb = 0;\n\nassign m_databus_valid = running;\nassign valid = m_databus_ready;\nassign data  = m_databus_rdata;\n\nalways @(posedge clk,posedge rst) begin\n   if(rst) begin\n      address <= 0;\n      running <= 0;\n   end else if(running) begin\n      if(m_databus_ready) begin\n         address <= address + 4;\n            \n         if(m_databus_last) begin\n            running <= 1'b0;\n         end\n      end\n   end else if(run) begin\n      address <= addr_internal;\n      running <= 1'b1;\n   end\nend\n\nendmodule\n")};
+String temp_38_CONTENT = {String("`timescale 1ns / 1ps\n\n// Module that implements AXI transfer logic. Handles multiple transfers, initial and final strobes and 4k boundary. \n// Does not contain any logic to drive a transfer. It just computes values that are necessary according to the AXI specification\n// A transfer is equal to a N amount of AXI bursts intended to transfer a variable amount of bytes.\n// TODO: The interface logic is a bit clubersome to use by outside modules. Would be nice to give another look.\n// TODO: Also take a look at the BurstAlign and BurstSplit interfaces. These three modules are usually used together but the interface is a bit clubersome when doing so.\n//       It should be easy to instantiate a TransferController and the necessary Align or Split interfaces without much hassle\n// TODO: We might also consider implementing some transfer logic inside this. Forcing the outside code to set the burst_start_i wire is a bit error prone.\n//       We can always receive the AXI wires and use them to drive the logic. It probably does not add any extra resources since we are just implementing what the outside code is implementing already.\nmodule AXITransferController #(\n   parameter AXI_ADDR_W   = 32,\n   parameter AXI_DATA_W   = 32,\n   parameter AXI_LEN_W    = 8,\n   parameter LEN_W        = 32,\n   parameter MAX_TRANSF_W = 32\n) (\n   input [AXI_ADDR_W-1:0] address_i,  // Must remain constant during transfer\n   input [     LEN_W-1:0] length_i,   // In bytes\n\n   input                  transfer_start_i, // Assert one cycle before starting a transfer. Set address_i and length_i to the correct values beforehand\n   input                  burst_start_i, // At the start of a burst (after values accepted by axi), assert this signal for one cycle. This updates the stored values and prepares the values of the next cycle\n\n   output reg [AXI_ADDR_W-1:0] true_axi_axaddr_o,  /* registered */\n\n   // All these signals are combinatorial. Register them outside this module if needed\n   output reg [(AXI_DATA_W/8)-1:0] initial_strb_o, // First strobe of the transfer. The rest is always full 1\n   output reg [(AXI_DATA_W/8)-1:0] final_strb_o, // Last strobe of the transfer. Only valid if last_transfer is asserted\n\n   output [MAX_TRANSF_W-1:0]  symbolsToRead_o,        // How many symbols (data transfers) to expect from the source\n   output                     outputOneExtraSymbol_o, // For unaligned transfers, we must output one more than we read. \n   output [MAX_TRANSF_W-1:0]  sourceSymbolsToRead_o,\n   output [MAX_TRANSF_W-1:0]  axiSymbolsTransfers_o,\n\n   output reg [AXI_LEN_W-1:0] true_axi_axlen_o,\n   output reg                 last_transfer_o,\n   output                     last_transfer_next_o,\n\n   input clk_i,\n   input rst_i\n);\n\n   function integer calculate_AXI_OFFSET_W(input integer axi_data_w);\n      begin\n         calculate_AXI_OFFSET_W = $clog2((axi_data_w / 8));\n      end\n   endfunction\n\n   function [2:0] calculate_AXI_AXSIZE(input integer axi_data_w);\n      begin\n         calculate_AXI_AXSIZE = 0;\n         if (axi_data_w >= 8) calculate_AXI_AXSIZE = 3'b000;\n         if (axi_data_w >= 16) calculate_AXI_AXSIZE = 3'b001;\n         if (axi_data_w >= 32) calculate_AXI_AXSIZE = 3'b010;\n         if (axi_data_w >= 64) calculate_AXI_AXSIZE = 3'b011;\n         if (axi_data_w >= 128) calculate_AXI_AXSIZE = 3'b100;\n         if (axi_data_w >= 256) calculate_AXI_AXSIZE = 3'b101;\n         if (axi_data_w >= 512) calculate_AXI_AXSIZE = 3'b110;\n         if (axi_data_w >= 1024) calculate_AXI_AXSIZE = 3'b111;\n      end\n   endfunction\n\n   localparam OFFSET_W = calculate_AXI_OFFSET_W(AXI_DATA_W);\n   localparam STROBE_W = AXI_DATA_W / 8;\n   localparam MAX_LENGTH = (2 ** AXI_LEN_W);\n\n   wire [AXI_DATA_W-1:0] OFFSET_MASK = (0 | {OFFSET_W{1'b1}});\n\n   function [15:0] min(input [15:0] a, b);\n      begin\n         min = (a < b) ? a : b;\n      end\n   endfunction\n\n   // State variables\n   reg [LEN_W-1:0] stored_len;\n   reg first_i_transfer;\n\n   // Generic variables outside generate\n   reg [LEN_W-1:0] transfer_byte_size;\n   reg [LEN_W-1:0] last_transfer_o_len;\n\n   wire [12:0] max_transfer_len;  // Assigned inside the generate\n   wire [12:0] max_transfer_len_minus_one;  // Assigned inside the generate\n\n   wire [12:0] first_i_transfer_len = (max_transfer_len_minus_one + (STROBE_W - address_i[OFFSET_W-1:0]));\n   wire [12:0] boundary_transfer_len = (13'h1000 - true_axi_axaddr_o[11:0]);\n   wire [AXI_ADDR_W-1:0] true_address_i = address_i & (~OFFSET_MASK);\n\n   assign last_transfer_next_o = (transfer_byte_size == stored_len);\n\n   always @* begin\n      if (first_i_transfer)\n         transfer_byte_size = min(boundary_transfer_len, min(stored_len, first_i_transfer_len));\n      else transfer_byte_size = min(boundary_transfer_len, min(stored_len, max_transfer_len));\n\n      if (last_transfer_next_o) true_axi_axlen_o = last_transfer_o_len;\n      else true_axi_axlen_o = (transfer_byte_size - 1) >> OFFSET_W;\n   end\n\n   reg [$clog2(STROBE_W):0] final_strb_o_count;  // Values for 128, right?\n   reg [$clog2(STROBE_W):0] initial_strb_o_count;\n   reg [$clog2(STROBE_W)-1:0] true_final_strb_o_count;  // $clog2(16) = 4.\n   reg [$clog2(STROBE_W)-1:0] initial_strb_o_last_zero;\n   reg [STROBE_W-1:0] temp_initial_strb_o;\n   reg [STROBE_W-1:0] base_strb;\n   wire [OFFSET_W:0] length_iPlusAddress_i = length_i[OFFSET_W:0] + address_i[OFFSET_W:0];\n\n   integer i;\n   always @* begin\n      // Strobe for a address_i == 0 and length_i smaller then a full transfer\n      base_strb = 0;\n      for (i = 0; i < (AXI_DATA_W / 8); i = i + 1) begin\n         if (i < length_i[OFFSET_W-1:0]) base_strb[i] = 1'b1;\n      end\n\n      if (length_i >= ((1 << OFFSET_W) - address_i[OFFSET_W-1:0])) begin\n         initial_strb_o       = (~0) << address_i[OFFSET_W-1:0];\n         initial_strb_o_count = ((1 << OFFSET_W) - address_i[OFFSET_W-1:0]);\n      end else begin\n         initial_strb_o       = base_strb << address_i[OFFSET_W-1:0];\n         initial_strb_o_count = (1 << OFFSET_W);\n      end\n\n      final_strb_o_count      = {1'b1, length_i[OFFSET_W-1:0]} - initial_strb_o_count;\n      true_final_strb_o_count = final_strb_o_count[OFFSET_W-1:0];\n\n      if (true_final_strb_o_count == 0) begin\n         final_strb_o = ~0;\n      end else begin\n         final_strb_o = 0;\n         for (i = 0; i < (AXI_DATA_W / 8); i = i + 1) begin\n            if (i < true_final_strb_o_count) final_strb_o[i] = 1'b1;\n         end\n      end\n   end\n\n   generate\n      if (AXI_DATA_W == 32) begin\n         assign sourceSymbolsToRead_o = ((length_i - 1) >> 2) + 1;\n         assign axiSymbolsTransfers_o = ((length_i - 1 + address_i[1:0]) >> 2) + 1;\n         assign symbolsToRead_o       = (|length_i[1:0]) ? (length_i >> 2) + 1 : length_i >> 2;\n\n         assign max_transfer_len           = min(MAX_LENGTH * 4,13'h0400);\n         assign max_transfer_len_minus_one = min((MAX_LENGTH * 4) - 4,13'h03FC);\n         always @* begin\n            last_transfer_o_len = 0;\n\n            if ((address_i[1:0] == 2'b00) & (stored_len[1:0] == 2'b00))\n               last_transfer_o_len = stored_len[9:2] - 8'h1;\n            else if((address_i[1:0] == 2'b10 && stored_len[1:0] == 2'b11) || (address_i[1:0] == 2'b11 && stored_len[1:0] >= 2'b10))\n               last_transfer_o_len = stored_len[9:2] + 8'h1;\n            else last_transfer_o_len = stored_len[9:2];\n         end\n      end  // if(AXI_DATA_W == 32)\n      if (AXI_DATA_W == 64) begin\n         assign sourceSymbolsToRead_o = ((length_i - 1) >> 3) + 1;\n         assign axiSymbolsTransfers_o =  ((length_i - 1 + address_i[2:0]) >> 3) + 1;\n\n         assign symbolsToRead_o            = (|length_i[2:0]) ? (length_i >> 3) + 1 : length_i >> 3;\n         assign max_transfer_len           = min(MAX_LENGTH * 8,13'h0800);\n         assign max_transfer_len_minus_one = min((MAX_LENGTH * 8) - 8,13'h07F8);\n         wire [2:0] address_i_plus_len = address_i[2:0] + stored_len[2:0];\n         always @* begin\n            last_transfer_o_len = 0;\n\n            if ((address_i[2:0] == 3'b000) && (stored_len[2:0] == 3'b000))\n               last_transfer_o_len = stored_len[10:3] - 8'h1;\n            else if (!(address_i_plus_len >= address_i[2:0] || address_i_plus_len == 0))\n               last_transfer_o_len = stored_len[10:3] + 8'h1;\n            else last_transfer_o_len = stored_len[10:3];\n         end\n      end  // if(AXI_DATA_W == 64)\n      if (AXI_DATA_W == 128) begin\n         assign sourceSymbolsToRead_o = ((length_i - 1) >> 4) + 1;\n         assign axiSymbolsTransfers_o =  ((length_i - 1 + address_i[3:0]) >> 4) + 1;\n\n         assign symbolsToRead_o            = (|length_i[3:0]) ? (length_i >> 4) + 1 : length_i >> 4;\n         assign max_transfer_len           = min(MAX_LENGTH * 16,13'h1000);\n         assign max_transfer_len_minus_one = min((MAX_LENGTH * 16) - 16,13'h0FF0);\n         wire [3:0] address_i_plus_len = address_i[3:0] + stored_len[3:0];\n         always @* begin\n            last_transfer_o_len = 0;\n\n            if ((address_i[3:0] == 4'b0000) && (stored_len[3:0] == 4'b0000))\n               last_transfer_o_len = stored_len[11:4] - 8'h1;\n            else if (!(address_i_plus_len >= address_i[3:0] || address_i_plus_len == 0))\n               last_transfer_o_len = stored_len[11:4] + 8'h1;\n            else last_transfer_o_len = stored_len[11:4];\n\n         end\n      end  // if(AXI_DATA_W == 128)\n      if (AXI_DATA_W == 256) begin\n         assign sourceSymbolsToRead_o = ((length_i - 1) >> 5) + 1;\n         assign axiSymbolsTransfers_o =  ((length_i - 1 + address_i[4:0]) >> 5) + 1;\n\n         assign symbolsToRead_o = (|length_i[4:0]) ? (length_i >> 5) + 1 : length_i >> 5;\n         assign max_transfer_len           = min(MAX_LENGTH * 32,13'h1000);\n         assign max_transfer_len_minus_one = min((MAX_LENGTH * 32) - 32,13'h0FE0); // Because of boundary conditions, cannot go higher\n         wire [4:0] address_i_plus_len = address_i[4:0] + stored_len[4:0];\n         always @* begin\n            last_transfer_o_len = 0;\n\n            if ((address_i[4:0] == 5'h00) && (stored_len[4:0] == 5'h00))\n               last_transfer_o_len = stored_len[12:5] - 8'h1;\n            else if (!(address_i_plus_len >= address_i[4:0] || address_i_plus_len == 0))\n               last_transfer_o_len = stored_len[12:5] + 8'h1;\n            else last_transfer_o_len = stored_len[12:5];\n\n         end\n      end  // if(AXI_DATA_W == 256)\n      if (AXI_DATA_W == 512) begin\n         assign sourceSymbolsToRead_o = ((length_i - 1) >> 6) + 1;\n         assign axiSymbolsTransfers_o =  ((length_i - 1 + address_i[5:0]) >> 6) + 1;\n\n         assign symbolsToRead_o = (|length_i[5:0]) ? (length_i >> 6) + 1 : length_i >> 6;\n         assign max_transfer_len           = min(MAX_LENGTH * 64,13'h1000);\n         assign max_transfer_len_minus_one = min((MAX_LENGTH * 64) - 64,13'h0FC0); // Because of boundary conditions, cannot go higher\n         wire [5:0] address_i_plus_len = address_i[5:0] + stored_len[5:0];\n         always @* begin\n            last_transfer_o_len = 0;\n\n            if ((address_i[5:0] == 6'h00) && (stored_len[5:0] == 6'h00))\n               last_transfer_o_len = stored_len[13:6] - 8'h1;\n            else if (!(address_i_plus_len >= address_i[5:0] || address_i_plus_len == 0))\n               last_transfer_o_len = stored_len[13:6] + 8'h1;\n            else last_transfer_o_len = stored_len[13:6];\n         end\n      end  // if(AXI_DATA_W == 512)\n   endgenerate\n\n   // Outside generate, logic is generic enough\n   always @(posedge clk_i, posedge rst_i) begin\n      if (rst_i) begin\n         first_i_transfer  <= 1'b0;\n         stored_len        <= 0;\n         last_transfer_o   <= 0;\n         true_axi_axaddr_o <= 0;\n      end else begin\n         if (transfer_start_i) begin\n            first_i_transfer  <= 1'b1;\n            last_transfer_o   <= last_transfer_next_o;\n            true_axi_axaddr_o <= true_address_i;\n            stored_len        <= length_i;\n         end\n         if (burst_start_i) begin\n            first_i_transfer  <= 1'b0;\n            last_transfer_o   <= last_transfer_next_o;\n            true_axi_axaddr_o <= true_axi_axaddr_o + ((true_axi_axlen_o + 1) * (AXI_DATA_W / 8));\n            stored_len        <= stored_len - transfer_byte_size;\n         end\n      end\n   end\n\n   assign outputOneExtraSymbol_o = axiSymbolsTransfers_o != sourceSymbolsToRead_o;\n\n// If offset is 3 and we have a length of 2, we need two transfers.\n/*\n\nFor 32 bits:\nOffset | Length   | M_Transfers | AXI_Transfers | OneExtraTransfer\n0      |  1,2,3,4 |     1       |        1      |\n0      |  5,6,7,8 |     2       |        2      |\n\n\nOffset | Length   | M_Transfers | AXI_Transfers | OneExtraTransfer\n1      |  1,2,3   |     1       |        1      |\n1      |  4       |     1       |        2      |       X\n1      |  5,6,7   |     2       |        2      |\n\nM_Transfers is always length divided by the AXI_DATA Size plus 1\n\n2      |  1,2     |     1       |        1      |        \n2      |  3,4     |     1       |        2      |       X\n2      |  5,6     |     2       |        2      |        \n2      |  7,8     |     2       |        3      |       X\n\n\n3      |  1       |     1       |        1      |        \n3      |  2,3,4   |     1       |        2      |       X\n\n\n*/\n\nendmodule  // transfer_controller\n")};
+String temp_39_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule iob_reg_r #(\n   parameter DATA_W  = 21,\n   parameter RST_VAL = {DATA_W{1'b0}}\n) (\n   input [1-1:0] clk_i,\n   input [1-1:0] cke_i,\n   input [1-1:0] arst_i,\n\n   input rst_i,\n\n   input  [DATA_W-1:0] data_i,\n   output [DATA_W-1:0] data_o\n);\n\n   wire [DATA_W-1:0] data_nxt = rst_i ? RST_VAL : data_i;\n\n   iob_reg #(\n      .DATA_W (DATA_W),\n      .RST_VAL(RST_VAL)\n   ) iob_reg_inst (\n      .clk_i(clk_i), //clock signal\n      .cke_i(cke_i), //clock enable\n      .arst_i(arst_i), //asynchronous reset\n      .data_i(data_nxt),\n      .data_o(data_o)\n   );\n\nendmodule\n")};
+String temp_40_CONTENT = {String("`define IOB_REG_DATA_W 1\n`define IOB_REG_RST_VAL {DATA_W{1'b0}}\n`define IOB_REG_RST_POL 1\n")};
+String temp_41_CONTENT = {String("`timescale 1ns / 1ps\n\n// Joins two simple write only interfaces into a single one.\n// No pipelining for now and no backpreassure. Need to figure out how we actually want this before implementing more logic here\n// This is mostly intended to allow DMA and CPU access to Versat address space.\n// DMA only needs to write currently, so no point in doing anything complex right now\n\nmodule JoinTwoSimple #(\n      parameter DATA_W = 32,\n      parameter ADDR_W = 32      \n   ) (\n      input                   m0_valid,\n      input [DATA_W-1:0]      m0_data,\n      input [ADDR_W-1:0]      m0_addr,\n      input [(DATA_W/8)-1:0]  m0_wstrb,\n\n      input                   m1_valid,\n      input [DATA_W-1:0]      m1_data,\n      input [ADDR_W-1:0]      m1_addr,\n      input [(DATA_W/8)-1:0]  m1_wstrb,\n\n      output                  s_valid,\n      output [DATA_W-1:0]     s_data,\n      output [ADDR_W-1:0]     s_addr,\n      output [(DATA_W/8)-1:0] s_wstrb\n   );\n\nassign s_valid = (m0_valid | m1_valid);\nassign s_data =  (m0_valid ? m0_data  : m1_data);\nassign s_addr =  (m0_valid ? m0_addr  : m1_addr);\nassign s_wstrb = (m0_valid ? m0_wstrb : m1_wstrb);\n\nendmodule")};
+String temp_42_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule iob_reg_re #(\n   parameter DATA_W  = 21,\n   parameter RST_VAL = {DATA_W{1'b0}}\n) (\n   input [1-1:0] clk_i,\n   input [1-1:0] cke_i,\n   input [1-1:0] arst_i,\n\n   input rst_i,\n   input en_i,\n\n   input  [DATA_W-1:0] data_i,\n   output [DATA_W-1:0] data_o\n);\n\n   wire [DATA_W-1:0] data = en_i ? data_i : data_o;\n\n   iob_reg_r #(\n      .DATA_W (DATA_W),\n      .RST_VAL(RST_VAL)\n   ) reg0 (\n      .clk_i(clk_i), //clock signal\n      .cke_i(cke_i), //clock enable\n      .arst_i(arst_i), //asynchronous reset\n      .rst_i(rst_i),\n      .data_i(data),\n      .data_o(data_o)\n   );\n\nendmodule\n")};
+String temp_43_CONTENT = {String("`timescale 1ns / 1ps\n\n// Simple counter interface\nmodule CountNLoops #(\n   parameter COUNT_W = 0\n   ) (\n      input [COUNT_W-1:0] count_i,\n      input start_i,\n\n      input advance_i,\n\n      output reg count_is_zero_o,\n\n      input clk_i,\n      input rst_i\n   );\n\nreg [COUNT_W-1:0] count;\n\nalways @(posedge clk_i,posedge rst_i) begin\n   if(rst_i) begin\n      count <= 0;\n      count_is_zero_o <= 1'b0;\n   end else if(start_i) begin\n      count_is_zero_o <= 1'b0;\n      count <= count_i;\n      if(count_i == 0) begin\n         count_is_zero_o <= 1'b1;\n      end\n   end else if(advance_i) begin\n      if(|count) count <= count - 1;\n      if(count == 1) begin\n         count_is_zero_o <= 1'b1;\n      end\n   end\nend\n\nendmodule")};
+String temp_44_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule AddressGen2 #(\n   parameter ADDR_W   = 10,\n   parameter PERIOD_W = 10,\n   parameter DELAY_W  = 7,\n   parameter DATA_W   = 8\n) (\n   input clk_i,\n   input rst_i,\n\n   input run_i,\n\n   //configurations \n   input        [  ADDR_W - 1:0] start_i,\n   input        [PERIOD_W - 1:0] duty_i,\n\n   input        [PERIOD_W - 1:0] per_i,\n   input signed [  ADDR_W - 1:0] incr_i,\n\n   input        [  ADDR_W - 1:0] iter_i,\n   input signed [  ADDR_W - 1:0] shift_i,\n\n   input        [PERIOD_W - 1:0] per2_i,\n   input signed [  ADDR_W - 1:0] incr2_i,\n\n   input        [  ADDR_W - 1:0] iter2_i,\n   input signed [  ADDR_W - 1:0] shift2_i,\n\n   input        [ DELAY_W - 1:0] delay_i,\n\n   //outputs \n   output                    valid_o,\n   input                     ready_i,\n   output     [ADDR_W - 1:0] addr_o,\n   output                    store_o,\n\n   output     done_o\n);\n\n   SuperAddress #(\n      .ADDR_W(ADDR_W),\n      .PERIOD_W(PERIOD_W),\n      .DELAY_W(DELAY_W),\n      .DATA_W(DATA_W)\n      ) reader (\n      .clk_i(clk_i),\n      .rst_i(rst_i),\n      .run_i(run_i),\n      .done_o(done_o),\n\n      .ignore_first_i(1'b0),\n\n      //configurations \n      .per_i(per_i),\n      .delay_i (delay_i),\n      .start_i (start_i),\n      .incr_i  (incr_i),\n\n      .iter_i(iter_i),\n      .duty_i      (duty_i),\n      .shift_i     (shift_i),\n\n      .per2_i(per2_i),\n      .incr2_i(incr2_i),\n      .iter2_i(iter2_i),\n      .shift2_i(shift2_i),\n\n      .per3_i(0),\n      .incr3_i(0),\n      .iter3_i(0),\n      .shift3_i(0),\n\n      .doneDatabus(),\n      .doneAddress(),\n\n      //outputs \n      .valid_o(valid_o),\n      .ready_i(ready_i),\n      .addr_o (addr_o),\n      .store_o(store_o),\n\n      .databus_ready(1'b1),\n      .databus_valid(),\n      .databus_addr(),\n      .databus_len(),\n      .databus_last(1'b1),\n\n      // Data interface\n      .data_valid_i(1'b1),\n      .data_ready_i(1'b1),\n      .reading(1'b1),\n\n      .count_i(0),\n      .start_address_i(0),\n      .address_shift_i(0),\n      .databus_length(0)\n   );\n\nendmodule  // MyAddressGen\n")};
+String temp_45_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule iob_ram_2p #(\n   parameter HEXFILE = \"none\",\n   parameter DATA_W  = 0,\n   parameter ADDR_W  = 0\n) (\n   input clk_i,\n\n   //write port\n   input              w_en_i,\n   input [ADDR_W-1:0] w_addr_i,\n   input [DATA_W-1:0] w_data_i,\n\n   //read port\n   input               r_en_i,\n   input  [ADDR_W-1:0] r_addr_i,\n   output [DATA_W-1:0] r_data_o\n);\n\n   //this allows ISE 14.7 to work; do not remove\n   localparam MEM_INIT_FILE_INT = HEXFILE;\n\n   // Declare the RAM\n   reg [DATA_W-1:0] mem    [(2**ADDR_W)-1:0];\n\n`ifdef NO_X_SIM\n   integer i;\n`endif\n   reg [DATA_W-1:0] r_data;\n   // Initialize the RAM\n   initial begin\n       if (MEM_INIT_FILE_INT != \"none\") begin\n           $readmemh(MEM_INIT_FILE_INT, mem, 0, (2 ** ADDR_W) - 1);\n       end else begin\n`ifdef NO_X_SIM\n         // We rather initialize with some dummy value than with zeroes. More likely to catch a problem.\n           for(i = 0; i < (2**ADDR_W); i = i + 1) begin\n               mem[i] = {(DATA_W/8){8'hBA}};\n           end\n`endif\n    end\n   end\n\n   //read port\n   always @(posedge clk_i) begin\n       if (r_en_i) begin\n           r_data <= mem[r_addr_i];\n       end\n   end\n\n   //write port\n   always @(posedge clk_i) begin\n       if (w_en_i) begin\n           mem[w_addr_i] <= w_data_i;\n       end\n   end\n\n   assign r_data_o = r_data;\n\nendmodule\n")};
+String temp_46_CONTENT = {String("`timescale 1ns / 1ps\n`include \"iob_utils.vh\"\n\n\nmodule iob_fifo_sync #(\n   parameter W_DATA_W = 21,\n   R_DATA_W = 21,\n   ADDR_W = 21,  //higher ADDR_W lower DATA_W\n   //determine W_ADDR_W and R_ADDR_W\n   MAXDATA_W =\n      `IOB_MAX(W_DATA_W, R_DATA_W),\n   MINDATA_W =\n      `IOB_MIN(W_DATA_W, R_DATA_W),\n   R = MAXDATA_W / MINDATA_W,\n   MINADDR_W = ADDR_W - $clog2(R),  //lower ADDR_W (higher DATA_W)\n   W_ADDR_W = (W_DATA_W == MAXDATA_W) ? MINADDR_W : ADDR_W,\n   R_ADDR_W = (R_DATA_W == MAXDATA_W) ? MINADDR_W : ADDR_W\n) (\n   input [1-1:0] clk_i,\n   input [1-1:0] cke_i,\n   input [1-1:0] arst_i,\n\n   input rst_i,\n\n   //write port\n   input                 w_en_i,\n   input  [W_DATA_W-1:0] w_data_i,\n   output                w_full_o,\n\n   //read port\n   input                 r_en_i,\n   output [R_DATA_W-1:0] r_data_o,\n   output                r_empty_o,\n\n   //write port\n   output                 ext_mem_clk_o,\n   output [        R-1:0] ext_mem_w_en_o,\n   output [MINADDR_W-1:0] ext_mem_w_addr_o,\n   output [MAXDATA_W-1:0] ext_mem_w_data_o,\n   //read port\n   output [        R-1:0] ext_mem_r_en_o,\n   output [MINADDR_W-1:0] ext_mem_r_addr_o,\n   input  [MAXDATA_W-1:0] ext_mem_r_data_i,\n\n   //FIFO level\n   output [(ADDR_W+1)-1:0] level_o\n);\n\n   localparam ADDR_W_DIFF = $clog2(R);\n   localparam [ADDR_W:0] FIFO_SIZE = {1'b1, {ADDR_W{1'b0}}};  //in bytes\n\n   //effective write enable\n   wire                w_en_int = (w_en_i & (~w_full_o));\n\n   //write address\n   wire [W_ADDR_W-1:0] w_addr;\n   versat_counter #(\n      .DATA_W (W_ADDR_W),\n      .RST_VAL({W_ADDR_W{1'd0}})\n   ) w_addr_cnt0 (\n      .clk_i(clk_i), //clock signal\n      .cke_i(cke_i), //clock enable\n      .arst_i(arst_i), //asynchronous reset\n\n      .rst_i (rst_i),\n      .en_i  (w_en_int),\n      .data_o(w_addr)\n   );\n\n   //effective read enable\n   wire                r_en_int = (r_en_i & (~r_empty_o));\n\n   //read address\n   wire [R_ADDR_W-1:0] r_addr;\n   versat_counter #(\n      .DATA_W (R_ADDR_W),\n      .RST_VAL({R_ADDR_W{1'd0}})\n   ) r_addr_cnt0 (\n      .clk_i(clk_i), //clock signal\n      .cke_i(cke_i), //clock enable\n      .arst_i(arst_i), //asynchronous reset\n\n      .rst_i (rst_i),\n      .en_i  (r_en_int),\n      .data_o(r_addr)\n   );\n\n   //assign according to assymetry type\n   localparam [ADDR_W-1:0] W_INCR = (W_DATA_W > R_DATA_W) ?\n                  {{ADDR_W-1{1'd0}},{1'd1}} << ADDR_W_DIFF : {{ADDR_W-1{1'd0}},{1'd1}};\n   localparam [ADDR_W-1:0] R_INCR = (R_DATA_W > W_DATA_W) ?\n                  {{ADDR_W-1{1'd0}},{1'd1}} << ADDR_W_DIFF : {{ADDR_W-1{1'd0}},{1'd1}};\n\n   //FIFO level\n   reg  [ADDR_W:0] level_nxt;\n   wire [ADDR_W:0] level_int;\n   iob_reg_r #(\n      .DATA_W (ADDR_W + 1),\n      .RST_VAL({(ADDR_W + 1) {1'd0}})\n   ) level_reg0 (\n      .clk_i(clk_i), //clock signal\n      .cke_i(cke_i), //clock enable\n      .arst_i(arst_i), //asynchronous reset\n\n      .rst_i(rst_i),\n\n      .data_i(level_nxt),\n      .data_o(level_int)\n   );\n\n   reg [(ADDR_W+1)-1:0] level_incr;\n   always @* begin\n      level_incr = level_int + W_INCR;\n      level_nxt  = level_int;\n      if (w_en_int && (!r_en_int))  //write only\n         level_nxt = level_incr;\n      else if (w_en_int && r_en_int)  //write and read\n         level_nxt = level_incr - R_INCR;\n      else if (r_en_int)  //read only\n         level_nxt = level_int - R_INCR;\n   end\n\n   assign level_o = level_int;\n\n   //FIFO empty\n   wire r_empty_nxt;\n   assign r_empty_nxt = level_nxt < {1'b0,R_INCR};\n   iob_reg_r #(\n      .DATA_W (1),\n      .RST_VAL(1'd1)\n   ) r_empty_reg0 (\n      .clk_i(clk_i), //clock signal\n      .cke_i(cke_i), //clock enable\n      .arst_i(arst_i), //asynchronous reset\n      .rst_i(rst_i),\n      .data_i(r_empty_nxt),\n      .data_o(r_empty_o)\n   );\n\n   //FIFO full\n   wire w_full_nxt;\n   assign w_full_nxt = level_nxt > (FIFO_SIZE - W_INCR);\n   iob_reg_r #(\n      .DATA_W (1),\n      .RST_VAL(1'd0)\n   ) w_full_reg0 (\n      .clk_i(clk_i), //clock signal\n      .cke_i(cke_i), //clock enable\n      .arst_i(arst_i), //asynchronous reset\n      .rst_i(rst_i),\n      .data_i(w_full_nxt),\n      .data_o(w_full_o)\n   );\n\n   assign ext_mem_clk_o = clk_i;\n\n   iob_asym_converter #(\n      .W_DATA_W(W_DATA_W),\n      .R_DATA_W(R_DATA_W),\n      .ADDR_W  (ADDR_W)\n   ) asym_converter (\n      .ext_mem_w_en_o  (ext_mem_w_en_o),\n      .ext_mem_w_addr_o(ext_mem_w_addr_o),\n      .ext_mem_w_data_o(ext_mem_w_data_o),\n      .ext_mem_r_en_o  (ext_mem_r_en_o),\n      .ext_mem_r_addr_o(ext_mem_r_addr_o),\n      .ext_mem_r_data_i(ext_mem_r_data_i),\n      .clk_i(clk_i), //clock signal\n      .cke_i(cke_i), //clock enable\n      .arst_i(arst_i), //asynchronous reset\n      .rst_i(rst_i),\n      .w_addr_i        (w_addr),\n      .w_en_i          (w_en_int),\n      .w_data_i        (w_data_i),\n      .r_addr_i        (r_addr),\n      .r_en_i          (r_en_int),\n      .r_data_o        (r_data_o)\n   );\n\nendmodule\n")};
+String temp_47_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule SimpleAXItoAXI #(\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter AXI_LEN_W  = 8,\n   parameter AXI_ID_W   = 4,\n   parameter LEN_W      = 8\n) (\n   input                             m_wvalid_i,\n   output reg                        m_wready_o,\n   input      [      AXI_ADDR_W-1:0] m_waddr_i,\n   input      [      AXI_DATA_W-1:0] m_wdata_i,\n   input      [(AXI_DATA_W / 8)-1:0] m_wstrb_i,\n   input      [           LEN_W-1:0] m_wlen_i,\n   output reg                        m_wlast_o,\n\n   input                       m_rvalid_i,\n   output reg                  m_rready_o,\n   input      [AXI_ADDR_W-1:0] m_raddr_i,\n   output     [AXI_DATA_W-1:0] m_rdata_o,\n   input      [     LEN_W-1:0] m_rlen_i,\n   output                      m_rlast_o,\n\n   output [AXI_ID_W-1:0] axi_awid_o,\n   output [AXI_ADDR_W-1:0] axi_awaddr_o,\n   output [AXI_LEN_W-1:0] axi_awlen_o,\n   output [3-1:0] axi_awsize_o,\n   output [2-1:0] axi_awburst_o,\n   output [2-1:0] axi_awlock_o,\n   output [4-1:0] axi_awcache_o,\n   output [3-1:0] axi_awprot_o,\n   output [4-1:0] axi_awqos_o,\n   output [1-1:0] axi_awvalid_o,\n   input [1-1:0] axi_awready_i,\n   output [AXI_DATA_W-1:0] axi_wdata_o,\n   output [(AXI_DATA_W/8)-1:0] axi_wstrb_o,\n   output [1-1:0] axi_wlast_o,\n   output [1-1:0] axi_wvalid_o,\n   input [1-1:0] axi_wready_i,\n   input [AXI_ID_W-1:0] axi_bid_i,\n   input [2-1:0] axi_bresp_i,\n   input [1-1:0] axi_bvalid_i,\n   output [1-1:0] axi_bready_o,\n   output [AXI_ID_W-1:0] axi_arid_o,\n   output [AXI_ADDR_W-1:0] axi_araddr_o,\n   output [AXI_LEN_W-1:0] axi_arlen_o,\n   output [3-1:0] axi_arsize_o,\n   output [2-1:0] axi_arburst_o,\n   output [2-1:0] axi_arlock_o,\n   output [4-1:0] axi_arcache_o,\n   output [3-1:0] axi_arprot_o,\n   output [4-1:0] axi_arqos_o,\n   output [1-1:0] axi_arvalid_o,\n   input [1-1:0] axi_arready_i,\n   input [AXI_ID_W-1:0] axi_rid_i,\n   input [AXI_DATA_W-1:0] axi_rdata_i,\n   input [2-1:0] axi_rresp_i,\n   input [1-1:0] axi_rlast_i,\n   input [1-1:0] axi_rvalid_i,\n   output [1-1:0] axi_rready_o,\n\n   input clk_i,\n   input rst_i\n);\n\n   wire temp_axi_awvalid;\n   wire temp_axi_awready;\n   wire temp_axi_wvalid;\n   wire temp_axi_wready;\n   wire temp_axi_bvalid;\n   wire temp_axi_bready;\n\n   VersatAxiDelay delayAW(\n      .s_valid_i(temp_axi_awvalid),\n      .s_ready_o(temp_axi_awready),\n      .m_valid_o(axi_awvalid_o),\n      .m_ready_i(axi_awready_i),\n      .clk_i(clk_i),\n      .rst_i(rst_i)      \n   );\n\n   VersatAxiDelay delayW(\n      .s_valid_i(temp_axi_wvalid),\n      .s_ready_o(temp_axi_wready),\n      .m_valid_o(axi_wvalid_o),\n      .m_ready_i(axi_wready_i),\n      .clk_i(clk_i),\n      .rst_i(rst_i)      \n   );\n\n   VersatAxiDelay delayB(\n      .s_valid_i(axi_bvalid_i),\n      .s_ready_o(axi_bready_o),\n      .m_valid_o(temp_axi_bvalid),\n      .m_ready_i(temp_axi_bready),\n      .clk_i(clk_i),\n      .rst_i(rst_i)      \n   );\n\n   SimpleAXItoAXIWrite #(\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .AXI_DATA_W(AXI_DATA_W),\n      .AXI_ID_W  (AXI_ID_W),\n      .AXI_LEN_W (AXI_LEN_W),\n      .LEN_W     (LEN_W)\n   ) simpleWrite (\n      .m_wvalid_i(m_wvalid_i),\n      .m_wready_o(m_wready_o),\n      .m_waddr_i (m_waddr_i),\n      .m_wdata_i (m_wdata_i),\n      .m_wstrb_i (m_wstrb_i),\n      .m_wlen_i  (m_wlen_i),\n      .m_wlast_o (m_wlast_o),\n\n      .axi_awid_o(axi_awid_o), //Address write channel ID.\n      .axi_awaddr_o(axi_awaddr_o), //Address write channel address.\n      .axi_awlen_o(axi_awlen_o), //Address write channel burst length.\n      .axi_awsize_o(axi_awsize_o), //Address write channel burst size. This signal indicates the size of each transfer in the burst.\n      .axi_awburst_o(axi_awburst_o), //Address write channel burst type.\n      .axi_awlock_o(axi_awlock_o), //Address write channel lock type.\n      .axi_awcache_o(axi_awcache_o), //Address write channel memory type. Set to 0000 if master output; ignored if slave input.\n      .axi_awprot_o(axi_awprot_o), //Address write channel protection type. Set to 000 if master output; ignored if slave input.\n      .axi_awqos_o(axi_awqos_o), //Address write channel quality of service.\n      .axi_awvalid_o(temp_axi_awvalid), //Address write channel valid.\n      .axi_awready_i(temp_axi_awready), //Address write channel ready.\n      .axi_wdata_o(axi_wdata_o), //Write channel data.\n      .axi_wstrb_o(axi_wstrb_o), //Write channel write strobe.\n      .axi_wlast_o(axi_wlast_o), //Write channel last word flag.\n      .axi_wvalid_o(temp_axi_wvalid), //Write channel valid.\n      .axi_wready_i(temp_axi_wready), //Write channel ready.\n      .axi_bid_i(axi_bid_i), //Write response channel ID.\n      .axi_bresp_i(axi_bresp_i), //Write response channel response.\n      .axi_bvalid_i(temp_axi_bvalid), //Write response channel valid.\n      .axi_bready_o(temp_axi_bready), //Write response channel ready.\n\n      .clk_i(clk_i),\n      .rst_i(rst_i)\n   );\n\n   SimpleAXItoAXIRead #(\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .AXI_DATA_W(AXI_DATA_W),\n      .AXI_ID_W  (AXI_ID_W),\n      .AXI_LEN_W (AXI_LEN_W),\n      .LEN_W     (LEN_W)\n   ) simpleRead (\n      .m_rvalid_i(m_rvalid_i),\n      .m_rready_o(m_rready_o),\n      .m_raddr_i (m_raddr_i),\n      .m_rdata_o (m_rdata_o),\n      .m_rlen_i  (m_rlen_i),\n      .m_rlast_o (m_rlast_o),\n\n      .axi_arid_o(axi_arid_o), //Address read channel ID.\n      .axi_araddr_o(axi_araddr_o), //Address read channel address.\n      .axi_arlen_o(axi_arlen_o), //Address read channel burst length.\n      .axi_arsize_o(axi_arsize_o), //Address read channel burst size. This signal indicates the size of each transfer in the burst.\n      .axi_arburst_o(axi_arburst_o), //Address read channel burst type.\n      .axi_arlock_o(axi_arlock_o), //Address read channel lock type.\n      .axi_arcache_o(axi_arcache_o), //Address read channel memory type. Set to 0000 if master output; ignored if slave input.\n      .axi_arprot_o(axi_arprot_o), //Address read channel protection type. Set to 000 if master output; ignored if slave input.\n      .axi_arqos_o(axi_arqos_o), //Address read channel quality of service.\n      .axi_arvalid_o(axi_arvalid_o), //Address read channel valid.\n      .axi_arready_i(axi_arready_i), //Address read channel ready.\n      .axi_rid_i(axi_rid_i), //Read channel ID.\n      .axi_rdata_i(axi_rdata_i), //Read channel data.\n      .axi_rresp_i(axi_rresp_i), //Read channel response.\n      .axi_rlast_i(axi_rlast_i), //Read channel last word.\n      .axi_rvalid_i(axi_rvalid_i), //Read channel valid.\n      .axi_rready_o(axi_rready_o), //Read channel ready.\n\n      .clk_i(clk_i),\n      .rst_i(rst_i)\n   );\n\nendmodule  // SimpleAXItoAXI\n")};
+String temp_48_CONTENT = {String("`timescale 1ns / 1ps\n\n// Modules that forces the fastest side to slow down.\n// Basically converts two simple handshakes into one handshake\nmodule JoinTwoHandshakes #(\n   parameter FIRST_DATA_W = 0,\n   parameter SECOND_DATA_W = 0\n)(\n   input  first_valid_i,\n   output first_ready_o,\n   input  [FIRST_DATA_W-1:0]  first_data_i,\n\n   input  second_valid_i,\n   output second_ready_o,\n   input  [SECOND_DATA_W-1:0] second_data_i,\n\n   output result_valid_o,\n   input  result_ready_i,\n   output [FIRST_DATA_W-1:0]  result_first_data_o,\n   output [SECOND_DATA_W-1:0] result_second_data_o,\n\n   input forceReset,\n\n   input clk_i,\n   input rst_i\n);\n\nwire buffered_first_valid,buffered_second_valid;\n\nSkidBuffer #(.DATA_W(FIRST_DATA_W)) firstBuffer(\n   .in_valid_i(first_valid_i),\n   .in_ready_o(first_ready_o),\n   .in_data_i(first_data_i),\n\n   .out_valid_o(buffered_first_valid),\n   .out_ready_i(result_ready_i && buffered_second_valid),\n   .out_data_o(result_first_data_o),\n\n   .forceReset(forceReset),\n\n   .clk_i(clk_i),\n   .rst_i(rst_i)\n);\n\nSkidBuffer #(.DATA_W(SECOND_DATA_W)) secondBuffer(\n   .in_valid_i(second_valid_i),\n   .in_ready_o(second_ready_o),\n   .in_data_i(second_data_i),\n\n   .out_valid_o(buffered_second_valid),\n   .out_ready_i(result_ready_i && buffered_first_valid),\n   .out_data_o(result_second_data_o),\n\n   .forceReset(forceReset),\n\n   .clk_i(clk_i),\n   .rst_i(rst_i)\n);\n\nassign result_valid_o = buffered_first_valid & buffered_second_valid;\n\nendmodule\n\n")};
+String temp_49_CONTENT = {String("`timescale 1ns / 1ps\n\n// Buffer for simple handshake signals. \n// Think of a skid buffer but without registering the valid/ready signals, meaning that we keep the combinatorial path over the entire pipeline\n// Should have the same interface as a skid buffer, meaning that a simple change in modules should still work and improve performance, if needed\n\n// What this unit accomplishes is that we basically have a \"pull\" interface, since this unit is always asserting in_ready_o when it can.\n// Helpful to break ready/valid dependencies, since this unit does not need to wait for in_valid_i to become asserted before asserting ready_o\n\nmodule HandShakeBuffer #(\n   parameter DATA_W = 0\n)(\n   input  in_valid_i,\n   output reg in_ready_o,\n   input [DATA_W-1:0] in_data_i,\n\n   output reg out_valid_o,\n   input out_ready_i,\n   output [DATA_W-1:0] out_data_o,\n\n   input clk_i,\n   input rst_i\n);\n\nreg data_valid;\nreg [DATA_W-1:0] data_stored;\n\nassign out_data_o = data_stored;\nassign out_valid_o = data_valid;\n\nalways @(posedge clk_i,posedge rst_i) begin\n   if(rst_i) begin\n      data_valid <= 1'b0;\n      data_stored <= 0;\n   end else begin\n      // If no data, can always transfer\n      if(!data_valid && in_valid_i && in_ready_o) begin\n         data_valid <= 1'b1;\n         data_stored <= in_data_i;\n      end\n\n      // If data, can always output, and we then have no data\n      if(data_valid && out_valid_o && out_ready_i) begin\n         data_valid <= 1'b0;\n      end\n\n      // Unless the input is also trying to transfer, at which point we still have valid data\n      if(in_ready_o && in_valid_i && out_valid_o && out_ready_i) begin\n         data_valid <= 1'b1;\n         data_stored <= in_data_i;\n      end\n   end\nend\n\nalways @* begin\n   in_ready_o = 1'b0;\n\n    // If no data, can always transfer\n   if(!data_valid)\n      in_ready_o = 1'b1;\n\n   // Data is moved out and moved in at the same time.\n   // This is the combinatorial path that a skid buffer would break\n   // It also puts a dependency on in_valid/in_ready\n   if(in_valid_i && out_valid_o && out_ready_i)\n      in_ready_o = 1'b1;\n\nend\n\nendmodule\n")};
+String temp_50_CONTENT = {String("`timescale 1ns / 1ps\n\n`define max(a, b) (a) > (b) ? (a) : (b)\n`define min(a, b) (a) < (b) ? (a) : (b)\n\n// Addresses are given in byte space\n// The total size in bits is given by multiplying 2^ADDR_W * min(A_DATA_W,B_DATA_W)\n// The number of blocks used is equal to max([A|B]_DATA_W) / min([A|B]_DATA_W)\n\nmodule my_2p_asym_ram #(\n   parameter W_DATA_W = 0,\n   parameter R_DATA_W = 0,\n   parameter ADDR_W   = 0\n) (\n   input                     clk_i,\n   //write port\n   input                     w_en_i,\n   input      [W_DATA_W-1:0] w_data_i,\n   input      [  ADDR_W-1:0] w_addr_i,\n   //read port\n   input                     r_en_i,\n   input      [  ADDR_W-1:0] r_addr_i,\n   output reg [R_DATA_W-1:0] r_data_o\n);\n\n   //determine the number of blocks N\n   localparam MAXDATA_W =\n   `max(W_DATA_W, R_DATA_W);\n   localparam MINDATA_W =\n   `min(W_DATA_W, R_DATA_W);\n   localparam N = MAXDATA_W / MINDATA_W;\n   localparam N_W = $clog2(N);\n   localparam SYMBOL_W = $clog2(MINDATA_W / 8);\n\n   //symmetric memory block buses\n   //write buses\n   reg  [        N-1:0] en_wr;\n   reg  [MINDATA_W-1:0] data_wr[N-1:0];\n\n   //read buses\n   wire [MINDATA_W-1:0] data_rd[N-1:0];\n\n   //instantiate N symmetric RAM blocks and connect them to the buses\n   generate\n   genvar i;\n      for (i = 0; i < N; i = i + 1) begin : ramInst\n         iob_ram_2p #(\n            .DATA_W(MINDATA_W),\n            .ADDR_W(ADDR_W - (N_W + SYMBOL_W))\n         ) iob_2p_ram_inst (\n            .clk_i   (clk_i),\n            .w_en_i  (en_wr[i]),\n            .w_addr_i(w_addr_i[ADDR_W-1:N_W+SYMBOL_W]),\n            .w_data_i(data_wr[i]),\n            .r_en_i  (r_en_i),\n            .r_addr_i(r_addr_i[ADDR_W-1:N_W+SYMBOL_W]),\n            .r_data_o(data_rd[i])\n         );\n\n      end\n   endgenerate\n\n   generate\n\n      if (W_DATA_W > R_DATA_W) begin\n\n         integer j, l;\n\n         //write parallel\n         always @* begin\n            for (j = 0; j < N; j = j + 1) begin\n               en_wr[j]   = w_en_i;\n               data_wr[j] = w_data_i[j*MINDATA_W+:MINDATA_W];\n            end\n         end\n\n         //read address register\n         reg [ADDR_W-1:0] r_addr_i_lsbs_reg;\n         always @(posedge clk_i) r_addr_i_lsbs_reg <= r_addr_i[ADDR_W-1:0] >> SYMBOL_W;\n\n         //read mux\n         always @* begin\n            r_data_o = 1'b0;\n            for (l = 0; l < N; l = l + 1) begin\n               r_data_o = data_rd[r_addr_i_lsbs_reg];\n            end\n         end\n\n      end else if (W_DATA_W < R_DATA_W) begin\n         integer j, k;\n         wire [ADDR_W-1:0] byteAddr = w_addr_i[ADDR_W-1:0] >> SYMBOL_W;\n\n         //write serial\n         always @* begin\n            for (j = 0; j < N; j = j + 1) begin\n               en_wr[j]   = w_en_i & (byteAddr[N_W-1:0] == j[N_W-1:0]);\n               data_wr[j] = w_data_i;\n            end\n         end\n         //read parallel\n         always @* begin\n            r_data_o = 1'b0;\n            for (k = 0; k < N; k = k + 1) begin\n               r_data_o[k*MINDATA_W+:MINDATA_W] = data_rd[k];\n            end\n         end\n\n      end else begin  //W_DATA_W = R_DATA_W\n         //write serial\n         always @* begin\n            en_wr[0]   = w_en_i;\n            data_wr[0] = w_data_i;\n         end\n         //read parallel\n         always @(data_rd[0]) begin\n            r_data_o = data_rd[0];\n         end\n      end\n   endgenerate\nendmodule  // my_2p_asym_ram\n\n`undef max\n`undef min\n\n")};
+String temp_51_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule SimpleAXItoAXIRead #(\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter AXI_LEN_W  = 8,\n   parameter AXI_ID_W   = 4,\n   parameter LEN_W      = 8\n) (\n   input                       m_rvalid_i,\n   output reg                  m_rready_o,\n   input      [AXI_ADDR_W-1:0] m_raddr_i,\n   output     [AXI_DATA_W-1:0] m_rdata_o,\n   input      [     LEN_W-1:0] m_rlen_i,\n   output                      m_rlast_o,\n\n   /*\n      NOTE: Using the burst aligner to calculate the logic for rlast is error prone.\n      At the beginning, we receive a length. Because the outside expects data aligned, it also means that it expects a constant amount of transfers.\n      It does not matter if everything is align or not, the ouside code expects the same number of transfers for the same length.\n      It is therefore easier to calculate the number of transfers from the length and to control the transfer logic from that aspect.\n   */ \n\n   output [AXI_ID_W-1:0] axi_arid_o,\n   output [AXI_ADDR_W-1:0] axi_araddr_o,\n   output [AXI_LEN_W-1:0] axi_arlen_o,\n   output [3-1:0] axi_arsize_o,\n   output [2-1:0] axi_arburst_o,\n   output [2-1:0] axi_arlock_o,\n   output [4-1:0] axi_arcache_o,\n   output [3-1:0] axi_arprot_o,\n   output [4-1:0] axi_arqos_o,\n   output [1-1:0] axi_arvalid_o,\n   input [1-1:0] axi_arready_i,\n   input [AXI_ID_W-1:0] axi_rid_i,\n   input [AXI_DATA_W-1:0] axi_rdata_i,\n   input [2-1:0] axi_rresp_i,\n   input [1-1:0] axi_rlast_i,\n   input [1-1:0] axi_rvalid_i,\n   output [1-1:0] axi_rready_o,\n\n   input clk_i,\n   input rst_i\n);\n\n   localparam OFFSET_W = $clog2(AXI_DATA_W / 8);\n\n   localparam [2:0] axi_size = ((AXI_DATA_W == 16)   ? 3'b001 : \n                                (AXI_DATA_W == 32)   ? 3'b010 :\n                                (AXI_DATA_W == 64)   ? 3'b011 :\n                                (AXI_DATA_W == 128)  ? 3'b100 :\n                                (AXI_DATA_W == 256)  ? 3'b101 :\n                                (AXI_DATA_W == 512)  ? 3'b110 : \n                                (AXI_DATA_W == 1024) ? 3'b111 : 3'b000);\n\n   // Read\n\n   assign axi_arid_o    = 0;\n   assign axi_arsize_o  = axi_size;\n   assign axi_arburst_o = 'b01;  // INCR\n   assign axi_arlock_o  = 0;\n   assign axi_arcache_o = 0;\n   assign axi_arprot_o  = 0;\n   assign axi_arqos_o   = 0;\n\n   reg [1:0] read_state;\n   reg arvalid, rready;\n\n   assign axi_arvalid_o = arvalid;\n   assign axi_rready_o  = (read_state == 2'h3);\n\n   wire read_last_transfer;\n   wire burst_i_align_empty;\n\n   // Read\n   BurstAlign #(\n      .AXI_DATA_W(AXI_DATA_W)\n   ) aligner (\n      .offset_i(m_raddr_i[OFFSET_W-1:0]),\n      .start_i (read_state == 0),\n\n      .burst_last_i   (axi_rvalid_i && axi_rready_o && axi_rlast_i),\n      .transfer_last_i(read_last_transfer),\n\n      .last_transfer_o(/* m_rlast_o */),\n      .empty_o        (burst_i_align_empty),\n\n      // Simple interface for data_in\n      .data_in_i (axi_rdata_i),\n      .valid_in_i(axi_rvalid_i),\n\n      // Simple interface for data_out\n      .data_out_o (m_rdata_o),\n      .valid_out_o(m_rready_o),\n\n      .clk_i(clk_i),\n      .rst_i(rst_i)\n   );\n\n   reg transfer_start, burst_i_start;\n\n   wire [AXI_LEN_W-1:0] true_axi_arlen;\n   reg [AXI_LEN_W-1:0] read_axi_len;\n   assign axi_arlen_o = read_axi_len;\n\n   wire [31:0] symbolsToRead;\n   reg [31:0] symbolsRead;\n\n   // TODO:\n   // Read the text on the interface.\n   // This is mostly a hack to make things work correct, but it is more logic than we actually need.\n   // We can probably save a good deal of resources by simplifying this following the approach mentioned on the interface text.\n   assign m_rlast_o = (read_state == 0 || (m_rready_o && (symbolsRead + 1) >= symbolsToRead));\n\n   AXITransferController #(\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .AXI_DATA_W(AXI_DATA_W),\n      .AXI_LEN_W (AXI_LEN_W),\n      .LEN_W     (LEN_W)\n   ) read_controller (\n      .address_i(m_raddr_i),\n      .length_i (m_rlen_i),   // In bytes\n\n      .transfer_start_i((read_state == 2'h0) && m_rvalid_i && burst_i_align_empty),\n      .burst_start_i   ((read_state == 2'h2) && axi_arready_i && axi_arvalid_o),\n\n      // Do not need them for read operation\n      .initial_strb_o      (),\n      .final_strb_o        (),\n      .symbolsToRead_o     (symbolsToRead),\n      .last_transfer_next_o(),\n\n      .true_axi_axaddr_o(axi_araddr_o),\n\n      // TODO: Register these signals to \n      .true_axi_axlen_o(true_axi_arlen),\n      .last_transfer_o (read_last_transfer),\n\n      .clk_i(clk_i),\n      .rst_i(rst_i)\n   );\n\n   always @(posedge clk_i, posedge rst_i) begin\n      if (rst_i) begin\n         read_state   <= 0;\n         arvalid      <= 0;\n         read_axi_len <= 0;\n         symbolsRead  <= 0;\n      end else begin\n         if(read_state > 0) begin\n            if(m_rvalid_i && m_rready_o) begin\n               symbolsRead <= symbolsRead + 1;\n            end\n         end\n\n         case (read_state)\n            2'h0: begin\n               if (m_rvalid_i && burst_i_align_empty) begin\n                  read_state <= 2'h1;\n                  symbolsRead <= 0;\n               end\n            end\n            2'h1: begin\n               arvalid      <= 1'b1;\n               read_state   <= 2'h2;\n               read_axi_len <= true_axi_arlen;\n            end\n            2'h2: begin  // Write address set\n               if (axi_arready_i) begin\n                  arvalid    <= 1'b0;\n                  read_state <= 2'h3;\n               end\n            end\n            2'h3: begin\n               if (axi_rvalid_i && axi_rready_o && axi_rlast_i) begin\n                  if (read_last_transfer) begin\n                     read_state <= 2'h0;\n                  end else begin\n                     read_state <= 2'h1;\n                  end\n               end\n            end\n         endcase\n      end\n   end\n\nendmodule  // SimpleAXItoAXIRead\n")};
+String temp_52_CONTENT = {String("`timescale 1ns / 1ps\n\n/*\n\nReceives addresses in the slave interface\nReads memory content (memory connected to the mem_ wire)\nWrites data through the master interface\n\nThis module is intended to function as a simple adapter.\nConnect a address generator on one side and connect this to the other and it should work fine.\nTODO: To make this easier to use, the m_last_i signals should get through. The Slave interface is really poor compared to what is actually expected.\n      A proper slave probable uses more logic but it simplifies the code a lot more.\n\n*/\n\nmodule MemoryReader #(\n   parameter ADDR_W = 32,\n   parameter DATA_W = 32\n) (\n   // Slave\n   input               s_valid_i,\n   output              s_ready_o,\n   input  [ADDR_W-1:0] s_addr_i,\n\n   // Master\n   output reg              m_valid_o,\n   input                   m_ready_i,\n   output     [ADDR_W-1:0] m_addr_o,\n   output     [DATA_W-1:0] m_data_o,\n   input                   m_last_i,\n\n   // Connect to memory\n   output              mem_enable_o,\n   output [ADDR_W-1:0] mem_addr_o,\n   input  [DATA_W-1:0] mem_data_i,\n\n   input               force_reset_i,\n\n   input clk_i,\n   input rst_i\n);\n\n   wire s_transfer = (s_valid_i && s_ready_o);\n   wire m_transfer = (m_valid_o && m_ready_i);\n\n   reg [ADDR_W-1:0] last_addr;\n\n   always @(posedge clk_i, posedge rst_i) begin\n      if (rst_i) begin\n         m_valid_o <= 1'b0;\n         last_addr <= 0;\n      end else begin\n         if (m_transfer) begin\n            m_valid_o <= 1'b0;\n         end\n\n         if (s_transfer && !m_last_i) begin\n            m_valid_o <= 1'b1;\n            last_addr <= s_addr_i;\n         end\n\n         if(force_reset_i) begin\n            m_valid_o <= 1'b0;\n         end\n      end\n   end\n\n   assign s_ready_o    = m_valid_o ? m_ready_i : 1'b1;\n\n   assign mem_enable_o = s_transfer;\n   assign mem_addr_o   = s_addr_i;\n\n   assign m_data_o     = mem_data_i;\n   assign m_addr_o     = last_addr;\n\nendmodule  // MemoryReader\n")};
+String temp_53_CONTENT = {String("`timescale 1ns / 1ps\n\n// Buffer for simple handshake signals that breaks ready/valid signals dependencies while keeping a throughput of 1\n// This means that multiple skid buffers in a row do not suffer from a large combinatorial path that spans the entire pipeline\n// This is accomplished by having a second buffer that stores the extra data generated \n// from taking one extra cycle to properly react to the ready/signal values\n// This and handshake buffer are equivalent interface wise, but this unit uses more memory and logic in order to achieve greater throughput\n\nmodule SkidBuffer #(\n   parameter DATA_W = 32\n)(\n   input  in_valid_i,\n   output in_ready_o,\n   input [DATA_W-1:0] in_data_i,\n\n   output out_valid_o,\n   input out_ready_i,\n   output [DATA_W-1:0] out_data_o,\n\n   input forceReset,\n\n   input clk_i,\n   input rst_i\n);\n\nlocalparam EMPTY = 2'b00,\n           DATA = 2'b01,\n           EXTRA = 2'b10;\n\nreg [1:0] state;\nreg [DATA_W-1:0] data_stored,extra_data_stored;\n\nwire in_transfer = (in_valid_i & in_ready_o);\nwire out_transfer = (out_valid_o & out_ready_i);\n\n// Technically combinatorial but of a register on our side. Compiler could be smart enough to detect this, but can always rewrite if needed.\nassign in_ready_o = (state == EMPTY || state == DATA);\nassign out_valid_o = (state == DATA || state == EXTRA);\nassign out_data_o = data_stored;\n\nalways @(posedge clk_i,posedge rst_i) begin\n   if(rst_i) begin\n      state <= EMPTY;\n      data_stored <= 0;\n      extra_data_stored <= 0;\n   end else begin\n      case(state)\n      EMPTY: begin // out_transfer cannot occur here\n         if(in_transfer) begin\n            state <= DATA;\n            data_stored <= in_data_i;\n         end\n      end\n      DATA: begin\n         case({in_transfer,out_transfer})\n         2'b00: begin\n            // Nothing\n         end\n         2'b01: begin\n            state <= EMPTY;\n         end\n         2'b10: begin\n            state <= EXTRA;\n            extra_data_stored <= in_data_i;\n         end\n         2'b11: begin\n            data_stored <= in_data_i;\n         end\n         endcase\n      end\n      EXTRA: begin // in_transfer cannot occur here.\n         if(out_transfer) begin\n            state <= DATA;\n            data_stored <= extra_data_stored;\n         end\n      end\n      2'b11:; // Nothing\n      endcase\n\n      if(forceReset) begin\n         state <= EMPTY;\n      end\n   end\nend\n\nendmodule\n")};
+String temp_54_CONTENT = {String("`timescale 1ns / 1ps\n\n// Only intented for simulation. Address in byteSpace\nmodule SimHelper_DatabusMem #(\n   parameter ADDR_W = 1,\n   parameter DATA_W = 32,\n   parameter LEN_W  = 8\n) (\n   output                      databus_ready,\n   input                       databus_valid,\n   input      [    ADDR_W-1:0] databus_addr,\n   output reg [    DATA_W-1:0] databus_rdata,\n   input      [    DATA_W-1:0] databus_wdata,\n   input      [(DATA_W/8)-1:0] databus_wstrb,\n   input      [     LEN_W-1:0] databus_len,\n   output                      databus_last,\n\n   input              insertValue,\n   input [ADDR_W-1:0] addrToInsert,\n   input [DATA_W-1:0] valueToInsert,\n\n   input clk,\n   input rst\n);\n\n   localparam OFFSET = $clog2(DATA_W / 8);\n   localparam MEMSIZE = 2 ** (ADDR_W - OFFSET);\n   reg [DATA_W-1:0] mem        [MEMSIZE-1:0];\n\n   reg [       1:0] state;\n   reg [ LEN_W-1:0] counter;\n   reg [ADDR_W-1:0] addr;\n   reg              read_valid;\n\n   assign databus_ready = ((state == 2'h1 && read_valid) || state == 2'h2);\n   assign databus_last  = (counter == 0 && (state != 2'h0));\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         state      <= 0;\n         counter    <= 0;\n         addr       <= 0;\n         read_valid <= 0;\n      end else begin\n         if (insertValue) begin\n            mem[addrToInsert>>OFFSET] <= valueToInsert;\n         end\n\n         case (state)\n            2'h0:\n            if (databus_valid) begin\n               counter <= {{OFFSET{1'b0}}, databus_len[(LEN_W-1):OFFSET]};\n               addr    <= databus_addr;\n\n               if (|databus_wstrb == 0) begin\n                  state <= 2'h1;\n               end else begin\n                  state <= 2'h2;\n               end\n            end\n            2'h1: begin  // Read\n               if (databus_valid) begin\n                  read_valid    <= 1'b1;\n                  databus_rdata <= mem[addr>>OFFSET];\n                  counter       <= counter - 1;\n                  addr          <= addr + (1 << OFFSET);\n                  if (counter == 0) begin\n                     state <= 2'h0;\n                  end\n               end\n            end\n            2'h2: begin\n               if (databus_valid) begin\n                  counter           <= counter - 1;\n                  mem[addr>>OFFSET] <= databus_wdata;\n                  addr              <= addr + (1 << OFFSET);\n                  if (counter == 0) begin\n                     state <= 2'h0;\n                  end\n               end\n            end\n         endcase\n      end\n   end\n\nendmodule\n")};
+String temp_55_CONTENT = {String("`define IOB_MAX(a, b) (((a) > (b)) ? (a) : (b))\n`define IOB_MIN(a, b) (((a) < (b)) ? (a) : (b))\n`define IOB_ABS(a, w) {a[w-1]? (-a): (a)}\n\n\n`define IOB_NBYTES (DATA_W/8)\n`define IOB_GET_NBYTES(WIDTH) (WIDTH/8 + |(WIDTH%8))\n`define IOB_NBYTES_W $clog2(`IOB_NBYTES)\n\n`define IOB_WORD_ADDR(ADDR) ((ADDR>>`IOB_NBYTES_W)<<`IOB_NBYTES_W)\n\n`define IOB_BYTE_OFFSET(ADDR) (ADDR%(DATA_W/8))\n\n`define IOB_GET_WDATA(ADDR, DATA) (DATA<<(8*`IOB_BYTE_OFFSET(ADDR)))\n`define IOB_GET_WSTRB(ADDR, WIDTH) (((1<<`IOB_GET_NBYTES(WIDTH))-1)<<`IOB_BYTE_OFFSET(ADDR))\n`define IOB_GET_RDATA(ADDR, DATA, WIDTH) ((DATA>>(8*`IOB_BYTE_OFFSET(ADDR)))&((1<<WIDTH)-1))\n\n`define IOB_CSHIFT_LEFT(DATA_W, DATA, SHIFT) ((DATA << SHIFT) | (DATA >> (DATA_W - SHIFT)))\n`define IOB_CSHIFT_RIGHT(DATA_W, DATA, SHIFT) ((DATA >> SHIFT) | (DATA << (DATA_W - SHIFT)))\n\n//\n//TESTBENCH UTILS\n//\n\n//CLOCK GENERATOR\n`define IOB_CLOCK(CLK, PER) initial CLK=0; always #(PER/2) CLK = ~CLK;\n\n//PULSE GENERATOR\n`define IOB_PULSE(VAR, PRE, DURATION, POST) VAR=0; #PRE VAR=1; #DURATION VAR=0; #POST;\n\n//RESET GENERATOR\n`define IOB_RESET(CLK, RESET, PRE, DURATION, POST) RESET=~`IOB_REG_RST_POL;\\\n   #PRE RESET=`IOB_REG_RST_POL; #DURATION RESET=~`IOB_REG_RST_POL; #POST;\\\n   @(posedge CLK) #1;\n\n//SLEEP\n`define IOB_SLEEP(TIME) #TIME;\n\n\n//\n// BUS INTERCONNECT MACROS\n//\n\n//DATA WIDTHS\n`define VALID_W 1\n`define WSTRB_W_(D) D/8\n`define READY_W 1\n\n`define WRITE_W_(D) (D+(`WSTRB_W_(D)))\n`define READ_W_(D) (D)\n\n//DATA POSITIONS\n//REQ bus\n`define WDATA_P_(D) `WSTRB_W_(D)\n`define ADDR_P_(D) (`WDATA_P_(D)+D)\n`define VALID_P_(A, D) (`ADDR_P_(D)+A)\n//RESP bus\n`define RDATA_P `VALID_W+`READY_W\n\n\n//CONCAT BUS WIDTHS\n//request part\n`define REQ_W_(A, D) ((`VALID_W+A)+`WRITE_W_(D))\n//response part\n`define RESP_W_(D) ((`READ_W_(D)+`VALID_W)+`READY_W)\n\n\n/////////////////////////////////////////////////////////////////////////////////\n//FIELD RANGES\n\n//gets request section of cat bus\n`define REQ_(I, A, D) (I*`REQ_W_(A,D)) +: `REQ_W_(A,D)\n\n//gets the response part of a cat bus section\n`define RESP_(I, D) (I*`RESP_W_(D)) +: `RESP_W_(D)\n\n//gets the WRITE valid bit of cat bus section\n`define VALID_(I, A, D) (I*`REQ_W_(A,D)) + `VALID_P_(A,D)\n\n//gets the ADDRESS of cat bus section\n`define ADDRESS_(I, W, A, D) I*`REQ_W_(A,D)+`ADDR_P_(D)+W-1 -: W\n\n//gets the WDATA field of cat bus\n`define WDATA_(I, A, D) I*`REQ_W_(A,D)+`WDATA_P_(D) +: D\n\n//gets the WSTRB field of cat bus\n`define WSTRB_(I, A, D) I*`REQ_W_(A,D) +: `WSTRB_W_(D)\n\n//gets the WRITE fields of cat bus\n`define WRITE_(I, A, D) I*`REQ_W_(A,D) +: `WRITE_W_(D)\n\n//gets the RDATA field of cat bus\n`define RDATA_(I, D) I*`RESP_W_(D)+`RDATA_P +: D\n\n//gets the read valid field of cat bus\n`define RVALID_(I, D) I*`RESP_W_(D)+`READY_W\n\n//gets the READY field of cat bus\n`define READY_(I, D) I*`RESP_W_(D)\n\n\n/////////////////////////////////////////////////////////////////////////////////\n//defaults\n\n`define WSTRB_W `WSTRB_W_(DATA_W)\n\n`define WRITE_W `WRITE_W_(DATA_W)\n`define READ_W `READ_W_(DATA_W)\n\n`define WDATA_P `WDATA_P_(DATA_W)\n`define ADDR_P `ADDR_P_(DATA_W)\n`define VALID_P `VALID_P_(ADDR_W, DATA_W)\n\n`define REQ_W `REQ_W_(ADDR_W, DATA_W)\n`define RESP_W `RESP_W_(DATA_W)\n\n`define REQ(I) `REQ_(I, ADDR_W, DATA_W)\n`define RESP(I) `RESP_(I, DATA_W)\n`define VALID(I) `VALID_(I, ADDR_W, DATA_W)\n`define ADDRESS(I, W) `ADDRESS_(I, W, ADDR_W, DATA_W)\n`define WDATA(I) `WDATA_(I, ADDR_W, DATA_W)\n`define WSTRB(I) `WSTRB_(I, ADDR_W, DATA_W)\n`define WRITE(I) `WRITE_(I, ADDR_W, DATA_W)\n`define RDATA(I) `RDATA_(I, DATA_W)\n`define RVALID(I) `RVALID_(I, DATA_W)\n`define READY(I) `READY_(I, DATA_W)\n")};
+String temp_56_CONTENT = {String("`timescale 1ns / 1ps\n\n`define VERSAT_SIM_DELAY 0\n\n`ifdef SIM\n\n`undef VERSAT_SIM_DELAY\n\n`ifdef VERSAT_SIM_AXI_DELAY\n`define VERSAT_SIM_DELAY `VERSAT_SIM_AXI_DELAY\n`else\n`define VERSAT_SIM_DELAY 5\n`endif\n\n`endif\n\nmodule VersatAxiDelay #(\n   parameter MAX_DELAY = `VERSAT_SIM_DELAY\n) (\n   input      s_valid_i,\n   output reg s_ready_o,\n\n   output reg m_valid_o,\n   input      m_ready_i,\n\n   input clk_i,\n   input rst_i\n);\n\n   generate \n   if(MAX_DELAY == 0) begin\n      always @* begin\n         s_ready_o = m_ready_i;\n         m_valid_o = s_valid_i;\n      end\n   end else begin\n      reg [$clog2(MAX_DELAY):0] counter;\n      always @(posedge clk_i, posedge rst_i) begin\n         if (rst_i) begin\n            counter <= ($urandom % MAX_DELAY);\n         end else begin\n            if ((counter == 0) && m_valid_o && m_ready_i) begin\n               counter <= ($urandom % MAX_DELAY);\n            end\n\n            if (counter && s_valid_i) counter <= counter - 1;\n         end\n      end\n\n      always @* begin\n         s_ready_o = 1'b0;\n         m_valid_o = 1'b0;\n\n         if (counter == 0) begin\n            s_ready_o = m_ready_i;\n            m_valid_o = s_valid_i;\n         end\n      end\n   end\n   endgenerate\n\nendmodule  // AxiDelay\n\n`undef VERSAT_SIM_DELAY\n")};
+String temp_57_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule versat_counter #(\n   parameter DATA_W  = 21,\n   parameter RST_VAL = {DATA_W{1'b0}}\n) (\ninput [1-1:0] clk_i,\ninput [1-1:0] cke_i,\ninput [1-1:0] arst_i,\n\n   input rst_i,\n   input en_i,\n\n   output [DATA_W-1:0] data_o\n);\n\n   wire [DATA_W-1:0]   data;\n\n   assign data = data_o + 1'b1;\n\n   iob_reg_re #(\n      .DATA_W (DATA_W),\n      .RST_VAL(RST_VAL)\n   ) reg0 (\n.clk_i(clk_i), //clock signal\n.cke_i(cke_i), //clock enable\n.arst_i(arst_i), //asynchronous reset\n      .rst_i (rst_i),\n      .en_i  (en_i),\n      .data_i(data),\n      .data_o(data_o)\n   );\n\nendmodule\n")};
+String temp_58_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule DelayCalc #(\n   parameter DELAY_W = 7\n) (\n   //control\n   input clk,\n   input rst,\n\n   input      running,\n   input      run,\n   output reg done,\n\n   output     lastCycle,\n\n   input [DELAY_W-1:0] delay0\n);\n   reg [DELAY_W-1:0] delay;\n\n   assign lastCycle = (delay == 0) && !done;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         delay  <= 0;\n         done <= 1'b1;\n      end else if(run) begin\n         delay <= delay0;\n         done <= 1'b0;\n      end else if(running) begin\n         if (delay == 0) begin\n            done <= 1'b1;\n         end else begin\n            delay <= delay - 1;\n         end\n      end\n   end\n\nendmodule\n")};
+String temp_59_CONTENT = {String("`timescale 1ns / 1ps\n\n// TODO: Replace code with generic instantiation for 128,256,512 and 1024\n\n// Given aligned data, splits the data in order to meet byte alignment in a burst transfer starting with offset byte\nmodule BurstSplit #(\n   parameter DATA_W = 32,\n\n   parameter OFFSET_W = $clog2(DATA_W / 8)\n)(\n   input [OFFSET_W-1:0] offset_i,\n\n   input [DATA_W-1:0] data_in_i,\n   input              data_valid_i,\n\n   output reg [DATA_W-1:0] data_out_o, // Combinatorial from data_in_i and stored_data\n\n   input clk_i,\n   input rst_i\n);\n\n   reg [(DATA_W-8)-1:0] stored_data;\n   always @(posedge clk_i, posedge rst_i) begin\n      if (rst_i) begin\n         stored_data <= 0;\n      end else if (data_valid_i) begin\n         stored_data <= data_in_i[DATA_W-1:8];\n      end\n   end\n\n   generate\n      if (DATA_W == 32) begin\n         always @* begin\n            data_out_o = data_in_i;\n            case (offset_i)\n               2'b00: ;\n               2'b01: data_out_o = {data_in_i[23:0], stored_data[23:16]};\n               2'b10: data_out_o = {data_in_i[15:0], stored_data[23:8]};\n               2'b11: data_out_o = {data_in_i[7:0], stored_data[23:0]};\n            endcase\n         end\n      end  // if(DATA_W == 32)\n      if (DATA_W == 64) begin\n         always @* begin\n            data_out_o = data_in_i;\n            case (offset_i)\n               3'b000: ;\n               3'b001: data_out_o = {data_in_i[55:0], stored_data[55:48]};\n               3'b010: data_out_o = {data_in_i[47:0], stored_data[55:40]};\n               3'b011: data_out_o = {data_in_i[39:0], stored_data[55:32]};\n               3'b100: data_out_o = {data_in_i[31:0], stored_data[55:24]};\n               3'b101: data_out_o = {data_in_i[23:0], stored_data[55:16]};\n               3'b110: data_out_o = {data_in_i[15:0], stored_data[55:8]};\n               3'b111: data_out_o = {data_in_i[7:0], stored_data[55:0]};\n            endcase\n         end\n      end  // if(DATA_W == 64)\n      if (DATA_W == 128) begin\n         always @* begin\n            data_out_o = data_in_i;\n            case (offset_i)\n               4'b0000: ;\n               4'b0001: data_out_o = {data_in_i[119:0], stored_data[119:112]};\n               4'b0010: data_out_o = {data_in_i[111:0], stored_data[119:104]};\n               4'b0011: data_out_o = {data_in_i[103:0], stored_data[119:96]};\n               4'b0100: data_out_o = {data_in_i[95:0], stored_data[119:88]};\n               4'b0101: data_out_o = {data_in_i[87:0], stored_data[119:80]};\n               4'b0110: data_out_o = {data_in_i[79:0], stored_data[119:72]};\n               4'b0111: data_out_o = {data_in_i[71:0], stored_data[119:64]};\n               4'b1000: data_out_o = {data_in_i[63:0], stored_data[119:56]};\n               4'b1001: data_out_o = {data_in_i[55:0], stored_data[119:48]};\n               4'b1010: data_out_o = {data_in_i[47:0], stored_data[119:40]};\n               4'b1011: data_out_o = {data_in_i[39:0], stored_data[119:32]};\n               4'b1100: data_out_o = {data_in_i[31:0], stored_data[119:24]};\n               4'b1101: data_out_o = {data_in_i[23:0], stored_data[119:16]};\n               4'b1110: data_out_o = {data_in_i[15:0], stored_data[119:8]};\n               4'b1111: data_out_o = {data_in_i[7:0], stored_data[119:0]};\n            endcase\n         end\n      end  // if(DATA_W == 128)\n      if (DATA_W == 256) begin\n         always @* begin\n            data_out_o = data_in_i;\n            case (offset_i)\n               5'b00000: ;\n               5'b00001: data_out_o = {data_in_i[247:0], stored_data[247:240]};\n               5'b00010: data_out_o = {data_in_i[239:0], stored_data[247:232]};\n               5'b00011: data_out_o = {data_in_i[231:0], stored_data[247:224]};\n               5'b00100: data_out_o = {data_in_i[223:0], stored_data[247:216]};\n               5'b00101: data_out_o = {data_in_i[215:0], stored_data[247:208]};\n               5'b00110: data_out_o = {data_in_i[207:0], stored_data[247:200]};\n               5'b00111: data_out_o = {data_in_i[199:0], stored_data[247:192]};\n               5'b01000: data_out_o = {data_in_i[191:0], stored_data[247:184]};\n               5'b01001: data_out_o = {data_in_i[183:0], stored_data[247:176]};\n               5'b01010: data_out_o = {data_in_i[175:0], stored_data[247:168]};\n               5'b01011: data_out_o = {data_in_i[167:0], stored_data[247:160]};\n               5'b01100: data_out_o = {data_in_i[159:0], stored_data[247:152]};\n               5'b01101: data_out_o = {data_in_i[151:0], stored_data[247:144]};\n               5'b01110: data_out_o = {data_in_i[143:0], stored_data[247:136]};\n               5'b01111: data_out_o = {data_in_i[135:0], stored_data[247:128]};\n               5'b10000: data_out_o = {data_in_i[127:0], stored_data[247:120]};\n               5'b10001: data_out_o = {data_in_i[119:0], stored_data[247:112]};\n               5'b10010: data_out_o = {data_in_i[111:0], stored_data[247:104]};\n               5'b10011: data_out_o = {data_in_i[103:0], stored_data[247:96]};\n               5'b10100: data_out_o = {data_in_i[95:0], stored_data[247:88]};\n               5'b10101: data_out_o = {data_in_i[87:0], stored_data[247:80]};\n               5'b10110: data_out_o = {data_in_i[79:0], stored_data[247:72]};\n               5'b10111: data_out_o = {data_in_i[71:0], stored_data[247:64]};\n               5'b11000: data_out_o = {data_in_i[63:0], stored_data[247:56]};\n               5'b11001: data_out_o = {data_in_i[55:0], stored_data[247:48]};\n               5'b11010: data_out_o = {data_in_i[47:0], stored_data[247:40]};\n               5'b11011: data_out_o = {data_in_i[39:0], stored_data[247:32]};\n               5'b11100: data_out_o = {data_in_i[31:0], stored_data[247:24]};\n               5'b11101: data_out_o = {data_in_i[23:0], stored_data[247:16]};\n               5'b11110: data_out_o = {data_in_i[15:0], stored_data[247:8]};\n               5'b11111: data_out_o = {data_in_i[7:0], stored_data[247:0]};\n            endcase\n         end\n      end  // if(DATA_W == 256)\n      if (DATA_W == 512) begin\n         always @* begin\n            data_out_o = data_in_i;\n            case (offset_i)\n               6'b000000: ;\n               6'b000001: data_out_o = {data_in_i[503:0], stored_data[503:496]};\n               6'b000010: data_out_o = {data_in_i[495:0], stored_data[503:488]};\n               6'b000011: data_out_o = {data_in_i[487:0], stored_data[503:480]};\n               6'b000100: data_out_o = {data_in_i[479:0], stored_data[503:472]};\n               6'b000101: data_out_o = {data_in_i[471:0], stored_data[503:464]};\n               6'b000110: data_out_o = {data_in_i[463:0], stored_data[503:456]};\n               6'b000111: data_out_o = {data_in_i[455:0], stored_data[503:448]};\n               6'b001000: data_out_o = {data_in_i[447:0], stored_data[503:440]};\n               6'b001001: data_out_o = {data_in_i[439:0], stored_data[503:432]};\n               6'b001010: data_out_o = {data_in_i[431:0], stored_data[503:424]};\n               6'b001011: data_out_o = {data_in_i[423:0], stored_data[503:416]};\n               6'b001100: data_out_o = {data_in_i[415:0], stored_data[503:408]};\n               6'b001101: data_out_o = {data_in_i[407:0], stored_data[503:400]};\n               6'b001110: data_out_o = {data_in_i[399:0], stored_data[503:392]};\n               6'b001111: data_out_o = {data_in_i[391:0], stored_data[503:384]};\n               6'b010000: data_out_o = {data_in_i[383:0], stored_data[503:376]};\n               6'b010001: data_out_o = {data_in_i[375:0], stored_data[503:368]};\n               6'b010010: data_out_o = {data_in_i[367:0], stored_data[503:360]};\n               6'b010011: data_out_o = {data_in_i[359:0], stored_data[503:352]};\n               6'b010100: data_out_o = {data_in_i[351:0], stored_data[503:344]};\n               6'b010101: data_out_o = {data_in_i[343:0], stored_data[503:336]};\n               6'b010110: data_out_o = {data_in_i[335:0], stored_data[503:328]};\n               6'b010111: data_out_o = {data_in_i[327:0], stored_data[503:320]};\n               6'b011000: data_out_o = {data_in_i[319:0], stored_data[503:312]};\n               6'b011001: data_out_o = {data_in_i[311:0], stored_data[503:304]};\n               6'b011010: data_out_o = {data_in_i[303:0], stored_data[503:296]};\n               6'b011011: data_out_o = {data_in_i[295:0], stored_data[503:288]};\n               6'b011100: data_out_o = {data_in_i[287:0], stored_data[503:280]};\n               6'b011101: data_out_o = {data_in_i[279:0], stored_data[503:272]};\n               6'b011110: data_out_o = {data_in_i[271:0], stored_data[503:264]};\n               6'b011111: data_out_o = {data_in_i[263:0], stored_data[503:256]};\n               6'b100000: data_out_o = {data_in_i[255:0], stored_data[503:248]};\n               6'b100001: data_out_o = {data_in_i[247:0], stored_data[503:240]};\n               6'b100010: data_out_o = {data_in_i[239:0], stored_data[503:232]};\n               6'b100011: data_out_o = {data_in_i[231:0], stored_data[503:224]};\n               6'b100100: data_out_o = {data_in_i[223:0], stored_data[503:216]};\n               6'b100101: data_out_o = {data_in_i[215:0], stored_data[503:208]};\n               6'b100110: data_out_o = {data_in_i[207:0], stored_data[503:200]};\n               6'b100111: data_out_o = {data_in_i[199:0], stored_data[503:192]};\n               6'b101000: data_out_o = {data_in_i[191:0], stored_data[503:184]};\n               6'b101001: data_out_o = {data_in_i[183:0], stored_data[503:176]};\n               6'b101010: data_out_o = {data_in_i[175:0], stored_data[503:168]};\n               6'b101011: data_out_o = {data_in_i[167:0], stored_data[503:160]};\n               6'b101100: data_out_o = {data_in_i[159:0], stored_data[503:152]};\n               6'b101101: data_out_o = {data_in_i[151:0], stored_data[503:144]};\n               6'b101110: data_out_o = {data_in_i[143:0], stored_data[503:136]};\n               6'b101111: data_out_o = {data_in_i[135:0], stored_data[503:128]};\n               6'b110000: data_out_o = {data_in_i[127:0], stored_data[503:120]};\n               6'b110001: data_out_o = {data_in_i[119:0], stored_data[503:112]};\n               6'b110010: data_out_o = {data_in_i[111:0], stored_data[503:104]};\n               6'b110011: data_out_o = {data_in_i[103:0], stored_data[503:96]};\n               6'b110100: data_out_o = {data_in_i[95:0], stored_data[503:88]};\n               6'b110101: data_out_o = {data_in_i[87:0], stored_data[503:80]};\n               6'b110110: data_out_o = {data_in_i[79:0], stored_data[503:72]};\n               6'b110111: data_out_o = {data_in_i[71:0], stored_data[503:64]};\n               6'b111000: data_out_o = {data_in_i[63:0], stored_data[503:56]};\n               6'b111001: data_out_o = {data_in_i[55:0], stored_data[503:48]};\n               6'b111010: data_out_o = {data_in_i[47:0], stored_data[503:40]};\n               6'b111011: data_out_o = {data_in_i[39:0], stored_data[503:32]};\n               6'b111100: data_out_o = {data_in_i[31:0], stored_data[503:24]};\n               6'b111101: data_out_o = {data_in_i[23:0], stored_data[503:16]};\n               6'b111110: data_out_o = {data_in_i[15:0], stored_data[503:8]};\n               6'b111111: data_out_o = {data_in_i[7:0], stored_data[503:0]};\n            endcase\n         end\n      end  // if(DATA_W == 512)\n   endgenerate\n\nendmodule  // burst_split\n")};
+String temp_60_CONTENT = {String("`timescale 1ns / 1ps\n\n// Unit that computes both databus address and memory address for reading and writing operations.\n// This unit is the source of truth for how the address gen interface generates the addresses for accessing memory.\n// As such, in order to obtain the addresses for a given set of values given, we use verilator to tranform the hardware into software and simulate this unit.\n\n// Take care when changing this. This unit is verilated in order to simulate address gen independently of the accelerator at pc-emul-run time.\nmodule SuperAddress #(\n   parameter AXI_ADDR_W = 32,\n   parameter DATA_W   = 32,\n   parameter ADDR_W   = 10,\n   parameter PERIOD_W = 10,\n   parameter DELAY_W  = 7,\n   parameter LEN_W      = 8,\n   parameter COUNT_W    = 8\n) (\n   input clk_i,\n   input rst_i,\n\n   input run_i,\n\n   input ignore_first_i, // Treat as this is bias vread, for now\n\n   //configurations \n   input        [  ADDR_W - 1:0] start_i,\n   input        [PERIOD_W - 1:0] duty_i,\n\n   input        [PERIOD_W - 1:0] per_i,\n   input signed [  ADDR_W - 1:0] incr_i,\n\n   input        [  ADDR_W - 1:0] iter_i,\n   input signed [  ADDR_W - 1:0] shift_i,\n\n   input        [PERIOD_W - 1:0] per2_i,\n   input signed [  ADDR_W - 1:0] incr2_i,\n\n   input        [  ADDR_W - 1:0] iter2_i,\n   input signed [  ADDR_W - 1:0] shift2_i,\n\n   input        [PERIOD_W - 1:0] per3_i,\n   input signed [  ADDR_W - 1:0] incr3_i,\n\n   input        [  ADDR_W - 1:0] iter3_i,\n   input signed [  ADDR_W - 1:0] shift3_i,\n\n   input        [ DELAY_W - 1:0] delay_i,\n\n   //outputs \n   output reg                valid_o,\n   input                     ready_i,\n   output reg [ADDR_W - 1:0] addr_o,\n   output                    store_o,\n\n   output wire doneDatabus,\n   output reg  doneAddress,\n   output wire done_o,\n\n   input            [COUNT_W-1:0] count_i,\n   input       [  AXI_ADDR_W-1:0] start_address_i,\n   input       [  AXI_ADDR_W-1:0] address_shift_i,\n   input       [       LEN_W-1:0] databus_length,\n\n   input                          data_ready_i,\n   input                          data_valid_i,\n   input                          reading,\n\n   // Only address databus values. Read vs Write implemented outside of thies unit.\n   input                          databus_ready,\n   output                         databus_valid,\n   output     [  AXI_ADDR_W-1:0]  databus_addr,\n   output     [       LEN_W-1:0]  databus_len,\n   input                          databus_last\n);\n\nlocalparam OFFSET_W = $clog2(DATA_W / 8);\n\nreg                                           [   DELAY_W-1:0] delay_counter;\n\nreg                                           [  ADDR_W - 1:0] iter,iter2,iter3;\nreg                                           [PERIOD_W - 1:0] per,per2,per3;\n\nreg [ADDR_W-1:0] addr2,addr3;\n\nwire iter3Cond = (((iter3 + 1) == iter3_i) || (iter3_i == 0));\nwire per3Cond = (((per3 + 1) == per3_i) || (per3_i == 0));\n\nwire iter2Cond = (((iter2 + 1) == iter2_i) || (iter2_i == 0));\nwire per2Cond = (((per2 + 1) == per2_i) || (per2_i == 0));\n\n//wire true_iter = (ignore ? iter_i + 1 : iter_i);\n\nwire iterCond = (((iter + 1) == iter_i) || (iter_i == 0));\nwire perCond = (((per + 1) == per_i) || (per_i == 0));\n\nwire [5:0] cases = {iter3Cond,per3Cond,iter2Cond,per2Cond,iterCond,perCond};\n\n/* TODO:\n   \n   The address generation can be decoupled, but it is better if we separate it into individual modules.\n   Because we must take into account future iter and per conditions.\n   The idea of \"runnning one ahead\" does not work if we only take into account per. \n\n   Basically need a module that implements per and iter logic only. We can then implement three of them if needed\n\n*/\n\nreg ignore;\n\nassign store_o = (per < duty_i && !ignore);\n\nalways @(posedge clk_i,posedge rst_i) begin\n   if (rst_i) begin\n      delay_counter <= 0;\n      addr_o        <= 0;\n      addr2         <= 0;\n      addr3         <= 0;\n      iter          <= 0;\n      iter2         <= 0;\n      iter3         <= 0;\n      per           <= 0;\n      per2          <= 0;\n      per3          <= 0;\n      valid_o       <= 0;\n      doneAddress   <= 1'b1;\n   end else if (run_i) begin\n      delay_counter <= delay_i;\n      addr_o        <= (start_i << OFFSET_W);\n      addr2         <= (start_i << OFFSET_W);\n      addr3         <= (start_i << OFFSET_W);\n      iter          <= 0;\n      iter2         <= 0;\n      iter3         <= 0;\n      per           <= 0;\n      per2          <= 0;\n      per3          <= 0;\n      valid_o       <= 0;\n      doneAddress   <= 1'b0;\n      ignore        <= ignore_first_i;\n      if (delay_i == 0) begin\n         valid_o <= 1'b1;\n      end\n   end else if (|delay_counter) begin\n      delay_counter <= delay_counter - 1;\n      valid_o       <= (delay_counter == 1);\n   end else if (valid_o && ready_i) begin\n      casez(cases)\n      6'b?????0: begin\n         if (per < duty_i && (!ignore)) begin\n            addr_o <= addr_o + (incr_i << OFFSET_W);\n         end\n         per <= per + 1;         \n      end\n      6'b????01: begin\n         if(!ignore)\n            addr_o <= addr_o + (shift_i << OFFSET_W);\n         per    <= 0;\n         ignore <= 0;\n         iter   <= iter + 1;\n      end\n      6'b???011: begin\n         if(!ignore) begin\n            addr_o <= addr2 + (incr2_i << OFFSET_W);\n            addr2  <= addr2 + (incr2_i << OFFSET_W);\n         end\n         per    <= 0;\n         iter   <= 0;\n         ignore <= 0;\n         per2   <= per2 + 1;\n      end\n      6'b??0111: begin\n         if(!ignore) begin\n            addr_o <= addr2 + (shift2_i << OFFSET_W);\n            addr2  <= addr2 + (shift2_i << OFFSET_W);\n         end\n         per    <= 0;\n         iter   <= 0;\n         per2   <= 0;\n         ignore <= 0;\n         iter2  <= iter2 + 1;\n      end\n      6'b?01111: begin\n         if(!ignore) begin\n            addr_o <= addr3 + (incr3_i << OFFSET_W);\n            addr2  <= addr3 + (incr3_i << OFFSET_W);\n            addr3  <= addr3 + (incr3_i << OFFSET_W);\n         end\n         per    <= 0;\n         iter   <= 0;\n         per2   <= 0;\n         iter2  <= 0;\n         ignore <= 0;\n         per3   <= per3 + 1;\n      end\n      6'b011111: begin\n         if(!ignore) begin\n            addr_o <= addr3 + (shift3_i << OFFSET_W);\n            addr2  <= addr3 + (shift3_i << OFFSET_W);\n            addr3  <= addr3 + (shift3_i << OFFSET_W);\n         end\n         per    <= 0;\n         iter   <= 0;\n         per2   <= 0;\n         iter2  <= 0;\n         per3   <= 0;\n         ignore <= 0;\n         iter3  <= iter3 + 1;\n      end\n      6'b111111: begin\n         doneAddress <= 1'b1;\n         valid_o <= 0;\n      end\n      endcase\n   end\nend\n\n// Databus side\nreg [1:0] state;\nreg [  AXI_ADDR_W-1:0] address;\n\nassign databus_len   = databus_length;\nassign databus_addr = address;\n\nwire count_is_zero;\nwire counter_advance;\n\nCountNLoops #(.COUNT_W(COUNT_W)) counter(\n.start_i(run_i),\n.count_i(count_i),\n\n.advance_i(counter_advance),\n\n.count_is_zero_o(count_is_zero),\n\n.clk_i(clk_i),\n.rst_i(rst_i)\n);\n\nassign doneDatabus = (state == 2'b0);\n\nreg databus_valid_reg; // Allows data_ready to propagate\nassign databus_valid = (state == 2'b10) && (reading ? (databus_valid_reg && data_ready_i) : data_valid_i);\n\nalways @(posedge clk_i,posedge rst_i) begin\n   if(rst_i) begin\n      state <= 0;\n      address <= 0;\n      databus_valid_reg <= 1'b0;\n   end else begin\n      case(state)\n      2'b00: begin\n         if(run_i && count_i != 0 && databus_length != 0) begin\n            state <= 2'b01;\n            address <= start_address_i;\n         end\n      end\n      2'b01: begin\n         if(count_is_zero) begin\n            state <= 2'b00;\n         end else begin\n            state <= 2'b10;\n            databus_valid_reg <= 1'b1;\n         end\n      end\n      2'b10: begin\n         if(databus_valid && databus_ready && databus_last) begin\n            databus_valid_reg <= 1'b0;\n            address <= address + address_shift_i;\n            state <= 2'b01;\n         end\n      end\n      2'b11: begin\n      end\n      endcase\n   end\nend\n\nassign counter_advance = (databus_valid && databus_ready && databus_last);\n\nassign done_o = doneAddress && doneDatabus;\n\nendmodule  // SuperAddress\n")};
+String temp_61_CONTENT = {String("`timescale 1ns / 1ps\n`include \"iob_utils.vh\"\n\nmodule iob_asym_converter #(\n   parameter W_DATA_W = 21,\n   parameter R_DATA_W = 21,\n   parameter ADDR_W = 3,  //higher ADDR_W lower DATA_W\n   //determine W_ADDR_W and R_ADDR_W\n   parameter MAXDATA_W = `IOB_MAX(W_DATA_W, R_DATA_W),\n   parameter MINDATA_W = `IOB_MIN(W_DATA_W, R_DATA_W),\n   parameter R = MAXDATA_W / MINDATA_W,\n   parameter MINADDR_W = ADDR_W - $clog2(R),  //lower ADDR_W (higher DATA_W)\n   parameter W_ADDR_W = (W_DATA_W == MAXDATA_W) ? MINADDR_W : ADDR_W,\n   parameter R_ADDR_W = (R_DATA_W == MAXDATA_W) ? MINADDR_W : ADDR_W\n) (\n   //memory write port\n   output [ R-1:0]        ext_mem_w_en_o,\n   output [MINADDR_W-1:0] ext_mem_w_addr_o,\n   output [MAXDATA_W-1:0] ext_mem_w_data_o,\n   //memory read port\n   output [ R-1:0]        ext_mem_r_en_o,\n   output [MINADDR_W-1:0] ext_mem_r_addr_o,\n   input [MAXDATA_W-1:0]  ext_mem_r_data_i,\n   input [1-1:0] clk_i,\n   input [1-1:0] cke_i,\n   input [1-1:0] arst_i,\n   input                  rst_i,\n   //write port\n   input [ W_ADDR_W-1:0]  w_addr_i,\n   input                  w_en_i,\n   input [ W_DATA_W-1:0]  w_data_i,\n   //read port\n   input [ R_ADDR_W-1:0]  r_addr_i,\n   input                  r_en_i,\n   output [ R_DATA_W-1:0] r_data_o\n);\n\n   //Data is valid after read enable\n   wire r_data_valid_reg;\n   iob_reg_r #(\n      .DATA_W (1),\n      .RST_VAL(1'b0)\n   ) r_data_valid_reg_inst (\n      .clk_i(clk_i), //clock signal\n      .cke_i(cke_i), //clock enable\n      .arst_i(arst_i), //asynchronous reset\n      .rst_i (rst_i),\n      .data_i(r_en_i),\n      .data_o(r_data_valid_reg)\n   );\n\n   //Register read data from the memory\n   wire [MAXDATA_W-1:0] r_data_reg;\n   iob_reg_re #(\n      .DATA_W (MAXDATA_W),\n      .RST_VAL({MAXDATA_W{1'd0}})\n   ) r_data_reg_inst (\n      .clk_i(clk_i), //clock signal\n      .cke_i(cke_i), //clock enable\n      .arst_i(arst_i), //asynchronous reset\n      .rst_i (rst_i),\n      .en_i  (r_data_valid_reg),\n      .data_i(ext_mem_r_data_i),\n      .data_o(r_data_reg)\n   );\n\n   reg [MAXDATA_W-1:0] r_data_int;\n   always @* begin\n      if (r_data_valid_reg) begin\n         r_data_int = ext_mem_r_data_i;\n      end else begin\n         r_data_int = r_data_reg;\n      end\n   end\n\n   //Generate the RAM based on the parameters\n   generate\n      if (W_DATA_W > R_DATA_W) begin : g_write_wider\n         //memory write port\n         assign ext_mem_w_en_o   = {R{w_en_i}};\n         assign ext_mem_w_addr_o = w_addr_i;\n         assign ext_mem_w_data_o = w_data_i;\n\n         //register to hold the LSBs of r_addr\n         wire [$clog2(R)-1:0] r_addr_lsbs_reg;\n         iob_reg #(\n            .DATA_W ($clog2(R)),\n            .RST_VAL({$clog2(R) {1'd0}})\n         ) r_addr_reg_inst (\n            .clk_i(clk_i), //clock signal\n            .cke_i(cke_i), //clock enable\n            .arst_i(arst_i), //asynchronous reset\n            .data_i(r_addr_i[$clog2(R)-1:0]),\n            .data_o(r_addr_lsbs_reg)\n         );\n\n         //memory read port\n         assign ext_mem_r_en_o   = {{(R - 1) {1'd0}}, r_en_i} << r_addr_i[$clog2(R)-1:0];\n         assign ext_mem_r_addr_o = r_addr_i[R_ADDR_W-1:$clog2(R)];\n\n         wire [W_DATA_W-1:0] r_data;\n         assign r_data   = r_data_int >> (r_addr_lsbs_reg * R_DATA_W);\n         assign r_data_o = r_data[R_DATA_W-1:0];\n\n      end else if (W_DATA_W < R_DATA_W) begin : g_read_wider\n         //memory write port\n         assign ext_mem_w_en_o = {{(R - 1) {1'd0}}, w_en_i} << w_addr_i[$clog2(R)-1:0];\n         assign ext_mem_w_data_o = {{(R_DATA_W - W_DATA_W) {1'd0}}, w_data_i} <<\n                                                                        (w_addr_i[$clog2(R)-1:0] * W_DATA_W);\n         assign ext_mem_w_addr_o = w_addr_i[W_ADDR_W-1:$clog2(R)];\n\n         //memory read port\n         assign ext_mem_r_en_o = {R{r_en_i}};\n         assign ext_mem_r_addr_o = r_addr_i;\n         assign r_data_o = r_data_int;\n\n      end else begin : g_same_width\n         //W_DATA_W == R_DATA_W\n         //memory write port\n         assign ext_mem_w_en_o   = w_en_i;\n         assign ext_mem_w_addr_o = w_addr_i;\n         assign ext_mem_w_data_o = w_data_i;\n\n         //memory read port\n         assign ext_mem_r_en_o   = r_en_i;\n         assign ext_mem_r_addr_o = r_addr_i;\n         assign r_data_o         = r_data_int;\n      end\n   endgenerate\nendmodule\n\n")};
+String temp_62_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule MemoryScanner #(\n   parameter DATA_W = 32,\n   parameter ADDR_W = 10\n) (\n   output reg [ADDR_W-1:0] addr_o,\n   input      [DATA_W-1:0] dataIn_i,\n   output                  enable_o,\n\n   input               nextValue_i,\n   output [DATA_W-1:0] currentValue_o,\n\n   input reset_i,\n\n   input clk_i,\n   input rst_i\n);\n\n   localparam INCREMENT = DATA_W / 8;\n\n   reg hasValueStored;\n\n   assign currentValue_o = dataIn_i;\n\n   assign enable_o       = nextValue_i || !hasValueStored;\n\n   always @(posedge clk_i, posedge rst_i) begin\n      if (rst_i) begin\n         addr_o         <= 0;\n         hasValueStored <= 1'b0;\n      end else if (reset_i) begin\n         addr_o         <= 0;\n         hasValueStored <= 1'b0;\n      end else begin\n         if (enable_o) begin\n            hasValueStored <= 1'b1;\n         end\n         if (nextValue_i || enable_o) begin\n            addr_o <= addr_o + INCREMENT;\n         end\n      end\n   end\n\nendmodule  // MemoryScanner\n")};
+String temp_63_CONTENT = {String("`timescale 1ns / 1ps\n\n// Ex: 64 bits input and 32 bits output, sel == 0 selects lower 32 bits. sel == 1 selects upper 32 bits\n\nmodule WideAdapter #(\n   parameter INPUT_W = 64,\n   parameter SIZE_W = 32, // Size of data (data can be smaller than output, in which case the output is zero extended)\n   parameter OUTPUT_W = 32,  // Size of output\n\n   parameter DIFF_W = $clog2(INPUT_W / SIZE_W)  // Local parameter, needed by input definition\n) (\n   input [DIFF_W-1:0] sel_i,\n\n   input  [ INPUT_W-1:0] in_i,\n   output [OUTPUT_W-1:0] out_o\n);\n\n   ZeroExtend #(\n      .INPUT_W (SIZE_W),\n      .OUTPUT_W(OUTPUT_W)\n   ) extend (\n      .in_i (in_i[sel_i*SIZE_W+:SIZE_W]),\n      .out_o(out_o)\n   );\n\nendmodule  // WideAdapter\n")};
+String temp_64_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule AddressGen #(\n   parameter ADDR_W   = 10,\n   parameter PERIOD_W = 10,\n   parameter DELAY_W  = 7,\n   parameter DATA_W   = 32\n) (\n   input clk_i,\n   input rst_i,\n\n   input run_i,\n\n   //configurations\n   input        [  ADDR_W - 1:0] start_i,\n   input        [PERIOD_W - 1:0] duty_i,\n\n   input        [PERIOD_W - 1:0] per_i,\n   input signed [  ADDR_W - 1:0] incr_i,\n\n   input        [  ADDR_W - 1:0] iter_i,\n   input signed [  ADDR_W - 1:0] shift_i,\n\n\n   input        [ DELAY_W - 1:0] delay_i,\n\n   //outputs \n   output                    valid_o,\n   input                     ready_i,\n   output     [ADDR_W - 1:0] addr_o,\n   output                    store_o,\n\n   output     done_o\n);\n\n   SuperAddress #(\n      .ADDR_W(ADDR_W),\n      .PERIOD_W(PERIOD_W),\n      .DELAY_W(DELAY_W),\n      .DATA_W(DATA_W)\n      ) reader (\n      .clk_i(clk_i),\n      .rst_i(rst_i),\n      .run_i(run_i),\n      .done_o(done_o),\n\n      .ignore_first_i(1'b0),\n\n      //configurations \n      .per_i(per_i),\n      .delay_i (delay_i),\n      .start_i (start_i),\n      .incr_i  (incr_i),\n\n      .iter_i(iter_i),\n      .duty_i      (duty_i),\n      .shift_i     (shift_i),\n\n      .per2_i({PERIOD_W{1'b0}}),\n      .incr2_i({ADDR_W{1'b0}}),\n      .iter2_i({ADDR_W{1'b0}}),\n      .shift2_i({ADDR_W{1'b0}}),\n\n      .per3_i({PERIOD_W{1'b0}}),\n      .incr3_i({ADDR_W{1'b0}}),\n      .iter3_i({ADDR_W{1'b0}}),\n      .shift3_i({ADDR_W{1'b0}}),\n\n      .doneDatabus(),\n      .doneAddress(),\n\n      //outputs \n      .valid_o(valid_o),\n      .ready_i(ready_i),\n      .addr_o (addr_o),\n      .store_o(store_o),\n\n      .databus_ready(1'b1),\n      .databus_valid(),\n      .databus_addr(),\n      .databus_len(),\n      .databus_last(1'b1),\n\n      // Data interface\n      .data_valid_i(1'b1),\n      .data_ready_i(1'b1),\n      .reading(1'b1),\n\n      .count_i(0),\n      .start_address_i(0),\n      .address_shift_i(0),\n      .databus_length(0)\n   );\n\nendmodule  // MyAddressGen\n")};
+String temp_65_CONTENT = {String("`timescale 1ns / 1ps\n\n/*\n\nMuxes native N masters into a write and read master.\n\n*/\n\nmodule MuxNative #(\n   parameter ADDR_W   = 0,\n   parameter DATA_W   = 32,\n   parameter N_SLAVES = 2,\n   parameter LEN_W    = 8\n) (\n   // Slaves\n   input  [                 N_SLAVES-1:0] s_valid_i,\n   output [                 N_SLAVES-1:0] s_ready_o,\n   output [                 N_SLAVES-1:0] s_last_o,\n   input  [      (ADDR_W * N_SLAVES)-1:0] s_addr_i,\n   input  [      (DATA_W * N_SLAVES)-1:0] s_wdata_i,\n   input  [((DATA_W / 8) * N_SLAVES)-1:0] s_wstrb_i,\n   output [                   DATA_W-1:0] s_rdata_o,\n   input  [     (LEN_W * N_SLAVES) - 1:0] s_len_i,\n\n   // Write interface\n   output reg                    m_wvalid_o,\n   input                         m_wready_i,\n   output reg [      ADDR_W-1:0] m_waddr_o,\n   output reg [      DATA_W-1:0] m_wdata_o,\n   output reg [(DATA_W / 8)-1:0] m_wstrb_o,\n   output reg [       LEN_W-1:0] m_wlen_o,\n   input                         m_wlast_i,\n\n   // Read interface\n   output reg              m_rvalid_o,\n   input                   m_rready_i,\n   output reg [ADDR_W-1:0] m_raddr_o,\n   input      [DATA_W-1:0] m_rdata_i,\n   output reg [ LEN_W-1:0] m_rlen_o,\n   input                   m_rlast_i,\n\n   input clk_i,\n   input rst_i\n);\n\n   wire [      ADDR_W-1:0] st_addr [N_SLAVES-1:0];\n   wire [      DATA_W-1:0] st_wdata[N_SLAVES-1:0];\n   wire [(DATA_W / 8)-1:0] st_wstrb[N_SLAVES-1:0];\n   wire [       LEN_W-1:0] st_len  [N_SLAVES-1:0];\n\n   generate\n      genvar g;\n      for (g = 0; g < N_SLAVES; g = g + 1) begin : unpackSlave\n         assign st_addr[g]  = s_addr_i[ADDR_W*g+:ADDR_W];\n         assign st_wdata[g] = s_wdata_i[DATA_W*g+:DATA_W];\n         assign st_wstrb[g] = s_wstrb_i[(DATA_W/8)*g+:(DATA_W/8)];\n         assign st_len[g]   = s_len_i[LEN_W*g+:LEN_W];\n      end\n   endgenerate\n\n   assign s_rdata_o = m_rdata_i;\n\n   // If currently working and which interface it is servicing\n   reg                            w_running;\n   reg     [$clog2(N_SLAVES)-1:0] w_slave;\n   reg                            r_running;\n   reg     [$clog2(N_SLAVES)-1:0] r_slave;\n\n   // If there is any request (any slave is asserting valid)\n   reg                            w_req_valid;\n   reg     [$clog2(N_SLAVES)-1:0] w_req;\n   reg                            r_req_valid;\n   reg     [$clog2(N_SLAVES)-1:0] r_req;\n\n   integer                        i;\n   always @* begin\n      w_req_valid = 0;\n      r_req_valid = 0;\n      w_req       = 0;\n      r_req       = 0;\n\n      for (i = 0; i < N_SLAVES; i = i + 1) begin\n         if (s_valid_i[i]) begin\n            if (|st_wstrb[i]) begin\n               w_req_valid = 1'b1;\n               w_req       = i;\n            end else begin\n               r_req_valid = 1'b1;\n               r_req       = i;\n            end\n         end\n      end\n   end\n\n   wire r_transfer = (m_rvalid_o && m_rready_i);\n   wire w_transfer = (m_wvalid_o && m_wready_i);\n\n   always @(posedge clk_i, posedge rst_i) begin\n      if (rst_i) begin\n         w_running <= 0;\n         w_slave   <= 0;\n         r_running <= 0;\n         r_slave   <= 0;\n      end else begin\n         if ((!w_running) && w_req_valid) begin\n            w_running <= 1'b1;\n            w_slave   <= w_req;\n         end\n         if (w_running && m_wlast_i && w_transfer) begin\n            w_running <= 1'b0;\n         end\n\n         if ((!r_running) && r_req_valid) begin\n            r_running <= 1'b1;\n            r_slave   <= r_req;\n         end\n         if (r_running && m_rlast_i && r_transfer) begin\n            r_running <= 1'b0;\n         end\n      end\n   end\n\n   assign s_ready_o = (((w_running && m_wready_i) ? 1 : 0) << w_slave) | ((r_running && m_rready_i ? 1 : 0) << r_slave);\n   assign s_last_o = (((w_running && m_wlast_i) ? 1 : 0 ) << w_slave) | ((r_running && m_rlast_i ? 1 : 0 ) << r_slave);\n\n   always @* begin\n      m_rvalid_o = 0;\n      m_raddr_o  = 0;\n      m_rlen_o   = 0;\n\n      m_wvalid_o = 0;\n      m_waddr_o  = 0;\n      m_wdata_o  = 0;\n      m_wstrb_o  = 0;\n      m_wlen_o   = 0;\n\n      if (w_running) begin\n         m_wvalid_o = s_valid_i[w_slave];\n         m_waddr_o  = st_addr[w_slave];\n         m_wdata_o  = st_wdata[w_slave];\n         m_wstrb_o  = st_wstrb[w_slave];\n         m_wlen_o   = st_len[w_slave];\n      end\n\n      if (r_running) begin\n         m_rvalid_o = s_valid_i[r_slave];\n         m_raddr_o  = st_addr[r_slave];\n         m_rlen_o   = st_len[r_slave];\n      end\n   end\n\nendmodule  // xmerge\n")};
+String temp_66_CONTENT = {String("`timescale 1ns / 1ps\n\n// Assumes input is smaller or equal to output, otherwise will produce an error\nmodule ZeroExtend #(\n   parameter OUTPUT_W = 1,\n   parameter INPUT_W  = 1\n) (\n   input      [ INPUT_W-1:0] in_i,\n   output reg [OUTPUT_W-1:0] out_o\n);\n\n   always @* begin\n      out_o              = 0;\n      out_o[INPUT_W-1:0] = in_i;\n   end\n\nendmodule  // ZeroExtend\n")};
+String temp_67_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule AddressGen3 #(\n   parameter ADDR_W   = 10,\n   parameter PERIOD_W = 10,\n   parameter DELAY_W  = 7,\n   parameter DATA_W   = 8\n) (\n   input clk_i,\n   input rst_i,\n\n   input run_i,\n\n   input ignore_first_i, // Treat as this is bias vread, for now\n\n   //configurations \n   input        [  ADDR_W - 1:0] start_i,\n   input        [PERIOD_W - 1:0] duty_i,\n\n   input        [PERIOD_W - 1:0] per_i,\n   input signed [  ADDR_W - 1:0] incr_i,\n\n   input        [  ADDR_W - 1:0] iter_i,\n   input signed [  ADDR_W - 1:0] shift_i,\n\n   input        [PERIOD_W - 1:0] per2_i,\n   input signed [  ADDR_W - 1:0] incr2_i,\n\n   input        [  ADDR_W - 1:0] iter2_i,\n   input signed [  ADDR_W - 1:0] shift2_i,\n\n   input        [PERIOD_W - 1:0] per3_i,\n   input signed [  ADDR_W - 1:0] incr3_i,\n\n   input        [  ADDR_W - 1:0] iter3_i,\n   input signed [  ADDR_W - 1:0] shift3_i,\n\n   input        [ DELAY_W - 1:0] delay_i,\n\n   //outputs \n   output                valid_o,\n   input                 ready_i,\n   output [ADDR_W - 1:0] addr_o,\n   output                store_o,\n\n   output  done_o\n);\n\n   SuperAddress #(\n      .ADDR_W(ADDR_W),\n      .PERIOD_W(PERIOD_W),\n      .DELAY_W(DELAY_W),\n      .DATA_W(DATA_W),\n      .LEN_W(1),\n      .COUNT_W(1),\n      .AXI_ADDR_W(1)\n      ) reader (\n      .clk_i(clk_i),\n      .rst_i(rst_i),\n      .run_i(run_i),\n      .done_o(done_o),\n\n      .ignore_first_i(ignore_first_i),\n\n      //configurations \n      .per_i(per_i),\n      .delay_i (delay_i),\n      .start_i (start_i),\n      .incr_i  (incr_i),\n\n      .iter_i(iter_i),\n      .duty_i      (duty_i),\n      .shift_i     (shift_i),\n\n      .per2_i(per2_i),\n      .incr2_i(incr2_i),\n      .iter2_i(iter2_i),\n      .shift2_i(shift2_i),\n\n      .per3_i(per3_i),\n      .incr3_i(incr3_i),\n      .iter3_i(iter3_i),\n      .shift3_i(shift3_i),\n\n      .doneDatabus(),\n      .doneAddress(),\n\n      //outputs \n      .valid_o(valid_o),\n      .ready_i(ready_i),\n      .addr_o (addr_o),\n      .store_o(store_o),\n\n      .databus_ready(1'b1),\n      .databus_valid(),\n      .databus_addr(),\n      .databus_len(),\n      .databus_last(1'b1),\n\n      // Data interface\n      .data_valid_i(1'b1),\n      .data_ready_i(1'b1),\n      .reading(1'b1),\n\n      .count_i(1'b0),\n      .start_address_i(1'b0),\n      .address_shift_i(1'b0),\n      .databus_length(1'b0)\n   );\n\nendmodule  // MyAddressGen\n")};
+String temp_68_CONTENT = {String("`timescale 1ns / 1ps\n`include \"iob_reg_conf.vh\"\n\nmodule iob_reg #(\n  parameter DATA_W = `IOB_REG_DATA_W,\n  parameter RST_VAL = `IOB_REG_RST_VAL\n) (\n   input [1-1:0] clk_i,\n   input [1-1:0] cke_i,\n   input [1-1:0] arst_i,\n\n   input      [DATA_W-1:0] data_i,\n   output reg [DATA_W-1:0] data_o\n);\n\n   localparam RST_POL = `IOB_REG_RST_POL;\n\n   generate\n      if (RST_POL == 1) begin: g_rst_pol_1\n         always @(posedge clk_i, posedge arst_i) begin\n            if (arst_i) begin\n               data_o <= RST_VAL;\n            end else if (cke_i) begin\n               data_o <= data_i;\n            end\n         end\n      end else begin: g_rst_pol_0\n         always @(posedge clk_i, negedge arst_i) begin\n            if (~arst_i) begin\n               data_o <= RST_VAL;\n            end else if (cke_i) begin\n               data_o <= data_i;\n            end\n         end\n      end\n   endgenerate\n\nendmodule\n")};
+String temp_69_CONTENT = {String("`timescale 1ns / 1ps\n\n`define max(a, b) (a) > (b) ? (a) : (b)\n`define min(a, b) (a) < (b) ? (a) : (b)\n\n// Addresses are given in byte space. \n// The total size in bits is given by multiplying 2^ADDR_W * min(A_DATA_W,B_DATA_W)\n// The number of blocks used is equal to max([A|B]_DATA_W) / min([A|B]_DATA_W)\n\nmodule my_dp_asym_ram #(\n   parameter FILE     = \"none\",\n   parameter A_DATA_W = 8,\n   parameter B_DATA_W = 8,\n   parameter ADDR_W   = 6\n) (\n   input clk_i,\n\n   // Port A\n   input      [A_DATA_W-1:0] dinA_i,\n   input      [  ADDR_W-1:0] addrA_i,\n   input                     enA_i,\n   input                     weA_i,\n   output reg [A_DATA_W-1:0] doutA_o,\n\n   // Port B\n   input      [B_DATA_W-1:0] dinB_i,\n   input      [  ADDR_W-1:0] addrB_i,\n   input                     enB_i,\n   input                     weB_i,\n   output reg [B_DATA_W-1:0] doutB_o\n);\n\n   //determine the number of blocks N\n   localparam MAXDATA_W =\n   `max(A_DATA_W, B_DATA_W);\n   localparam MINDATA_W =\n   `min(A_DATA_W, B_DATA_W);\n   localparam N = MAXDATA_W / MINDATA_W;\n   localparam N_W = $clog2(N);\n   localparam SYMBOL_W = $clog2(MINDATA_W / 8);\n\n   localparam M_ADDR_W = ADDR_W - N_W;\n\n   //symmetric memory block buses\n   //write buses\n   reg  [        N-1:0] bus_enA_i;\n   reg  [        N-1:0] bus_weA_i;\n   reg  [MINDATA_W-1:0] bus_inA   [N-1:0];\n   wire [MINDATA_W-1:0] bus_outA  [N-1:0];\n\n   reg  [        N-1:0] bus_enB_i;\n   reg  [        N-1:0] bus_weB_i;\n   reg  [MINDATA_W-1:0] bus_inB   [N-1:0];\n   wire [MINDATA_W-1:0] bus_outB  [N-1:0];\n\n   //instantiate N symmetric RAM blocks and connect them to the buses\n   generate\n   genvar i;\n      for (i = 0; i < N; i = i + 1) begin  : ramInst\n         my_iob_dp_ram #(\n            .DATA_W(MINDATA_W),\n            .ADDR_W(M_ADDR_W - SYMBOL_W)\n         ) iob_dp_ram_inst (\n            .clk_i(clk_i),\n\n            // Port A\n            .dinA_i (bus_inA[i]),\n            .addrA_i(addrA_i[ADDR_W-1:SYMBOL_W+N_W]),\n            .enA_i  (bus_enA_i[i]),\n            .weA_i  (bus_weA_i[i]),\n            .doutA_o(bus_outA[i]),\n\n            // Port B\n            .dinB_i (bus_inB[i]),\n            .addrB_i(addrB_i[ADDR_W-1:SYMBOL_W+N_W]),\n            .enB_i  (bus_enB_i[i]),\n            .weB_i  (bus_weB_i[i]),\n            .doutB_o(bus_outB[i])\n         );\n      end\n   endgenerate\n\n   reg [N-1:0] selector;\n\n   generate\n      if (A_DATA_W > B_DATA_W) begin\n         always @(posedge clk_i) if (enB_i) selector <= addrB_i[N_W+SYMBOL_W-1:SYMBOL_W];\n      end else if (A_DATA_W < B_DATA_W) begin\n         always @(posedge clk_i) if (enA_i) selector <= addrA_i[N_W+SYMBOL_W-1:SYMBOL_W];\n      end\n   endgenerate\n\n   integer j, k, l;\n   generate\n      if (A_DATA_W > B_DATA_W) begin\n         // Port A\n         always @* begin\n            for (j = 0; j < N; j = j + 1) begin\n               bus_enA_i[j]                    = enA_i;\n               bus_weA_i[j]                    = weA_i;\n               bus_inA[j]                      = dinA_i[j*MINDATA_W+:MINDATA_W];\n               doutA_o[j*MINDATA_W+:MINDATA_W] = bus_outA[j];\n            end\n         end\n\n         // Port B         \n         always @* begin\n            for (k = 0; k < N; k = k + 1) begin\n               if (selector == k) begin\n                  doutB_o = bus_outB[k];\n               end\n\n               if (addrB_i[N_W+SYMBOL_W-1:SYMBOL_W] == k) begin\n                  bus_enB_i[k] = enB_i;\n               end else begin\n                  bus_enB_i[k] = 1'b0;\n               end\n               bus_weB_i[k] = weB_i;\n               bus_inB[k]   = dinB_i;\n            end\n         end\n\n      end else if (A_DATA_W < B_DATA_W) begin\n         // Port B\n         always @* begin\n            for (j = 0; j < N; j = j + 1) begin\n               bus_enB_i[j]                    = enB_i;\n               bus_weB_i[j]                    = weB_i;\n               bus_inB[j]                      = dinB_i[j*MINDATA_W+:MINDATA_W];\n               doutB_o[j*MINDATA_W+:MINDATA_W] = bus_outB[j];\n            end\n         end\n\n         // Port A\n         always @* begin\n            for (k = 0; k < N; k = k + 1) begin\n               if (selector == k) begin\n                  doutA_o = bus_outA[k];\n               end\n\n               if (addrA_i[N_W+SYMBOL_W-1:SYMBOL_W] == k) begin\n                  bus_enA_i[k] = enA_i;\n               end else begin\n                  bus_enA_i[k] = 1'b0;\n               end\n               bus_weA_i[k] = weA_i;\n               bus_inA[k]   = dinA_i;\n            end\n         end\n      end else begin  //A_DATA_W = B_DATA_W\n         // Port A\n         always @* begin\n            bus_enA_i[0] = enA_i;\n            bus_weA_i[0] = weA_i;\n            bus_inA[0]   = dinA_i;\n            doutA_o      = bus_outA[0];\n         end\n\n         // Port B\n         always @* begin\n            bus_enB_i[0] = enB_i;\n            bus_weB_i[0] = weB_i;\n            bus_inB[0]   = dinB_i;\n            doutB_o      = bus_outB[0];\n         end\n      end\n   endgenerate\n\nendmodule  // my_dp_asym_ram\n\n`undef max\n`undef min\n")};
+String temp_70_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule my_iob_dp_ram #(\n   parameter FILE   = \"none\",\n   parameter DATA_W = 8,\n   parameter ADDR_W = 6\n) (\n   input clk_i,\n\n   // Port A\n   input      [DATA_W-1:0] dinA_i,\n   input      [ADDR_W-1:0] addrA_i,\n   input                   enA_i,\n   input                   weA_i,\n   output reg [DATA_W-1:0] doutA_o,\n\n   // Port B\n   input      [DATA_W-1:0] dinB_i,\n   input      [ADDR_W-1:0] addrB_i,\n   input                   enB_i,\n   input                   weB_i,\n   output reg [DATA_W-1:0] doutB_o\n);\n\n   //this allows ISE 14.7 to work; do not remove\n   localparam mem_init_file_int = FILE;\n\n\n   // Declare the RAM\n   reg [DATA_W-1:0] ram[2**ADDR_W-1:0];\n\n`ifdef NO_X_SIM\n   integer i;\n`endif\n   // Initialize the RAM\n   initial begin \n      if (mem_init_file_int != \"none\") begin\n         $readmemh(mem_init_file_int, ram, 0, 2 ** ADDR_W - 1);\n      end else begin\n`ifdef NO_X_SIM \n         // We rather initialize with some dummy value than with zeroes. More likely to catch a problem.\n           for(i = 0; i < (2**ADDR_W); i = i + 1) begin\n               ram[i] = {(DATA_W/8){8'hBA}};\n           end\n`endif\n      end\n   end\n\n   always @(posedge clk_i) begin  // Port A\n      if (enA_i) begin\n         if (weA_i) begin\n            ram[addrA_i] <= dinA_i;\n         //end else begin\n         //   doutA_o <= ram[addrA_i];\n         end\n         doutA_o <= ram[addrA_i];\n      end\n   end\n\n   always @(posedge clk_i) begin  // Port B\n      if (enB_i) begin\n         if (weB_i) begin\n            ram[addrB_i] <= dinB_i;\n         //end else begin\n         //   doutB_o <= ram[addrB_i];\n         end\n         doutB_o <= ram[addrB_i];\n      end\n   end\n\nendmodule  // my_iob_dp_ram\n")};
+String temp_71_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Const #(\n   parameter DATA_W = 32\n) (\n\n   output [DATA_W-1:0] out0,\n\n   input [DATA_W-1:0] constant  // config\n);\n\n   assign out0 = constant;\n\nendmodule\n")};
+String temp_72_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule LookupTableRead #(\n   parameter DATA_W     = 32,\n   parameter ADDR_W     = 16,\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter DELAY_W    = 20,\n   parameter LEN_W      = 8\n) (\n   //databus interface\n   input                         databus_ready_0,\n   output                        databus_valid_0,\n   output reg [  AXI_ADDR_W-1:0] databus_addr_0,\n   input      [  AXI_DATA_W-1:0] databus_rdata_0,\n   output     [  AXI_DATA_W-1:0] databus_wdata_0,\n   output     [AXI_DATA_W/8-1:0] databus_wstrb_0,\n   output     [       LEN_W-1:0] databus_len_0,\n   input                         databus_last_0,\n\n   output reg done,\n\n   input [ADDR_W-3:0] in0,\n\n   (* versat_latency = 2 *) output [DATA_W-1:0] out0,\n\n   // Used by lookup table\n   output reg [    ADDR_W-1:0] ext_dp_addr_0_port_0,\n   output     [AXI_DATA_W-1:0] ext_dp_out_0_port_0,\n   input      [AXI_DATA_W-1:0] ext_dp_in_0_port_0,\n   output                      ext_dp_enable_0_port_0,\n   output                      ext_dp_write_0_port_0,\n\n   // Used to write data into lookup table\n   output [    ADDR_W-1:0] ext_dp_addr_0_port_1,\n   output [AXI_DATA_W-1:0] ext_dp_out_0_port_1,\n   output                  ext_dp_enable_0_port_1,\n   input  [AXI_DATA_W-1:0] ext_dp_in_0_port_1,\n   output                  ext_dp_write_0_port_1,\n\n   // configurations\n   input [AXI_ADDR_W-1:0] ext_addr,\n   input [    ADDR_W-1:0] iterA,\n   input [    ADDR_W-1:0] perA,\n   input [    ADDR_W-1:0] dutyA,\n   input [    ADDR_W-1:0] shiftA,\n   input [    ADDR_W-1:0] incrA,\n   input [     LEN_W-1:0] length,\n   input                  pingPong,\n\n   input disabled,\n\n   input running,\n   input clk,\n   input rst,\n   input run\n);\n\n   assign ext_dp_out_0_port_0 = 0;\n\n   localparam DIFF = AXI_DATA_W / DATA_W;\n   localparam DECISION_BIT_W = $clog2(DIFF);\n\n   /*\n   function [ADDR_W-DECISION_BIT_W-1:0] symbolSpaceConvert(input [ADDR_W-1:0] in);\n      reg [ADDR_W-1:0] shiftRes;\n      begin\n         shiftRes = in >> DECISION_BIT_W;\n         symbolSpaceConvert = shiftRes[ADDR_W-DECISION_BIT_W-1:0];\n      end\n   endfunction\n   */\n\n   reg              pingPongState;\n\n   reg [ADDR_W-1:0] addr_0;\n   always @* begin\n      addr_0 = {in0[ADDR_W-3:0], 2'b0};\n      addr_0[ADDR_W-1] = pingPong && (!pingPongState);\n   end\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) ext_dp_addr_0_port_0 <= 0;\n      else ext_dp_addr_0_port_0 <= addr_0;\n   end\n\n   generate\n      if (AXI_DATA_W > DATA_W) begin\n         // Byte selector needs to be saved to later indicate which lane to output (for 64)\n         reg [DECISION_BIT_W-1:0] sel_0;  // Matches addr_0_port_0\n         reg [DECISION_BIT_W-1:0] sel_1;  // Matches rdata_0_port_0\n         always @(posedge clk, posedge rst) begin\n            if (rst) begin\n               sel_0 <= 0;\n               sel_1 <= 0;\n            end else begin\n               sel_0 <= in0[DECISION_BIT_W-1:0];\n               sel_1 <= sel_0;\n            end\n         end\n\n         WideAdapter #(\n            .INPUT_W (AXI_DATA_W),\n            .OUTPUT_W(DATA_W)\n         ) adapter (\n            .sel_i(sel_1),\n            .in_i (ext_dp_in_0_port_0),\n            .out_o(out0)\n         );\n      end else begin\n         assign out0 = ext_dp_in_0_port_0;\n      end\n   endgenerate\n\n   assign ext_dp_enable_0_port_0 = 1'b1;\n   assign ext_dp_write_0_port_0  = 1'b0;\n\n   assign databus_wdata_0        = 0;\n   assign databus_wstrb_0        = 0;\n   assign databus_len_0          = length;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         done <= 1'b1;\n      end else if (run && !disabled) begin\n         done <= 1'b0;\n      end else begin\n         if (databus_valid_0 && databus_ready_0 && databus_last_0) done <= 1'b1;\n      end\n   end\n\n   // Ping pong \n   always @(posedge clk, posedge rst) begin\n      if (rst) pingPongState <= 0;\n      else if (run)  // && !disabled\n         pingPongState <= pingPong ? (!pingPongState) : 1'b0;\n   end\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) databus_addr_0 <= 0;\n      else if (run && !disabled) databus_addr_0 <= ext_addr;\n   end\n\n   wire [ADDR_W-1:0] startA = 0;\n   wire [DELAY_W-1:0] delayA = 0;\n\n   wire              gen_ready;\n   wire [ADDR_W-1:0] gen_addr;\n\n   AddressGen #(\n      .ADDR_W  (ADDR_W),\n      .DATA_W  (AXI_DATA_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(ADDR_W)\n   ) addrgenA (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .iter_i(iterA),\n      .per_i    (perA),\n      .duty_i      (dutyA),\n      .delay_i     (delayA),\n      .start_i     (startA),\n      .shift_i     (shiftA),\n      .incr_i      (incrA),\n\n      //outputs \n      .valid_o(),\n      .ready_i(gen_ready),\n      .addr_o (gen_addr),\n      .store_o(),\n\n      .done_o ()\n   );\n\n   wire                  write_en;\n   wire [    ADDR_W-1:0] write_addr;\n   wire [AXI_DATA_W-1:0] write_data;\n\n   reg                   gen_valid;\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         gen_valid <= 1'b0;\n      end else if (run) begin\n         gen_valid <= !disabled;\n      end else if (running) begin\n         if (databus_valid_0 && databus_ready_0 && databus_last_0) begin\n            gen_valid <= 1'b0;\n         end\n      end\n   end\n\n   wire result_ready_int = ~rst;\n\n   JoinTwoHandshakes #(\n      .FIRST_DATA_W(ADDR_W),\n      .SECOND_DATA_W(AXI_DATA_W)\n   ) writer (\n      .first_valid_i(gen_valid),\n      .first_ready_o(gen_ready),\n      .first_data_i(gen_addr),\n\n      .second_valid_i(databus_ready_0),\n      .second_ready_o(databus_valid_0),\n      .second_data_i(databus_rdata_0),\n\n      .result_valid_o(write_en),\n      .result_ready_i(result_ready_int),\n      .result_first_data_o(write_addr),\n      .result_second_data_o(write_data),\n\n      .forceReset(!running),\n\n      .clk_i(clk),\n      .rst_i(rst)\n   );\n\n   assign ext_dp_addr_0_port_1 = pingPong ? {(pingPongState) ^ write_addr[ADDR_W-1],write_addr[ADDR_W-2:0]} : write_addr;\n   assign ext_dp_enable_0_port_1 = write_en;\n   assign ext_dp_write_0_port_1 = 1'b1;\n   assign ext_dp_out_0_port_1 = write_data;\n\n\nendmodule\n")};
+String temp_73_CONTENT = {String("`timescale 1ns / 1ps\n\n`define COMPLEX_INTERFACE\n\n// Probably could be implemented using Mem.v but for now simplify\n(* source *) module ReadWriteMem #(\n   parameter DATA_W        = 32,\n   parameter DELAY_W       = 7,\n   parameter SIZE_W        = 32,\n   parameter ADDR_W        = 12,\n   parameter PERIOD_W      = 10\n) (\n   //control\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n   input  disabled,\n\n   //databus interface\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  ADDR_W-1:0] addr,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output reg                rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   //input / output data\n                            input  [DATA_W-1:0] in0,\n   (* versat_latency = 3 *) output [DATA_W-1:0] out0,\n\n   // External memory\n   output [ADDR_W-1:0] ext_dp_addr_0_port_0,\n   output [DATA_W-1:0] ext_dp_out_0_port_0,\n   input  [DATA_W-1:0] ext_dp_in_0_port_0,\n   output              ext_dp_enable_0_port_0,\n   output              ext_dp_write_0_port_0,\n\n   output [ADDR_W-1:0] ext_dp_addr_0_port_1,\n   output [DATA_W-1:0] ext_dp_out_0_port_1,\n   input  [DATA_W-1:0] ext_dp_in_0_port_1,\n   output              ext_dp_enable_0_port_1,\n   output              ext_dp_write_0_port_1,\n\n   input [DELAY_W-1:0] delay0,\n\n   // Configuration\n   // Input config\n   input [ADDR_W-1:0] iterA,\n   input [PERIOD_W-1:0] perA,\n   input [PERIOD_W-1:0] dutyA,\n   input [ADDR_W-1:0] startA,\n   input [ADDR_W-1:0] shiftA,\n   input [ADDR_W-1:0] incrA,\n   input              reverseA,\n   input              extA,\n   input              in0_wr,\n\n   // Output config\n   input [ADDR_W-1:0] iterB,\n   input [PERIOD_W-1:0] perB,\n   input [PERIOD_W-1:0] dutyB,\n   input [ADDR_W-1:0] startB,\n   input [ADDR_W-1:0] shiftB,\n   input [ADDR_W-1:0] incrB,\n   //input [    32-1:0] delay1,\n   input              reverseB\n);\n\n   wire we = |wstrb;\n\n   wire doneA, doneB;\n   wire ready_int = ~rst;\n\n   //output databus\n   reg [DATA_W-1:0] out_reg;\n\n   assign out0 = (running ? out_reg : 0);\n   assign done = (doneA & doneB);\n\n   //function to reverse bits\n   function [ADDR_W-1:0] reverseBits;\n      input [ADDR_W-1:0] word;\n      integer i;\n\n      begin\n         for (i = 0; i < ADDR_W; i = i + 1) reverseBits[i] = word[ADDR_W-1-i];\n      end\n   endfunction\n\n   //mem enables output by addr gen\n   wire enA_int;\n   wire enA = enA_int | valid;\n\n   //write enables\n   wire wrA = valid ? we : (enA_int & in0_wr & ~extA); //addrgen on & input on & input isn't address\n\n   //port addresses and enables\n   wire [ADDR_W-1:0] addrA, addrA_int, addrA_int2;\n   wire [ADDR_W-1:0] addrB, addrB_int, addrB_int2;\n\n   //data inputs\n   wire [DATA_W-1:0] data_to_wrA = valid ? wdata : in0;\n\n   //address generators\n\n   AddressGen #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(SIZE_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenA (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .per_i(perA),\n      .start_i (startA),\n      .incr_i  (incrA),\n      .delay_i (delay0),\n\n`ifdef COMPLEX_INTERFACE\n      .iter_i(iterA),\n      .duty_i      (dutyA),\n      .shift_i     (shiftA),\n`endif\n\n      //outputs \n      .valid_o(enA_int),\n      .ready_i(ready_int),\n      .addr_o (addrA_int),\n      .store_o(), // TODO: Handle duty\n\n      .done_o (doneA)\n   );\n\n   AddressGen #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(SIZE_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenB (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .per_i(perB),\n      .start_i (startB),\n      .incr_i  (incrB),\n      .delay_i (0),\n\n`ifdef COMPLEX_INTERFACE\n      .iter_i(iterB),\n      .duty_i      (dutyB),\n      .shift_i     (shiftB),\n`endif\n\n      //outputs \n      .valid_o(),\n      .ready_i(ready_int),\n      .addr_o (addrB_int),\n      .store_o(), // TODO: Handle duty\n\n      .done_o (doneB)\n   );\n\n   //define addresses based on ext and rvrs\n   assign addrA      = valid ? addr[ADDR_W-1:0] : (extA ? in0[ADDR_W-1:0] : addrA_int2[ADDR_W-1:0]);\n   assign addrB      = valid ? addr[ADDR_W-1:0] : addrB_int2[ADDR_W-1:0];\n   assign addrA_int2 = reverseA ? reverseBits(addrA_int) : addrA_int;\n   assign addrB_int2 = reverseB ? reverseBits(addrB_int) : addrB_int;\n\n   //register mem inputs\n   reg [DATA_W-1:0] data_a_reg;\n   reg [ADDR_W-1:0] addr_a_reg, addr_b_reg;\n   reg en_a_reg, en_b_reg, we_a_reg;\n   always @(posedge clk) begin\n      data_a_reg <= data_to_wrA;\n      addr_a_reg <= addrA;\n      addr_b_reg <= addrB;\n      en_a_reg   <= enA;\n      en_b_reg   <= (valid && !we);\n      we_a_reg   <= wrA;\n   end\n\n   // Read \n   assign rdata = (rvalid ? out_reg : 32'h0);\n\n   // Delay by a cycle to match memory read latency\n   reg readCounter[1:0];\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         rvalid         <= 1'b0;\n         readCounter[0] <= 1'b0;\n         readCounter[1] <= 1'b0;\n      end else begin\n         if (rvalid) begin\n            rvalid         <= 1'b0;\n            readCounter[0] <= 1'b0;\n            readCounter[1] <= 1'b0;\n         end else begin\n            // Write\n            //if(valid && we)\n            //   ready <= 1'b1;\n\n            // Read\n            rvalid         <= readCounter[0];\n            readCounter[0] <= readCounter[1];\n            if (wstrb == 0) readCounter[1] <= valid;\n         end\n      end\n   end\n\n   assign ext_dp_addr_0_port_0   = addr_a_reg;\n   assign ext_dp_out_0_port_0    = data_a_reg;\n   assign ext_dp_enable_0_port_0 = en_a_reg;\n   assign ext_dp_write_0_port_0  = we_a_reg;\n\n   assign ext_dp_addr_0_port_1   = addr_b_reg;\n   assign ext_dp_out_0_port_1    = 0;\n   assign ext_dp_enable_0_port_1 = en_b_reg || running;\n   assign ext_dp_write_0_port_1  = 1'b0;\n\n   //register mem outputs\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out_reg <= 0;\n      end else if (run) begin\n         out_reg <= 0;\n      end else begin\n         out_reg <= ext_dp_in_0_port_1;\n      end\n   end\n\nendmodule\n\n`undef COMPLEX_INTERFACE\n")};
+String temp_74_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule PipelineRegister #(\n   parameter DATA_W = 32\n) (\n   input running,\n\n   input [DATA_W-1:0] in0,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input clk,\n   input rst\n);\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0 <= {DATA_W{1'b0}};\n      end else if (running) begin\n         out0 <= in0;\n      end else begin\n         out0 <= {DATA_W{1'b0}};\n      end\n   end\n\nendmodule\n")};
+String temp_75_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Merge2 #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //input / output data\n                             input [DATA_W-1:0] in0,\n   (* versat_latency = 1 *)  input [DATA_W-1:0] in1,\n   (* versat_latency = 2 *)  input [DATA_W-1:0] in2,\n   (* versat_latency = 3 *)  input [DATA_W-1:0] in3,\n   (* versat_latency = 4 *)  input [DATA_W-1:0] in4,\n   (* versat_latency = 5 *)  input [DATA_W-1:0] in5,\n   (* versat_latency = 6 *)  input [DATA_W-1:0] in6,\n   (* versat_latency = 7 *)  input [DATA_W-1:0] in7,\n   (* versat_latency = 8 *)  input [DATA_W-1:0] in8,\n   (* versat_latency = 9 *)  input [DATA_W-1:0] in9,\n   (* versat_latency = 10 *) input [DATA_W-1:0] in10,\n   (* versat_latency = 11 *) input [DATA_W-1:0] in11,\n   (* versat_latency = 12 *) input [DATA_W-1:0] in12,\n   (* versat_latency = 13 *) input [DATA_W-1:0] in13,\n   (* versat_latency = 14 *) input [DATA_W-1:0] in14,\n   (* versat_latency = 15 *) input [DATA_W-1:0] in15,\n   (* versat_latency = 16 *) input [DATA_W-1:0] in16,\n   (* versat_latency = 17 *) input [DATA_W-1:0] in17,\n   (* versat_latency = 18 *) input [DATA_W-1:0] in18,\n   (* versat_latency = 19 *) input [DATA_W-1:0] in19,\n   (* versat_latency = 20 *) input [DATA_W-1:0] in20,\n   (* versat_latency = 21 *) input [DATA_W-1:0] in21,\n   (* versat_latency = 22 *) input [DATA_W-1:0] in22,\n   (* versat_latency = 23 *) input [DATA_W-1:0] in23,\n   (* versat_latency = 24 *) input [DATA_W-1:0] in24,\n   (* versat_latency = 25 *) input [DATA_W-1:0] in25,\n   (* versat_latency = 26 *) input [DATA_W-1:0] in26,\n   (* versat_latency = 27 *) input [DATA_W-1:0] in27,\n   (* versat_latency = 28 *) input [DATA_W-1:0] in28,\n   (* versat_latency = 29 *) input [DATA_W-1:0] in29,\n   (* versat_latency = 30 *) input [DATA_W-1:0] in30,\n   (* versat_latency = 31 *) input [DATA_W-1:0] in31,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] delay0\n);\n\n   reg  [DELAY_W-1:0] delay;\n\n   wire [ DATA_W-1:0] select[31:0];\n\n   assign select[0]  = in0;\n   assign select[1]  = in1;\n   assign select[2]  = in2;\n   assign select[3]  = in3;\n   assign select[4]  = in4;\n   assign select[5]  = in5;\n   assign select[6]  = in6;\n   assign select[7]  = in7;\n   assign select[8]  = in8;\n   assign select[9]  = in9;\n   assign select[10] = in10;\n   assign select[11] = in11;\n   assign select[12] = in12;\n   assign select[13] = in13;\n   assign select[14] = in14;\n   assign select[15] = in15;\n   assign select[16] = in16;\n   assign select[17] = in17;\n   assign select[18] = in18;\n   assign select[19] = in19;\n   assign select[20] = in20;\n   assign select[21] = in21;\n   assign select[22] = in22;\n   assign select[23] = in23;\n   assign select[24] = in24;\n   assign select[25] = in25;\n   assign select[26] = in26;\n   assign select[27] = in27;\n   assign select[28] = in28;\n   assign select[29] = in29;\n   assign select[30] = in30;\n   assign select[31] = in31;\n\n   reg [4:0] counter;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         delay   <= {DELAY_W{1'b0}};\n         counter <= 5'b0;\n      end else if (run) begin\n         delay   <= delay0;\n         counter <= 5'b0;\n      end else if (running) begin\n         if (|delay) begin\n            delay <= delay - 1;\n         end\n\n         if (delay == 0) begin\n            counter <= counter + 1;\n         end\n\n         out0 <= select[counter];\n      end else begin\n         delay   <= delay;\n         counter <= counter;\n      end\n   end\n\nendmodule\n")};
+String temp_76_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule DebugReadMem #(\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter LEN_W      = 8\n) (\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output reg done,\n\n   // Databus interface\n   input                     databus_ready_0,\n   output reg                databus_valid_0,\n   output [  AXI_ADDR_W-1:0] databus_addr_0,\n   input  [  AXI_DATA_W-1:0] databus_rdata_0,\n   output [  AXI_DATA_W-1:0] databus_wdata_0,\n   output [AXI_DATA_W/8-1:0] databus_wstrb_0,\n   output [       LEN_W-1:0] databus_len_0,\n   input                     databus_last_0,\n\n   input [AXI_ADDR_W-1:0]    address,\n\n   output reg [AXI_DATA_W-1:0] lastRead\n);\n\n   assign databus_addr_0  = address;\n   assign databus_wstrb_0 = {(AXI_DATA_W/8){1'b0}};\n   assign databus_len_0   = 4;\n   assign databus_wdata_0 = {AXI_DATA_W{1'b0}};\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         databus_valid_0 <= 1'b0;\n         lastRead <= {AXI_DATA_W{1'b0}};\n         done <= 1'b1;\n      end else if (run) begin\n         databus_valid_0 <= 1'b1;\n         lastRead <= {AXI_DATA_W{1'b0}};\n         done <= 1'b0;\n      end else if (running) begin\n         if(databus_ready_0) begin\n            databus_valid_0 <= 1'b0;\n            lastRead <= databus_rdata_0;\n            done <= 1'b1;\n         end\n      end\n   end\n\nendmodule  // DebugReadMem\n\n")};
+String temp_77_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule CombMux8 #(\n   parameter DATA_W = 32\n) (\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n   input [DATA_W-1:0] in2,\n   input [DATA_W-1:0] in3,\n   input [DATA_W-1:0] in4,\n   input [DATA_W-1:0] in5,\n   input [DATA_W-1:0] in6,\n   input [DATA_W-1:0] in7,\n\n   (* versat_latency = 0 *) output reg [DATA_W-1:0] out0,\n\n   input [2:0] sel\n);\n\n   always @* begin\n      case (sel)\n         3'b000: out0 = in0;\n         3'b001: out0 = in1;\n         3'b010: out0 = in2;\n         3'b011: out0 = in3;\n         3'b100: out0 = in4;\n         3'b101: out0 = in5;\n         3'b110: out0 = in6;\n         3'b111: out0 = in7;\n      endcase\n   end\n\nendmodule\n")};
+String temp_78_CONTENT = {String("`timescale 1ns / 1ps\n\n`define COMPLEX_INTERFACE\n\n(* source *) module Mem #(\n   parameter DATA_W        = 32,\n   parameter SIZE_W        = 32,\n   parameter DELAY_W       = 7,\n   parameter ADDR_W        = 12,\n   parameter PERIOD_W      = 10\n) (\n   //control\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n   input  disabled,\n\n   //databus interface\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  ADDR_W-1:0] addr,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output reg                rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   //input / output data\n                            input  [DATA_W-1:0] in0,\n                            input  [DATA_W-1:0] in1,\n   (* versat_latency = 3 *) output [DATA_W-1:0] out0,\n   (* versat_latency = 3 *) output [DATA_W-1:0] out1,\n\n   // External memory\n   output [ADDR_W-1:0] ext_dp_addr_0_port_0,\n   output [DATA_W-1:0] ext_dp_out_0_port_0,\n   input  [DATA_W-1:0] ext_dp_in_0_port_0,\n   output              ext_dp_enable_0_port_0,\n   output              ext_dp_write_0_port_0,\n\n   output [ADDR_W-1:0] ext_dp_addr_0_port_1,\n   output [DATA_W-1:0] ext_dp_out_0_port_1,\n   input  [DATA_W-1:0] ext_dp_in_0_port_1,\n   output              ext_dp_enable_0_port_1,\n   output              ext_dp_write_0_port_1,\n\n   // Configuration\n   input [ADDR_W-1:0] iterA,\n   input [PERIOD_W-1:0] perA,\n   input [PERIOD_W-1:0] dutyA,\n   input [ADDR_W-1:0] startA,\n   input [ADDR_W-1:0] shiftA,\n   input [ADDR_W-1:0] incrA,\n   input              reverseA,\n   input              extA,\n   input              in0_wr,\n\n   input [ADDR_W-1:0] iterB,\n   input [PERIOD_W-1:0] perB,\n   input [PERIOD_W-1:0] dutyB,\n   input [ADDR_W-1:0] startB,\n   input [ADDR_W-1:0] shiftB,\n   input [ADDR_W-1:0] incrB,\n   input              reverseB,\n   input              extB,\n   input              in1_wr,\n\n   input [DELAY_W-1:0] delay0,\n   input [DELAY_W-1:0] delay1\n);\n\n   wire we = |wstrb;\n\n   wire doneA, doneB;\n   wire ready_int = ~rst;\n\n   //output databus\n   reg [DATA_W-1:0] outA_reg, outB_reg;\n\n   reg [DELAY_W-1:0] testDelay0;\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         testDelay0 <= 0;\n      end else if (run) begin\n         testDelay0 <= delay0 + 3;\n      end else if (|testDelay0) begin\n         testDelay0 <= testDelay0 - 1;\n      end\n   end\n\n   reg [DELAY_W-1:0] testDelay1;\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         testDelay1 <= 0;\n      end else if (run) begin\n         testDelay1 <= delay1 + 3;\n      end else if (|testDelay1) begin\n         testDelay1 <= testDelay1 - 1;\n      end\n   end\n\n   assign out0 = (running & (|testDelay0) == 0) ? outA_reg : 0;\n   assign out1 = (running & (|testDelay1) == 0) ? outB_reg : 0;\n\n   // Delay done by 3 cycles so that pc-emul matches simulation\n   // since pc-emul external memories stop working when the accelerator stops running in pc-emul.\n   reg doneA_1,doneB_1;\n   reg doneA_2,doneB_2;\n   reg doneA_3,doneB_3;\n   always @(posedge clk,posedge rst)\n   begin\n      if(rst) begin\n         doneA_1 <= 0;\n         doneA_2 <= 0;\n         doneB_1 <= 0;\n         doneB_2 <= 0;\n      end else begin\n         doneA_1 <= doneA;\n         doneA_2 <= doneA_1;\n         doneA_3 <= doneA_2;\n         doneB_1 <= doneB;\n         doneB_2 <= doneB_1;\n         doneB_3 <= doneB_2;\n      end\n   end\n   assign done = (doneA & doneB & doneA_2 & doneB_2 & doneA_3 & doneB_3);\n\n   //assign done = (doneA & doneB);\n\n   //function to reverse bits\n   function [ADDR_W-1:0] reverseBits;\n      input [ADDR_W-1:0] word;\n      integer i;\n\n      begin\n         for (i = 0; i < ADDR_W; i = i + 1) reverseBits[i] = word[ADDR_W-1-i];\n      end\n   endfunction\n\n   //mem enables output by addr gen\n   wire enA_int;\n   wire enA = enA_int | valid;\n   wire enB;\n\n   //write enables\n   wire wrA = valid? we : (enA_int & in0_wr & ~extA); //addrgen on & input on & input isn't address\n   wire wrB = (enB & in1_wr & ~extB);\n\n   //port addresses and enables\n   wire [ADDR_W-1:0] addrA, addrA_int, addrA_int2;\n   wire [ADDR_W-1:0] addrB, addrB_int, addrB_int2;\n\n   //data inputs\n   wire [DATA_W-1:0] data_to_wrA = valid ? wdata : in0;\n\n   //address generators\n\n   AddressGen #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(SIZE_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenA (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .per_i(perA),\n      .start_i (startA),\n      .incr_i  (incrA),\n      .delay_i (delay0),\n\n`ifdef COMPLEX_INTERFACE\n      .iter_i(iterA),\n      .duty_i      (dutyA),\n      .shift_i     (shiftA),\n`endif\n\n      //outputs \n      .valid_o(enA_int),\n      .ready_i(ready_int),\n      .addr_o (addrA_int),\n      .store_o(),\n\n      .done_o (doneA)\n   );\n\n   AddressGen #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(SIZE_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenB (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .per_i(perB),\n      .start_i (startB),\n      .incr_i  (incrB),\n      .delay_i (delay1),\n\n`ifdef COMPLEX_INTERFACE\n      .iter_i(iterB),\n      .duty_i      (dutyB),\n      .shift_i     (shiftB),\n`endif\n\n      //outputs \n      .valid_o(enB),\n      .ready_i(ready_int),\n      .addr_o (addrB_int),\n      .store_o(),\n\n      .done_o (doneB)\n   );\n\n   //define addresses based on ext and rvrs\n   assign addrA      = valid ? addr[ADDR_W-1:0] : (extA ? in0[ADDR_W-1:0] : addrA_int2[ADDR_W-1:0]);\n   assign addrB      = (extB ? in1[ADDR_W-1:0] : addrB_int2[ADDR_W-1:0]);\n   assign addrA_int2 = reverseA ? reverseBits(addrA_int) : addrA_int;\n   assign addrB_int2 = reverseB ? reverseBits(addrB_int) : addrB_int;\n\n   //register mem inputs\n   reg [DATA_W-1:0] data_a_reg, data_b_reg;\n   reg [ADDR_W-1:0] addr_a_reg, addr_b_reg;\n   reg en_a_reg, en_b_reg, we_a_reg, we_b_reg;\n   always @(posedge clk) begin\n      data_a_reg <= data_to_wrA;\n      data_b_reg <= in1;\n      addr_a_reg <= addrA;\n      addr_b_reg <= addrB;\n      en_a_reg   <= enA;\n      en_b_reg   <= enB;\n      we_a_reg   <= wrA;\n      we_b_reg   <= wrB;\n   end\n\n   // Read \n   assign rdata = (rvalid ? outA_reg : {DATA_W{1'b0}});\n\n   // Delay by a cycle to match memory read latency\n   reg readCounter[1:0];\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         rvalid         <= 1'b0;\n         readCounter[0] <= 1'b0;\n         readCounter[1] <= 1'b0;\n      end else begin\n         if (rvalid) begin\n            rvalid         <= 1'b0;\n            readCounter[0] <= 1'b0;\n            readCounter[1] <= 1'b0;\n         end else begin\n            // Write\n            //if(valid && we)\n            //   ready <= 1'b1;\n\n            // Read\n            rvalid         <= readCounter[0];\n            readCounter[0] <= readCounter[1];\n            if (wstrb == 0) readCounter[1] <= valid;\n         end\n      end\n   end\n\n   assign ext_dp_addr_0_port_0   = addr_a_reg;\n   assign ext_dp_out_0_port_0    = data_a_reg;\n   assign ext_dp_enable_0_port_0 = en_a_reg;\n   assign ext_dp_write_0_port_0  = we_a_reg;\n\n   assign ext_dp_addr_0_port_1   = addr_b_reg;\n   assign ext_dp_out_0_port_1    = data_b_reg;\n   assign ext_dp_enable_0_port_1 = en_b_reg;\n   assign ext_dp_write_0_port_1  = we_b_reg;\n\n   //register mem outputs\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         outA_reg <= 0;\n         outB_reg <= 0;\n      end else if (run) begin\n         outA_reg <= 0;\n         outB_reg <= 0;\n      end else begin\n         outA_reg <= ext_dp_in_0_port_0;  //outA;\n         outB_reg <= ext_dp_in_0_port_1;\n      end\n   end\n\nendmodule\n\n`undef COMPLEX_INTERFACE\n")};
+String temp_79_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Mux8 #(\n   parameter DATA_W = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n   input [DATA_W-1:0] in2,\n   input [DATA_W-1:0] in3,\n   input [DATA_W-1:0] in4,\n   input [DATA_W-1:0] in5,\n   input [DATA_W-1:0] in6,\n   input [DATA_W-1:0] in7,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [2:0] sel\n);\n\n   reg [DATA_W-1:0] out;\n   always @* begin\n      case (sel)\n         3'b000: out = in0;\n         3'b001: out = in1;\n         3'b010: out = in2;\n         3'b011: out = in3;\n         3'b100: out = in4;\n         3'b101: out = in5;\n         3'b110: out = in6;\n         3'b111: out = in7;\n      endcase\n   end\n\n   always @(posedge clk,posedge rst) begin\n      if(rst) begin\n         out0 <= 0;\n      end else if (running) begin\n         out0 <= out;         \n      end else begin\n        out0 <= 0;\n      end\n   end\n\nendmodule\n")};
+String temp_80_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Generator #(\n    parameter PERIOD_W = 16,\n    parameter DELAY_W  = 7,\n    parameter ADDR_W   = 32\n) (\n    input clk,\n    input rst,\n\n    input running,\n    input run,\n\n    //configurations \n    input [ADDR_W-1:0] iter,\n    input [ADDR_W-1:0] shift,\n\n    input [PERIOD_W - 1:0] per,\n    input [ADDR_W-1:0] incr,\n\n    input [ADDR_W-1:0] iter2,\n    input [ADDR_W-1:0] shift2,\n\n    input [PERIOD_W - 1:0] per2,\n    input [ADDR_W-1:0] incr2,\n\n    input [ADDR_W-1:0] iter3,\n    input [ADDR_W-1:0] shift3,\n\n    input [PERIOD_W - 1:0] per3,\n    input [ADDR_W-1:0] incr3,\n\n    input [PERIOD_W - 1:0] duty,\n    input [ADDR_W-1:0] start,\n\n    input [DELAY_W-1:0] delay0,\n\n    //outputs \n    (* versat_latency = 0 *)\n    output [ADDR_W-1:0] out0 // Latency zero because Address Gen is one cycle ahead in providing the address\n);\n\n  wire [ADDR_W-1:0] genOut;\n\n  assign out0 = genOut;  //done ? off_value : genOut;\n\n  AddressGen3 #(\n      .ADDR_W  (ADDR_W),\n      .DATA_W  (8),\n      .DELAY_W (DELAY_W),\n      .PERIOD_W(PERIOD_W)\n  ) addrGen (\n      .clk_i(clk),\n      .rst_i(rst),\n\n      .run_i(run),\n\n      .ignore_first_i(1'b0),\n\n      //configurations \n      .duty_i (duty),\n      .start_i(start),\n\n      .per_i (per),\n      .incr_i(incr),\n\n      .iter_i (iter),\n      .shift_i(shift),\n\n      .per2_i (per2),\n      .incr2_i(incr2),\n\n      .iter2_i (iter2),\n      .shift2_i(shift2),\n\n      .per3_i (per3),\n      .incr3_i(incr3),\n\n      .iter3_i (iter3),\n      .shift3_i(shift3),\n\n      .delay_i(delay0),\n\n      //outputs \n      .valid_o(),\n      .ready_i(running),\n      .addr_o (genOut),\n      .store_o(),\n\n      .done_o()\n  );\n\nendmodule\n")};
+String temp_81_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule SwapEndian #(\n   parameter DATA_W = 32\n) (\n   input running,\n\n   (* versat_latency = 0 *) input [DATA_W-1:0] in0,\n\n   //input / output data\n   (* versat_latency = 0 *) output reg [DATA_W-1:0] out0,\n\n   input enabled\n);\n\n   always @* begin\n      out0 = {DATA_W{1'b0}};\n      if (running) begin\n          out0 = in0;\n          if (enabled) begin\n             out0[0+:8]  = in0[24+:8];\n             out0[8+:8]  = in0[16+:8];\n             out0[16+:8] = in0[8+:8];\n             out0[24+:8] = in0[0+:8];\n          end\n      end\n   end\n\n   integer i;\n   always @* begin\n      out0 = {DATA_W{1'b0}};\n      if (running) begin\n          out0 = in0;\n          if (enabled) begin\n            for(i=0; i<DATA_W; i=i+8) begin\n               out0[i +: 8] = in0[(DATA_W-8-i) +: 8];\n            end\n          end\n      end\n   end\n\nendmodule\n")};
+String temp_82_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Buffer #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] amount\n);\n\n   wire [  DELAY_W:0] occupancy;\n\n   wire               aboveOrEqual = (occupancy >= {1'b0, amount});\n   wire               belowOrEqual = (occupancy <= {1'b0, amount});\n\n   wire               read_en = (running && aboveOrEqual);\n   wire               write_en = (running && belowOrEqual);\n\n   wire               ext_2p_write;\n   wire [DELAY_W-1:0] ext_2p_addr_out;\n   wire [ DATA_W-1:0] ext_2p_data_out;\n\n   wire               ext_2p_read;\n   wire [DELAY_W-1:0] ext_2p_addr_in;\n   wire [ DATA_W-1:0] ext_2p_data_in;\n\n   my_2p_asym_ram #(\n      .W_DATA_W(DATA_W),\n      .R_DATA_W(DATA_W),\n      .ADDR_W  (DELAY_W)\n   ) ext_2p (\n      // Writting port\n      .w_en_i  (ext_2p_write),\n      .w_addr_i(ext_2p_addr_out),\n      .w_data_i(ext_2p_data_out),\n\n      // Reading port\n      .r_en_i  (ext_2p_read),\n      .r_addr_i(ext_2p_addr_in),\n      .r_data_o(ext_2p_data_in),\n\n      .clk_i(clk)\n   );\n\n   reg  [DATA_W-1:0] inData;\n   wire [DATA_W-1:0] fifo_data;\n   iob_fifo_sync #(\n      .W_DATA_W(DATA_W),\n      .R_DATA_W(DATA_W),\n      .ADDR_W  (DELAY_W)\n   ) fifo (\n      .rst_i (rst),\n      .clk_i (clk),\n      .cke_i (1'b1),\n      .arst_i(1'b0),\n\n      .level_o(occupancy),\n\n      //read port\n      .r_data_o (fifo_data),\n      .r_empty_o(),\n      .r_en_i   (read_en),\n\n      //write port\n      .w_data_i(in0),\n      .w_full_o(),\n      .w_en_i  (write_en),\n\n      //write port\n      .ext_mem_clk_o   (),\n      .ext_mem_w_en_o  (ext_2p_write),\n      .ext_mem_w_addr_o(ext_2p_addr_out),\n      .ext_mem_w_data_o(ext_2p_data_out),\n      //read port\n      .ext_mem_r_en_o  (ext_2p_read),\n      .ext_mem_r_addr_o(ext_2p_addr_in),\n      .ext_mem_r_data_i(ext_2p_data_in)\n   );\n\n   always @(posedge clk) begin\n      if (rst) inData <= 0;\n      else inData <= in0;\n   end\n\n   always @* begin\n      out0 = 0;\n\n      if (amount == 0) out0 = inData;\n      else out0 = fifo_data;\n   end\n\nendmodule\n")};
+String temp_83_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule TestConst #(\n   parameter DATA_W = 32,\n   parameter DELAY_W = 7\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //input / output data\n   output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] delay0,\n\n   input [DATA_W-1:0] constant\n);\n\n   reg [DELAY_W-1:0] delay;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0 <= {DATA_W{1'b0}};\n      end else if (run) begin\n         if (delay0 == 0) begin\n            out0 <= constant;\n         end\n         delay <= delay0;\n      end else if (running & (|delay)) begin\n         delay <= delay - 1;\n         if (delay == 1) begin\n             out0 <= constant;\n         end\n      end else begin\n         out0 <= {DATA_W{1'b0}};\n      end\n   end\n\nendmodule\n")};
+String temp_84_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule DebugWriteMem #(\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter LEN_W      = 8\n) (\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output reg done,\n\n   // Databus interface\n   input                     databus_ready_0,\n   output reg                databus_valid_0,\n   output [  AXI_ADDR_W-1:0] databus_addr_0,\n   input  [  AXI_DATA_W-1:0] databus_rdata_0,\n   output [  AXI_DATA_W-1:0] databus_wdata_0,\n   output [AXI_DATA_W/8-1:0] databus_wstrb_0,\n   output [       LEN_W-1:0] databus_len_0,\n   input                     databus_last_0,\n\n   input [AXI_ADDR_W-1:0]    address,\n   input [31:0]              content,\n   input [LEN_W-1:0]         length\n);\n\n   assign databus_addr_0  = address;\n   assign databus_wstrb_0 = {(AXI_DATA_W/8){1'b1}};\n   assign databus_len_0   = length;\n   assign databus_wdata_0 = content;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         databus_valid_0 <= 1'b0;\n         done <= 1'b1;\n      end else if (run && length != 0) begin\n         databus_valid_0 <= 1'b1;\n         done <= 1'b0;\n      end else if (running) begin\n         if(databus_ready_0 && databus_last_0) begin\n            databus_valid_0 <= 1'b0;\n            done <= 1'b1;\n         end\n      end\n   end\n\nendmodule  // DebugReadMem")};
+String temp_85_CONTENT = {String("`timescale 1ns / 1ps\n\n(* source *) module Reg #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n\n   // native interface \n   input      [         1:0] addr,\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output reg                rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   output reg [DATA_W-1:0]       out0, /* technically should have versat_latency 1 but since it's not a computing unit, output is only used to start a datapath, we save 1 cycle */\n\n   input [DELAY_W-1:0] delay0,\n   input disabled,\n\n   output [DATA_W-1:0] currentValue\n);\n\n   wire lastCycle;\n\n   DelayCalc #(.DELAY_W(DELAY_W)) delay_inst (\n   .clk(clk),\n   .rst(rst),\n\n   .running(running),\n   .run(run),\n   .done(done),\n\n   .lastCycle(lastCycle),\n\n   .delay0(delay0)\n   );\n\n   assign rdata        = (rvalid ? out0 : 0);\n   assign currentValue = out0;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0   <= {DATA_W{1'b0}};\n         rvalid <= 1'b0;\n      end else begin\n         // Native interface\n         rvalid <= 1'b0;\n\n         if (valid & (|wstrb)) begin\n            out0 <= wdata;\n         end\n         if (lastCycle && !disabled) begin\n            out0 <= in0;\n         end\n\n         if (valid & (wstrb == 0)) begin\n            rvalid <= 1'b1;\n         end\n\n      end\n   end\n\nendmodule\n")};
+String temp_86_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule StridedMerge #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //input / output data\n                             input [DATA_W-1:0] in0,\n   (* versat_latency = 1 *)  input [DATA_W-1:0] in1,\n   (* versat_latency = 2 *)  input [DATA_W-1:0] in2,\n   (* versat_latency = 3 *)  input [DATA_W-1:0] in3,\n   (* versat_latency = 4 *)  input [DATA_W-1:0] in4,\n   (* versat_latency = 5 *)  input [DATA_W-1:0] in5,\n   (* versat_latency = 6 *)  input [DATA_W-1:0] in6,\n   (* versat_latency = 7 *)  input [DATA_W-1:0] in7,\n   (* versat_latency = 8 *)  input [DATA_W-1:0] in8,\n   (* versat_latency = 9 *)  input [DATA_W-1:0] in9,\n   (* versat_latency = 10 *) input [DATA_W-1:0] in10,\n   (* versat_latency = 11 *) input [DATA_W-1:0] in11,\n   (* versat_latency = 12 *) input [DATA_W-1:0] in12,\n   (* versat_latency = 13 *) input [DATA_W-1:0] in13,\n   (* versat_latency = 14 *) input [DATA_W-1:0] in14,\n   (* versat_latency = 15 *) input [DATA_W-1:0] in15,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] delay0,\n   input [DELAY_W-1:0] stride\n);\n\n   reg  [DELAY_W-1:0] delay;\n   reg  [DELAY_W-1:0] delay2;\n\n   wire [ DATA_W-1:0] select [15:0];\n\n   assign select[0]  = in0;\n   assign select[1]  = in1;\n   assign select[2]  = in2;\n   assign select[3]  = in3;\n   assign select[4]  = in4;\n   assign select[5]  = in5;\n   assign select[6]  = in6;\n   assign select[7]  = in7;\n   assign select[8]  = in8;\n   assign select[9]  = in9;\n   assign select[10] = in10;\n   assign select[11] = in11;\n   assign select[12] = in12;\n   assign select[13] = in13;\n   assign select[14] = in14;\n   assign select[15] = in15;\n\n   reg [3:0] counter;\n\n   //assign out0 = running ? select[counter] : 0;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         delay   <= 0;\n         counter <= 0;\n      end else if (run) begin\n         delay   <= delay0;\n         counter <= 0;\n         delay2  <= stride;\n      end else if (running) begin\n         if (|delay) begin\n            delay <= delay - 1;\n            if (delay == 1) begin\n               delay2 <= stride;\n            end\n         end else begin\n            if (|delay2) begin\n               delay2 <= delay2 - 1;\n            end\n\n            if (delay2 == 0) begin\n               counter <= counter + 1;\n               delay2  <= stride;\n            end\n         end\n\n\n         out0 <= select[counter];\n      end\n   end\n\nendmodule\n")};
+String temp_87_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Equality #(\n   parameter DATA_W = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0\n);\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0 <= {DATA_W{1'b0}};\n      end else if (running) begin\n         out0 <= (in0 == in1) ? {DATA_W{1'b1}} : {DATA_W{1'b0}};\n      end else begin\n         out0 <= {DATA_W{1'b0}};\n      end\n   end\n\nendmodule\n")};
+String temp_88_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Counter (\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //configurations \n   input [          31:0] start,\n\n   //outputs \n   (* versat_latency = 0 *) output reg [31:0] out0\n);\n\n   always @(posedge clk,posedge rst) begin\n      if(rst) begin\n         out0 <= 0;\n      end else if(run) begin\n         out0 <= start;\n      end else if(running) begin\n         out0 <= out0 + 1;\n      end\n   end\n\nendmodule\n")};
+String temp_89_CONTENT = {String("`timescale 1ns / 1ps\n\n`define MULADD_MACC 1'b0\n\n/*\n\n Description: multiply (accumulate) functions\n\n */\n\nmodule Muladd #(\n   parameter DELAY_W = 7,\n   parameter DATA_W = 32,\n   parameter LOOP_W = 10\n) (\n   input      rst,\n   input      clk,\n   input      run,\n   input      running,\n   output reg done,\n\n                            input  [DATA_W-1:0] in0,\n                            input  [DATA_W-1:0] in1,\n   (* versat_latency = 3 *) output [DATA_W-1:0] out0,\n\n   // config interface\n   input       opcode,\n   input [LOOP_W-1:0] iter,\n   input [LOOP_W-1:0] period,\n\n   input [DELAY_W-1:0] delay0\n);\n\n   reg [DELAY_W-1:0] delay;\n   reg [LOOP_W-1:0] currentIteration;\n   reg [LOOP_W-1:0] currentPeriod;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         done             <= 1'b0;\n         delay            <= {DELAY_W{1'b0}};\n         currentIteration <= {LOOP_W{1'b0}};\n         currentPeriod    <= {LOOP_W{1'b0}};\n      end else if (run) begin\n         delay <= delay0 + 2; // Add 2 because it takes 2 cycles for the accumulator to start working and this whole logic is just the control for the accumulator\n         done <= 1'b0;\n      end else if (running) begin\n         if (|delay) begin\n            delay <= delay - 1;\n            if (iter == 0) begin\n               done <= 1'b1;\n            end\n            currentIteration <= 0;\n            currentPeriod    <= 0;\n         end else if (!done) begin\n            currentPeriod <= currentPeriod + 1;\n\n            if ((currentPeriod + 1) >= period) begin\n               currentPeriod    <= 0;\n\n               currentIteration <= currentIteration + 1;\n               if ((currentIteration + 1) >= iter) begin\n                  done <= 1'b1;\n               end\n            end\n         end\n      end\n   end\n\n   // select multiplier statically\n   reg signed [DATA_W-1:0] in0_reg, in1_reg, dsp_out0;\n   reg signed [2*DATA_W-1:0] acc, result_mult_reg;\n   //DSP48E template\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         in0_reg  <= {DATA_W{1'b0}};\n         in1_reg  <= {DATA_W{1'b0}};\n         dsp_out0 <= {DATA_W{1'b0}};\n         acc      <= {2*DATA_W{1'b0}};\n      end else if (running) begin\n         in0_reg         <= in0;\n         in1_reg         <= in1;\n         result_mult_reg <= in0_reg * in1_reg;\n\n         if (currentPeriod == 0) begin\n            acc <= result_mult_reg;\n         end else begin\n            if (opcode == `MULADD_MACC) acc <= acc + result_mult_reg;\n            else acc <= acc - result_mult_reg;\n         end\n\n         dsp_out0 <= acc[DATA_W-1:0];\n      end\n   end\n\n   assign out0 = dsp_out0;\n\nendmodule\n")};
+String temp_90_CONTENT = {String("`timescale 1ns / 1ps\n\n(* source *) module RegFile #(\n   parameter DELAY_W = 7,\n   parameter ADDR_W  = 6, // 2 + $CLOG(NUMBER_REGS)\n   parameter DATA_W  = 32,\n   parameter AXI_DATA_W = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input      running,\n   input      run,\n   output     done,\n\n   output [    ADDR_W-1:0] ext_2p_addr_out_0,\n   output [    ADDR_W-1:0] ext_2p_addr_in_0,\n   output                  ext_2p_write_0,\n   output                  ext_2p_read_0,\n   input  [AXI_DATA_W-1:0] ext_2p_data_in_0,\n   output [AXI_DATA_W-1:0] ext_2p_data_out_0,\n\n   output [    ADDR_W-1:0] ext_2p_addr_out_1,\n   output [    ADDR_W-1:0] ext_2p_addr_in_1,\n   output                  ext_2p_write_1,\n   output                  ext_2p_read_1,\n   input  [AXI_DATA_W-1:0] ext_2p_data_in_1,\n   output [AXI_DATA_W-1:0] ext_2p_data_out_1,\n\n   // native interface \n   input      [  ADDR_W-1:0] addr,\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output                    rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   (* versat_latency = 2 *) output [DATA_W-1:0] out0,\n   (* versat_latency = 2 *) output [DATA_W-1:0] out1,\n\n   input [3:0]         selectedInput,\n   input [3:0]         selectedOutput0,\n   input [3:0]         selectedOutput1,\n   input disabled,\n   \n   input [DELAY_W-1:0] delay0\n);\n\nwire lastCycle;\nreg ext_read_en;\n\n   DelayCalc #(\n       .DELAY_W(DELAY_W)\n   ) delay_inst (\n   .clk(clk),\n   .rst(rst),\n\n   .running(running),\n   .run(run),\n   .done(done),\n\n   .lastCycle(lastCycle),\n\n   .delay0(delay0)\n   );\n\nreg [ADDR_W-1:0] address0,address1,addressWrite;\nreg write,read;\n\nassign ext_2p_addr_out_0 = addressWrite;\nassign ext_2p_addr_out_1 = addressWrite;\n\nassign ext_2p_addr_in_0 = address0;\nassign ext_2p_addr_in_1 = address1;\n\nassign ext_2p_write_0 = write;\nassign ext_2p_write_1 = write;\n\nassign ext_2p_read_0 = ext_read_en; //read;\nassign ext_2p_read_1 = ext_read_en; //read;\n\nassign out0 = ext_2p_data_in_0;\nassign out1 = ext_2p_data_in_1;\n\nreg [DATA_W-1:0] dataToWrite;\n\nassign ext_2p_data_out_0 = dataToWrite;\nassign ext_2p_data_out_1 = dataToWrite;\n\nreg read_reg,write_reg;\n\nassign rvalid = read_reg | write_reg;\nassign rdata = (rvalid ? ext_2p_data_in_0 : 0);\n\nalways @(posedge clk,posedge rst) begin\n   if(rst) begin\n      write <= 1'b0;\n      read <= 1'b0;\n      read_reg <= 1'b0;\n      write_reg <= 0;\n      dataToWrite <= 0;\n      address0 <= 0;\n      address1 <= 0;\n      ext_read_en <= 1'b0;\n   end else begin\n      write <= 1'b0;\n      read <= 1'b0;\n      read_reg <= read;\n      write_reg <= 0;\n      ext_read_en <= 1'b1;\n\n      address0 <= {selectedOutput0,2'b00};\n      address1 <= {selectedOutput1,2'b00};\n\n      if(lastCycle && !disabled) begin\n         dataToWrite <= in0;\n         addressWrite <= {selectedInput,2'b00};\n         write <= 1'b1;\n      end\n\n      if (valid & (|wstrb)) begin\n         dataToWrite <= wdata;\n         addressWrite <= addr;\n         write <= 1'b1;\n      end\n      if (valid & (wstrb == 0)) begin\n         write_reg <= 1'b1;\n         address0 <= addr;\n         address1 <= addr;\n         read <= 1'b1;\n      end\n   end\nend\n\nendmodule\n")};
+String temp_91_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Merge #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //input / output data\n                             input [DATA_W-1:0] in0,\n   (* versat_latency = 1 *)  input [DATA_W-1:0] in1,\n   (* versat_latency = 2 *)  input [DATA_W-1:0] in2,\n   (* versat_latency = 3 *)  input [DATA_W-1:0] in3,\n   (* versat_latency = 4 *)  input [DATA_W-1:0] in4,\n   (* versat_latency = 5 *)  input [DATA_W-1:0] in5,\n   (* versat_latency = 6 *)  input [DATA_W-1:0] in6,\n   (* versat_latency = 7 *)  input [DATA_W-1:0] in7,\n   (* versat_latency = 8 *)  input [DATA_W-1:0] in8,\n   (* versat_latency = 9 *)  input [DATA_W-1:0] in9,\n   (* versat_latency = 10 *) input [DATA_W-1:0] in10,\n   (* versat_latency = 11 *) input [DATA_W-1:0] in11,\n   (* versat_latency = 12 *) input [DATA_W-1:0] in12,\n   (* versat_latency = 13 *) input [DATA_W-1:0] in13,\n   (* versat_latency = 14 *) input [DATA_W-1:0] in14,\n   (* versat_latency = 15 *) input [DATA_W-1:0] in15,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] delay0\n);\n\n   reg  [DELAY_W-1:0] delay;\n\n   wire [ DATA_W-1:0] select[15:0];\n\n   assign select[0]  = in0;\n   assign select[1]  = in1;\n   assign select[2]  = in2;\n   assign select[3]  = in3;\n   assign select[4]  = in4;\n   assign select[5]  = in5;\n   assign select[6]  = in6;\n   assign select[7]  = in7;\n   assign select[8]  = in8;\n   assign select[9]  = in9;\n   assign select[10] = in10;\n   assign select[11] = in11;\n   assign select[12] = in12;\n   assign select[13] = in13;\n   assign select[14] = in14;\n   assign select[15] = in15;\n\n   reg [3:0] counter;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         delay   <= {DELAY_W{1'b0}};\n         counter <= 4'b0;\n      end else if (run) begin\n         delay   <= delay0;\n         counter <= 4'b0;\n      end else if (running) begin\n         if (|delay) begin\n            delay <= delay - 1;\n         end\n\n         if (delay == 0) begin\n            counter <= counter + 1;\n         end\n\n         out0 <= select[counter];\n      end\n   end\n\nendmodule\n")};
+String temp_92_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule CombMux4 #(\n   parameter DATA_W = 32\n) (\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n   input [DATA_W-1:0] in2,\n   input [DATA_W-1:0] in3,\n\n   (* versat_latency = 0 *) output reg [DATA_W-1:0] out0,\n\n   input [1:0] sel\n);\n\n   always @* begin\n      case (sel)\n         2'b00: out0 = in0;\n         2'b01: out0 = in1;\n         2'b10: out0 = in2;\n         2'b11: out0 = in3;\n      endcase\n   end\n\nendmodule\n")};
+String temp_93_CONTENT = {String("`timescale 1ns / 1ps\n\n/*\n\n Description: multiply functions\n\n */\n\nmodule Mul #(\n   parameter DATA_W = 32\n) (\n   input rst,\n   input clk,\n   input running,\n\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 4 *) output [DATA_W-1:0] out0\n\n);\n\n   // select multiplier statically\n   reg signed [DATA_W-1:0] in0_reg, in1_reg, dsp_out0, acc, result_mult_reg;\n   //DSP48E template\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         in0_reg         <= {DATA_W{1'b0}};\n         in1_reg         <= {DATA_W{1'b0}};\n         dsp_out0        <= {DATA_W{1'b0}};\n         result_mult_reg <= {DATA_W{1'b0}};\n         acc             <= {DATA_W{1'b0}};\n      end else if (running) begin\n         in0_reg         <= in0;\n         in1_reg         <= in1;\n         result_mult_reg <= in0_reg * in1_reg;\n         acc             <= result_mult_reg;\n         dsp_out0        <= acc;\n      end\n   end\n\n   assign out0 = dsp_out0;\n\nendmodule\n")};
+String temp_94_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Mux2 #(\n   parameter DATA_W = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input sel\n);\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0 <= {DATA_W{1'b0}};\n      end else if (running) begin\n        if (sel) begin\n           out0 <= in1;\n        end else begin\n           out0 <= in0;\n        end\n      end\n   end\n\nendmodule\n")};
+String temp_95_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule DoneCycle #(\n    parameter DATA_W = 32\n\n) (\n   //control\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n\n   input [DATA_W-1:0] amount\n);\n\n   reg [DATA_W-1:0] counter;\n\n   assign done = (counter == {DATA_W{1'b0}});\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         counter <= 0;\n      end else if (run) begin\n         counter <= amount;\n      end else if (running & (|counter)) begin\n         counter <= counter - 1;\n      end else begin\n         counter <= counter;\n      end\n   end\n\nendmodule\n")};
+String temp_96_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Store #(\n   parameter DELAY_W = 7,\n   parameter DATA_W  = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input      running,\n   input      run,\n   output reg done,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n\n   input [DELAY_W-1:0] delay0,  // delay\n\n   output reg [DATA_W-1:0] currentValue  // state\n);\n\n   reg [DELAY_W-1:0] delay;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         currentValue <= {DATA_W{1'b0}};\n         delay        <= {DELAY_W{1'b0}};\n         done         <= 1'b1;\n      end else if (run) begin\n         done  <= 1'b0;\n         delay <= delay0;\n      end else if (running) begin\n         if (|delay) delay <= delay - 1;\n\n         if (delay == 0) begin\n            currentValue <= in0;\n            done         <= 1'b1;\n         end\n      end\n   end\n\nendmodule\n\n\n\n\n\n")};
+String temp_97_CONTENT = {String("`timescale 1ns / 1ps\n\n`define COMPLEX_INTERFACE\n\nmodule OnlyOutputMem #(\n   parameter DATA_W        = 32,\n   parameter SIZE_W        = 32,\n   parameter DELAY_W       = 7,\n   parameter ADDR_W        = 12,\n   parameter PERIOD_W      = 10\n) (\n   //control\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n   input  disabled,\n\n   //databus interface\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  ADDR_W-1:0] addr,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output reg                rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   //input / output data\n   (* versat_latency = 2 *) output [DATA_W-1:0] out0,\n\n   // External memory\n   output [    ADDR_W-1:0] ext_2p_addr_out_0,\n   output [    ADDR_W-1:0] ext_2p_addr_in_0,\n   output                  ext_2p_write_0,\n   output                  ext_2p_read_0,\n   input  [DATA_W-1:0] ext_2p_data_in_0,\n   output [DATA_W-1:0] ext_2p_data_out_0,\n\n   // Configuration\n   input [ADDR_W-1:0] iterA,\n   input [PERIOD_W-1:0] perA,\n   input [PERIOD_W-1:0] dutyA,\n   input [ADDR_W-1:0] startA,\n   input [ADDR_W-1:0] shiftA,\n   input [ADDR_W-1:0] incrA,\n   input [DELAY_W-1:0] delay0\n);\n\n   wire we = |wstrb;\n\n   wire doneA;\n\n   //output databus\n   reg [DATA_W-1:0] outA_reg;\n\n   assign out0 = running ? outA_reg : 0;\n\n   assign done = doneA;\n\n   //port addresses and enables\n   wire [ADDR_W-1:0] addrA;\n   wire enA;\n   wire ready_int = ~rst;\n\n   //address generators\n\n   AddressGen #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(SIZE_W),\n      .DELAY_W(DELAY_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenA (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && !disabled),\n\n      //configurations \n      .per_i(perA),\n      .start_i (startA),\n      .incr_i  (incrA),\n      .delay_i (delay0),\n\n`ifdef COMPLEX_INTERFACE\n      .iter_i(iterA),\n      .duty_i      (dutyA),\n      .shift_i     (shiftA),\n`endif\n\n      //outputs \n      .valid_o(enA),\n      .ready_i(ready_int),\n      .addr_o (addrA),\n      .store_o(), // TODO: Handle duty\n\n      .done_o (doneA)\n   );\n   \n   //register mem inputs\n   reg [DATA_W-1:0] data_a_reg;\n   reg [ADDR_W-1:0] addr_a_reg;\n   reg we_a_reg;\n   always @(posedge clk,posedge rst) begin\n      if(rst) begin\n         data_a_reg <= 0;\n         addr_a_reg <= 0;\n         we_a_reg   <= 0;\n      end else begin\n         data_a_reg <= wdata;\n         addr_a_reg <= addr;\n         we_a_reg   <= valid & we;\n      end\n   end\n\n   assign ext_2p_addr_out_0 = addr_a_reg;\n   assign ext_2p_write_0    = we_a_reg;\n   assign ext_2p_data_out_0 = data_a_reg;\n\n   assign ext_2p_addr_in_0 = addrA;\n   assign ext_2p_read_0    = enA;\n   \n   //register mem outputs\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         outA_reg <= 0;\n      end else begin\n         outA_reg <= ext_2p_data_in_0;  //outA;\n      end\n   end\n\nendmodule\n\n`undef COMPLEX_INTERFACE\n")};
+String temp_98_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule Conditional (\n   input clk,\n   input rst,\n\n   input running,\n\n   input [31:0] in0,  // Selector\n   input [31:0] in1,\n   input [31:0] in2,\n\n   (* versat_latency = 1 *) output reg [31:0] out0\n);\n\nalways @(posedge clk, posedge rst) begin\n   if(rst) begin\n      out0[31:0] <= 0;\n   end else if (running) begin\n      if (|in0) begin\n         out0[31:0] <= in1[31:0];\n      end else begin\n         out0[31:0] <= in2[31:0];\n         end\n   end\nend\n\nendmodule\n")};
+String temp_99_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule TimedMux #(\n   parameter DATA_W = 32,\n   parameter DELAY_W = 32\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n   input run,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0,\n\n   input [DELAY_W-1:0] delay0\n);\n\n   reg [DELAY_W-1:0] delay;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         delay <= 0;\n      end else if (run) begin\n         delay <= delay0 + 1;\n      end else if (running && |delay) begin\n         delay <= delay - 1;\n         out0  <= in0;\n      end else if (running) begin\n         out0 <= in1;\n      end\n   end\n\nendmodule\n")};
+String temp_100_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule VWrite #(\n   parameter DATA_W     = 32,  // Internal datapath width\n   parameter ADDR_W     = 16,\n   parameter PERIOD_W   = 14,  // Must be 2 less than ADDR_W (boundary of 4) (for 32 bit DATA_W)\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,  // External databus width\n   parameter DELAY_W    = 7,\n   parameter LEN_W      = 16\n) (\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n\n   // Databus interface\n   input                     databus_ready_0,\n   output                    databus_valid_0,\n   output [  AXI_ADDR_W-1:0] databus_addr_0,\n   input  [  AXI_DATA_W-1:0] databus_rdata_0,\n   output [  AXI_DATA_W-1:0] databus_wdata_0,\n   output [AXI_DATA_W/8-1:0] databus_wstrb_0,\n   output [       LEN_W-1:0] databus_len_0,\n   input                     databus_last_0,\n\n   // input / output data\n   input [DATA_W-1:0] in0,\n\n   // External memory\n   output [    ADDR_W-1:0] ext_2p_addr_out_0,\n   output [    ADDR_W-1:0] ext_2p_addr_in_0,\n   output                  ext_2p_write_0,\n   output                  ext_2p_read_0,\n   input  [AXI_DATA_W-1:0] ext_2p_data_in_0,\n   output [    DATA_W-1:0] ext_2p_data_out_0,\n\n   // configurations\n   (* versat_stage=\"Write\" *) input [AXI_ADDR_W-1:0] ext_addr,\n\n   (* versat_stage=\"Write\" *) input [    ADDR_W-1:0] amount_minus_one,\n   (* versat_stage=\"Write\" *) input [     LEN_W-1:0] length,\n   (* versat_stage=\"Write\" *) input                  enabled,\n   (* versat_stage=\"Write\" *) input [AXI_ADDR_W-1:0] addr_shift,\n\n   input pingPong,\n\n   input [  ADDR_W-1:0] iter,\n   input [PERIOD_W-1:0] per,\n   input [PERIOD_W-1:0] duty,\n   input [  ADDR_W-1:0] start,\n   input [  ADDR_W-1:0] shift,\n   input [  ADDR_W-1:0] incr,\n\n   input [  ADDR_W-1:0] iter2,\n   input [PERIOD_W-1:0] per2,\n   input [  ADDR_W-1:0] shift2,\n   input [  ADDR_W-1:0] incr2,\n\n   input [  ADDR_W-1:0] iter3,\n   input [PERIOD_W-1:0] per3,\n   input [  ADDR_W-1:0] shift3,\n   input [  ADDR_W-1:0] incr3,\n\n   input          ignore_first,\n   input [20-1:0] extra_delay,\n\n   input [DELAY_W-1:0] delay0\n);\n   localparam DELAY_STORE_W = (DELAY_W > 20) ? DELAY_W : 20;\n   localparam EXTRA_DELAY_W = 20;\n\n   //reg  doneWrite; // Databus write part\n   wire transferDone;\n   reg  doneStore;\n   wire doneStore_int;\n   assign done = (transferDone & doneStore);\n\n   wire data_valid, data_ready;\n   wire [   AXI_DATA_W-1:0] data_data;\n   wire [DELAY_STORE_W-1:0] delay_store;\n\n   generate\n      if (DELAY_W < EXTRA_DELAY_W) begin : gen_delay_smaller\n         assign delay_store = {{(EXTRA_DELAY_W - DELAY_W) {1'b0}}, delay0} + extra_delay;\n      end else if (DELAY_W > EXTRA_DELAY_W) begin : gen_delay_bigger\n         assign delay_store = {{(DELAY_W - EXTRA_DELAY_W) {1'b0}}, extra_delay} + delay0;\n      end else begin : gen_delay_equal\n         assign delay_store = delay0 + extra_delay;\n      end\n   endgenerate\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         doneStore <= 1'b1;\n      end else if (run) begin\n         doneStore <= 1'b0;\n      end else if (running) begin\n         doneStore <= doneStore_int;\n      end\n   end\n\n   // Ping pong and related logic for the initial address\n   reg pingPongState;\n\n   // Ping pong \n   always @(posedge clk, posedge rst) begin\n      if (rst) pingPongState <= 0;\n      else if (run) pingPongState <= pingPong ? (!pingPongState) : 1'b0;\n   end\n\n   //wire [ADDR_W-1:0] start = {pingPong && !pingPongState , {(ADDR_W-1){1'b0}}};\n\n   // port addresses and enables\n   wire [ADDR_W-1:0] store_addr_temp;\n\n   // mem enables output by addr gen\n   wire store_en, do_store;\n\n   wire [DATA_W-1:0] store_data = in0;\n\n   reg  [ADDR_W-1:0] gen_addr_temp;\n   reg               gen_valid;\n   wire              gen_ready;\n\n   localparam OFFSET_TEMP = AXI_DATA_W / 8;\n   localparam [ADDR_W-1:0] OFFSET_W = OFFSET_TEMP[ADDR_W-1:0];\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         gen_addr_temp <= 0;\n      end else if(run && enabled && length != 0) begin\n         gen_addr_temp <= 0;\n         gen_valid     <= 1'b1;\n      end else begin\n         if (gen_valid && gen_ready) begin\n            gen_addr_temp <= gen_addr_temp + OFFSET_W;\n         end\n         if (!running) begin\n            gen_valid <= 0;\n         end\n      end\n   end\n\n   wire [ADDR_W-1:0] amount;\n   assign amount = amount_minus_one + 1'b1;\n\n   SuperAddress #(\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .LEN_W     (LEN_W),\n      .COUNT_W   (ADDR_W),\n      .ADDR_W    (ADDR_W),\n      .DATA_W    (DATA_W),\n      .PERIOD_W  (PERIOD_W),\n      .DELAY_W   (1)\n   ) writer (\n      .clk_i (clk),\n      .rst_i (rst),\n      .run_i (run && enabled && (length != 0)),\n      .done_o(transferDone),\n\n      .ignore_first_i(1'b0),\n\n      //configurations \n      .per_i  ({PERIOD_W{1'b0}}),\n      .delay_i(1'b0),\n      //.start_i (0),\n      .start_i(0),\n      .incr_i ({ADDR_W{1'b0}}),\n      .iter_i ({ADDR_W{1'b0}}),\n      .duty_i ({PERIOD_W{1'b0}}),\n      .shift_i({ADDR_W{1'b0}}),\n\n      .per2_i  ({PERIOD_W{1'b0}}),\n      .incr2_i ({ADDR_W{1'b0}}),\n      .iter2_i ({ADDR_W{1'b0}}),\n      .shift2_i({ADDR_W{1'b0}}),\n\n      .per3_i  ({PERIOD_W{1'b0}}),\n      .incr3_i ({ADDR_W{1'b0}}),\n      .iter3_i ({ADDR_W{1'b0}}),\n      .shift3_i({ADDR_W{1'b0}}),\n\n      .doneDatabus(),\n      .doneAddress(),\n\n      .valid_o(),\n      .ready_i(1'b1),\n      .addr_o (),\n      .store_o(),\n\n      .databus_ready(databus_ready_0),\n      .databus_valid(databus_valid_0),\n      .databus_addr (databus_addr_0),\n      .databus_len  (databus_len_0),\n      .databus_last (databus_last_0),\n\n      // Data interface\n      .data_valid_i(data_valid),\n      .data_ready_i(1'b1),\n      .reading     (1'b0),\n\n      .count_i        (amount),\n      .start_address_i(ext_addr),\n      .address_shift_i(addr_shift),\n      .databus_length (length)\n   );\n\n   assign data_ready      = databus_ready_0;\n   assign databus_wstrb_0 = ~0;\n   assign databus_wdata_0 = data_data;\n\n   wire [ADDR_W-1:0] gen_addr = {\n      pingPong ? !pingPongState : gen_addr_temp[ADDR_W-1], gen_addr_temp[ADDR_W-2:0]\n   };\n\n   AddressGen3 #(\n      .ADDR_W  (ADDR_W),\n      .DATA_W  (DATA_W),\n      .DELAY_W (DELAY_STORE_W),\n      .PERIOD_W(PERIOD_W)\n   ) addrgenStore (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run),\n\n      .ignore_first_i(ignore_first),\n\n      //configurations \n      .per_i  (per),\n      .delay_i(delay_store),\n      .start_i({1'b0, start[ADDR_W-2:0]}),\n      .incr_i (incr),\n\n      .iter_i (iter),\n      .duty_i (duty),\n      .shift_i(shift),\n\n      .per2_i  (per2),\n      .incr2_i (incr2),\n      .iter2_i (iter2),\n      .shift2_i(shift2),\n\n      .per3_i  (per3),\n      .incr3_i (incr3),\n      .iter3_i (iter3),\n      .shift3_i(shift3),\n\n      //outputs \n      .valid_o(store_en),\n      .ready_i(1'b1),\n      .addr_o (store_addr_temp),\n      .store_o(do_store),\n      .done_o (doneStore_int)\n   );\n\n   wire [ADDR_W-1:0] store_addr = {\n      pingPong ? pingPongState : store_addr_temp[ADDR_W-1], store_addr_temp[ADDR_W-2:0]\n   };\n\n   wire read_en;\n   wire [ADDR_W-1:0] read_addr;\n   wire [AXI_DATA_W-1:0] read_data;\n\n   MemoryReader #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(AXI_DATA_W)\n   ) reader (\n      // Slave\n      .s_valid_i(gen_valid),\n      .s_ready_o(gen_ready),\n      .s_addr_i (gen_addr),\n\n      // Master\n      .m_valid_o(data_valid),\n      .m_ready_i(data_ready),\n      .m_addr_o (),\n      .m_data_o (data_data),\n      .m_last_i (1'b0),\n\n      // Connect to memory\n      .mem_enable_o(read_en),\n      .mem_addr_o  (read_addr),\n      .mem_data_i  (read_data),\n\n      .force_reset_i(!running || run),\n\n      .clk_i(clk),\n      .rst_i(rst)\n   );\n\n   assign ext_2p_write_0    = store_en && do_store;\n   assign ext_2p_addr_out_0 = store_addr;\n   assign ext_2p_data_out_0 = store_data;\n\n   assign ext_2p_read_0     = read_en;\n   assign ext_2p_addr_in_0  = read_addr;\n   assign read_data         = ext_2p_data_in_0;\n\n   reg reportedA;\n   reg reportedB;\n   reg reportedC;\n\n   // Reports most common errors\n   always @(posedge clk) begin\n      if (run) begin\n         reportedA <= 1'b0;\n      end else if (pingPong && gen_addr_temp[ADDR_W-1] && reportedA == 1'b0) begin\n         $display(\"%m: Overflow of memory when using PingPong for reading\");\n         reportedA <= 1'b1;\n      end\n   end\n\n   always @(posedge clk) begin\n      if (run) begin\n         reportedB <= 1'b0;\n      end else if (pingPong && store_addr_temp[ADDR_W-1] && reportedB == 1'b0) begin\n         $display(\"%m: Overflow of write memory when using PingPong for outputting\");\n         reportedB <= 1'b1;\n      end\n   end\n\n   always @(posedge clk) begin\n      if (run) begin\n         reportedC <= 1'b0;\n      end else if (pingPong && start[ADDR_W-1] && reportedC == 1'b0) begin\n         $display(\"%m: Last bit of output start ignored when using PingPong\");\n         reportedC <= 1'b1;\n      end\n   end\n\nendmodule  // VWrite\n")};
+String temp_101_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule LookupTable #(\n   parameter DATA_W        = 32,\n   parameter SIZE_W        = 32,\n   parameter ADDR_W        = 8\n) (\n   //databus interface\n   input      [DATA_W/8-1:0] wstrb,\n   input      [  ADDR_W-1:0] addr,\n   input      [  DATA_W-1:0] wdata,\n   input                     valid,\n   output reg                rvalid,\n   output     [  DATA_W-1:0] rdata,\n\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 3 *) output reg [DATA_W-1:0] out0,\n   (* versat_latency = 3 *) output reg [DATA_W-1:0] out1,\n\n   output [ADDR_W-1:0] ext_dp_addr_0_port_0,\n   output [DATA_W-1:0] ext_dp_out_0_port_0,\n   input  [DATA_W-1:0] ext_dp_in_0_port_0,\n   output              ext_dp_enable_0_port_0,\n   output              ext_dp_write_0_port_0,\n\n   output [ADDR_W-1:0] ext_dp_addr_0_port_1,\n   output [DATA_W-1:0] ext_dp_out_0_port_1,\n   input  [DATA_W-1:0] ext_dp_in_0_port_1,\n   output              ext_dp_enable_0_port_1,\n   output              ext_dp_write_0_port_1,\n\n   input running,\n   input clk,\n   input rst\n);\n\n   assign rdata = 0;\n\n   reg [DATA_W-1:0] data;\n   reg              write;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         data     <= {DATA_W{1'b0}};\n         write    <= 1'b0;\n         rvalid   <= 1'b0;\n      end else begin\n         write  <= 1'b0;\n         rvalid <= 1'b0;\n\n         if (valid && wstrb == 0) begin\n            rvalid <= 1'b1;\n         end\n\n         if (valid && |wstrb) begin\n            data     <= wdata;\n            write    <= 1'b1;\n         end\n      end\n   end\n\n   assign ext_dp_out_0_port_0    = data;\n   assign ext_dp_enable_0_port_0 = 1'b1;\n   assign ext_dp_write_0_port_0  = write;\n\n   assign ext_dp_out_0_port_1    = 0;\n   assign ext_dp_enable_0_port_1 = 1'b1;\n   assign ext_dp_write_0_port_1  = 1'b0;\n\n   localparam DIFF = DATA_W / SIZE_W;\n   localparam DECISION_BIT_W = $clog2(DIFF);\n\n   reg [ADDR_W-1:0] addr_0_reg,addr_1_reg;\n\n   always @(posedge clk,posedge rst) begin\n      if(rst) begin\n         addr_0_reg <= 0;\n         addr_1_reg <= 0;\n      end else begin\n         if (valid && |wstrb) begin\n            addr_0_reg <= addr;\n         end else begin\n            addr_0_reg <= in0[ADDR_W-1:0];\n         end\n         addr_1_reg <= in1[ADDR_W-1:0];\n      end\n   end\n\n   assign ext_dp_addr_0_port_0 = addr_0_reg;\n   assign ext_dp_addr_0_port_1 = addr_1_reg;\n\n   wire [DATA_W-1:0] outA_int,outB_int;\n\n   generate\n      if (SIZE_W == DATA_W) begin\n         assign outA_int = ext_dp_in_0_port_0;\n         assign outB_int = ext_dp_in_0_port_1;\n      end else begin\n         reg [DECISION_BIT_W-1:0] sel_A, sel_B;\n         reg [DECISION_BIT_W-1:0] sel_A_reg, sel_B_reg;\n\n         always @(posedge clk, posedge rst) begin\n            if (rst) begin\n               sel_A <= 0;\n               sel_B <= 0;\n            end else begin\n               sel_A_reg <= in0[DECISION_BIT_W-1:0];\n               sel_B_reg <= in1[DECISION_BIT_W-1:0];\n               sel_A <= sel_A_reg;\n               sel_B <= sel_B_reg;\n            end\n         end\n\n         WideAdapter #(\n            .INPUT_W (DATA_W),\n            .SIZE_W  (SIZE_W),\n            .OUTPUT_W(DATA_W)\n         ) adapter_a (\n            .sel_i(sel_A),\n            .in_i (ext_dp_in_0_port_0),\n            .out_o(outA_int)\n         );\n\n         WideAdapter #(\n            .INPUT_W (DATA_W),\n            .SIZE_W  (SIZE_W),\n            .OUTPUT_W(DATA_W)\n         ) adapter_b (\n            .sel_i(sel_B),\n            .in_i (ext_dp_in_0_port_1),\n            .out_o(outB_int)\n         );\n      end\n   endgenerate\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         out0 <= 0;\n         out1 <= 0;\n      end else if (running) begin\n         out0 <= outA_int;\n         out1 <= outB_int;\n      end else begin\n         out0 <= 0;\n         out1 <= 0;\n      end\n   end\n\nendmodule\n")};
+String temp_102_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule VRead #(\n   parameter DATA_W     = 32,\n   parameter ADDR_W     = 18,\n   parameter PERIOD_W   = 16, // Must be 2 less than ADDR_W (boundary of 4) (for 32 bit DATA_W)\n   parameter AXI_ADDR_W = 32,\n   parameter AXI_DATA_W = 32,\n   parameter DELAY_W    = 7,\n   parameter LEN_W      = 16\n) (\n   input clk,\n   input rst,\n\n   input  running,\n   input  run,\n   output done,\n\n   // Databus interface\n   input                         databus_ready_0,\n   output                        databus_valid_0,\n   output     [  AXI_ADDR_W-1:0] databus_addr_0,\n   input      [  AXI_DATA_W-1:0] databus_rdata_0,\n   output     [  AXI_DATA_W-1:0] databus_wdata_0,\n   output     [AXI_DATA_W/8-1:0] databus_wstrb_0,\n   output     [       LEN_W-1:0] databus_len_0,\n   input                         databus_last_0,\n\n   // input / output data\n   (* versat_latency = 1 *) output [DATA_W-1:0] out0,\n\n   // External memory\n   output [    ADDR_W-1:0] ext_2p_addr_out_0,\n   output [    ADDR_W-1:0] ext_2p_addr_in_0,\n   output                  ext_2p_write_0,\n   output                  ext_2p_read_0,\n   input  [AXI_DATA_W-1:0] ext_2p_data_in_0,\n   output [AXI_DATA_W-1:0] ext_2p_data_out_0,\n\n   (* versat_stage=\"Read\" *) input [AXI_ADDR_W-1:0] ext_addr,\n   (* versat_stage=\"Read\" *) input                  pingPong,\n\n   (* versat_stage=\"Read\" *) input [    ADDR_W-1:0] amount_minus_one,\n   (* versat_stage=\"Read\" *) input [     LEN_W-1:0] length,\n   (* versat_stage=\"Read\" *) input [AXI_ADDR_W-1:0] addr_shift,\n\n   (* versat_stage=\"Read\" *) input enabled,\n\n   input [  ADDR_W-1:0] iter,\n   input [PERIOD_W-1:0] per,\n   input [PERIOD_W-1:0] duty,\n   input [  ADDR_W-1:0] start,\n   input [  ADDR_W-1:0] shift,\n   input [  ADDR_W-1:0] incr,\n   input [  ADDR_W-1:0] iter2,\n   input [PERIOD_W-1:0] per2,\n   input [  ADDR_W-1:0] shift2,\n   input [  ADDR_W-1:0] incr2,\n   input [  ADDR_W-1:0] iter3,\n   input [PERIOD_W-1:0] per3,\n   input [  ADDR_W-1:0] shift3,\n   input [  ADDR_W-1:0] incr3,\n\n   input [DELAY_W-1:0]  extra_delay,\n   input                ignore_first,\n\n   input [DELAY_W-1:0] delay0\n);\n\n   //assign databus_wdata_0 = 0;\n   //assign databus_wstrb_0 = 0;\n   //assign databus_len_0   = length;\n\n   // output databus\n   wire              transferDone;\n   reg               doneOutput;\n   wire              doneOutput_int;\n\n   assign done = (transferDone  & doneOutput);\n\n   wire data_valid,data_ready;\n   wire [AXI_DATA_W-1:0] data_data;\n\n   always @(posedge clk, posedge rst) begin\n      if (rst) begin\n         doneOutput <= 1'b1;\n      end else if (run) begin\n         doneOutput <= 1'b0;\n      end else begin\n         if (doneOutput_int) doneOutput <= 1'b1;\n      end\n   end\n\n   // Ping pong and related logic for the initial address\n   reg pingPongState;\n\n   // port addresses and enables\n   wire [ADDR_W-1:0] output_addr_temp;\n\n   // Ping pong \n   always @(posedge clk, posedge rst) begin\n      if (rst) pingPongState <= 0;\n      else if (run) pingPongState <= pingPong ? (!pingPongState) : 1'b0;\n   end\n\n   wire [ADDR_W-1:0] amount;\n   assign amount = amount_minus_one + 1'b1;\n   \n   //wire [ADDR_W-1:0] gen_addr_temp;\n   //wire gen_valid, gen_ready;\n\n   reg [ADDR_W-1:0] gen_addr_temp;\n   reg gen_valid;\n   wire gen_ready;\n\n   localparam OFFSET_TEMP = AXI_DATA_W / 8;\n   localparam [ADDR_W-1:0] OFFSET_W = OFFSET_TEMP[ADDR_W-1:0];\n\n   always @(posedge clk,posedge rst) begin\n      if(rst) begin\n         gen_addr_temp <= 0;\n      end else if(run && enabled && length != 0) begin\n         gen_addr_temp <= 0;\n         gen_valid <= 1'b1;\n      end else begin\n         if(gen_valid && gen_ready) begin\n            gen_addr_temp <= gen_addr_temp + OFFSET_W;\n         end\n         if(!running) begin\n            gen_valid <= 0;\n         end\n      end\n   end\n\n   SuperAddress #(\n      .AXI_ADDR_W(AXI_ADDR_W),\n      .LEN_W(LEN_W),\n      .COUNT_W(ADDR_W),\n      .ADDR_W(ADDR_W),\n      .DATA_W(DATA_W),\n      .PERIOD_W(PERIOD_W),\n      .DELAY_W(1)\n      ) reader (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run && enabled && length != 0),\n      .done_o(transferDone),\n\n      .ignore_first_i(1'b0),\n\n      .per_i({PERIOD_W{1'b0}}),\n      .delay_i (1'b0),\n      .start_i ({ADDR_W{1'b0}}),\n      .incr_i  ({ADDR_W{1'b0}}),\n\n      .iter_i({ADDR_W{1'b0}}),\n      .duty_i      ({PERIOD_W{1'b0}}),\n      .shift_i     ({ADDR_W{1'b0}}),\n\n      .per2_i({PERIOD_W{1'b0}}),\n      .incr2_i({ADDR_W{1'b0}}),\n      .iter2_i({ADDR_W{1'b0}}),\n      .shift2_i({ADDR_W{1'b0}}),\n\n      .per3_i({PERIOD_W{1'b0}}),\n      .incr3_i({ADDR_W{1'b0}}),\n      .iter3_i({ADDR_W{1'b0}}),\n      .shift3_i({ADDR_W{1'b0}}),\n\n      .doneDatabus(),\n      .doneAddress(),\n\n      //outputs \n      //.valid_o(gen_valid), // gen_valid\n      //.ready_i(gen_ready), // gen_ready\n      //.addr_o (gen_addr_temp), // gen_addr_temp\n\n      .valid_o(),\n      .ready_i(1'b1),\n      .addr_o (),\n\n      .store_o(),\n\n      .databus_ready(databus_ready_0),\n      .databus_valid(databus_valid_0),\n      .databus_addr(databus_addr_0),\n      .databus_len(databus_len_0),\n      .databus_last(databus_last_0),\n\n      // Data interface\n      .data_valid_i(1'b0),\n      .data_ready_i(data_ready),\n      .reading(1'b1),\n\n      .count_i(amount),\n      .start_address_i(ext_addr),\n      .address_shift_i(addr_shift),\n      .databus_length(length)\n   );\n\nassign databus_wdata_0 = 0;\nassign databus_wstrb_0 = 0;\nassign data_valid = databus_ready_0;\nassign data_data = databus_rdata_0;\n\n   wire [ADDR_W-1:0] gen_addr = {pingPong ? !pingPongState : gen_addr_temp[ADDR_W-1],gen_addr_temp[ADDR_W-2:0]};\n\n   // mem enables output by addr gen\n   wire output_enabled;\n\n   AddressGen3 #(\n      .ADDR_W(ADDR_W),\n      .DATA_W(DATA_W),\n      .PERIOD_W(PERIOD_W),\n      .DELAY_W(DELAY_W)\n   ) addrgenOutput (\n      .clk_i(clk),\n      .rst_i(rst),\n      .run_i(run),\n\n      .ignore_first_i(ignore_first),\n\n      //configurations \n      .per_i(per),\n      .delay_i (delay0 + extra_delay),\n      .start_i ({1'b0,start[ADDR_W-2:0]}),\n      .incr_i  (incr),\n\n      .iter_i(iter),\n      .duty_i      (duty),\n      .shift_i     (shift),\n\n      .per2_i(per2),\n      .incr2_i(incr2),\n      .iter2_i(iter2),\n      .shift2_i(shift2),\n\n      .per3_i(per3),\n      .incr3_i(incr3),\n      .iter3_i(iter3),\n      .shift3_i(shift3),\n\n      //outputs \n      .valid_o(output_enabled),\n      .ready_i(1'b1),\n      .addr_o (output_addr_temp),\n      .store_o(),\n      .done_o (doneOutput_int)\n   );\n\n   wire [ADDR_W-1:0] true_output_addr = output_addr_temp;\n\n   /*\n      Basically, I need to have VRead simulate a initial loop of 17 but then go back to looping 16.\n\n   */\n\n   wire [ADDR_W-1:0] output_addr = {pingPong ? pingPongState : true_output_addr[ADDR_W-1],true_output_addr[ADDR_W-2:0]};\n\n   wire                  write_en;\n   wire [    ADDR_W-1:0] write_addr;\n   wire [AXI_DATA_W-1:0] write_data;\n\n   JoinTwoHandshakes #(\n      .FIRST_DATA_W(ADDR_W),\n      .SECOND_DATA_W(AXI_DATA_W)\n   ) writer (\n      .first_valid_i(gen_valid),\n      .first_ready_o(gen_ready),\n      .first_data_i(gen_addr),\n\n      .second_valid_i(data_valid),\n      .second_ready_o(data_ready),\n      .second_data_i(data_data),\n\n      .result_valid_o(write_en),\n      .result_ready_i(1'b1),\n      .result_first_data_o(write_addr),\n      .result_second_data_o(write_data),\n\n      .forceReset(!running || run),\n\n      .clk_i(clk),\n      .rst_i(rst)\n   );\n\n   localparam DIFF = AXI_DATA_W / DATA_W;\n   localparam DECISION_BIT_W = $clog2(DIFF);\n   localparam DECISION_BIT_START = $clog2(DATA_W / 8);\n\n   generate\n      if (AXI_DATA_W > DATA_W) begin\n         reg [DECISION_BIT_W-1:0] sel_0;  // Matches addr_0_port_0\n         always @(posedge clk, posedge rst) begin\n            if (rst) begin\n               sel_0 <= 0;\n            end else begin\n               sel_0 <= output_addr[DECISION_BIT_START+:DECISION_BIT_W];\n            end\n         end\n\n         WideAdapter #(\n            .INPUT_W (AXI_DATA_W),\n            .OUTPUT_W(DATA_W),\n            .SIZE_W  (DATA_W)\n         ) adapter (\n            .sel_i(sel_0),\n            .in_i (ext_2p_data_in_0),\n            .out_o(out0)\n         );\n      end else begin\n         assign out0 = ext_2p_data_in_0;\n      end  // if(AXI_DATA_W > DATA_W)\n   endgenerate\n\n   assign ext_2p_write_0    = write_en;\n   assign ext_2p_addr_out_0 = write_addr;\n   assign ext_2p_data_out_0 = write_data;\n\n   assign ext_2p_read_0     = output_enabled;\n   assign ext_2p_addr_in_0  = output_addr;\n\n   reg reportedA;\n   reg reportedB;\n   reg reportedC;\n\n   // Reports most common errors\n   always @(posedge clk) begin\n      if(run) begin\n         reportedA <= 1'b0;\n      end else if(pingPong && gen_addr_temp[ADDR_W-1] && reportedA == 1'b0) begin\n         $display(\"%m: Overflow of memory when using PingPong for reading\");\n         reportedA <= 1'b1;\n      end\n   end\n\n   always @(posedge clk) begin\n      if(run) begin\n         reportedB <= 1'b0;\n      end else if(pingPong && true_output_addr[ADDR_W-1] && reportedB == 1'b0) begin\n         $display(\"%m: Overflow of write memory when using PingPong for outputting\");\n         reportedB <= 1'b1;\n      end\n   end\n\n   always @(posedge clk) begin\n      if(run) begin\n         reportedC <= 1'b0;\n      end else if(pingPong && start[ADDR_W-1] && reportedC == 1'b0) begin\n         $display(\"%m: Last bit of output start ignored when using PingPong\");\n         reportedC <= 1'b1;\n      end\n   end\n\n\nendmodule\n")};
+String temp_103_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule FixedBuffer #(\n   parameter DATA_W = 32,\n   parameter AMOUNT = 0\n) (\n   //control\n   input clk,\n   input rst,\n\n   input running,\n\n   //input / output data\n   input [DATA_W-1:0] in0,\n\n   (* versat_latency = 1 *) output reg [DATA_W-1:0] out0\n);\n\n   generate\n      if (AMOUNT == 0) begin\n         always @(posedge clk, posedge rst) begin\n            if (rst) begin\n               out0 <= {DATA_W{1'b0}};\n            end else if (running) begin\n               out0 <= in0;\n            end else begin\n               out0 <= {DATA_W{1'b0}};\n            end\n         end\n      end else begin\n         integer        i;\n         genvar         ii;\n         reg     [DATA_W-1:0] bufferData[AMOUNT-1:0];\n         reg     [DATA_W-1:0] bufferNextData[AMOUNT-1:0];\n\n         // Looks strange but putting everything inside a always @(posedge clk,posedge rst) block was giving a verilator error in the lines bufferData[i] <= bufferData[i+1].\n         // Somehow putting this logic as a non-delayed assignment and generating AMOUNT always cases seems to be accepted fine by the tools.\n         // NOTE: check verilator documentation about UNOPTFLAT: https://verilator.org/guide/latest/warnings.html?highlight=unoptflat#cmdoption-arg-UNOPTFLAT\n         always @* begin\n            for (i = 0; i < AMOUNT - 1; i = i + 1) begin\n               bufferNextData[i] = bufferData[i+1];\n            end\n            bufferNextData[AMOUNT-1] = in0;\n         end\n\n         for(ii = 0; ii < AMOUNT; ii = ii + 1) begin : bufferAssigns\n            always @(posedge clk,posedge rst) begin\n               if (rst) begin\n                  bufferData[ii] <= {DATA_W{1'b0}};\n               end else if (running) begin\n                  bufferData[ii] <= bufferNextData[ii];\n               end else begin\n                  bufferData[ii] <= {DATA_W{1'b0}};\n               end\n            end\n         end\n\n         always @(posedge clk, posedge rst) begin\n            if (rst) begin\n               out0 <= {DATA_W{1'b0}};\n            end else if (running) begin\n               out0 <= bufferData[0];\n            end else begin\n               out0 <= {DATA_W{1'b0}};\n            end\n         end\n      end\n   endgenerate\n\nendmodule\n")};
+String temp_104_CONTENT = {String("`timescale 1ns / 1ps\n\nmodule CombMux2 #(\n   parameter DATA_W = 32\n) (\n   //input / output data\n   input [DATA_W-1:0] in0,\n   input [DATA_W-1:0] in1,\n\n   (* versat_latency = 0 *) output [DATA_W-1:0] out0,\n\n   input sel\n);\n\n   assign out0 = (sel ? in1 : in0);\n\nendmodule\n")};
+FileContent defaultVerilogFiles_Raw[] = {  {String("BurstAlign.v"),String("./hardware/src"),String(""),temp_34_CONTENT},  {String("SimpleAXIToAXIWrite.v"),String("./hardware/src"),String(""),temp_35_CONTENT},  {String("MemoryWriter.v"),String("./hardware/src"),String(""),temp_36_CONTENT},  {String("SimpleDMA.v"),String("./hardware/src"),String(""),temp_37_CONTENT},  {String("AXITransferController.v"),String("./hardware/src"),String(""),temp_38_CONTENT},  {String("iob_reg_r.v"),String("./hardware/src"),String(""),temp_39_CONTENT},  {String("iob_reg_conf.vh"),String("./hardware/src"),String(""),temp_40_CONTENT},  {String("JoinTwoSimple.v"),String("./hardware/src"),String(""),temp_41_CONTENT},  {String("iob_reg_re.v"),String("./hardware/src"),String(""),temp_42_CONTENT},  {String("CountNLoops.v"),String("./hardware/src"),String(""),temp_43_CONTENT},  {String("AddressGen2.v"),String("./hardware/src"),String(""),temp_44_CONTENT},  {String("iob_ram_2p.v"),String("./hardware/src"),String(""),temp_45_CONTENT},  {String("iob_fifo_sync.v"),String("./hardware/src"),String(""),temp_46_CONTENT},  {String("SimpleAXIToAXI.v"),String("./hardware/src"),String(""),temp_47_CONTENT},  {String("JoinTwoHandshakes.v"),String("./hardware/src"),String(""),temp_48_CONTENT},  {String("HandshakeBuffer.v"),String("./hardware/src"),String(""),temp_49_CONTENT},  {String("my_2p_asym_ram.v"),String("./hardware/src"),String(""),temp_50_CONTENT},  {String("SimpleAXIToAXIRead.v"),String("./hardware/src"),String(""),temp_51_CONTENT},  {String("MemoryReader.v"),String("./hardware/src"),String(""),temp_52_CONTENT},  {String("SkidBuffer.v"),String("./hardware/src"),String(""),temp_53_CONTENT},  {String("SimHelper_DatabusMem.v"),String("./hardware/src"),String(""),temp_54_CONTENT},  {String("iob_utils.vh"),String("./hardware/src"),String(""),temp_55_CONTENT},  {String("VersatAxiDelay.v"),String("./hardware/src"),String(""),temp_56_CONTENT},  {String("versat_counter.v"),String("./hardware/src"),String(""),temp_57_CONTENT},  {String("DelayCalc.v"),String("./hardware/src"),String(""),temp_58_CONTENT},  {String("BurstSplit.v"),String("./hardware/src"),String(""),temp_59_CONTENT},  {String("SuperAddress.v"),String("./hardware/src"),String(""),temp_60_CONTENT},  {String("iob_asym_converter.v"),String("./hardware/src"),String(""),temp_61_CONTENT},  {String("MemoryScanner.v"),String("./hardware/src"),String(""),temp_62_CONTENT},  {String("WideAdapter.v"),String("./hardware/src"),String(""),temp_63_CONTENT},  {String("AddressGen.v"),String("./hardware/src"),String(""),temp_64_CONTENT},  {String("MuxNative.v"),String("./hardware/src"),String(""),temp_65_CONTENT},  {String("ZeroExtend.v"),String("./hardware/src"),String(""),temp_66_CONTENT},  {String("AddressGen3.v"),String("./hardware/src"),String(""),temp_67_CONTENT},  {String("iob_reg.v"),String("./hardware/src"),String(""),temp_68_CONTENT},  {String("my_dp_asym_ram.v"),String("./hardware/src"),String(""),temp_69_CONTENT},  {String("my_iob_dp_ram.v"),String("./hardware/src"),String(""),temp_70_CONTENT},  {String("Const.v"),String("./hardware/src/units"),String(""),temp_71_CONTENT},  {String("LookupTableRead.v"),String("./hardware/src/units"),String(""),temp_72_CONTENT},  {String("ReadWriteMem.v"),String("./hardware/src/units"),String(""),temp_73_CONTENT},  {String("PipelineRegister.v"),String("./hardware/src/units"),String(""),temp_74_CONTENT},  {String("Merge2.v"),String("./hardware/src/units"),String(""),temp_75_CONTENT},  {String("DebugReadMem.v"),String("./hardware/src/units"),String(""),temp_76_CONTENT},  {String("CombMux8.v"),String("./hardware/src/units"),String(""),temp_77_CONTENT},  {String("Mem.v"),String("./hardware/src/units"),String(""),temp_78_CONTENT},  {String("Mux8.v"),String("./hardware/src/units"),String(""),temp_79_CONTENT},  {String("Generator.v"),String("./hardware/src/units"),String(""),temp_80_CONTENT},  {String("SwapEndian.v"),String("./hardware/src/units"),String(""),temp_81_CONTENT},  {String("Buffer.v"),String("./hardware/src/units"),String(""),temp_82_CONTENT},  {String("TestConst.v"),String("./hardware/src/units"),String(""),temp_83_CONTENT},  {String("DebugWriteMem.v"),String("./hardware/src/units"),String(""),temp_84_CONTENT},  {String("Reg.v"),String("./hardware/src/units"),String(""),temp_85_CONTENT},  {String("StridedMerge.v"),String("./hardware/src/units"),String(""),temp_86_CONTENT},  {String("Equality.v"),String("./hardware/src/units"),String(""),temp_87_CONTENT},  {String("Counter.v"),String("./hardware/src/units"),String(""),temp_88_CONTENT},  {String("Muladd.v"),String("./hardware/src/units"),String(""),temp_89_CONTENT},  {String("RegFile.v"),String("./hardware/src/units"),String(""),temp_90_CONTENT},  {String("Merge.v"),String("./hardware/src/units"),String(""),temp_91_CONTENT},  {String("CombMux4.v"),String("./hardware/src/units"),String(""),temp_92_CONTENT},  {String("Mul.v"),String("./hardware/src/units"),String(""),temp_93_CONTENT},  {String("Mux2.v"),String("./hardware/src/units"),String(""),temp_94_CONTENT},  {String("DoneCycle.v"),String("./hardware/src/units"),String(""),temp_95_CONTENT},  {String("Store.v"),String("./hardware/src/units"),String(""),temp_96_CONTENT},  {String("OnlyOutputMem.v"),String("./hardware/src/units"),String(""),temp_97_CONTENT},  {String("Conditional.v"),String("./hardware/src/units"),String(""),temp_98_CONTENT},  {String("TimedMux.v"),String("./hardware/src/units"),String(""),temp_99_CONTENT},  {String("VWrite.v"),String("./hardware/src/units"),String(""),temp_100_CONTENT},  {String("LookupTable.v"),String("./hardware/src/units"),String(""),temp_101_CONTENT},  {String("VRead.v"),String("./hardware/src/units"),String(""),temp_102_CONTENT},  {String("FixedBuffer.v"),String("./hardware/src/units"),String(""),temp_103_CONTENT},  {String("CombMux2.v"),String("./hardware/src/units"),String(""),temp_104_CONTENT}};
+Array<FileContent> defaultVerilogFiles = {defaultVerilogFiles_Raw,ARRAY_SIZE(defaultVerilogFiles_Raw)};
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+// File auto generated by embedData tool
+#include "utilsCore.hpp"
+
+// Structs definitions
+struct AddressGenBaseParameters{
+  String start;
+  String duty;
+  String per;
+  String incr;
+  String iter;
+  String shift;
+};
+extern Array<String> META_AddressGenBaseParameters_Members;
+struct AddressVParameters{
+  String ext_addr;
+  String length;
+  String amount_minus_one;
+  String extra_delay;
+  String addr_shift;
+  String enabled;
+  String pingPong;
+  String start;
+  String duty;
+  String per;
+  String incr;
+  String iter;
+  String shift;
+};
+extern Array<String> META_AddressVParameters_Members;
+struct AddressMemParameters{
+  String iterA;
+  String perA;
+  String dutyA;
+  String startA;
+  String shiftA;
+  String incrA;
+  String reverseA;
+  String extA;
+  String in0_wr;
+  String iterB;
+  String perB;
+  String dutyB;
+  String startB;
+  String shiftB;
+  String incrB;
+  String reverseB;
+  String extB;
+  String in1_wr;
+};
+extern Array<String> META_AddressMemParameters_Members;
+// Enum definition
+enum AddressGenType{
+  AddressGenType_MEM = 1,
+  AddressGenType_READ = 2,
+  AddressGenType_GEN = 3
+};
+String META_Repr(AddressGenType val);
+static const AddressGenType AddressGenTypes[] = {AddressGenType_MEM,AddressGenType_READ,AddressGenType_GEN};
+enum MergeModifier{
+  MergeModifier_NONE = 0x0,
+  MergeModifier_NO_UNIT_MERGED = 0x1
+};
+String META_Repr(MergeModifier val);
+static const MergeModifier MergeModifiers[] = {MergeModifier_NONE,MergeModifier_NO_UNIT_MERGED};
+enum ConstructType{
+  ConstructType_MODULE,
+  ConstructType_MERGE,
+  ConstructType_ITERATIVE,
+  ConstructType_ADDRESSGEN
+};
+String META_Repr(ConstructType val);
+static const ConstructType ConstructTypes[] = {ConstructType_MODULE,ConstructType_MERGE,ConstructType_ITERATIVE,ConstructType_ADDRESSGEN};
+enum VersatRegister{
+  VersatRegister_Control,
+  VersatRegister_DmaInternalAddress,
+  VersatRegister_DmaExternalAddress,
+  VersatRegister_DmaTransferLength,
+  VersatRegister_DmaControl,
+  VersatRegister_Debug,
+  VersatRegister_ProfileControl,
+  VersatRegister_ProfileRunCount,
+  VersatRegister_ProfileRunCount2,
+  VersatRegister_ProfileCyclesSinceLastReset,
+  VersatRegister_ProfileCyclesSinceLastReset2,
+  VersatRegister_ProfileRunningCycles,
+  VersatRegister_ProfileRunningCycles2,
+  VersatRegister_ProfileDatabusValid,
+  VersatRegister_ProfileDatabusValid2,
+  VersatRegister_ProfileDatabusValidAndReady,
+  VersatRegister_ProfileDatabusValidAndReady2,
+  VersatRegister_ProfileConfigurationsSet,
+  VersatRegister_ProfileConfigurationsSet2,
+  VersatRegister_ProfileConfigurationsSetWhileRunning,
+  VersatRegister_ProfileConfigurationsSetWhileRunning2
+};
+String META_Repr(VersatRegister val);
+static const VersatRegister VersatRegisters[] = {VersatRegister_Control,VersatRegister_DmaInternalAddress,VersatRegister_DmaExternalAddress,VersatRegister_DmaTransferLength,VersatRegister_DmaControl,VersatRegister_Debug,VersatRegister_ProfileControl,VersatRegister_ProfileRunCount,VersatRegister_ProfileRunCount2,VersatRegister_ProfileCyclesSinceLastReset,VersatRegister_ProfileCyclesSinceLastReset2,VersatRegister_ProfileRunningCycles,VersatRegister_ProfileRunningCycles2,VersatRegister_ProfileDatabusValid,VersatRegister_ProfileDatabusValid2,VersatRegister_ProfileDatabusValidAndReady,VersatRegister_ProfileDatabusValidAndReady2,VersatRegister_ProfileConfigurationsSet,VersatRegister_ProfileConfigurationsSet2,VersatRegister_ProfileConfigurationsSetWhileRunning,VersatRegister_ProfileConfigurationsSetWhileRunning2};
+// Table definition
+struct AddressGenWireNames_GenType{
+  AddressGenType type;
+  Array<String> names;
+};
+struct ProfilingVersatRegisters_GenType{
+  VersatRegister t;
+};
+// Arrays
+extern Array<String> AddressGenExtraFormat;
+extern Array<String> AddressGenMemExtraFormat;
+// Tables
+extern Array<AddressGenWireNames_GenType> AddressGenWireNames;
+extern Array<ProfilingVersatRegisters_GenType> ProfilingVersatRegisters;
+// Define Maps (the arrays store the data, not the keys)
+#define VERSAT_LATENCY "versat_latency"
+#define VERSAT_STATIC "versat_static"
+#define VERSAT_STAGE "versat_stage"
+extern Array<String> possibleAttributes;
+// Normal Maps
+Opt<String> META_addressGenType_Map(AddressGenType val);
+Opt<AddressGenType> META_addressGenType_ReverseMap(String val);
+Opt<String> META_mergeModifiers_Map(MergeModifier val);
+Opt<MergeModifier> META_mergeModifiers_ReverseMap(String val);
+// File content
+extern String META_ExtractVerilatedSignals_Content;
+extern String META_GetVerilatorRoot_Content;
+extern String META_HeaderTemplate_Content;
+extern String META_MakefileTemplate_Content;
+extern String META_TopInstanceTemplate_Content;
+extern String META_WrapperTemplate_Content;
+extern String META_VersatTemplate_Content;
+extern String META_FirmwareTemplate_Content;
+struct FileContent{
+  String fileName;
+  // Without filename
+  String originalRelativePath;
+  String commonFolder;
+  String content;
+};
+extern Array<FileContent> defaultVerilogUnits;
+extern Array<FileContent> defaultVerilogFiles;
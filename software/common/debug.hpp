@@ -13,6 +13,9 @@ extern bool currentlyDebugging;
 #define debugRegion() if(debugFlag)
 #define debugRegionIf(COND) if(debugFlag && (COND))
 
+// Self tests (versat --self-test) count the checks that fail and report where they are
+#define TEST_CHECK(FAILED,COND) if(!(COND)){printf("  Check failed at %s:%d: %s\n",__FILE__,__LINE__,#COND); (FAILED) += 1;}
+
 typedef void (*SignalHandler)(int sig);
 
 bool CurrentlyDebugging();
@@ -1,6 +1,15 @@
 #include "filesystem.hpp"
 #include "utils.hpp"
 
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Files can be opened by multiple threads at the same time
+static pthread_mutex_t storeFileInfoMutex = PTHREAD_MUTEX_INITIALIZER;
 static Arena storeFileInfoArena = {};
 static ArenaList<FileInfo>* storeFileInfo;
 
@@ -15,20 +24,23 @@ const char* FilePurpose_Name(FilePurpose p){
   case FilePurpose_MISC: return "MISC";
   case FilePurpose_DEBUG_INFO: return "DEBUG_INFO";
   case FilePurpose_READ_CONTENT: return "READ_CONTENT";
+  case FilePurpose_CACHE: return "CACHE";
   } END_SWITCH()
   NOT_POSSIBLE();
 }
 
+static void RemoveTemporaryFiles();
+static bool IsGeneratedFile(FilePurpose purpose);
+
 static void CheckOrInitArena(){
   if(storeFileInfoArena.mem == nullptr){
     storeFileInfoArena = InitArena(Megabyte(1)); // Simple and effective, more robust code would probably change to a growable arena or something similar.
     storeFileInfo = PushArenaList<FileInfo>(&storeFileInfoArena);
+    atexit(RemoveTemporaryFiles);
   }
 }
 
 FILE* OpenFile(String filepath,const char* mode,FilePurpose purpose){
-  CheckOrInitArena();
-
   char pathBuffer[4096]; // Because C calls require null terminated strings, need to copy to some space to append null terminator
 
   if(filepath.size >= 4095){
@@ -55,17 +67,191 @@ FILE* OpenFile(String filepath,const char* mode,FilePurpose purpose){
 
   Assert(fileMode);
   
-  FILE* file = fopen(pathBuffer,mode);
+  bool generated = (fileMode == FileOpenMode_WRITE && IsGeneratedFile(purpose));
 
+  FILE* file = nullptr;
+  String temporaryPath = {};
+  pthread_mutex_lock(&storeFileInfoMutex);
+  CheckOrInitArena();
+  if(generated){
+    temporaryPath = PushString(&storeFileInfoArena,"%s.versat_tmp",pathBuffer);
+    file = fopen(temporaryPath.data,mode);
+  } else {
+    file = fopen(pathBuffer,mode);
+  }
+  
   FileInfo* info = storeFileInfo->PushElem();
   info->filepath = PushString(&storeFileInfoArena,"%s",pathBuffer); // Use pathBuffer instead of filepath to make sure that we got the actual path used for the call
+  info->temporaryPath = temporaryPath;
   info->mode = fileMode;
   info->purpose = purpose;
   info->wasOpenSucessful = (file != nullptr);
+  pthread_mutex_unlock(&storeFileInfoMutex);
 
   return file;
 }
 
 Array<FileInfo> CollectAllFilesInfo(Arena* out){
+  if(storeFileInfo == nullptr){
+    return {};
+  }
   return PushArrayFromList(out,storeFileInfo);
 }
+
+static bool IsGeneratedFile(FilePurpose purpose){
+  FULL_SWITCH(purpose){
+  case FilePurpose_VERILOG_COMMON_CODE:
+  case FilePurpose_VERILOG_CODE:
+  case FilePurpose_VERILOG_INCLUDE:
+  case FilePurpose_MAKEFILE:
+  case FilePurpose_SOFTWARE:
+  case FilePurpose_SCRIPT:
+    return true;
+  case FilePurpose_MISC:
+  case FilePurpose_READ_CONTENT:
+  case FilePurpose_DEBUG_INFO:
+  case FilePurpose_CACHE:
+    return false;
+  } END_SWITCH()
+  NOT_POSSIBLE();
+}
+
+// Files are read directly, otherwise they would be stored as opened by the program
+static Opt<String> ReadEntireFile(const char* filepath,Arena* out){
+  FILE* file = fopen(filepath,"r");
+  if(!file){
+    return {};
+  }
+  DEFER_CLOSE_FILE(file);
+
+  // Directories can also be opened
+  struct stat info = {};
+  if(fstat(fileno(file),&info) != 0 || !S_ISREG(info.st_mode)){
+    return {};
+  }
+
+  long int size = GetFileSize(file);
+  Byte* mem = PushBytes(out,size);
+  if((long int) fread(mem,sizeof(Byte),size,file) != size){
+    return {};
+  }
+
+  String res = {};
+  res.data = (const char*) mem;
+  res.size = size;
+  return res;
+}
+
+// Temporary files are left behind if the program exits before committing (errors in the middle of generation)
+static void RemoveTemporaryFiles(){
+  if(storeFileInfo == nullptr){
+    return;
+  }
+
+  for(FileInfo info : storeFileInfo){
+    if(!Empty(info.temporaryPath)){
+      remove(StaticFormat("%.*s",UN(info.temporaryPath)));
+    }
+  }
+}
+
+GeneratedFilesReport CommitGeneratedFiles(String manifestPath,Arena* out){
+  TEMP_REGION(temp,out);
+
+  GeneratedFilesReport report = {};
+  ArenaList<String>* stale = PushArenaList<String>(temp);
+  
+  Array<FileInfo> files = CollectAllFilesInfo(temp);
+  Hashmap<String,u64>* generated = PushHashmap<String,u64>(temp,files.size);
+  for(FileInfo info : files){
+    if(Empty(info.temporaryPath)){
+      continue;
+    }
+
+    String filepath = PushString(temp,"%.*s",UN(info.filepath));
+    const char* temporaryPath = StaticFormat("%.*s",UN(info.temporaryPath));
+    
+    // Same file opened multiple times, only the last content remains and it was already committed
+    Opt<String> content = ReadEntireFile(temporaryPath,temp);
+    if(!content.has_value()){
+      continue;
+    }
+
+    Opt<String> previous = ReadEntireFile(filepath.data,temp);
+    if(previous.has_value() && CompareString(previous.value(),content.value())){
+      remove(temporaryPath);
+      report.unchanged += 1;
+    } else if(rename(temporaryPath,filepath.data) != 0){
+      // The file keeps its previous content, so it must not be recorded as generated
+      printf("Error: could not write generated file %s: %s\n",filepath.data,strerror(errno));
+      remove(temporaryPath);
+      report.failed += 1;
+      continue;
+    } else {
+      report.written += 1;
+    }
+
+    generated->Insert(filepath,StableHashString(content.value()));
+  }
+
+  const char* manifest = StaticFormat("%.*s",UN(manifestPath));
+  Opt<String> previousManifest = ReadEntireFile(manifest,temp);
+  if(previousManifest.has_value()){
+    for(String line : Split(previousManifest.value(),'\n',temp)){
+      // Lines are "<hash> <path>"
+      if(line.size <= 17){
+        continue;
+      }
+      String filepath = Offset(line,17);
+      
+      if(!generated->Exists(filepath)){
+        *stale->PushElem() = PushString(out,filepath);
+      }
+    }
+  }
+  
+  FILE* file = OpenFile(manifestPath,"w",FilePurpose_MISC);
+  if(file){
+    DEFER_CLOSE_FILE(file);
+    for(auto p : generated){
+      fprintf(file,"%016lx %.*s\n",*p.second,UN(p.first));
+    }
+  }
+
+  report.stale = PushArrayFromList(out,stale);
+  
+  return report;
+}
+
+static std::atomic<int> cacheFileCounter(0);
+
+CacheFile OpenCacheFile(String filepath,Arena* out){
+  CacheFile res = {};
+  res.filepath = PushString(out,filepath);
+  res.temporaryPath = PushString(out,"%.*s.%d_%d.tmp",UN(filepath),(int) getpid(),cacheFileCounter.fetch_add(1));
+  res.file = OpenFileAndCreateDirectories(res.temporaryPath,"w",FilePurpose_CACHE);
+  return res;
+}
+
+bool CommitCacheFile(CacheFile cache){
+  if(!cache.file){
+    return false;
+  }
+
+  const char* temporaryPath = StaticFormat("%.*s",UN(cache.temporaryPath));
+  const char* filepath = StaticFormat("%.*s",UN(cache.filepath));
+  
+  bool writeError = ferror(cache.file);
+  if(fclose(cache.file) != 0 || writeError){
+    remove(temporaryPath);
+    return false;
+  }
+
+  if(rename(temporaryPath,filepath) != 0){
+    printf("Warning: could not store cache entry %s: %s\n",filepath,strerror(errno));
+    remove(temporaryPath);
+    return false;
+  }
+
+  return true;
+}
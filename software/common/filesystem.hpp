@@ -17,7 +17,8 @@ enum FilePurpose{
   FilePurpose_SCRIPT,
   FilePurpose_MISC,
   FilePurpose_READ_CONTENT,
-  FilePurpose_DEBUG_INFO
+  FilePurpose_DEBUG_INFO,
+  FilePurpose_CACHE
 };
 
 const char* FilePurpose_Name(FilePurpose p);
@@ -31,6 +32,7 @@ enum FileOpenMode{
 
 struct FileInfo{
   String filepath;
+  String temporaryPath; // Generated files are written here first, see CommitGeneratedFiles
   FileOpenMode mode;
   FilePurpose purpose;
   bool wasOpenSucessful;
@@ -38,3 +40,25 @@ struct FileInfo{
 
 FILE* OpenFile(String filepath,const char* mode,FilePurpose purpose);
 Array<FileInfo> CollectAllFilesInfo(Arena* out);
+
+struct GeneratedFilesReport{
+  int written;
+  int unchanged;
+  int failed; // Could not be moved into place, they are not in the manifest
+  Array<String> stale; // In the previous manifest but not generated by this run. Not removed, the user might still want them
+};
+
+// Generated files (verilog, software, makefiles and scripts) are written to a temporary file and only replace the real file if the content changed. Unchanged files keep their timestamps, so downstream builds only redo the work for the files that changed.
+// The manifest stores the hash of every generated file.
+// Must be called after every generated file is closed.
+GeneratedFilesReport CommitGeneratedFiles(String manifestPath,Arena* out);
+
+// Cache entries are shared by the parallel workers and by compiler runs happening at the same time. Writers fill a temporary file private to them and CommitCacheFile renames it over the entry, so readers only ever see complete entries.
+struct CacheFile{
+  FILE* file; // Null if the temporary file could not be opened
+  String filepath;
+  String temporaryPath;
+};
+
+CacheFile OpenCacheFile(String filepath,Arena* out);
+bool CommitCacheFile(CacheFile cache); // Closes the file. On failure the entry is left as it was
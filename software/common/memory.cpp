@@ -40,13 +40,14 @@ struct FunctionAllocationInfo{
   size_t memoryUsed;
 };
 
-static Arena debugMemoryArena;
-static Array<ArenaInfo> debugArenaStack;
-static int debugArenaIndex;
-static ArenaList<FunctionAllocationInfo>* debugInfo;
+// Regions are thread specific, each thread tracks its own stack
+static thread_local Arena debugMemoryArena;
+static thread_local Array<ArenaInfo> debugArenaStack;
+static thread_local int debugArenaIndex;
+static thread_local ArenaList<FunctionAllocationInfo>* debugInfo;
 
 static void InitMemoryDebug(){
-  static bool init = false;
+  static thread_local bool init = false;
   if(init){
     return;
   }
@@ -120,7 +121,7 @@ void DebugEndRegion(Arena* arena,const char* file,const char* function,int line)
   }
 }
 
-Arena* contextArenas[2];
+thread_local Arena* contextArenas[2];
 
 Arena* GetArena(Arena* diff){
   if(contextArenas[0] != diff){
@@ -174,12 +175,12 @@ void* AllocatePages(int pages){
   void* res = mmap(0, pages * GetPageSize(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
   Assert(res != MAP_FAILED);
  
-  pagesAllocated += pages;
+  __atomic_add_fetch(&pagesAllocated,pages,__ATOMIC_RELAXED);
   return res;
 }
 
 void DeallocatePages(void* ptr,int pages){
-  pagesDeallocated += pages;
+  __atomic_add_fetch(&pagesDeallocated,pages,__ATOMIC_RELAXED);
   munmap(ptr,pages * GetPageSize());
 }
 
@@ -543,95 +544,294 @@ String PushString(DynamicArena* arena,String str){
 }
 
 bool BitIterator::operator!=(BitIterator& iter){ // Returns false if passed over iter
-   bool passedOver = currentByte > iter.currentByte || (currentByte == iter.currentByte && currentBit >= iter.currentBit);
-
-   return !passedOver;
+  bool passedOver = (index >= iter.index);
+  return !passedOver;
 }
 
 void BitIterator::operator++(){
-  int byteSize = (array->bitSize + 7) / 8;
+  index = array->FirstBitSetIndex(index + 1);
+  if(index < 0){
+    index = array->bitSize;
+  }
+}
+
+int BitIterator::operator*(){
+  return index;
+}
+
+// ============================================================================
+// BitArray kernels
+//
+// Memory is always allocated in blocks of 256 bits and bits after bitSize are kept at zero,
+// which means that kernels can work on whole blocks without any special handling of the last one.
+
+static void And_Scalar(u64* dst,u64* src,int words){
+  for(int i = 0; i < words; i++){
+    dst[i] &= src[i];
+  }
+}
+
+static int AndCount_Scalar(u64* dst,u64* a,u64* b,int words){
+  int count = 0;
+  for(int i = 0; i < words; i++){
+    u64 val = a[i] & b[i];
+    dst[i] = val;
+    count += __builtin_popcountll(val);
+  }
+  return count;
+}
+
+static int Count_Scalar(u64* src,int words){
+  int count = 0;
+  for(int i = 0; i < words; i++){
+    count += __builtin_popcountll(src[i]);
+  }
+  return count;
+}
+
+// Returns the index of the first non zero word starting from start or words if none.
+static int NonZeroWord_Scalar(u64* src,int start,int words){
+  for(int i = start; i < words; i++){
+    if(src[i]){
+      return i;
+    }
+  }
+  return words;
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static void And_SSE(u64* dst,u64* src,int words){
+  for(int i = 0; i < words; i += 2){
+    __m128i d = _mm_loadu_si128((__m128i*) &dst[i]);
+    __m128i s = _mm_loadu_si128((__m128i*) &src[i]);
+    _mm_storeu_si128((__m128i*) &dst[i],_mm_and_si128(d,s));
+  }
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static int AndCount_SSE(u64* dst,u64* a,u64* b,int words){
+  i64 count = 0;
+  for(int i = 0; i < words; i += 2){
+    __m128i va = _mm_loadu_si128((__m128i*) &a[i]);
+    __m128i vb = _mm_loadu_si128((__m128i*) &b[i]);
+    __m128i val = _mm_and_si128(va,vb);
+    _mm_storeu_si128((__m128i*) &dst[i],val);
+    count += _mm_popcnt_u64(_mm_cvtsi128_si64(val));
+    count += _mm_popcnt_u64(_mm_extract_epi64(val,1));
+  }
+  return (int) count;
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static int Count_SSE(u64* src,int words){
+  i64 count = 0;
+  for(int i = 0; i < words; i++){
+    count += _mm_popcnt_u64(src[i]);
+  }
+  return (int) count;
+}
 
-  // Increment once
-  currentBit += 1;
-  if(currentBit >= 8){
-    currentBit = 0;
-    currentByte += 1;
+__attribute__((target("sse4.2,popcnt")))
+static int NonZeroWord_SSE(u64* src,int start,int words){
+  int i = start;
+  for(; i < words && (i % 2) != 0; i++){
+    if(src[i]){
+      return i;
+    }
+  }
+  for(; i < words; i += 2){
+    __m128i val = _mm_loadu_si128((__m128i*) &src[i]);
+    if(!_mm_testz_si128(val,val)){
+      return (src[i] ? i : i + 1);
+    }
   }
+  return words;
+}
+
+__attribute__((target("avx2,popcnt")))
+static void And_AVX2(u64* dst,u64* src,int words){
+  for(int i = 0; i < words; i += 4){
+    __m256i d = _mm256_loadu_si256((__m256i*) &dst[i]);
+    __m256i s = _mm256_loadu_si256((__m256i*) &src[i]);
+    _mm256_storeu_si256((__m256i*) &dst[i],_mm256_and_si256(d,s));
+  }
+}
+
+__attribute__((target("avx2,popcnt")))
+static int AndCount_AVX2(u64* dst,u64* a,u64* b,int words){
+  i64 count = 0;
+  for(int i = 0; i < words; i += 4){
+    __m256i va = _mm256_loadu_si256((__m256i*) &a[i]);
+    __m256i vb = _mm256_loadu_si256((__m256i*) &b[i]);
+    __m256i val = _mm256_and_si256(va,vb);
+    _mm256_storeu_si256((__m256i*) &dst[i],val);
+
+    if(!_mm256_testz_si256(val,val)){
+      count += _mm_popcnt_u64(dst[i + 0]);
+      count += _mm_popcnt_u64(dst[i + 1]);
+      count += _mm_popcnt_u64(dst[i + 2]);
+      count += _mm_popcnt_u64(dst[i + 3]);
+    }
+  }
+  return (int) count;
+}
 
-  // Stop at first valid found after
-  // TODO: Maybe use the FirstBitSetIndex function, instead of this
-  //       Need to change that function to maybe return bitSize if not
-  while(currentByte < byteSize){
-    unsigned char ch = array->memory[currentByte];
+__attribute__((target("avx2,popcnt")))
+static int Count_AVX2(u64* src,int words){
+  i64 count = 0;
+  for(int i = 0; i < words; i += 4){
+    __m256i val = _mm256_loadu_si256((__m256i*) &src[i]);
 
-    if(!ch){
-      currentByte += 1;
-      currentBit = 0;
-      continue;
+    if(!_mm256_testz_si256(val,val)){
+      count += _mm_popcnt_u64(src[i + 0]);
+      count += _mm_popcnt_u64(src[i + 1]);
+      count += _mm_popcnt_u64(src[i + 2]);
+      count += _mm_popcnt_u64(src[i + 3]);
     }
+  }
+  return (int) count;
+}
 
-    // Fallthrough switch
-    switch(currentBit){
-    case 0: if(ch & 0x01) goto end; else ++currentBit;
-    case 1: if(ch & 0x02) goto end; else ++currentBit;
-    case 2: if(ch & 0x04) goto end; else ++currentBit;
-    case 3: if(ch & 0x08) goto end; else ++currentBit;
-    case 4: if(ch & 0x10) goto end; else ++currentBit;
-    case 5: if(ch & 0x20) goto end; else ++currentBit;
-    case 6: if(ch & 0x40) goto end; else ++currentBit;
-    case 7: if(ch & 0x80) goto end; else {
-      currentBit = 0;
-      currentByte += 1;
+__attribute__((target("avx2,popcnt")))
+static int NonZeroWord_AVX2(u64* src,int start,int words){
+  int i = start;
+  for(; i < words && (i % 4) != 0; i++){
+    if(src[i]){
+      return i;
     }
+  }
+  for(; i < words; i += 4){
+    __m256i val = _mm256_loadu_si256((__m256i*) &src[i]);
+    if(!_mm256_testz_si256(val,val)){
+      for(int j = i; j < i + 4; j++){
+        if(src[j]){
+          return j;
+        }
+      }
     }
   }
+  return words;
+}
 
- end:
+struct BitKernels{
+  void (*And)(u64* dst,u64* src,int words);
+  int  (*AndCount)(u64* dst,u64* a,u64* b,int words);
+  int  (*Count)(u64* src,int words);
+  int  (*NonZeroWord)(u64* src,int start,int words);
+};
 
-  //Assert(array->Get(*(*this)));
-  return;
+static BitKernels bitKernels[] = {
+  {And_Scalar,AndCount_Scalar,Count_Scalar,NonZeroWord_Scalar},
+  {And_SSE,AndCount_SSE,Count_SSE,NonZeroWord_SSE},
+  {And_AVX2,AndCount_AVX2,Count_AVX2,NonZeroWord_AVX2}
+};
+
+BitKernelLevel BestBitKernelLevel(){
+  static BitKernelLevel level = [](){
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")){
+      return BitKernelLevel_AVX2;
+    }
+    if(__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")){
+      return BitKernelLevel_SSE;
+    }
+    return BitKernelLevel_SCALAR;
+  }();
+  
+  return level;
 }
 
-int BitIterator::operator*(){
-  int index = currentByte * 8 + currentBit;
-  return index;
+// Per thread, so that benchmarking a level does not affect the other threads
+static thread_local BitKernels* currentBitKernels = nullptr;
+static thread_local BitKernelLevel currentBitKernelLevel;
+
+static inline BitKernels* GetBitKernels(){
+  if(!currentBitKernels){
+    SetBitKernelLevel(BestBitKernelLevel());
+  }
+  return currentBitKernels;
+}
+
+void SetBitKernelLevel(BitKernelLevel level){
+  Assert(level <= BestBitKernelLevel());
+
+  currentBitKernelLevel = level;
+  currentBitKernels = &bitKernels[level];
+}
+
+BitKernelLevel GetBitKernelLevel(){
+  GetBitKernels();
+  return currentBitKernelLevel;
+}
+
+const char* BitKernelLevelName(BitKernelLevel level){
+  FULL_SWITCH(level){
+  case BitKernelLevel_SCALAR: return "Scalar";
+  case BitKernelLevel_SSE: return "SSE";
+  case BitKernelLevel_AVX2: return "AVX2";
+} END_SWITCH();
+
+  return nullptr;
+}
+
+// ============================================================================
+// BitArray
+
+static int BitArrayByteSize(int bitSize){
+  return ALIGN_UP_256(BitSizeToByteSize(bitSize));
 }
 
 void BitArray::Init(Byte* memory,int bitSize){
   this->memory = memory;
   this->bitSize = bitSize;
-  this->byteSize = BitSizeToByteSize(bitSize);
-  Assert(IS_ALIGNED_32(this->byteSize));
+  this->byteSize = BitArrayByteSize(bitSize);
+  Assert(IS_ALIGNED_64(this->memory));
 }
 
 void BitArray::Init(Arena* arena,int bitSize){
+  AlignArena(arena,32);
   this->memory = MarkArena(arena).mark;
   this->bitSize = bitSize;
-  this->byteSize = ALIGN_UP_32(BitSizeToByteSize(bitSize));
-  PushBytes(arena,this->byteSize); // Makes it easier to use popcount
+  this->byteSize = BitArrayByteSize(bitSize);
+  PushBytes(arena,this->byteSize);
 }
 
 void BitArray::Fill(bool value){
   int fillValue = (value ? 0xff : 0x00);
 
-  for(int i = 0; i < this->byteSize; i++){
-    this->memory[i] = fillValue;
+  memset(this->memory,fillValue,this->byteSize);
+
+  if(value){
+    // Bits after bitSize must stay at zero
+    u64* words = (u64*) this->memory;
+    int lastWord = bitSize / 64;
+    int lastBit = bitSize % 64;
+    int numberWords = byteSize / 8;
+
+    if(lastWord < numberWords){
+      words[lastWord] = (lastBit ? ((((u64) 1) << lastBit) - 1) : 0);
+      for(int i = lastWord + 1; i < numberWords; i++){
+        words[i] = 0;
+      }
+    }
   }
 }
 
 void BitArray::Copy(BitArray array){
   Assert(this->bitSize >= array.bitSize);
 
-  Memcpy(this->memory,array.memory,byteSize);
+  int toCopy = std::min(this->byteSize,array.byteSize);
+  Memcpy(this->memory,array.memory,toCopy);
+  if(toCopy < this->byteSize){
+    memset(this->memory + toCopy,0,this->byteSize - toCopy);
+  }
 }
 
 int BitArray::Get(int index){
   Assert(index < this->bitSize);
 
-  int byteIndex = index / 8;
-  int bitIndex = index % 8;
-  Byte byte = memory[byteIndex];
-  int result = (byte & (1 << bitIndex) ? 1 : 0);
+  u64* words = (u64*) this->memory;
+  int result = (words[index / 64] >> (index % 64)) & 1;
 
   return result;
 }
@@ -639,155 +839,86 @@ int BitArray::Get(int index){
 void BitArray::Set(int index,bool value){
   Assert(index < this->bitSize);
 
-  int byteIndex = index / 8;
-  int bitIndex = index % 8;
+  u64* words = (u64*) this->memory;
+  u64 mask = ((u64) 1) << (index % 64);
 
   if(value){
-    memory[byteIndex] |= (1 << bitIndex);
+    words[index / 64] |= mask;
   } else {
-    memory[byteIndex] &= ~(1 << bitIndex);
+    words[index / 64] &= ~mask;
   }
 }
 
 int BitArray::GetNumberBitsSet(){
-  int count = 0;
-
-#if 1
-  i32* ptr = (i32*) this->memory;
-  int i = 0;
-  for(;i < this->bitSize; i += 32){
-    count += PopCount(*ptr);
-    ptr += 1;
-  }
-#else
-  // Deal with data not aligned to 4
-  int32* ptr = (int32*) this->memory;
-  int i = 0;
-  for(;(i + 32) < this->bitSize; i += 32){
-    count += PopCount(*ptr);
-    ptr += 1;
-  }
-
-  if(i < this->bitSize){
-    int bytes = BitSizeToByteSize(this->bitSize - i);
-
-    int32 test = {};
-    int8* testView = &test;
-    int8* ptrView = (int8*) ptr;
-
-    switch(bytes){
-    case 1: testView[0] = ptrView[0];
-    case 2: testView[1] = ptrView[1];
-    case 3: testView[2] = ptrView[2];
-    case 4: testView[3] = ptrView[3]; // Shouldn't happen, as it means we are aligned
-    }
-
-    count += PopCount(test);
-  }
-#endif
-
+  int count = GetBitKernels()->Count((u64*) this->memory,this->byteSize / 8);
   return count;
 }
 
 int BitArray::FirstBitSetIndex(){
-#ifdef VERSAT_DEBUG
-  int correct = 0;
-  for(int i = 0; i < this->bitSize; i++){
-    if(Get(i)){
-      correct = i;
-      break;
-    }
-  }
-#endif
-   
-  u32* ptr = (u32*) this->memory;
-  int i = 0;
-  for(;i < this->bitSize; i += 32){
-    if(*ptr != 0){
-      int index = i + TrailingZerosCount(*ptr);
-#ifdef VERSAT_DEBUG
-      Assert(index == correct);
-#endif
-      return index;
-    }
-    ptr += 1;
-  }
-  Assert(false); // Not correct but good for the current needs
-  return -1;
+  return FirstBitSetIndex(0);
 }
 
 int BitArray::FirstBitSetIndex(int start){
-  // TODO: For now I want correctness, find the bug to trailing zero.
-  //#ifdef VERSAT_DEBUG
-  int correct = 0;
-  for(int i = start; i < this->bitSize; i++){
-    if(Get(i)){
-      correct = i;
-      break;
-    }
+  if(start >= this->bitSize){
+    return -1;
   }
-  return correct;
-//#endif
-
-  Assert(start < this->bitSize);
-  int i = ALIGN_UP_32(start - 31);
-  u32 startDWord = BitSizeToDWordSize(i);
-  u32* ptr = (u32*) this->memory;
-  ptr = &ptr[startDWord];
 
-  u32 val = *ptr;
+  u64* words = (u64*) this->memory;
+  int numberWords = this->byteSize / 8;
+  int wordIndex = start / 64;
 
-  while(val != 0){
-    int bitIndex = TrailingZerosCount(val);
-    int index = i + bitIndex;
-    if(index >= this->bitSize){
-      Assert(false); // Not correct but good for the current needs
-      return -1;
-    }
-    if(index >= start){
-#ifdef VERSAT_DEBUG
-      Assert(index == correct);
-#endif
-      return index;
-    }
-
-    val = CLEAR_BIT(val,bitIndex);
+  // Handle the start word separately to skip the bits before start
+  u64 first = words[wordIndex] & (~((u64) 0) << (start % 64));
+  if(first){
+    return wordIndex * 64 + __builtin_ctzll(first);
   }
 
-  i += 32;
-  ptr += 1;
-  for(;i < this->bitSize; i += 32){
-    if(*ptr != 0){
-      int index = i + TrailingZerosCount(*ptr);
-#ifdef VERSAT_DEBUG
-      Assert(index == correct);
-#endif
-      return index;
-    }
-    ptr += 1;
+  wordIndex = GetBitKernels()->NonZeroWord(words,wordIndex + 1,numberWords);
+  if(wordIndex >= numberWords){
+    return -1;
   }
-  Assert(false); // Not correct but good for the current needs
-  return -1;
+
+  int index = wordIndex * 64 + __builtin_ctzll(words[wordIndex]);
+  return index;
+}
+
+int BitArray::IntersectAndCount(BitArray& other){
+  Assert(this->bitSize == other.bitSize);
+
+  u64* words = (u64*) this->memory;
+  int count = GetBitKernels()->AndCount(words,words,(u64*) other.memory,this->byteSize / 8);
+  return count;
+}
+
+int BitArray::CopyIntersectAndCount(BitArray& a,BitArray& b){
+  Assert(this->bitSize == a.bitSize && this->bitSize == b.bitSize);
+
+  int count = GetBitKernels()->AndCount((u64*) this->memory,(u64*) a.memory,(u64*) b.memory,this->byteSize / 8);
+  return count;
 }
 
 void BitArray::operator&=(BitArray& other){
   Assert(this->bitSize == other.bitSize);
 
-  for(int i = 0; i < byteSize; i++){
-    this->memory[i] &= other.memory[i];
+  GetBitKernels()->And((u64*) this->memory,(u64*) other.memory,this->byteSize / 8);
+}
+
+void BitArray::Remove(BitArray& other){
+  Assert(this->bitSize == other.bitSize);
+
+  u64* words = (u64*) this->memory;
+  u64* otherWords = (u64*) other.memory;
+  for(int i = 0; i < this->byteSize / 8; i++){
+    words[i] &= ~otherWords[i];
   }
 }
 
 BitIterator BitArray::begin(){
   BitIterator iter = {};
   iter.array = this;
-
-  if(bitSize == 0){
-    return iter;
-  }
-
-  if(!Get(0)){
-    ++iter;
+  iter.index = FirstBitSetIndex(0);
+  if(iter.index < 0){
+    iter.index = bitSize;
   }
 
   return iter;
@@ -796,8 +927,7 @@ BitIterator BitArray::begin(){
 BitIterator BitArray::end(){
   BitIterator iter = {};
   iter.array = this;
-  iter.currentByte = bitSize/ 8;
-  iter.currentBit = bitSize % 8;
+  iter.index = bitSize;
   return iter;
 }
 
@@ -21,7 +21,8 @@
 #endif 
 
 struct Arena;
-extern Arena* contextArenas[2];
+// Each thread has its own pair of context arenas. Threads other than the main thread must set them before using any of the TEMP_REGION macros.
+extern thread_local Arena* contextArenas[2];
 // Pass nullptr to get one arena, pass an arena to get a guaranteed different arena to the one passed
 // Calling code must pass any arena that it contains to this function to make sure that the arena returned is different. We only receive one currently because we only expect to support out/temp flows (only 2 arenas required).
 // Check the TEMP_REGION macros and their usage to better understand how to use this approach for memory management.
@@ -61,6 +62,7 @@ void Free(Arena* arena);
 size_t MemoryUsage(Arena* arena);
 Byte* PushBytes(Arena* arena, size_t size);
 size_t SpaceAvailable(Arena* arena);
+Arena SubArena(Arena* arena,size_t size);
 
 void ReportArenaUsage();
 void DebugInitRegion(Arena* arena,const char* file,const char* function,int line);
@@ -280,8 +282,7 @@ class BitArray;
 class BitIterator{
 public:
   BitArray* array;
-  int currentByte;
-  int currentBit;
+  int index;
 
 public:
   bool operator!=(BitIterator& iter);
@@ -289,6 +290,19 @@ public:
   int operator*(); // Returns index where it is set to one;
 };
 
+// Kernels used by BitArray. The best level supported by the cpu is selected by default.
+enum BitKernelLevel{
+  BitKernelLevel_SCALAR,
+  BitKernelLevel_SSE,
+  BitKernelLevel_AVX2
+};
+
+BitKernelLevel BestBitKernelLevel();
+BitKernelLevel GetBitKernelLevel();
+void SetBitKernelLevel(BitKernelLevel level); // Mostly for benchmarking. Only affects the calling thread
+const char* BitKernelLevelName(BitKernelLevel level);
+
+// Memory is allocated in blocks of 256 bits, bits after bitSize are always zero.
 struct BitArray{
 public:
   Byte* memory;
@@ -296,7 +310,7 @@ public:
   int byteSize;
 
 public:
-  void Init(Byte* memory,int bitSize);
+  void Init(Byte* memory,int bitSize); // Memory must contain ALIGN_UP_256(BitSizeToByteSize(bitSize)) bytes
   void Init(Arena* arena,int bitSize);
 
   void Fill(bool value);
@@ -307,10 +321,16 @@ public:
 
   int GetNumberBitsSet();
 
+  // Return -1 if no bit is set
   int FirstBitSetIndex();
   int FirstBitSetIndex(int start);
 
+  // Fused versions of &= followed by GetNumberBitsSet
+  int IntersectAndCount(BitArray& other);
+  int CopyIntersectAndCount(BitArray& a,BitArray& b); // this = a & b
+  
   void operator&=(BitArray& other);
+  void Remove(BitArray& other); // this &= ~other
 
   BitIterator begin();
   BitIterator end();
@@ -981,7 +981,7 @@ int ParseInt(String ss){
 }
 
 double ParseDouble(String str){
-  static char buffer[1024];
+  static thread_local char buffer[1024];
 
   Memcpy(buffer,(char*) str.data,str.size);
   buffer[str.size] = '\0';
@@ -993,7 +993,7 @@ double ParseDouble(String str){
 }
 
 float ParseFloat(String str){
-  static char buffer[1024];
+  static thread_local char buffer[1024];
 
   Memcpy(buffer,(char*) str.data,str.size);
   buffer[str.size] = '\0';
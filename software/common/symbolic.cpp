@@ -5,8 +5,6 @@
 #include "utils.hpp"
 #include "utilsCore.hpp"
 
-static TokenizerTemplate* tmpl;
-
 int TypeToBingingStrength(SymbolicExpression* expr){
   switch(expr->type){
   case SymbolicExpressionType_VARIABLE:
@@ -315,10 +313,30 @@ static void PrintAST(SymbolicExpression* expr,int level = 0){
   }
 }
 
+// ALIGN is created by the address gen code
+static bool IsAlignFunction(SymbolicExpression* expr){
+  return (CompareString(expr->name,"ALIGN") && expr->terms.size == 2);
+}
+
+// Same semantics as the ALIGN function of the generated header. Zero alignment leaves the base unchanged instead of dividing by zero.
+static int SymbolicAlign(int base,int alignment){
+  if(alignment == 0){
+    return base;
+  }
+
+  int diff = base % alignment;
+  return (diff == 0) ? base : (base - diff + alignment);
+}
+
 int Evaluate(SymbolicExpression* expr,Hashmap<String,int>* values){
   int val = 0;
   switch(expr->type){
   case SymbolicExpressionType_FUNC: {
+    if(IsAlignFunction(expr)){
+      val = SymbolicAlign(Evaluate(expr->terms[0],values),Evaluate(expr->terms[1],values));
+      break;
+    }
+    
     //WARN_CODE();
 
     return 0;
@@ -367,6 +385,125 @@ int Evaluate(SymbolicExpression* expr,Hashmap<String,int>* values){
   return val;
 }
 
+static int CompileSymbolicExpressionRecurse(SymbolicExpression* expr,Array<String> slots,GrowableArray<SymbolicInstruction>& builder){
+  auto Emit = [&](SymbolicOpcode op,int left,int right,int value) -> int{
+    int index = builder.size;
+    *builder.PushElem() = {op,left,right,value};
+    return index;
+  };
+
+  int res = -1;
+  switch(expr->type){
+  case SymbolicExpressionType_FUNC: {
+    if(IsAlignFunction(expr)){
+      int left = CompileSymbolicExpressionRecurse(expr->terms[0],slots,builder);
+      int right = CompileSymbolicExpressionRecurse(expr->terms[1],slots,builder);
+      res = Emit(SymbolicOpcode_ALIGN,left,right,0);
+      break;
+    }
+    
+    // Giving some value to an unknown function would make every address computed from it silently wrong
+    printf("Symbolic program cannot evaluate function: %.*s\n",UN(expr->name));
+    NOT_IMPLEMENTED("Add an opcode for the function");
+    return Emit(SymbolicOpcode_LITERAL,0,0,0);
+  } break;
+  case SymbolicExpressionType_LITERAL:{
+    return Emit(SymbolicOpcode_LITERAL,0,0,GetLiteralValue(expr));
+  } break;
+  case SymbolicExpressionType_VARIABLE:{
+    int slot = -1;
+    for(int i = slots.size - 1; i >= 0; i--){
+      if(CompareString(slots[i],expr->variable)){
+        slot = i;
+        break;
+      }
+    }
+    Assert(slot != -1);
+
+    res = Emit(SymbolicOpcode_LOAD,0,0,slot);
+  } break;
+  case SymbolicExpressionType_DIV:{
+    int left = CompileSymbolicExpressionRecurse(expr->top,slots,builder);
+    int right = CompileSymbolicExpressionRecurse(expr->bottom,slots,builder);
+    res = Emit(SymbolicOpcode_DIV,left,right,0);
+  } break;
+  case SymbolicExpressionType_SUM: // fallthrough
+  case SymbolicExpressionType_MUL:{
+    bool isMul = (expr->type == SymbolicExpressionType_MUL);
+    SymbolicOpcode op = isMul ? SymbolicOpcode_MUL : SymbolicOpcode_ADD;
+
+    if(expr->terms.size == 0){
+      res = Emit(SymbolicOpcode_LITERAL,0,0,isMul ? 1 : 0);
+      break;
+    }
+
+    res = CompileSymbolicExpressionRecurse(expr->terms[0],slots,builder);
+    for(int i = 1; i < expr->terms.size; i++){
+      int right = CompileSymbolicExpressionRecurse(expr->terms[i],slots,builder);
+      res = Emit(op,res,right,0);
+    }
+  } break;
+  }
+
+  if(expr->negative){
+    res = Emit(SymbolicOpcode_NEGATE,res,0,0);
+  }
+
+  return res;
+}
+
+SymbolicProgram* CompileSymbolicExpression(SymbolicExpression* expr,Array<String> slots,Arena* out){
+  SymbolicProgram* program = PushStruct<SymbolicProgram>(out);
+
+  GrowableArray<SymbolicInstruction> builder = StartArray<SymbolicInstruction>(out);
+  CompileSymbolicExpressionRecurse(expr,slots,builder);
+  program->instructions = EndArray(builder);
+
+  return program;
+}
+
+int Evaluate(SymbolicProgram* program,Array<int> slots){
+  TEMP_REGION(temp,nullptr);
+
+  int size = program->instructions.size;
+  int* regs = PushArray<int>(temp,size).data;
+
+  for(int i = 0; i < size; i++){
+    SymbolicInstruction inst = program->instructions[i];
+
+    switch(inst.op){
+    case SymbolicOpcode_LITERAL: regs[i] = inst.value; break;
+    case SymbolicOpcode_LOAD: regs[i] = slots[inst.value]; break;
+    case SymbolicOpcode_ADD: regs[i] = regs[inst.left] + regs[inst.right]; break;
+    case SymbolicOpcode_MUL: regs[i] = regs[inst.left] * regs[inst.right]; break;
+    case SymbolicOpcode_NEGATE: regs[i] = -regs[inst.left]; break;
+    case SymbolicOpcode_ALIGN: regs[i] = SymbolicAlign(regs[inst.left],regs[inst.right]); break;
+    case SymbolicOpcode_DIV:{
+      int right = regs[inst.right];
+      if(right == 0){
+        PRINTF_WITH_LOCATION("Division by zero\n");
+        DEBUG_BREAK();
+        regs[i] = 0;
+      } else {
+        regs[i] = regs[inst.left] / right;
+      }
+    } break;
+    }
+  }
+
+  return regs[size - 1];
+}
+
+bool ProgramUsesSlot(SymbolicProgram* program,int slot){
+  for(SymbolicInstruction inst : program->instructions){
+    if(inst.op == SymbolicOpcode_LOAD && inst.value == slot){
+      return true;
+    }
+  }
+
+  return false;
+}
+
 #define EXPECT(TOKENIZER,STR) \
   TOKENIZER->AssertNextToken(STR)
 
@@ -737,7 +874,7 @@ SymbolicExpression* ParseSymbolicExpression(Tokenizer* tok,Arena* out){
   // TODO: We need to find a way of solving the problem of creating a tokenizer template once and be done with it.
   //       We probably want to move this somewhat to the META data, no point in doing this at runtime.
   TEMP_REGION(temp,out);
-  tmpl = CreateTokenizerTemplate(temp,",+-*/();[]",{".."});
+  TokenizerTemplate* tmpl = CreateTokenizerTemplate(temp,",+-*/();[]",{".."});
   
   TOKENIZER_REGION(tok,tmpl);
 
@@ -800,6 +937,10 @@ static SymbolicExpression* CopyExpression(SymbolicExpression* in,Arena* out){
   SymbolicExpression* res = PushStruct<SymbolicExpression>(out);
   *res = *in;
 
+  // Copies are never part of the store, even if the original was.
+  res->interned = false;
+  res->nameId = 0;
+
   // Need to copy the string, the string memory is our responsibility.
   if(in->type == SymbolicExpressionType_VARIABLE || in->type == SymbolicExpressionType_FUNC){
     res->variable = PushString(out,res->variable);
@@ -841,6 +982,157 @@ SymbolicExpression* SymbolicDeepCopy(SymbolicExpression* expr,Arena* out){
   NOT_POSSIBLE();
 }
 
+// ============================================================================
+// Hash-consed store
+
+// Key of an interned node. Children are already interned, so they are compared by pointer.
+struct SymbolicNodeKey{
+  SymbolicExpressionType type;
+  bool negative;
+  int literal;
+  int nameId;
+  SymbolicExpression* top;
+  SymbolicExpression* bottom;
+  Array<SymbolicExpression*> terms;
+
+  bool operator==(const SymbolicNodeKey& other) const{
+    if(type != other.type || negative != other.negative || literal != other.literal || nameId != other.nameId){
+      return false;
+    }
+    if(top != other.top || bottom != other.bottom || terms.size != other.terms.size){
+      return false;
+    }
+    for(int i = 0; i < terms.size; i++){
+      if(terms[i] != other.terms[i]){
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+template<> class std::hash<SymbolicNodeKey>{
+public:
+  std::size_t operator()(SymbolicNodeKey const& key) const noexcept{
+    u64 hash = StableHashInt(key.type);
+    hash = StableHashInt(key.negative,hash);
+    hash = StableHashInt(key.literal,hash);
+    hash = StableHashInt(key.nameId,hash);
+    hash = StableHashInt((i64) key.top,hash);
+    hash = StableHashInt((i64) key.bottom,hash);
+    for(SymbolicExpression* term : key.terms){
+      hash = StableHashInt((i64) term,hash);
+    }
+    return hash;
+  }
+};
+
+// Each thread has its own store since the compiler instantiates modules in parallel.
+// Interned nodes never leave this file (Normalize returns copies), so the store is emptied between normalizations once it grows past a threshold.
+struct SymbolicStore{
+  Arena arena;
+  TrieMap<SymbolicNodeKey,SymbolicExpression*>* nodes;
+  TrieMap<String,int>* names;
+  TrieMap<SymbolicExpression*,SymbolicExpression*>* normalized; // Interned expression to its interned normalized form
+};
+
+static const size_t SYMBOLIC_STORE_SIZE = Megabyte(64);
+static const size_t SYMBOLIC_STORE_RESET_SIZE = Megabyte(16);
+
+static thread_local SymbolicStore symbolicStoreInst = {};
+static thread_local SymbolicStore* symbolicStore = nullptr;
+static thread_local int normalizeDepth = 0;
+
+static void ResetSymbolicStore(SymbolicStore* store){
+  Arena* arena = &store->arena;
+  arena->used = 0;
+
+  store->nodes = PushTrieMap<SymbolicNodeKey,SymbolicExpression*>(arena);
+  store->names = PushTrieMap<String,int>(arena);
+  store->normalized = PushTrieMap<SymbolicExpression*,SymbolicExpression*>(arena);
+}
+
+static SymbolicStore* GetSymbolicStore(){
+  if(!symbolicStore){
+    symbolicStoreInst.arena = InitArena(SYMBOLIC_STORE_SIZE);
+    ResetSymbolicStore(&symbolicStoreInst);
+    symbolicStore = &symbolicStoreInst;
+  }
+
+  return symbolicStore;
+}
+
+static int InternName(SymbolicStore* store,String name){
+  int* existing = store->names->Get(name);
+  if(existing){
+    return *existing;
+  }
+
+  int id = store->names->inserted;
+  store->names->Insert(PushString(&store->arena,name),id);
+  return id;
+}
+
+// Returns the canonical node for expr. Structurally equal expressions return the same node.
+static SymbolicExpression* Intern(SymbolicExpression* expr){
+  if(expr->interned){
+    return expr;
+  }
+
+  SymbolicStore* store = GetSymbolicStore();
+  TEMP_REGION(temp,nullptr);
+
+  SymbolicNodeKey key = {};
+  key.type = expr->type;
+  key.negative = expr->negative;
+
+  switch(expr->type){
+  case SymbolicExpressionType_LITERAL:{
+    key.literal = expr->literal;
+
+    // Negative zero compares equal to zero, so both must map to the same node.
+    if(expr->literal == 0){
+      key.negative = false;
+    }
+  } break;
+  case SymbolicExpressionType_VARIABLE:{
+    key.nameId = InternName(store,expr->variable);
+  } break;
+  case SymbolicExpressionType_FUNC:
+    key.nameId = InternName(store,expr->name);
+    // fallthrough
+  case SymbolicExpressionType_SUM:
+  case SymbolicExpressionType_MUL:{
+    key.terms = PushArray<SymbolicExpression*>(temp,expr->terms.size);
+    for(int i = 0; i < expr->terms.size; i++){
+      key.terms[i] = Intern(expr->terms[i]);
+    }
+  } break;
+  case SymbolicExpressionType_DIV:{
+    key.top = Intern(expr->top);
+    key.bottom = Intern(expr->bottom);
+  } break;
+  }
+
+  SymbolicExpression** existing = store->nodes->Get(key);
+  if(existing){
+    return *existing;
+  }
+
+  SymbolicExpression* node = CopyExpression(expr,&store->arena);
+  node->negative = key.negative;
+  node->top = key.top;
+  node->bottom = key.bottom;
+  node->terms = CopyArray(key.terms,&store->arena);
+  node->nameId = key.nameId;
+  node->interned = true;
+
+  key.terms = node->terms;
+  store->nodes->Insert(key,node);
+
+  return node;
+}
+
 typedef SymbolicExpression* (*ApplyFunction)(SymbolicExpression* expr,Arena* out);
 typedef SymbolicExpression* (*ApplyNonRecursiveFunction)(SymbolicExpression* expr,Arena* out);
 
@@ -1457,6 +1749,13 @@ MultPartition PartitionMultExpressionOnVariable(SymbolicExpression* expr,String
 // Performs no form of normalization or canonicalization whatsoever.
 // A simple equality for use by other functions
 bool ExpressionEqual(SymbolicExpression* left,SymbolicExpression* right){
+  if(left == right){
+    return true;
+  }
+  if(left->interned && right->interned){
+    return false;
+  }
+  
   if(left->type != right->type){
     return false;
   }
@@ -2061,10 +2360,20 @@ void CheckIfCorrect(SymbolicExpression* start,SymbolicExpression* end){
   }
 }
 
-SymbolicExpression* Normalize(SymbolicExpression* expr,Arena* out,bool debugPrint){
-  TEMP_REGION(temp,out);
+// Returns the interned normalized form of expr
+static SymbolicExpression* NormalizeInterned(SymbolicExpression* expr,bool debugPrint){
+  TEMP_REGION(temp,nullptr);
+  SymbolicStore* store = GetSymbolicStore();
+
+  SymbolicExpression* key = Intern(expr);
+  if(!debugPrint){
+    SymbolicExpression** memo = store->normalized->Get(key);
+    if(memo){
+      return *memo;
+    }
+  }
+  
   SymbolicExpression* current = expr;
-  SymbolicExpression* next = nullptr;
 
   if(debugPrint){
     printf("Norm start:\n");
@@ -2072,82 +2381,63 @@ SymbolicExpression* Normalize(SymbolicExpression* expr,Arena* out,bool debugPrin
   }
 
   bool debugPrintAST = false;
-  
-  // TODO: Better way of detecting end, should be a check if expression did not change after an entire loop
-  for(int i = 0; i < 10; i++){
-    BLOCK_REGION(temp);
-    if(debugPrint) printf("%d:\n",i);
 
-    next = NormalizeLiterals(current,out);
-    CheckIfSymbolicExpressionsShareNodes(current,next);
+  // Intermediate trees live in temp, only the end result is copied into the store and out.
+  // Sharing checks are quadratic, only performed when debugging the normalization process.
+  auto Step = [&](const char* name,SymbolicExpression* next){
+    if(debugPrint) CheckIfSymbolicExpressionsShareNodes(current,next);
     current = next;
-    if(debugPrint) printf("Normalize Literals:\n");
+    if(debugPrint) printf("%s:\n",name);
     if(debugPrint) {Print(current); printf("\n");}
     if(debugPrintAST) PrintAST(current);
+  };
+  
+  // Passes are deterministic, so once a full round leaves the expression unchanged every round after it will too.
+  for(int i = 0; i < 10; i++){
+    if(debugPrint) printf("%d:\n",i);
 
-    next = NormalizeLiterals(current,out);
-    CheckIfSymbolicExpressionsShareNodes(current,next);
-    current = next;
-    if(debugPrint) printf("Normalize Literals:\n");
-    if(debugPrint) {Print(current); printf("\n");}
-    if(debugPrintAST) PrintAST(current);
+    SymbolicExpression* start = current;
     
-    next = ApplyDistributivity(current,out);
-    CheckIfSymbolicExpressionsShareNodes(current,next);
-    current = next;
-    if(debugPrint) printf("Apply distributivity:\n");
-    if(debugPrint) {Print(current); printf("\n");}
-    if(debugPrintAST) PrintAST(current);
+    Step("Normalize Literals",NormalizeLiterals(current,temp));
+    Step("Normalize Literals",NormalizeLiterals(current,temp));
+    Step("Apply distributivity",ApplyDistributivity(current,temp));
+    Step("Remove paran",RemoveParenthesis(current,temp));
+    Step("Remove paran",RemoveParenthesis(current,temp));
+    Step("SimilarTerms",ApplySimilarTermsAddition(current,temp));
+    Step("Remove paran",RemoveParenthesis(current,temp));
 
-    next = RemoveParenthesis(current,out);
-    CheckIfSymbolicExpressionsShareNodes(current,next);
-    current = next;
-    if(debugPrint) printf("Remove paran:\n");
-    if(debugPrint) {Print(current); printf("\n");}
-    if(debugPrintAST) PrintAST(current);
+    // Logic inside similar term might add superflouous constants, so we normalize literals again
+    Step("Normalize Literals",NormalizeLiterals(current,temp));
+    Step("MoveDivToTop",MoveDivToTop(current,temp));
 
-    next = RemoveParenthesis(current,out);
-    CheckIfSymbolicExpressionsShareNodes(current,next);
-    current = next;
-    if(debugPrint) printf("Remove paran:\n");
-    if(debugPrint) {Print(current); printf("\n");}
-    if(debugPrintAST) PrintAST(current);
+    if(ExpressionEqual(start,current)){
+      break;
+    }
+  }
 
-    next = ApplySimilarTermsAddition(current,out);
-    CheckIfSymbolicExpressionsShareNodes(current,next);
-    current = next;
-    if(debugPrint) printf("SimilarTerms:\n");
-    if(debugPrint) {Print(current); printf("\n");}
-    if(debugPrintAST) PrintAST(current);
+  current = ApplyNonRecursive(current,temp,SortTerms);
 
-    next = RemoveParenthesis(current,out);
-    CheckIfSymbolicExpressionsShareNodes(current,next); 
-    current = next;
-    if(debugPrint) printf("Remove paran:\n");
-    if(debugPrint) {Print(current); printf("\n");}
-    if(debugPrintAST) PrintAST(current);
+  SymbolicExpression* result = Intern(current);
+  store->normalized->Insert(key,result);
 
-    // Logic inside similar term might add superflouous constants, so we normalize literals again
-    next = NormalizeLiterals(current,out);
-    CheckIfSymbolicExpressionsShareNodes(current,next);
-    current = next;
-    if(debugPrint) printf("Normalize Literals:\n");
-    if(debugPrint) {Print(current); printf("\n");}
-    if(debugPrintAST) PrintAST(current);
+  //CheckIfCorrect(expr,result);
+  
+  return result;
+}
 
-    next = MoveDivToTop(current,out);
-    CheckIfSymbolicExpressionsShareNodes(current,next);
-    current = next;
-    if(debugPrint) printf("MoveDivToTop:\n");
-    if(debugPrint) {Print(current); printf("\n");}
-    if(debugPrintAST) PrintAST(current);
+SymbolicExpression* Normalize(SymbolicExpression* expr,Arena* out,bool debugPrint){
+  SymbolicStore* store = GetSymbolicStore();
+
+  // Only outside of any normalization, since the ones in progress hold interned nodes
+  if(normalizeDepth == 0 && store->arena.used > SYMBOLIC_STORE_RESET_SIZE){
+    ResetSymbolicStore(store);
   }
 
-  current = ApplyNonRecursive(current,out,SortTerms);
+  normalizeDepth += 1;
+  SymbolicExpression* result = NormalizeInterned(expr,debugPrint);
+  normalizeDepth -= 1;
 
-  //CheckIfCorrect(expr,current);
-  
-  return current;
+  return SymbolicDeepCopy(result,out);
 }
 
 struct TestCase{
@@ -2155,16 +2445,17 @@ struct TestCase{
   String expectedNormalized;
 };
 
-void TestSymbolic(){
+int TestSymbolic(){
   TEMP_REGION(temp,nullptr);
+  int failed = 0;
 
   TestCase cases[] = {
     {"a+b+c+d","a+b+c+d"},
-    {"a-a-b-b-2*c-c","-(2*b-(3*c))"},
+    {"a-a-b-b-2*c-c","-(2*b)-(3*c)"},
     {"a+a+b+b+2*c+c","2*a+2*b+3*c"},
     {"a*b + a * b","2*a*b"},
     {"-a * b - a * b","-(2*a*b)"},
-    {"-((1*x)*(3-1))+1*y","-(2*x+y)"},
+    {"-((1*x)*(3-1))+1*y","-(2*x)+y"},
     {"-a-b-(a-b)-(-a+b)-(-(a-b)-(-a+b)+(a-b) + (-a+b))","-(a)-(b)"},
     {"(a-b)*(a-b)","a*a-(2*a*b)+b*b"},
     {"a*b + a*b + 2*a*b","4*a*b"},
@@ -2179,9 +2470,8 @@ void TestSymbolic(){
     {"(x*y)/x","y"},
   };
 
-  bool printNormalizeProcess = true;
+  bool printNormalizeProcess = false;
  
-  printf("\n");
   for(TestCase c : cases){
     BLOCK_REGION(temp);
     SymbolicExpression* sym = ParseSymbolicExpression(c.input,temp);
@@ -2189,30 +2479,69 @@ void TestSymbolic(){
 
     String repr = PushRepresentation(normalized,temp);
 
-    if(CompareString(repr,c.expectedNormalized)){
-      printf("OK");
-    } else {
-      printf("Different\n");      
-
-      printf("Start:");
+    TEST_CHECK(failed,CompareString(repr,c.expectedNormalized));
+    if(!CompareString(repr,c.expectedNormalized)){
+      printf("  Start:");
       Print(sym);
-      printf("\nEnd  :");
+      printf("\n  End  :");
       Print(normalized);
-
-#if 1
-      printf("\nExpec:%.*s\n",UN(c.expectedNormalized));
-      PrintAST(normalized);
+      printf("\n  Expec:%.*s\n",UN(c.expectedNormalized));
 
       if(printNormalizeProcess){
         printf("Proccess:\n");
         Normalize(sym,temp,true);
         printf("\n");
       }
-#endif
     }
 
-    printf("\n");
+    // Normalized expressions are already normal
+    TEST_CHECK(failed,ExpressionEqual(Normalize(normalized,temp),normalized));
+  }
+
+  SymbolicStore* store = GetSymbolicStore();
+
+  // Equal structures intern to the same node, no matter where they come from
+  {
+    BLOCK_REGION(temp);
+    SymbolicExpression* first = Intern(ParseSymbolicExpression("a*(b+2)-ALIGN(x,4)",temp));
+    SymbolicExpression* second = Intern(ParseSymbolicExpression("a*(b+2)-ALIGN(x,4)",temp));
+    SymbolicExpression* other = Intern(ParseSymbolicExpression("a*(b+2)-ALIGN(y,4)",temp));
+
+    TEST_CHECK(failed,first == second);
+    TEST_CHECK(failed,first != other);
+    TEST_CHECK(failed,first->interned && !ExpressionEqual(first,other));
+    TEST_CHECK(failed,Intern(ParseSymbolicExpression("0",temp)) == Intern(ParseSymbolicExpression("-0",temp)));
+  }
+
+  // Results are memoized and the caller receives a copy that it can modify
+  {
+    BLOCK_REGION(temp);
+    SymbolicExpression* sym = ParseSymbolicExpression("(a-b)*(a-b)",temp);
+    SymbolicExpression* first = Normalize(sym,temp);
+    TEST_CHECK(failed,store->normalized->Get(Intern(sym)) != nullptr);
+
+    SymbolicExpression* second = Normalize(sym,temp);
+    TEST_CHECK(failed,first != second && !first->interned && !second->interned);
+    TEST_CHECK(failed,ExpressionEqual(first,second));
+
+    first->negative = !first->negative;
+    TEST_CHECK(failed,ExpressionEqual(Normalize(sym,temp),second));
   }
+
+  // Emptying the store does not change the results
+  {
+    BLOCK_REGION(temp);
+    SymbolicExpression* sym = ParseSymbolicExpression("a*b + a*b + 2*a*b",temp);
+    String before = PushRepresentation(Normalize(sym,temp),temp);
+
+    ResetSymbolicStore(store);
+    TEST_CHECK(failed,store->nodes->inserted == 0 && store->normalized->inserted == 0);
+
+    String after = PushRepresentation(Normalize(sym,temp),temp);
+    TEST_CHECK(failed,CompareString(before,after));
+  }
+
+  return failed;
 }
 
 Array<String> GetAllSymbols(SymbolicExpression* expr,Arena* out){
@@ -2453,6 +2782,184 @@ SymbolicExpression* GetLoopLinearSumTotalSize(LoopLinearSum* in,Arena* out){
   return result;
 }
 
+CompiledLoopLinearSum* CompileLoopLinearSum(LoopLinearSum* sum,Array<String> inputVariables,Arena* out){
+  TEMP_REGION(temp,out);
+
+  int loops = sum->terms.size;
+  
+  CompiledLoopLinearSum* res = PushStruct<CompiledLoopLinearSum>(out);
+  res->slots = PushArray<String>(out,inputVariables.size + loops);
+  res->firstLoopSlot = inputVariables.size;
+  for(int i = 0; i < inputVariables.size; i++){
+    res->slots[i] = inputVariables[i];
+  }
+  for(int i = 0; i < loops; i++){
+    res->slots[res->firstLoopSlot + i] = sum->terms[i].var;
+  }
+
+  SymbolicExpression* fullExpression = TransformIntoSymbolicExpression(sum,temp);
+  res->address = CompileSymbolicExpression(fullExpression,res->slots,out);
+
+  res->loopStart = PushArray<SymbolicProgram*>(out,loops);
+  res->loopEnd = PushArray<SymbolicProgram*>(out,loops);
+  for(int i = 0; i < loops; i++){
+    res->loopStart[i] = CompileSymbolicExpression(sum->terms[i].loopStart,res->slots,out);
+    res->loopEnd[i] = CompileSymbolicExpression(sum->terms[i].loopEnd,res->slots,out);
+  }
+
+  // The address is linear on the innermost loop variable as long as no term depends on loop variables, meaning that consecutive iterations differ by a constant step.
+  res->incremental = (loops > 0);
+  auto CheckNoLoopVariables = [&](SymbolicExpression* expr){
+    SymbolicProgram* program = CompileSymbolicExpression(expr,res->slots,temp);
+    for(int i = 0; i < loops; i++){
+      if(ProgramUsesSlot(program,res->firstLoopSlot + i)){
+        res->incremental = false;
+      }
+    }
+  };
+  
+  for(LoopLinearSumTerm term : sum->terms){
+    CheckNoLoopVariables(term.term);
+  }
+  CheckNoLoopVariables(sum->freeTerm);
+  
+  return res;
+}
+
+Array<int> SimulateLoopLinearSum(CompiledLoopLinearSum* compiled,Array<int> inputValues,Arena* out){
+  TEMP_REGION(temp,out);
+
+  Array<int> slots = PushArray<int>(temp,compiled->slots.size);
+  for(int i = 0; i < inputValues.size; i++){
+    slots[i] = inputValues[i];
+  }
+  
+  auto Recurse = [compiled,slots](auto Recurse,GrowableArray<int>& values,int loopIndex) -> void{
+    if(loopIndex < 0){
+      *values.PushElem() = Evaluate(compiled->address,slots);
+      return;
+    }
+
+    int loopStart = Evaluate(compiled->loopStart[loopIndex],slots);
+    int loopEnd = Evaluate(compiled->loopEnd[loopIndex],slots);
+
+    Assert(loopStart <= loopEnd);
+
+    int slot = compiled->firstLoopSlot + loopIndex;
+    if(loopIndex == 0 && compiled->incremental && loopEnd - loopStart >= 2){
+      slots[slot] = loopStart;
+      int address = Evaluate(compiled->address,slots);
+      slots[slot] = loopStart + 1;
+      int step = Evaluate(compiled->address,slots) - address;
+
+      for(int i = loopStart; i < loopEnd; i++){
+        *values.PushElem() = address;
+        address += step;
+      }
+      slots[slot] = loopEnd - 1;
+      return;
+    }
+    
+    for(int i = loopStart; i < loopEnd; i++){
+      slots[slot] = i;
+      Recurse(Recurse,values,loopIndex - 1);
+    }
+  };
+
+  GrowableArray<int> builder = StartArray<int>(out);
+  Recurse(Recurse,builder,compiled->loopStart.size - 1);
+  Array<int> values = EndArray(builder);
+
+  return values;
+}
+
+// Tree evaluation of every address of sum, used to check the compiled simulation
+static void TestEnumerateLoopLinearSum(LoopLinearSum* sum,SymbolicExpression* address,Hashmap<String,int>* values,int loopIndex,GrowableArray<int>& out){
+  if(loopIndex < 0){
+    *out.PushElem() = Evaluate(address,values);
+    return;
+  }
+
+  LoopLinearSumTerm term = sum->terms[loopIndex];
+  int start = Evaluate(term.loopStart,values);
+  int end = Evaluate(term.loopEnd,values);
+  for(int i = start; i < end; i++){
+    values->Insert(term.var,i);
+    TestEnumerateLoopLinearSum(sum,address,values,loopIndex - 1,out);
+  }
+}
+
+int TestSymbolicProgram(){
+  TEMP_REGION(temp,nullptr);
+  int failed = 0;
+
+  String variables[] = {"x","y","z"};
+  Array<String> slots = {variables,3};
+
+  // Denominators are never zero for the values used
+  const char* expressions[] = {
+    "12",
+    "x",
+    "-x",
+    "x+y*z",
+    "-(x*y)-(3*z)+7",
+    "(x*4+y)/(z*z+1)",
+    "x*(y-(2*z))/3",
+    "-(x+y)/(1+z*z)",
+    "ALIGN(x*4+y,8)",
+    "x-ALIGN(y,z)+ALIGN(ALIGN(x,3),z*z)"
+  };
+
+  for(const char* str : expressions){
+    BLOCK_REGION(temp);
+    SymbolicExpression* expr = ParseSymbolicExpression(String(str),temp);
+    SymbolicProgram* program = CompileSymbolicExpression(expr,slots,temp);
+
+    for(int i = 0; i < 50; i++){
+      Array<int> slotValues = PushArray<int>(temp,slots.size);
+      Hashmap<String,int>* values = PushHashmap<String,int>(temp,slots.size);
+      for(int ii = 0; ii < slots.size; ii++){
+        slotValues[ii] = RandomNumberBetween(-20,21);
+        values->Insert(slots[ii],slotValues[ii]);
+      }
+
+      TEST_CHECK(failed,Evaluate(program,slotValues) == Evaluate(expr,values));
+    }
+  }
+
+  // Address gen loops, first with a constant step (incremental simulation) and then with an inner term that depends on the outer loop
+  const char* innerTerms[] = {"2","j+1"};
+  for(const char* innerTerm : innerTerms){
+    BLOCK_REGION(temp);
+
+    String inputs[] = {"n","m","s"};
+    Array<String> inputVariables = {inputs,3};
+    int inputValues[] = {5,3,7};
+    
+    LoopLinearSum* inner = PushLoopLinearSumSimpleVar("i",ParseSymbolicExpression(String(innerTerm),temp),SYM_zero,ParseSymbolicExpression(String("n"),temp),temp);
+    LoopLinearSum* outer = PushLoopLinearSumSimpleVar("j",ParseSymbolicExpression(String("s"),temp),SYM_one,ParseSymbolicExpression(String("m+1"),temp),temp);
+    LoopLinearSum* sum = AddLoopLinearSum(inner,outer,temp);
+    sum->freeTerm = ParseSymbolicExpression(String("ALIGN(n,4)"),temp);
+
+    CompiledLoopLinearSum* compiled = CompileLoopLinearSum(sum,inputVariables,temp);
+    TEST_CHECK(failed,compiled->incremental == (innerTerm == innerTerms[0]));
+    Array<int> simulated = SimulateLoopLinearSum(compiled,{inputValues,3},temp);
+
+    Hashmap<String,int>* values = PushHashmap<String,int>(temp,5);
+    for(int i = 0; i < inputVariables.size; i++){
+      values->Insert(inputVariables[i],inputValues[i]);
+    }
+    GrowableArray<int> builder = StartArray<int>(temp);
+    TestEnumerateLoopLinearSum(sum,TransformIntoSymbolicExpression(sum,temp),values,sum->terms.size - 1,builder);
+    Array<int> expected = EndArray(builder);
+
+    TEST_CHECK(failed,simulated.size == 15 && expected.size == 15);
+    TEST_CHECK(failed,simulated.size == expected.size && Memcmp(simulated.data,expected.data,expected.size));
+  }
+
+  return failed;
+}
+
 void Print(LoopLinearSum* sum,bool printNewLine){
   TEMP_REGION(temp,nullptr);
 
@@ -39,6 +39,8 @@ struct SymbolicReprAtom{
 struct SymbolicExpression{
   SymbolicExpressionType type;
   bool negative;
+  bool interned; // Node is owned by the hash-consed store used by Normalize and is shared. Never seen outside of symbolic.cpp
+  int nameId; // Interned id of variable or name. Only valid if interned
 
   // All these should be inside a union. Not handling this for now
   int literal;
@@ -71,6 +73,35 @@ Array<SymbolicReprAtom> CompileRepresentation(SymbolicExpression* expr,Arena* ou
 
 int Evaluate(SymbolicExpression* expr,Hashmap<String,int>* values);
 
+enum SymbolicOpcode{
+  SymbolicOpcode_LITERAL, // value
+  SymbolicOpcode_LOAD,    // slots[value]
+  SymbolicOpcode_ADD,     // left + right
+  SymbolicOpcode_MUL,     // left * right
+  SymbolicOpcode_DIV,     // left / right
+  SymbolicOpcode_NEGATE,  // -left
+  SymbolicOpcode_ALIGN    // ALIGN(left,right)
+};
+
+// Left and right are the indexes of the instructions that produce the operands. Each instruction writes to the register with the same index as itself.
+struct SymbolicInstruction{
+  SymbolicOpcode op;
+  int left;
+  int right;
+  int value;
+};
+
+// Flat form of a symbolic expression, with variables resolved to slot indexes at compile time so evaluation performs no lookups.
+// The result is the value of the last instruction. Programs are never modified after compiled and can be evaluated by multiple threads at the same time.
+struct SymbolicProgram{
+  Array<SymbolicInstruction> instructions;
+};
+
+// Every variable in expr must be inside slots. If a name appears multiple times, the last one is used. ALIGN is the only function supported.
+SymbolicProgram* CompileSymbolicExpression(SymbolicExpression* expr,Array<String> slots,Arena* out);
+int Evaluate(SymbolicProgram* program,Array<int> slots);
+bool ProgramUsesSlot(SymbolicProgram* program,int slot);
+
 SymbolicExpression* PushLiteral(Arena* out,int value,bool negate = false);
 SymbolicExpression* PushVariable(Arena* out,String name,bool negate = false);
 
@@ -93,6 +124,7 @@ SymbolicExpression* SymbolicDeepCopy(SymbolicExpression* expr,Arena* out);
 // Use this function to get the literal value of a literal type expression, takes into account negation.
 int GetLiteralValue(SymbolicExpression* expr);
 
+// Structural compare. Nodes interned by Normalize are compared by pointer, but those never leave symbolic.cpp.
 bool ExpressionEqual(SymbolicExpression* left,SymbolicExpression* right);
 bool IsZero(SymbolicExpression* expr);
 
@@ -113,13 +145,14 @@ SymbolicExpression* MoveDivToTop(SymbolicExpression* base,Arena* out);
 SymbolicExpression* NormalizeLiterals(SymbolicExpression* expr,Arena* out);
 SymbolicExpression* SymbolicReplace(SymbolicExpression* base,String varToReplace,SymbolicExpression* replacingExpr,Arena* out);
 SymbolicExpression* ReplaceVariables(SymbolicExpression* expr,Hashmap<String,SymbolicExpression*>* values,Arena* out);
+// Runs the normalization passes until they stop changing the expression. Results are memoized per thread and the caller receives a copy that it can modify.
 SymbolicExpression* Normalize(SymbolicExpression* expr,Arena* out,bool debugPrint = false);
 SymbolicExpression* Derivate(SymbolicExpression* expr,String base,Arena* out);
 
 // Are allowed to call normalize
 SymbolicExpression* Group(SymbolicExpression* expr,String variableToGroupWith,Arena* out);
 
-void TestSymbolic();
+int TestSymbolic();
 
 Array<String> GetAllSymbols(SymbolicExpression* expr,Arena* out);
 
@@ -152,9 +185,26 @@ SymbolicExpression* TransformIntoSymbolicExpression(LoopLinearSum* sum,Arena* ou
 
 SymbolicExpression* GetLoopLinearSumTotalSize(LoopLinearSum* in,Arena* out);
 
+// Slots are the input variables followed by the loop variables, innermost loop first.
+struct CompiledLoopLinearSum{
+  Array<String> slots;
+  int firstLoopSlot;
+  SymbolicProgram* address;
+  Array<SymbolicProgram*> loopStart;
+  Array<SymbolicProgram*> loopEnd;
+  bool incremental; // Innermost loop can be computed by adding a constant step instead of evaluating the address
+};
+
+CompiledLoopLinearSum* CompileLoopLinearSum(LoopLinearSum* sum,Array<String> inputVariables,Arena* out);
+
+// Returns every address generated by the loops, in the order they are generated.
+Array<int> SimulateLoopLinearSum(CompiledLoopLinearSum* compiled,Array<int> inputValues,Arena* out);
+
 void Print(LoopLinearSum* sum,bool printNewLine = false);
 void Repr(StringBuilder* builder,LoopLinearSum* sum);
 
+int TestSymbolicProgram();
+
 // ============================================================================
 // Global special Symbolic Expressions 
 
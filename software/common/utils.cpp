@@ -5,6 +5,8 @@
 //#include "parser.hpp"
 #include "signal.h"
 #include <dirent.h>
+#include <unistd.h>
+#include <atomic>
 
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -127,6 +129,21 @@ String OS_NormalizePath(String in,Arena* out){
   return res;
 }
 
+String CreateTemporaryDirectory(String name,Arena* out){
+  static std::atomic<int> counter(0);
+
+  fs::path path = fs::temp_directory_path() / SF("%.*s_%d_%d",UN(name),(int) getpid(),counter.fetch_add(1));
+  fs::remove_all(path);
+  fs::create_directories(path);
+
+  return PushString(out,"%s",path.c_str());
+}
+
+void RemoveDirectory(String path){
+  std::error_code error;
+  fs::remove_all(fs::path(CS(path)),error);
+}
+
 Opt<Array<String>> GetAllFilesInsideDirectory(String dirPath,Arena* out){
    DIR* dir = opendir(StaticFormat("%.*s",UN(dirPath))); // Make sure it's zero terminated
 
@@ -19,6 +19,10 @@ String OS_NormalizePath(String in,Arena* out);
 
 Opt<Array<String>> GetAllFilesInsideDirectory(String dirPath,Arena* out);
 
+// Mainly for the self tests. The folder is unique to this process and RemoveDirectory deletes it with everything inside
+String CreateTemporaryDirectory(String name,Arena* out);
+void RemoveDirectory(String path);
+
 String PushEscapedString(Arena* out,String toEscape,char spaceSubstitute);
 void   PrintEscapedString(String toEscape,char spaceSubstitute);
 
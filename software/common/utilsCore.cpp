@@ -42,11 +42,11 @@ String Offset(String base,int amount){
 
 char* StaticFormat(const char* format,...){
   static const int BUFFER_SIZE = 1024*4;
-  static char buffer[BUFFER_SIZE];
-  static char buffer2[BUFFER_SIZE];
-  static char buffer3[BUFFER_SIZE];
-  static char buffer4[BUFFER_SIZE];
-  static int currentBuffer = 0;
+  static thread_local char buffer[BUFFER_SIZE];
+  static thread_local char buffer2[BUFFER_SIZE];
+  static thread_local char buffer3[BUFFER_SIZE];
+  static thread_local char buffer4[BUFFER_SIZE];
+  static thread_local int currentBuffer = 0;
   
   va_list args;
   va_start(args,format);
@@ -194,7 +194,7 @@ void CreateDirectories(const char* path){
 }
 
 static char* GetNumberRepr(u64 number){
-  static char buffer[32];
+  static thread_local char buffer[32];
 
   if(number == 0){
     buffer[0] = '0';
@@ -285,15 +285,24 @@ Time operator-(const Time& s1,const Time& s2){
   return res;
 }
 
+double ToSeconds(Time time){
+  double res = (double) time.seconds + ((double) time.microSeconds / 1000000.0);
+  return res;
+}
+
+double ElapsedSeconds(Time start){
+  return ToSeconds(GetTime() - start);
+}
+
 Time operator+(const Time& s1,const Time& s2){
   Time res = {};
   
   res.seconds = s1.seconds + s2.seconds;
   res.microSeconds = s1.microSeconds + s2.microSeconds;
 
-  if(res.microSeconds > 1000000){
+  if(res.microSeconds >= 1000000){
     res.seconds += res.microSeconds / 1000000;
-    res.microSeconds %= res.microSeconds;
+    res.microSeconds %= 1000000;
   }
   
   return res;
@@ -735,3 +744,58 @@ bool IsAlpha(char ch){
   return false;
 }
 
+
+CacheReader StartCacheReader(String content){
+  CacheReader reader = {};
+  reader.ptr = content.data;
+  reader.end = content.data + content.size;
+  return reader;
+}
+
+i64 CacheReadInt(CacheReader* reader){
+  char* end = nullptr;
+  long long val = strtoll(reader->ptr,&end,10);
+  if(end == reader->ptr){
+    reader->error = true;
+  }
+  reader->ptr = end;
+  return (i64) val;
+}
+
+u64 CacheReadHex(CacheReader* reader){
+  char* end = nullptr;
+  unsigned long long val = strtoull(reader->ptr,&end,16);
+  if(end == reader->ptr){
+    reader->error = true;
+  }
+  reader->ptr = end;
+  return (u64) val;
+}
+
+void CacheReadWord(CacheReader* reader,const char* expected){
+  while(*reader->ptr == ' ' || *reader->ptr == '\n'){
+    reader->ptr += 1;
+  }
+  int size = strlen(expected);
+  if(strncmp(reader->ptr,expected,size) != 0){
+    reader->error = true;
+    return;
+  }
+  reader->ptr += size;
+}
+
+String CacheReadString(CacheReader* reader){
+  i64 size = CacheReadInt(reader);
+  if(reader->error || size < 0 || *reader->ptr != ':' || size > reader->end - reader->ptr - 1){
+    reader->error = true;
+    return {};
+  }
+
+  String res = String(reader->ptr + 1,(int) size);
+  reader->ptr += size + 1;
+  return res;
+}
+
+void CacheWriteString(FILE* file,String str){
+  fprintf(file,"%d:%.*s",str.size,str.size,str.data);
+}
@@ -320,6 +320,9 @@ Time operator+(const Time& s1,const Time& s2);
 bool operator>(const Time& s1,const Time& s2);
 bool operator==(const Time& s1,const Time& s2);
 
+double ToSeconds(Time time);
+double ElapsedSeconds(Time start); // Seconds since start
+
 static constexpr Time Seconds(u64 seconds){Time t = {}; t.seconds = seconds; return t;};
 static constexpr Time MilliSeconds(u64 milli){Time t = {}; t.microSeconds = milli * 1000; return t;};
 
@@ -423,6 +426,45 @@ public:
    }
 };
 
+// djb2. Unlike std::hash, the value only depends on the data, which is needed for anything persisted between runs.
+#define STABLE_HASH_START 5381
+
+inline u64 StableHashBytes(const void* data,size_t size,u64 hash = STABLE_HASH_START){
+   const unsigned char* bytes = (const unsigned char*) data;
+   for(size_t i = 0; i < size; i++){
+      hash = ((hash << 5) + hash) + bytes[i];
+   }
+   return hash;
+}
+
+inline u64 StableHashInt(i64 val,u64 hash = STABLE_HASH_START){
+   return StableHashBytes(&val,sizeof(val),hash);
+}
+
+// Size is also hashed, otherwise ("ab","c") and ("a","bc") would give the same hash
+inline u64 StableHashString(String str,u64 hash = STABLE_HASH_START){
+   hash = StableHashInt(str.size,hash);
+   return StableHashBytes(str.data,str.size,hash);
+}
+
+// Reading of the text files kept in the cache folder. Entries can be stale or broken, so
+// malformed input only sets error and the caller is expected to throw the entry away.
+// Content must be null terminated.
+struct CacheReader{
+   const char* ptr;
+   const char* end;
+   bool error;
+};
+
+CacheReader StartCacheReader(String content);
+i64 CacheReadInt(CacheReader* reader);
+u64 CacheReadHex(CacheReader* reader);
+void CacheReadWord(CacheReader* reader,const char* expected);
+String CacheReadString(CacheReader* reader); // Points inside the content
+
+// Strings are written as "size:data" so that any character can appear inside
+void CacheWriteString(FILE* file,String str);
+
 inline bool operator==(String first,String second){
    if(first.size != second.size){
       return false;
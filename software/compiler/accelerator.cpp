@@ -7,18 +7,23 @@
 #include "versat.hpp"
 
 #include "symbolic.hpp"
+#include "thread.hpp"
 
 #define TAG_TEMPORARY 1
 #define TAG_PERMANENT 2
 
 static Pool<Accelerator> accelerators;
+static Mutex acceleratorsMutex = {PTHREAD_MUTEX_INITIALIZER};
 
 Accelerator* CreateAccelerator(String name,AcceleratorPurpose purpose){
   static int globalID = 0;
+
+  LockMutex(&acceleratorsMutex);
   Accelerator* accel = accelerators.Alloc();
+  accel->id = globalID++;
+  UnlockMutex(&acceleratorsMutex);
   
   accel->accelMemory = CreateDynamicArena(1);
-  accel->id = globalID++;
   
   accel->name = PushString(accel->accelMemory,name);
   accel->purpose = purpose;
@@ -77,7 +82,6 @@ void SetStatic(FUInstance* inst){
 }
 
 FUInstance* CreateFUInstance(Accelerator* accel,FUDeclaration* type,String name){
-  static int globalID = 0;
   String storedName = PushString(accel->accelMemory,name);
 
   Assert(CheckValidName(storedName));
@@ -95,7 +99,7 @@ FUInstance* CreateFUInstance(Accelerator* accel,FUDeclaration* type,String name)
   inst->name = storedName;
   inst->accel = accel;
   inst->declaration = type;
-  inst->id = globalID++;
+  inst->id = accel->nextInstanceId++;
 
   inst->isSpecificConfigShared = PushArray<bool>(globalPermanent,type->configs.size);
   Memset(inst->isSpecificConfigShared,false);
@@ -186,6 +190,7 @@ FUInstance* CopyInstance(Accelerator* accel,FUInstance* oldInstance,bool preserv
   
   if(preserveIds){
     newInst->id = oldInstance->id;
+    accel->nextInstanceId = std::max(accel->nextInstanceId,oldInstance->id + 1);
   }
   newInst->isMergeMultiplexer = oldInstance->isMergeMultiplexer;
   newInst->addressGenUsed = oldInstance->addressGenUsed;
@@ -262,17 +267,17 @@ Array<int> ExtractOutputLatencies(Accelerator* accel,CalculateDelayResult delays
 }
 
 // TODO: This functions should have actual error handling and reporting. Instead of just Asserting.
-static int Visit(Array<FUInstance*> ordering,int& nodesFound,FUInstance* node,Hashmap<FUInstance*,int>* tags){
-  int* tag = tags->Get(node);
-  Assert(tag);
+static int Visit(AcceleratorGraph* graph,Array<int> ordering,int& nodesFound,int index,Array<int> tags){
+  int& tag = tags[index];
 
-  if(*tag == TAG_PERMANENT){
+  if(tag == TAG_PERMANENT){
     return 0;
   }
-  if(*tag == TAG_TEMPORARY){
+  if(tag == TAG_TEMPORARY){
     Assert(0);
   }
 
+  FUInstance* node = graph->instances[index];
   FUInstance* inst = node;
 
   if(node->type == NodeType_SINK ||
@@ -280,19 +285,19 @@ static int Visit(Array<FUInstance*> ordering,int& nodesFound,FUInstance* node,Ha
     return 0;
   }
 
-  *tag = TAG_TEMPORARY;
+  tag = TAG_TEMPORARY;
 
   int count = 0;
   if(node->type == NodeType_COMPUTE){
-    FOREACH_LIST(ConnectionNode*,ptr,node->allInputs){
-      count += Visit(ordering,nodesFound,ptr->instConnectedTo.inst,tags);
+    for(GraphConnection& conn : graph->Inputs(index)){
+      count += Visit(graph,ordering,nodesFound,conn.other,tags);
     }
   }
 
-  *tag = TAG_PERMANENT;
+  tag = TAG_PERMANENT;
 
   if(node->type == NodeType_COMPUTE){
-    ordering[nodesFound++] = node;
+    ordering[nodesFound++] = index;
     count += 1;
   }
 
@@ -300,101 +305,104 @@ static int Visit(Array<FUInstance*> ordering,int& nodesFound,FUInstance* node,Ha
 }
 
 DAGOrderNodes CalculateDAGOrder(Accelerator* accel,Arena* out){
-  Pool<FUInstance>* instances = &accel->allocated;
-  int size = instances->Size();
+  TEMP_REGION(temp,out);
+
+  AcceleratorGraph* graph = CreateAcceleratorGraph(accel,temp);
+  return CalculateDAGOrder(graph,out);
+}
+
+DAGOrderNodes CalculateDAGOrder(AcceleratorGraph* graph,Arena* out){
+  TEMP_REGION(temp,out);
+  int size = graph->Size();
 
   DAGOrderNodes res = {};
   
-  res.size = 0;
+  res.size = size;
   res.instances = PushArray<FUInstance*>(out,size);
   res.order = PushArray<int>(out,size);
 
+  // Graph index of the instances in the order that they are found
+  Array<int> ordering = PushArray<int>(temp,size);
   int nodesFound = 0;
   
-  // NOTE: Could replace Hashmap with an array and add a Pool function to get the index from a ptr.
-  Hashmap<FUInstance*,int>* tags = PushHashmap<FUInstance*,int>(out,size);
-
-  for(FUInstance* ptr : *instances){
-    res.size += 1;
-    tags->Insert(ptr,0);
-  }
+  Array<int> tags = PushArray<int>(temp,size);
+  Memset(tags,0);
 
   // Add source units, guaranteed to come first
-  for(FUInstance* ptr : *instances){
-    FUInstance* inst = ptr;
-    if(ptr->type == NodeType_SOURCE || (ptr->type == NodeType_SOURCE_AND_SINK && CHECK_DELAY(inst,DelayType::DelayType_SOURCE_DELAY))){
-      res.instances[nodesFound++] = ptr;
+  for(int i = 0; i < size; i++){
+    FUInstance* inst = graph->instances[i];
+    if(inst->type == NodeType_SOURCE || (inst->type == NodeType_SOURCE_AND_SINK && CHECK_DELAY(inst,DelayType::DelayType_SOURCE_DELAY))){
+      ordering[nodesFound++] = i;
 
-      tags->Insert(ptr,TAG_PERMANENT);
+      tags[i] = TAG_PERMANENT;
     }
   }
-  res.sources = {};
-  res.sources.data = res.instances.data;
-  res.sources.size = nodesFound;
+  int sourcesSize = nodesFound;
 
   int computeIndexStart = nodesFound;
-  FUInstance** computeStart = res.sources.data + res.sources.size;
   // Add compute units
-  for(FUInstance* ptr : *instances){
-    if(ptr->type == NodeType_UNCONNECTED){
-      res.instances[nodesFound++] = ptr;
-      tags->Insert(ptr,TAG_PERMANENT);
+  for(int i = 0; i < size; i++){
+    FUInstance* inst = graph->instances[i];
+    if(inst->type == NodeType_UNCONNECTED){
+      ordering[nodesFound++] = i;
+      tags[i] = TAG_PERMANENT;
     } else {
-      int tag = tags->GetOrFail(ptr);
-      if(tag == 0 && ptr->type == NodeType_COMPUTE){
-        Visit(res.instances,nodesFound,ptr,tags);
+      if(tags[i] == 0 && inst->type == NodeType_COMPUTE){
+        Visit(graph,ordering,nodesFound,i,tags);
       }
     }
   }
-  res.computeUnits.data = computeStart;
-  res.computeUnits.size = nodesFound - computeIndexStart;
+  int computeSize = nodesFound - computeIndexStart;
   
   int sinkIndexStart = nodesFound;
-  FUInstance** sinkStart = res.computeUnits.data + res.computeUnits.size;
   // Add sink units
-  for(FUInstance* ptr : *instances){
-    FUInstance* inst = ptr;
-    if(ptr->type == NodeType_SINK || (ptr->type == NodeType_SOURCE_AND_SINK && CHECK_DELAY(inst,DelayType::DelayType_SINK_DELAY))){
-      res.instances[nodesFound++] = ptr;
-
-      int* tag = tags->Get(ptr);
-      Assert(*tag == 0);
+  for(int i = 0; i < size; i++){
+    FUInstance* inst = graph->instances[i];
+    if(inst->type == NodeType_SINK || (inst->type == NodeType_SOURCE_AND_SINK && CHECK_DELAY(inst,DelayType::DelayType_SINK_DELAY))){
+      ordering[nodesFound++] = i;
 
-      *tag = TAG_PERMANENT;
+      Assert(tags[i] == 0);
+      tags[i] = TAG_PERMANENT;
     }
   }
-  res.sinks.data = sinkStart;
-  res.sinks.size = nodesFound - sinkIndexStart;
+  int sinksSize = nodesFound - sinkIndexStart;
 
-  for(FUInstance* ptr : *instances){
-    int tag = tags->GetOrFail(ptr);
-    Assert(tag == TAG_PERMANENT);
+  for(int i = 0; i < size; i++){
+    Assert(tags[i] == TAG_PERMANENT);
   }
 
-  Assert(res.sources.size + res.computeUnits.size + res.sinks.size == size);
+  Assert(sourcesSize + computeSize + sinksSize == size);
+
+  for(int i = 0; i < size; i++){
+    res.instances[i] = graph->instances[ordering[i]];
+  }
+  res.sources = {res.instances.data,sourcesSize};
+  res.computeUnits = {res.instances.data + computeIndexStart,computeSize};
+  res.sinks = {res.instances.data + sinkIndexStart,sinksSize};
 
-  // Reuse tags hashmap
-  Hashmap<FUInstance*,int>* orderIndex = tags;
-  orderIndex->Clear();
+  // Position inside res.instances, indexed by graph index. Only set after a node is processed, to detect any potential error.
+  Array<int> position = PushArray<int>(temp,size);
+  Memset(position,-1);
 
   res.maxOrder = 0;
   for(int i = 0; i < size; i++){
-    FUInstance* node = res.instances[i];
+    int node = ordering[i];
 
     int order = 0;
-    FOREACH_LIST(ConnectionNode*,ptr,node->allInputs){
-      FUInstance* other = ptr->instConnectedTo.inst;
+    for(GraphConnection& conn : graph->Inputs(node)){
+      FUInstance* other = graph->instances[conn.other];
 
       if(other->type == NodeType_SOURCE_AND_SINK){
         continue;
       }
 
-      int index = orderIndex->GetOrFail(other);
+      int index = position[conn.other];
+      Assert(index != -1);
 
       order = std::max(order,res.order[index]);
     }
 
-    orderIndex->Insert(node,i); // Only insert after to detect any potential error.
+    position[node] = i;
     res.order[i] = order;
     res.maxOrder = std::max(res.maxOrder,order);
   }
@@ -422,7 +430,9 @@ bool IsUnitCombinatorial(FUInstance* instance){
 void FixDelays(Accelerator* accel,Hashmap<Edge,DelayInfo>* edgeDelays){
   TEMP_REGION(temp,nullptr);
 
-  int buffersInserted = 0;
+  // Edges that leave the same port share a chain of buffers, each edge taps the chain at the buffer that ends at its delay.
+  Hashmap<PortInstance,ArenaList<Pair<PortInstance,int>>*>* delaysByPort = PushHashmap<PortInstance,ArenaList<Pair<PortInstance,int>>*>(temp,edgeDelays->nodesUsed);
+  
   for(auto edgePair : edgeDelays){
     Edge edge = edgePair.first;
     int delay = edgePair.second->value;
@@ -443,29 +453,172 @@ void FixDelays(Accelerator* accel,Hashmap<Edge,DelayInfo>* edgeDelays){
     }
     Assert(delay > 0); // Cannot deal with negative delays at this stage.
 
-    FUInstance* buffer = nullptr;
-    if(globalOptions.useFixedBuffers){
-      String bufferName = PushString(globalPermanent,"fixedBuffer%d",buffersInserted);
+    GetOrAllocateResult<ArenaList<Pair<PortInstance,int>>*> res = delaysByPort->GetOrAllocate(edge.units[0]);
+    if(!res.alreadyExisted){
+      *res.data = PushArenaList<Pair<PortInstance,int>>(temp);
+    }
+    *(*res.data)->PushElem() = {edge.units[1],delay};
+  }
+  
+  int buffersInserted = 0;
+  for(auto p : delaysByPort){
+    PortInstance start = p.first;
+    Array<Pair<PortInstance,int>> taps = PushArrayFromList(temp,*p.second);
+
+    // Buffers are added by increasing delay, each one adds the delay missing since the previous one
+    PortInstance chainEnd = start;
+    int chainDelay = 0;
+    while(true){
+      int delay = -1;
+      for(Pair<PortInstance,int> tap : taps){
+        if(tap.second > chainDelay && (delay == -1 || tap.second < delay)){
+          delay = tap.second;
+        }
+      }
+
+      if(delay == -1){
+        break;
+      }
 
-      buffer = CreateFUInstance(accel,BasicDeclaration::fixedBuffer,bufferName);
-      buffer->bufferAmount = delay - BasicDeclaration::fixedBuffer->info.infos[0].outputLatencies[0];
-      String bufferAmountString = PushString(globalPermanent,"%d",buffer->bufferAmount);
-      SetParameter(buffer,"AMOUNT",bufferAmountString);
-    } else {
-      String bufferName = PushString(globalPermanent,"buffer%d",buffersInserted);
+      FUInstance* buffer = nullptr;
+      if(globalOptions.useFixedBuffers){
+        String bufferName = PushString(globalPermanent,"fixedBuffer%d",buffersInserted);
+
+        buffer = CreateFUInstance(accel,BasicDeclaration::fixedBuffer,bufferName);
+        buffer->bufferAmount = delay - chainDelay - BasicDeclaration::fixedBuffer->info.infos[0].outputLatencies[0];
+        String bufferAmountString = PushString(globalPermanent,"%d",buffer->bufferAmount);
+        SetParameter(buffer,"AMOUNT",bufferAmountString);
+      } else {
+        String bufferName = PushString(globalPermanent,"buffer%d",buffersInserted);
+
+        buffer = CreateFUInstance(accel,BasicDeclaration::buffer,bufferName);
+        buffer->bufferAmount = delay - chainDelay - BasicDeclaration::buffer->info.infos[0].outputLatencies[0];
+        Assert(buffer->bufferAmount >= 0);
+        SetStatic(buffer);
+      }
+
+      ConnectUnits(chainEnd,MakePortIn(buffer,0));
+      for(Pair<PortInstance,int> tap : taps){
+        if(tap.second == delay){
+          RemoveConnection(accel,start.inst,start.port,tap.first.inst,tap.first.port);
+          ConnectUnits(MakePortOut(buffer,0),tap.first);
+        }
+      }
+
+      OutputDebugDotGraph(accel,SF("fixDelay_%d.dot",buffersInserted),buffer);
+
+      chainEnd = MakePortOut(buffer,0);
+      chainDelay = delay;
+      buffersInserted += 1;
+    }
+  }
+}
+
+static int LimitCombinatorialDepth(Accelerator* accel,int maxDepth,int* registersInserted);
+
+// Amount of combinatorial units that a value goes through inside the unit. Zero if the unit registers its outputs.
+static int CombinatorialDepth(FUDeclaration* decl){
+  if(decl == BasicDeclaration::input || decl == BasicDeclaration::output){
+    return 0;
+  }
+  
+  if(decl->NumberInputs() == 0 || decl->NumberOutputs() == 0){
+    return 0;
+  }
+
+  for(int latency : decl->GetOutputLatencies()){
+    if(latency != 0){
+      return 0;
+    }
+  }
+
+  if(!decl->fixedDelayCircuit){
+    return 1;
+  }
+
+  // Every instance of the declaration has the same depth. Parallel registrations can calculate it at the same time, but they store the same value
+  int cached = AtomicLoad(&decl->combinatorialDepth);
+  if(cached == 0){
+    cached = LimitCombinatorialDepth(decl->fixedDelayCircuit,0,nullptr) + 1;
+    AtomicStore(&decl->combinatorialDepth,cached);
+  }
+
+  return cached - 1;
+}
+
+// Returns the longest chain of combinatorial units. If maxDepth is positive, pipeline registers are inserted on the edges that would make a chain longer than maxDepth.
+static int LimitCombinatorialDepth(Accelerator* accel,int maxDepth,int* registersInserted){
+  TEMP_REGION(temp,nullptr);
+
+  DAGOrderNodes order = CalculateDAGOrder(accel,temp);
 
-      buffer = CreateFUInstance(accel,BasicDeclaration::buffer,bufferName);
-      buffer->bufferAmount = delay - BasicDeclaration::buffer->info.infos[0].outputLatencies[0];
-      Assert(buffer->bufferAmount >= 0);
-      SetStatic(buffer);
+  // Units not inserted start a new chain (depth zero), which includes the inserted registers.
+  Hashmap<FUInstance*,int>* depth = PushHashmap<FUInstance*,int>(temp,order.size);
+  // Registers are shared by every edge of the same output port that needs to be cut.
+  Hashmap<PortInstance,FUInstance*>* portRegister = PushHashmap<PortInstance,FUInstance*>(temp,order.size);
+
+  auto GetDepth = [depth](FUInstance* inst){
+    int* res = depth->Get(inst);
+    return res ? *res : 0;
+  };
+  
+  int maxDepthFound = 0;
+  for(FUInstance* inst : order.instances){
+    int unitDepth = CombinatorialDepth(inst->declaration);
+    if(unitDepth == 0){
+      continue;
     }
 
-    InsertUnit(accel,edge.units[0],edge.units[1],MakePortOut(buffer,0),MakePortIn(buffer,0));
+    ArenaList<ConnectionNode*>* toCut = PushArenaList<ConnectionNode*>(temp);
+    int maxInputDepth = 0;
+    FOREACH_LIST(ConnectionNode*,ptr,inst->allInputs){
+      int inputDepth = GetDepth(ptr->instConnectedTo.inst);
 
-    OutputDebugDotGraph(accel,SF("fixDelay_%d.dot",buffersInserted),buffer);
+      if(maxDepth > 0 && inputDepth > 0 && inputDepth + unitDepth > maxDepth){
+        *toCut->PushElem() = ptr;
+      } else {
+        maxInputDepth = std::max(maxInputDepth,inputDepth);
+      }
+    }
+
+    for(ConnectionNode* ptr : PushArrayFromList(temp,toCut)){
+      PortInstance before = ptr->instConnectedTo;
+      PortInstance after = MakePortIn(inst,ptr->port);
+      int edgeDelay = ptr->edgeDelay;
+
+      FUInstance** shared = portRegister->Get(before);
+      if(shared && edgeDelay == 0){
+        RemoveConnection(accel,before.inst,before.port,after.inst,after.port);
+        ConnectUnits(MakePortOut(*shared,0),after);
+        continue;
+      }
+
+      String name = GenerateNewValidName(accel,"pipeline",globalPermanent);
+      FUInstance* reg = CreateFUInstance(accel,BasicDeclaration::pipelineRegister,name);
+      InsertUnit(accel,before,after,MakePortOut(reg,0),MakePortIn(reg,0),edgeDelay);
+
+      if(edgeDelay == 0){
+        portRegister->Insert(before,reg);
+      }
+      *registersInserted += 1;
+    }
 
-    buffersInserted += 1;
+    int instDepth = maxInputDepth + unitDepth;
+    depth->Insert(inst,instDepth);
+    maxDepthFound = std::max(maxDepthFound,instDepth);
   }
+
+  return maxDepthFound;
+}
+
+int LongestCombinatorialPath(Accelerator* accel){
+  return LimitCombinatorialDepth(accel,0,nullptr);
+}
+
+int PipelineCombinatorialPaths(Accelerator* accel,int maxDepth){
+  int registersInserted = 0;
+  LimitCombinatorialDepth(accel,maxDepth,&registersInserted);
+  return registersInserted;
 }
 
 FUInstance* GetInputInstance(Pool<FUInstance>* nodes,int inputIndex){
@@ -838,6 +991,73 @@ Array<Edge> GetAllEdges(Accelerator* accel,Arena* out){
   return result;
 }
 
+Array<Edge> GetAllEdges(AcceleratorGraph* graph,Arena* out){
+  Array<Edge> result = PushArray<Edge>(out,graph->outputs.size);
+
+  int index = 0;
+  for(int i = 0; i < graph->Size(); i++){
+    for(GraphConnection& conn : graph->Outputs(i)){
+      result[index++] = MakeEdge(graph->instances[i],conn.port,graph->instances[conn.other],conn.otherPort,conn.delay);
+    }
+  }
+
+  return result;
+}
+
+AcceleratorGraph* CreateAcceleratorGraph(Accelerator* accel,Arena* out){
+  AcceleratorGraph* graph = PushStruct<AcceleratorGraph>(out);
+  *graph = {};
+
+  int size = accel->allocated.Size();
+  graph->instances = PushArray<FUInstance*>(out,size);
+  graph->instanceIndex = PushHashmap<FUInstance*,int>(out,size);
+
+  int index = 0;
+  int amountInputs = 0;
+  int amountOutputs = 0;
+  for(FUInstance* inst : accel->allocated){
+    graph->instances[index] = inst;
+    graph->instanceIndex->Insert(inst,index);
+    index += 1;
+
+    amountInputs += Size(inst->allInputs);
+    amountOutputs += Size(inst->allOutputs);
+  }
+
+  graph->inputStart = PushArray<int>(out,size + 1);
+  graph->inputs = PushArray<GraphConnection>(out,amountInputs);
+  graph->outputStart = PushArray<int>(out,size + 1);
+  graph->outputs = PushArray<GraphConnection>(out,amountOutputs);
+
+  int inputIndex = 0;
+  int outputIndex = 0;
+  for(int i = 0; i < size; i++){
+    FUInstance* inst = graph->instances[i];
+
+    graph->inputStart[i] = inputIndex;
+    FOREACH_LIST(ConnectionNode*,ptr,inst->allInputs){
+      GraphConnection& conn = graph->inputs[inputIndex++];
+      conn.other = graph->IndexOf(ptr->instConnectedTo.inst);
+      conn.otherPort = ptr->instConnectedTo.port;
+      conn.port = ptr->port;
+      conn.delay = ptr->edgeDelay;
+    }
+
+    graph->outputStart[i] = outputIndex;
+    FOREACH_LIST(ConnectionNode*,ptr,inst->allOutputs){
+      GraphConnection& conn = graph->outputs[outputIndex++];
+      conn.other = graph->IndexOf(ptr->instConnectedTo.inst);
+      conn.otherPort = ptr->instConnectedTo.port;
+      conn.port = ptr->port;
+      conn.delay = ptr->edgeDelay;
+    }
+  }
+  graph->inputStart[size] = inputIndex;
+  graph->outputStart[size] = outputIndex;
+
+  return graph;
+}
+
 static void AdvanceUntilValid(EdgeIterator* iter){
   if(iter->currentNode != iter->end && iter->currentPort){
     return;
@@ -920,19 +1140,13 @@ Opt<Edge> FindEdge(FUInstance* out,int outIndex,FUInstance* in,int inIndex,int d
   Assert(inIndex < inDecl->NumberInputs());
   Assert(outIndex < outDecl->NumberOutputs());
 
-  Accelerator* accel = out->accel;
-
-  EdgeIterator iter = IterateEdges(accel);
-  while(iter.HasNext()){
-    Edge edgeInst = iter.Next();
-    Edge* edge = &edgeInst;
-
-    if(edge->units[0].inst == out &&
-       edge->units[0].port == outIndex &&
-       edge->units[1].inst == in &&
-       edge->units[1].port == inIndex &&
-       edge->delay == delay) {
-      return *edge;
+  // Only the outputs of the out instance can contain the edge
+  FOREACH_LIST(ConnectionNode*,ptr,out->allOutputs){
+    if(ptr->port == outIndex &&
+       ptr->instConnectedTo.inst == in &&
+       ptr->instConnectedTo.port == inIndex &&
+       ptr->edgeDelay == delay){
+      return MakeEdge(out,outIndex,in,inIndex,delay);
     }
   }
 
@@ -952,18 +1166,8 @@ void ConnectUnits(FUInstance* out,int outIndex,FUInstance* in,int inIndex,int de
 }
 
 void ConnectUnitsIfNotConnected(FUInstance* out,int outIndex,FUInstance* in,int inIndex,int delay){
-  Accelerator* accel = out->accel;
-
-  EdgeIterator iter = IterateEdges(accel);
-  while(iter.HasNext()){
-    Edge edgeInst = iter.Next();
-    Edge* edge = &edgeInst;
-
-    if(edge->units[0].inst == out && edge->units[0].port == outIndex &&
-       edge->units[1].inst == in  && edge->units[1].port == inIndex &&
-       delay == edge->delay){
-      return;
-    }
+  if(FindEdge(out,outIndex,in,inIndex,delay).has_value()){
+    return;
   }
 
   ConnectUnitsGetEdge(out,outIndex,in,inIndex,delay);
@@ -1210,14 +1414,20 @@ void MappingCheck(AcceleratorMapping* map,Accelerator* first,Accelerator* second
 }
 
 // TODO: Need to add list to arena in order to this be good. 
-static Arena mappingArenaInst = {};
-static Arena* mappingArena = nullptr;
+static thread_local Arena mappingArenaInst = {};
+static thread_local Arena* mappingArenaPtr = nullptr;
 
-AcceleratorMapping* MappingSimple(Accelerator* first,Accelerator* second,int size,Arena* out){
-  if(!mappingArena){
+static Arena* GetMappingArena(){
+  if(!mappingArenaPtr){
     mappingArenaInst = InitArena(Megabyte(64));
-    mappingArena = &mappingArenaInst; 
+    mappingArenaPtr = &mappingArenaInst; 
   }
+
+  return mappingArenaPtr;
+}
+
+AcceleratorMapping* MappingSimple(Accelerator* first,Accelerator* second,int size,Arena* out){
+  Arena* mappingArena = GetMappingArena();
   
   AcceleratorMapping* mapping = PushStruct<AcceleratorMapping>(out);
   mapping->instanceMap = PushTrieMap<FUInstance*,FUInstance*>(mappingArena);
@@ -1238,6 +1448,7 @@ AcceleratorMapping* MappingSimple(Accelerator* first,Accelerator* second,Arena*
 AcceleratorMapping* MappingInvert(AcceleratorMapping* toReverse,Arena* out){
   MappingCheck(toReverse);
 
+  Arena* mappingArena = GetMappingArena();
   AcceleratorMapping* result = PushStruct<AcceleratorMapping>(out);
   result->instanceMap = PushTrieMap<FUInstance*,FUInstance*>(mappingArena);
   result->inputMap = PushTrieMap<PortInstance,PortInstance>(mappingArena);
@@ -1267,6 +1478,7 @@ AcceleratorMapping* MappingCombine(AcceleratorMapping* first,AcceleratorMapping*
 
   Assert(first->secondId == second->firstId);
   
+  Arena* mappingArena = GetMappingArena();
   AcceleratorMapping* result = PushStruct<AcceleratorMapping>(out);
   result->instanceMap = PushTrieMap<FUInstance*,FUInstance*>(mappingArena);
   result->inputMap = PushTrieMap<PortInstance,PortInstance>(mappingArena);
@@ -199,6 +199,7 @@ struct Accelerator{ // Graph + data storage
    // Mainly for debugging
   String name; // For debugging purposes it's useful to give accelerators a name
   int id;
+  int nextInstanceId; // Ids are per accelerator so that they do not depend on the order that accelerators are built
   AcceleratorPurpose purpose;
 };
 
@@ -277,6 +278,34 @@ struct EdgeIterator{
   Edge Next();
 };
 
+// A connection seen from one of the instances of the edge. Instances are referred by their index in the graph.
+struct GraphConnection{
+  int other; // Instance at the other end of the edge
+  int otherPort;
+  int port; // Port of the instance that owns the connection
+  int delay;
+};
+
+// Read only snapshot of the connections of an accelerator in compressed sparse row form.
+// Instances are indexed in pool order and the connections of each instance keep the order of the ConnectionNode lists,
+// so code that iterates the snapshot visits edges in the same order as code that iterates the accelerator.
+// Any change to the accelerator makes the snapshot stale, build it again after mutating the graph.
+struct AcceleratorGraph{
+  Array<FUInstance*> instances;
+  Hashmap<FUInstance*,int>* instanceIndex;
+
+  // Connections of instance i are in [start[i],start[i+1])
+  Array<int> inputStart;
+  Array<GraphConnection> inputs;
+  Array<int> outputStart;
+  Array<GraphConnection> outputs; // Edges in the same order as EdgeIterator
+
+  int Size(){return instances.size;};
+  int IndexOf(FUInstance* inst){return instanceIndex->GetOrFail(inst);};
+  Array<GraphConnection> Inputs(int index){return {inputs.data + inputStart[index],inputStart[index + 1] - inputStart[index]};};
+  Array<GraphConnection> Outputs(int index){return {outputs.data + outputStart[index],outputStart[index + 1] - outputStart[index]};};
+};
+
 struct StaticId{
    FUDeclaration* parent;
    String name;
@@ -363,8 +392,11 @@ void SetStatic(FUInstance* instance);
 // 
 // Edge iteration and edge operations, including connecting units
 Array<Edge> GetAllEdges(Accelerator* accel,Arena* out);
+Array<Edge> GetAllEdges(AcceleratorGraph* graph,Arena* out);
 EdgeIterator IterateEdges(Accelerator* accel);
 
+AcceleratorGraph* CreateAcceleratorGraph(Accelerator* accel,Arena* out);
+
 Opt<Edge> FindEdge(FUInstance* out,int outIndex,FUInstance* in,int inIndex,int delay);
 Opt<Edge> FindEdge(PortInstance out,PortInstance in,int delay);
 void ConnectUnitsGetEdge(FUInstance* out,int outIndex,FUInstance* in,int inIndex,int delay = 0);
@@ -391,8 +423,14 @@ PortInstance GetAssociatedOutputPortInstance(FUInstance* unit,int portIndex);
 //
 // Graph fixes and operations
 void FixDelays(Accelerator* accel,Hashmap<Edge,DelayInfo>* edgeDelays);
+
+// Depth counted in combinatorial units (operations, comb muxes, combinatorial modules count as their inner chain).
+int LongestCombinatorialPath(Accelerator* accel);
+// Inserts pipeline registers so that no chain goes over maxDepth. Delays must be calculated afterwards to rebalance parallel paths. Returns amount of registers inserted.
+int PipelineCombinatorialPaths(Accelerator* accel,int maxDepth);
 Pair<Accelerator*,SubMap*> Flatten(Accelerator* accel,int times);
 DAGOrderNodes CalculateDAGOrder(Accelerator* accel,Arena* out);
+DAGOrderNodes CalculateDAGOrder(AcceleratorGraph* graph,Arena* out);
 
 
 bool IsCombinatorial(Accelerator* accel);
@@ -36,36 +36,17 @@ AddressAccess* GetAddressGenOrFail(String name){
 Array<int> SimulateSingleAddressAccess(LoopLinearSum* access,Hashmap<String,int>* extraEnv,Arena* out){
   TEMP_REGION(temp,out);
 
-  auto Recurse = [](auto Recurse,Hashmap<String,int>* env,GrowableArray<int>& values,LoopLinearSum* loops,SymbolicExpression* addr,int loopIndex) -> void{
-    if(loopIndex < 0){
-      int val = Evaluate(addr,env);
-      *values.PushElem() = val;
-    } else {
-      LoopLinearSumTerm def = loops->terms[loopIndex];
-      int loopStart = Evaluate(def.loopStart,env);
-      int loopEnd = Evaluate(def.loopEnd,env);
-
-      Assert(loopStart <= loopEnd);
-      
-      for(int i = loopStart; i < loopEnd; i++){
-        env->Insert(def.var,i);
-
-        Recurse(Recurse,env,values,loops,addr,loopIndex - 1);
-      }
-    }
-  };
-
-  Hashmap<String,int>* env = PushHashmap<String,int>(temp,access->terms.size + extraEnv->nodesUsed);
-
+  Array<String> inputVariables = PushArray<String>(temp,extraEnv->nodesUsed);
+  Array<int> inputValues = PushArray<int>(temp,extraEnv->nodesUsed);
+  int index = 0;
   for(auto p : extraEnv){
-    env->Insert(p.first,*p.second);
+    inputVariables[index] = p.first;
+    inputValues[index] = *p.second;
+    index += 1;
   }
   
-  GrowableArray<int> builder = StartArray<int>(out);
-  SymbolicExpression* fullExpression = TransformIntoSymbolicExpression(access,temp);
-  
-  Recurse(Recurse,env,builder,access,fullExpression,access->terms.size - 1);
-  Array<int> values = EndArray(builder);
+  CompiledLoopLinearSum* compiled = CompileLoopLinearSum(access,inputVariables,temp);
+  Array<int> values = SimulateLoopLinearSum(compiled,inputValues,out);
 
   return values;
 }
@@ -282,6 +263,101 @@ static ExternalMemoryAccess CompileExternalMemoryAccess(LoopLinearSum* access,Sy
   return result;
 }
 
+// Bus cycles lost per AXI burst (address handshake and read latency). Must match the default VERSAT_AXI_BURST_OVERHEAD of the generated header.
+static const int AXI_BURST_OVERHEAD = 8;
+static const int AXI_MAX_BURST_BEATS = 256; // AXI_LEN_W = 8
+static const int AXI_BOUNDARY = 4096;
+
+// Predicted AXI traffic of the external side of a VRead access.
+struct ExternalAccessCost{
+  int transfers; // One per iteration of the outer external loop
+  int transactions; // AXI bursts
+  int beats;
+  int wastedBeats; // Beats that only carry data that the address gen does not use
+  int cost; // In bus cycles
+};
+
+// Mirrors the burst splitting performed by AXITransferController: bursts are limited by the max burst length and cannot cross a 4KB boundary. The ext pointer is assumed to be 4KB aligned.
+// Values must contain every input of the access and VERSAT_DIFF_W.
+static ExternalAccessCost EstimateExternalAccessCost(AddressAccess* access,Hashmap<String,int>* values,int usefulElements,int axiDataW,Arena* out){
+  TEMP_REGION(temp,out);
+  
+  const int elementSize = sizeof(float);
+  LoopLinearSum* external = access->external;
+  LoopLinearSumTerm inner = external->terms[0];
+  LoopLinearSumTerm outer = external->terms[external->terms.size - 1];
+
+  SymbolicExpression* freeTerm = external->freeTerm;
+  if(IsZero(freeTerm)){
+    freeTerm = access->internal->freeTerm;
+  }
+  
+  i64 start = (i64) Evaluate(freeTerm,values) * elementSize;
+  i64 length = (i64) Evaluate(GetLoopSize(inner,temp),values) * elementSize;
+  i64 amount = 1;
+  i64 shift = 0;
+  if(external->terms.size > 1){
+    SymbolicExpression* fullExpression = TransformIntoSymbolicExpression(external,temp);
+
+    amount = Evaluate(GetLoopSize(outer,temp),values);
+    shift = (i64) Evaluate(Normalize(Derivate(fullExpression,outer.var,temp),temp),values) * elementSize;
+  }
+
+  int beatBytes = axiDataW / 8;
+  int maxBurstBytes = MIN(AXI_MAX_BURST_BEATS * beatBytes,AXI_BOUNDARY);
+
+  // Bursts only depend on the position of the transfer inside a 4KB page, which repeats every period transfers.
+  i64 a = ((shift % AXI_BOUNDARY) + AXI_BOUNDARY) % AXI_BOUNDARY;
+  i64 b = AXI_BOUNDARY;
+  while(a != 0){
+    i64 t = b % a;
+    b = a;
+    a = t;
+  }
+  i64 period = AXI_BOUNDARY / b;
+
+  i64 transactions = 0;
+  i64 beats = 0;
+  for(i64 i = 0; i < MIN(amount,period); i++){
+    i64 transferTransactions = 0;
+    i64 transferBeats = 0;
+
+    i64 addr = (((start + i * shift) % AXI_BOUNDARY) + AXI_BOUNDARY) % AXI_BOUNDARY;
+    i64 end = addr + length;
+    addr -= addr % beatBytes;
+    
+    while(addr < end){
+      i64 boundary = (addr / AXI_BOUNDARY + 1) * AXI_BOUNDARY;
+      i64 burstEnd = MIN(MIN(addr + maxBurstBytes,boundary),end);
+      i64 burstBeats = (burstEnd - addr + beatBytes - 1) / beatBytes;
+      
+      transferTransactions += 1;
+      transferBeats += burstBeats;
+      addr += burstBeats * beatBytes;
+    }
+
+    // Transfer i is repeated once for every period that fits in amount, starting at i.
+    i64 repeats = (amount - i + period - 1) / period;
+    transactions += transferTransactions * repeats;
+    beats += transferBeats * repeats;
+  }
+
+  i64 usefulBeats = ((i64) usefulElements * elementSize + beatBytes - 1) / beatBytes;
+  
+  ExternalAccessCost res = {};
+  res.transfers = (int) amount;
+  res.transactions = (int) transactions;
+  res.beats = (int) beats;
+  res.wastedBeats = (int) MAX(beats - usefulBeats,0);
+  res.cost = (int) (transactions * AXI_BURST_OVERHEAD + beats);
+
+  return res;
+}
+
+static String Repr(ExternalAccessCost cost,Arena* out){
+  return PushString(out,"%d transfers, %d AXI bursts, %d beats (%d wasted), cost %d",cost.transfers,cost.transactions,cost.beats,cost.wastedBeats,cost.cost);
+}
+
 static CompiledAccess CompileAccess(LoopLinearSum* access,SymbolicExpression* dutyDiv,Arena* out){
   TEMP_REGION(temp,out);
   
@@ -667,6 +743,47 @@ AddressAccess* CompileAddressGen(AddressGenDef* def,String content){
       anyError = true;
     }
   }
+
+  Array<Array<int>> specializations = PushArray<Array<int>>(out,def->specializations.size);
+  for(int i = 0; i < def->specializations.size; i++){
+    AddressGenSpecializeDef spec = def->specializations[i];
+
+    specializations[i] = PushArray<int>(out,def->inputs.size);
+    Array<bool> seen = PushArray<bool>(temp,def->inputs.size);
+    
+    for(int j = 0; j < spec.inputs.size; j++){
+      Token input = spec.inputs[j];
+      int index = -1;
+      for(int k = 0; k < def->inputs.size; k++){
+        if(CompareString(def->inputs[k],input)){
+          index = k;
+        }
+      }
+
+      if(index == -1){
+        ReportError(content,input,"Specialized variable does not appear inside input list");
+        anyError = true;
+        continue;
+      }
+
+      if(seen[index]){
+        ReportError(content,input,"Input variable is specialized more than once");
+        anyError = true;
+        continue;
+      }
+      
+      seen[index] = true;
+      specializations[i][index] = spec.values[j];
+    }
+
+    for(int k = 0; k < def->inputs.size; k++){
+      if(!seen[k]){
+        printf("On address gen: %.*s:%d\n",UN(def->name),def->name.loc.start.line);
+        printf("\t[Error] Specialization does not give a value to input '%.*s' (every input must have a value)\n",UN(def->inputs[k]));
+        anyError = true;
+      }
+    }
+  }
   
   if(anyError){
     return nullptr;
@@ -744,6 +861,7 @@ AddressAccess* CompileAddressGen(AddressGenDef* def,String content){
   result->internal = PushLoopLinearSumSimpleVar("x",PushLiteral(temp,1),PushLiteral(temp,0),finalExpression,out);
   result->external = AddLoopLinearSum(expr,freeTerm,out);
   result->dutyDivExpr = SymbolicDeepCopy(dutyDiv,out);
+  result->specializations = specializations;
   
   return result;
 };
@@ -798,14 +916,22 @@ static String GenerateReadCompilationFunction(AccessAndType access,Arena* out){
     AddressAccess* doubleLoop = ConvertAccessTo2External(access,loopIndex,temp);
     AddressAccess* singleLoop = ConvertAccessTo1External(access,temp);
 
+    // Predicted bus cycles of each external access, takes into account AXI burst limits.
+    // Unlike precomputed configurations, the values are only known at runtime, so 4KB boundary crossings and wasted beats are not part of the cost.
     region(temp){
-      String repr = PushRepresentation(GetLoopLinearSumTotalSize(doubleLoop->external,temp),temp);
+      ExternalMemoryAccess external = CompileExternalMemoryAccess(doubleLoop->external,doubleLoop->dutyDivExpr,temp);
+      c->Comment(PushString(temp,"Double loop (outer loop %.*s): (%.*s) + 1 transfers of (%.*s) elements",UN(access->external->terms[loopIndex].var),UN(external.amountMinusOne),UN(external.length)));
+
+      String repr = PushString(temp,"VersatExternalAccessCost((%.*s) * sizeof(float),(%.*s) + 1)",UN(external.length),UN(external.amountMinusOne));
       c->VarDeclare("int","doubleLoop",repr);
     }
 
     region(temp){
-      String repr2 = PushRepresentation(GetLoopLinearSumTotalSize(singleLoop->external,temp),temp);
-      c->VarDeclare("int","singleLoop",repr2);
+      ExternalMemoryAccess external = CompileExternalMemoryAccess(singleLoop->external,singleLoop->dutyDivExpr,temp);
+      c->Comment(PushString(temp,"Single loop: (%.*s) + 1 transfers of (%.*s) elements",UN(external.amountMinusOne),UN(external.length)));
+
+      String repr = PushString(temp,"VersatExternalAccessCost((%.*s) * sizeof(float),(%.*s) + 1)",UN(external.length),UN(external.amountMinusOne));
+      c->VarDeclare("int","singleLoop",repr);
     }
 
     // TODO: Maybe it would be better to just not generate single or double loop if we can check that one is always gonna be better than the other, right?
@@ -882,6 +1008,7 @@ static String GenerateReadCompilationFunction(AccessAndType access,Arena* out){
   CEmitter* m = StartCCode(temp);
 
   EmitDebugAddressGenInfo(initial,m);
+  m->Comment("Loop layouts are chosen with VersatExternalAccessCost. 4KB boundary crossings and wasted beats are only modeled for precomputed configurations");
   
   String functionName = PushString(temp,"CompileVUnit_%.*s_Ext",UN(addressGenName));
   m->FunctionBlock("static AddressVArguments",functionName);
@@ -1252,6 +1379,278 @@ String GenerateAddressCompileAndLoadFunction(String structName,AddressAccess* ac
   return data;
 }
 
+// Inputs of a specialization plus the VERSAT_DIFF_W of the hardware being generated
+static Hashmap<String,int>* PushSpecializationValues(AddressAccess* access,Array<int> values,Arena* out){
+  Hashmap<String,int>* env = PushHashmap<String,int>(out,values.size + 1);
+
+  for(int i = 0; i < values.size; i++){
+    env->Insert(access->inputVariableNames[i],values[i]);
+  }
+  env->Insert("VERSAT_DIFF_W",globalOptions.databusDataSize / 32);
+
+  return env;
+}
+
+// Name used to identify a specialization, Tile with a = 16 and b = -2 becomes Tile_a16_bm2
+static String SpecializationName(AddressAccess* access,Array<int> values,Arena* out){
+  auto builder = StartString(out);
+
+  builder->PushString(access->name);
+  for(int i = 0; i < values.size; i++){
+    int value = values[i];
+    builder->PushString("_%.*s%s%d",UN(access->inputVariableNames[i]),value < 0 ? "m" : "",value < 0 ? -value : value);
+  }
+
+  return EndString(out,builder);
+}
+
+// ALIGN is a function in the generated header and cannot be used inside a constant initializer. VERSAT_ALIGN is the equivalent macro. Expr must not be interned.
+static void UseConstantAlign(SymbolicExpression* expr){
+  Assert(!expr->interned);
+  
+  switch(expr->type){
+  case SymbolicExpressionType_LITERAL:
+  case SymbolicExpressionType_VARIABLE: break;
+  case SymbolicExpressionType_DIV:{
+    UseConstantAlign(expr->top);
+    UseConstantAlign(expr->bottom);
+  } break;
+  case SymbolicExpressionType_FUNC:{
+    if(CompareString(expr->name,"ALIGN")){
+      expr->name = "VERSAT_ALIGN";
+    }
+  } // fallthrough
+  case SymbolicExpressionType_SUM:
+  case SymbolicExpressionType_MUL:{
+    for(SymbolicExpression* child : expr->terms){
+      UseConstantAlign(child);
+    }
+  } break;
+  }
+}
+
+// Replaces every input variable with the specialized literal value. Only loop variables and VERSAT_DIFF_W remain afterwards.
+static AddressAccess* SpecializeAddressAccess(AddressAccess* access,Array<int> values,Arena* out){
+  TEMP_REGION(temp,out);
+
+  Hashmap<String,SymbolicExpression*>* literals = PushHashmap<String,SymbolicExpression*>(temp,values.size);
+  for(int i = 0; i < values.size; i++){
+    literals->Insert(access->inputVariableNames[i],PushLiteral(temp,values[i] < 0 ? -values[i] : values[i],values[i] < 0));
+  }
+
+  auto Specialize = [literals](SymbolicExpression* expr,Arena* out) -> SymbolicExpression*{
+    TEMP_REGION(temp,out);
+    SymbolicExpression* res = Normalize(ReplaceVariables(expr,literals,temp),out);
+    UseConstantAlign(res);
+    return res;
+  };
+
+  auto SpecializeSum = [Specialize](LoopLinearSum* sum,Arena* out) -> LoopLinearSum*{
+    LoopLinearSum* res = Copy(sum,out);
+
+    for(LoopLinearSumTerm& term : res->terms){
+      term.term = Specialize(term.term,out);
+      term.loopStart = Specialize(term.loopStart,out);
+      term.loopEnd = Specialize(term.loopEnd,out);
+    }
+    res->freeTerm = Specialize(res->freeTerm,out);
+
+    return res;
+  };
+
+  AddressAccess* result = PushStruct<AddressAccess>(out);
+  result->name = PushString(out,access->name);
+  result->internal = SpecializeSum(access->internal,out);
+  result->external = SpecializeSum(access->external,out);
+  if(access->dutyDivExpr){
+    result->dutyDivExpr = Specialize(access->dutyDivExpr,out);
+  }
+
+  return result;
+}
+
+// Members in the same order as the AddressVArguments, AddressGenArguments and AddressMemArguments structs
+static Array<String> GetAddressArgumentsMembers(AddressGenInst inst,Arena* out){
+  auto builder = StartArray<String>(out);
+
+  Array<String> base = {};
+  Array<String> extraFormat = {};
+  FULL_SWITCH(inst.type){
+  case AddressGenType_READ:{
+    base = META_AddressVParameters_Members;
+    extraFormat = AddressGenExtraFormat;
+  } break;
+  case AddressGenType_GEN:{
+    base = META_AddressGenBaseParameters_Members;
+    extraFormat = AddressGenExtraFormat;
+  } break;
+  case AddressGenType_MEM:{
+    base = META_AddressMemParameters_Members;
+    extraFormat = AddressGenMemExtraFormat;
+  } break;
+  }
+
+  for(String str : base){
+    *builder.PushElem() = str;
+  }
+  for(int i = 2; i < inst.loopsSupported + 1; i++){
+    for(String format : extraFormat){
+      *builder.PushElem() = PushString(out,format.data,i);
+    }
+  }
+
+  return EndArray(builder);
+}
+
+// Emits a constant arguments struct. Members not set by params are zero. The ext_addr value is always a runtime value and must be set by the caller.
+static void EmitPrecomputedArguments(CEmitter* c,String typeName,String name,Array<String> members,Array<Pair<String,String>> params){
+  c->VarDeclareBlock(typeName,name,true);
+
+  for(String member : members){
+    String value = "0";
+
+    for(Pair<String,String> p : params){
+      if(CompareString(p.first,member) && !CompareString(member,"ext_addr")){
+        value = p.second;
+      }
+    }
+
+    c->Elem(value);
+  }
+
+  c->EndBlock();
+}
+
+static String GetExtAddrParam(Array<Pair<String,String>> params){
+  for(Pair<String,String> p : params){
+    if(CompareString(p.first,"ext_addr")){
+      return p.second;
+    }
+  }
+
+  Assert(false);
+  return {};
+}
+
+String GenerateAddressSpecializedLoadFunctions(String structName,AddressAccess* access,AddressGenInst inst,Arena* out){
+  TEMP_REGION(temp,out);
+
+  CEmitter* m = StartCCode(temp);
+
+  Array<String> members = GetAddressArgumentsMembers(inst,temp);
+  String loadFunctionName = PushString(temp,"LoadVUnit_%.*s",UN(structName));
+  String configArg = PushString(temp,"volatile %.*sConfig*",UN(structName));
+  
+  for(Array<int> values : access->specializations){
+    Hashmap<String,int>* env = PushSpecializationValues(access,values,temp);
+    String specName = SpecializationName(access,values,temp);
+    String functionName = PushString(temp,"%.*s_%.*s",UN(specName),UN(structName));
+
+    auto builder = StartString(temp);
+    for(int i = 0; i < values.size; i++){
+      builder->PushString("%s%.*s = %d",i == 0 ? "" : ", ",UN(access->inputVariableNames[i]),values[i]);
+    }
+    String valuesRepr = EndString(temp,builder);
+    
+    m->Comment(PushString(temp,"%.*s precomputed for %.*s",UN(access->name),UN(valuesRepr)));
+
+    FULL_SWITCH(inst.type){
+    case AddressGenType_READ: {
+      // Every possible external loop decomposition is evaluated with the AXI cost model and the cheapest is used.
+
+      int useful = Evaluate(GetLoopLinearSumTotalSize(access->internal,temp),env);
+      
+      int loopIndex = 0;
+      ExternalAccessCost doubleCost = {};
+      for(int i = 0; i < access->external->terms.size; i++){
+        AddressAccess* candidate = ConvertAccessTo2External(access,i,temp);
+        ExternalAccessCost cost = EstimateExternalAccessCost(candidate,env,useful,globalOptions.databusDataSize,temp);
+
+        if(i == 0 || cost.cost < doubleCost.cost){
+          loopIndex = i;
+          doubleCost = cost;
+        }
+      }
+      
+      AddressAccess* doubleLoop = ConvertAccessTo2External(access,loopIndex,temp);
+      AddressAccess* singleLoop = ConvertAccessTo1External(access,temp);
+      ExternalAccessCost singleCost = EstimateExternalAccessCost(singleLoop,env,useful,globalOptions.databusDataSize,temp);
+
+      m->Comment(PushString(temp,"Double loop (outer loop %.*s): %.*s",UN(access->external->terms[loopIndex].var),UN(Repr(doubleCost,temp))));
+      m->Comment(PushString(temp,"Single loop: %.*s",UN(Repr(singleCost,temp))));
+      
+      AddressAccess* doubleSpecialized = SpecializeAddressAccess(doubleLoop,values,temp);
+      AddressAccess* singleSpecialized = SpecializeAddressAccess(singleLoop,values,temp);
+
+      Array<Pair<String,String>> doubleParams = InstantiateRead(doubleSpecialized,loopIndex,true,inst.loopsSupported,temp);
+      Array<Pair<String,String>> singleParams = InstantiateRead(singleSpecialized,-1,false,inst.loopsSupported,temp);
+
+      String doubleName = PushString(temp,"%.*s_Double",UN(functionName));
+      String singleName = PushString(temp,"%.*s_Single",UN(functionName));
+      
+      EmitPrecomputedArguments(m,"const AddressVArguments",doubleName,members,doubleParams);
+      EmitPrecomputedArguments(m,"const AddressVArguments",singleName,members,singleParams);
+
+      m->FunctionBlock("static void",functionName);
+      m->Argument(configArg,"config");
+      m->Argument("void*","ext");
+
+      m->VarDeclare("AddressVArguments","args");
+      if(doubleCost.cost < singleCost.cost){
+        m->If("!forceSingleLoop");
+      } else {
+        m->If("!forceSingleLoop && forceDoubleLoop");
+      }
+      m->Assignment("args",doubleName);
+      m->Assignment("args.ext_addr",PushString(temp,"(iptr) (%.*s)",UN(GetExtAddrParam(doubleParams))));
+      m->Else();
+      m->Assignment("args",singleName);
+      m->Assignment("args.ext_addr",PushString(temp,"(iptr) (%.*s)",UN(GetExtAddrParam(singleParams))));
+      m->EndIf();
+
+      m->Statement(PushString(temp,"%.*s(config,args)",UN(loadFunctionName)));
+      m->EndBlock();
+    } break;
+    case AddressGenType_GEN: {
+      AddressAccess* specialized = SpecializeAddressAccess(access,values,temp);
+      Array<Pair<String,String>> params = InstantiateGen(specialized,inst.loopsSupported,temp);
+
+      String argsName = PushString(temp,"%.*s_Args",UN(functionName));
+      EmitPrecomputedArguments(m,"const AddressGenArguments",argsName,members,params);
+
+      m->FunctionBlock("static void",functionName);
+      m->Argument(configArg,"config");
+      m->Statement(PushString(temp,"%.*s(config,%.*s)",UN(loadFunctionName),UN(argsName)));
+      m->EndBlock();
+    } break;
+    case AddressGenType_MEM: {
+      AddressAccess* specialized = SpecializeAddressAccess(access,values,temp);
+
+      for(int i = 0; i < ARRAY_SIZE(memInfo); i++){
+        auto info = memInfo[i];
+        Array<Pair<String,String>> params = InstantiateMem(specialized,info.port,info.dir,inst.loopsSupported,temp);
+
+        String memFunctionName = PushString(temp,"%.*s_%.*s",UN(functionName),UN(info.name));
+        String argsName = PushString(temp,"%.*s_Args",UN(memFunctionName));
+        EmitPrecomputedArguments(m,"const AddressMemArguments",argsName,members,params);
+
+        m->FunctionBlock("static void",memFunctionName);
+        m->Argument(configArg,"config");
+        m->Statement(PushString(temp,"%.*s(config,%.*s)",UN(loadFunctionName),UN(argsName)));
+        m->EndBlock();
+      }
+    } break;
+    }
+  }
+  
+  CAST* ast = EndCCode(m);
+
+  auto strBuilder = StartString(temp);
+  Repr(ast,strBuilder);
+  String data = EndString(out,strBuilder);
+  return data;
+}
+
 String GenerateAddressPrintFunction(AddressAccess* access,Arena* out){
   TEMP_REGION(temp,out);
 
@@ -24,6 +24,9 @@ struct AddressAccess{
   SymbolicExpression* dutyDivExpr; // Any expression of the form (A/B) is broken up, this var saves B and the internal/external LoopLinearSum take the A part (otherwise this is nullptr). This simplifies a lot of things, since we only care about B at the very end. 
   
   Array<String> inputVariableNames;
+
+  // Each entry contains one value per input (in inputVariableNames order). For each, we precompute the configuration at generation time instead of emitting code that computes it at runtime.
+  Array<Array<int>> specializations;
 };
 
 struct ExternalMemoryAccess{
@@ -106,4 +109,5 @@ SymbolicExpression* GetLoopHighestDecider(LoopLinearSumTerm* term);
 String GenerateAddressGenCompilationFunction(AccessAndType access,Arena* out);
 String GenerateAddressLoadingFunction(String structName,AddressGenInst type,Arena* out);
 String GenerateAddressCompileAndLoadFunction(String structName,AddressAccess* access,AddressGenInst type,Arena* out);
+String GenerateAddressSpecializedLoadFunctions(String structName,AddressAccess* access,AddressGenInst type,Arena* out);
 String GenerateAddressPrintFunction(AddressAccess* initial,Arena* out);
@@ -80,7 +80,7 @@ Array<Array<MuxInfo>> CalculateMuxInformation(AccelInfoIterator* iter,Arena* out
       if(info->isMergeMultiplexer){
         int muxGroup = info->muxGroup;
         if(!alreadySet[muxGroup]){
-          builder[muxGroup].configIndex = info->globalConfigPos.value();
+          builder[muxGroup].configIndex = iter.GlobalConfigPos().value();
           builder[muxGroup].val = info->mergePort;
           builder[muxGroup].name = info->baseName;
           builder[muxGroup].fullName = info->fullName;
@@ -392,17 +392,11 @@ String EmitInternalMemoryWires(Array<ExternalMemoryInterface> external,Arena* ou
   return content;
 }
 
-static String OutputName(Pool<FUInstance>& instances,PortInstance node,Arena* out){
+static String OutputName(AcceleratorGraph* graph,PortInstance node,Arena* out){
   FUInstance* inst = node.inst;
   FUDeclaration* decl = inst->declaration;
 
-  int id = 0;
-  for(FUInstance* ptr : instances){
-    if(ptr == inst){
-      break;
-    }
-    id++;
-  }
+  int id = graph->IndexOf(inst);
     
   if(decl == BasicDeclaration::input){
     return PushString(out,"in%d",inst->portIndex);
@@ -417,7 +411,7 @@ static String OutputName(Pool<FUInstance>& instances,PortInstance node,Arena* ou
   return PushString(out,"output_%d_%d",id,node.port);
 };
 
-void EmitCombOperations(VEmitter* m,Pool<FUInstance> instances){
+void EmitCombOperations(VEmitter* m,AcceleratorGraph* graph){
   TEMP_REGION(temp,m->arena);
 
   auto Format = [](String format,Array<String> args,Arena* out){
@@ -455,14 +449,14 @@ void EmitCombOperations(VEmitter* m,Pool<FUInstance> instances){
   };
   
   int combOps = 0;
-  for(FUInstance* node : instances){
+  for(FUInstance* node : graph->instances){
     if(node->declaration->IsCombinatorialOperation()){
       combOps += 1;
     }
   }
   
   if(combOps){
-    for(FUInstance* node : instances){
+    for(FUInstance* node : graph->instances){
       if(node->declaration->IsCombinatorialOperation()){
         m->Reg(SF("comb_%.*s_%d",UN(node->name),node->id),SYM_dataW);
       }
@@ -470,14 +464,14 @@ void EmitCombOperations(VEmitter* m,Pool<FUInstance> instances){
 
     m->CombBlock();
     {
-      for(FUInstance* node : instances){
+      for(FUInstance* node : graph->instances){
         if(node->declaration->IsCombinatorialOperation()){
           int size = node->declaration->NumberInputs();
           String identifier = PushString(temp,"comb_%.*s_%d",UN(node->name),node->id);
             
           Array<String> args = PushArray<String>(temp,size);
           for(int i = 0; i < size; i++){
-            args[i] = OutputName(instances,node->inputs[i],temp);
+            args[i] = OutputName(graph,node->inputs[i],temp);
           }
           String expr = Format(node->declaration->operation,args,temp);
           m->Set(identifier,expr);
@@ -489,7 +483,7 @@ void EmitCombOperations(VEmitter* m,Pool<FUInstance> instances){
 }
 
 // TODO: We want to merge this with the TopLevelInstanciateUnits. 
-void EmitInstanciateUnits(VEmitter* m,Pool<FUInstance> instances,FUDeclaration* module,Array<Array<int>> wireIndexByInstanceGood,Array<Wire> configs){
+void EmitInstanciateUnits(VEmitter* m,AcceleratorGraph* graph,FUDeclaration* module,Array<Array<int>> wireIndexByInstanceGood,Array<Wire> configs){
   TEMP_REGION(temp,m->arena);
   
   int delaySeen = 0;
@@ -499,8 +493,8 @@ void EmitInstanciateUnits(VEmitter* m,Pool<FUInstance> instances,FUDeclaration*
   int memoryMappedSeen = 0;
   int externalSeen = 0;
     
-  for(int instIndex = 0; instIndex < instances.Size(); instIndex++){
-    FUInstance* inst = instances.Get(instIndex);
+  for(int instIndex = 0; instIndex < graph->Size(); instIndex++){
+    FUInstance* inst = graph->instances[instIndex];
     FUDeclaration* decl = inst->declaration;
     if(decl == BasicDeclaration::input || decl == BasicDeclaration::output || decl->IsCombinatorialOperation()){
       continue;
@@ -530,7 +524,7 @@ void EmitInstanciateUnits(VEmitter* m,Pool<FUInstance> instances,FUDeclaration*
     for(int i = 0; i < inst->inputs.size; i++){
       if(inst->inputs[i].inst){
         PortInstance other = GetAssociatedOutputPortInstance(inst,i);
-        m->PortConnectIndexed("in%d",i,OutputName(instances,other,temp));
+        m->PortConnectIndexed("in%d",i,OutputName(graph,other,temp));
       } else {
         m->PortConnectIndexed("in%d",i,"0");
       }
@@ -647,7 +641,7 @@ void EmitInstanciateUnits(VEmitter* m,Pool<FUInstance> instances,FUDeclaration*
 }
 
 // TODO: We want to merge this function with EmitInstanceateUnits. They are basically the same code but need to handle the top level different in regards to the way wires are connection in relation to configs, states and stuff like that.
-void EmitTopLevelInstanciateUnits(VEmitter* m,VersatComputedValues val,Pool<FUInstance> instances,FUDeclaration* module,Array<Wire> configs){
+void EmitTopLevelInstanciateUnits(VEmitter* m,VersatComputedValues val,AcceleratorGraph* graph,FUDeclaration* module,Array<Wire> configs){
   TEMP_REGION(temp,m->arena);
   
   int doneSeen = 0;
@@ -655,10 +649,10 @@ void EmitTopLevelInstanciateUnits(VEmitter* m,VersatComputedValues val,Pool<FUIn
   int memoryMappedSeen = 0;
   int externalSeen = 0;
     
-  for(int instIndex = 0; instIndex < instances.Size(); instIndex++){
+  for(int instIndex = 0; instIndex < graph->Size(); instIndex++){
     BLOCK_REGION(temp);
 
-    FUInstance* inst = instances.Get(instIndex);
+    FUInstance* inst = graph->instances[instIndex];
 
     FUDeclaration* decl = inst->declaration;
     if(decl == BasicDeclaration::input || decl == BasicDeclaration::output || decl->IsCombinatorialOperation()){
@@ -689,7 +683,7 @@ void EmitTopLevelInstanciateUnits(VEmitter* m,VersatComputedValues val,Pool<FUIn
     for(int i = 0; i < inst->inputs.size; i++){
       if(inst->inputs[i].inst){
         PortInstance other = GetAssociatedOutputPortInstance(inst,i);
-        m->PortConnectIndexed("in%d",i,OutputName(instances,other,temp));
+        m->PortConnectIndexed("in%d",i,OutputName(graph,other,temp));
       } else {
         m->PortConnectIndexed("in%d",i,"0");
       }
@@ -810,11 +804,11 @@ void EmitTopLevelInstanciateUnits(VEmitter* m,VersatComputedValues val,Pool<FUIn
   }
 }
 
-void EmitConnectOutputsToOut(VEmitter* v,Pool<FUInstance> instances){
+void EmitConnectOutputsToOut(VEmitter* v,AcceleratorGraph* graph){
   TEMP_REGION(temp,v->arena);
 
   FUInstance* outNode = nullptr;
-  for(FUInstance* node : instances){
+  for(FUInstance* node : graph->instances){
     if(node->declaration == BasicDeclaration::output){
       outNode = node;
     }
@@ -829,7 +823,7 @@ void EmitConnectOutputsToOut(VEmitter* v,Pool<FUInstance> instances){
       PortInstance other = GetAssociatedOutputPortInstance(outNode,i);
       
       // TODO: Test this section very throughly
-      v->Assign(PushString(temp,"out%d",i),OutputName(instances,other,temp));
+      v->Assign(PushString(temp,"out%d",i),OutputName(graph,other,temp));
     }
   }
 }
@@ -961,7 +955,7 @@ void OutputCircuitSource(FUDeclaration* module,FILE* file){
   Accelerator* accel = module->fixedDelayCircuit;
   AccelInfo info = module->info;
 
-  Pool<FUInstance> instances = accel->allocated;
+  AcceleratorGraph* graph = CreateAcceleratorGraph(accel,temp);
   
   Array<InstanceInfo*> allSameLevel = GetAllSameLevelUnits(&info,0,0,temp);
   auto builder = StartArray<Array<int>>(temp);
@@ -1123,8 +1117,8 @@ void OutputCircuitSource(FUDeclaration* module,FILE* file){
   }
 
   if(info.numberConnections){
-    for(int i = 0; i < instances.Size(); i++){
-      FUInstance* node = instances.Get(i);
+    for(int i = 0; i < graph->Size(); i++){
+      FUInstance* node = graph->instances[i];
       for(int k = 0; k < node->outputs.size; k++){
         bool out = node->outputs[k];
         if(out){
@@ -1134,12 +1128,12 @@ void OutputCircuitSource(FUDeclaration* module,FILE* file){
     }
   }
   
-  EmitCombOperations(m,instances);
+  EmitCombOperations(m,graph);
 
   m->Blank();
-  EmitInstanciateUnits(m,instances,module,wireIndexByInstanceGood,configs);
+  EmitInstanciateUnits(m,graph,module,wireIndexByInstanceGood,configs);
 
-  EmitConnectOutputsToOut(m,instances);
+  EmitConnectOutputsToOut(m,graph);
 
   m->EndModule();
   
@@ -1490,14 +1484,15 @@ static Array<TypeStructInfo> GetMemMappedStructInfo(AccelInfo* info,Arena* out){
   return structures;
 }
 
-Array<TypeStructInfoElement> ExtractStructuredConfigs(Array<InstanceInfo> info,Arena* out){
+Array<TypeStructInfoElement> ExtractStructuredConfigs(AccelInfoIterator top,Arena* out){
   TEMP_REGION(temp,out);
 
   TrieMap<int,ArenaList<String>*>* map = PushTrieMap<int,ArenaList<String>*>(temp);
   
   int maxConfig = 0;
-  for(InstanceInfo& in : info){
-    if(in.isComposite || !in.globalConfigPos.has_value() || in.isConfigStatic){
+  for(AccelInfoIterator iter = top; iter.IsValid(); iter = iter.Step()){
+    InstanceInfo& in = *iter.CurrentUnit();
+    if(in.isComposite || !iter.GlobalConfigPos().has_value() || in.isConfigStatic){
       continue;
     }
     
@@ -1634,6 +1629,7 @@ StructInfo* GenerateStateStruct(AccelInfoIterator iter,Arena* out){
 
   StructInfo* res = PushStruct<StructInfo>(out);
 
+  AccelInfoIterator parentIter = iter.GetParent();
   InstanceInfo* parent = iter.GetParentUnit();
   if(parent){
     res->name = parent->decl->name;
@@ -1648,13 +1644,13 @@ StructInfo* GenerateStateStruct(AccelInfoIterator iter,Arena* out){
     InstanceInfo* unit = it.CurrentUnit();
     StructElement elem = {};
 
-    if(!unit->statePos.has_value()){
+    if(!it.StatePos().has_value()){
       continue;
     }
 
     int parentGlobalStatePos = 0;
     if(parent){
-      parentGlobalStatePos = parent->statePos.value();
+      parentGlobalStatePos = parentIter.StatePos().value();
     }
     
     elem.name = unit->baseName;
@@ -1716,7 +1712,7 @@ StructInfo* GenerateStateStruct(AccelInfoIterator iter,Arena* out){
     }
 
     // TODO: Kinda of an hack because we do not have local state pos the same way we have local config pos.
-    elem.localPos = unit->statePos.value() - parentGlobalStatePos;
+    elem.localPos = it.StatePos().value() - parentGlobalStatePos;
     elem.size = unit->stateSize;
     elem.doesNotBelong = unit->doesNotBelong;
     
@@ -1749,7 +1745,7 @@ StructInfo* GenerateConfigStructRecurse(AccelInfoIterator iter,TrieMap<StructInf
     InstanceInfo* unit = it.CurrentUnit();
     StructElement elem = {};
       
-    if(!unit->globalConfigPos.has_value()){
+    if(!it.GlobalConfigPos().has_value()){
       continue;
     }
     
@@ -2230,6 +2226,14 @@ static void OutputMakefile(String typeName,FUDeclaration* topLevelDecl,String so
       TemplateSetString("traceType",traceType);
     }
 
+    // Build acceleration. The makefile only stores the defaults, every value can still be overridden when calling make
+    TemplateSetNumber("verilatorThreads",globalOptions.verilatorThreads);
+    TemplateSetNumber("buildJobs",globalOptions.verilatorJobs);
+    TemplateSetNumber("outputSplit",globalOptions.verilatorJobs > 1 ? 20000 : 0); // Verilator default when splitting
+    TemplateSetString("ccache",globalOptions.verilatorCCache ? "ccache" : "");
+    TemplateSetString("optimizationFlags",PushString(temp,"-O%d",globalOptions.verilatorOptLevel));
+    TemplateSetString("defaultTarget",globalOptions.verilatorPGO ? "pgo.stamp" : "libaccel.a");
+
     ProcessTemplateSimple(output,META_MakefileTemplate_Content);
   }
 }
@@ -2245,7 +2249,7 @@ void OutputTopLevel(Accelerator* accel,Array<Wire> allStaticsVerilatorSide,Accel
     m->If(SF("csr_addr >= %d && csr_addr < %d",index,index+4));
   };
 
-  Pool<FUInstance> instances = accel->allocated;
+  AcceleratorGraph* graph = CreateAcceleratorGraph(accel,temp);
   
   if(!s){
     printf("Error creating file, check if filepath is correct: %.*s\n",UN(hardwarePath));
@@ -2266,7 +2270,7 @@ void OutputTopLevel(Accelerator* accel,Array<Wire> allStaticsVerilatorSide,Accel
 
   {
     VEmitter* m = StartVCode(temp);
-    EmitConnectOutputsToOut(m,instances);
+    EmitConnectOutputsToOut(m,graph);
     auto b = StartString(temp);
     Repr(EndVCode(m),b);
     String content = EndString(temp,b);
@@ -2278,7 +2282,7 @@ void OutputTopLevel(Accelerator* accel,Array<Wire> allStaticsVerilatorSide,Accel
     Array<Wire> configs = topLevelDecl->configs;
 
     VEmitter* m = StartVCode(temp);
-    EmitTopLevelInstanciateUnits(m,val,instances,topLevelDecl,configs);
+    EmitTopLevelInstanciateUnits(m,val,graph,topLevelDecl,configs);
     auto b = StartString(temp);
     Repr(EndVCode(m),b);
     String content = EndString(temp,b);
@@ -2706,8 +2710,8 @@ assign data_wstrb = csr_wstrb;
     VEmitter* m = StartVCode(temp);
 
     if(info.numberConnections){
-      for(int i = 0; i < instances.Size(); i++){
-        FUInstance* node = instances.Get(i);
+      for(int i = 0; i < graph->Size(); i++){
+        FUInstance* node = graph->instances[i];
         for(int k = 0; k < node->outputs.size; k++){
           bool out = node->outputs[k];
           if(out){
@@ -2811,7 +2815,7 @@ assign data_wstrb = csr_wstrb;
   {
     VEmitter* m = StartVCode(temp);
 
-    EmitCombOperations(m,instances);
+    EmitCombOperations(m,graph);
       
     auto b = StartString(temp);
     Repr(EndVCode(m),b);
@@ -3049,8 +3053,8 @@ void OutputHeader(Array<TypeStructInfoElement> structuredConfigs,AccelInfo info,
     }
   }
 
-  Array<String> allStates = ExtractStates(info.infos[0].info,temp2);
-  Array<Pair<String,int>> allMem = ExtractMem(info.infos[0].info,temp2);
+  Array<String> allStates = ExtractStates(StartIteration(&info),temp2);
+  Array<Pair<String,int>> allMem = ExtractMem(StartIteration(&info),temp2);
 
   TemplateSetBool("outputChangeDelay",false);
 
@@ -3125,6 +3129,10 @@ void OutputHeader(Array<TypeStructInfoElement> structuredConfigs,AccelInfo info,
 
     String content = GenerateAddressCompileAndLoadFunction(structName,initial,inst,temp);
     *builder.PushElem() = content;
+
+    if(initial->specializations.size > 0){
+      *builder.PushElem() = GenerateAddressSpecializedLoadFunctions(structName,initial,inst,temp);
+    }
   }
 
   Array<String> content = EndArray(builder);
@@ -3443,6 +3451,41 @@ void OutputHeader(Array<TypeStructInfoElement> structuredConfigs,AccelInfo info,
   ProcessTemplateSimple(f,META_HeaderTemplate_Content);
 }
 
+// Name of the unit that owns each databus interface, in the same order that the interfaces are connected by the instantiation code
+static void CollectDatabusOwners(Accelerator* accel,String prefix,ArenaList<String>* out,Arena* arena){
+  TEMP_REGION(temp,arena);
+  AcceleratorGraph* graph = CreateAcceleratorGraph(accel,temp);
+
+  for(int instIndex = 0; instIndex < graph->Size(); instIndex++){
+    FUInstance* inst = graph->instances[instIndex];
+    FUDeclaration* decl = inst->declaration;
+    if(decl == BasicDeclaration::input || decl == BasicDeclaration::output || decl->IsCombinatorialOperation()){
+      continue;
+    }
+    if(decl->nIOs == 0){
+      continue;
+    }
+
+    String name = inst->name;
+    if(!Empty(prefix)){
+      name = PushString(arena,"%.*s.%.*s",UN(prefix),UN(inst->name));
+    }
+
+    if((decl->type == FUDeclarationType_COMPOSITE || decl->type == FUDeclarationType_MERGED) && decl->fixedDelayCircuit){
+      CollectDatabusOwners(decl->fixedDelayCircuit,name,out,arena);
+      continue;
+    }
+
+    for(int i = 0; i < decl->nIOs; i++){
+      if(decl->nIOs > 1){
+        *out->PushElem() = PushString(arena,"%.*s[%d]",UN(name),i);
+      } else {
+        *out->PushElem() = name;
+      }
+    }
+  }
+}
+
 void OutputVerilatorWrapper(Accelerator* accel,Array<Wire> allStaticsVerilatorSide,AccelInfo info,FUDeclaration* topLevelDecl,Array<TypeStructInfoElement> structuredConfigs,String softwarePath){
   TEMP_REGION(temp,nullptr);
   Pool<FUInstance> nodes = accel->allocated;
@@ -3475,7 +3518,7 @@ void OutputVerilatorWrapper(Accelerator* accel,Array<Wire> allStaticsVerilatorSi
   auto external = EndArray(builder);
 
   TemplateSetNumber("delays",info.delays);
-  Array<String> statesHeaderSide = ExtractStates(info.infos[0].info,temp);
+  Array<String> statesHeaderSide = ExtractStates(StartIteration(&info),temp);
   
   TemplateSetNumber("nInputs",info.inputs);
   TemplateSetBool("implementsDone",info.implementsDone);
@@ -3634,36 +3677,31 @@ if(SimulateDatabus){
 
    DatabusAccess* access = &databusBuffer[@{i}];
 
-   if(self->databus_valid_@{i}){
-      if(access->latencyCounter > 0){
-         access->latencyCounter -= 1;
-      } else {
-         char* ptr = (char*) (self->databus_addr_@{i});
-
-         if(self->databus_wstrb_@{i} == 0){
-            if(ptr == nullptr){
-              memset(&self->databus_rdata_@{i},0xdf,sizeOfData);
-            } else {
-              memcpy(&self->databus_rdata_@{i},&ptr[access->counter * sizeOfData],sizeOfData);
-            }
-         } else { // self->databus_wstrb_@{i} != 0
-            if(ptr != nullptr){
-              memcpy(&ptr[access->counter * sizeOfData],&self->databus_wdata_@{i},sizeOfData);
-            }
-         }
-         self->databus_ready_@{i} = 1;
-
-         int transferLength = self->databus_len_@{i};
-         int countersLength = ALIGN_UP(transferLength,sizeOfData) / sizeOfData;
+   if(self->databus_valid_@{i} && access->beatAllowed){
+      char* ptr = (char*) (self->databus_addr_@{i});
 
-         if(access->counter >= countersLength - 1){
-            access->counter = 0;
-            self->databus_last_@{i} = 1;
+      if(self->databus_wstrb_@{i} == 0){
+         if(ptr == nullptr){
+           memset(&self->databus_rdata_@{i},0xdf,sizeOfData);
          } else {
-            access->counter += 1;
+           memcpy(&self->databus_rdata_@{i},&ptr[access->counter * sizeOfData],sizeOfData);
          }
+      } else { // self->databus_wstrb_@{i} != 0
+         if(ptr != nullptr){
+           memcpy(&ptr[access->counter * sizeOfData],&self->databus_wdata_@{i},sizeOfData);
+         }
+      }
+      self->databus_ready_@{i} = 1;
+
+      int transferLength = self->databus_len_@{i};
+      int countersLength = ALIGN_UP(transferLength,sizeOfData) / sizeOfData;
 
-         access->latencyCounter = MEMORY_LATENCY;
+      if(access->counter >= countersLength - 1){
+         access->counter = 0;
+         self->databus_last_@{i} = 1;
+         MemoryModelBurstDone(@{i});
+      } else {
+         access->counter += 1;
       }
    }
 
@@ -3671,7 +3709,23 @@ if(SimulateDatabus){
 }
                                      )FOO""";
 
+    // The memory model decides which masters get a beat this cycle, using every request at once
+    String requestTemplate = R"FOO(   requests[@{i}] = {(bool) self->databus_valid_@{i},self->databus_wstrb_@{i} != 0,(iptr) self->databus_addr_@{i}};
+)FOO";
+
     auto* s = StartString(temp);
+    if(info.nIOs){
+      s->PushString("if(SimulateDatabus){\n");
+      s->PushString("   DatabusRequest requests[%d];\n",info.nIOs);
+      for(int i = 0; i < info.nIOs; i++){
+        Hashmap<String,String>* vals = PushHashmap<String,String>(temp,1);
+        vals->Insert("i",PushString(temp,"%d",i));
+        TemplateSimpleSubstitute(s,requestTemplate,vals);
+      }
+      s->PushString("   SimulateMemoryModel(requests,%d);\n",info.nIOs);
+      s->PushString("}\n");
+    }
+    
     for(int i = 0; i < info.nIOs; i++){
       Hashmap<String,String>* vals = PushHashmap<String,String>(temp,1);
       vals->Insert("i",PushString(temp,"%d",i));
@@ -3681,6 +3735,51 @@ if(SimulateDatabus){
       
     TemplateSetString("databusSim",content);
   }
+
+  {
+    String profileBusTemplate = R"FOO(
+   if(self->databus_valid_@{i}){
+      anyValid = true;
+      databusProfile[@{i}].databusValid += 1;
+
+      if(self->databus_ready_@{i}){
+         anyReady = true;
+         databusProfile[@{i}].databusValidAndReady += 1;
+         databusProfile[@{i}].bytesTransferred += sizeOfData;
+      }
+   }
+)FOO";
+
+    auto* s = StartString(temp);
+    for(int i = 0; i < info.nIOs; i++){
+      Hashmap<String,String>* vals = PushHashmap<String,String>(temp,1);
+      vals->Insert("i",PushString(temp,"%d",i));
+      TemplateSimpleSubstitute(s,profileBusTemplate,vals);
+    }
+    String content = EndString(temp,s);
+      
+    TemplateSetString("databusProfile",content);
+  }
+
+  {
+    auto list = PushArenaList<String>(temp);
+    CollectDatabusOwners(accel,{},list,temp);
+    Array<String> owners = PushArrayFromList(temp,list);
+
+    auto* s = StartString(temp);
+    s->PushString("static const char* databusOwnerNames[] = {\n");
+    for(int i = 0; i < info.nIOs; i++){
+      // Fallback in case the instantiation order ever stops matching
+      if(owners.size == info.nIOs){
+        s->PushString("  \"%.*s\",\n",UN(owners[i]));
+      } else {
+        s->PushString("  \"databus_%d\",\n",i);
+      }
+    }
+    s->PushString("};");
+    
+    TemplateSetString("databusOwners",EndString(temp,s));
+  }
     
   {
     CEmitter* c = StartCCode(temp);
@@ -3998,6 +4097,44 @@ static iptr WRITE_@{0} = 0;)FOO";
 
   TemplateSetNumber("databusDataSize",globalOptions.databusDataSize);
 
+  // Top level signals that waveform triggers can refer to by name
+  {
+    auto names = PushArenaList<String>(temp);
+    *names->PushElem() = "run";
+    *names->PushElem() = "running";
+    if(info.implementsDone){
+      *names->PushElem() = "done";
+    }
+    for(int i = 0; i < info.nIOs; i++){
+      *names->PushElem() = PushString(temp,"databus_valid_%d",i);
+      *names->PushElem() = PushString(temp,"databus_ready_%d",i);
+      *names->PushElem() = PushString(temp,"databus_addr_%d",i);
+    }
+    for(Wire w : topLevelDecl->states){
+      *names->PushElem() = w.name;
+    }
+    for(WireExtra& w : allConfigsVerilatorSide){
+      *names->PushElem() = w.name;
+    }
+    Array<String> signals = PushArrayFromList(temp,names);
+
+    auto s = StartString(temp);
+    s->PushString("static const char* traceSignalNames[] = {\n");
+    for(String name : signals){
+      s->PushString("  \"%.*s\",\n",UN(name));
+    }
+    s->PushString("};\n\n");
+    
+    s->PushString("static long long TraceSignalRead(V%.*s* self,int index){\n",UN(accel->name));
+    s->PushString("  switch(index){\n");
+    for(int i = 0; i < signals.size; i++){
+      s->PushString("  case %d: return TraceSignalToInt(self->%.*s);\n",i,UN(signals[i]));
+    }
+    s->PushString("  }\n  return 0;\n}\n");
+
+    TemplateSetString("traceSignals",EndString(temp,s));
+  }
+
   String wrapperPath = PushString(temp,"%.*s/wrapper.cpp",UN(softwarePath));
   FILE* output = OpenFileAndCreateDirectories(wrapperPath,"w",FilePurpose_SOFTWARE);
   DEFER_CLOSE_FILE(output);
@@ -4178,7 +4315,7 @@ static iptr WRITE_@{0} = 0;)FOO";
   ProcessTemplateSimple(output,META_WrapperTemplate_Content);
 }
 
-void OutputFirmware(String softwarePath,VersatComputedValues val){
+void OutputFirmware(String typeName,String softwarePath,VersatComputedValues val){
   TEMP_REGION(temp,nullptr);
   
   //TODO: The src folder is not good. We want to remove this. We should not depend on IOb stuff in Versat code. 
@@ -4198,6 +4335,7 @@ void OutputFirmware(String softwarePath,VersatComputedValues val){
   
   String content = PushASTRepr(c,temp);
   TemplateSetString("registerLocation",content);
+  TemplateSetString("typeName",typeName);
 
   String dmaExists = R"FOO(
   if(enableDMA && (dataInsideVersat != destInsideVersat)){
@@ -4362,7 +4500,7 @@ void VersatPrintProfile(VersatProfile p){
   PRINT("  Configurations set while accel running: %llu\n",
         p.configurationsSetWhileRunning);
   PRINT("  Configurations efficiency: %llu%%\n",
-        Percentage(p.configurationsSet, p.configurationsSetWhileRunning));
+        Percentage(p.configurationsSetWhileRunning, p.configurationsSet));
 }
 )FOO";
 
@@ -4548,14 +4686,14 @@ void OutputTopLevelFiles(Accelerator* accel,FUDeclaration* topDecl,String hardwa
     fprintf(s,"%.*s\n",UN(content));
   }
 
-  Array<TypeStructInfoElement> structuredConfigs = ExtractStructuredConfigs(info.infos[0].info,temp);
+  Array<TypeStructInfoElement> structuredConfigs = ExtractStructuredConfigs(StartIteration(&info),temp);
 
   OutputTopLevel(accel,allStaticsVerilatorSide,info,topDecl,structuredConfigs,hardwarePath,val,external,wireInfo);
   OutputHeader(structuredConfigs,info,isSimple,accel,softwarePath,allStaticsVerilatorSide,val);
   OutputVerilatorWrapper(accel,allStaticsVerilatorSide,info,topDecl,structuredConfigs,softwarePath);
   OutputMakefile(accel->name,topDecl,softwarePath);
   OutputPCEmulControl(info,softwarePath);
-  OutputFirmware(softwarePath,val);
+  OutputFirmware(accel->name,softwarePath,val);
 
   {
     // TODO: Need to add some form of error checking and handling inside the script for the case where verilator root is not found
@@ -18,6 +18,10 @@ Array<InstanceInfo>& AccelInfoIterator::GetCurrentMerge(){
   return info->infos[mergeIndex].info;
 }
 
+InstanceInfoTable* AccelInfoIterator::GetCurrentTable(){
+  return &info->infos[mergeIndex].table;
+}
+
 int AccelInfoIterator::MergeSize(){
   if(info->infos.size){
     return info->infos.size;
@@ -55,21 +59,14 @@ AccelInfoIterator AccelInfoIterator::GetParent(){
     return {};
   }
 
-  int currentLevel = GetCurrentMerge()[this->index].level;
-  if(currentLevel == 0){
+  int parent = GetCurrentTable()->parent[this->index];
+  if(parent == -1){
     return {};
   }
 
-  for(int i = this->index - 1; i >= 0; i--){
-    if(GetCurrentMerge()[i].level < currentLevel){
-      Assert(GetCurrentMerge()[i].level == currentLevel - 1);
-      AccelInfoIterator res = *this;
-      res.index = i;
-      return res;
-    }
-  }
-
-  NOT_POSSIBLE("Any valid AccelInfo should never reach this point");
+  AccelInfoIterator res = *this;
+  res.index = parent;
+  return res;
 }
 
 InstanceInfo* AccelInfoIterator::GetParentUnit(){
@@ -89,25 +86,54 @@ InstanceInfo* AccelInfoIterator::GetUnit(int indexParam){
   return &GetCurrentMerge()[indexParam];
 }
 
+int AccelInfoIterator::Level(){
+  return GetCurrentTable()->level[index];
+}
+
+FUDeclaration* AccelInfoIterator::Decl(){
+  return GetCurrentTable()->decl[index];
+}
+
+static Opt<int> PositionOpt(int pos){
+  if(pos == -1){
+    return {};
+  }
+  return pos;
+}
+
+Opt<int> AccelInfoIterator::GlobalConfigPos(){
+  return PositionOpt(GetCurrentTable()->configPos[index]);
+}
+
+Opt<int> AccelInfoIterator::StatePos(){
+  return PositionOpt(GetCurrentTable()->statePos[index]);
+}
+
+Opt<int> AccelInfoIterator::DelayPos(){
+  return PositionOpt(GetCurrentTable()->delayPos[index]);
+}
+
+int AccelInfoIterator::LocalOrder(){
+  return GetCurrentTable()->localOrder[index];
+}
+
+NodeType AccelInfoIterator::ConnectionType(){
+  return GetCurrentTable()->connectionType[index];
+}
+
 AccelInfoIterator AccelInfoIterator::Next(){
   if(!IsValid()){
     return {};
   }
 
-  int currentLevel = GetCurrentMerge()[index].level;
-  for(int i = index + 1; i < GetCurrentMerge().size; i++){
-    int level = GetCurrentMerge()[i].level; 
-    if(level == currentLevel){
-      AccelInfoIterator toReturn = *this;
-      toReturn.index = i;
-      return toReturn;
-    }
-    if(level < currentLevel){
-      return {};
-    }
+  int next = GetCurrentTable()->nextSibling[index];
+  if(next == -1){
+    return {};
   }
 
-  return {};
+  AccelInfoIterator toReturn = *this;
+  toReturn.index = next;
+  return toReturn;
 }
 
 AccelInfoIterator AccelInfoIterator::Step(){
@@ -129,8 +155,8 @@ AccelInfoIterator AccelInfoIterator::StepInsideOnly(){
     return {};
   }
 
-  int currentLevel = GetCurrentMerge()[index].level;
-  if(index + 1 < GetCurrentMerge().size && GetCurrentMerge()[index + 1].level > currentLevel){
+  Array<int> level = GetCurrentTable()->level;
+  if(index + 1 < level.size && level[index + 1] > level[index]){
     AccelInfoIterator toReturn = *this;
     toReturn.index = index + 1;
     return toReturn;
@@ -154,12 +180,12 @@ AccelInfoIterator AccelInfoIterator::ReverseStep(){
 }
 
 int AccelInfoIterator::CurrentLevelSize(){
-  Array<InstanceInfo>& array = GetCurrentMerge();
-  int currentLevel = array[index].level;
+  Array<int> level = GetCurrentTable()->level;
+  int currentLevel = level[index];
 
   int size = 0;
-  for(int i = 0; i < array.size; i++){
-    if(array[i].level == currentLevel){
+  for(int i = 0; i < level.size; i++){
+    if(level[i] == currentLevel){
       size += 1;
     }
   }
@@ -174,10 +200,8 @@ Array<InstanceInfo*> GetAllSameLevelUnits(AccelInfo* info,int level,int mergeInd
   iter.SetMergeIndex(mergeIndex);
 
   for(; iter.IsValid(); iter = iter.Step()){
-    InstanceInfo* unit = iter.CurrentUnit();
-
-    if(unit->level == level){
-      *builder.PushElem() = unit;
+    if(iter.Level() == level){
+      *builder.PushElem() = iter.CurrentUnit();
     }
   }
 
@@ -198,21 +222,22 @@ AccelInfoIterator StartIterationFromEnding(AccelInfo* info){
   return iter;
 }
 
-Array<String> ExtractStates(Array<InstanceInfo> info,Arena* out){
+Array<String> ExtractStates(AccelInfoIterator top,Arena* out){
   int count = 0;
-  for(InstanceInfo& in : info){
-    if(!in.isComposite && in.statePos.has_value()){
-      count += in.decl->states.size;
+  for(AccelInfoIterator iter = top; iter.IsValid(); iter = iter.Step()){
+    if(!iter.CurrentUnit()->isComposite && iter.StatePos().has_value()){
+      count += iter.Decl()->states.size;
     }
   }
 
   Array<String> res = PushArray<String>(out,count);
   int index = 0;
-  for(InstanceInfo& in : info){
-    if(!in.isComposite && in.statePos.has_value()){
-      FUDeclaration* decl = in.decl;
+  for(AccelInfoIterator iter = top; iter.IsValid(); iter = iter.Step()){
+    InstanceInfo* in = iter.CurrentUnit();
+    if(!in->isComposite && iter.StatePos().has_value()){
+      FUDeclaration* decl = iter.Decl();
       for(Wire& wire : decl->states){
-        res[index++] = PushString(out,"%.*s_%.*s",UN(in.fullName),UN(wire.name)); 
+        res[index++] = PushString(out,"%.*s_%.*s",UN(in->fullName),UN(wire.name)); 
       }
     }
   }
@@ -220,26 +245,60 @@ Array<String> ExtractStates(Array<InstanceInfo> info,Arena* out){
   return res;
 }
 
-Array<Pair<String,int>> ExtractMem(Array<InstanceInfo> info,Arena* out){
+Array<Pair<String,int>> ExtractMem(AccelInfoIterator top,Arena* out){
   int count = 0;
-  for(InstanceInfo& in : info){
-    if(!in.isComposite && in.memMapped.has_value()){
+  for(AccelInfoIterator iter = top; iter.IsValid(); iter = iter.Step()){
+    InstanceInfo* in = iter.CurrentUnit();
+    if(!in->isComposite && in->memMapped.has_value()){
       count += 1;
     }
   }
 
   Array<Pair<String,int>> res = PushArray<Pair<String,int>>(out,count);
   int index = 0;
-  for(InstanceInfo& in : info){
-    if(!in.isComposite && in.memMapped.has_value()){
-      String name = PushString(out,"%.*s_addr",UN(in.fullName)); 
-      res[index++] = {name,(int) in.memMapped.value()};
+  for(AccelInfoIterator iter = top; iter.IsValid(); iter = iter.Step()){
+    InstanceInfo* in = iter.CurrentUnit();
+    if(!in->isComposite && in->memMapped.has_value()){
+      String name = PushString(out,"%.*s_addr",UN(in->fullName)); 
+      res[index++] = {name,(int) in->memMapped.value()};
     }
   }
 
   return res;
 }
 
+InstanceInfoView GetDebugView(AccelInfoIterator iter){
+  InstanceInfoTable* table = iter.GetCurrentTable();
+  int index = iter.index;
+
+  InstanceInfoView res = {};
+  res.index = index;
+  res.level = table->level[index];
+  res.parent = table->parent[index];
+  res.nextSibling = table->nextSibling[index];
+  res.decl = table->decl[index];
+  res.globalConfigPos = iter.GlobalConfigPos();
+  res.statePos = iter.StatePos();
+  res.delayPos = iter.DelayPos();
+  res.localOrder = table->localOrder[index];
+  res.connectionType = table->connectionType[index];
+  res.cold = *iter.CurrentUnit();
+  
+  return res;
+}
+
+Array<InstanceInfoView> GetDebugView(AccelInfo* info,int mergeIndex,Arena* out){
+  AccelInfoIterator iter = StartIteration(info);
+  iter.SetMergeIndex(mergeIndex);
+  
+  Array<InstanceInfoView> res = PushArray<InstanceInfoView>(out,iter.GetCurrentMerge().size);
+  for(; iter.IsValid(); iter = iter.Step()){
+    res[iter.index] = GetDebugView(iter);
+  }
+
+  return res;
+}
+
 String ReprStaticConfig(StaticId id,Wire* wire,Arena* out){
   String identifier = PushString(out,"%.*s_%.*s_%.*s",UN(id.parent->name),UN(id.name),UN(wire->name));
 
@@ -326,22 +385,54 @@ String GetName(Array<Partition> partitions,Arena* out){
   return EndString(out,builder);
 }
 
+static void FillTableNavigation(InstanceInfoTable* table){
+  TEMP_REGION(temp,nullptr);
+
+  Array<int> level = table->level;
+
+  int maxLevel = 0;
+  for(int l : level){
+    maxLevel = MAX(maxLevel,l);
+  }
+
+  // Last unit seen of each level. Since units are stored depth first, the last unit seen one level up is the parent.
+  Array<int> lastSeen = PushArray<int>(temp,maxLevel + 1);
+  Memset(lastSeen,-1);
+
+  for(int i = 0; i < level.size; i++){
+    int l = level[i];
+    int parent = -1;
+    if(l > 0){
+      parent = lastSeen[l - 1];
+      Assert(parent != -1);
+    }
+
+    table->parent[i] = parent;
+    table->nextSibling[i] = -1;
+
+    int previous = lastSeen[l];
+    if(previous != -1 && table->parent[previous] == parent){
+      table->nextSibling[previous] = i;
+    }
+    lastSeen[l] = i;
+  }
+}
+
 // TODO: Move this function to a better place
 // This function cannot return an array for merge units because we do not have the merged units info in this level.
 // This function only works for modules and for recursing the merged info to upper modules.
 // The info needed by merge must be stored by the merge function.
-Array<InstanceInfo> GenerateInitialInstanceInfo(Accelerator* accel,Arena* out,Array<Partition> partitions,bool calculateOrder){
+void GenerateInitialInstanceInfo(MergePartition* partition,Accelerator* accel,Arena* out,Array<Partition> partitions,bool calculateOrder){
   TEMP_REGION(temp,out);
   // Only for basic units on the top level of accel
   // The subunits are basically copied from the sub declarations.
   // Or they are calculated inside the Fill... function
-  auto SetBaseInfo = [](InstanceInfo* elem,FUInstance* inst,int level,Arena* out){
+  auto SetBaseInfo = [](InstanceInfo* elem,FUInstance* inst,Arena* out){
     *elem = {};
     elem->inst = inst;
     elem->name = inst->name;
     elem->baseName = inst->name; // Remember this function only sets basic units, so the baseName is just the name.
     elem->decl = inst->declaration;
-    elem->level = level;
     elem->isComposite = IsTypeHierarchical(inst->declaration);
     elem->isMerge = inst->declaration->type == FUDeclarationType_MERGED;
     elem->isStatic = inst->isStatic;
@@ -356,7 +447,6 @@ Array<InstanceInfo> GenerateInitialInstanceInfo(Accelerator* accel,Arena* out,Ar
     elem->id = inst->id;
     elem->inputDelays = inst->declaration->GetInputDelays();
     elem->outputLatencies = inst->declaration->GetOutputLatencies();
-    elem->connectionType = inst->type;
     elem->partitionIndex = 0;
     elem->individualWiresShared = inst->isSpecificConfigShared;
     elem->addressGenUsed = inst->addressGenUsed;
@@ -368,101 +458,136 @@ Array<InstanceInfo> GenerateInitialInstanceInfo(Accelerator* accel,Arena* out,Ar
     elem->individualWiresGlobalConfigPos = PushArray<int>(out,inst->declaration->NumberConfigs());
     elem->individualWiresLocalConfigPos = PushArray<int>(out,inst->declaration->NumberConfigs());
   };
-  
-  // NOTE: This function fills all the subunits that belong to composite units.
-  //       Care must be taken when having arrays inside InstanceInfos, these need to be copied individually otherwise we are changing data for the subunits declarations as well.
-  auto Function = [SetBaseInfo](auto Recurse,GrowableArray<InstanceInfo>& array,Accelerator* accel,int level,Array<Partition> partitions,Arena* out) -> void{
+
+  // Subunits are copied from the merge partition selected for each unit, so we know the amount of units beforehand.
+  int amountOfInstances = accel->allocated.Size();
+  Array<int> mergeIndexes = PushArray<int>(temp,amountOfInstances);
+  int amountOfUnits = 0;
+  {
     int partitionIndex = 0;
+    int index = 0;
     for(FUInstance* inst : accel->allocated){
-      InstanceInfo* elem = array.PushElem();
-      SetBaseInfo(elem,inst,level,out);
-
       AccelInfoIterator iter = StartIteration(&inst->declaration->info);
 
       if(partitions.size > 0 && inst->declaration->info.infos.size > 1){
         iter.SetMergeIndex(partitions[partitionIndex].value);
-        elem->outputLatencies = partitions[partitionIndex].decl->info.infos[iter.mergeIndex].outputLatencies;
-        elem->partitionIndex = partitions[partitionIndex].value;
         partitionIndex += 1;
       }
-      
-      for(; iter.IsValid(); iter = iter.Step()){
-        InstanceInfo* subUnit = iter.CurrentUnit();
-        InstanceInfo* elem = array.PushElem();
-
-        *elem = *subUnit;
-        elem->individualWiresGlobalConfigPos = CopyArray(subUnit->individualWiresGlobalConfigPos,out);
-        Memset(elem->individualWiresGlobalConfigPos,0);
-        elem->level += 1;
-      }
-    }
-  };
-  
-  auto build = StartArray<InstanceInfo>(out);
-
-  Function(Function,build,accel,0,partitions,out);
-  Array<InstanceInfo> res = EndArray(build);
 
-  auto instanceToIndex = PushTrieMap<FUInstance*,int>(temp);
-
-  for(int i = 0; i < res.size; i++){
-    int index = i;
-    InstanceInfo* info = &res[i];
-    if(info->level != 0){
-      continue;
-    }
-    
-    for(FUInstance* inst : accel->allocated){
-      if(inst == info->inst){
-        instanceToIndex->Insert(inst,index);
+      mergeIndexes[index++] = iter.mergeIndex;
+      amountOfUnits += 1;
+      if(inst->declaration->info.infos.size > 0){
+        amountOfUnits += iter.GetCurrentMerge().size;
       }
     }
   }
 
-  for(int i = 0; i < res.size; i++){
-    InstanceInfo* info = &res[i];
-    if(info->level != 0){
-      continue;
+  Array<InstanceInfo> res = PushArray<InstanceInfo>(out,amountOfUnits);
+
+  InstanceInfoTable* table = &partition->table;
+  *table = {};
+  table->level = PushArray<int>(out,amountOfUnits);
+  table->parent = PushArray<int>(out,amountOfUnits);
+  table->nextSibling = PushArray<int>(out,amountOfUnits);
+  table->decl = PushArray<FUDeclaration*>(out,amountOfUnits);
+  table->configPos = PushArray<int>(out,amountOfUnits);
+  table->statePos = PushArray<int>(out,amountOfUnits);
+  table->delayPos = PushArray<int>(out,amountOfUnits);
+  table->localOrder = PushArray<int>(out,amountOfUnits);
+  table->connectionType = PushArray<NodeType>(out,amountOfUnits);
+  
+  // NOTE: This fills all the subunits that belong to composite units.
+  //       Care must be taken when having arrays inside InstanceInfos, these need to be copied individually otherwise we are changing data for the subunits declarations as well.
+  int index = 0;
+  int partitionIndex = 0;
+  int instanceIndex = 0;
+  for(FUInstance* inst : accel->allocated){
+    int mergeIndex = mergeIndexes[instanceIndex++];
+
+    InstanceInfo* elem = &res[index];
+    SetBaseInfo(elem,inst,out);
+
+    if(partitions.size > 0 && inst->declaration->info.infos.size > 1){
+      elem->outputLatencies = partitions[partitionIndex].decl->info.infos[mergeIndex].outputLatencies;
+      elem->partitionIndex = mergeIndex;
+      partitionIndex += 1;
     }
 
-    FUInstance* inst = info->inst;
-    
-    ArenaList<SimplePortConnection>* list = PushArenaList<SimplePortConnection>(temp);
+    table->level[index] = 0;
+    table->decl[index] = inst->declaration;
+    table->configPos[index] = -1;
+    table->statePos[index] = -1;
+    table->delayPos[index] = -1;
+    table->localOrder[index] = 0;
+    table->connectionType[index] = inst->type;
+    index += 1;
+
+    AccelInfoIterator iter = StartIteration(&inst->declaration->info);
+    iter.SetMergeIndex(mergeIndex);
     
-    FOREACH_LIST(ConnectionNode*,ptr,inst->allInputs){
-      FUInstance* out = ptr->instConnectedTo.inst;
-      int outPort = ptr->instConnectedTo.port;
+    for(; iter.IsValid(); iter = iter.Step()){
+      InstanceInfo* subUnit = iter.CurrentUnit();
+      InstanceInfoTable* subTable = iter.GetCurrentTable();
+      int subIndex = iter.index;
+      InstanceInfo* elem = &res[index];
+
+      *elem = *subUnit;
+      elem->individualWiresGlobalConfigPos = CopyArray(subUnit->individualWiresGlobalConfigPos,out);
+      Memset(elem->individualWiresGlobalConfigPos,0);
+
+      table->level[index] = subTable->level[subIndex] + 1;
+      table->decl[index] = subTable->decl[subIndex];
+      table->configPos[index] = subTable->configPos[subIndex];
+      table->statePos[index] = subTable->statePos[subIndex];
+      table->delayPos[index] = subTable->delayPos[subIndex];
+      table->localOrder[index] = subTable->localOrder[subIndex];
+      table->connectionType[index] = subTable->connectionType[subIndex];
+      index += 1;
+    }
+  }
+  Assert(index == amountOfUnits);
 
-      int outIndex = instanceToIndex->GetOrFail(out);
+  FillTableNavigation(table);
+  
+  AcceleratorGraph* graph = CreateAcceleratorGraph(accel,temp);
 
-      SimplePortConnection* portInst = list->PushElem();
-      portInst->outInst = outIndex;
-      portInst->outPort = outPort;
-      portInst->inPort = ptr->port;
+  // Level 0 infos are the top level instances, in pool order
+  Array<int> graphToInfo = PushArray<int>(temp,graph->Size());
+  int topIndex = 0;
+  for(int i = 0; i < res.size; i++){
+    if(table->level[i] == 0){
+      Assert(res[i].inst == graph->instances[topIndex]);
+      graphToInfo[topIndex++] = i;
+    }
+  }
+  Assert(topIndex == graph->Size());
+
+  for(int i = 0; i < graph->Size(); i++){
+    InstanceInfo* info = &res[graphToInfo[i]];
+
+    Array<GraphConnection> inputs = graph->Inputs(i);
+    info->inputs = PushArray<SimplePortConnection>(out,inputs.size);
+    for(int ii = 0; ii < inputs.size; ii++){
+      SimplePortConnection* portInst = &info->inputs[ii];
+      portInst->outInst = graphToInfo[inputs[ii].other];
+      portInst->outPort = inputs[ii].otherPort;
+      portInst->inPort = inputs[ii].port;
+      portInst->edgeDelay = inputs[ii].delay;
     }
-    info->inputs = PushArrayFromList(out,list);
   }
 
 #if 1
   if(calculateOrder){
-    DAGOrderNodes order = CalculateDAGOrder(accel,temp);
-    {
-      for(int index = 0; index < res.size; index++){
-        InstanceInfo* info = &res[index];
-
-        FUInstance* inst = info->inst;
-        for(int i = 0; i < order.instances.size; i++){
-          if(order.instances[i] == inst){
-            info->localOrder = i;
-            break;
-          }
-        }
-      }
+    DAGOrderNodes order = CalculateDAGOrder(graph,temp);
+
+    for(int i = 0; i < order.instances.size; i++){
+      int graphIndex = graph->IndexOf(order.instances[i]);
+      table->localOrder[graphToInfo[graphIndex]] = i;
     }
   }
 #endif
-  
-  return res;
+
+  partition->info = res;
 }
 
 struct Node{
@@ -477,6 +602,8 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
   TEMP_REGION(temp,out);
   Assert(!Empty(initialIter.accelName)); // For now, we must have some name if only to output debug info graphs and such
 
+  InstanceInfoTable* table = initialIter.GetCurrentTable();
+
   for(AccelInfoIterator iter = initialIter; iter.IsValid(); iter = iter.Step()){
     InstanceInfo* parent = iter.GetParentUnit();
     if(parent){
@@ -521,8 +648,7 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
   auto CalculateAmountOfLevels = [](AccelInfoIterator initialIter){
     int maxLevelSeen = 0;
     for(AccelInfoIterator iter = initialIter; iter.IsValid(); iter = iter.Step()){
-      InstanceInfo* info = iter.CurrentUnit();
-      maxLevelSeen = MAX(maxLevelSeen,info->level);
+      maxLevelSeen = MAX(maxLevelSeen,iter.Level());
     }
     return maxLevelSeen + 1;
   };
@@ -532,8 +658,7 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
 
     Array<int> amountOfUnits = PushArray<int>(out,amountOfLevels);
     for(AccelInfoIterator iter = initialIter; iter.IsValid(); iter = iter.Step()){
-      InstanceInfo* info = iter.CurrentUnit();
-      amountOfUnits[info->level] += 1;
+      amountOfUnits[iter.Level()] += 1;
     }
 
     return amountOfUnits;
@@ -553,8 +678,7 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
     Array<int> indexPerLevel = PushArray<int>(temp,amountOfLevels);
 
     for(AccelInfoIterator iter = initialIter; iter.IsValid(); iter = iter.Step()){
-      InstanceInfo* info = iter.CurrentUnit();
-      int level = info->level;
+      int level = iter.Level();
       int currentIndex = indexPerLevel[level];
       
       iterators[level][currentIndex] = iter;
@@ -598,7 +722,7 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
           unit->individualWiresGlobalConfigPos[i] = -1;
         }
 
-        unit->globalConfigPos = {};
+        table->configPos[iter.index] = -1;
         continue;
       }
 
@@ -640,7 +764,7 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
       }
 
       // Store global pos already because for top level localPos == globalPos
-      unit->globalConfigPos = unit->localConfigPos;
+      table->configPos[iter.index] = unit->localConfigPos.value_or(-1);
     }
   }
   
@@ -649,11 +773,11 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
     for(AccelInfoIterator iter : allIteratorsPerLevel[level]){
       InstanceInfo* parent = iter.CurrentUnit();
 
-      if(!parent->globalConfigPos.has_value()){
+      if(!iter.GlobalConfigPos().has_value()){
         continue;
       }
       
-      int parentGlobalPos = parent->globalConfigPos.value();
+      int parentGlobalPos = iter.GlobalConfigPos().value();
 
       AccelInfoIterator configIter = StartIteration(&parent->decl->info);
       configIter.SetMergeIndex(parent->partitionIndex);
@@ -671,7 +795,7 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
         }
 
         if(configUnit->localConfigPos.has_value()){
-          unit->globalConfigPos = parentGlobalPos + configUnit->localConfigPos.value();
+          table->configPos[it.index] = parentGlobalPos + configUnit->localConfigPos.value();
         }
       }
     }
@@ -692,13 +816,12 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
       int index = 0;
       for(AccelInfoIterator it = iter; it.IsValid(); it = it.Next(),stateIter = stateIter.Next()){
         InstanceInfo* unit = it.CurrentUnit();
-        InstanceInfo* stateUnit = stateIter.CurrentUnit();
         
-        if(stateUnit->statePos.has_value()){
-          int statePos = startIndex + stateUnit->statePos.value();
+        if(stateIter.StatePos().has_value()){
+          int statePos = startIndex + stateIter.StatePos().value();
           
           if(unit->stateSize){
-            unit->statePos = statePos;
+            it.GetCurrentTable()->statePos[it.index] = statePos;
           }
           
           index += 1;
@@ -714,7 +837,7 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
         InstanceInfo* unit = it.CurrentUnit();
 
         if(unit->stateSize){
-          unit->statePos = stateIndex;
+          it.GetCurrentTable()->statePos[it.index] = stateIndex;
         }
         
         AccelInfoIterator inside = it.StepInsideOnly();
@@ -845,13 +968,12 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
       int index = 0;
       for(AccelInfoIterator it = iter; it.IsValid(); it = it.Next(),delayIter = delayIter.Next()){
         InstanceInfo* unit = it.CurrentUnit();
-        InstanceInfo* delayUnit = delayIter.CurrentUnit();
 
-        if(delayUnit->delayPos.has_value()){
-          int delayPos = startIndex + delayUnit->delayPos.value();
+        if(delayIter.DelayPos().has_value()){
+          int delayPos = startIndex + delayIter.DelayPos().value();
         
           if(unit->delaySize){
-            unit->delayPos = delayPos;
+            it.GetCurrentTable()->delayPos[it.index] = delayPos;
           }
           
           index += 1;
@@ -867,7 +989,7 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
         InstanceInfo* unit = it.CurrentUnit();
 
         if(unit->delaySize){
-          unit->delayPos = delayIndex;
+          it.GetCurrentTable()->delayPos[it.index] = delayIndex;
         }
         
         AccelInfoIterator inside = it.StepInsideOnly();
@@ -911,7 +1033,7 @@ void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out){
     } else {
       for(AccelInfoIterator it = iter; it.IsValid(); it = it.Next()){
         InstanceInfo* unit = it.CurrentUnit();
-        int order = unit->localOrder;
+        int order = it.LocalOrder();
 
         unit->baseNodeDelay = calculatedDelay.nodeBaseLatencyByOrder[order].value;
         unit->portDelay = PushArray<int>(out,calculatedDelay.inputPortBaseLatencyByOrder[order].size);
@@ -1197,7 +1319,7 @@ AccelInfo CalculateAcceleratorInfo(Accelerator* accel,bool recursive,Arena* out,
       iter.SetMergeIndex(i);
 
       // We do need partitions here, I think
-      result.infos[i].info = GenerateInitialInstanceInfo(accel,out,partitions,calculateOrder);
+      GenerateInitialInstanceInfo(&result.infos[i],accel,out,partitions,calculateOrder);
 
       FillInstanceInfo(iter,out);
 
@@ -1209,7 +1331,7 @@ AccelInfo CalculateAcceleratorInfo(Accelerator* accel,bool recursive,Arena* out,
     }
   } else {
     iter.SetMergeIndex(0);
-    result.infos[0].info = GenerateInitialInstanceInfo(accel,out,{},calculateOrder);
+    GenerateInitialInstanceInfo(&result.infos[0],accel,out,{},calculateOrder);
     FillInstanceInfo(iter,out);
 
     result.infos[0].inputDelays = ExtractInputDelays(iter,out);
@@ -12,6 +12,7 @@ struct SimplePortConnection{
   int outInst;
   int outPort;
   int inPort;
+  int edgeDelay;
 };
 
 struct StructInfo;
@@ -21,14 +22,13 @@ struct StructInfo;
 // Data that is carried directly from the units is set inside GenerateInitialInstanceInfo
 // Data that is computed from graph / data that depends on other units is calculated inside FillInstanceInfo
 
-// We currently just stuff everything into this struct, so it's easier to visualize all the info that we need for the current accelerator.
-// Some of this data is duplicated/unnecessary, but for now we just carry on since this simplifies debugging a lot, being able to see all the info for a given accelerator directly.
-// This approach is very slow but easier to debug since everything related to one unit is all in the same place.
-// Until I find a better way of debugging (visualizing) SoA, this will stay like this for a while.
+// The data of each unit is split in two. The hot data (read by every pass when iterating or calculating positions) lives in InstanceInfoTable, as parallel arrays.
+// Everything else lives in InstanceInfo, which is basically a side table that is only accessed when a pass needs the specific member.
+// Both are indexed the same way, so the index of an InstanceInfo is also the index of its hot data.
+// When debugging, GetDebugView rebuilds the entire data of a unit in one place.
 
 // TODO: Put some note explaining the required changes when inserting stuff here.
 struct InstanceInfo{
-  int level;
   FUDeclaration* decl;
   FUDeclaration* parent;
   
@@ -38,7 +38,6 @@ struct InstanceInfo{
   String fullName;
   
   Opt<int> globalStaticPos; // Separating static from global makes stuff simpler. If mixing together, do not forget that struct generation cares about source of configPos.
-  Opt<int> globalConfigPos;
   Opt<int> localConfigPos;
 
   Array<int> individualWiresGlobalStaticPos;
@@ -56,7 +55,6 @@ struct InstanceInfo{
   int sharedIndex;
   Array<bool> isSpecificConfigShared;
   
-  Opt<int> statePos;
   int stateSize;
   
   // Some of these could be removed and be computed from the others
@@ -65,7 +63,6 @@ struct InstanceInfo{
   Opt<int> memMappedBitSize;
   Opt<String> memDecisionMask; // This is local to the accelerator
 
-  Opt<int> delayPos;
   Array<int> extraDelay;
   int baseNodeDelay;
   int delaySize;
@@ -80,11 +77,9 @@ struct InstanceInfo{
 
   bool doesNotBelong; // For merge units, if true then this unit does not actually exist for the given partition
   int special;
-  int localOrder;
   FUInstance* inst; // Points to the recon instance for merge declarations.
   bool debug;
 
-  NodeType connectionType;
   Array<int> inputDelays;
   Array<int> outputLatencies;
   Array<int> portDelay;
@@ -96,9 +91,40 @@ struct InstanceInfo{
   StructInfo* structInfo;
 };
 
+// Positions that do not exist (unit without state, static unit without config, ...) are stored as -1.
+struct InstanceInfoTable{
+  Array<int> level;
+  Array<int> parent;      // -1 for the top level units.
+  Array<int> nextSibling; // Next unit with the same parent, -1 if last.
+  
+  Array<FUDeclaration*> decl;
+  Array<int> configPos; // Global config pos
+  Array<int> statePos;
+  Array<int> delayPos;
+  Array<int> localOrder;
+  Array<NodeType> connectionType;
+};
+
+// Every member of a unit in one place. Only meant for debugging, it is rebuilt on every call.
+struct InstanceInfoView{
+  int index;
+  int level;
+  int parent;
+  int nextSibling;
+  FUDeclaration* decl;
+  Opt<int> globalConfigPos;
+  Opt<int> statePos;
+  Opt<int> delayPos;
+  int localOrder;
+  NodeType connectionType;
+
+  InstanceInfo cold;
+};
+
 struct MergePartition{
   String name; // For now this appears to not affect anything.
   Array<InstanceInfo> info;
+  InstanceInfoTable table;
 
   // TODO: Composite units currently break the meaning of baseType.
   //       Since a composite unit with 2 merged instances would need to have 2 base types.
@@ -141,7 +167,7 @@ struct AccelInfo{
   bool implementsDone;
 };
 
-// NOTE: The member 'level' of InstanceInfo needs to be valid in order for this iterator to work. 
+// NOTE: The table of the merge partition needs to be valid in order for this iterator to work. 
 //       Do not know how to handle merged. Should we iterate Array<InstanceInfo> and let outside code work, or do we take the accelInfo and then allow the iterator to switch between different merges and stuff?      
 struct AccelInfoIterator{
   String accelName; // Usually for debug purposes.
@@ -151,6 +177,7 @@ struct AccelInfoIterator{
 
   void SetMergeIndex(int index){mergeIndex = index;};
   Array<InstanceInfo>& GetCurrentMerge();
+  InstanceInfoTable* GetCurrentTable();
   int MergeSize();
 
   String GetMergeName();
@@ -166,6 +193,15 @@ struct AccelInfoIterator{
   InstanceInfo* GetUnit(int index);
   Array<InstanceInfo*> GetAllSubUnits(Arena* out);
 
+  // Hot data of the current unit
+  int Level();
+  FUDeclaration* Decl();
+  Opt<int> GlobalConfigPos();
+  Opt<int> StatePos();
+  Opt<int> DelayPos();
+  int LocalOrder();
+  NodeType ConnectionType();
+
   // Next and step mimick gdb like commands. Does not update current, instead returning the advanced iterator
   WARN_UNUSED AccelInfoIterator Next(); // Next unit in current level only.
   WARN_UNUSED AccelInfoIterator Step(); // Next unit in the array. Goes down and up the levels as it progresses.
@@ -191,7 +227,7 @@ void FillAccelInfoFromCalculatedInstanceInfo(AccelInfo* info,Accelerator* accel)
 Array<InstanceInfo*> GetAllSameLevelUnits(AccelInfo* info,int level,int mergeIndex,Arena* out);
 
 // TODO: mergeIndex seems to be the wrong approach. Check the correct approach when trying to simplify merge.
-Array<InstanceInfo> GenerateInitialInstanceInfo(Accelerator* accel,Arena* out,Array<Partition> partitions,bool calculateOrder = true);
+void GenerateInitialInstanceInfo(MergePartition* partition,Accelerator* accel,Arena* out,Array<Partition> partitions,bool calculateOrder = true);
 Array<Partition> GenerateInitialPartitions(Accelerator* accel,Arena* out);
 
 void FillInstanceInfo(AccelInfoIterator initialIter,Arena* out);
@@ -203,10 +239,11 @@ AccelInfo CalculateAcceleratorInfo(Accelerator* accel,bool recursive,Arena* out,
 Array<int> ExtractInputDelays(AccelInfoIterator top,Arena* out);
 Array<int> ExtractOutputLatencies(AccelInfoIterator top,Arena* out);
 
-// Array info related
-// TODO: This should be built on top of AccelInfo (taking an iterator), instead of just taking the array of instance infos.
-Array<String> ExtractStates(Array<InstanceInfo> info,Arena* out);
-Array<Pair<String,int>> ExtractMem(Array<InstanceInfo> info,Arena* out);
+Array<String> ExtractStates(AccelInfoIterator top,Arena* out);
+Array<Pair<String,int>> ExtractMem(AccelInfoIterator top,Arena* out);
+
+InstanceInfoView GetDebugView(AccelInfoIterator iter);
+Array<InstanceInfoView> GetDebugView(AccelInfo* info,int mergeIndex,Arena* out);
 
 
 String ReprStaticConfig(StaticId id,Wire* wire,Arena* out);
@@ -262,11 +262,11 @@ String PushDebugPath(Arena* out,String folderName,String subFolder,String fileNa
 // ============================================================================
 // Debug path regions
 
-static Array<String> debugRegionStack;
-static int debugRegionIndex;
-static Arena debugRegionArenaInst;
-static Arena* debugRegionArena;
-static bool debugRegionInit;
+static thread_local Array<String> debugRegionStack;
+static thread_local int debugRegionIndex;
+static thread_local Arena debugRegionArenaInst;
+static thread_local Arena* debugRegionArena;
+static thread_local bool debugRegionInit;
 
 DebugPathMarker::DebugPathMarker(String name){
   if(!debugRegionInit){
@@ -2,9 +2,14 @@
 
 #include "configurations.hpp"
 #include "globals.hpp"
+#include "thread.hpp"
 #include "versat.hpp"
 
 Pool<FUDeclaration> globalDeclarations;
+static Mutex declarationsMutex = {PTHREAD_MUTEX_INITIALIZER};
+
+static thread_local FUDeclaration* reservedDeclaration;
+static thread_local bool reservedDeclarationUsed;
 
 namespace BasicDeclaration{
   FUDeclaration* buffer;
@@ -102,13 +107,18 @@ static void RegisterOperators(){
 }
 
 FUDeclaration* GetTypeByName(String name){
+  FUDeclaration* res = nullptr;
+
+  LockMutex(&declarationsMutex);
   for(FUDeclaration* decl : globalDeclarations){
     if(CompareString(decl->name,name)){
-      return decl;
+      res = decl;
+      break;
     }
   }
+  UnlockMutex(&declarationsMutex);
   
-  return nullptr;
+  return res;
 }
 
 FUDeclaration* GetTypeByNameOrFail(String name){
@@ -118,12 +128,43 @@ FUDeclaration* GetTypeByNameOrFail(String name){
 }
 
 FUDeclaration* RegisterFU(FUDeclaration decl){
-  FUDeclaration* type = globalDeclarations.Alloc();
+  LockMutex(&declarationsMutex);
+  FUDeclaration* type = nullptr;
+  if(reservedDeclaration){
+    Assert(!reservedDeclarationUsed);
+    type = reservedDeclaration;
+    reservedDeclarationUsed = true;
+  } else {
+    type = globalDeclarations.Alloc();
+  }
   *type = decl;
+  UnlockMutex(&declarationsMutex);
+
+  return type;
+}
+
+FUDeclaration* ReserveFU(){
+  LockMutex(&declarationsMutex);
+  FUDeclaration* type = globalDeclarations.Alloc();
+  UnlockMutex(&declarationsMutex);
 
   return type;
 }
 
+void BeginRegistrationInto(FUDeclaration* reserved){
+  Assert(!reservedDeclaration);
+
+  reservedDeclaration = reserved;
+  reservedDeclarationUsed = false;
+}
+
+void EndRegistrationInto(){
+  Assert(reservedDeclaration && reservedDeclarationUsed);
+
+  reservedDeclaration = nullptr;
+  reservedDeclarationUsed = false;
+}
+
 void InitializeSimpleDeclarations(){
   RegisterOperators();
   RegisterCircuitInput();
@@ -83,6 +83,10 @@ struct FUDeclaration{
   AddressGenInst supportedAddressGen;
   
   int lat; // TODO: For now this is only for iterative units. Would also useful to have a standardized way of computing this from the graph and then compute it when needed. 
+
+  int combinatorialDepth; // Cached by CombinatorialDepth, plus one so that zero means not calculated yet
+
+  String registrationReport; // Messages produced while registering. Declarations can be registered in parallel, so the caller prints them in order
   
   Hashmap<StaticId,StaticData>* staticUnits;
 
@@ -160,9 +164,15 @@ namespace BasicDeclaration{
   extern FUDeclaration* pipelineRegister;
 }
 
+// RegisterFU and GetTypeByName can be called by multiple threads at the same time.
 FUDeclaration* RegisterFU(FUDeclaration declaration);
 FUDeclaration* GetTypeByName(String str);
 FUDeclaration* GetTypeByNameOrFail(String name);
+
+// Parallel code reserves the declarations beforehand, in the order that they must appear in globalDeclarations, so that the order does not depend on thread scheduling.
+FUDeclaration* ReserveFU(); // Empty until registered into
+void BeginRegistrationInto(FUDeclaration* reserved); // The next RegisterFU of the calling thread fills reserved instead of adding a declaration
+void EndRegistrationInto();
 void InitializeSimpleDeclarations();
 bool HasMultipleConfigs(FUDeclaration* decl);
 
@@ -68,22 +68,6 @@ SimpleEdge Get(AccelEdgeIterator iter){
   return res;
 }
 
-// TODO: We probably want to remove this 
-static ConnectionNode* GetConnectionNode(SimpleEdge edge,AccelInfoIterator top){
-  InstanceInfo* out = top.GetUnit(edge.outIndex);
-  InstanceInfo* in = top.GetUnit(edge.inIndex);
-
-  FOREACH_LIST(ConnectionNode*,ptr,out->inst->allOutputs){
-    if(ptr->instConnectedTo.inst == in->inst && ptr->instConnectedTo.port == edge.inPort &&
-       ptr->port == edge.outPort){
-      return ptr;
-    }
-  }
-
-  Assert(false);
-  return nullptr;
-}
-
 // TODO: I should give the codebase a comb through and start normalizing this stuff. There is some confusion caused by repeated names for things that are not equal.
 // Naming conventions -
 // Latency - number of cycles it takes for node/edge to produce valid data.
@@ -92,12 +76,188 @@ static ConnectionNode* GetConnectionNode(SimpleEdge edge,AccelInfoIterator top){
 // Global vs local - Global values are values that apply to the entire graph and subgraphs, while local only applies to the current graph. It can also be used to represent the different between values that only make sense in a graph subset versues the entire graph.
 // 
 
-SimpleCalculateDelayResult CalculateDelay(AccelInfoIterator top,Arena* out){
+// Groups the edges by the unit that they enter (or leave). Inside each group the edges stay in increasing index order.
+static Array<Array<int>> GroupEdgesByUnit(Array<SimpleEdge> edges,int amountOfUnits,bool groupByOutput,Arena* out){
+  TEMP_REGION(temp,out);
+
+  auto GetUnit = [groupByOutput](SimpleEdge edge){
+    return groupByOutput ? edge.outIndex : edge.inIndex;
+  };
+  
+  Array<int> amount = PushArray<int>(temp,amountOfUnits);
+  for(SimpleEdge edge : edges){
+    amount[GetUnit(edge)] += 1;
+  }
+
+  Array<Array<int>> groups = PushArray<Array<int>>(out,amountOfUnits);
+  for(int i = 0; i < amountOfUnits; i++){
+    groups[i] = PushArray<int>(out,amount[i]);
+    groups[i].size = 0;
+  }
+
+  for(int i = 0; i < edges.size; i++){
+    Array<int>& group = groups[GetUnit(edges[i])];
+    group.data[group.size++] = i;
+  }
+
+  return groups;
+}
+
+struct LatencyConstraint{
+  int from; // -1 if the edge starts with a constant zero latency
+  int to;
+  int latency;
+  int weight; // Registers added per cycle of delay placed on the edge
+};
+
+struct FlowArc{
+  int from;
+  int to;
+  i64 capacity;
+  i64 cost;
+};
+
+// Finds the earliest non negative times that respect every constraint (time[to] - time[from] >= latency) while minimizing the sum of weight * (time[to] - time[from] - latency), which is the amount of registers used by the fixed buffers.
+// This is the retiming formulation. We solve its dual, a min cost flow, with successive shortest paths and recover the times from the shortest distances of the final residual graph.
+// Constraints must not form cycles.
+static Array<int> SolveMinimumDelayTimes(Array<LatencyConstraint> constraints,int amountOfNodes,Arena* out){
+  TEMP_REGION(temp,out);
+
+  const i64 INFINITE = ((i64) 1) << 60;
+  int root = amountOfNodes;
+  int source = amountOfNodes + 1;
+  int sink = amountOfNodes + 2;
+  int totalNodes = amountOfNodes + 3;
+
+  auto NodeOf = [root](int from){
+    return (from < 0) ? root : from;
+  };
+  
+  // Each time is multiplied by the weight entering the node minus the weight leaving it. Negative nodes supply flow, positive nodes consume it.
+  Array<i64> balance = PushArray<i64>(temp,amountOfNodes + 1);
+  for(LatencyConstraint c : constraints){
+    balance[NodeOf(c.from)] -= c.weight;
+    balance[c.to] += c.weight;
+  }
+
+  // Arcs are stored in pairs, arc i ^ 1 is the residual of arc i.
+  Array<FlowArc> arcs = PushArray<FlowArc>(temp,2 * (constraints.size + 2 * amountOfNodes + 1));
+  arcs.size = 0;
+  auto AddArc = [&arcs](int from,int to,i64 capacity,i64 cost){
+    arcs.data[arcs.size++] = {from,to,capacity,cost};
+    arcs.data[arcs.size++] = {to,from,0,-cost};
+  };
+
+  for(LatencyConstraint c : constraints){
+    AddArc(NodeOf(c.from),c.to,INFINITE,-c.latency);
+  }
+  for(int i = 0; i < amountOfNodes; i++){
+    AddArc(root,i,INFINITE,0); // Times cannot be negative
+  }
+  for(int i = 0; i < amountOfNodes + 1; i++){
+    if(balance[i] < 0){
+      AddArc(source,i,-balance[i],0);
+    } else if(balance[i] > 0){
+      AddArc(i,sink,balance[i],0);
+    }
+  }
+
+  // Arcs grouped by the node they leave
+  Array<int> firstArc = PushArray<int>(temp,totalNodes + 1);
+  for(FlowArc arc : arcs){
+    firstArc[arc.from + 1] += 1;
+  }
+  for(int i = 0; i < totalNodes; i++){
+    firstArc[i + 1] += firstArc[i];
+  }
+  Array<int> arcsByNode = PushArray<int>(temp,arcs.size);
+  Array<int> inserted = PushArray<int>(temp,totalNodes);
+  for(int i = 0; i < arcs.size; i++){
+    int node = arcs[i].from;
+    arcsByNode[firstArc[node] + inserted[node]++] = i;
+  }
+
+  Array<i64> distance = PushArray<i64>(temp,totalNodes);
+  Array<int> parentArc = PushArray<int>(temp,totalNodes);
+  Array<bool> inQueue = PushArray<bool>(temp,totalNodes);
+  Array<int> queue = PushArray<int>(temp,totalNodes);
+
+  // Residual costs can be negative, Bellman-Ford with a queue. Nodes at or above nodeLimit are ignored.
+  auto ShortestPaths = [&](int start,int nodeLimit){
+    Memset(distance,INFINITE);
+    Memset(inQueue,false);
+
+    distance[start] = 0;
+    parentArc[start] = -1;
+    queue[0] = start;
+    inQueue[start] = true;
+
+    int head = 0;
+    int queued = 1;
+    while(queued > 0){
+      int node = queue[head];
+      head = (head + 1) % totalNodes;
+      queued -= 1;
+      inQueue[node] = false;
+
+      for(int i = firstArc[node]; i < firstArc[node + 1]; i++){
+        FlowArc arc = arcs[arcsByNode[i]];
+
+        if(arc.capacity <= 0 || arc.to >= nodeLimit){
+          continue;
+        }
+
+        i64 newDistance = distance[node] + arc.cost;
+        if(newDistance < distance[arc.to]){
+          distance[arc.to] = newDistance;
+          parentArc[arc.to] = arcsByNode[i];
+
+          if(!inQueue[arc.to]){
+            queue[(head + queued) % totalNodes] = arc.to;
+            queued += 1;
+            inQueue[arc.to] = true;
+          }
+        }
+      }
+    }
+  };
+
+  while(true){
+    ShortestPaths(source,totalNodes);
+
+    if(distance[sink] == INFINITE){
+      break;
+    }
+
+    i64 amount = INFINITE;
+    for(int node = sink; node != source; node = arcs[parentArc[node]].from){
+      amount = std::min(amount,arcs[parentArc[node]].capacity);
+    }
+    for(int node = sink; node != source; node = arcs[parentArc[node]].from){
+      arcs[parentArc[node]].capacity -= amount;
+      arcs[parentArc[node] ^ 1].capacity += amount;
+    }
+  }
+
+  // No negative cycles remain, the distances from the root give the earliest optimal times.
+  ShortestPaths(root,amountOfNodes + 1);
+
+  Array<int> times = PushArray<int>(out,amountOfNodes);
+  for(int i = 0; i < amountOfNodes; i++){
+    times[i] = (int) -distance[i];
+  }
+
+  return times;
+}
+
+SimpleCalculateDelayResult CalculateDelay(AccelInfoIterator top,Arena* out,bool sharedBuffers){
   DEBUG_PATH("delays");
   
   TEMP_REGION(temp,out);
   Assert(!Empty(top.accelName));
 
+  InstanceInfoTable* table = top.GetCurrentTable();
+  
   int amountOfNodes = 0;
   for(AccelInfoIterator iter = top; iter.IsValid(); iter = iter.Next()){
     amountOfNodes += 1;
@@ -108,15 +268,10 @@ SimpleCalculateDelayResult CalculateDelay(AccelInfoIterator top,Arena* out){
   // TODO: Separate latency calculation from delay calculation, even if currently it seems fine, it is hard to reason about.
   // TODO: None of this code should depend on FUInstance or FUDeclaration. Only on InstanceInfo direct members.
   
-  // Keyed by order
-  Array<DelayInfo> nodeBaseLatencyByOrder = PushArray<DelayInfo>(out,amountOfNodes);
-  Memset(nodeBaseLatencyByOrder,{});
-  
   Array<int> orderToIndex = PushArray<int>(temp,amountOfNodes);
   for(AccelInfoIterator iter = top; iter.IsValid(); iter = iter.Next()){
     int index = iter.GetIndex();
-    InstanceInfo* info = iter.CurrentUnit();
-    orderToIndex[info->localOrder] = index;
+    orderToIndex[iter.LocalOrder()] = index;
   }
   
   int totalEdges = 0;
@@ -124,267 +279,356 @@ SimpleCalculateDelayResult CalculateDelay(AccelInfoIterator top,Arena* out){
     totalEdges += 1;
   }
 
+  // Edges are kept in iteration order, the resulting edge delays are indexed by it.
+  Array<SimpleEdge> edges = PushArray<SimpleEdge>(temp,totalEdges);
   Array<int> edgeDelay = PushArray<int>(temp,totalEdges);
   // Need to replace this with a DelayInfo array for the edges
   int edgeIndex = 0;
   for(AccelEdgeIterator iter = IterateEdges(top); IsValid(iter); Advance(iter),edgeIndex += 1){
-    SimpleEdge edge = Get(iter);
-    ConnectionNode* conn = GetConnectionNode(edge,top);
-    edgeDelay[edgeIndex] = conn->edgeDelay;
+    InstanceInfo* info = iter.iter.CurrentUnit();
+    edges[edgeIndex] = Get(iter);
+    edgeDelay[edgeIndex] = info->inputs[iter.edgeIndex].edgeDelay;
   }
-  
-  Array<DelayInfo> edgesGlobalLatency = PushArray<DelayInfo>(out,totalEdges);
-
-  // Sets latency for each edge of the node 
-  auto SendLatencyUpwards = [&top,&edgesGlobalLatency,&nodeBaseLatencyByOrder,&orderToIndex,&edgeDelay](int orderIndex){
-    int trueIndex = orderToIndex[orderIndex];
-    InstanceInfo* info = top.GetUnit(trueIndex);
-    DelayInfo b = nodeBaseLatencyByOrder[orderIndex]; 
-    int edgeIndex = 0;
-    for(AccelEdgeIterator iter = IterateEdges(top); IsValid(iter); Advance(iter),edgeIndex += 1){
-      SimpleEdge edge = Get(iter);
-
-      if(edge.outIndex != trueIndex){
-        continue;
-      }
 
-      int otherIndex = edge.inIndex;
-      InstanceInfo* otherInfo = top.GetUnit(otherIndex);
-      
-      int a = info->outputLatencies[edge.outPort];
+  Array<Array<int>> inputEdges = GroupEdgesByUnit(edges,table->level.size,false,temp);
+  Array<Array<int>> outputEdges = GroupEdgesByUnit(edges,table->level.size,true,temp);
 
-      int d = 0;
-      if(info->decl == BasicDeclaration::fixedBuffer){
-        d = info->special;
-      }
-      
-      // Need to replace this with a DelayInfo array for the edges
-      //ConnectionNode* conn = GetConnectionNode(edge,top);
+  // Latency of the edge relative to the latency of the node that outputs it
+  auto EdgeLatency = [&](int edgeIndex){
+    SimpleEdge edge = edges[edgeIndex];
+    InstanceInfo* info = top.GetUnit(edge.outIndex);
+    InstanceInfo* otherInfo = top.GetUnit(edge.inIndex);
+    
+    int a = info->outputLatencies[edge.outPort];
 
-      int e = edgeDelay[edgeIndex]; //conn->edgeDelay;
+    int d = 0;
+    if(table->decl[edge.outIndex] == BasicDeclaration::fixedBuffer){
+      d = info->special;
+    }
       
-      int c = otherInfo->inputDelays[edge.inPort];
-      int delay = b.value + a + e - c + d;
-
-      edgesGlobalLatency[edgeIndex].value = delay;
-
-      // If the node is a buffer, delays are now variable.
-      // We want to preserve this information as much as possible. Even if not needed because the merge is simple, we might be able to unlock some optimizations down the line
-      if(HasVariableDelay(info->decl)){
-        edgesGlobalLatency[edgeIndex].isAny = true;
-      }
+    int e = edgeDelay[edgeIndex];
       
-      edgesGlobalLatency[edgeIndex].isAny |= b.isAny;
-    }
-  };
-
-  // Start at sources
-  for(int orderIndex = 0; orderIndex < orderToIndex.size; orderIndex++){
-    FUInstance* node = top.GetUnit(orderToIndex[orderIndex])->inst;
+    int c = otherInfo->inputDelays[edge.inPort];
 
-    int maxInputEdgeLatency = 0;
-    int edgeIndex = 0;
-    bool allAny = true;
-    for(AccelEdgeIterator iter = IterateEdges(top); IsValid(iter); Advance(iter),edgeIndex += 1){
-      SimpleEdge edge = Get(iter);
-      int inIndex = edge.inIndex;
+    return a + e - c + d;
+  };
 
-      InstanceInfo* inInfo = top.GetUnit(inIndex);
-      FUInstance* inNode = inInfo->inst;
-      if(inNode != node){
-        continue;
+  // Delays on edges to the output are handled by the parent accelerator, they do not become buffers (see FixDelays). The merge path buffers them (see GenerateFixDelays).
+  auto NeedsBuffer = [&](int edgeIndex){
+    return !sharedBuffers || table->decl[edges[edgeIndex].inIndex] != BasicDeclaration::output;
+  };
+  
+  // Edges that leave the same output port share a chain of buffers (see FixDelays), only the largest delay of each port uses registers.
+  // Without shared buffers every edge is its own group.
+  Array<int> edgePortGroup = PushArray<int>(temp,totalEdges);
+  int amountOfPortGroups = 0;
+  for(Array<int> outEdges : outputEdges){
+    for(int i = 0; i < outEdges.size; i++){
+      int group = -1;
+      for(int j = 0; j < i && sharedBuffers; j++){
+        if(edges[outEdges[j]].outPort == edges[outEdges[i]].outPort){
+          group = edgePortGroup[outEdges[j]];
+          break;
+        }
       }
 
-      int edgeLatency = edgesGlobalLatency[edgeIndex].value;
-      maxInputEdgeLatency = std::max(maxInputEdgeLatency,edgeLatency);
-      allAny &= edgesGlobalLatency[edgeIndex].isAny;
-    }
-    
-    nodeBaseLatencyByOrder[orderIndex].value = maxInputEdgeLatency;
-    nodeBaseLatencyByOrder[orderIndex].isAny = (maxInputEdgeLatency != 0 && allAny);
-
-    // Send latency upwards.
-    if(node->type != NodeType_SOURCE_AND_SINK){
-      SendLatencyUpwards(orderIndex);
+      if(group == -1){
+        group = amountOfPortGroups++;
+      }
+      edgePortGroup[outEdges[i]] = group;
     }
   }
-
-  Array<DelayInfo> edgesExtraDelay = CopyArray(edgesGlobalLatency,out);
-
-  DebugRegionLatencyGraph(top,orderToIndex,nodeBaseLatencyByOrder,edgesExtraDelay,"globalLatency");
-
-  // This is still the global latency per port.
-  Array<Array<DelayInfo>> inputPortBaseLatencyByOrder = PushArray<Array<DelayInfo>>(out,orderToIndex.size);
   
-  for(int i = 0; i < orderToIndex.size; i++){
-    FUInstance* node = top.GetUnit(orderToIndex[i])->inst;
-
-    int maxPortIndex = -1;
-    int edgeIndex = 0;
-    for(AccelEdgeIterator iter = IterateEdges(top); IsValid(iter); Advance(iter),edgeIndex += 1){
-      SimpleEdge edge = Get(iter);
-      int inIndex = edge.inIndex;
-
-      InstanceInfo* inInfo = top.GetUnit(inIndex);
-      FUInstance* inNode = inInfo->inst;
-      if(inNode != node){
+  auto CountDelayRegisters = [&](Array<DelayInfo> edgesExtraDelay){
+    Array<int> portDelay = PushArray<int>(temp,amountOfPortGroups);
+    for(int i = 0; i < edges.size; i++){
+      if(edgesExtraDelay[i].isAny || !NeedsBuffer(i)){
         continue;
       }
-
-      maxPortIndex = std::max(maxPortIndex,edge.inPort);
+      int& delay = portDelay[edgePortGroup[i]];
+      delay = std::max(delay,edgesExtraDelay[i].value);
     }
 
-    if(maxPortIndex == -1){
-      inputPortBaseLatencyByOrder[i] = {};
-      continue;
+    int registers = 0;
+    for(int delay : portDelay){
+      registers += delay;
     }
-    inputPortBaseLatencyByOrder[i] = PushArray<DelayInfo>(out,maxPortIndex + 1);
-
-    edgeIndex = 0;
-    for(AccelEdgeIterator iter = IterateEdges(top); IsValid(iter); Advance(iter),edgeIndex += 1){
-      SimpleEdge edge = Get(iter);
-      int inIndex = edge.inIndex;
+    return registers;
+  };
+  
+  // Computes latencies and delays. If computeLatencyByOrder is given, compute nodes are delayed up to it (instead of starting as soon as all their inputs are valid).
+  auto Schedule = [&](Array<int> computeLatencyByOrder,bool outputDebug,Arena* out){
+    // Keyed by order
+    Array<DelayInfo> nodeBaseLatencyByOrder = PushArray<DelayInfo>(out,amountOfNodes);
+    Memset(nodeBaseLatencyByOrder,{});
+
+    // Amount of cycles a compute node waits after all its inputs are valid
+    Array<int> nodeWaitByOrder = PushArray<int>(temp,amountOfNodes);
+  
+    Array<DelayInfo> edgesGlobalLatency = PushArray<DelayInfo>(out,totalEdges);
+
+    // Sets latency for each edge of the node 
+    auto SendLatencyUpwards = [&](int orderIndex){
+      int trueIndex = orderToIndex[orderIndex];
+      FUDeclaration* decl = table->decl[trueIndex];
+      DelayInfo b = nodeBaseLatencyByOrder[orderIndex]; 
+      for(int edgeIndex : outputEdges[trueIndex]){
+        int delay = b.value + EdgeLatency(edgeIndex);
+
+        edgesGlobalLatency[edgeIndex].value = delay;
+
+        // If the node is a buffer, delays are now variable.
+        // We want to preserve this information as much as possible. Even if not needed because the merge is simple, we might be able to unlock some optimizations down the line
+        if(HasVariableDelay(decl)){
+          edgesGlobalLatency[edgeIndex].isAny = true;
+        }
+      
+        edgesGlobalLatency[edgeIndex].isAny |= b.isAny;
+      }
+    };
+
+    // Start at sources
+    for(int orderIndex = 0; orderIndex < orderToIndex.size; orderIndex++){
+      NodeType type = table->connectionType[orderToIndex[orderIndex]];
+
+      int maxInputEdgeLatency = 0;
+      bool allAny = true;
+      for(int edgeIndex : inputEdges[orderToIndex[orderIndex]]){
+        int edgeLatency = edgesGlobalLatency[edgeIndex].value;
+        maxInputEdgeLatency = std::max(maxInputEdgeLatency,edgeLatency);
+        allAny &= edgesGlobalLatency[edgeIndex].isAny;
+      }
 
-      InstanceInfo* inInfo = top.GetUnit(inIndex);
-      FUInstance* inNode = inInfo->inst;
-      if(inNode != node){
-        continue;
+      int nodeLatency = maxInputEdgeLatency;
+      if(computeLatencyByOrder.size && type == NodeType_COMPUTE){
+        nodeLatency = std::max(nodeLatency,computeLatencyByOrder[orderIndex]);
       }
+      nodeWaitByOrder[orderIndex] = nodeLatency - maxInputEdgeLatency;
       
-      inputPortBaseLatencyByOrder[i][edge.inPort] = edgesExtraDelay[edgeIndex];
-    }
-  }
-  
-  // Store latency on data consuming units
-  for(int i = 0; i < orderToIndex.size; i++){
-    FUInstance* node = top.GetUnit(orderToIndex[i])->inst;
+      nodeBaseLatencyByOrder[orderIndex].value = nodeLatency;
+      nodeBaseLatencyByOrder[orderIndex].isAny = (maxInputEdgeLatency != 0 && allAny);
 
-    if(!(node->type == NodeType_SINK || node->type == NodeType_SOURCE_AND_SINK)){
-      continue;
+      // Send latency upwards.
+      if(type != NodeType_SOURCE_AND_SINK){
+        SendLatencyUpwards(orderIndex);
+      }
     }
 
-    // For each edge in that contains that node as an output
-    int minEdgeDelay = 9999;
-    int edgeIndex = 0;
-    for(AccelEdgeIterator iter = IterateEdges(top); IsValid(iter); Advance(iter),edgeIndex += 1){
-      SimpleEdge edge = Get(iter);
-      int inIndex = edge.inIndex;
+    Array<DelayInfo> edgesExtraDelay = CopyArray(edgesGlobalLatency,out);
 
-      InstanceInfo* inInfo = top.GetUnit(inIndex);
-      FUInstance* inNode = inInfo->inst;
-      if(inNode != node){
+    if(outputDebug){
+      DebugRegionLatencyGraph(top,orderToIndex,nodeBaseLatencyByOrder,edgesExtraDelay,"globalLatency");
+    }
+    
+    // This is still the global latency per port.
+    Array<Array<DelayInfo>> inputPortBaseLatencyByOrder = PushArray<Array<DelayInfo>>(out,orderToIndex.size);
+  
+    for(int i = 0; i < orderToIndex.size; i++){
+      int maxPortIndex = -1;
+      for(int edgeIndex : inputEdges[orderToIndex[i]]){
+        maxPortIndex = std::max(maxPortIndex,edges[edgeIndex].inPort);
+      }
+
+      if(maxPortIndex == -1){
+        inputPortBaseLatencyByOrder[i] = {};
         continue;
       }
+      inputPortBaseLatencyByOrder[i] = PushArray<DelayInfo>(out,maxPortIndex + 1);
 
-      int edgeDelay = edgesExtraDelay[edgeIndex].value;
-      minEdgeDelay = std::min(minEdgeDelay,edgeDelay);
+      for(int edgeIndex : inputEdges[orderToIndex[i]]){
+        inputPortBaseLatencyByOrder[i][edges[edgeIndex].inPort] = edgesExtraDelay[edgeIndex];
+      }
     }
+  
+    // Store latency on data consuming units
+    for(int i = 0; i < orderToIndex.size; i++){
+      NodeType type = table->connectionType[orderToIndex[i]];
 
-    // Is this even possible?
-    Assert(minEdgeDelay != 9999);
+      if(!(type == NodeType_SINK || type == NodeType_SOURCE_AND_SINK)){
+        continue;
+      }
 
-    nodeBaseLatencyByOrder[i].value = minEdgeDelay;
-  }
+      // For each edge in that contains that node as an output
+      int minEdgeDelay = 9999;
+      for(int edgeIndex : inputEdges[orderToIndex[i]]){
+        int edgeDelay = edgesExtraDelay[edgeIndex].value;
+        minEdgeDelay = std::min(minEdgeDelay,edgeDelay);
+      }
 
-  // We have the global latency of each node and edge.
-  // We now need to calculate the "extra" latency added to each edge in order to align everything together.
+      // Is this even possible?
+      Assert(minEdgeDelay != 9999);
+
+      nodeBaseLatencyByOrder[i].value = minEdgeDelay;
+    }
 
-  // Converts global latency into edge delays
-  for(int i = 0; i < orderToIndex.size; i++){
-    FUInstance* node = top.GetUnit(orderToIndex[i])->inst;
+    // We have the global latency of each node and edge.
+    // We now need to calculate the "extra" latency added to each edge in order to align everything together.
 
-    int nodeDelay = nodeBaseLatencyByOrder[i].value;
+    // Converts global latency into edge delays
+    for(int i = 0; i < orderToIndex.size; i++){
+      int nodeDelay = nodeBaseLatencyByOrder[i].value;
     
-    int minEdgeDelay = 9999;
-    int edgeIndex = 0;
-    for(AccelEdgeIterator iter = IterateEdges(top); IsValid(iter); Advance(iter),edgeIndex += 1){
-      SimpleEdge edge = Get(iter);
-      int inIndex = edge.inIndex;
-
-      InstanceInfo* inInfo = top.GetUnit(inIndex);
-      FUInstance* inNode = inInfo->inst;
-      if(inNode != node){
+      int minEdgeDelay = 9999;
+      for(int edgeIndex : inputEdges[orderToIndex[i]]){
+        edgesExtraDelay[edgeIndex].value = nodeDelay - edgesExtraDelay[edgeIndex].value;
+      
+        int edgeDelay = edgesExtraDelay[edgeIndex].value;
+        minEdgeDelay = std::min(minEdgeDelay,edgeDelay);
+      }
+
+      if(minEdgeDelay == 9999){
         continue;
       }
 
-      edgesExtraDelay[edgeIndex].value = nodeDelay - edgesExtraDelay[edgeIndex].value;
-      
-      int edgeDelay = edgesExtraDelay[edgeIndex].value;
-      minEdgeDelay = std::min(minEdgeDelay,edgeDelay);
+      // A compute node that waits keeps that wait on all its inputs
+      minEdgeDelay -= nodeWaitByOrder[i];
+      for(int edgeIndex : inputEdges[orderToIndex[i]]){
+        edgesExtraDelay[edgeIndex].value -= minEdgeDelay;
+      }
     }
 
-    if(minEdgeDelay == 9999){
-      continue;
+    if(outputDebug){
+      DebugRegionLatencyGraph(top,orderToIndex,nodeBaseLatencyByOrder,edgesExtraDelay,"edgeDelay");
     }
+    
+    // Store delays on data producing units
+    for(int i = 0; i < orderToIndex.size; i++){
+      NodeType type = table->connectionType[orderToIndex[i]];
 
-    edgeIndex = 0;
-    for(AccelEdgeIterator iter = IterateEdges(top); IsValid(iter); Advance(iter),edgeIndex += 1){
-      SimpleEdge edge = Get(iter);
-      int inIndex = edge.inIndex;
-
-      InstanceInfo* inInfo = top.GetUnit(inIndex);
-      FUInstance* inNode = inInfo->inst;
-      if(inNode != node){
+      if(type != NodeType_SOURCE){
         continue;
       }
 
-      edgesExtraDelay[edgeIndex].value -= minEdgeDelay;
+      // For each edge in that contains that node as an output
+      int minEdgeDelay = 9999;
+      for(int edgeIndex : outputEdges[orderToIndex[i]]){
+        int edgeDelay = edgesExtraDelay[edgeIndex].value;
+        minEdgeDelay = std::min(minEdgeDelay,edgeDelay);
+      }
+
+      // Is this even possible?
+      Assert(minEdgeDelay != 9999);
+
+      nodeBaseLatencyByOrder[i].value = minEdgeDelay;
+    
+      for(int edgeIndex : outputEdges[orderToIndex[i]]){
+        edgesExtraDelay[edgeIndex].value -= minEdgeDelay;
+      }
+    }
+
+    if(outputDebug){
+      DebugRegionLatencyGraph(top,orderToIndex,nodeBaseLatencyByOrder,edgesExtraDelay,"finalDelays");
     }
-  }
+    
+    SimpleCalculateDelayResult res = {};
+    res.nodeBaseLatencyByOrder = nodeBaseLatencyByOrder;
+    res.edgesExtraDelay = edgesExtraDelay;
+    res.inputPortBaseLatencyByOrder = inputPortBaseLatencyByOrder;
 
-  DebugRegionLatencyGraph(top,orderToIndex,nodeBaseLatencyByOrder,edgesExtraDelay,"edgeDelay");
+    return res;
+  };
 
-  // Store delays on data producing units
-  for(int i = 0; i < orderToIndex.size; i++){
-    FUInstance* node = top.GetUnit(orderToIndex[i])->inst;
+  // Aligning every unit as soon as possible is not optimal, a compute node that feeds multiple delayed edges uses less registers if it waits on its inputs instead.
+  // Port based delay calculation: we find the unit latencies that minimize the registers of the output ports, each port having its own latency.
+  // Variable buffers and cycles are not handled, we keep the unit level delays in those cases.
+  bool portLevelDelays = !globalOptions.unitDelays;
+  for(int i = 0; i < table->level.size; i++){
+    if(HasVariableDelay(table->decl[i])){
+      portLevelDelays = false;
+    }
+  }
+  
+  // The cost of a port is the largest delay of its edges. Modeled by giving each of the k edges 1/k of the weight and adding a mirror node after the consumers, each edge delay plus the delay from its consumer to the mirror is the same for every edge of the port, so minimizing the sum minimizes the largest one (Leiserson and Saxe).
+  // Weights are scaled by the lcm of every k to keep them integer. If it gets too big we stop sharing (k = 1), which only overestimates the cost.
+  Array<int> portFanout = PushArray<int>(temp,amountOfPortGroups);
+  for(int i = 0; i < edges.size; i++){
+    if(NeedsBuffer(i)){
+      portFanout[edgePortGroup[i]] += 1;
+    }
+  }
 
-    if(node->type != NodeType_SOURCE){
+  int scale = 1;
+  for(int fanout : portFanout){
+    if(fanout <= 1){
       continue;
     }
+    
+    int a = scale;
+    int b = fanout;
+    while(b != 0){
+      int t = a % b;
+      a = b;
+      b = t;
+    }
+    scale = (scale / a) * fanout;
 
-    // For each edge in that contains that node as an output
-    int minEdgeDelay = 9999;
-    int edgeIndex = 0;
-    for(AccelEdgeIterator iter = IterateEdges(top); IsValid(iter); Advance(iter),edgeIndex += 1){
-      SimpleEdge edge = Get(iter);
-      int outIndex = edge.outIndex;
+    if(scale > (1 << 16)){
+      Memset(portFanout,1);
+      scale = 1;
+      break;
+    }
+  }
 
-      InstanceInfo* outInfo = top.GetUnit(outIndex);
-      FUInstance* outNode = outInfo->inst;
-      if(outNode != node){
-        continue;
+  Array<int> portMirror = PushArray<int>(temp,amountOfPortGroups);
+  int amountOfLatencyNodes = table->level.size;
+  for(int i = 0; i < amountOfPortGroups; i++){
+    portMirror[i] = (portFanout[i] > 1) ? amountOfLatencyNodes++ : -1;
+  }
+  
+  Array<LatencyConstraint> constraints = PushArray<LatencyConstraint>(temp,2 * totalEdges);
+  constraints.size = 0;
+  for(int i = 0; i < edges.size; i++){
+    SimpleEdge edge = edges[i];
+    LatencyConstraint& c = constraints.data[constraints.size++];
+
+    int fanout = portFanout[edgePortGroup[i]];
+    c.to = edge.inIndex;
+    c.weight = NeedsBuffer(i) ? scale / std::max(fanout,1) : 0;
+
+    // Outputs of these nodes do not depend on their inputs, edge latency starts at zero
+    if(table->connectionType[edge.outIndex] == NodeType_SOURCE_AND_SINK){
+      c.from = -1;
+      c.latency = 0;
+    } else {
+      if(table->localOrder[edge.outIndex] >= table->localOrder[edge.inIndex]){
+        portLevelDelays = false;
       }
-
-      int edgeDelay = edgesExtraDelay[edgeIndex].value;
-      minEdgeDelay = std::min(minEdgeDelay,edgeDelay);
+    
+      c.from = edge.outIndex;
+      c.latency = EdgeLatency(i);
     }
 
-    // Is this even possible?
-    Assert(minEdgeDelay != 9999);
+    int mirror = portMirror[edgePortGroup[i]];
+    if(mirror != -1 && NeedsBuffer(i)){
+      LatencyConstraint& m = constraints.data[constraints.size++];
+      m.from = edge.inIndex;
+      m.to = mirror;
+      m.latency = -c.latency;
+      m.weight = c.weight;
+    }
+  }
+  
+  SimpleCalculateDelayResult unitLevel = Schedule({},false,temp);
+  int unitLevelRegisters = CountDelayRegisters(unitLevel.edgesExtraDelay);
+  
+  Array<int> computeLatencyByOrder = {};
+  if(portLevelDelays && unitLevelRegisters > 0){
+    Array<int> times = SolveMinimumDelayTimes(constraints,amountOfLatencyNodes,temp);
 
-    nodeBaseLatencyByOrder[i].value = minEdgeDelay;
-    
-    edgeIndex = 0;
-    for(AccelEdgeIterator iter = IterateEdges(top); IsValid(iter); Advance(iter),edgeIndex += 1){
-      SimpleEdge edge = Get(iter);
-      int outIndex = edge.outIndex;
-
-      InstanceInfo* outInfo = top.GetUnit(outIndex);
-      FUInstance* outNode = outInfo->inst;
-      if(outNode != node){
-        continue;
-      }
+    computeLatencyByOrder = PushArray<int>(temp,amountOfNodes);
+    for(int i = 0; i < amountOfNodes; i++){
+      computeLatencyByOrder[i] = times[orderToIndex[i]];
+    }
 
-      edgesExtraDelay[edgeIndex].value -= minEdgeDelay;
+    SimpleCalculateDelayResult portLevel = Schedule(computeLatencyByOrder,false,temp);
+    if(CountDelayRegisters(portLevel.edgesExtraDelay) >= unitLevelRegisters){
+      computeLatencyByOrder = {};
     }
   }
 
-  DebugRegionLatencyGraph(top,orderToIndex,nodeBaseLatencyByOrder,edgesExtraDelay,"finalDelays");
-  
-  SimpleCalculateDelayResult res = {};
-  res.nodeBaseLatencyByOrder = nodeBaseLatencyByOrder;
-  res.edgesExtraDelay = edgesExtraDelay;
-  res.inputPortBaseLatencyByOrder = inputPortBaseLatencyByOrder;
+  SimpleCalculateDelayResult res = Schedule(computeLatencyByOrder,true,out);
+  res.delayRegisters = CountDelayRegisters(res.edgesExtraDelay);
+  res.unitLevelDelayRegisters = unitLevelRegisters;
   
   // TODO: Missing pushing delays towards inputs and pushing delays towards outputs. I think.
   //       Probably best to add more complex tests that push the delay algorithm further.
@@ -392,16 +636,16 @@ SimpleCalculateDelayResult CalculateDelay(AccelInfoIterator top,Arena* out){
   return res;
 }
 
-CalculateDelayResult CalculateDelay(Accelerator* accel,Arena* out){
+CalculateDelayResult CalculateDelay(Accelerator* accel,Arena* out,bool sharedBuffers){
   TEMP_REGION(temp,out);
   AccelInfo info = {};
 
   info.infos = PushArray<MergePartition>(out,1);
-  info.infos[0].info = GenerateInitialInstanceInfo(accel,out,{});
+  GenerateInitialInstanceInfo(&info.infos[0],accel,out,{});
 
   AccelInfoIterator top = StartIteration(&info);
   top.accelName = accel->name;
-  SimpleCalculateDelayResult delays = CalculateDelay(top,out);
+  SimpleCalculateDelayResult delays = CalculateDelay(top,out,sharedBuffers);
 
   EdgeDelay* edgeToDelay = PushHashmap<Edge,DelayInfo>(out,delays.edgesExtraDelay.size);
   NodeDelay* nodeDelay = PushHashmap<FUInstance*,DelayInfo>(out,delays.nodeBaseLatencyByOrder.size);
@@ -421,7 +665,7 @@ CalculateDelayResult CalculateDelay(Accelerator* accel,Arena* out){
     
   for(AccelInfoIterator iter = top; iter.IsValid(); iter = iter.Next()){
     FUInstance* node = iter.CurrentUnit()->inst;
-    int order = iter.CurrentUnit()->localOrder;
+    int order = iter.LocalOrder();
 
     nodeDelay->Insert(node,delays.nodeBaseLatencyByOrder[order]);
 
@@ -436,6 +680,8 @@ CalculateDelayResult CalculateDelay(Accelerator* accel,Arena* out){
   res.edgesDelay = edgeToDelay;
   res.nodeDelay = nodeDelay;
   res.portDelay = portDelay;
+  res.delayRegisters = delays.delayRegisters;
+  res.unitLevelDelayRegisters = delays.unitLevelDelayRegisters;
 
   return res;
 }
@@ -472,8 +718,8 @@ GraphPrintingContent GenerateLatencyDotGraph(AccelInfoIterator top,Array<int> or
       edgeArray[edgeIndex].color = Color_BLACK;
     }
     edgeArray[edgeIndex].content = PushString(out,"%d",edgeLatency.value);
-    edgeArray[edgeIndex].firstNode = nodeArray[top.GetUnit(edge.outIndex)->localOrder].name;
-    edgeArray[edgeIndex].secondNode = nodeArray[top.GetUnit(edge.inIndex)->localOrder].name;
+    edgeArray[edgeIndex].firstNode = nodeArray[top.GetCurrentTable()->localOrder[edge.outIndex]].name;
+    edgeArray[edgeIndex].secondNode = nodeArray[top.GetCurrentTable()->localOrder[edge.inIndex]].name;
   }
     
   GraphPrintingContent result = {};
@@ -511,3 +757,93 @@ Array<DelayToAdd> GenerateFixDelays(Accelerator* accel,EdgeDelay* edgeDelays,Are
 
   return PushArrayFromList(out,list);
 }
+
+// Input 0 feeds X, whose output is consumed by units that also wait amounts of cycles on input 1
+static Accelerator* TestDelayRegistersAccelerator(String name,Array<int> waits){
+  Accelerator* accel = CreateAccelerator(name,AcceleratorPurpose_TEMP);
+  FUDeclaration* add = GetTypeByNameOrFail("ADD");
+
+  FUInstance* in0 = CreateOrGetInput(accel,"in0",0);
+  FUInstance* in1 = CreateOrGetInput(accel,"in1",1);
+  FUInstance* out = CreateOrGetOutput(accel);
+  FUInstance* x = CreateFUInstance(accel,add,"x");
+
+  ConnectUnits(in0,0,x,0);
+  ConnectUnits(in0,0,x,1);
+  for(int i = 0; i < waits.size; i++){
+    FUInstance* y = CreateFUInstance(accel,add,PushString(globalPermanent,"y%d",i));
+
+    ConnectUnits(x,0,y,0);
+    ConnectUnits(in1,0,y,1,waits[i]);
+    ConnectUnits(y,0,out,i);
+  }
+
+  return accel;
+}
+
+// Registers used by the buffers that FixDelays inserted
+static int TestDelayRegistersInserted(Accelerator* accel){
+  int registers = 0;
+  for(FUInstance* inst : accel->allocated){
+    FUDeclaration* decl = inst->declaration;
+    if(decl == BasicDeclaration::buffer || decl == BasicDeclaration::fixedBuffer){
+      registers += inst->bufferAmount + decl->info.infos[0].outputLatencies[0];
+    }
+  }
+  return registers;
+}
+
+int TestDelayRegisters(){
+  TEMP_REGION(temp,nullptr);
+  int failed = 0;
+
+  bool savedUnitDelays = globalOptions.unitDelays;
+  int waitsData[] = {1,3,7};
+  Array<int> waits = {waitsData,3};
+
+  // Aligned as soon as possible, x feeds a chain tapped at 1, 3 and 7 cycles (7 registers instead of 11 with a buffer per edge)
+  globalOptions.unitDelays = true;
+  {
+    Accelerator* accel = TestDelayRegistersAccelerator("DelayTest",waits);
+    CalculateDelayResult delays = CalculateDelay(accel,temp);
+    TEST_CHECK(failed,delays.unitLevelDelayRegisters == 7);
+    TEST_CHECK(failed,delays.delayRegisters == 7);
+
+    FixDelays(accel,delays.edgesDelay);
+    TEST_CHECK(failed,TestDelayRegistersInserted(accel) == delays.delayRegisters);
+  }
+
+  // Minimized, x waits one cycle on the input and the chain only needs 2 and 6
+  globalOptions.unitDelays = false;
+  {
+    Accelerator* accel = TestDelayRegistersAccelerator("DelayTest",waits);
+    CalculateDelayResult delays = CalculateDelay(accel,temp);
+    TEST_CHECK(failed,delays.unitLevelDelayRegisters == 7);
+    TEST_CHECK(failed,delays.delayRegisters == 6);
+
+    FixDelays(accel,delays.edgesDelay);
+    TEST_CHECK(failed,TestDelayRegistersInserted(accel) == delays.delayRegisters);
+  }
+
+  // Merge path, every edge gets its own buffer and the edges to the output are also delayed.
+  // Aligned as soon as possible the y units use 1 + 3 + 7 registers on their inputs and 6 + 4 + 0 on their outputs.
+  // Minimized, every y unit waits for the last one and only the inputs waiting less use registers (6 + 4)
+  int minimizedData[] = {10,21};
+  for(int unitDelays = 0; unitDelays < 2; unitDelays++){
+    globalOptions.unitDelays = unitDelays;
+
+    Accelerator* accel = TestDelayRegistersAccelerator("DelayTest",waits);
+    CalculateDelayResult delays = CalculateDelay(accel,temp,false);
+    TEST_CHECK(failed,delays.unitLevelDelayRegisters == 21);
+    TEST_CHECK(failed,delays.delayRegisters == minimizedData[unitDelays]);
+
+    int inserted = 0;
+    for(DelayToAdd toAdd : GenerateFixDelays(accel,delays.edgesDelay,temp)){
+      inserted += toAdd.bufferAmount + BasicDeclaration::fixedBuffer->info.infos[0].outputLatencies[0];
+    }
+    TEST_CHECK(failed,inserted == delays.delayRegisters);
+  }
+
+  globalOptions.unitDelays = savedUnitDelays;
+  return failed;
+}
@@ -2,7 +2,9 @@
 
 #include "configurations.hpp"
 
-// TODO: Maybe it would be best if we just made the change to versat to do delay calculation in a port by port basis instead of just looking at the units themselves. This would extract a little bit more performace, use less hardware since we can have better fixed buffer allocations and we could even simplify a bit of the code, since the "out" unit already requires port based delay calculations.
+// Delays are calculated on a port by port basis. Unit latencies are chosen to minimize the registers used by the fixed buffers, instead of aligning each unit as soon as its inputs are valid.
+// Edges that leave the same output port share a chain of buffers (FixDelays). The merge path inserts a buffer per edge, including the edges to the output (GenerateFixDelays), and must calculate with sharedBuffers set to false.
+// TODO: We could simplify a bit of the code, since the "out" unit already requires port based delay calculations.
 
 typedef Hashmap<Edge,DelayInfo> EdgeDelay;
 typedef Hashmap<PortInstance,DelayInfo> PortDelay;
@@ -23,6 +25,8 @@ struct CalculateDelayResult{
   EdgeDelay* edgesDelay;
   PortDelay* portDelay;
   NodeDelay* nodeDelay;
+  int delayRegisters;
+  int unitLevelDelayRegisters; // Registers needed if every unit was aligned as soon as possible
 };
 
 // Nodes indexed by order, edges indexed by index returned from EdgeIterator
@@ -30,13 +34,17 @@ struct SimpleCalculateDelayResult{
   Array<DelayInfo> nodeBaseLatencyByOrder;
   Array<DelayInfo> edgesExtraDelay;
   Array<Array<DelayInfo>> inputPortBaseLatencyByOrder;
+  int delayRegisters;
+  int unitLevelDelayRegisters; // Registers needed if every unit was aligned as soon as possible
 };
 
-SimpleCalculateDelayResult CalculateDelay(AccelInfoIterator top,Arena* out);
+SimpleCalculateDelayResult CalculateDelay(AccelInfoIterator top,Arena* out,bool sharedBuffers = true);
 
 // TODO: This is very bad performance wise. We are internally creating an AccelInfo and then extracting the values from the delay calculating.
 //       Also, cannot call this function for merge accelerators, most of them will lead to errors.
 //       Need to simplefy further (Replace CalculateDelayResult with the simple version).
-CalculateDelayResult CalculateDelay(Accelerator* accel,Arena* out);
+CalculateDelayResult CalculateDelay(Accelerator* accel,Arena* out,bool sharedBuffers = true);
 
 Array<DelayToAdd> GenerateFixDelays(Accelerator* accel,EdgeDelay* edgeDelays,Arena* out);
+
+int TestDelayRegisters();
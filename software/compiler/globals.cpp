@@ -8,11 +8,16 @@
 Options globalOptions = {};
 DebugState globalDebug = {};
 
-Arena* globalPermanent;
+thread_local Arena* globalPermanent;
 
 Options DefaultOptions(Arena* out){
   Options res = {};
   res.databusDataSize = 32;
+  res.threads = 0; // Zero means not set by the user
+  res.cliqueTime = -1; // Negative means not set by the user
+  res.verilatorThreads = 1;
+  res.verilatorJobs = 1;
+  res.verilatorOptLevel = 0; // Zero means not set by the user
 
   res.useFixedBuffers = true;
   res.shadowRegister = true; 
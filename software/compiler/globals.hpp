@@ -25,6 +25,7 @@ struct Options{
   String hardwareOutputFilepath;
   String softwareOutputFilepath;
   String debugPath;
+  String cachePath; // Data kept between runs to speedup compilation
 
   String prefixIObPort;
   
@@ -33,6 +34,13 @@ struct Options{
   String specificationFilepath;
   String topName;
   int databusDataSize; // AXI_DATA_W
+  int threads; // Total threads used by the parallel parts of the compiler, including the main thread
+  int cliqueTime; // Time limit of the clique search in seconds, zero means no limit
+  int maxCombinatorialDepth; // Pipeline registers are inserted so that no chain of combinatorial units goes over this amount, zero disables
+  int verilatorThreads; // Threads used by the verilated model of the pc-emul makefile
+  int verilatorJobs; // Parallel compile jobs of the verilated code. Output is split into smaller files when bigger than one
+  int verilatorOptLevel; // -O level used to compile the verilated code and the wrapper
+  float cliqueGap; // Percentage. Clique search stops once the gap between the clique found and the upper bound is this small
 
   bool addInputAndOutputsToTop;
   bool debug;
@@ -44,6 +52,13 @@ struct Options{
   bool exportInternalMemories;
   bool insertDebugRegisters;
   bool insertProfilingRegisters;
+  bool parallelClique; // Use ParallelMaxClique when merging
+  bool benchmarkClique; // Benchmark the BitArray kernels with the consolidation graphs of every merge
+  bool disableCache;
+  bool unitDelays; // Align every unit as soon as possible instead of minimizing delay registers
+  bool verilatorCCache; // Compile verilated code through ccache
+  bool verilatorPGO; // Makefile builds the model with profile guided optimization by default
+  bool selfTest; // Run the self tests instead of compiling
   
   bool extraIOb;
   bool useSymbolAddress; // If the system removes the LSB bits of the address (alignment info) and if we must generate code to account for that.
@@ -67,7 +82,7 @@ Options DefaultOptions(Arena* out);
 
 extern Options globalOptions;
 extern DebugState globalDebug;
-extern Arena* globalPermanent;
+extern thread_local Arena* globalPermanent;
 
 extern Pool<FUDeclaration> globalDeclarations;
 
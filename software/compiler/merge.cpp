@@ -9,6 +9,7 @@
 #include "textualRepresentation.hpp"
 #include "symbolic.hpp"
 #include "utilsCore.hpp"
+#include "thread.hpp"
 
 bool NodeConflict(FUInstance* inst){
   // For now, do not even try to map nodes that contain any config modifiers.
@@ -140,6 +141,84 @@ ConsolidationGraph Copy(ConsolidationGraph graph,Arena* out){
   return res;
 }
 
+static int ListSize(ConsolidationGraph* graph,int node){
+  int res = graph->listOffsets[node + 1] - graph->listOffsets[node];
+  return res;
+}
+
+static int* ListStart(ConsolidationGraph* graph,int node){
+  int* res = &graph->listIndexes.data[graph->listOffsets[node]];
+  return res;
+}
+
+bool IsNeighbor(ConsolidationGraph* graph,int node0,int node1){
+  if(graph->edges.size){
+    return graph->edges[node0].Get(node1);
+  }
+
+  if(node0 == node1){
+    return false;
+  }
+  
+  // Binary search, lists are sorted
+  int* list = ListStart(graph,node0);
+  int low = 0;
+  int high = ListSize(graph,node0);
+  while(low < high){
+    int mid = (low + high) / 2;
+    if(list[mid] < node1){
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  bool inList = (low < ListSize(graph,node0) && list[low] == node1);
+
+  bool res = (graph->complement ? !inList : inList);
+  return res;
+}
+
+int IntersectNeighbors(ConsolidationGraph* graph,int node,BitArray* out,BitArray* in){
+  if(graph->edges.size){
+    if(out == in){
+      return out->IntersectAndCount(graph->edges[node]);
+    }
+    return out->CopyIntersectAndCount(*in,graph->edges[node]);
+  }
+
+  if(out != in){
+    out->Copy(*in);
+  }
+  
+  int* list = ListStart(graph,node);
+  int size = ListSize(graph,node);
+
+  if(graph->complement){
+    out->Set(node,0);
+    for(int i = 0; i < size; i++){
+      out->Set(list[i],0);
+    }
+    return out->GetNumberBitsSet();
+  }
+
+  // Keep only the set bits that appear in the list. Both are ordered, so a single pass over each is enough.
+  int count = 0;
+  int listIndex = 0;
+  for(int index = out->FirstBitSetIndex(0); index != -1; index = out->FirstBitSetIndex(index + 1)){
+    while(listIndex < size && list[listIndex] < index){
+      listIndex += 1;
+    }
+
+    if(listIndex < size && list[listIndex] == index){
+      count += 1;
+    } else {
+      out->Set(index,0);
+    }
+  }
+  
+  return count;
+}
+
 IsCliqueResult IsClique(ConsolidationGraph graph){
   IsCliqueResult res = {};
   res.result = true;
@@ -157,12 +236,12 @@ IsCliqueResult IsClique(ConsolidationGraph graph){
     }
 
     int count = 0;
-    for(int ii = 0; ii < graph.edges.size; ii++){
+    for(int ii = 0; ii < graph.nodes.size; ii++){
       if(!graph.validNodes.Get(ii)){
         continue;
       }
 
-      if(graph.edges[i].Get(ii)){
+      if(IsNeighbor(&graph,i,ii)){
         count += 1;
       }
     }
@@ -195,6 +274,331 @@ bool EqualPortMapping(PortInstance p1,PortInstance p2){
   return res;
 }
 
+// Two edges can only be mapped if both ends have an equal port mapping and the delays are equal.
+struct EdgeMappingKey{
+  FUDeclaration* decls[2];
+  int inputPort[2]; // Inputs only map to inputs of the same port
+  int delay;
+  int index;
+};
+
+static EdgeMappingKey MakeEdgeMappingKey(Edge& edge,int index){
+  EdgeMappingKey key = {};
+  for(int i = 0; i < 2; i++){
+    FUInstance* inst = edge.units[i].inst;
+    key.decls[i] = inst->declaration;
+    key.inputPort[i] = (inst->declaration == BasicDeclaration::input) ? GetInputPortNumber(inst) : 0;
+  }
+  key.delay = edge.delay;
+  key.index = index;
+  return key;
+}
+
+// Ignores the index. Keys that compare equal are the same as EqualPortMapping on both ends and equal delays.
+static int CompareEdgeMappingKey(const void* v0,const void* v1){
+  const EdgeMappingKey* k0 = (const EdgeMappingKey*) v0;
+  const EdgeMappingKey* k1 = (const EdgeMappingKey*) v1;
+
+  for(int i = 0; i < 2; i++){
+    if(k0->decls[i] != k1->decls[i]){
+      return (k0->decls[i] < k1->decls[i]) ? -1 : 1;
+    }
+    if(k0->inputPort[i] != k1->inputPort[i]){
+      return (k0->inputPort[i] < k1->inputPort[i]) ? -1 : 1;
+    }
+  }
+  if(k0->delay != k1->delay){
+    return (k0->delay < k1->delay) ? -1 : 1;
+  }
+  return 0;
+}
+
+static int CompareEdgeMappingKeyAndIndex(const void* v0,const void* v1){
+  int res = CompareEdgeMappingKey(v0,v1);
+  if(res != 0){
+    return res;
+  }
+  return ((const EdgeMappingKey*) v0)->index - ((const EdgeMappingKey*) v1)->index;
+}
+
+// Bit matrices above this size are stored as lists, even if the lists end up using more memory.
+#define MAX_CONSOLIDATION_MATRIX_SIZE Megabyte(32)
+
+struct InstanceMapping{
+  FUInstance* inst;
+  int node;
+};
+
+static int CompareInstanceMapping(const void* v0,const void* v1){
+  const InstanceMapping* m0 = (const InstanceMapping*) v0;
+  const InstanceMapping* m1 = (const InstanceMapping*) v1;
+
+  if(m0->inst != m1->inst){
+    return (m0->inst < m1->inst) ? -1 : 1;
+  }
+  return m0->node - m1->node;
+}
+
+static int CompareIndexPair(const void* v0,const void* v1){
+  const Pair<int,int>* p0 = (const Pair<int,int>*) v0;
+  const Pair<int,int>* p1 = (const Pair<int,int>*) v1;
+
+  if(p0->first != p1->first){
+    return p0->first - p1->first;
+  }
+  return p0->second - p1->second;
+}
+
+static int CompareInt(const void* v0,const void* v1){
+  int res = *((const int*) v0) - *((const int*) v1);
+  return res;
+}
+
+// Reorders graph->nodes and fills the adjacency of the graph.
+//
+// Two mapping nodes can only conflict if they map a common instance (mappings of instances with NodeConflict are never added).
+// Instead of checking every pair, mapping nodes are bucketed by the instances that they map and only pairs inside a bucket are checked.
+// The resulting conflict graph is usually sparse while the consolidation graph (its complement) is dense.
+//
+// Nodes are placed in degeneracy order of the consolidation graph (repeatedly remove the node with smallest degree).
+// Each node has at most degeneracy neighbors after it, which are the only nodes that the clique search looks at when starting from that node.
+static void BuildConsolidationGraphAdjacency(ConsolidationGraph* graph,Arena* out){
+  TEMP_REGION(temp,out);
+  
+  Time start = GetTime();
+  int size = graph->nodes.size;
+
+  Array<InstanceMapping> mappings = PushArray<InstanceMapping>(temp,size * 4);
+  int mappingsSize = 0;
+  for(int i = 0; i < size; i++){
+    MappingNode& node = graph->nodes[i];
+
+    if(node.type == MappingNode::NODE){
+      mappings[mappingsSize++] = {node.nodes.instances[0],i};
+      mappings[mappingsSize++] = {node.nodes.instances[1],i};
+    } else {
+      mappings[mappingsSize++] = {node.edges[0].units[0].inst,i};
+      mappings[mappingsSize++] = {node.edges[0].units[1].inst,i};
+      mappings[mappingsSize++] = {node.edges[1].units[0].inst,i};
+      mappings[mappingsSize++] = {node.edges[1].units[1].inst,i};
+    }
+  }
+  mappings.size = mappingsSize;
+  qsort(mappings.data,mappings.size,sizeof(InstanceMapping),CompareInstanceMapping);
+
+  // Pairs can appear more than once if they share more than one instance. Duplicates are removed after sorting.
+  auto conflictsBuilder = StartArray<Pair<int,int>>(temp);
+  for(int bucketStart = 0; bucketStart < mappings.size;){
+    int bucketEnd = bucketStart + 1;
+    while(bucketEnd < mappings.size && mappings[bucketEnd].inst == mappings[bucketStart].inst){
+      bucketEnd += 1;
+    }
+
+    for(int i = bucketStart; i < bucketEnd; i++){
+      for(int ii = i + 1; ii < bucketEnd; ii++){
+        int node0 = mappings[i].node;
+        int node1 = mappings[ii].node;
+
+        // Bucket is sorted by node, so node0 <= node1
+        if(node0 == node1){
+          continue;
+        }
+
+        if(MappingConflict(graph->nodes[node0],graph->nodes[node1])){
+          Pair<int,int>* conflict = conflictsBuilder.PushElem();
+          conflict->first = node0;
+          conflict->second = node1;
+        }
+      }
+    }
+    
+    bucketStart = bucketEnd;
+  }
+  Array<Pair<int,int>> conflicts = EndArray(conflictsBuilder);
+  qsort(conflicts.data,conflicts.size,sizeof(Pair<int,int>),CompareIndexPair);
+
+  int uniqueSize = 0;
+  for(int i = 0; i < conflicts.size; i++){
+    if(uniqueSize > 0 && conflicts[uniqueSize - 1] == conflicts[i]){
+      continue;
+    }
+    conflicts[uniqueSize++] = conflicts[i];
+  }
+  conflicts.size = uniqueSize;
+
+  // Conflict lists, indexed by the original node order
+  Array<int> conflictOffsets = PushArray<int>(temp,size + 1);
+  Memset(conflictOffsets,0);
+  for(Pair<int,int> conflict : conflicts){
+    conflictOffsets[conflict.first + 1] += 1;
+    conflictOffsets[conflict.second + 1] += 1;
+  }
+  for(int i = 0; i < size; i++){
+    conflictOffsets[i + 1] += conflictOffsets[i];
+  }
+
+  Array<int> conflictIndexes = PushArray<int>(temp,conflicts.size * 2);
+  Array<int> fill = PushArray<int>(temp,size);
+  for(int i = 0; i < size; i++){
+    fill[i] = conflictOffsets[i];
+  }
+  for(Pair<int,int> conflict : conflicts){
+    conflictIndexes[fill[conflict.first]++] = conflict.second;
+    conflictIndexes[fill[conflict.second]++] = conflict.first;
+  }
+
+  // Degeneracy order. The degree of a node in the consolidation graph is (nodes left - 1 - conflicts left), so the node
+  // with smallest degree is the node with most conflicts left. Nodes are kept in buckets (linked lists) indexed by conflicts left.
+  Array<int> conflictsLeft = PushArray<int>(temp,size);
+  Array<int> next = PushArray<int>(temp,size);
+  Array<int> previous = PushArray<int>(temp,size);
+  Array<bool> removed = PushArray<bool>(temp,size);
+  int maxConflicts = 0;
+  for(int i = 0; i < size; i++){
+    conflictsLeft[i] = conflictOffsets[i + 1] - conflictOffsets[i];
+    maxConflicts = std::max(maxConflicts,conflictsLeft[i]);
+    removed[i] = false;
+  }
+
+  Array<int> bucketHead = PushArray<int>(temp,maxConflicts + 1);
+  Memset(bucketHead,-1);
+
+  auto BucketInsert = [&](int node){
+    int bucket = conflictsLeft[node];
+    previous[node] = -1;
+    next[node] = bucketHead[bucket];
+    if(bucketHead[bucket] != -1){
+      previous[bucketHead[bucket]] = node;
+    }
+    bucketHead[bucket] = node;
+  };
+  auto BucketRemove = [&](int node){
+    if(previous[node] != -1){
+      next[previous[node]] = next[node];
+    } else {
+      bucketHead[conflictsLeft[node]] = next[node];
+    }
+    if(next[node] != -1){
+      previous[next[node]] = previous[node];
+    }
+  };
+
+  // Insert in reverse so that ties are removed in the original node order
+  for(int i = size - 1; i >= 0; i--){
+    BucketInsert(i);
+  }
+
+  Array<int> order = PushArray<int>(temp,size); // order[newIndex] = oldIndex
+  Array<int> position = PushArray<int>(temp,size); // position[oldIndex] = newIndex
+  int current = maxConflicts;
+  for(int i = 0; i < size; i++){
+    while(bucketHead[current] == -1){
+      current -= 1;
+    }
+
+    int node = bucketHead[current];
+    BucketRemove(node);
+    removed[node] = true;
+    order[i] = node;
+    position[node] = i;
+
+    for(int j = conflictOffsets[node]; j < conflictOffsets[node + 1]; j++){
+      int other = conflictIndexes[j];
+      if(removed[other]){
+        continue;
+      }
+      BucketRemove(other);
+      conflictsLeft[other] -= 1;
+      BucketInsert(other);
+    }
+  }
+
+  Array<MappingNode> originalNodes = PushArray<MappingNode>(temp,size);
+  Memcpy(originalNodes,graph->nodes);
+  for(int i = 0; i < size; i++){
+    graph->nodes[i] = originalNodes[order[i]];
+  }
+
+  // Conflict lists in the new order
+  Array<int> sortedOffsets = PushArray<int>(temp,size + 1);
+  Array<int> sortedIndexes = PushArray<int>(temp,conflictIndexes.size);
+  sortedOffsets[0] = 0;
+  for(int i = 0; i < size; i++){
+    int old = order[i];
+    int start = sortedOffsets[i];
+    int amount = conflictOffsets[old + 1] - conflictOffsets[old];
+    for(int j = 0; j < amount; j++){
+      sortedIndexes[start + j] = position[conflictIndexes[conflictOffsets[old] + j]];
+    }
+    qsort(&sortedIndexes.data[start],amount,sizeof(int),CompareInt);
+    sortedOffsets[i + 1] = start + amount;
+  }
+
+  // Pick the representation
+  i64 numberConflicts = conflicts.size;
+  i64 numberEdges = ((i64) size * (size - 1)) / 2 - numberConflicts;
+
+  size_t matrixBytes = (size_t) size * (ALIGN_UP_256(BitSizeToByteSize(size)) + sizeof(BitArray));
+  bool complement = (numberConflicts <= numberEdges);
+  size_t listBytes = ((size_t) size + 1 + 2 * std::min(numberConflicts,numberEdges)) * sizeof(int);
+
+  // The matrix is faster to intersect, only use lists if they save a good amount of memory
+  bool useMatrix = (matrixBytes <= MAX_CONSOLIDATION_MATRIX_SIZE && matrixBytes <= listBytes * 4);
+  
+  graph->edges = {};
+  graph->listOffsets = {};
+  graph->listIndexes = {};
+  graph->complement = false;
+  
+  if(useMatrix){
+    graph->edges = PushArray<BitArray>(out,size);
+    for(int i = 0; i < size; i++){
+      BitArray& row = graph->edges[i];
+      row.Init(out,size);
+      row.Fill(1);
+      row.Set(i,0);
+      for(int j = sortedOffsets[i]; j < sortedOffsets[i + 1]; j++){
+        row.Set(sortedIndexes[j],0);
+      }
+    }
+  } else if(complement){
+    graph->complement = true;
+    graph->listOffsets = PushArray<int>(out,size + 1);
+    graph->listIndexes = PushArray<int>(out,sortedIndexes.size);
+    Memcpy(graph->listOffsets,sortedOffsets);
+    Memcpy(graph->listIndexes,sortedIndexes);
+  } else {
+    graph->listOffsets = PushArray<int>(out,size + 1);
+    graph->listIndexes = PushArray<int>(out,numberEdges * 2);
+
+    int index = 0;
+    for(int i = 0; i < size; i++){
+      graph->listOffsets[i] = index;
+
+      int conflictIndex = sortedOffsets[i];
+      for(int j = 0; j < size; j++){
+        if(conflictIndex < sortedOffsets[i + 1] && sortedIndexes[conflictIndex] == j){
+          conflictIndex += 1;
+          continue;
+        }
+        if(j == i){
+          continue;
+        }
+        graph->listIndexes[index++] = j;
+      }
+    }
+    graph->listOffsets[size] = index;
+  }
+
+  if(globalOptions.debug){
+    double density = (size > 1) ? (double) numberEdges / (((double) size * (size - 1)) / 2.0) : 0.0;
+    size_t bytes = useMatrix ? matrixBytes : listBytes;
+    const char* format = useMatrix ? "bit matrix" : (complement ? "non neighbor lists" : "neighbor lists");
+
+    printf("Consolidation graph: %d nodes, %ld edges (density %.3f), %.*s as %s, built in %.3fs\n",size,numberEdges,density,UN(ReprMemorySize(bytes,temp)),format,ElapsedSeconds(start));
+  }
+}
+
 ConsolidationResult GenerateConsolidationGraph(Accelerator* accel0,Accelerator* accel1,ConsolidationGraphOptions options,Arena* out){
   TEMP_REGION(temp,out);
   ConsolidationGraph graph = {};
@@ -283,22 +687,36 @@ ConsolidationResult GenerateConsolidationGraph(Accelerator* accel0,Accelerator*
   
 #if 1
   // Check possible edge mapping
-  Array<Edge> accel0Edges = GetAllEdges(accel0,temp);
-  Array<Edge> accel1Edges = GetAllEdges(accel1,temp);
-
+  Array<Edge> accel0Edges = GetAllEdges(CreateAcceleratorGraph(accel0,temp),temp);
+  Array<Edge> accel1Edges = GetAllEdges(CreateAcceleratorGraph(accel1,temp),temp);
+
+  // Edges of accel1 sorted by key. Each edge of accel0 only visits the edges with the same key, in their original order,
+  // which adds the same mapping nodes in the same order as checking every pair.
+  Array<EdgeMappingKey> accel1Keys = PushArray<EdgeMappingKey>(temp,accel1Edges.size);
+  for(int i = 0; i < accel1Edges.size; i++){
+    accel1Keys[i] = MakeEdgeMappingKey(accel1Edges[i],i);
+  }
+  qsort(accel1Keys.data,accel1Keys.size,sizeof(EdgeMappingKey),CompareEdgeMappingKeyAndIndex);
+  
   for(Edge& edge0 : accel0Edges){
-    for(Edge& edge1 : accel1Edges){
-  // TODO: some nodes do not care about which port is connected (think the inputs for common operations, like multiplication, adders and the likes)
-      // Can augment the algorithm further to find more mappings
-      if(!(EqualPortMapping(edge0.units[0],edge1.units[0]) &&
-           EqualPortMapping(edge0.units[1],edge1.units[1]))){
-        continue;
+    EdgeMappingKey key0 = MakeEdgeMappingKey(edge0,0);
+
+    int low = 0;
+    int high = accel1Keys.size;
+    while(low < high){
+      int middle = (low + high) / 2;
+      if(CompareEdgeMappingKey(&accel1Keys[middle],&key0) < 0){
+        low = middle + 1;
+      } else {
+        high = middle;
       }
+    }
 
-      if(edge0.delay != edge1.delay){
-        continue;
-      }
-      
+    for(int k = low; k < accel1Keys.size && CompareEdgeMappingKey(&accel1Keys[k],&key0) == 0; k++){
+      Edge& edge1 = accel1Edges[accel1Keys[k].index];
+
+      // TODO: some nodes do not care about which port is connected (think the inputs for common operations, like multiplication, adders and the likes)
+      // Can augment the algorithm further to find more mappings
       MappingNode node = {};
       node.type = MappingNode::EDGE;
       node.edges[0].units[0] = edge0.units[0];
@@ -355,6 +773,10 @@ ConsolidationResult GenerateConsolidationGraph(Accelerator* accel0,Accelerator*
           continue;
         }
 
+        if(NodeConflict(instA) || NodeConflict(instB)){
+          continue;
+        }
+
         MappingNode node = {};
         node.type = MappingNode::NODE;
         node.nodes.instances[0] = instA;
@@ -404,11 +826,6 @@ ConsolidationResult GenerateConsolidationGraph(Accelerator* accel0,Accelerator*
 
   graph.nodes = EndArray(nodes);
 
-#if 0
-  printf("Size (MB):%d ",((graph.nodes.size / 8) * graph.nodes.size) / Megabyte(1));
-  exit(0);
-#endif
-
   // Order nodes based on how equal in depth they are
 #if 0
   region(out){
@@ -458,159 +875,743 @@ ConsolidationResult GenerateConsolidationGraph(Accelerator* accel0,Accelerator*
 #endif
 
   int upperBound = std::min(accel0Edges.size,accel1Edges.size);
-  Array<BitArray> neighbors = PushArray<BitArray>(out,graph.nodes.size);
-  int times = 0;
-  for(int i = 0; i < graph.nodes.size; i++){
-    neighbors[i].Init(out,graph.nodes.size);
-    neighbors[i].Fill(0);
+
+  BuildConsolidationGraphAdjacency(&graph,out);
+  
+  graph.validNodes.Init(out,graph.nodes.size);
+  graph.validNodes.Fill(1);
+
+  ConsolidationResult res = {};
+  res.graph = graph;
+  res.upperBound = upperBound;
+  res.specificsAdded = specificsAdded;
+
+  return res;
+}
+
+// Greedy coloring of the candidates, one color class at a time (as in the bitset variants of Tomita's MCQ).
+// bound[k] receives the number of different colors used by the k-th candidate (in index order) and every candidate after it,
+// which bounds the size of any clique inside those candidates. Returns the number of colors used.
+static int ColoringBound(ConsolidationGraph* graph,BitArray* candidates,int num,int* bound,Arena* temp){
+  auto mark = MarkArena(temp);
+
+  int size = candidates->bitSize;
+  Array<int> nodes = PushArray<int>(temp,num);
+  Array<int> color = PushArray<int>(temp,num);
+
+  int index = 0;
+  for(int i = candidates->FirstBitSetIndex(0); i != -1; i = candidates->FirstBitSetIndex(i + 1)){
+    nodes[index++] = i;
   }
-  for(int i = 0; i < graph.nodes.size; i++){
-    MappingNode node1 = graph.nodes[i];
 
-    for(int ii = 0; ii < i; ii++){
-      times += 1;
+  BitArray uncolored = {};
+  BitArray colorClass = {};
+  BitArray neighbors = {};
+  uncolored.Init(temp,size);
+  colorClass.Init(temp,size);
+  neighbors.Init(temp,size);
+  uncolored.Copy(*candidates);
+
+  int colors = 0;
+  int left = num;
+  int position = 0;
+  while(left > 0){
+    colors += 1;
+
+    // Every node in a color class is not a neighbor of the nodes before it in the class
+    colorClass.Copy(uncolored);
+    for(int i = colorClass.FirstBitSetIndex(0); i != -1; i = colorClass.FirstBitSetIndex(i + 1)){
+      // Nodes are colored in increasing order inside a class, the position only moves forward
+      while(nodes[position] != i){
+        position += 1;
+      }
+      color[position] = colors;
 
-      MappingNode node2 = graph.nodes[ii];
+      uncolored.Set(i,0);
+      left -= 1;
 
-      if(MappingConflict(node1,node2)){
-        continue;
+      IntersectNeighbors(graph,i,&neighbors,&colorClass);
+      colorClass.Remove(neighbors);
+    }
+    position = 0;
+  }
+
+  Array<bool> seen = PushArray<bool>(temp,colors + 1);
+  Memset(seen,false);
+  int different = 0;
+  for(int i = num - 1; i >= 0; i--){
+    if(!seen[color[i]]){
+      seen[color[i]] = true;
+      different += 1;
+    }
+    bound[i] = different;
+  }
+
+  PopMark(mark);
+
+  return colors;
+}
+
+// Upper bound on the max clique of the graph while the search is processing vertex. Table is valid for every index after vertex.
+// A clique that starts before vertex + 1 is at most one bigger per vertex than the cliques that start at vertex + 1.
+static int CliqueUpperBound(CliqueState* state,int vertex){
+  int size = state->table.size;
+  int tableBound = (vertex + 1 < size) ? state->table[vertex + 1] : 0;
+
+  int bound = std::min(state->upperBound,tableBound + vertex + 1);
+  bound = std::max(bound,state->max);
+  return bound;
+}
+
+static float CliqueGap(int max,int upperBound){
+  if(upperBound <= 0){
+    return 0.0f;
+  }
+  float res = (float) (upperBound - max) / (float) upperBound;
+  return res;
+}
+
+// Checks time limit and gap target, printing the state of the search every second.
+static bool CliqueShouldStop(CliqueState* state,int vertex){
+  if(state->stop){
+    return true;
+  }
+  
+  Time now = GetTime();
+  int upperBound = CliqueUpperBound(state,vertex);
+  float gap = CliqueGap(state->max,upperBound);
+
+  if(now - state->lastReport > Seconds(1)){
+    state->lastReport = now;
+    printf("Clique search: %d (upper bound %d, gap %.2f%%) after %.1fs\n",state->max,upperBound,gap * 100.0f,ElapsedSeconds(state->start));
+  }
+  
+  if(gap <= state->gapTarget){
+    state->stop = true;
+  }
+
+  if(!(state->maxTime == Seconds(0)) && now - state->start > state->maxTime){
+    state->stop = true;
+  }
+
+  return state->stop;
+}
+
+// Num is the number of valid nodes in graph
+void Clique(CliqueState* state,ConsolidationGraph graphArg,int vertex,int num,int index,IndexRecord* record,int size,Arena* temp){
+  state->iterations += 1;
+
+  ConsolidationGraph graph = graphArg;
+
+  if(num == 0){
+    if(size > state->max){
+      state->max = size;
+
+      // Record best clique found so far
+      state->clique.validNodes.Fill(0);
+      for(IndexRecord* ptr = record; ptr != nullptr; ptr = ptr->next){
+        state->clique.validNodes.Set(ptr->index,1);
       }
 
-      neighbors.data[i].Set(ii,1);
-      neighbors.data[ii].Set(i,1);
+      state->found = true;
     }
+    return;
   }
-  graph.edges = neighbors;
 
-  // Reorder based on degree of nodes
-#if 0
+  if(CliqueShouldStop(state,vertex)){
+    state->found = true;
+    return;
+  }
+
+  if(size + num <= state->max){
+    return;
+  }
+
+  // colorBound[k] bounds the cliques formed by the k-th valid node and the ones after it.
+  Array<int> colorBound = PushArray<int>(temp,num);
+  ColoringBound(&graph,&graph.validNodes,num,colorBound.data,temp);
+  int position = 0;
+  
+  int lastI = index;
+  do{
+    if(size + num <= state->max){
+      return;
+    }
+
+    if(size + colorBound[position] <= state->max){
+      return;
+    }
+    position += 1;
+    
+    int i = graph.validNodes.FirstBitSetIndex(lastI);
+
+    if(size + state->table[i] <= state->max){
+      return;
+    }
+
+    graph.validNodes.Set(i,0);
+    num -= 1;
+    
+    auto mark = MarkArena(temp);
+    ConsolidationGraph tempGraph = graph;
+    tempGraph.validNodes.Init(temp,graph.nodes.size);
+    int tempNum = IntersectNeighbors(&graph,i,&tempGraph.validNodes,&graph.validNodes);
+
+    IndexRecord newRecord = {};
+    newRecord.index = i;
+    newRecord.next = record;
+
+    Clique(state,tempGraph,vertex,tempNum,i,&newRecord,size + 1,temp);
+
+    PopMark(mark);
+
+    if(state->found == true){
+      return;
+    }
+
+    lastI = i;
+  } while(num != 0);
+}
+
+CliqueState MaxClique(ConsolidationGraph graph,int upperBound,Arena* out,Time MAX_CLIQUE_TIME,float gapTarget){
+  CliqueState state = {};
+  state.table = PushArray<int>(out,graph.nodes.size);
+  state.clique = Copy(graph,out); // Preserve nodes and edges, but allocates different valid nodes
+  state.maxTime = MAX_CLIQUE_TIME;
+  state.gapTarget = gapTarget;
+  state.start = GetTime();
+  state.lastReport = state.start;
+
   region(out){
-    Array<int> degree = PushArray<int>(out,graph.nodes.size);
-    Memset(degree,0);
-    for(int i = 0; i < graph.nodes.size; i++){
-      degree[i] = graph.edges[i].GetNumberBitsSet();
+    Array<int> bound = PushArray<int>(out,graph.nodes.size);
+    graph.validNodes.Fill(1);
+    state.colors = ColoringBound(&graph,&graph.validNodes,graph.nodes.size,bound.data,out);
+  }
+  state.upperBound = std::min(upperBound,state.colors);
+  
+  graph.validNodes.Fill(0);
+
+  int processed = graph.nodes.size; // Vertices fully searched, table is valid from here on
+  for(int i = graph.nodes.size - 1; i >= 0; i--){
+    BLOCK_REGION(out);
+
+    state.found = false;
+    for(int j = i; j < graph.nodes.size; j++){
+      graph.validNodes.Set(j,1);
+    }
+
+    int num = IntersectNeighbors(&graph,i,&graph.validNodes,&graph.validNodes);
+
+    IndexRecord record = {};
+    record.index = i;
+
+    Clique(&state,graph,i,num,i,&record,1,out);
+    state.table[i] = state.max;
+    if(!state.stop){
+      processed = i;
+    }
+
+    if(state.max == state.upperBound){
+      break;
     }
+
+    if(CliqueShouldStop(&state,i - 1)){
+      break;
+    }
+  }
+
+  state.upperBound = CliqueUpperBound(&state,processed - 1);
+  if(state.upperBound > state.max){
+    printf("Clique search stopped at %d (upper bound %d, gap %.2f%%). Result might not be optimal\n",state.max,state.upperBound,CliqueGap(state.max,state.upperBound) * 100.0f);
+  }
+  
+  Assert(IsClique(state.clique).result);
+
+  return state;
+}
+
+// ============================================================================
+// Parallel clique search
+
+/*
+  The search space is divided in the same way as MaxClique: vertex i (processed from last to first)
+  searches the cliques whose smallest index is i. Each vertex opens a job and every child of the
+  vertex (the second smallest index of the clique) is a task that any free worker can take, which
+  means that a big vertex is still split between all the workers.
+
+  The incumbent is shared by all the workers as a key packed into a u64 (size,vertex,child), where
+  bigger vertices and smaller children win ties. This is the same order in which the serial search
+  finds cliques, which means that both searches return the same clique when they run to completion.
+  
+  The table of Östergård bounds is only used for vertices that are fully processed.
+*/
+
+static const int CLIQUE_KEY_BITS = 22;
+static const u64 CLIQUE_KEY_MASK = (((u64) 1) << CLIQUE_KEY_BITS) - 1;
+
+static u64 CliqueKey(int size,int vertex,int child){
+  u64 key = (((u64) size) << (2 * CLIQUE_KEY_BITS)) |
+            (((u64) vertex) << CLIQUE_KEY_BITS) |
+            (CLIQUE_KEY_MASK - (u64) child);
+  return key;
+}
+
+static int CliqueKeySize(u64 key){
+  return (int) (key >> (2 * CLIQUE_KEY_BITS));
+}
+
+struct CliqueJob{
+  int vertex; // -1 if slot is free
+  BitArray candidates; // Children not handed out yet. Nodes after vertex that are neighbors of vertex
+  int nextChild;
+  int childsLeft;
+  int outstanding;
+  int best; // Upper bound on the size of cliques that start at vertex, when the job finishes
+};
+
+struct ParallelCliqueState;
+
+struct CliqueWorker{
+  ParallelCliqueState* state;
+  Arena arena;
+
+  // Current task
+  int vertex;
+  int child;
+  bool found;
+
+  u64 bestKey;
+  BitArray clique;
+  int iterations;
+};
+
+struct ParallelCliqueState{
+  ConsolidationGraph graph;
+  int upperBound;
+  Time start;
+  Time maxTime;
+  float gapTarget;
+  Time lastReport; // Only used by the main thread
+
+  Mutex lock;
+
+  // Lock protected
+  Array<CliqueJob> jobs;
+  int nextVertex;
+  int jobsOpen;
+  Array<int> best; // Indexed by vertex
+
+  Array<int> table; // Only valid for indexes >= tableStart 
+  int tableStart;
+  
+  u64 incumbent;
+  bool timeout;
+  
+  Array<CliqueWorker> workers;
+};
+
+static bool CanImprove(CliqueWorker* worker,int size){
+  ParallelCliqueState* state = worker->state;
+  size = std::min(size,state->upperBound);
+  
+  u64 key = CliqueKey(size,worker->vertex,worker->child);
+  return (key > AtomicLoad(&state->incumbent));
+}
+
+static bool RecordClique(CliqueWorker* worker,int size,IndexRecord* record){
+  ParallelCliqueState* state = worker->state;
+  u64 key = CliqueKey(size,worker->vertex,worker->child);
+
+  u64 current = AtomicLoad(&state->incumbent);
+  while(key > current){
+    if(AtomicCompareAndSwap(&state->incumbent,&current,key)){
+      worker->bestKey = key;
+      worker->clique.Fill(0);
+      for(IndexRecord* ptr = record; ptr != nullptr; ptr = ptr->next){
+        worker->clique.Set(ptr->index,1);
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static int ValidTableBound(ParallelCliqueState* state,int index){
+  if(index >= state->graph.nodes.size){
+    return 0;
+  }
+  if(index < AtomicLoad(&state->tableStart)){
+    return INT_MAX;
+  }
+  return state->table[index];
+}
+
+// Same as CliqueShouldStop. The table is valid from tableStart onwards.
+static bool ParallelCliqueShouldStop(CliqueWorker* worker){
+  ParallelCliqueState* state = worker->state;
+  if(AtomicLoad(&state->timeout)){
+    return true;
   }
-#endif
 
-  graph.validNodes.Init(out,graph.nodes.size);
-  graph.validNodes.Fill(1);
+  int size = state->graph.nodes.size;
+  int max = CliqueKeySize(AtomicLoad(&state->incumbent));
+  int start = AtomicLoad(&state->tableStart);
+  int tableBound = (start < size) ? state->table[start] : 0;
+  int upperBound = std::max(std::min(state->upperBound,tableBound + start),max);
+  float gap = CliqueGap(max,upperBound);
+
+  Time now = GetTime();
+  if(worker == &state->workers[0] && now - state->lastReport > Seconds(1)){
+    state->lastReport = now;
+    printf("Clique search: %d (upper bound %d, gap %.2f%%) after %.1fs\n",max,upperBound,gap * 100.0f,ElapsedSeconds(state->start));
+  }
 
-  ConsolidationResult res = {};
-  res.graph = graph;
-  res.upperBound = upperBound;
-  res.specificsAdded = specificsAdded;
+  // A zero gap is left to the normal pruning, since workers might still find a clique of the same size that the serial search would pick
+  bool stop = (state->gapTarget > 0.0f && gap <= state->gapTarget);
+  if(!(state->maxTime == Seconds(0)) && now - state->start > state->maxTime){
+    stop = true;
+  }
 
-  return res;
+  if(stop){
+    AtomicStore(&state->timeout,true);
+  }
+  return stop;
 }
 
-void Clique(CliqueState* state,ConsolidationGraph graphArg,int index,IndexRecord* record,int size,Arena* temp,Time MAX_CLIQUE_TIME){
-  state->iterations += 1;
-
-  ConsolidationGraph graph = graphArg;
+// Num is the number of bits set in validNodes
+static void ParallelClique(CliqueWorker* worker,BitArray validNodes,int num,int index,IndexRecord* record,int size){
+  ParallelCliqueState* state = worker->state;
+  worker->iterations += 1;
 
-  int num = graph.validNodes.GetNumberBitsSet();
   if(num == 0){
-    if(size > state->max){
-      state->max = size;
-
-      // Record best clique found so far
-      state->clique.validNodes.Fill(0);
-      for(IndexRecord* ptr = record; ptr != nullptr; ptr = ptr->next){
-        state->clique.validNodes.Set(ptr->index,1);
+    if(RecordClique(worker,size,record)){
+      // A clique starting at vertex cannot be bigger than the cliques starting at vertex + 1 plus one.
+      int bound = ValidTableBound(state,worker->vertex + 1);
+      if(bound != INT_MAX && size >= bound + 1){
+        worker->found = true;
       }
-
-      state->found = true;
     }
     return;
   }
 
-  auto end = GetTime();
-  Time elapsed = end - state->start;
-  if(elapsed > MAX_CLIQUE_TIME){
-    state->found = true;
+  if(ParallelCliqueShouldStop(worker)){
+    worker->found = true;
+    return;
+  }
+
+  if(!CanImprove(worker,size + num)){
     return;
   }
 
+  Array<int> colorBound = PushArray<int>(&worker->arena,num);
+  ColoringBound(&state->graph,&validNodes,num,colorBound.data,&worker->arena);
+  int position = 0;
+  
   int lastI = index;
   do{
-    if(size + num <= state->max){
+    if(!CanImprove(worker,size + num)){
       return;
     }
 
-#if 0
-    if(size + num <= state->table[index]){
+    if(!CanImprove(worker,size + colorBound[position])){
       return;
     }
-#endif
+    position += 1;
 
-    int i = graph.validNodes.FirstBitSetIndex(lastI);
+    int i = validNodes.FirstBitSetIndex(lastI);
 
-    if(size + state->table[i] <= state->max){
+    int bound = ValidTableBound(state,i);
+    if(bound != INT_MAX && !CanImprove(worker,size + bound)){
       return;
     }
 
-    graph.validNodes.Set(i,0);
-
-    auto mark = MarkArena(temp);
-    ConsolidationGraph tempGraph = Copy(graph,temp);
-
-    tempGraph.validNodes &= graph.edges[i];
+    validNodes.Set(i,0);
+    num -= 1;
+    
+    auto mark = MarkArena(&worker->arena);
+    BitArray subset = {};
+    subset.Init(&worker->arena,validNodes.bitSize);
+    int subsetNum = IntersectNeighbors(&state->graph,i,&subset,&validNodes);
 
     IndexRecord newRecord = {};
     newRecord.index = i;
     newRecord.next = record;
 
-    Clique(state,tempGraph,i,&newRecord,size + 1,temp,MAX_CLIQUE_TIME);
+    ParallelClique(worker,subset,subsetNum,i,&newRecord,size + 1);
 
     PopMark(mark);
 
-    if(state->found == true){
+    if(worker->found){
       return;
     }
 
     lastI = i;
-  } while((num = graph.validNodes.GetNumberBitsSet()) != 0);
+  } while(num != 0);
 }
 
-CliqueState MaxClique(ConsolidationGraph graph,int upperBound,Arena* out,Time MAX_CLIQUE_TIME){
-  CliqueState state = {};
-  state.table = PushArray<int>(out,graph.nodes.size);
-  state.clique = Copy(graph,out); // Preserve nodes and edges, but allocates different valid nodes
+// Lock must be held.
+static void FinishVertex(ParallelCliqueState* state,CliqueJob* job){
+  // Pruned cliques are never bigger than the incumbent, which makes the incumbent size a valid bound.
+  int best = std::max(job->best,CliqueKeySize(AtomicLoad(&state->incumbent)));
+
+  state->best[job->vertex] = best;
+  job->vertex = -1;
+  state->jobsOpen -= 1;
+
+  // Extend the table while every vertex after the start is finished.
+  int start = state->tableStart;
+  while(start > 0 && state->best[start - 1] >= 0){
+    int next = (start < state->graph.nodes.size ? state->table[start] : 0);
+    state->table[start - 1] = std::max(state->best[start - 1],next);
+    start -= 1;
+  }
+  AtomicStore(&state->tableStart,start);
+}
 
-  graph.validNodes.Fill(0);
+// Lock must be held. Returns the job that the worker must perform or nullptr if no work is currently available.
+static CliqueJob* GetCliqueTask(CliqueWorker* worker,BitArray* subset,int* subsetNum){
+  ParallelCliqueState* state = worker->state;
 
-  state.start = GetTime();
-  for(int i = graph.nodes.size - 1; i >= 0; i--){
-    BLOCK_REGION(out);
+  while(1){
+    if(AtomicLoad(&state->timeout)){
+      // Stop handing out work, the jobs finish as soon as the outstanding children finish
+      for(CliqueJob& job : state->jobs){
+        if(job.vertex >= 0){
+          job.childsLeft = 0;
+
+          if(job.outstanding == 0){
+            FinishVertex(state,&job);
+          }
+        }
+      }
+      return nullptr;
+    }
+    
+    // Biggest vertex first, since that is the order that gives better bounds.
+    CliqueJob* job = nullptr;
+    for(CliqueJob& possible : state->jobs){
+      if(possible.vertex >= 0 && possible.childsLeft > 0 && (job == nullptr || possible.vertex > job->vertex)){
+        job = &possible;
+      }
+    }
 
-    state.found = false;
-    for(int j = i; j < graph.nodes.size; j++){
-      graph.validNodes.Set(j,1);
+    if(job){
+      int child = job->candidates.FirstBitSetIndex(job->nextChild);
+
+      // Children are handed out in increasing order, which gives decreasing keys.
+      // If this child cannot improve the incumbent, the remaining children cannot either.
+      worker->vertex = job->vertex;
+      worker->child = child;
+      int bound = ValidTableBound(state,job->vertex + 1);
+      if(bound != INT_MAX && !CanImprove(worker,bound + 1)){
+        job->childsLeft = 0;
+        if(job->outstanding == 0){
+          FinishVertex(state,job);
+        }
+        continue;
+      }
+      
+      job->candidates.Set(child,0);
+      job->nextChild = child;
+      job->childsLeft -= 1;
+      job->outstanding += 1;
+
+      // Same subset that the serial search would use for this child.
+      *subsetNum = IntersectNeighbors(&state->graph,child,subset,&job->candidates);
+
+      return job;
     }
 
-    graph.validNodes &= graph.edges[i];
+    if(state->nextVertex < 0){
+      return nullptr;
+    }
 
-    IndexRecord record = {};
-    record.index = i;
+    CliqueJob* free = nullptr;
+    for(CliqueJob& possible : state->jobs){
+      if(possible.vertex < 0){
+        free = &possible;
+        break;
+      }
+    }
+    if(!free){
+      return nullptr;
+    }
 
-    Clique(&state,graph,i,&record,1,out,MAX_CLIQUE_TIME);
-    state.table[i] = state.max;
+    int vertex = state->nextVertex;
+    state->nextVertex -= 1;
 
-    if(state.max == upperBound){
-      break;
+    free->vertex = vertex;
+    free->best = 0;
+    free->outstanding = 0;
+    free->nextChild = vertex;
+    state->jobsOpen += 1;
+
+    // A clique starting at vertex is at most one bigger than the cliques starting at vertex + 1.
+    int bound = ValidTableBound(state,vertex + 1);
+    if(bound == INT_MAX){
+      bound = state->graph.nodes.size;
+    }
+    worker->vertex = vertex;
+    worker->child = 0;
+    if(!CanImprove(worker,bound + 1)){
+      FinishVertex(state,free);
+      continue;
+    }
+    
+    free->candidates.Fill(0);
+    for(int j = vertex + 1; j < state->graph.nodes.size; j++){
+      free->candidates.Set(j,1);
+    }
+    free->childsLeft = IntersectNeighbors(&state->graph,vertex,&free->candidates,&free->candidates);
+
+    if(free->childsLeft == 0){
+      IndexRecord record = {};
+      record.index = vertex;
+      RecordClique(worker,1,&record);
+      free->best = 1;
+      FinishVertex(state,free);
     }
+  }
+}
+
+static void ParallelCliqueTask(int id,void* args){
+  CliqueWorker* worker = (CliqueWorker*) args;
+  ParallelCliqueState* state = worker->state;
+
+  BitArray subset = {};
+  subset.Init(&worker->arena,state->graph.nodes.size);
+
+  while(1){
+    LockMutex(&state->lock);
+    int subsetNum = 0;
+    CliqueJob* job = GetCliqueTask(worker,&subset,&subsetNum);
+    bool finished = (job == nullptr && state->jobsOpen == 0);
+    UnlockMutex(&state->lock);
 
-    auto end = GetTime();
-    Time elapsed = end - state.start;
-    if(elapsed > MAX_CLIQUE_TIME){
+    if(finished){
       break;
     }
+    if(!job){
+      // Other workers are still processing the last children. Their results are needed to open more vertices
+      sched_yield();
+      continue;
+    }
+
+    IndexRecord vertexRecord = {};
+    vertexRecord.index = worker->vertex;
+    IndexRecord childRecord = {};
+    childRecord.index = worker->child;
+    childRecord.next = &vertexRecord;
+
+    worker->found = false;
+    u64 keyBefore = worker->bestKey;
+    
+    auto mark = MarkArena(&worker->arena);
+    ParallelClique(worker,subset,subsetNum,worker->child,&childRecord,2);
+    PopMark(mark);
+
+    LockMutex(&state->lock);
+    if(worker->bestKey != keyBefore){
+      job->best = std::max(job->best,CliqueKeySize(worker->bestKey));
+    }
+    job->outstanding -= 1;
+    if(job->childsLeft == 0 && job->outstanding == 0){
+      FinishVertex(state,job);
+    }
+    UnlockMutex(&state->lock);
   }
+}
 
-  Assert(IsClique(state.clique).result);
+CliqueState ParallelMaxClique(ConsolidationGraph graph,int upperBound,Arena* out,Time MAX_CLIQUE_TIME,float gapTarget){
+  CliqueState res = {};
+  res.table = PushArray<int>(out,graph.nodes.size);
+  res.clique = Copy(graph,out);
+  res.clique.validNodes.Fill(0);
+  res.start = GetTime();
 
-  return state;
+  int size = graph.nodes.size;
+  Assert(size < (int) CLIQUE_KEY_MASK);
+  if(size == 0){
+    return res;
+  }
+  
+  int threads = NumberThreads() + 1; // Main thread also works
+
+  auto mark = MarkArena(out);
+  
+  region(out){
+    Array<int> bound = PushArray<int>(out,size);
+    graph.validNodes.Fill(1);
+    res.colors = ColoringBound(&graph,&graph.validNodes,size,bound.data,out);
+  }
+  
+  ParallelCliqueState state = {};
+  state.graph = graph;
+  state.upperBound = std::min(std::min(upperBound,size),res.colors);
+  state.start = res.start;
+  state.lastReport = res.start;
+  state.maxTime = MAX_CLIQUE_TIME;
+  state.gapTarget = gapTarget;
+  state.nextVertex = size - 1;
+  state.tableStart = size;
+  state.table = res.table;
+  InitMutex(&state.lock);
+  
+  state.best = PushArray<int>(out,size);
+  Memset(state.best,-1);
+
+  state.jobs = PushArray<CliqueJob>(out,threads * 2);
+  for(CliqueJob& job : state.jobs){
+    job.vertex = -1;
+    job.candidates.Init(out,size);
+  }
+
+  state.workers = PushArray<CliqueWorker>(out,threads);
+  for(CliqueWorker& worker : state.workers){
+    worker.state = &state;
+    worker.clique.Init(out,size);
+    worker.clique.Fill(0);
+  }
+
+  // Each worker gets a part of the remaining memory for the recursion
+  size_t workerMemory = SpaceAvailable(out) / (threads + 1);
+  for(CliqueWorker& worker : state.workers){
+    worker.arena = SubArena(out,workerMemory);
+  }
+  
+  // Main thread works as worker zero while the pool handles the others.
+  WorkGroup* work = PushWorkGroup(out,threads - 1);
+  for(int i = 0; i < work->tasks.size; i++){
+    work->tasks[i].function = ParallelCliqueTask;
+    work->tasks[i].args = &state.workers[i + 1];
+    AddTask(work->tasks[i]);
+  }
+  ParallelCliqueTask(0,&state.workers[0]);
+  WaitCompletion();
+  
+  for(CliqueWorker& worker : state.workers){
+    res.iterations += worker.iterations;
+
+    if(worker.bestKey != 0 && worker.bestKey == state.incumbent){
+      res.clique.validNodes.Copy(worker.clique);
+    }
+  }
+  res.max = CliqueKeySize(state.incumbent);
+  res.found = true;
+
+  int tableBound = (state.tableStart < size) ? state.table[state.tableStart] : 0;
+  res.upperBound = std::max(std::min(state.upperBound,tableBound + state.tableStart),res.max);
+  
+  PopMark(mark);
+
+  if(res.upperBound > res.max){
+    printf("Clique search stopped at %d (upper bound %d, gap %.2f%%). Result might not be optimal\n",res.max,res.upperBound,CliqueGap(res.max,res.upperBound) * 100.0f);
+  }
+  
+  Assert(IsClique(res.clique).result);
+  
+  return res;
 }
 
 void OutputConsolidationGraph(ConsolidationGraph graph,bool onlyOutputValid,String moduleName,String fileName){
@@ -645,11 +1646,11 @@ void OutputConsolidationGraph(ConsolidationGraph graph,bool onlyOutputValid,Stri
     }
 
     MappingNode* node1 = &graph.nodes[i];
-    for(int ii = i + 1; ii < graph.edges.size; ii++){
+    for(int ii = i + 1; ii < graph.nodes.size; ii++){
       if(!graph.validNodes.Get(ii)){
         continue;
       }
-      if(!graph.edges[i].Get(ii)){
+      if(!IsNeighbor(&graph,i,ii)){
         continue;
       }
 
@@ -693,11 +1694,11 @@ void DebugRegionOutputConsolidationGraph(ConsolidationGraph graph,String name,bo
     }
 
     MappingNode* node1 = &graph.nodes[i];
-    for(int ii = i + 1; ii < graph.edges.size; ii++){
+    for(int ii = i + 1; ii < graph.nodes.size; ii++){
       if(!graph.validNodes.Get(ii)){
         continue;
       }
-      if(!graph.edges[i].Get(ii)){
+      if(!IsNeighbor(&graph,i,ii)){
         continue;
       }
 
@@ -764,6 +1765,67 @@ GraphMapping InitGraphMapping(Arena* out){
   return mapping;
 }
 
+// Times the intersection kernels and the full clique search for every kernel level supported by the cpu.
+static void BenchmarkConsolidationGraph(ConsolidationGraph graph,int upperBound,Arena* temp){
+  BLOCK_REGION(temp);
+
+  int size = graph.nodes.size;
+
+  BitArray valid = {};
+  valid.Init(temp,size);
+  valid.Fill(1);
+  BitArray result = {};
+  result.Init(temp,size);
+
+  // Each row is intersected with every other row, same operation as a level of the clique search.
+  int rows = std::min(size,256);
+  
+  // Reference byte at a time implementation, the one used before the kernels. Only meaningful for the bit matrix.
+  if(graph.edges.size){
+    Time start = GetTime();
+    i64 total = 0;
+    for(int i = 0; i < rows; i++){
+      for(int j = 0; j < size; j++){
+        for(int k = 0; k < result.byteSize; k++){
+          result.memory[k] = graph.edges[i].memory[k] & graph.edges[j].memory[k];
+        }
+        total += result.GetNumberBitsSet();
+      }
+    }
+    double seconds = ElapsedSeconds(start);
+    printf("  %-8s intersect+count: %8.2f ns/row (%ld)\n","Bytes",(seconds * 1e9) / ((double) rows * size),total);
+  }
+  
+  BitKernelLevel original = GetBitKernelLevel();
+  for(int level = 0; level <= BestBitKernelLevel(); level++){
+    SetBitKernelLevel((BitKernelLevel) level);
+    const char* name = BitKernelLevelName((BitKernelLevel) level);
+    
+    Time start = GetTime();
+    i64 total = 0;
+    for(int i = 0; i < rows; i++){
+      for(int j = 0; j < size; j++){
+        if(graph.edges.size){
+          total += result.CopyIntersectAndCount(graph.edges[i],graph.edges[j]);
+        } else {
+          total += IntersectNeighbors(&graph,j,&result,&valid);
+        }
+      }
+    }
+    double seconds = ElapsedSeconds(start);
+    printf("  %-8s intersect+count: %8.2f ns/row (%ld)\n",name,(seconds * 1e9) / ((double) rows * size),total);
+
+    region(temp){
+      ConsolidationGraph copy = Copy(graph,temp);
+      start = GetTime();
+      CliqueState state = MaxClique(copy,upperBound,temp,Seconds(globalOptions.cliqueTime));
+      seconds = ElapsedSeconds(start);
+      printf("  %-8s max clique: %d in %.4fs (%d iterations)\n",name,state.max,seconds,state.iterations);
+    }
+  }
+  SetBitKernelLevel(original);
+}
+
 GraphMapping ConsolidationGraphMapping(Accelerator* accel1,Accelerator* accel2,ConsolidationGraphOptions options,Arena* out){
   TEMP_REGION(temp,out);
 
@@ -801,7 +1863,18 @@ GraphMapping ConsolidationGraphMapping(Accelerator* accel1,Accelerator* accel2,C
     
   int upperBound = result.upperBound;
   upperBound = INT_MAX; // TODO: Upperbound not working correctly.
-  ConsolidationGraph clique = MaxClique(graph,upperBound,temp,Seconds(10)).clique;
+  if(globalOptions.benchmarkClique){
+    BenchmarkConsolidationGraph(graph,upperBound,temp);
+  }
+  
+  CliqueState state = {};
+  // Merges instantiated in parallel already occupy the pool
+  if(globalOptions.parallelClique && !InsideTask()){
+    state = ParallelMaxClique(graph,upperBound,temp,Seconds(globalOptions.cliqueTime),globalOptions.cliqueGap / 100.0f);
+  } else {
+    state = MaxClique(graph,upperBound,temp,Seconds(globalOptions.cliqueTime),globalOptions.cliqueGap / 100.0f);
+  }
+  ConsolidationGraph clique = state.clique;
 
   DebugRegionOutputConsolidationGraph(clique,"Clique");
   AddCliqueToMapping(res,clique);
@@ -1026,6 +2099,293 @@ static GraphMapping CalculateMergeMapping(Accelerator* accel1,Accelerator* accel
   return graphMapping;
 }
 
+// ============================================================================
+// Merge cache
+
+/*
+  The mapping calculated for each merge step is stored on disk and keyed by a hash of everything it depends on.
+  Instances are stored as indexes into the allocated list of each accelerator, which only change if the hash changes.
+  The mapping is inserted back in the same order that it was stored, which means that the merge sees the exact same GraphMapping.
+*/
+
+#define MERGE_CACHE_VERSION 1
+
+static Array<FUInstance*> IndexInstances(Accelerator* accel,Arena* out){
+  auto arr = StartArray<FUInstance*>(out);
+  for(FUInstance* inst : accel->allocated){
+    *arr.PushElem() = inst;
+  }
+  return EndArray(arr);
+}
+
+static Hashmap<FUInstance*,int>* InstanceToIndex(Array<FUInstance*> instances,Arena* out){
+  Hashmap<FUInstance*,int>* res = PushHashmap<FUInstance*,int>(out,instances.size);
+  for(int i = 0; i < instances.size; i++){
+    res->Insert(instances[i],i);
+  }
+  return res;
+}
+
+static u64 HashAccelerator(Accelerator* accel,u64 hash){
+  TEMP_REGION(temp,nullptr);
+
+  Array<FUInstance*> instances = IndexInstances(accel,temp);
+  Hashmap<FUInstance*,int>* toIndex = InstanceToIndex(instances,temp);
+
+  hash = StableHashInt(instances.size,hash);
+  for(FUInstance* inst : instances){
+    hash = StableHashString(inst->name,hash);
+    hash = StableHashString(inst->declaration->name,hash);
+    hash = StableHashInt(inst->portIndex,hash);
+    hash = StableHashInt(NodeConflict(inst),hash);
+
+    FOREACH_LIST(ConnectionNode*,con,inst->allOutputs){
+      hash = StableHashInt(con->port,hash);
+      hash = StableHashInt(toIndex->GetOrFail(con->instConnectedTo.inst),hash);
+      hash = StableHashInt(con->instConnectedTo.port,hash);
+      hash = StableHashInt(con->edgeDelay,hash);
+    }
+  }
+  
+  return hash;
+}
+
+// Must contain every input of CalculateMergeMapping and nothing else
+static u64 MergeMappingKey(Accelerator* accel1,Accelerator* accel2,MergingStrategy strategy){
+  u64 hash = StableHashInt(MERGE_CACHE_VERSION);
+
+  hash = HashAccelerator(accel1,hash);
+  hash = HashAccelerator(accel2,hash);
+
+  hash = StableHashInt((int) strategy,hash);
+
+  // A search that stops early can find a different mapping
+  hash = StableHashInt(globalOptions.cliqueTime,hash);
+  hash = StableHashBytes(&globalOptions.cliqueGap,sizeof(float),hash);
+
+  return hash;
+}
+
+static String MergeCacheFilepath(u64 key,Arena* out){
+  return PushString(out,"%.*s/merge_%016lx.txt",UN(globalOptions.cachePath),key);
+}
+
+static void StoreMergeMapping(u64 key,GraphMapping& mapping,Accelerator* accel1,Accelerator* accel2){
+  TEMP_REGION(temp,nullptr);
+
+  Hashmap<FUInstance*,int>* index1 = InstanceToIndex(IndexInstances(accel1,temp),temp);
+  Hashmap<FUInstance*,int>* index2 = InstanceToIndex(IndexInstances(accel2,temp),temp);
+
+  CacheFile cache = OpenCacheFile(MergeCacheFilepath(key,temp),temp);
+  FILE* file = cache.file;
+  if(!file){
+    return;
+  }
+
+  // Instance map goes from accel2 to accel1
+  fprintf(file,"VersatMergeCache %d\n",MERGE_CACHE_VERSION);
+  fprintf(file,"instances %d\n",mapping.instanceMap->nodesUsed);
+  for(Pair<FUInstance*,FUInstance**> pair : mapping.instanceMap){
+    fprintf(file,"%d %d\n",index2->GetOrFail(pair.first),index1->GetOrFail(*pair.second));
+  }
+
+  fprintf(file,"edges %d\n",mapping.edgeMap->nodesUsed);
+  for(Pair<Edge,Edge*> pair : mapping.edgeMap){
+    Edge e2 = pair.first;
+    Edge e1 = *pair.second;
+    fprintf(file,"%d %d %d %d %d ",index2->GetOrFail(e2.out.inst),e2.out.port,index2->GetOrFail(e2.in.inst),e2.in.port,e2.delay);
+    fprintf(file,"%d %d %d %d %d\n",index1->GetOrFail(e1.out.inst),e1.out.port,index1->GetOrFail(e1.in.inst),e1.in.port,e1.delay);
+  }
+
+  CommitCacheFile(cache);
+}
+
+// Returns an empty optional if there is no entry or the entry does not make sense for the accelerators
+static Opt<GraphMapping> LoadMergeMapping(u64 key,Accelerator* accel1,Accelerator* accel2,Arena* out){
+  TEMP_REGION(temp,out);
+
+  String filepath = MergeCacheFilepath(key,temp);
+  FILE* file = OpenFile(filepath,"r",FilePurpose_CACHE);
+  if(!file){
+    return {};
+  }
+  DEFER_CLOSE_FILE(file);
+
+  String content = PushFile(temp,file);
+  PushNullByte(temp);
+
+  Array<FUInstance*> instances1 = IndexInstances(accel1,temp);
+  Array<FUInstance*> instances2 = IndexInstances(accel2,temp);
+
+  CacheReader reader = StartCacheReader(content);
+  
+  auto GetInstance = [&](Array<FUInstance*> instances) -> FUInstance*{
+    int index = CacheReadInt(&reader);
+    if(reader.error || index < 0 || index >= instances.size){
+      reader.error = true;
+      return nullptr;
+    }
+    return instances[index];
+  };
+  auto GetEdge = [&](Array<FUInstance*> instances) -> Edge{
+    Edge edge = {};
+    edge.out.inst = GetInstance(instances);
+    edge.out.port = CacheReadInt(&reader);
+    edge.in.inst = GetInstance(instances);
+    edge.in.port = CacheReadInt(&reader);
+    edge.delay = CacheReadInt(&reader);
+    return edge;
+  };
+  
+  GraphMapping res = InitGraphMapping(out);
+
+  CacheReadWord(&reader,"VersatMergeCache");
+  if(CacheReadInt(&reader) != MERGE_CACHE_VERSION){
+    return {};
+  }
+  
+  CacheReadWord(&reader,"instances");
+  int amount = CacheReadInt(&reader);
+  for(int i = 0; i < amount && !reader.error; i++){
+    FUInstance* inst2 = GetInstance(instances2);
+    FUInstance* inst1 = GetInstance(instances1);
+
+    if(reader.error || inst1->declaration != inst2->declaration){
+      return {};
+    }
+    
+    InsertMapping(res,inst2,inst1);
+  }
+
+  CacheReadWord(&reader,"edges");
+  amount = CacheReadInt(&reader);
+  for(int i = 0; i < amount && !reader.error; i++){
+    Edge edge2 = GetEdge(instances2);
+    Edge edge1 = GetEdge(instances1);
+
+    if(reader.error){
+      return {};
+    }
+    
+    res.edgeMap->Insert(edge2,edge1);
+  }
+
+  if(reader.error){
+    return {};
+  }
+  
+  return res;
+}
+
+// CalculateMergeMapping without specific nodes, but reuses the result of previous runs if possible.
+static GraphMapping CachedMergeMapping(Accelerator* accel1,Accelerator* accel2,MergingStrategy strategy,Arena* out){
+  if(globalOptions.disableCache){
+    return CalculateMergeMapping(accel1,accel2,{},strategy,out);
+  }
+  
+  u64 key = MergeMappingKey(accel1,accel2,strategy);
+
+  Opt<GraphMapping> cached = LoadMergeMapping(key,accel1,accel2,out);
+  if(cached.has_value()){
+    return cached.value();
+  }
+
+  GraphMapping res = CalculateMergeMapping(accel1,accel2,{},strategy,out);
+  StoreMergeMapping(key,res,accel1,accel2);
+  
+  return res;
+}
+
+// Input feeding both ports of a single operator that feeds the output. Different operators give accelerators that cannot share a mapping
+static Accelerator* TestMergeCacheAccelerator(String name,String operatorName,int delay){
+  Accelerator* accel = CreateAccelerator(name,AcceleratorPurpose_TEMP);
+
+  FUInstance* input = CreateFUInstance(accel,BasicDeclaration::input,"in");
+  FUInstance* op = CreateFUInstance(accel,GetTypeByNameOrFail(operatorName),"op");
+  FUInstance* output = CreateFUInstance(accel,BasicDeclaration::output,"out");
+
+  ConnectUnits(input,0,op,0,delay);
+  ConnectUnits(input,0,op,1);
+  ConnectUnits(op,0,output,0);
+
+  return accel;
+}
+
+int TestMergeCache(){
+  TEMP_REGION(temp,nullptr);
+  int failed = 0;
+
+  String savedCachePath = globalOptions.cachePath;
+  globalOptions.cachePath = CreateTemporaryDirectory("versat_merge_cache_test",temp);
+
+  Accelerator* accel1 = TestMergeCacheAccelerator("A","ADD",0);
+  Accelerator* accel2 = TestMergeCacheAccelerator("B","ADD",0);
+
+  Array<FUInstance*> instances1 = IndexInstances(accel1,temp);
+  Array<FUInstance*> instances2 = IndexInstances(accel2,temp);
+
+  GraphMapping mapping = InitGraphMapping(temp);
+  for(int i = 0; i < instances1.size; i++){
+    InsertMapping(mapping,instances2[i],instances1[i]);
+  }
+
+  Edge edge1 = {};
+  edge1.out = {instances1[0],0};
+  edge1.in = {instances1[1],0};
+  Edge edge2 = {};
+  edge2.out = {instances2[0],0};
+  edge2.in = {instances2[1],0};
+  mapping.edgeMap->Insert(edge2,edge1);
+
+  u64 key = MergeMappingKey(accel1,accel2,CONSOLIDATION_GRAPH);
+  StoreMergeMapping(key,mapping,accel1,accel2);
+
+  // Stored mapping comes back unchanged
+  Opt<GraphMapping> loaded = LoadMergeMapping(key,accel1,accel2,temp);
+  TEST_CHECK(failed,loaded.has_value());
+  if(loaded.has_value()){
+    GraphMapping res = loaded.value();
+    TEST_CHECK(failed,res.instanceMap->nodesUsed == instances1.size);
+    for(int i = 0; i < instances1.size; i++){
+      FUInstance** mapped = res.instanceMap->Get(instances2[i]);
+      TEST_CHECK(failed,mapped && *mapped == instances1[i]);
+    }
+
+    Edge* mappedEdge = res.edgeMap->Get(edge2);
+    TEST_CHECK(failed,res.edgeMap->nodesUsed == 1);
+    TEST_CHECK(failed,mappedEdge && mappedEdge->out.inst == edge1.out.inst && mappedEdge->in.inst == edge1.in.inst);
+  }
+
+  // Only the entry remains, the temporary file was renamed over it
+  Opt<Array<String>> files = GetAllFilesInsideDirectory(globalOptions.cachePath,temp);
+  TEST_CHECK(failed,files.has_value() && files.value().size == 1);
+
+  // Every input of the mapping calculation is part of the key
+  Accelerator* delayed = TestMergeCacheAccelerator("C","ADD",1);
+  Accelerator* other = TestMergeCacheAccelerator("D","SUB",0);
+  TEST_CHECK(failed,MergeMappingKey(accel1,accel2,CONSOLIDATION_GRAPH) == key);
+  TEST_CHECK(failed,MergeMappingKey(accel1,delayed,CONSOLIDATION_GRAPH) != key);
+  TEST_CHECK(failed,MergeMappingKey(accel1,other,CONSOLIDATION_GRAPH) != key);
+  TEST_CHECK(failed,MergeMappingKey(accel1,accel2,FIRST_FIT) != key);
+  TEST_CHECK(failed,!LoadMergeMapping(MergeMappingKey(accel1,other,CONSOLIDATION_GRAPH),accel1,other,temp).has_value());
+
+  // An entry that maps units of different types is rejected
+  TEST_CHECK(failed,!LoadMergeMapping(key,accel1,other,temp).has_value());
+
+  // So is a damaged entry
+  FILE* file = fopen(CS(MergeCacheFilepath(key,temp)),"w");
+  if(file){
+    fprintf(file,"VersatMergeCache %d\ninstances 3\n0 0\n1",MERGE_CACHE_VERSION);
+    fclose(file);
+  }
+  TEST_CHECK(failed,!LoadMergeMapping(key,accel1,accel2,temp).has_value());
+
+  RemoveDirectory(globalOptions.cachePath);
+  globalOptions.cachePath = savedCachePath;
+
+  return failed;
+}
+
 String GetFreeMergeMultiplexerName(Accelerator* accel,Arena* out){
   auto mark = MarkArena(out);
 
@@ -2058,7 +3418,7 @@ FUDeclaration* Merge(Array<FUDeclaration*> types,
       // TODO: Need to see if we actually need reconOrder here or not.
       //       After previous changes, we might get away with only calculating it on the spot. Need to check this.
       reconOrder[i] = CalculateDAGOrder(accel,temp);
-      reconDelay[i] = CalculateDelay(accel,temp);
+      reconDelay[i] = CalculateDelay(accel,temp,false);
       
       Array<DelayToAdd> delaysToAdd = GenerateFixDelays(accel,reconDelay[i].edgesDelay,globalPermanent);
       for(DelayToAdd toAdd : delaysToAdd){
@@ -2153,13 +3513,14 @@ FUDeclaration* Merge(Array<FUDeclaration*> types,
     }
     decl->info.infos[i].name = EndString(globalPermanent,builder);
     
-    decl->info.infos[i].info = GenerateInitialInstanceInfo(decl->fixedDelayCircuit,globalPermanent,{},oldDelayCalc);
+    GenerateInitialInstanceInfo(&decl->info.infos[i],decl->fixedDelayCircuit,globalPermanent,{},oldDelayCalc);
     AccelInfoIterator iter = StartIteration(&decl->info);
     iter.SetMergeIndex(i);
     iter.accelName = decl->info.infos[i].name;
     FillInstanceInfo(iter,globalPermanent);
     
     Array<InstanceInfo*> instanceInfos = GetAllSameLevelUnits(&decl->info,0,i,temp);
+    InstanceInfoTable* table = iter.GetCurrentTable();
     
     AcceleratorMapping* mergedAccelToRecon = MappingInvert(reconToMergedAccel[i],globalPermanent);
     
@@ -2174,10 +3535,10 @@ FUDeclaration* Merge(Array<FUDeclaration*> types,
 
       if(reconNode){
         instance->baseNodeDelay = reconDelay[i].nodeDelay->GetOrFail(reconNode).value;
-        instance->localOrder = reconToOrder[i]->GetOrFail(reconNode);
+        table->localOrder[iter.GetIndex(instance)] = reconToOrder[i]->GetOrFail(reconNode);
       } else {
         instance->baseNodeDelay = 0; // NOTE: Even if they do not belong, this delay is directly inserted into the header file, meaning that for now it's better if we keep everything at zero.
-        instance->localOrder = 0;
+        table->localOrder[iter.GetIndex(instance)] = 0;
       }
 
       // These map directly from the merged accelerator into the flattenedBaseType per type used.
@@ -2666,7 +4027,7 @@ FUDeclaration* Merge2(Array<FUDeclaration*> types,
     if(modifier & MergeModifier_NO_UNIT_MERGED){
       map = InitGraphMapping(temp); // Empty map
     } else { 
-      map = CalculateMergeMapping(merged->mergedGraph,flatten[i],{},strat,temp);
+      map = CachedMergeMapping(merged->mergedGraph,flatten[i],strat,temp);
     }
 
     Accelerator* recon = merged->recons[i];
@@ -2842,6 +4203,7 @@ FUDeclaration* Merge2(Array<FUDeclaration*> types,
   Array<DAGOrderNodes> reconOrder = PushArray<DAGOrderNodes>(temp,size);
   Array<CalculateDelayResult> reconDelay = PushArray<CalculateDelayResult>(temp,size);
 
+  int buffersAdded = 0;
   while(true){
     bool insertedBuffer = false;
     for(int i = 0; i < size; i++){
@@ -2850,7 +4212,7 @@ FUDeclaration* Merge2(Array<FUDeclaration*> types,
       // TODO: Need to see if we actually need reconOrder here or not.
       //       After previous changes, we might get away with only calculating it on the spot. Need to check this.
       reconOrder[i] = CalculateDAGOrder(recon,temp);
-      reconDelay[i] = CalculateDelay(recon,temp);
+      reconDelay[i] = CalculateDelay(recon,temp,false);
       
       Array<DelayToAdd> delaysToAdd = GenerateFixDelays(recon,reconDelay[i].edgesDelay,globalPermanent);
 
@@ -2860,8 +4222,7 @@ FUDeclaration* Merge2(Array<FUDeclaration*> types,
       for(DelayToAdd toAdd : delaysToAdd){
         insertedBuffer = true;
         
-        static int added = 0;
-        String uniqueName = PushString(globalPermanent,"%.*s_%d_%d",UN(toAdd.bufferName),i,added++);
+        String uniqueName = PushString(globalPermanent,"%.*s_%d_%d",UN(toAdd.bufferName),i,buffersAdded++);
 
         Edge mergedEdge = MapReconEdgeToMerged(merged,toAdd.edge,i);
         
@@ -2930,7 +4291,7 @@ FUDeclaration* Merge2(Array<FUDeclaration*> types,
     decl->info.infos[i].recon = merged->recons[i];
     decl->info.infos[i].name  = types[i]->name;
 
-    decl->info.infos[i].info = GenerateInitialInstanceInfo(mergedGraph,globalPermanent,{},false);
+    GenerateInitialInstanceInfo(&decl->info.infos[i],mergedGraph,globalPermanent,{},false);
 
     AccelInfoIterator iter = StartIteration(&decl->info);
     iter.SetMergeIndex(i);
@@ -2963,7 +4324,7 @@ FUDeclaration* Merge2(Array<FUDeclaration*> types,
         }
         
         info->baseNodeDelay = reconDelay[i].nodeDelay->GetOrFail(reconInst).value;
-        info->localOrder = reconToOrder[i]->GetOrFail(reconInst);
+        iter.GetCurrentTable()->localOrder[iter.index] = reconToOrder[i]->GetOrFail(reconInst);
         info->addressGenUsed = reconInst->addressGenUsed;
       } else {
         // TODO: In theory we would like for this to work but some code relies on the inst always existing.
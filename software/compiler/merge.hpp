@@ -92,7 +92,13 @@ struct ConsolidationGraphOptions{
 
 struct ConsolidationGraph{
   Array<MappingNode> nodes;
-  Array<BitArray> edges;
+
+  // Adjacency is either a bit matrix (edges) or, when the matrix would use too much memory, a sorted list of indexes per node.
+  // The lists contain the neighbors of the node or, if complement is set, the nodes that are not neighbors.
+  Array<BitArray> edges; // Empty if using lists
+  Array<int> listOffsets; // nodes.size + 1 entries, list of node i is [listOffsets[i],listOffsets[i+1])
+  Array<int> listIndexes;
+  bool complement;
 
   BitArray validNodes;
 };
@@ -105,13 +111,20 @@ struct ConsolidationResult{
 
 struct CliqueState{
   int max;
-  int upperBound;
+  int upperBound; // Proven bound on the size of the max clique
   int startI;
   int iterations;
   Array<int> table;
   ConsolidationGraph clique;
   Time start;
   bool found;
+
+  // Anytime search. The search stops once the time limit or the gap target is reached 
+  int colors; // Number of colors of a greedy coloring of the whole graph
+  float gapTarget;
+  Time maxTime; // Zero means no limit
+  Time lastReport;
+  bool stop;
 };
 
 struct OverheadCount{
@@ -197,7 +210,8 @@ bool MappingConflict(MappingNode map1,MappingNode map2);
 ConsolidationGraph Copy(ConsolidationGraph graph,Arena* out);
 
 bool MappingConflict(MappingNode map1,MappingNode map2);
-CliqueState MaxClique(ConsolidationGraph graph,int upperBound,Arena* out,float MAX_CLIQUE_TIME);
+// Gap target is a fraction, the search stops once (upper bound - max) / upper bound <= gapTarget. MAX_CLIQUE_TIME of zero means no limit
+CliqueState MaxClique(ConsolidationGraph graph,int upperBound,Arena* out,Time MAX_CLIQUE_TIME,float gapTarget = 0.0f);
 ConsolidationGraph GenerateConsolidationGraph(Arena* out,Accelerator* accel1,Accelerator* accel2,ConsolidationGraphOptions options,MergingStrategy strategy);
 
 MergeGraphResult HierarchicalHeuristic(FUDeclaration* decl1,FUDeclaration* decl2,String name);
@@ -206,10 +220,18 @@ BitArray* CalculateNeighborsTable(ConsolidationGraph graph,Arena* out);
 
 IsCliqueResult IsClique(ConsolidationGraph graph);
 
-ConsolidationGraph ParallelMaxClique(ConsolidationGraph graph,int upperBound,Arena* out,float MAX_CLIQUE_TIME);
+bool IsNeighbor(ConsolidationGraph* graph,int node0,int node1);
+
+// out = in & neighbors(node). Returns the number of bits set in out. Out and in can be the same array.
+int IntersectNeighbors(ConsolidationGraph* graph,int node,BitArray* out,BitArray* in);
+
+// Same result as MaxClique (when both run to completion) but uses every thread of the pool.
+CliqueState ParallelMaxClique(ConsolidationGraph graph,int upperBound,Arena* out,Time MAX_CLIQUE_TIME,float gapTarget = 0.0f);
 
 String MappingNodeIdentifier(MappingNode* node,Arena* memory);
 MergeGraphResult HierarchicalMergeAccelerators(Accelerator* accel1,Accelerator* accel2,String name);
+
+int TestMergeCache();
 MergeGraphResult HierarchicalMergeAcceleratorsFullClique(Accelerator* accel1,Accelerator* accel2,String name);
 
 FUDeclaration* MergeAccelerators(FUDeclaration* accel1,FUDeclaration* accel2,String name,int flatteningOrder = 99,MergingStrategy strategy = MergingStrategy::CONSOLIDATION_GRAPH,SpecificMerge* specifics = nullptr,int nSpecifics = 0);
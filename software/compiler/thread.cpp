@@ -7,12 +7,13 @@
 #include "utils.hpp"
 
 static pthread_mutex_t poolMutex;
+static pthread_cond_t completionCond;
 static sem_t poolSemaphore;
 static pthread_t threads[64]; // Limit to 64, for now
 static int numberThreads;
 
-inline void LockMutex(){pthread_mutex_lock(&poolMutex);}
-inline void UnlockMutex(){pthread_mutex_unlock(&poolMutex);}
+inline void LockPool(){pthread_mutex_lock(&poolMutex);}
+inline void UnlockPool(){pthread_mutex_unlock(&poolMutex);}
 inline void IncSem(){sem_post(&poolSemaphore);}
 inline void DecSem(){sem_wait(&poolSemaphore);}
 
@@ -27,6 +28,8 @@ static bool stop;
 static int jobsAdded;
 static int jobsFinished;
 
+static thread_local bool insideTask;
+
 void* ThreadFunction(void* arg){
    union {
       void* ptr;
@@ -46,16 +49,21 @@ void* ThreadFunction(void* arg){
          break;
       }
 
-      LockMutex();
+      LockPool();
       Task task = tasks[taskRead];
       taskRead = (taskRead + 1) % MAX_TASKS;
-      UnlockMutex();
+      UnlockPool();
 
+      insideTask = true;
       task.function(id,task.args);
+      insideTask = false;
 
-      LockMutex();
-      jobsFinished += 1; // Should be an atomic increment
-      UnlockMutex();
+      LockPool();
+      jobsFinished += 1;
+      if(jobsFinished == jobsAdded){
+         pthread_cond_broadcast(&completionCond);
+      }
+      UnlockPool();
    }
 
    return nullptr;
@@ -75,6 +83,7 @@ void InitThreadPool(int nThreads){
 
    int res = 0;
    res |= pthread_mutex_init(&poolMutex,NULL);
+   res |= pthread_cond_init(&completionCond,NULL);
    res |= sem_init(&poolSemaphore,0,0);
 
    for(iptr i = 0; i < nThreads; i++){
@@ -85,9 +94,9 @@ void InitThreadPool(int nThreads){
 }
 
 bool FullTasks(){
-   LockMutex();
+   LockPool();
    bool full = ((taskWrite + 1) % MAX_TASKS == taskRead);
-   UnlockMutex();
+   UnlockPool();
    return full;
 }
 
@@ -96,18 +105,17 @@ void AddTask(Task task){
 
    MemoryBarrier();
 
-   LockMutex();
+   LockPool();
 
    Assert((taskWrite + 1) % MAX_TASKS != taskRead); // Could also have just a delay, waiting for more free space, but could lock if AddTask called by the tasks themselves
 
    tasks[taskWrite] = task;
    taskWrite = (taskWrite + 1) % MAX_TASKS;
+   jobsAdded += 1;
 
-   UnlockMutex();
+   UnlockPool();
 
    IncSem();
-
-   jobsAdded += 1;
 }
 
 int NumberThreads(){
@@ -115,28 +123,25 @@ int NumberThreads(){
 }
 
 void WaitCompletion(){
-   while(1){
-      LockMutex();
-      bool end = (jobsAdded == jobsFinished);
-      UnlockMutex();
-
-      if(end){
-         break;
-      } else {
-         //sleep(1);
-      }
+   LockPool();
+   while(jobsAdded != jobsFinished){
+      pthread_cond_wait(&completionCond,&poolMutex);
    }
+   UnlockPool();
+}
 
-   return;
+int NumberProcessors(){
+   int res = sysconf(_SC_NPROCESSORS_ONLN);
+   return std::max(res,1);
 }
 
 void TerminatePool(bool force){
    if(!force){
       // Wait for threads to terminate the remaining tasks
       while(1){
-         LockMutex();
+         LockPool();
          bool end = (taskWrite == taskRead);
-         UnlockMutex();
+         UnlockPool();
 
          if(end){
             break;
@@ -146,9 +151,9 @@ void TerminatePool(bool force){
       }
    }
 
-   LockMutex();
+   LockPool();
    stop = true;
-   UnlockMutex();
+   UnlockPool();
 
    for(int i = 0; i < numberThreads; i++){ // Make sure that threads can see the stop and get out
       IncSem();
@@ -165,3 +170,54 @@ WorkGroup* PushWorkGroup(Arena* out,int numberWork){
 
    return work;
 }
+
+void DoWork(WorkGroup* work){
+   for(Task& task : work->tasks){
+      if(task.function == nullptr){
+         task.function = work->function;
+      }
+      AddTask(task);
+   }
+
+   WaitCompletion();
+}
+
+void DoWorkAndParticipate(WorkGroup* work){
+   for(Task& task : work->tasks){
+      if(task.function == nullptr){
+         task.function = work->function;
+      }
+   }
+
+   for(int i = 1; i < work->tasks.size; i++){
+      AddTask(work->tasks[i]);
+   }
+
+   if(work->tasks.size > 0){
+      Task task = work->tasks[0];
+
+      // Calling thread uses the id after the last pool thread
+      insideTask = true;
+      task.function(numberThreads,task.args);
+      insideTask = false;
+   }
+   
+   WaitCompletion();
+}
+
+bool InsideTask(){
+   return insideTask;
+}
+
+void InitMutex(Mutex* mutex){
+   int res = pthread_mutex_init(&mutex->mutex,NULL);
+   Assert(res == 0);
+}
+
+void LockMutex(Mutex* mutex){
+   pthread_mutex_lock(&mutex->mutex);
+}
+
+void UnlockMutex(Mutex* mutex){
+   pthread_mutex_unlock(&mutex->mutex);
+}
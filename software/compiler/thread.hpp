@@ -1,11 +1,14 @@
 #pragma once
 
 /*
-  Most of this code was made in an attempt to accelerate max clique, but for the most part this is
-  mostly unused. Maybe in the future we might make use of this and for now we keep it as is.
+  Simple thread pool. Tasks are pushed into a fixed size ring buffer and picked by the first free thread.
 
+  Context arenas are thread local. Code that runs inside tasks can only use the TEMP_REGION macros after
+  setting the context arenas of the thread, otherwise each task should receive the arenas that it is allowed to use.
 */
 
+#include <pthread.h>
+
 #include "memory.hpp"
 
 typedef void (*TaskFunction)(int id,void* args);
@@ -28,13 +31,50 @@ void TerminatePool(bool force = false);
 
 void WaitCompletion();
 
+// Returns zero if the pool was not initialized.
 int NumberThreads();
 
+// Number of processors available in the machine.
+int NumberProcessors();
+
 bool FullTasks();
 void AddTask(Task task);
 
 WorkGroup* PushWorkGroup(Arena* out,int numberWork);
 
+// Adds every task of the work group to the pool and waits for all of them to finish.
 void DoWork(WorkGroup* work);
 
+// Same as DoWork, except that the calling thread runs the first task instead of only waiting.
+void DoWorkAndParticipate(WorkGroup* work);
+
+// True if the calling thread is running a task. The pool does not support nested work,
+// code that uses the pool must run serially when called from inside a task.
+bool InsideTask();
+
 #define MemoryBarrier() __asm__ __volatile__("":::"memory"); __sync_synchronize() // Gcc specific
+
+// ============================================================================
+// Synchronization primitives for code running inside tasks
+
+struct Mutex{
+   pthread_mutex_t mutex;
+};
+
+void InitMutex(Mutex* mutex);
+void LockMutex(Mutex* mutex);
+void UnlockMutex(Mutex* mutex);
+
+// Gcc specific. Sequentially consistent, since the data that we share between threads is small.
+template<typename T>
+inline T AtomicLoad(T* ptr){return __atomic_load_n(ptr,__ATOMIC_SEQ_CST);};
+
+template<typename T>
+inline void AtomicStore(T* ptr,T val){__atomic_store_n(ptr,val,__ATOMIC_SEQ_CST);};
+
+template<typename T>
+inline T AtomicAdd(T* ptr,T val){return __atomic_add_fetch(ptr,val,__ATOMIC_SEQ_CST);};
+
+// If *ptr equals expected, stores val and returns true. Otherwise loads *ptr into expected and returns false.
+template<typename T>
+inline bool AtomicCompareAndSwap(T* ptr,T* expected,T val){return __atomic_compare_exchange_n(ptr,expected,val,false,__ATOMIC_SEQ_CST,__ATOMIC_SEQ_CST);};
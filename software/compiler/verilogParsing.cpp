@@ -90,9 +90,31 @@ bool PerformDefineSubstitution(StringBuilder* builder,TrieMap<String,MacroDefini
   return true;
 }
 
-void PreprocessVerilogFile_(String fileContent,TrieMap<String,MacroDefinition>* macros,Array<String> includeFilepaths,StringBuilder* builder);
+static FILE* OpenIncludeFile(String fileName,Array<String> includeFilepaths){
+  std::string filename(UN_REVERSE(fileName));
+  for(String str : includeFilepaths){
+    std::string string(str.data,str.size);
+
+    std::string filepath;
+    if(string.back() == '/'){
+      filepath = string + filename;
+    } else {
+      filepath = string + '/' + filename;
+    }
+
+    FILE* file = OpenFile(filepath.c_str(),"r",FilePurpose_READ_CONTENT);
+
+    if(file){
+      return file;
+    }
+  }
 
-static void DoIfStatement(Tokenizer* tok,TrieMap<String,MacroDefinition>* macros,Array<String> includeFilepaths,StringBuilder* builder){
+  return nullptr;
+}
+
+void PreprocessVerilogFile_(String fileContent,TrieMap<String,MacroDefinition>* macros,Array<String> includeFilepaths,ArenaList<VerilogInclude>* includes,StringBuilder* builder);
+
+static void DoIfStatement(Tokenizer* tok,TrieMap<String,MacroDefinition>* macros,Array<String> includeFilepaths,ArenaList<VerilogInclude>* includes,StringBuilder* builder){
   Token first = tok->NextToken();
   Token macroName = tok->NextToken();
 
@@ -123,14 +145,14 @@ static void DoIfStatement(Tokenizer* tok,TrieMap<String,MacroDefinition>* macros
     
     if(CompareString(type,"endif")){
       if(doIf){
-        PreprocessVerilogFile_(subContent,macros,includeFilepaths,builder);
+        PreprocessVerilogFile_(subContent,macros,includeFilepaths,includes,builder);
       }
       break;
     }
 
     if(CompareString(type,"else")){
       if(doIf){
-        PreprocessVerilogFile_(subContent,macros,includeFilepaths,builder);
+        PreprocessVerilogFile_(subContent,macros,includeFilepaths,includes,builder);
         doIf = false;
       } else {
         mark = tok->Mark();
@@ -142,14 +164,14 @@ static void DoIfStatement(Tokenizer* tok,TrieMap<String,MacroDefinition>* macros
     if(doIf) {
       if(CompareString(type,"ifdef") || CompareString(type,"ifndef") || CompareString(type,"elsif")){
         tok->Rollback(subMark); // TODO: Not good.
-        DoIfStatement(tok,macros,includeFilepaths,builder);
+        DoIfStatement(tok,macros,includeFilepaths,includes,builder);
       }
     }
     // otherwise must be some other directive, will be handled automatically in the Preprocess call.
   }
 }
 
-void PreprocessVerilogFile_(String fileContent,TrieMap<String,MacroDefinition>* macros,Array<String> includeFilepaths,StringBuilder* builder){
+void PreprocessVerilogFile_(String fileContent,TrieMap<String,MacroDefinition>* macros,Array<String> includeFilepaths,ArenaList<VerilogInclude>* includes,StringBuilder* builder){
   Tokenizer tokenizer = Tokenizer(fileContent, "():;[]{}`,+-/*\\\"",{});
   Tokenizer* tok = &tokenizer;
 
@@ -173,25 +195,7 @@ void PreprocessVerilogFile_(String fileContent,TrieMap<String,MacroDefinition>*
       Token fileName = tok->NextFindUntil("\"").value();
       tok->AssertNextToken("\"");
 
-      // Open include file
-      std::string filename(UN_REVERSE(fileName));
-      FILE* file = nullptr;
-      for(String str : includeFilepaths){
-        std::string string(str.data,str.size);
-        
-        std::string filepath;
-        if(string.back() == '/'){
-          filepath = string + filename;
-        } else {
-          filepath = string + '/' + filename;
-        }
-
-        file = OpenFile(filepath.c_str(),"r",FilePurpose_READ_CONTENT);
-
-        if(file){
-          break;
-        }
-      }
+      FILE* file = OpenIncludeFile(fileName,includeFilepaths);
       DEFER_CLOSE_FILE(file);
       
       if(!file){
@@ -220,7 +224,13 @@ void PreprocessVerilogFile_(String fileContent,TrieMap<String,MacroDefinition>*
 
       mem[amountRead] = '\0';
 
-      PreprocessVerilogFile_(String((const char*) mem,fileSize),macros,includeFilepaths,builder);
+      if(includes){
+        VerilogInclude* include = includes->PushElem();
+        include->name = PushString(includes->arena,fileName);
+        include->contentHash = StableHashString(String((const char*) mem,fileSize));
+      }
+
+      PreprocessVerilogFile_(String((const char*) mem,fileSize),macros,includeFilepaths,includes,builder);
     } else if(CompareString(identifier,"define")){
       tok->AdvancePeek();
 
@@ -283,7 +293,7 @@ void PreprocessVerilogFile_(String fileContent,TrieMap<String,MacroDefinition>*
     } else if(CompareString(identifier,"timescale")){
       tok->AdvanceRemainingLine();
     } else if(CompareString(identifier,"ifdef") || CompareString(identifier,"ifndef")){
-      DoIfStatement(tok,macros,includeFilepaths,builder);
+      DoIfStatement(tok,macros,includeFilepaths,includes,builder);
       
     } else if(CompareString(identifier,"else")){
       NOT_POSSIBLE("All else and ends should have already been handled inside DoIf");
@@ -307,13 +317,13 @@ void PreprocessVerilogFile_(String fileContent,TrieMap<String,MacroDefinition>*
   }
 }
 
-String PreprocessVerilogFile(String fileContent,Array<String> includeFilepaths,Arena* out){
+String PreprocessVerilogFile(String fileContent,Array<String> includeFilepaths,Arena* out,ArenaList<VerilogInclude>* includes){
   TEMP_REGION(temp,out);
 
   TrieMap<String,MacroDefinition>* macros = PushTrieMap<String,MacroDefinition>(temp);
 
   auto builder = StartString(temp);
-  PreprocessVerilogFile_(fileContent,macros,includeFilepaths,builder);
+  PreprocessVerilogFile_(fileContent,macros,includeFilepaths,includes,builder);
 
   String res = EndString(out,builder);
 
@@ -540,18 +550,19 @@ static Expression* VerilogParseExpression(Tokenizer* tok,Arena* out){
 }
 
 static ExpressionRange ParseRange(Tokenizer* tok,Arena* out){
-  static Expression zeroExpression = {};
-
   Token peek = tok->PeekToken();
 
   if(!CompareString(peek,"[")){ // No range is equal to range [0:0]. Do not known if it's worth/need to  differentiate
     ExpressionRange range = {};
 
-    zeroExpression.type = Expression::LITERAL;
-    zeroExpression.val = MakeValue(0);
+    // Allocated instead of shared because files can be parsed by multiple threads
+    Expression* zeroExpression = PushStruct<Expression>(out);
+    *zeroExpression = {};
+    zeroExpression->type = Expression::LITERAL;
+    zeroExpression->val = MakeValue(0);
     
-    range.top = &zeroExpression;
-    range.bottom = &zeroExpression;
+    range.top = zeroExpression;
+    range.bottom = zeroExpression;
     
     return range;
   }
@@ -1058,3 +1069,534 @@ Value Eval(Expression* expr,Array<ParameterExpression> parameters){
 
   return ret;
 }
+
+static Expression* CopyExpression(Expression* expr,Arena* out){
+  if(expr == nullptr){
+    return nullptr;
+  }
+
+  Expression* res = PushStruct<Expression>(out);
+  *res = *expr;
+
+  if(expr->op){
+    res->op = PushString(out,String(expr->op)).data;
+    PushNullByte(out);
+  }
+  res->id = PushString(out,expr->id);
+  res->text = PushString(out,expr->text);
+  if(expr->val.type == ValueType_STRING){
+    res->val.str = PushString(out,expr->val.str);
+  }
+
+  res->expressions = PushArray<Expression*>(out,expr->expressions.size);
+  for(int i = 0; i < expr->expressions.size; i++){
+    res->expressions[i] = CopyExpression(expr->expressions[i],out);
+  }
+
+  return res;
+}
+
+static ExpressionRange CopyRange(ExpressionRange range,Arena* out){
+  ExpressionRange res = {};
+  res.top = CopyExpression(range.top,out);
+  res.bottom = CopyExpression(range.bottom,out);
+  return res;
+}
+
+ModuleInfo CopyModuleInfo(ModuleInfo info,Arena* out){
+  ModuleInfo res = info;
+
+  res.name = PushString(out,info.name);
+  res.memoryMappedBits = CopyRange(info.memoryMappedBits,out);
+  res.databusAddrSize = CopyRange(info.databusAddrSize,out);
+
+  res.defaultParameters = PushArray<ParameterExpression>(out,info.defaultParameters.size);
+  for(int i = 0; i < info.defaultParameters.size; i++){
+    res.defaultParameters[i].name = PushString(out,info.defaultParameters[i].name);
+    res.defaultParameters[i].expr = CopyExpression(info.defaultParameters[i].expr,out);
+  }
+
+  res.inputs = PushArray<PortInfo>(out,info.inputs.size);
+  for(int i = 0; i < info.inputs.size; i++){
+    res.inputs[i].delay = info.inputs[i].delay;
+    res.inputs[i].range = CopyRange(info.inputs[i].range,out);
+  }
+
+  res.outputs = PushArray<PortInfo>(out,info.outputs.size);
+  for(int i = 0; i < info.outputs.size; i++){
+    res.outputs[i].delay = info.outputs[i].delay;
+    res.outputs[i].range = CopyRange(info.outputs[i].range,out);
+  }
+
+  res.configs = PushArray<WireExpression>(out,info.configs.size);
+  for(int i = 0; i < info.configs.size; i++){
+    res.configs[i] = info.configs[i];
+    res.configs[i].name = PushString(out,info.configs[i].name);
+    res.configs[i].bitSize = CopyRange(info.configs[i].bitSize,out);
+  }
+
+  res.states = PushArray<WireExpression>(out,info.states.size);
+  for(int i = 0; i < info.states.size; i++){
+    res.states[i] = info.states[i];
+    res.states[i].name = PushString(out,info.states[i].name);
+    res.states[i].bitSize = CopyRange(info.states[i].bitSize,out);
+  }
+
+  res.externalInterfaces = PushArray<ExternalMemoryInterfaceExpression>(out,info.externalInterfaces.size);
+  for(int i = 0; i < info.externalInterfaces.size; i++){
+    ExternalMemoryInterfaceExpression& inter = res.externalInterfaces[i];
+    inter = info.externalInterfaces[i];
+
+    switch(inter.type){
+    case ExternalMemoryType_2P:{
+      inter.tp.bitSizeIn = CopyRange(inter.tp.bitSizeIn,out);
+      inter.tp.bitSizeOut = CopyRange(inter.tp.bitSizeOut,out);
+      inter.tp.dataSizeIn = CopyRange(inter.tp.dataSizeIn,out);
+      inter.tp.dataSizeOut = CopyRange(inter.tp.dataSizeOut,out);
+    } break;
+    case ExternalMemoryType_DP:{
+      for(int k = 0; k < 2; k++){
+        inter.dp[k].bitSize = CopyRange(inter.dp[k].bitSize,out);
+        inter.dp[k].dataSizeIn = CopyRange(inter.dp[k].dataSizeIn,out);
+        inter.dp[k].dataSizeOut = CopyRange(inter.dp[k].dataSizeOut,out);
+      }
+    } break;
+    }
+  }
+
+  return res;
+}
+
+// ============================================================================
+// Module info cache
+
+// Increment when the format, the parser or the information extracted changes. Entries of other versions are never used.
+#define MODULE_CACHE_VERSION 1
+
+static String ModuleCacheFilepath(u64 key,Arena* out){
+  return PushString(out,"%.*s/module_%016lx.txt",UN(globalOptions.cachePath),key);
+}
+
+u64 ModuleInfoCacheKey(String fileContent,Array<String> includeFilepaths){
+  u64 hash = StableHashInt(MODULE_CACHE_VERSION);
+
+  // Preprocessing always starts without any macro defined, the result only depends on the content,
+  // the include paths and the included files, which are checked when loading since the key cannot know them.
+  hash = StableHashString(fileContent,hash);
+  hash = StableHashInt(includeFilepaths.size,hash);
+  for(String path : includeFilepaths){
+    hash = StableHashString(path,hash);
+  }
+
+  return hash;
+}
+
+static void WriteExpression(FILE* file,Expression* expr){
+  if(expr == nullptr){
+    fprintf(file," -1");
+    return;
+  }
+
+  fprintf(file," %d ",(int) expr->type);
+  CacheWriteString(file,expr->op ? String(expr->op) : String{});
+  fprintf(file," ");
+  CacheWriteString(file,expr->id);
+  fprintf(file," %d ",(int) expr->val.type);
+
+  switch(expr->val.type){
+  case ValueType_NIL: break;
+  case ValueType_NUMBER: fprintf(file,"%lld",(long long) expr->val.number); break;
+  case ValueType_STRING: CacheWriteString(file,expr->val.str); break;
+  case ValueType_BOOLEAN: fprintf(file,"%d",expr->val.boolean ? 1 : 0); break;
+  }
+  
+  fprintf(file," %d",expr->expressions.size);
+  for(Expression* child : expr->expressions){
+    WriteExpression(file,child);
+  }
+}
+
+static void WriteRange(FILE* file,ExpressionRange range){
+  WriteExpression(file,range.top);
+  WriteExpression(file,range.bottom);
+}
+
+static void WriteWireExpressions(FILE* file,const char* name,Array<WireExpression> wires){
+  fprintf(file,"%s %d\n",name,wires.size);
+  for(WireExpression& wire : wires){
+    CacheWriteString(file,wire.name);
+    WriteRange(file,wire.bitSize);
+    fprintf(file," %d %d\n",(int) wire.stage,wire.isStatic ? 1 : 0);
+  }
+}
+
+static void WritePorts(FILE* file,const char* name,Array<PortInfo> ports){
+  fprintf(file,"%s %d\n",name,ports.size);
+  for(PortInfo& port : ports){
+    fprintf(file,"%d",port.delay);
+    WriteRange(file,port.range);
+    fprintf(file,"\n");
+  }
+}
+
+void StoreModuleInfoCache(u64 key,Array<VerilogInclude> includes,Array<ModuleInfo> modules){
+  TEMP_REGION(temp,nullptr);
+
+  CacheFile cache = OpenCacheFile(ModuleCacheFilepath(key,temp),temp);
+  FILE* file = cache.file;
+  if(!file){
+    return;
+  }
+  
+  fprintf(file,"VersatModuleCache %d\n",MODULE_CACHE_VERSION);
+  fprintf(file,"includes %d\n",includes.size);
+  for(VerilogInclude& include : includes){
+    CacheWriteString(file,include.name);
+    fprintf(file," %016lx\n",include.contentHash);
+  }
+
+  fprintf(file,"modules %d\n",modules.size);
+  for(ModuleInfo& info : modules){
+    fprintf(file,"module ");
+    CacheWriteString(file,info.name);
+    fprintf(file," %d %d %d %d %d %d\n",info.nDelays,info.nIO,(int) info.singleInterfaces,
+            info.doesIO ? 1 : 0,info.memoryMapped ? 1 : 0,info.isSource ? 1 : 0);
+
+    WriteRange(file,info.memoryMappedBits);
+    WriteRange(file,info.databusAddrSize);
+    fprintf(file,"\n");
+    
+    fprintf(file,"parameters %d\n",info.defaultParameters.size);
+    for(ParameterExpression& param : info.defaultParameters){
+      CacheWriteString(file,param.name);
+      WriteExpression(file,param.expr);
+      fprintf(file,"\n");
+    }
+
+    WritePorts(file,"inputs",info.inputs);
+    WritePorts(file,"outputs",info.outputs);
+    WriteWireExpressions(file,"configs",info.configs);
+    WriteWireExpressions(file,"states",info.states);
+
+    fprintf(file,"externals %d\n",info.externalInterfaces.size);
+    for(ExternalMemoryInterfaceExpression& inter : info.externalInterfaces){
+      fprintf(file,"%d %d",(int) inter.type,inter.interface);
+      switch(inter.type){
+      case ExternalMemoryType_2P:{
+        WriteRange(file,inter.tp.bitSizeIn);
+        WriteRange(file,inter.tp.bitSizeOut);
+        WriteRange(file,inter.tp.dataSizeIn);
+        WriteRange(file,inter.tp.dataSizeOut);
+      } break;
+      case ExternalMemoryType_DP:{
+        for(int i = 0; i < 2; i++){
+          WriteRange(file,inter.dp[i].bitSize);
+          WriteRange(file,inter.dp[i].dataSizeIn);
+          WriteRange(file,inter.dp[i].dataSizeOut);
+        }
+      } break;
+      }
+      fprintf(file,"\n");
+    }
+  }
+
+  CommitCacheFile(cache);
+}
+
+// Strings are kept inside the loaded content. Only the operator needs a copy, since it is used as a C string.
+static Expression* ReadExpression(CacheReader* reader,Arena* out,int depth = 0){
+  int type = CacheReadInt(reader);
+  if(reader->error || type == -1){
+    return nullptr;
+  }
+  if(type < Expression::UNDEFINED || type > Expression::LITERAL || depth > 1000){
+    reader->error = true;
+    return nullptr;
+  }
+
+  Expression* expr = PushStruct<Expression>(out);
+  *expr = {};
+  expr->type = (decltype(expr->type)) type;
+
+  String op = CacheReadString(reader);
+  if(!Empty(op)){
+    expr->op = PushString(out,op).data;
+    PushNullByte(out);
+  }
+  expr->id = CacheReadString(reader);
+
+  int valueType = CacheReadInt(reader);
+  switch(valueType){
+  case ValueType_NIL: break;
+  case ValueType_NUMBER: expr->val.number = CacheReadInt(reader); break;
+  case ValueType_STRING: expr->val.str = CacheReadString(reader); break;
+  case ValueType_BOOLEAN: expr->val.boolean = (CacheReadInt(reader) != 0); break;
+  default: reader->error = true; break;
+  }
+  expr->val.type = (ValueType) valueType;
+  
+  int amount = CacheReadInt(reader);
+  if(reader->error || amount < 0 || amount > reader->end - reader->ptr){
+    reader->error = true;
+    return nullptr;
+  }
+
+  expr->expressions = PushArray<Expression*>(out,amount);
+  for(int i = 0; i < amount; i++){
+    expr->expressions[i] = ReadExpression(reader,out,depth + 1);
+  }
+
+  return expr;
+}
+
+static ExpressionRange ReadRange(CacheReader* reader,Arena* out){
+  ExpressionRange range = {};
+  range.top = ReadExpression(reader,out);
+  range.bottom = ReadExpression(reader,out);
+  return range;
+}
+
+// Every count is checked against the remaining content so that a broken entry cannot make us allocate a huge array
+static int ReadAmount(CacheReader* reader,const char* name){
+  CacheReadWord(reader,name);
+  int amount = CacheReadInt(reader);
+  if(reader->error || amount < 0 || amount > reader->end - reader->ptr){
+    reader->error = true;
+    return 0;
+  }
+  return amount;
+}
+
+static Array<WireExpression> ReadWireExpressions(CacheReader* reader,const char* name,Arena* out){
+  int amount = ReadAmount(reader,name);
+  Array<WireExpression> wires = PushArray<WireExpression>(out,amount);
+  for(WireExpression& wire : wires){
+    wire = {};
+    wire.name = CacheReadString(reader);
+    wire.bitSize = ReadRange(reader,out);
+    wire.stage = (VersatStage) CacheReadInt(reader);
+    wire.isStatic = (CacheReadInt(reader) != 0);
+  }
+  return wires;
+}
+
+static Array<PortInfo> ReadPorts(CacheReader* reader,const char* name,Arena* out){
+  int amount = ReadAmount(reader,name);
+  Array<PortInfo> ports = PushArray<PortInfo>(out,amount);
+  for(PortInfo& port : ports){
+    port = {};
+    port.delay = CacheReadInt(reader);
+    port.range = ReadRange(reader,out);
+  }
+  return ports;
+}
+
+Opt<Array<ModuleInfo>> LoadModuleInfoCache(u64 key,Array<String> includeFilepaths,Arena* out){
+  TEMP_REGION(temp,out);
+
+  String filepath = ModuleCacheFilepath(key,temp);
+  FILE* file = OpenFile(filepath,"r",FilePurpose_CACHE);
+  if(!file){
+    return {};
+  }
+  DEFER_CLOSE_FILE(file);
+
+  // Module info points inside the content
+  auto mark = MarkArena(out);
+  String content = PushFile(out,file);
+  PushNullByte(out);
+
+  CacheReader reader = StartCacheReader(content);
+  auto Fail = [&](){
+    PopMark(mark);
+    return Opt<Array<ModuleInfo>>{};
+  };
+  
+  CacheReadWord(&reader,"VersatModuleCache");
+  if(CacheReadInt(&reader) != MODULE_CACHE_VERSION){
+    return Fail();
+  }
+
+  int amount = ReadAmount(&reader,"includes");
+  for(int i = 0; i < amount; i++){
+    String name = CacheReadString(&reader);
+    u64 contentHash = CacheReadHex(&reader);
+    if(reader.error){
+      return Fail();
+    }
+
+    FILE* includeFile = OpenIncludeFile(name,includeFilepaths);
+    if(!includeFile){
+      return Fail();
+    }
+    String includeContent = PushFile(temp,includeFile);
+    fclose(includeFile);
+
+    if(StableHashString(includeContent) != contentHash){
+      return Fail();
+    }
+  }
+
+  amount = ReadAmount(&reader,"modules");
+  Array<ModuleInfo> modules = PushArray<ModuleInfo>(out,amount);
+  for(ModuleInfo& info : modules){
+    info = {};
+
+    CacheReadWord(&reader,"module");
+    info.name = CacheReadString(&reader);
+    info.nDelays = CacheReadInt(&reader);
+    info.nIO = CacheReadInt(&reader);
+    info.singleInterfaces = (SingleInterfaces) CacheReadInt(&reader);
+    info.doesIO = (CacheReadInt(&reader) != 0);
+    info.memoryMapped = (CacheReadInt(&reader) != 0);
+    info.isSource = (CacheReadInt(&reader) != 0);
+
+    info.memoryMappedBits = ReadRange(&reader,out);
+    info.databusAddrSize = ReadRange(&reader,out);
+
+    int amountParameters = ReadAmount(&reader,"parameters");
+    info.defaultParameters = PushArray<ParameterExpression>(out,amountParameters);
+    for(ParameterExpression& param : info.defaultParameters){
+      param.name = CacheReadString(&reader);
+      param.expr = ReadExpression(&reader,out);
+    }
+
+    info.inputs = ReadPorts(&reader,"inputs",out);
+    info.outputs = ReadPorts(&reader,"outputs",out);
+    info.configs = ReadWireExpressions(&reader,"configs",out);
+    info.states = ReadWireExpressions(&reader,"states",out);
+
+    int amountExternals = ReadAmount(&reader,"externals");
+    info.externalInterfaces = PushArray<ExternalMemoryInterfaceExpression>(out,amountExternals);
+    for(ExternalMemoryInterfaceExpression& inter : info.externalInterfaces){
+      inter = {};
+      int type = CacheReadInt(&reader);
+      inter.interface = CacheReadInt(&reader);
+
+      if(type == ExternalMemoryType_2P){
+        inter.type = ExternalMemoryType_2P;
+        inter.tp.bitSizeIn = ReadRange(&reader,out);
+        inter.tp.bitSizeOut = ReadRange(&reader,out);
+        inter.tp.dataSizeIn = ReadRange(&reader,out);
+        inter.tp.dataSizeOut = ReadRange(&reader,out);
+      } else if(type == ExternalMemoryType_DP){
+        inter.type = ExternalMemoryType_DP;
+        for(int i = 0; i < 2; i++){
+          inter.dp[i].bitSize = ReadRange(&reader,out);
+          inter.dp[i].dataSizeIn = ReadRange(&reader,out);
+          inter.dp[i].dataSizeOut = ReadRange(&reader,out);
+        }
+      } else {
+        reader.error = true;
+      }
+    }
+
+    if(reader.error){
+      return Fail();
+    }
+  }
+
+  if(reader.error){
+    return Fail();
+  }
+
+  return modules;
+}
+
+static void TestModuleInfoCacheWriteInclude(String includePath,int width){
+  TEMP_REGION(temp,nullptr);
+  FILE* file = fopen(CS(PushString(temp,"%.*s/width.vh",UN(includePath))),"w");
+  if(file){
+    fprintf(file,"`define TEST_WIDTH %d\n",width);
+    fclose(file);
+  }
+}
+
+int TestModuleInfoCache(){
+  TEMP_REGION(temp,nullptr);
+  int failed = 0;
+
+  String savedCachePath = globalOptions.cachePath;
+  String dir = CreateTemporaryDirectory("versat_module_cache_test",temp);
+  globalOptions.cachePath = PushString(temp,"%.*s/cache",UN(dir));
+
+  String includePath = dir;
+  String otherIncludePath = PushString(temp,"%.*s/other",UN(dir));
+  Array<String> includePaths = {&includePath,1};
+  Array<String> otherIncludePaths = {&otherIncludePath,1};
+  TestModuleInfoCacheWriteInclude(includePath,8);
+
+  String content = String("`include \"width.vh\"\n"
+                          "module CacheTest #(parameter DATA_W = `TEST_WIDTH) (\n"
+                          "  input clk,\n"
+                          "  input [DATA_W-1:0] in0,\n"
+                          "  output [DATA_W-1:0] out0,\n"
+                          "  input [DATA_W-1:0] constant\n"
+                          ");\n"
+                          "endmodule\n");
+
+  // Preprocessing uses both context arenas
+  Arena includesArena = InitArena(Kilobyte(64));
+  auto includes = PushArenaList<VerilogInclude>(&includesArena);
+  String processed = PreprocessVerilogFile(content,includePaths,temp,includes);
+  Array<Module> parsed = ParseVerilogFile(processed,includePaths,temp);
+  TEST_CHECK(failed,parsed.size == 1);
+  if(parsed.size != 1){
+    Free(&includesArena);
+    globalOptions.cachePath = savedCachePath;
+    return failed;
+  }
+
+  Array<ModuleInfo> modules = PushArray<ModuleInfo>(temp,1);
+  modules[0] = ExtractModuleInfo(parsed[0],temp);
+
+  // Key only depends on the content and the include paths, it must be the same in every compiler run
+  u64 key = ModuleInfoCacheKey(content,includePaths);
+  TEST_CHECK(failed,ModuleInfoCacheKey(content,includePaths) == key);
+  TEST_CHECK(failed,ModuleInfoCacheKey(String("module Other(); endmodule"),includePaths) != key);
+  TEST_CHECK(failed,ModuleInfoCacheKey(content,otherIncludePaths) != key);
+
+  TEST_CHECK(failed,!LoadModuleInfoCache(key,includePaths,temp).has_value());
+
+  StoreModuleInfoCache(key,PushArrayFromList(temp,includes),modules);
+  Free(&includesArena);
+
+  Opt<Array<ModuleInfo>> loaded = LoadModuleInfoCache(key,includePaths,temp);
+  TEST_CHECK(failed,loaded.has_value() && loaded.value().size == 1);
+  if(loaded.has_value() && loaded.value().size == 1){
+    ModuleInfo& original = modules[0];
+    ModuleInfo& info = loaded.value()[0];
+
+    TEST_CHECK(failed,CompareString(info.name,"CacheTest"));
+    TEST_CHECK(failed,info.inputs.size == original.inputs.size && info.outputs.size == original.outputs.size);
+    TEST_CHECK(failed,info.configs.size == 1 && CompareString(info.configs[0].name,"constant"));
+    TEST_CHECK(failed,info.singleInterfaces == original.singleInterfaces);
+    TEST_CHECK(failed,info.defaultParameters.size == 1);
+    if(info.defaultParameters.size == 1){
+      TEST_CHECK(failed,Eval(info.defaultParameters[0].expr,info.defaultParameters).number == 8);
+    }
+  }
+
+  // Only the entry remains, the temporary file was renamed over it
+  Opt<Array<String>> files = GetAllFilesInsideDirectory(globalOptions.cachePath,temp);
+  TEST_CHECK(failed,files.has_value() && files.value().size == 1);
+
+  // A change to an included file is only seen when loading
+  TestModuleInfoCacheWriteInclude(includePath,16);
+  TEST_CHECK(failed,!LoadModuleInfoCache(key,includePaths,temp).has_value());
+  TestModuleInfoCacheWriteInclude(includePath,8);
+  TEST_CHECK(failed,LoadModuleInfoCache(key,includePaths,temp).has_value());
+  
+  // Damaged entries are not used
+  FILE* file = fopen(CS(ModuleCacheFilepath(key,temp)),"w");
+  if(file){
+    fprintf(file,"VersatModuleCache %d\nincludes 0\nmodules 1\nmodule ",MODULE_CACHE_VERSION);
+    fclose(file);
+  }
+  TEST_CHECK(failed,!LoadModuleInfoCache(key,includePaths,temp).has_value());
+
+  RemoveDirectory(dir);
+  globalOptions.cachePath = savedCachePath;
+
+  return failed;
+}
@@ -183,11 +183,28 @@ struct ModuleInfo{
   bool isSource;
 };
 
+// A file pulled by an `include directive
+struct VerilogInclude{
+  String name; // As it appears in the directive, the file is searched inside the include paths
+  u64 contentHash;
+};
+
 SymbolicExpression* SymbolicExpressionFromVerilog(Expression* topExpr,Arena* out);
 SymbolicExpression* SymbolicExpressionFromVerilog(ExpressionRange range,Arena* out);
 
-String PreprocessVerilogFile(String fileContent,Array<String> includeFilepaths,Arena* out);
+// If includes is given, it receives every file included during preprocessing. Must not be a temp arena list.
+String PreprocessVerilogFile(String fileContent,Array<String> includeFilepaths,Arena* out,ArenaList<VerilogInclude>* includes = nullptr);
 Array<Module> ParseVerilogFile(String fileContent,Array<String> includeFilepaths,Arena* out); // Only handles preprocessed files
 ModuleInfo ExtractModuleInfo(Module& module,Arena* out);
+ModuleInfo CopyModuleInfo(ModuleInfo info,Arena* out); // Deep copy, the result does not point into the parsed content
+
+// Cache of the modules extracted from a file, so that unchanged files are not parsed again in every run.
+// Entries are stored inside globalOptions.cachePath.
+u64 ModuleInfoCacheKey(String fileContent,Array<String> includeFilepaths);
+void StoreModuleInfoCache(u64 key,Array<VerilogInclude> includes,Array<ModuleInfo> modules);
+// Empty if there is no entry or if any included file changed since the entry was stored
+Opt<Array<ModuleInfo>> LoadModuleInfoCache(u64 key,Array<String> includeFilepaths,Arena* out);
+
+int TestModuleInfoCache();
 
 Value Eval(Expression* expr,Array<ParameterExpression> parameters);
@@ -379,6 +379,30 @@ void FillDeclarationWithDelayType(FUDeclaration* decl){
   }
 }
 
+static void InsertPipelineRegisters(FUDeclaration* decl,Accelerator* circuit){
+  if(globalOptions.maxCombinatorialDepth <= 0){
+    return;
+  }
+
+  int before = LongestCombinatorialPath(circuit);
+  int registers = PipelineCombinatorialPaths(circuit,globalOptions.maxCombinatorialDepth);
+  if(registers > 0){
+    decl->registrationReport = PushString(globalPermanent,"%.*sPipeline registers for %.*s: %d (combinatorial depth %d -> %d)\n",UN(decl->registrationReport),UN(decl->name),registers,before,LongestCombinatorialPath(circuit));
+  }
+}
+
+static void ReportDelayRegisters(FUDeclaration* decl,CalculateDelayResult delays){
+  if(delays.unitLevelDelayRegisters == 0){
+    return;
+  }
+  
+  decl->registrationReport = PushString(globalPermanent,"%.*sDelay registers for %.*s: %d (unit level delays: %d, saved: %d)\n",UN(decl->registrationReport),UN(decl->name),delays.delayRegisters,delays.unitLevelDelayRegisters,delays.unitLevelDelayRegisters - delays.delayRegisters);
+}
+
+void PrintRegistrationReport(FUDeclaration* decl){
+  printf("%.*s",UN(decl->registrationReport));
+}
+
 FUDeclaration* RegisterSubUnit(Accelerator* circuit,SubUnitOptions options){
   DEBUG_PATH("RegisterSubUnit");
   DEBUG_PATH(circuit->name);
@@ -431,7 +455,10 @@ FUDeclaration* RegisterSubUnit(Accelerator* circuit,SubUnitOptions options){
     // TODO: Need to add back the OutputDebugDotGraph calls
     res->baseCircuit = CopyAccelerator(circuit,AcceleratorPurpose_BASE,true); 
 
+    InsertPipelineRegisters(res,circuit);
+
     CalculateDelayResult delays = CalculateDelay(circuit,temp);
+    ReportDelayRegisters(res,delays);
 
     region(temp){
       FixDelays(circuit,delays.edgesDelay);
@@ -447,7 +474,10 @@ FUDeclaration* RegisterSubUnit(Accelerator* circuit,SubUnitOptions options){
     res->flattenedBaseCircuit = p.first;
     res->flattenMapping = p.second;
   
+    InsertPipelineRegisters(res,circuit);
+
     CalculateDelayResult delays = CalculateDelay(circuit,temp);
+    ReportDelayRegisters(res,delays);
 
     region(temp){
       FixDelays(circuit,delays.edgesDelay);
@@ -17,6 +17,7 @@
 #include "templateEngine.hpp"
 #include "codeGeneration.hpp"
 #include "addressGen.hpp"
+#include "thread.hpp"
 
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -86,6 +87,8 @@ struct Work{
 
   bool calculateDelayFixedGraph;
   bool flattenWithMapping;
+
+  FUDeclaration* declaration; // Reserved before instantiating, in the order of the work
 };
 
 void Print(Work* work){
@@ -111,6 +114,379 @@ void GetSubWorkRequirement(Hashmap<String,Work>* typeToWork,ConstructDef type){
   }
 }
 
+// Level of a module is one more than the highest level of the modules that it uses. Modules that do not use other modules are level 0.
+Array<int> CalculateDAGLevels(int maxNode,Array<Pair<int,int>> edges,Array<int> order,Arena* out){
+  Array<int> levels = PushArray<int>(out,maxNode);
+  Memset(levels,-1);
+
+  // Order from CalculateDAG always contains the children before the parent
+  for(int node : order){
+    int level = 0;
+    for(auto p : edges){
+      if(p.first == node){
+        Assert(levels[p.second] >= 0);
+        level = MAX(level,levels[p.second] + 1);
+      }
+    }
+    levels[node] = level;
+  }
+
+  return levels;
+}
+
+static FUDeclaration* InstantiateWorkDeclaration(String content,Work work){
+  FUDeclaration* decl = nullptr;
+
+  if(work.definition.type == ConstructType_MODULE){
+    decl = InstantiateBarebonesSpecifications(content,work.definition);
+  } else if(work.definition.type == ConstructType_MERGE){
+    decl = InstantiateSpecifications(content,work.definition);
+  }
+  decl->singleInterfaces |= SingleInterfaces_SIGNAL_LOOP;
+
+#if 0
+  if(work.calculateDelayFixedGraph){
+    Accelerator* copy = CopyAccelerator(decl->baseCircuit,AcceleratorPurpose_FIXED_DELAY,true,nullptr);
+
+    DAGOrderNodes order = CalculateDAGOrder(&copy->allocated,temp);
+    CalculateDelayResult delays = CalculateDelay(copy,order,temp);
+
+    decl->baseConfig.calculatedDelays = PushArray<int>(perm,delays.nodeDelay->nodesUsed);
+    Memset(decl->baseConfig.calculatedDelays,0);
+    int index = 0;
+    for(Pair<FUInstance*,DelayInfo*> p : delays.nodeDelay){
+      if(p.first->declaration->baseConfig.delayOffsets.max > 0){
+        decl->baseConfig.calculatedDelays[index] = p.second->value;
+        index += 1;
+      }
+    }
+
+    region(temp){
+      FixDelays(copy,delays.edgesDelay,temp);
+    }
+
+    decl->fixedDelayCircuit = copy;
+    decl->fixedDelayCircuit->name = decl->name;
+
+    FillDeclarationWithDelayType(decl);
+  }
+#endif
+
+#if 0
+  if(work.definition.type == ConstructType_MODULE && work.definition.module.name == "ModuleWithExtra"){
+    auto p = FlattenWithMerge(decl->baseCircuit,0);
+
+    DebugRegionOutputDotGraph(p.accel,"FlattenReconAttemp0");
+  }
+#endif
+
+  return decl;
+}
+
+static void FlattenWorkDeclaration(FUDeclaration* decl,Work work){
+  // Flatten with mapping seems to be specific to modules.
+  // Merge circuits are already flatten by the way the merge is performed.
+  if(work.definition.type != ConstructType_MERGE && work.flattenWithMapping){
+    Pair<Accelerator*,SubMap*> p = Flatten(decl->baseCircuit,99);
+
+    decl->flattenedBaseCircuit = p.first;
+    decl->flattenMapping = p.second;
+  }
+}
+
+// Arenas that a worker thread uses for the TEMP_REGION macros and globalPermanent.
+struct WorkerArenas{
+  Arena* permanent;
+  Arena* temp;
+  Arena* temp2;
+};
+
+// Worker zero is the calling thread and keeps using its own arenas.
+// Permanent arenas of the other workers are never freed, the data allocated in them is used until the end.
+static Array<WorkerArenas> CreateWorkerArenas(int amount,Arena* out){
+  Array<WorkerArenas> workers = PushArray<WorkerArenas>(out,amount);
+
+  for(int i = 0; i < amount; i++){
+    WorkerArenas& worker = workers[i];
+
+    if(i == 0){
+      worker.permanent = globalPermanent;
+      worker.temp = contextArenas[0];
+      worker.temp2 = contextArenas[1];
+      continue;
+    }
+
+    worker.permanent = PushStruct<Arena>(out);
+    worker.temp = PushStruct<Arena>(out);
+    worker.temp2 = PushStruct<Arena>(out);
+    *worker.permanent = InitArena(Megabyte(128));
+    *worker.temp = InitArena(Megabyte(128));
+    *worker.temp2 = InitArena(Megabyte(128));
+  }
+
+  return workers;
+}
+
+static void SetWorkerArenas(WorkerArenas arenas){
+  globalPermanent = arenas.permanent;
+  contextArenas[0] = arenas.temp;
+  contextArenas[1] = arenas.temp2;
+}
+
+static void FreeWorkerArenas(Array<WorkerArenas> workers){
+  for(int i = 1; i < workers.size; i++){
+    Free(workers[i].temp);
+    Free(workers[i].temp2);
+  }
+}
+
+struct VerilogFileWork{
+  String filepath; // File is only read if content is empty
+  String content;
+
+  bool failedToOpen;
+  bool cached; // Modules loaded from the cache instead of parsed
+  Array<ModuleInfo> modules;
+};
+
+struct VerilogParseState{
+  Array<VerilogFileWork> files;
+  int nextFile;
+};
+
+struct VerilogParseWorker{
+  VerilogParseState* state;
+  WorkerArenas arenas;
+  Arena* includes;
+
+  Time preprocess;
+  Time parse;
+  Time extract;
+  Time cache;
+};
+
+struct VerilogParseTiming{
+  int threads;
+  int modules;
+  int cachedFiles;
+  Time total;
+
+  // Summed over every thread
+  Time preprocess;
+  Time parse;
+  Time extract;
+  Time cache;
+};
+
+static void ParseVerilogFilesTask(int id,void* args){
+  VerilogParseWorker* worker = (VerilogParseWorker*) args;
+  VerilogParseState* state = worker->state;
+
+  SetWorkerArenas(worker->arenas);
+
+  // Module info is used until the end, registration keeps pointers into it. Everything else only lives while the file is handled.
+  Arena* perm = globalPermanent;
+  
+  while(true){
+    int index = AtomicAdd(&state->nextFile,1) - 1;
+    if(index >= state->files.size){
+      break;
+    }
+
+    VerilogFileWork& file = state->files[index];
+
+    TEMP_REGION(temp,perm);
+    
+    Time start = GetTime();
+    String content = file.content;
+    if(Empty(content)){
+      content = PushFile(temp,file.filepath);
+
+      if(Empty(content)){
+        file.failedToOpen = true;
+        continue;
+      }
+    }
+
+    u64 key = 0;
+    if(!globalOptions.disableCache){
+      key = ModuleInfoCacheKey(content,globalOptions.includePaths);
+
+      Opt<Array<ModuleInfo>> cachedModules = LoadModuleInfoCache(key,globalOptions.includePaths,temp);
+      if(cachedModules.has_value()){
+        Array<ModuleInfo> modules = cachedModules.value();
+
+        file.modules = PushArray<ModuleInfo>(perm,modules.size);
+        for(int i = 0; i < modules.size; i++){
+          file.modules[i] = CopyModuleInfo(modules[i],perm);
+        }
+        file.cached = true;
+        worker->cache = worker->cache + (GetTime() - start);
+        continue;
+      }
+    }
+
+    // Preprocessing uses both context arenas, the list of includes needs an arena of its own
+    auto includesMark = MarkArena(worker->includes);
+    auto includes = PushArenaList<VerilogInclude>(worker->includes);
+    String processed = PreprocessVerilogFile(content,globalOptions.includePaths,temp,includes);
+    Time preprocessed = GetTime();
+
+    Array<Module> modules = ParseVerilogFile(processed,globalOptions.includePaths,temp);
+    Time parsed = GetTime();
+    
+    file.modules = PushArray<ModuleInfo>(perm,modules.size);
+    for(int i = 0; i < modules.size; i++){
+      file.modules[i] = CopyModuleInfo(ExtractModuleInfo(modules[i],temp),perm);
+    }
+    Time extracted = GetTime();
+
+    if(!globalOptions.disableCache){
+      StoreModuleInfoCache(key,PushArrayFromList(temp,includes),file.modules);
+    }
+    PopMark(includesMark);
+    Time stored = GetTime();
+
+    worker->preprocess = worker->preprocess + (preprocessed - start);
+    worker->parse = worker->parse + (parsed - preprocessed);
+    worker->extract = worker->extract + (extracted - parsed);
+    worker->cache = worker->cache + (stored - extracted);
+  }
+}
+
+// Files are independent from each other and are handled in parallel. Registering the modules depends on the order and is left to the caller.
+VerilogParseTiming ParseVerilogFiles(Array<VerilogFileWork> files,Arena* out){
+  TEMP_REGION(temp,out);
+  Time start = GetTime();
+  
+  VerilogParseState state = {};
+  state.files = files;
+
+  int amountOfWorkers = MAX(MIN(NumberThreads() + 1,files.size),1);
+  Array<WorkerArenas> arenas = CreateWorkerArenas(amountOfWorkers,temp);
+  Array<VerilogParseWorker> workers = PushArray<VerilogParseWorker>(temp,amountOfWorkers);
+  for(int i = 0; i < amountOfWorkers; i++){
+    workers[i] = {};
+    workers[i].state = &state;
+    workers[i].arenas = arenas[i];
+    workers[i].includes = PushStruct<Arena>(temp);
+    *workers[i].includes = InitArena(Megabyte(16));
+  }
+
+  if(amountOfWorkers == 1){
+    ParseVerilogFilesTask(0,&workers[0]);
+  } else {
+    WorkGroup* work = PushWorkGroup(temp,amountOfWorkers);
+    work->function = ParseVerilogFilesTask;
+    for(int i = 0; i < amountOfWorkers; i++){
+      work->tasks[i].args = &workers[i];
+    }
+
+    DoWorkAndParticipate(work);
+  }
+  
+  FreeWorkerArenas(arenas);
+  for(VerilogParseWorker& worker : workers){
+    Free(worker.includes);
+  }
+
+  VerilogParseTiming res = {};
+  res.threads = amountOfWorkers;
+  for(VerilogParseWorker& worker : workers){
+    res.preprocess = res.preprocess + worker.preprocess;
+    res.parse = res.parse + worker.parse;
+    res.extract = res.extract + worker.extract;
+    res.cache = res.cache + worker.cache;
+  }
+  for(VerilogFileWork& file : files){
+    res.modules += file.modules.size;
+    res.cachedFiles += (file.cached ? 1 : 0);
+  }
+  res.total = GetTime() - start;
+  
+  return res;
+}
+
+struct InstantiateState{
+  String content;
+  Array<Work*> level;
+  int nextWork;
+};
+
+struct InstantiateWorker{
+  InstantiateState* state;
+  WorkerArenas arenas;
+};
+
+static void InstantiateLevelTask(int id,void* args){
+  InstantiateWorker* worker = (InstantiateWorker*) args;
+  InstantiateState* state = worker->state;
+
+  SetWorkerArenas(worker->arenas);
+  
+  while(true){
+    int index = AtomicAdd(&state->nextWork,1) - 1;
+    if(index >= state->level.size){
+      break;
+    }
+
+    Work work = *state->level[index];
+
+    BeginRegistrationInto(work.declaration);
+    FUDeclaration* decl = InstantiateWorkDeclaration(state->content,work);
+    EndRegistrationInto();
+
+    FlattenWorkDeclaration(decl,work);
+  }
+}
+
+// Instantiates the work level by level. Each level is done in parallel by the thread pool while the main thread also works.
+void InstantiateWork(String content,Array<Array<Work*>> workByLevel,Arena* out){
+  TEMP_REGION(temp,out);
+  
+  int maxLevelSize = 0;
+  for(Array<Work*> level : workByLevel){
+    maxLevelSize = MAX(maxLevelSize,level.size);
+  }
+  
+  int amountOfWorkers = MIN(NumberThreads() + 1,maxLevelSize);
+
+  Array<WorkerArenas> arenas = CreateWorkerArenas(amountOfWorkers,temp);
+  Array<InstantiateWorker> workers = PushArray<InstantiateWorker>(temp,amountOfWorkers);
+  for(int i = 0; i < amountOfWorkers; i++){
+    workers[i].arenas = arenas[i];
+  }
+  
+  for(Array<Work*> level : workByLevel){
+    InstantiateState state = {};
+    state.content = content;
+    state.level = level;
+
+    for(InstantiateWorker& worker : workers){
+      worker.state = &state;
+    }
+
+    int levelWorkers = MIN(amountOfWorkers,level.size);
+    if(levelWorkers <= 1){
+      InstantiateLevelTask(0,&workers[0]);
+    } else {
+      WorkGroup* work = PushWorkGroup(temp,levelWorkers);
+      work->function = InstantiateLevelTask;
+      for(int i = 0; i < levelWorkers; i++){
+        work->tasks[i].args = &workers[i];
+      }
+
+      DoWorkAndParticipate(work);
+    }
+
+    for(Work* work : level){
+      PrintRegistrationReport(work->declaration);
+    }
+  }
+
+  FreeWorkerArenas(arenas);
+}
+
 int CopyFileGroup(Array<FileContent> fileGroup,String filepathBase,bool flattenedDirs,FilePurpose purpose){
   TEMP_REGION(temp,nullptr);
     
@@ -199,6 +575,64 @@ parse_opt (int key, char *arg,
     case 129: {
       opts->options->insertProfilingRegisters = true;
     } break;
+
+    case 130: {
+      opts->options->parallelClique = true;
+    } break;
+
+    case 131: {
+      opts->options->benchmarkClique = true;
+    } break;
+
+    case 132: {
+      opts->options->cliqueTime = ParseInt(arg);
+    } break;
+
+    case 133: {
+      opts->options->cliqueGap = ParseFloat(arg);
+    } break;
+
+    case 134: {
+      opts->options->disableCache = true;
+    } break;
+
+    case 135: {
+      opts->options->cachePath = arg;
+    } break;
+
+    case 136: {
+      opts->options->unitDelays = true;
+    } break;
+
+    case 137: {
+      opts->options->maxCombinatorialDepth = ParseInt(arg);
+    } break;
+
+    case 138: {
+      opts->options->verilatorThreads = ParseInt(arg);
+    } break;
+
+    case 139: {
+      opts->options->verilatorJobs = ParseInt(arg);
+    } break;
+
+    case 140: {
+      opts->options->verilatorCCache = true;
+    } break;
+
+    case 141: {
+      opts->options->verilatorPGO = true;
+    } break;
+
+    case 142: {
+      opts->options->verilatorOptLevel = ParseInt(arg);
+    } break;
+
+    case 143: {
+      opts->options->selfTest = true;
+    } break;
+
+    case 'j': opts->options->threads = ParseInt(arg); break;
       
     case 'g': opts->options->debugPath = arg; opts->options->debug = true; break;
     case 't': opts->options->topName = arg; break;
@@ -216,6 +650,20 @@ struct argp_option options[] =
   {
     { "debug", 128 ,0, 0, "Insert debug registers on the generated accelerator"},
     { "profile", 129 ,0, 0, "Insert profiling registers on the generated accelerator"},
+    { "parallel-clique", 130 ,0, 0, "Use the parallel clique search when merging (uses all processors unless -j is given)"},
+    { "benchmark-clique", 131 ,0, OPTION_HIDDEN, "Benchmark the clique search kernels with the consolidation graphs of every merge"},
+    { "clique-time", 132 ,"Seconds", 0, "Time limit of the clique search used when merging, 0 for no limit (default:10, no limit if --clique-gap is given)"},
+    { "clique-gap", 133 ,"Percent", 0, "Stop the clique search once the result is proven to be within this percentage of the optimum"},
+    { "no-cache", 134 ,0, 0, "Do not read or write the cache kept between runs (stored next to the hardware output path)"},
+    { "cache-dir", 135 ,"Path", 0, "Folder of the cache kept between runs (default: versat_cache next to the hardware output path)"},
+    { "unit-delays", 136 ,0, 0, "Align every unit as soon as its inputs are valid instead of minimizing the registers used by delay buffers"},
+    { "max-comb-depth", 137 ,"Units", 0, "Insert pipeline registers so that no path goes through more than this amount of combinatorial units (default:0, disabled)"},
+    { "verilator-threads", 138 ,"Threads", 0, "Threads used by the verilated pc-emul model (default:1). Programs linking libaccel.a must also link with -pthread"},
+    { "verilator-jobs", 139 ,"Jobs", 0, "Parallel jobs used to compile the verilated pc-emul model. Verilator output is split into smaller files when bigger than 1 (default:1)"},
+    { "verilator-ccache", 140 ,0, 0, "Compile the verilated pc-emul model through ccache"},
+    { "verilator-pgo", 141 ,0, 0, "The generated makefile builds the pc-emul model with profile guided optimization, using a benchmark run as training"},
+    { "verilator-opt", 142 ,"Level", 0, "Optimization level used to compile the pc-emul model (default:2, 3 when --verilator-pgo is given)"},
+    { "self-test", 143 ,0, OPTION_HIDDEN, "Run the compiler self tests and exit"},
     { 0, 'b',"Size",   0, "Databus size connected to external RAM (8,16,default:32,64,128,256)"},
     { 0, 'd', 0,       0, "Use DMA"},
     { 0, 'D', 0,       0, "Architecture has databus"},
@@ -224,6 +672,7 @@ struct argp_option options[] =
     { 0, 's', 0,       0, "Insert consts and regs if Top unit contains inputs and outputs"},
     { 0, 'S',"File",   0, "Extra sources"},
     { 0, 'I',"Path",   0, "Include paths"},
+    { 0, 'j',"Threads",0, "Number of threads used by the compiler (default:1)"},
     { 0, 'L',"Name",   0, "Writes to a file a list of all files generated by Versat"},
     { 0, 'o',"Path",   0, "Hardware output path"},
     { 0, 'O',"Path",   0, "Software output path"},
@@ -234,10 +683,54 @@ struct argp_option options[] =
     { 0 }
   };
 
+// Every test prints the checks that failed and returns how many
+static int RunSelfTests(){
+  struct SelfTest{
+    const char* name;
+    int (*function)();
+  };
+
+  SelfTest tests[] = {
+    {"DelayRegisters",TestDelayRegisters},
+    {"MergeCache",TestMergeCache},
+    {"ModuleInfoCache",TestModuleInfoCache},
+    {"Symbolic",TestSymbolic},
+    {"SymbolicProgram",TestSymbolicProgram}
+  };
+
+  int totalFailed = 0;
+  for(SelfTest test : tests){
+    int failed = test.function();
+    printf("%-24s %s\n",test.name,failed ? "FAILED" : "OK");
+    totalFailed += failed;
+  }
+
+  return (totalFailed == 0) ? 0 : -1;
+}
+
+// Returns false if a generated file could not be written
+bool CommitAndReportGeneratedFiles(){
+  TEMP_REGION(temp,nullptr);
+  
+  String manifestPath = PushString(temp,"%.*s/versat_manifest.txt",UN(globalOptions.hardwareOutputFilepath));
+  GeneratedFilesReport report = CommitGeneratedFiles(manifestPath,temp);
+
+  printf("Generated files: %d written, %d unchanged",report.written,report.unchanged);
+  if(report.failed){
+    printf(", %d failed",report.failed);
+  }
+  printf("\n");
+  for(String stale : report.stale){
+    printf("No longer generated: %.*s\n",UN(stale));
+  }
+
+  return (report.failed == 0);
+}
+
 void ReportFileCreation(bool allFiles = false){
   TEMP_REGION(temp,nullptr);
   for(FileInfo f : CollectAllFilesInfo(temp)){
-    if(allFiles || (f.purpose != FilePurpose_DEBUG_INFO && f.mode == FileOpenMode_WRITE)){
+    if(allFiles || (f.purpose != FilePurpose_DEBUG_INFO && f.purpose != FilePurpose_CACHE && f.mode == FileOpenMode_WRITE)){
       String type = FilePurpose_Name(f.purpose);
       printf("Filename: %.*s Type: %.*s\n",UN(f.filepath),UN(type));
     }
@@ -268,11 +761,6 @@ int main(int argc,char* argv[]){
   InitializeTemplateEngine(perm);
   InitializeSimpleDeclarations();
 
-#if 0
-  TestSymbolic();
-  return 0;
-#endif
-  
   argp argp = { options, parse_opt, "SpecFile\n-T UnitName", "Dataflow to accelerator compiler. Check tutorial in https://github.com/IObundle/iob-versat to learn how to write a specification file"};
 
   OptionsGather gather = {};
@@ -298,51 +786,50 @@ int main(int argc,char* argv[]){
     globalOptions.topName = globalOptions.specificationFilepath;
   }
 
+  if(globalOptions.threads <= 0){
+    globalOptions.threads = (globalOptions.parallelClique ? NumberProcessors() : 1);
+  }
+  // The main thread also performs work, the pool only contains the extra threads.
+  globalOptions.threads = std::min(globalOptions.threads,64);
+  if(globalOptions.threads > 1){
+    InitThreadPool(globalOptions.threads - 1);
+  }
+
+  // A gap target replaces the time limit unless both are given
+  if(globalOptions.cliqueTime < 0){
+    globalOptions.cliqueTime = (globalOptions.cliqueGap > 0.0f ? 0 : 10);
+  }
+
+  // Profile guided builds are only worth it on top of the more aggressive optimizations
+  if(globalOptions.verilatorOptLevel <= 0){
+    globalOptions.verilatorOptLevel = (globalOptions.verilatorPGO ? 3 : 2);
+  }
+  globalOptions.verilatorThreads = std::max(globalOptions.verilatorThreads,1);
+  globalOptions.verilatorJobs = std::max(globalOptions.verilatorJobs,1);
+
   globalOptions.hardwareOutputFilepath = OS_NormalizePath(globalOptions.hardwareOutputFilepath,temp);
   globalOptions.softwareOutputFilepath = OS_NormalizePath(globalOptions.softwareOutputFilepath,temp);
+  if(Empty(globalOptions.cachePath)){
+    globalOptions.cachePath = PushString(temp,"%.*s/../versat_cache",UN(globalOptions.hardwareOutputFilepath));
+  }
+  globalOptions.cachePath = OS_NormalizePath(globalOptions.cachePath,temp);
 
   globalDebug.outputGraphs = true;
   globalDebug.outputConsolidationGraphs = true;
   globalDebug.outputVCD = true;
   
-  if(Empty(globalOptions.topName)){
+  // Self tests use their own cache folders
+  if(globalOptions.selfTest){
+    globalOptions.disableCache = true;
+  }
+  
+  if(Empty(globalOptions.topName) && !globalOptions.selfTest){
     char name[] = "versat";
     argp_help(&argp,stdout,ARGP_HELP_STD_HELP,name);
     printf("\nNeed to specify top unit with -t\n");
     exit(-1);
   }
   
-  // Register Versat common files. 
-  bool anyError = false;
-  for(FileContent file : defaultVerilogUnits){
-    String content = file.content;
-    
-    String processed = PreprocessVerilogFile(content,globalOptions.includePaths,temp);
-    Array<Module> modules = ParseVerilogFile(processed,globalOptions.includePaths,temp);
-    
-    for(Module& mod : modules){
-      ModuleInfo info = ExtractModuleInfo(mod,perm);
-      Opt<FUDeclaration*> inst = RegisterModuleInfo(&info,perm);
-      anyError |= !inst.has_value();
-    }
-  }
-
-  if(anyError){
-    return -1;
-  }
-  
-  // We need to do this after parsing the modules because the majority of these special types come from verilog files
-  // NOTE: This should never fail since the verilog files are embedded into the exe. A fail in here means that we failed to embed the necessary files at build time
-  BasicDeclaration::buffer = GetTypeByNameOrFail("Buffer");
-  BasicDeclaration::fixedBuffer = GetTypeByNameOrFail("FixedBuffer");
-  BasicDeclaration::pipelineRegister = GetTypeByNameOrFail("PipelineRegister");
-  BasicDeclaration::multiplexer = GetTypeByNameOrFail("Mux2");
-  BasicDeclaration::combMultiplexer = GetTypeByNameOrFail("CombMux2");
-  BasicDeclaration::stridedMerge = GetTypeByNameOrFail("StridedMerge");
-  BasicDeclaration::timedMultiplexer = GetTypeByNameOrFail("TimedMux");
-  BasicDeclaration::input = GetTypeByNameOrFail("CircuitInput");
-  BasicDeclaration::output = GetTypeByNameOrFail("CircuitOutput");
-
   // Collect all user verilog source files.
   bool error = false;
   Array<String> allVerilogFiles = {};
@@ -382,23 +869,62 @@ int main(int argc,char* argv[]){
   
   // NOTE: We process all the folders and just replace verilogFiles with all the filepaths in here.
   globalOptions.verilogFiles = allVerilogFiles;
+
+  // Versat common files and user files are parsed together. Registration is done afterwards in the same order as the files.
+  int numberDefaultUnits = defaultVerilogUnits.size;
+  Array<VerilogFileWork> verilogWork = PushArray<VerilogFileWork>(temp,numberDefaultUnits + globalOptions.verilogFiles.size);
+  for(int i = 0; i < verilogWork.size; i++){
+    verilogWork[i] = {};
+    if(i < numberDefaultUnits){
+      verilogWork[i].content = defaultVerilogUnits[i].content;
+    } else {
+      verilogWork[i].filepath = globalOptions.verilogFiles[i - numberDefaultUnits];
+    }
+  }
+  Array<VerilogFileWork> defaultUnitsWork = {verilogWork.data,numberDefaultUnits};
+  Array<VerilogFileWork> userUnitsWork = {verilogWork.data + numberDefaultUnits,globalOptions.verilogFiles.size};
   
-  // Parse verilog files and register all the user supplied units.
+  VerilogParseTiming parseTiming = ParseVerilogFiles(verilogWork,temp);
+  Time registerStart = GetTime();
+
+  // Register Versat common files. 
+  bool anyError = false;
+  for(VerilogFileWork& file : defaultUnitsWork){
+    for(ModuleInfo& info : file.modules){
+      Opt<FUDeclaration*> inst = RegisterModuleInfo(&info,perm);
+      anyError |= !inst.has_value();
+    }
+  }
+
+  if(anyError){
+    return -1;
+  }
+  
+  // We need to do this after parsing the modules because the majority of these special types come from verilog files
+  // NOTE: This should never fail since the verilog files are embedded into the exe. A fail in here means that we failed to embed the necessary files at build time
+  BasicDeclaration::buffer = GetTypeByNameOrFail("Buffer");
+  BasicDeclaration::fixedBuffer = GetTypeByNameOrFail("FixedBuffer");
+  BasicDeclaration::pipelineRegister = GetTypeByNameOrFail("PipelineRegister");
+  BasicDeclaration::multiplexer = GetTypeByNameOrFail("Mux2");
+  BasicDeclaration::combMultiplexer = GetTypeByNameOrFail("CombMux2");
+  BasicDeclaration::stridedMerge = GetTypeByNameOrFail("StridedMerge");
+  BasicDeclaration::timedMultiplexer = GetTypeByNameOrFail("TimedMux");
+  BasicDeclaration::input = GetTypeByNameOrFail("CircuitInput");
+  BasicDeclaration::output = GetTypeByNameOrFail("CircuitOutput");
+
+  if(globalOptions.selfTest){
+    return RunSelfTests();
+  }
+
+  // Register all the user supplied units.
   error = false;
-  for(String filepath : globalOptions.verilogFiles){
-    String content = PushFile(temp,filepath);
-    
-    if(Empty(content)){
-      printf("Failed to open file %.*s\n. Exiting\n",UN(filepath));
+  for(VerilogFileWork& file : userUnitsWork){
+    if(file.failedToOpen){
+      printf("Failed to open file %.*s\n. Exiting\n",UN(file.filepath));
       exit(-1);
     }
-
-    String processed = PreprocessVerilogFile(content,globalOptions.includePaths,temp);
-    Array<Module> modules = ParseVerilogFile(processed,globalOptions.includePaths,temp);
     
-    for(Module& mod : modules){
-      ModuleInfo info = ExtractModuleInfo(mod,perm);
-
+    for(ModuleInfo& info : file.modules){
       FUDeclaration* decl = GetTypeByName(info.name);
       if(decl){
         once(){
@@ -417,6 +943,10 @@ int main(int argc,char* argv[]){
     return -1;
   }
 
+  printf("Verilog units: %d files (%d cached), %d modules in %.3fs using %d threads (preprocess %.3fs, parse %.3fs, extract %.3fs, cache %.3fs summed over threads, register %.3fs)\n",
+         verilogWork.size,parseTiming.cachedFiles,parseTiming.modules,ToSeconds(parseTiming.total),parseTiming.threads,
+         ToSeconds(parseTiming.preprocess),ToSeconds(parseTiming.parse),ToSeconds(parseTiming.extract),ToSeconds(parseTiming.cache),ElapsedSeconds(registerStart));
+
   // TODO: The testbench logic is kinda addhoc right now. Need to join together the other logic and them create a proper switch between these two.
   if(globalOptions.opMode == VersatOperationMode_GENERATE_TESTBENCH){
     String topLevelUnit = globalOptions.topName;
@@ -429,18 +959,21 @@ int main(int argc,char* argv[]){
     }
 
     String path = PushString(temp,"%.*s/../%.*s_tb.v",UN(globalOptions.hardwareOutputFilepath),UN(decl->name));
-    FILE* testbenchLocation = OpenFileAndCreateDirectories(path,"w",FilePurpose_VERILOG_CODE);
-    DEFER_CLOSE_FILE(testbenchLocation);
+    {
+      FILE* testbenchLocation = OpenFileAndCreateDirectories(path,"w",FilePurpose_VERILOG_CODE);
+      DEFER_CLOSE_FILE(testbenchLocation);
 
-    OutputTestbench(decl,testbenchLocation);
+      OutputTestbench(decl,testbenchLocation);
+    }
 
     int res = CopyFileGroup(defaultVerilogFiles,globalOptions.hardwareOutputFilepath,true,FilePurpose_VERILOG_COMMON_CODE);
     if(res){
       return res;
     }
     
+    bool committed = CommitAndReportGeneratedFiles();
     ReportFileCreation(true);
-    return 0;
+    return committed ? 0 : -1;
   }
   
   String specFilepath = globalOptions.specificationFilepath;
@@ -618,63 +1151,30 @@ int main(int argc,char* argv[]){
     topWork->calculateDelayFixedGraph = true;
     topWork->flattenWithMapping = true;
       
-    for(auto p : typeToWork){
-      Work work = *p.second;
+    // Declarations keep the order of the work, no matter the order in which they are instantiated.
+    for(int i : order){
+      typeToWork->GetOrFail(modules[i].base.name).declaration = ReserveFU();
+    }
 
-      FUDeclaration* decl = nullptr;
-      
-      if(work.definition.type == ConstructType_MODULE){
-        decl = InstantiateBarebonesSpecifications(content,p.second->definition);
-      } else if(work.definition.type == ConstructType_MERGE){
-        decl = InstantiateSpecifications(content,p.second->definition);
-      }
-      decl->singleInterfaces |= SingleInterfaces_SIGNAL_LOOP;
-      
-#if 0
-      if(work.calculateDelayFixedGraph){
-        Accelerator* copy = CopyAccelerator(decl->baseCircuit,AcceleratorPurpose_FIXED_DELAY,true,nullptr);
-
-        DAGOrderNodes order = CalculateDAGOrder(&copy->allocated,temp);
-        CalculateDelayResult delays = CalculateDelay(copy,order,temp);
-
-        decl->baseConfig.calculatedDelays = PushArray<int>(perm,delays.nodeDelay->nodesUsed);
-        Memset(decl->baseConfig.calculatedDelays,0);
-        int index = 0;
-        for(Pair<FUInstance*,DelayInfo*> p : delays.nodeDelay){
-          if(p.first->declaration->baseConfig.delayOffsets.max > 0){
-            decl->baseConfig.calculatedDelays[index] = p.second->value;
-            index += 1;
-          }
-        }
+    // Modules in the same level are independent from each other and are instantiated in parallel.
+    Array<int> levels = CalculateDAGLevels(size,edges,order,temp);
+    int maxLevel = -1;
+    for(int i : order){
+      maxLevel = MAX(maxLevel,levels[i]);
+    }
 
-        region(temp){
-          FixDelays(copy,delays.edgesDelay,temp);
+    Array<Array<Work*>> workByLevel = PushArray<Array<Work*>>(temp,maxLevel + 1);
+    for(int level = 0; level <= maxLevel; level++){
+      auto arr = StartArray<Work*>(temp);
+      for(int i : order){
+        if(levels[i] == level){
+          *arr.PushElem() = &typeToWork->GetOrFail(modules[i].base.name);
         }
-
-        decl->fixedDelayCircuit = copy;
-        decl->fixedDelayCircuit->name = decl->name;
-
-        FillDeclarationWithDelayType(decl);
-      }
-#endif
-
-#if 0
-      if(work.definition.type == ConstructType_MODULE && work.definition.module.name == "ModuleWithExtra"){
-        auto p = FlattenWithMerge(decl->baseCircuit,0);
-
-        DebugRegionOutputDotGraph(p.accel,"FlattenReconAttemp0");
-      }
-#endif
-      
-      // Flatten with mapping seems to be specific to modules.
-      // Merge circuits are already flatten by the way the merge is performed.
-      if(work.definition.type != ConstructType_MERGE && work.flattenWithMapping){
-        Pair<Accelerator*,SubMap*> p = Flatten(decl->baseCircuit,99);
-        
-        decl->flattenedBaseCircuit = p.first;
-        decl->flattenMapping = p.second;
       }
+      workByLevel[level] = EndArray(arr);
     }
+
+    InstantiateWork(content,workByLevel,temp);
   }
 
   FUDeclaration* type = GetTypeByName(topLevelTypeStr);
@@ -719,6 +1219,7 @@ int main(int argc,char* argv[]){
     }
     
     type = RegisterSubUnit(accel);
+    PrintRegistrationReport(type);
     type->singleInterfaces |= SingleInterfaces_SIGNAL_LOOP;
 
     accel = CreateAccelerator(topLevelTypeStr,AcceleratorPurpose_MODULE);
@@ -761,6 +1262,7 @@ int main(int argc,char* argv[]){
     }
     
     type = RegisterSubUnit(accel);
+    PrintRegistrationReport(type);
     type->definitionArrays = PushArray<Pair<String,int>>(perm,2);
     type->definitionArrays[0] = (Pair<String,int>){"input",input};
     type->definitionArrays[1] = (Pair<String,int>){"output",output};
@@ -906,9 +1408,10 @@ int main(int argc,char* argv[]){
   }
   
   // This should be the last thing that we do, no further file creation can occur after this point
+  bool committed = CommitAndReportGeneratedFiles();
   ReportFileCreation();
 
-  return 0;
+  return committed ? 0 : -1;
 }
 
 /* ============================================================================
@@ -1762,6 +1762,7 @@ Opt<AddressGenDef> ParseAddressGen(Tokenizer* tok,Arena* out){
   EXPECT(tok,"{");
 
   ArenaList<AddressGenForDef>* loops = PushArenaList<AddressGenForDef>(temp);
+  ArenaList<AddressGenSpecializeDef>* specializations = PushArenaList<AddressGenSpecializeDef>(temp);
   SymbolicExpression* symbolic = nullptr;
   while(!tok->Done()){
     Token construct = tok->PeekToken();
@@ -1785,6 +1786,37 @@ Opt<AddressGenDef> ParseAddressGen(Tokenizer* tok,Arena* out){
       PROPAGATE(end);
       
       *loops->PushElem() = (AddressGenForDef){.loopVariable = loopVariable,.start = start,.end = end};
+    } else if(CompareString(construct,"specialize")){
+      // specialize a = 16, b = 32;
+      tok->AdvancePeek();
+
+      ArenaList<Token>* inputs = PushArenaList<Token>(temp);
+      ArenaList<int>* values = PushArenaList<int>(temp);
+      while(!tok->Done()){
+        Token input = tok->NextToken();
+        CHECK_IDENTIFIER(input);
+
+        EXPECT(tok,"=");
+
+        Opt<int> value = ParseNumber(tok);
+        PROPAGATE(value);
+
+        *inputs->PushElem() = input;
+        *values->PushElem() = value.value();
+        
+        if(tok->IfNextToken(",")){
+          continue;
+        } else {
+          break;
+        }
+      }
+
+      EXPECT(tok,";");
+
+      AddressGenSpecializeDef spec = {};
+      spec.inputs = PushArrayFromList(out,inputs);
+      spec.values = PushArrayFromList(out,values);
+      *specializations->PushElem() = spec;
     } else if(CompareString(construct,"addr")){
       tok->AdvancePeek();
 
@@ -1796,6 +1828,8 @@ Opt<AddressGenDef> ParseAddressGen(Tokenizer* tok,Arena* out){
       
       EXPECT(tok,";");
       break;
+    } else {
+      UNEXPECTED(construct);
     }
   }
 
@@ -1810,6 +1844,7 @@ Opt<AddressGenDef> ParseAddressGen(Tokenizer* tok,Arena* out){
   def.name = name;
   def.inputs = inputsArr;
   def.loops = PushArrayFromList(out,loops);
+  def.specializations = PushArrayFromList(out,specializations);
   def.symbolic = symbolic;
   
   return def;
@@ -124,10 +124,17 @@ struct AddressGenForDef{
   SymbolicExpression* end;
 };
 
+// Set of input values for which the address gen configuration is precomputed at generation time
+struct AddressGenSpecializeDef{
+  Array<Token> inputs;
+  Array<int> values;
+};
+
 struct AddressGenDef : public DefBase{
   AddressGenType type;
   Array<Token> inputs;
   Array<AddressGenForDef> loops;
+  Array<AddressGenSpecializeDef> specializations;
   SymbolicExpression* symbolic;
 };
 
@@ -91,6 +91,22 @@ void SignalLoop(){
   MEMSET(versat_base,VersatRegister_Control,0x40000000);
 }
 
+// There is only one accelerator, so the batch runs one after the other. The configuration registers cannot be read back, accelConfig keeps the one of the last run
+void VersatRunBatch(const @{typeName}Config* configs,@{typeName}State* states,int amount){
+  for(int i = 0; i < amount; i++){
+    VersatMemoryCopy(accelConfig,&configs[i],sizeof(configs[i]));
+    RunAccelerator(1);
+
+    volatile int* stateView = (volatile int*) accelState;
+    int* out = (int*) &states[i];
+    for(int k = 0; k < (int) (sizeof(states[i]) / sizeof(int)); k++){
+      out[k] = stateView[k];
+    }
+  }
+}
+
+void ConfigBatchWorkers(int workers){}
+
 void VersatMemoryCopy(volatile void* dest,volatile const void* data,int size){
   if(size <= 0){
     return;
@@ -145,7 +161,17 @@ void ConfigEnableDMA(bool value){
 }
 
 void ConfigCreateVCD(bool value){}
+void ConfigAsyncAccelerator(bool value){}
 void ConfigSimulateDatabus(bool value){}
+void ConfigCrossCheckAddressGen(bool value){}
+void ConfigTraceCycles(int start,int end){}
+void ConfigTraceRuns(int first,int end){}
+bool ConfigTraceTrigger(const char* expression,int cycles){return false;}
+void ConfigTraceRing(int cycles){}
+void ConfigMemoryModel(VersatMemoryModel model){}
+VersatMemoryModel VersatTypicalMemoryModel(){return (VersatMemoryModel){};}
+int VersatProfileDatabusInterfaces(){return 0;}
+VersatDatabusProfile VersatProfileGetDatabus(int index){return (VersatDatabusProfile){};}
 int SimulateAddressGen(iptr* arrayToFill,int arraySize,AddressVArguments args){return 0;}
 SimulateVReadResult SimulateVRead(AddressVArguments args){return (SimulateVReadResult){};}
 
@@ -63,6 +63,11 @@ void StartAccelerator(); // Also waits for previous run to end if accelerator is
 void EndAccelerator(); // Ensure the accelerator as finished running
 void ResetAccelerator();
 
+// Runs the accelerator once for each configuration and stores the state it ends with. The accelerator is left with the configuration of the last run.
+// Precondition: runs must be independent, no run can read memory written by another run of the batch. pc-emul runs them in worker processes forked at the call or, when it cannot fork, one after the other like embedded. Memory written by the units is only seen by the caller in the latter case, so it must be treated as undefined after the call
+void VersatRunBatch(const @{typeName}Config* configs,@{typeName}State* states,int amount);
+void ConfigBatchWorkers(int workers); // Processes used by VersatRunBatch in pc-emul, zero (default) uses one per processor
+
 // Fast data movement using internal Versat DMA if possible, otherwise regular memcpy style functions
 void VersatMemoryCopy(volatile void* dest,volatile const void* data,int byteSize);
 void VersatUnitWrite(volatile const void* baseaddr,int index,int val);
@@ -91,17 +96,52 @@ typedef struct{
   uint64_t configurationsSetWhileRunning;
 } VersatProfile;
 
+// Databus usage of a single unit interface. Only pc-emul tracks these, embedded reports no interfaces
+typedef struct{
+  const char* unitName;
+  uint64_t databusValid;
+  uint64_t databusValidAndReady;
+  uint64_t bytesTransferred;
+} VersatDatabusProfile;
+
 void             DebugRunAccelerator(int times, int maxCycles); // Mainly for cases where the accelerator is hanging, we put a upper bound in the amount of cycles that we wait for.
 VersatDebugState VersatDebugGetState();
 VersatProfile    VersatProfileGet();
 void             VersatProfileReset();
 void             VersatPrintProfile(VersatProfile profile);
 
+int                  VersatProfileDatabusInterfaces();
+VersatDatabusProfile VersatProfileGetDatabus(int index);
+
 // PC-Emul side functions that allow to enable or disable certain portions of the emulation
 // Their embedded counterparts simply do nothing
 void ConfigEnableDMA(bool value);
 void ConfigCreateVCD(bool value);
+void ConfigAsyncAccelerator(bool value); // StartAccelerator returns right away and a background thread simulates the run until EndAccelerator, like in hardware. Firmware accesses to the accelerator are interleaved with its cycles
 void ConfigSimulateDatabus(bool value); 
+void ConfigCrossCheckAddressGen(bool value); // Simulate functions also run the Verilated SuperAddress unit and report any difference
+
+// Timing of the memory behind the databus when it is simulated. Disabled by default, in which case every unit gets one transfer per cycle as soon as it asks
+typedef struct{
+  bool enabled;
+  int burstLatency; // Cycles from a burst being issued to its first transfer
+  int cyclesPerBeat; // Shared bandwidth, cycles between transfers of the data bus
+  int maxOutstanding; // Bursts in flight at once for reads and for writes (max 16)
+  bool halfDuplex; // Reads and writes share the data bus, like DRAM, instead of having separate channels like AXI
+  int banks; // Zero disables the bank and row model (max 64)
+  int rowBytes;
+  int rowHitLatency; // Added to burstLatency when the row of the bank is open
+  int rowMissLatency; // Added to burstLatency when the bank must open another row
+} VersatMemoryModel;
+
+void ConfigMemoryModel(VersatMemoryModel model);
+VersatMemoryModel VersatTypicalMemoryModel(); // Rough values for a DDR memory behind an AXI interconnect
+
+// Waveform capture windows (only when the model was verilated with trace enabled). Every cycle is traced by default, each window set only keeps the cycles inside it
+void ConfigTraceCycles(int start,int end); // Trace cycles in [start,end), negative end means until the end
+void ConfigTraceRuns(int first,int end); // Trace from the start of accelerator run first (zero based) until the start of run end, negative end means until the end
+bool ConfigTraceTrigger(const char* expression,int cycles); // "signal" or "signal op value" (op: == != < <= > >=) on a top level signal. Traces cycles after it first holds, negative cycles means until the end. Returns false if the expression is invalid
+void ConfigTraceRing(int cycles); // Only keep the last traced cycles (at least cycles of them). They are split in data only segments that must be appended to the first file, which holds the header. The files are reported when the program exits
 
 @{AddressStruct}
 
@@ -163,6 +203,25 @@ static inline iptr ALIGN(iptr base,iptr alignment){
   return result;
 }
 
+// Same as ALIGN but usable inside constant initializers (precomputed address gen configurations)
+#define VERSAT_ALIGN(base,alignment) ((((base) + (alignment) - 1) / (alignment)) * (alignment))
+
+// Bus cycles lost per AXI burst (address handshake and read latency)
+#ifndef VERSAT_AXI_BURST_OVERHEAD
+  #define VERSAT_AXI_BURST_OVERHEAD 8
+#endif
+
+// Predicted bus cycles of an external access made of amount transfers of lengthBytes each. Bursts contain at most 256 beats and never cross a 4KB boundary. Used to choose between the single and double loop versions of an address gen.
+static inline iptr VersatExternalAccessCost(iptr lengthBytes,iptr amount){
+  iptr beatBytes = VERSAT_AXI_DATA_W / 8;
+  iptr maxBurstBytes = (256 * beatBytes < 4096) ? 256 * beatBytes : 4096;
+
+  iptr beats = (lengthBytes + beatBytes - 1) / beatBytes;
+  iptr bursts = (lengthBytes + maxBurstBytes - 1) / maxBurstBytes;
+
+  return amount * (bursts * VERSAT_AXI_BURST_OVERHEAD + beats);
+}
+
 extern volatile AcceleratorStatic* accelStatic;
 
 @{allStaticDefines}
@@ -9,7 +9,28 @@ HARDWARE_SRC += @{moduleUnits}
 VERILATOR_ROOT?=$(shell ./GetVerilatorRoot.sh)
 INCLUDE := -I$(HARDWARE_FOLDER)
 
-VERILATOR_COMMON_ARGS := --report-unoptflat -GLEN_W=20 -CFLAGS "-O2 -march=native" $(INCLUDE)
+# Build acceleration, defaults given by the versat --verilator-* flags.
+# Link with -pthread, the wrapper simulates asynchronous runs in a thread and so do multithreaded models (VERILATOR_THREADS > 1).
+VERILATOR_THREADS ?= @{verilatorThreads}
+BUILD_JOBS ?= @{buildJobs}
+OUTPUT_SPLIT ?= @{outputSplit}
+CCACHE ?= @{ccache}
+OPT_FLAGS ?= @{optimizationFlags}
+BENCHMARK_CYCLES ?= 1000000
+
+# Profile guided optimization stage, set by the pgo.stamp target (generate or use)
+PGO ?=
+PGO_DIR := $(abspath ./pgo_data)
+ifeq ($(PGO),generate)
+PGO_FLAGS := -fprofile-generate=$(PGO_DIR)
+endif
+ifeq ($(PGO),use)
+PGO_FLAGS := -fprofile-use=$(PGO_DIR) -fprofile-partial-training -Wno-missing-profile
+endif
+
+CXX_FLAGS := -march=native $(OPT_FLAGS) $(PGO_FLAGS)
+
+VERILATOR_COMMON_ARGS := --report-unoptflat -GLEN_W=20 -CFLAGS "$(CXX_FLAGS)" $(INCLUDE)
 VERILATOR_COMMON_ARGS += -GAXI_ADDR_W=$(shell getconf LONG_BIT)
 VERILATOR_COMMON_ARGS += -GAXI_DATA_W=@{databusDataSize}
 VERILATOR_COMMON_ARGS += -GDATA_W=32
@@ -17,9 +38,28 @@ VERILATOR_COMMON_ARGS += -GDELAY_W=20
 VERILATOR_COMMON_ARGS += -GLEN_W=20
 VERILATOR_COMMON_ARGS += @{traceType}
 
+ifneq ($(OUTPUT_SPLIT),0)
+VERILATOR_COMMON_ARGS += --output-split $(OUTPUT_SPLIT) --output-split-cfuncs $(OUTPUT_SPLIT)
+endif
+
 VERILATOR_SUPERADDRESS_ARGS := $(filter-out -GAXI_DATA_W=%, $(VERILATOR_COMMON_ARGS))
 
-all: libaccel.a
+# Only the accelerator model is big enough to gain from threads and profiling
+VERILATOR_TOP_ARGS :=
+ifneq ($(VERILATOR_THREADS),1)
+VERILATOR_TOP_ARGS += --threads $(VERILATOR_THREADS)
+endif
+ifeq ($(PGO),generate)
+VERILATOR_TOP_ARGS += --prof-pgo
+endif
+ifeq ($(PGO),use)
+VERILATOR_TOP_ARGS += $(wildcard profile.vlt)
+endif
+
+# Verilator generated makefiles compile with OPT_FAST/OPT_SLOW/OPT_GLOBAL and prefix the compiler with OBJCACHE
+VERILATOR_MAKE_ARGS := -j$(BUILD_JOBS) OBJCACHE="$(CCACHE)" OPT_FAST="$(OPT_FLAGS)" OPT_SLOW="$(OPT_FLAGS)" OPT_GLOBAL="$(OPT_FLAGS)"
+
+all: @{defaultTarget}
 
 # Joins wrapper with verilator object files into a library
 libaccel.a: $(VHEADER) wrapper.o createVerilatorObjects $(VSIM_HEADER)
@@ -32,26 +72,55 @@ VUnitWireInfo.h: $(VHEADER)
 	./ExtractVerilatedSignals.py $(VHEADER) > VUnitWireInfo.h
 
 $(VHEADER): $(HARDWARE_SRC)
-	verilator $(VERILATOR_COMMON_ARGS) -GADDR_W=@{addressSize} --cc $(HARDWARE_SRC) --top-module $(TYPE_NAME)
-	$(MAKE) -C ./obj_dir -f V$(TYPE_NAME).mk
+	verilator $(VERILATOR_COMMON_ARGS) $(VERILATOR_TOP_ARGS) -GADDR_W=@{addressSize} --cc $(HARDWARE_SRC) --top-module $(TYPE_NAME)
+	$(MAKE) $(VERILATOR_MAKE_ARGS) -C ./obj_dir -f V$(TYPE_NAME).mk
 	cp ./obj_dir/*.h ./
 
 VSuperAddress.h: $(HARDWARE_SRC)
 	verilator $(VERILATOR_SUPERADDRESS_ARGS) -GADDR_W=32 --cc $(HARDWARE_FOLDER)/SuperAddress.v --top-module SuperAddress
-	$(MAKE) -C ./obj_dir -f VSuperAddress.mk
+	$(MAKE) $(VERILATOR_MAKE_ARGS) -C ./obj_dir -f VSuperAddress.mk
 	cp ./obj_dir/*.h ./
 
 wrapper.o: $(VHEADER) VUnitWireInfo.h wrapper.cpp $(VSIM_HEADER)
-	g++ -std=c++17 -march=native -O2 -g -c -o wrapper.o -I $(VERILATOR_ROOT)/include $(abspath wrapper.cpp)
+	$(CCACHE) g++ -std=c++17 $(CXX_FLAGS) -g -c -o wrapper.o -I $(VERILATOR_ROOT)/include $(abspath wrapper.cpp)
 
 # Created after calling verilator. Need to recall make to have access to the variables
 -include ./obj_dir/V$(TYPE_NAME)_classes.mk
 
 VERILATOR_SOURCE_DIR:=$(VERILATOR_ROOT)/include
 ALL_VERILATOR_FILES:=$(VM_GLOBAL_FAST) $(VM_GLOBAL_SLOW)
+ifneq ($(VERILATOR_THREADS),1)
+ALL_VERILATOR_FILES:=$(sort $(ALL_VERILATOR_FILES) verilated_threads)
+endif
 ALL_VERILATOR_O:=$(patsubst %,./obj_dir/%.o,$(ALL_VERILATOR_FILES))
 
 ./obj_dir/%.o: $(VERILATOR_SOURCE_DIR)/%.cpp
-	g++ -w -march=native -O2 -c -o $@ $< -I$(VERILATOR_ROOT)/include
+	$(CCACHE) g++ -w $(CXX_FLAGS) -c -o $@ $< -I$(VERILATOR_ROOT)/include
 
 verilatorObjects: $(ALL_VERILATOR_O)
+
+# Runs the accelerator model on its own, without firmware, and reports the simulated cycles per second
+benchmark: versat_benchmark
+	./versat_benchmark $(BENCHMARK_CYCLES)
+
+versat_benchmark: libaccel.a
+	$(CCACHE) g++ -std=c++17 $(CXX_FLAGS) -g -DVERSAT_BENCHMARK -o versat_benchmark -I $(VERILATOR_ROOT)/include $(abspath wrapper.cpp) $(wildcard ./obj_dir/*.o) -pthread
+
+# Profile guided build: an instrumented model is trained by the benchmark and then rebuilt using the profile.
+# Verilator uses the profile (profile.vlt) to balance threads and g++ uses it (PGO_DIR) to optimize the code.
+pgo.stamp: $(HARDWARE_SRC) wrapper.cpp
+	$(MAKE) clean-build
+	rm -rf $(PGO_DIR) profile.vlt
+	$(MAKE) PGO=generate benchmark
+	$(MAKE) clean-build
+	$(MAKE) PGO=use libaccel.a
+	touch pgo.stamp
+
+pgo:
+	rm -f pgo.stamp
+	$(MAKE) pgo.stamp
+
+clean-build:
+	rm -rf ./obj_dir wrapper.o libaccel.a versat_benchmark V$(TYPE_NAME).h VSuperAddress.h VUnitWireInfo.h
+
+.PHONY: all createVerilatorObjects verilatorObjects benchmark pgo clean-build
@@ -6,6 +6,9 @@
 #include <cstdint>
 #include <cstdio>
 #include <cassert>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #define Assert(x) assert(x)
 
 #include "versat_accel.h" // TODO: Is this needed? We technically have all the data that we need to not depend on this header and removing this dependency could simplify the build process. Take a look later
@@ -83,6 +86,13 @@ struct Array{
 struct DatabusAccess{
    int counter;
    int latencyCounter;
+   bool beatAllowed; // Set by the memory model every cycle
+};
+
+struct DatabusRequest{
+   bool valid;
+   bool write;
+   iptr address;
 };
 
 // ============================================================================
@@ -93,6 +103,7 @@ static V@{typeName}* dut = NULL;
 VersatPrintf versatPrintf;
 bool CreateVCD;
 bool SimulateDatabus;
+bool CrossCheckAddressGen;
 bool versatInitialized;
 
 static @{typeName}Config configBuffer = {};
@@ -104,6 +115,87 @@ volatile @{typeName}Config* accelConfig = (volatile @{typeName}Config*) &configB
 volatile @{typeName}State* accelState = (volatile @{typeName}State*) &stateBuffer;
 volatile AcceleratorStatic* accelStatic = (volatile AcceleratorStatic*) &staticBuffer;
 
+static int cyclesDone = 0;
+static int runsStarted = 0;
+
+// Profiling counters, equivalent to the registers inserted by --profile but computed from the simulation
+static VersatProfile profile = {};
+static VersatDatabusProfile databusProfile[@{nIOs}] = {};
+static iptr configSnapshot[sizeof(configBuffer) / sizeof(iptr)] = {};
+
+@{databusOwners}
+
+// Asynchronous runs (ConfigAsyncAccelerator) are simulated by simThread, which holds simMutex while it simulates and hands it over in between cycles whenever the firmware is waiting to access the model
+static bool asyncAccelerator = false;
+static std::thread* simThread = NULL;
+static std::mutex simMutex;
+static std::atomic<int> firmwareWaiting(0);
+
+struct FirmwareAccess{
+  FirmwareAccess(){
+    firmwareWaiting += 1;
+    simMutex.lock();
+    firmwareWaiting -= 1;
+  }
+  ~FirmwareAccess(){
+    simMutex.unlock();
+  }
+};
+
+// ============================================================================
+// Waveform capture
+
+// Every cycle is traced by default. Each window that is set further restricts which cycles are dumped. Cycles that are not dumped only pay for eval, the trace state is decided once per cycle by UpdateTraceState.
+enum TraceCompare{
+  TraceCompare_NOT_ZERO,
+  TraceCompare_EQUAL,
+  TraceCompare_DIFFERENT,
+  TraceCompare_LESS,
+  TraceCompare_LESS_EQUAL,
+  TraceCompare_GREATER,
+  TraceCompare_GREATER_EQUAL
+};
+
+struct TraceControl{
+  int startCycle;
+  int endCycle; // Exclusive, negative means no end
+
+  bool runWindow;
+  int startRun;
+  int endRun; // Exclusive, negative means no end
+
+  int triggerSignal; // Index into traceSignalNames, negative when there is no trigger
+  TraceCompare triggerCompare;
+  long long triggerValue;
+  int triggerCycles; // Negative means until the end
+  int triggeredAt; // Negative while the trigger has not fired
+
+  int ringCycles; // Zero means no ring buffer
+  int ringSegment; // Segment being written, zero is the file opened first
+  int ringSegmentCycles; // Accelerator cycles dumped into the current segment
+};
+
+static TraceControl traceControl = {0,-1,false,0,-1,-1,TraceCompare_NOT_ZERO,0,-1,-1,0,0,0};
+static bool traceDumping = false;
+
+template<typename T>
+static long long TraceSignalToInt(const T& value){
+  return (long long) value;
+}
+
+// Wide signals only compare their lower bits
+template<typename T,size_t N>
+static long long TraceSignalToInt(const T (&value)[N]){
+  return (long long) value[0];
+}
+
+template<size_t N>
+static long long TraceSignalToInt(const VlWide<N>& value){
+  return (long long) value[0];
+}
+
+@{traceSignals}
+
 // ============================================================================
 // Utilities
 
@@ -114,7 +206,7 @@ volatile AcceleratorStatic* accelStatic = (volatile AcceleratorStatic*) &staticB
 #define UPDATE(unit) \
    unit->clk = 0; \
    unit->eval(); \
-   if(CreateVCD) tfp->dump(contextp->time()); \
+   if(traceDumping) tfp->dump(contextp->time()); \
    contextp->timeInc(2); \
    unit->clk = 1; \
    unit->eval();
@@ -142,6 +234,169 @@ static char* Bin(unsigned int value){
 static const int INITIAL_MEMORY_LATENCY = 5;
 static const int MEMORY_LATENCY = 0;
 
+// ============================================================================
+// Memory model
+
+// Without a memory model every master gets one beat per cycle, independently of the others (the ideal model, using the latencies above).
+// With a memory model, reads and writes have a channel each, like the MuxNative joining the databus masters. Channels issue at most one burst per cycle, picking requesting masters in round robin, and keep up to maxOutstanding bursts in flight. Bursts wait their latency in parallel but transfer data in issue order, sharing the bandwidth given by cyclesPerBeat.
+
+#define MAX_OUTSTANDING 16
+#define MAX_BANKS 64
+
+struct MemoryChannel{
+   int master[MAX_OUTSTANDING]; // Issue order, first is the one transferring data
+   int latency[MAX_OUTSTANDING];
+   int size;
+   int lastIssued;
+};
+
+static VersatMemoryModel memoryModel = {};
+static MemoryChannel memoryChannels[2]; // Read and write
+static iptr openRow[MAX_BANKS];
+static int beatWait; // Cycles until the shared data bus can transfer again
+static int lastDataChannel;
+
+static void ResetMemoryModel(){
+  for(MemoryChannel& channel : memoryChannels){
+    channel.size = 0;
+  }
+  beatWait = 0;
+}
+
+static int IssueLatency(iptr address){
+  VersatMemoryModel* m = &memoryModel;
+  int latency = m->burstLatency;
+
+  if(m->banks > 0 && m->rowBytes > 0){
+    int banks = (m->banks < MAX_BANKS ? m->banks : MAX_BANKS);
+    iptr rowIndex = address / m->rowBytes;
+    int bank = (int) (rowIndex % banks);
+    iptr row = rowIndex / banks;
+
+    if(openRow[bank] == row){
+      latency += m->rowHitLatency;
+    } else {
+      latency += m->rowMissLatency;
+      openRow[bank] = row;
+    }
+  }
+
+  return latency;
+}
+
+static void SimulateMemoryModel(DatabusRequest* requests,int amount){
+  for(int i = 0; i < amount; i++){
+    databusBuffer[i].beatAllowed = false;
+  }
+
+  if(!memoryModel.enabled){
+    for(int i = 0; i < amount; i++){
+      DatabusAccess* access = &databusBuffer[i];
+      if(!requests[i].valid){
+        continue;
+      }
+
+      if(access->latencyCounter > 0){
+        access->latencyCounter -= 1;
+      } else {
+        access->beatAllowed = true;
+        access->latencyCounter = MEMORY_LATENCY;
+      }
+    }
+    return;
+  }
+
+  int maxOutstanding = memoryModel.maxOutstanding;
+  maxOutstanding = (maxOutstanding < 1 ? 1 : (maxOutstanding > MAX_OUTSTANDING ? MAX_OUTSTANDING : maxOutstanding));
+
+  bool dataReady[2] = {};
+  for(int c = 0; c < 2; c++){
+    MemoryChannel* channel = &memoryChannels[c];
+    bool isWrite = (c == 1);
+
+    // Bursts already in flight keep counting
+    for(int q = 0; q < channel->size; q++){
+      if(channel->latency[q] > 0){
+        channel->latency[q] -= 1;
+      }
+    }
+
+    if(channel->size < maxOutstanding){
+      for(int k = 1; k <= amount; k++){
+        int m = (channel->lastIssued + k) % amount;
+        DatabusRequest req = requests[m];
+        if(!req.valid || req.write != isWrite){
+          continue;
+        }
+
+        bool inFlight = false;
+        for(int q = 0; q < channel->size; q++){
+          inFlight |= (channel->master[q] == m);
+        }
+        if(inFlight){
+          continue;
+        }
+
+        channel->master[channel->size] = m;
+        channel->latency[channel->size] = IssueLatency(req.address);
+        channel->size += 1;
+        channel->lastIssued = m;
+        break;
+      }
+    }
+
+    dataReady[c] = (channel->size > 0 && channel->latency[0] == 0 && requests[channel->master[0]].valid);
+  }
+
+  if(beatWait > 0){
+    beatWait -= 1;
+    return;
+  }
+
+  bool granted = false;
+  if(memoryModel.halfDuplex){
+    // A single data bus, alternate between reads and writes when both are ready
+    int first = 1 - lastDataChannel;
+    for(int k = 0; k < 2; k++){
+      int c = (first + k) % 2;
+      if(dataReady[c]){
+        databusBuffer[memoryChannels[c].master[0]].beatAllowed = true;
+        lastDataChannel = c;
+        granted = true;
+        break;
+      }
+    }
+  } else {
+    for(int c = 0; c < 2; c++){
+      if(dataReady[c]){
+        databusBuffer[memoryChannels[c].master[0]].beatAllowed = true;
+        granted = true;
+      }
+    }
+  }
+
+  if(granted && memoryModel.cyclesPerBeat > 1){
+    beatWait = memoryModel.cyclesPerBeat - 1;
+  }
+}
+
+static void MemoryModelBurstDone(int master){
+  if(!memoryModel.enabled){
+    return;
+  }
+
+  for(MemoryChannel& channel : memoryChannels){
+    if(channel.size > 0 && channel.master[0] == master){
+      for(int q = 1; q < channel.size; q++){
+        channel.master[q - 1] = channel.master[q];
+        channel.latency[q - 1] = channel.latency[q];
+      }
+      channel.size -= 1;
+      return;
+    }
+  }
+}
+
 typedef char Byte;
 
 // Everything is statically allocated
@@ -154,12 +409,130 @@ extern "C" void InitializeVerilator(){
 #endif
 }
 
+#ifdef TRACE_FST
+#define TRACE_EXTENSION "fst"
+#else
+#define TRACE_EXTENSION "vcd"
+#endif
+
+#ifdef TRACE
+// The ring buffer splits the waveform into segments of ringCycles cycles with openNext. Only the file opened first has the header, the segments after it are data only and are named by Verilator with a four digit counter.
+static void RingSegmentName(char* buffer,int size,int segment){
+  if(segment == 0){
+    snprintf(buffer,size,"system." TRACE_EXTENSION);
+  } else {
+    snprintf(buffer,size,"system_cat%04d." TRACE_EXTENSION,(segment - 1) % 10000);
+  }
+}
+#endif
+
 static void CloseWaveform(){
+  // Exiting in the middle of an asynchronous run, let it finish before closing the file it is writing
+  if(simThread && simThread->get_id() != std::this_thread::get_id()){
+    simThread->join();
+    delete simThread;
+    simThread = NULL;
+  }
+
 #ifdef TRACE
   if(CreateVCD && tfp){
     tfp->close();
+
+    TraceControl* t = &traceControl;
+    if(t->ringCycles > 0 && t->ringSegment > 0){
+      char last[64];
+      RingSegmentName(last,sizeof(last),t->ringSegment);
+
+      // Before the second rotation the older segment is the first file
+      if(t->ringSegment > 1){
+        char previous[64];
+        RingSegmentName(previous,sizeof(previous),t->ringSegment - 1);
+        PRINT("Last traced cycles are in %s followed by %s, append them to system." TRACE_EXTENSION " which holds the header\n",previous,last);
+      } else {
+        PRINT("Last traced cycles are in system." TRACE_EXTENSION " followed by %s\n",last);
+      }
+    }
+  }
+#endif
+}
+
+// Only the VCD writer supports openNext, ConfigTraceRing does not enable the ring buffer for FST
+#if defined(TRACE) && !defined(TRACE_FST)
+// The first file is kept for its header. Otherwise only the last two segments are kept, which always contain the last ringCycles cycles at least.
+static void OpenRingSegment(){
+  TraceControl* t = &traceControl;
+
+  tfp->openNext(true);
+
+  t->ringSegment += 1;
+  t->ringSegmentCycles = 0;
+
+  if(t->ringSegment >= 3){
+    char filename[64];
+    RingSegmentName(filename,sizeof(filename),t->ringSegment - 2);
+    remove(filename);
+  }
+}
+#endif
+
+static bool TraceTriggerHolds(V@{typeName}* self){
+  TraceControl* t = &traceControl;
+  long long value = TraceSignalRead(self,t->triggerSignal);
+
+  switch(t->triggerCompare){
+  case TraceCompare_NOT_ZERO: return value != 0;
+  case TraceCompare_EQUAL: return value == t->triggerValue;
+  case TraceCompare_DIFFERENT: return value != t->triggerValue;
+  case TraceCompare_LESS: return value < t->triggerValue;
+  case TraceCompare_LESS_EQUAL: return value <= t->triggerValue;
+  case TraceCompare_GREATER: return value > t->triggerValue;
+  case TraceCompare_GREATER_EQUAL: return value >= t->triggerValue;
+  }
+  return false;
+}
+
+// Called when the accelerator state changes. Only new cycles count towards the ring buffer segments
+static void UpdateTraceState(bool newCycle){
+#ifdef TRACE
+  bool canTrace = (CreateVCD && tfp);
+#else
+  bool canTrace = false;
+#endif
+
+  if(!canTrace){
+    traceDumping = false;
+    return;
+  }
+
+  TraceControl* t = &traceControl;
+
+  int cycle = cyclesDone;
+  int run = runsStarted - 1;
+
+  bool dump = (cycle >= t->startCycle && (t->endCycle < 0 || cycle < t->endCycle));
+  if(t->runWindow){
+    dump = dump && (run >= t->startRun && (t->endRun < 0 || run < t->endRun));
+  }
+
+  if(dump && t->triggerSignal >= 0){
+    if(t->triggeredAt < 0 && TraceTriggerHolds(dut)){
+      t->triggeredAt = cycle;
+      PRINT("Trace trigger fired at cycle %d\n",cycle);
+    }
+
+    dump = (t->triggeredAt >= 0 && (t->triggerCycles < 0 || cycle < t->triggeredAt + t->triggerCycles));
+  }
+
+#if defined(TRACE) && !defined(TRACE_FST)
+  if(dump && newCycle && t->ringCycles > 0){
+    if(t->ringSegmentCycles >= t->ringCycles){
+      OpenRingSegment();
+    }
+    t->ringSegmentCycles += 1;
   }
 #endif
+
+  traceDumping = dump;
 }
 
 static void FillMemoryWithGarbage(){
@@ -202,6 +575,7 @@ extern "C" void VersatAcceleratorCreate(){
 
     atexit(CloseWaveform);
   }
+  UpdateTraceState(false);
 #endif
 
   self->run = 0;
@@ -216,19 +590,18 @@ extern "C" void VersatAcceleratorCreate(){
    self->rst = 0;
 
 #ifdef TRACE
-   if(CreateVCD) tfp->dump(contextp->time());
+   if(traceDumping) tfp->dump(contextp->time());
    contextp->timeInc(1);
-   if(CreateVCD) tfp->dump(contextp->time());
+   if(traceDumping) tfp->dump(contextp->time());
    contextp->timeInc(1);
 #endif
 }
 
-static int cyclesDone = 0;
-
 static void InternalUpdateAccelerator(){
    int baseAddress = 0;
 
    cyclesDone += 1;
+   UpdateTraceState(true);
 
    int sizeOfData = (@{databusDataSize} / 8);
 
@@ -237,6 +610,19 @@ static void InternalUpdateAccelerator(){
    // Databus must be updated before memories because databus could drive memories but memories "cannot" drive databus (in the sense that databus acts like a master if connected directly to memories but memories do not act like a master when connected to a databus. The unit logic is the one that acts like a master)
 
 @{databusSim}
+
+   profile.cyclesSinceLastReset += 1;
+   if(self->running){
+      profile.runningCycles += 1;
+   }
+
+   {
+      bool anyValid = false;
+      bool anyReady = false;
+@{databusProfile}
+      profile.databusValid += (anyValid ? 1 : 0);
+      profile.databusValidAndReady += (anyValid && anyReady ? 1 : 0);
+   }
    
    baseAddress = 0;
 
@@ -264,7 +650,7 @@ static void InternalUpdateAccelerator(){
 }
 
 #ifdef TRACE
-   if(CreateVCD) tfp->dump(contextp->time());
+   if(traceDumping) tfp->dump(contextp->time());
    contextp->timeInc(2);
 #endif
 
@@ -293,13 +679,39 @@ Once operator+(_OnceTag t,F&& f){
 @{declareExtraConfigs}
 
 extern "C" void VersatReset(){
+  FirmwareAccess access;
   FillMemoryWithGarbage();
   @{resetExtraConfigs}
 }
 
+// Config writes go directly to memory in pc-emul, so configurations set are counted as the config words that changed since the last check
+static void ProfileConfigurationChanges(bool running){
+  // Asynchronous runs end in the simulation thread while the firmware might be writing a config, like the registers in hardware
+  volatile iptr* config = (volatile iptr*) &configBuffer;
+
+  for(int i = 0; i < (int) (sizeof(configSnapshot) / sizeof(iptr)); i++){
+    if(config[i] != configSnapshot[i]){
+      profile.configurationsSet += 1;
+      if(running){
+        profile.configurationsSetWhileRunning += 1;
+      }
+      configSnapshot[i] = config[i];
+    }
+  }
+}
+
 static void InternalStartAccelerator(){
   V@{typeName}* self = dut;
 
+  runsStarted += 1;
+  UpdateTraceState(false);
+
+  profile.runCount += 1;
+  ProfileConfigurationChanges(false);
+
+  // Runs only end after every burst finishes, nothing is in flight. Open rows are kept
+  ResetMemoryModel();
+
 @{internalStart}
 
   self->run = 1;
@@ -308,9 +720,9 @@ static void InternalStartAccelerator(){
   self->run = 0;
 
 #ifdef TRACE
-  if(CreateVCD) tfp->dump(contextp->time());
+  if(traceDumping) tfp->dump(contextp->time());
   contextp->timeInc(1);
-  if(CreateVCD) tfp->dump(contextp->time());
+  if(traceDumping) tfp->dump(contextp->time());
   contextp->timeInc(1);
 #endif
 }
@@ -318,6 +730,9 @@ static void InternalStartAccelerator(){
 static void InternalEndAccelerator(){
   V@{typeName}* self = dut;
 
+  // Anything that changed since the start was written while the accelerator was running
+  ProfileConfigurationChanges(true);
+
   self->running = 0;
 
   // TODO: Is this update call needed?
@@ -327,18 +742,14 @@ static void InternalEndAccelerator(){
 }
 
 extern "C" int VersatAcceleratorCyclesElapsed(){
+  FirmwareAccess access;
   return cyclesDone;
 }
 
 void SimulateVUnits();
 
-extern "C" void VersatAcceleratorSimulate(){
-  InternalStartAccelerator();
-
-  if(debugging){
-    SimulateVUnits();
-  }
-
+// Must hold simMutex
+static void SimulateUntilDone(){
   for(int i = 0; !IsDone() ; i++){
     InternalUpdateAccelerator();
 
@@ -349,12 +760,66 @@ extern "C" void VersatAcceleratorSimulate(){
       fflush(stdout);
       exit(-1);
     }   
+
+    // Only happens in asynchronous runs. The firmware access takes place in between this cycle and the next
+    if(firmwareWaiting > 0){
+      simMutex.unlock();
+      while(firmwareWaiting > 0){
+        std::this_thread::yield();
+      }
+      simMutex.lock();
+    }
+  }
+}
+
+extern "C" void VersatAcceleratorSimulate(){
+  std::lock_guard<std::mutex> guard(simMutex);
+
+  InternalStartAccelerator();
+
+  if(debugging){
+    SimulateVUnits();
   }
 
+  SimulateUntilDone();
+
+  InternalEndAccelerator();
+}
+
+static void SimulationThread(){
+  std::lock_guard<std::mutex> guard(simMutex);
+
+  SimulateUntilDone();
   InternalEndAccelerator();
 }
 
+extern "C" void VersatAcceleratorWait(){
+  if(simThread){
+    simThread->join();
+    delete simThread;
+    simThread = NULL;
+  }
+}
+
+// The run is started by the caller so that the config is copied into the model before returning
+extern "C" void VersatAcceleratorStartAsync(){
+  VersatAcceleratorWait();
+
+  {
+    std::lock_guard<std::mutex> guard(simMutex);
+
+    InternalStartAccelerator();
+
+    if(debugging){
+      SimulateVUnits();
+    }
+  }
+
+  simThread = new std::thread(SimulationThread);
+}
+
 extern "C" int MemoryAccess(int address,int value,int write){
+  FirmwareAccess access;
   V@{typeName}* self = dut;
 
 @{memoryAccessDefines}
@@ -415,6 +880,7 @@ extern "C" int MemoryAccess(int address,int value,int write){
 }
 
 extern "C" void VersatSignalLoop(){
+   FirmwareAccess access;
    V@{typeName}* self = dut;
 
 #ifdef SIGNAL_LOOP
@@ -426,6 +892,7 @@ extern "C" void VersatSignalLoop(){
 }
 
 extern "C" void VersatLoadDelay(volatile const unsigned int* delayBuffer){
+  FirmwareAccess access;
   V@{typeName}* self = dut;
 
 @{setDelays}
@@ -452,7 +919,119 @@ iptr SimulateAddressPosition(iptr start_address,iptr amount_minus_one,iptr lengt
   return 0;
 }
 
-SimulateVReadResult SimulateVRead(AddressVArguments args){
+// Native model of the address side of SuperAddress, with the same inputs that the Verilator path drives (no delay, no ignore first, always ready).
+// Calls Store with the address (in DATA_W units) of every cycle where store_o is asserted, in the same order as the hardware.
+// Widths must match the parameters used to verilate SuperAddress: ADDR_W=32, DATA_W=32 and the default PERIOD_W.
+#define SUPER_ADDRESS_OFFSET_W 2
+#define SUPER_ADDRESS_PERIOD_MASK ((1 << 10) - 1)
+
+template<typename StoreFunction>
+static void ForEachSuperAddressStore(AddressVArguments args,StoreFunction Store){
+   uint32_t duty = args.duty & SUPER_ADDRESS_PERIOD_MASK;
+   uint32_t perI = args.per & SUPER_ADDRESS_PERIOD_MASK;
+   uint32_t per2I = args.per2 & SUPER_ADDRESS_PERIOD_MASK;
+   uint32_t per3I = args.per3 & SUPER_ADDRESS_PERIOD_MASK;
+   uint32_t iterI = (uint32_t) args.iter;
+   uint32_t iter2I = (uint32_t) args.iter2;
+   uint32_t iter3I = (uint32_t) args.iter3;
+
+   uint32_t incr = (uint32_t) args.incr << SUPER_ADDRESS_OFFSET_W;
+   uint32_t shift = (uint32_t) args.shift << SUPER_ADDRESS_OFFSET_W;
+   uint32_t incr2 = (uint32_t) args.incr2 << SUPER_ADDRESS_OFFSET_W;
+   uint32_t shift2 = (uint32_t) args.shift2 << SUPER_ADDRESS_OFFSET_W;
+   uint32_t incr3 = (uint32_t) args.incr3 << SUPER_ADDRESS_OFFSET_W;
+   uint32_t shift3 = (uint32_t) args.shift3 << SUPER_ADDRESS_OFFSET_W;
+
+   uint32_t addr = (uint32_t) args.start << SUPER_ADDRESS_OFFSET_W;
+   uint32_t addr2 = addr;
+   uint32_t addr3 = addr;
+   uint32_t per = 0,per2 = 0,per3 = 0;
+   uint32_t iter = 0,iter2 = 0,iter3 = 0;
+
+   while(1){
+      if(per < duty){
+        Store((iptr) (addr / 4));
+      }
+
+      bool perCond = ((per + 1) == perI || perI == 0);
+      bool iterCond = ((iter + 1) == iterI || iterI == 0);
+      bool per2Cond = ((per2 + 1) == per2I || per2I == 0);
+      bool iter2Cond = ((iter2 + 1) == iter2I || iter2I == 0);
+      bool per3Cond = ((per3 + 1) == per3I || per3I == 0);
+      bool iter3Cond = ((iter3 + 1) == iter3I || iter3I == 0);
+
+      if(!perCond){
+        if(per < duty){
+          addr += incr;
+        }
+        per = (per + 1) & SUPER_ADDRESS_PERIOD_MASK;
+      } else if(!iterCond){
+        addr += shift;
+        per = 0;
+        iter += 1;
+      } else if(!per2Cond){
+        addr2 += incr2;
+        addr = addr2;
+        per = iter = 0;
+        per2 = (per2 + 1) & SUPER_ADDRESS_PERIOD_MASK;
+      } else if(!iter2Cond){
+        addr2 += shift2;
+        addr = addr2;
+        per = iter = per2 = 0;
+        iter2 += 1;
+      } else if(!per3Cond){
+        addr3 += incr3;
+        addr = addr2 = addr3;
+        per = iter = per2 = iter2 = 0;
+        per3 = (per3 + 1) & SUPER_ADDRESS_PERIOD_MASK;
+      } else if(!iter3Cond){
+        addr3 += shift3;
+        addr = addr2 = addr3;
+        per = iter = per2 = iter2 = per3 = 0;
+        iter3 += 1;
+      } else {
+        break;
+      }
+   }
+}
+
+static SimulateVReadResult NativeSimulateVRead(AddressVArguments args){
+   SimulateVReadResult result = {};
+
+   result.amountOfExternalValuesRead = ((args.length) / sizeof(float)) * (args.amount_minus_one + 1);
+
+   bool* seen = (bool*) calloc(result.amountOfExternalValuesRead,sizeof(bool));
+   ForEachSuperAddressStore(args,[&](iptr addr){
+      if(addr < result.amountOfExternalValuesRead){
+        seen[addr] = true;
+      }
+   });
+
+   int amountSeen = 0;
+   for(int i = 0; i < result.amountOfExternalValuesRead; i++){
+      if(seen[i]){
+         amountSeen += 1;
+      }
+   }
+
+   free(seen);
+   result.amountOfInternalValuesUsed = amountSeen;
+
+   return result;
+}
+
+static int NativeSimulateAddressGen(iptr* arrayToFill,int arraySize,AddressVArguments args){
+   int arrayIndex = 0;
+   ForEachSuperAddressStore(args,[&](iptr addr){
+      if(arrayIndex < arraySize){
+        arrayToFill[arrayIndex++] = SimulateAddressPosition(args.ext_addr,args.amount_minus_one,args.length,args.addr_shift,addr);
+      }
+   });
+
+   return arrayIndex;
+}
+
+static SimulateVReadResult VerilatorSimulateVRead(AddressVArguments args){
    SimulateVReadResult result = {};
 
    result.amountOfExternalValuesRead = ((args.length) / sizeof(float)) * (args.amount_minus_one + 1);
@@ -581,7 +1160,7 @@ end:
    return result;
 }
 
-int SimulateAddressGen(iptr* arrayToFill,int arraySize,AddressVArguments args){
+static int VerilatorSimulateAddressGen(iptr* arrayToFill,int arraySize,AddressVArguments args){
    static VSuperAddress* self = nullptr;
 
    Verilated::traceEverOn(true);
@@ -693,7 +1272,7 @@ end:
    return arrayIndex;
 }
 
-void SimulateAndPrintAddressGen(AddressVArguments args){
+static void VerilatorSimulateAndPrintAddressGen(AddressVArguments args){
    static VSuperAddress* self = nullptr;
 
    Verilated::traceEverOn(true);
@@ -811,6 +1390,58 @@ end:
    tfp->close();
 }
 
+SimulateVReadResult SimulateVRead(AddressVArguments args){
+   SimulateVReadResult result = NativeSimulateVRead(args);
+
+   if(CrossCheckAddressGen){
+      SimulateVReadResult expected = VerilatorSimulateVRead(args);
+      if(expected.amountOfExternalValuesRead != result.amountOfExternalValuesRead || expected.amountOfInternalValuesUsed != result.amountOfInternalValuesUsed){
+         PRINT("SimulateVRead mismatch. Native: %d %d Verilator: %d %d\n",result.amountOfExternalValuesRead,result.amountOfInternalValuesUsed,expected.amountOfExternalValuesRead,expected.amountOfInternalValuesUsed);
+      }
+      return expected;
+   }
+
+   return result;
+}
+
+int SimulateAddressGen(iptr* arrayToFill,int arraySize,AddressVArguments args){
+   int amount = NativeSimulateAddressGen(arrayToFill,arraySize,args);
+
+   if(CrossCheckAddressGen){
+      iptr* expected = (iptr*) calloc(arraySize,sizeof(iptr));
+      int expectedAmount = VerilatorSimulateAddressGen(expected,arraySize,args);
+
+      bool equal = (amount == expectedAmount);
+      for(int i = 0; equal && i < amount; i++){
+         equal = (arrayToFill[i] == expected[i]);
+      }
+      if(!equal){
+         PRINT("SimulateAddressGen mismatch between native and Verilator simulation\n");
+         memcpy(arrayToFill,expected,sizeof(iptr) * expectedAmount);
+         amount = expectedAmount;
+      }
+
+      free(expected);
+   }
+
+   return amount;
+}
+
+void SimulateAndPrintAddressGen(AddressVArguments args){
+   // The Verilator path also dumps the waveform of the unit to simulate.vcd
+   if(CrossCheckAddressGen){
+      VerilatorSimulateAndPrintAddressGen(args);
+      return;
+   }
+
+   int totalIndex = 0;
+   PRINT("LoopIndex : Index of position being accessed\n");
+   ForEachSuperAddressStore(args,[&](iptr addr){
+      iptr address = SimulateAddressPosition(args.ext_addr,args.amount_minus_one,args.length,args.addr_shift,addr);
+      PRINT("%d : %ld\n",totalIndex++,(address - args.ext_addr) / 4);
+   });
+}
+
 #undef UPDATE
 
 struct VUnitInfo{
@@ -875,6 +1506,8 @@ void VersatReset();
 void InitializeVerilator();
 void VersatAcceleratorCreate();
 void VersatAcceleratorSimulate();
+void VersatAcceleratorStartAsync();
+void VersatAcceleratorWait();
 void VersatSignalLoop();
 int MemoryAccess(int address,int value,int write);
 
@@ -891,10 +1524,120 @@ void ConfigCreateVCD(bool value){
   CreateVCD = value;
 }
 
+void ConfigAsyncAccelerator(bool value){
+  VersatAcceleratorWait();
+  asyncAccelerator = value;
+}
+
+void ConfigTraceCycles(int start,int end){
+  traceControl.startCycle = start;
+  traceControl.endCycle = end;
+}
+
+void ConfigTraceRuns(int first,int end){
+  traceControl.runWindow = true;
+  traceControl.startRun = first;
+  traceControl.endRun = end;
+}
+
+bool ConfigTraceTrigger(const char* expression,int cycles){
+  char name[128] = {};
+  char op[3] = {};
+  long long value = 0;
+
+  int matched = sscanf(expression," %127[A-Za-z0-9_] %2[=!<>] %lli",name,op,&value);
+
+  TraceCompare compare = TraceCompare_NOT_ZERO;
+  if(matched == 3){
+    if(strcmp(op,"==") == 0){
+      compare = TraceCompare_EQUAL;
+    } else if(strcmp(op,"!=") == 0){
+      compare = TraceCompare_DIFFERENT;
+    } else if(strcmp(op,"<") == 0){
+      compare = TraceCompare_LESS;
+    } else if(strcmp(op,"<=") == 0){
+      compare = TraceCompare_LESS_EQUAL;
+    } else if(strcmp(op,">") == 0){
+      compare = TraceCompare_GREATER;
+    } else if(strcmp(op,">=") == 0){
+      compare = TraceCompare_GREATER_EQUAL;
+    } else {
+      PRINT("Trace trigger: unknown operator '%s' in '%s'\n",op,expression);
+      return false;
+    }
+  } else if(matched != 1){
+    PRINT("Trace trigger: expected 'signal' or 'signal op value', got '%s'\n",expression);
+    return false;
+  }
+
+  int signal = -1;
+  for(int i = 0; i < (int) ARRAY_SIZE(traceSignalNames); i++){
+    if(strcmp(traceSignalNames[i],name) == 0){
+      signal = i;
+      break;
+    }
+  }
+
+  if(signal < 0){
+    PRINT("Trace trigger: '%s' is not a top level signal. Available signals:\n",name);
+    for(const char* available : traceSignalNames){
+      PRINT("  %s\n",available);
+    }
+    return false;
+  }
+
+  traceControl.triggerSignal = signal;
+  traceControl.triggerCompare = compare;
+  traceControl.triggerValue = value;
+  traceControl.triggerCycles = cycles;
+  traceControl.triggeredAt = -1;
+
+  return true;
+}
+
+void ConfigTraceRing(int cycles){
+#ifdef TRACE_FST
+  // Splitting the waveform with openNext is only supported by the VCD writer
+  PRINT("Trace ring buffer requires VCD output, tracing every cycle instead\n");
+  return;
+#endif
+
+  // The current segment starts over, segments already written are kept
+  traceControl.ringCycles = (cycles > 0 ? cycles : 0);
+  traceControl.ringSegmentCycles = 0;
+}
+
 void ConfigSimulateDatabus(bool value){
   SimulateDatabus = value;
 }
 
+void ConfigCrossCheckAddressGen(bool value){
+  CrossCheckAddressGen = value;
+}
+
+void ConfigMemoryModel(VersatMemoryModel model){
+  memoryModel = model;
+  ResetMemoryModel();
+
+  for(iptr& row : openRow){
+    row = -1;
+  }
+}
+
+VersatMemoryModel VersatTypicalMemoryModel(){
+  VersatMemoryModel model = {};
+  model.enabled = true;
+  model.burstLatency = 20;
+  model.cyclesPerBeat = 1;
+  model.maxOutstanding = 4;
+  model.halfDuplex = true;
+  model.banks = 8;
+  model.rowBytes = 2048;
+  model.rowHitLatency = 0;
+  model.rowMissLatency = 10;
+  return model;
+}
+
 void versat_init(int base){
   versatInitialized = true;
   CreateVCD = true;
@@ -922,6 +1665,7 @@ static void CheckVersatInitialized(){
 }
 
 void ResetAccelerator(){
+  VersatAcceleratorWait();
   VersatReset();
   VersatLoadDelay(delayBuffer);
 }
@@ -937,6 +1681,7 @@ int GetAcceleratorCyclesElapsed(){
 void RunAccelerator(int times){
   CheckVersatInitialized();
 
+  VersatAcceleratorWait();
   for(int i = 0; i < times; i++){
     VersatAcceleratorSimulate();
   }
@@ -945,11 +1690,164 @@ void RunAccelerator(int times){
 void StartAccelerator(){
   CheckVersatInitialized();
 
-  VersatAcceleratorSimulate();
+  if(asyncAccelerator){
+    VersatAcceleratorStartAsync();
+  } else {
+    VersatAcceleratorSimulate();
+  }
 }
 
 void EndAccelerator(){
-  // Do nothing. Start accelerator does everything, for now
+  // Only asynchronous runs can still be running, otherwise start accelerator does everything
+  VersatAcceleratorWait();
+}
+
+// ======================================
+// Batch runs
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define MAX_BATCH_WORKERS 256
+
+static int batchWorkers = 0;
+
+void ConfigBatchWorkers(int workers){
+  batchWorkers = workers;
+}
+
+// Written by the worker processes, lives in memory shared with the caller
+struct BatchResult{
+  @{typeName}State state;
+  int cycles;
+  VersatProfile profile; // Counters added by the run
+  VersatDatabusProfile databusProfile[@{nIOs}];
+  bool done;
+};
+
+static void AddProfile(VersatProfile* profile,VersatProfile other){
+  profile->runCount += other.runCount;
+  profile->cyclesSinceLastReset += other.cyclesSinceLastReset;
+  profile->runningCycles += other.runningCycles;
+  profile->databusValid += other.databusValid;
+  profile->databusValidAndReady += other.databusValidAndReady;
+  profile->configurationsSet += other.configurationsSet;
+  profile->configurationsSetWhileRunning += other.configurationsSetWhileRunning;
+}
+
+static void AddDatabusProfile(VersatDatabusProfile* profile,VersatDatabusProfile other){
+  profile->databusValid += other.databusValid;
+  profile->databusValidAndReady += other.databusValidAndReady;
+  profile->bytesTransferred += other.bytesTransferred;
+}
+
+static void RunBatchEntry(const @{typeName}Config* config,@{typeName}State* state){
+  configBuffer = *config;
+  VersatAcceleratorSimulate();
+  *state = stateBuffer;
+}
+
+// Every worker is a fork of the whole simulation (model, buffers and memories) taken at the call, which is what keeps the runs independent without the wrapper having to be reentrant.
+// Multithreaded models run the batch in the calling process instead, the Verilator thread pool does not survive a fork. Which path is taken must not change the results, hence the precondition in the header.
+// Workers return the states, cycles and profile counters of their runs. Like embedded, the accelerator ends with the configuration of the last run.
+void VersatRunBatch(const @{typeName}Config* configs,@{typeName}State* states,int amount){
+  CheckVersatInitialized();
+
+  VersatAcceleratorWait(); // Forking with the simulation thread running would copy the model mid cycle
+
+  if(amount <= 0){
+    return;
+  }
+
+  int workers = batchWorkers;
+  if(workers <= 0){
+    workers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+  }
+  if(workers > amount){
+    workers = amount;
+  }
+  if(workers > MAX_BATCH_WORKERS){
+    workers = MAX_BATCH_WORKERS;
+  }
+
+  size_t resultsSize = sizeof(BatchResult) * amount;
+  BatchResult* results = NULL;
+  if(workers > 1 && dut->contextp()->threads() <= 1){
+    void* mem = mmap(NULL,resultsSize,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_ANONYMOUS,-1,0);
+    if(mem != MAP_FAILED){
+      results = (BatchResult*) mem;
+    }
+  }
+
+  if(!results){
+    for(int i = 0; i < amount; i++){
+      RunBatchEntry(&configs[i],&states[i]);
+    }
+    return;
+  }
+
+  // Otherwise buffered output would be printed by every worker
+  fflush(stdout);
+  fflush(stderr);
+
+  pid_t pids[MAX_BATCH_WORKERS];
+  for(int w = 0; w < workers; w++){
+    pids[w] = fork();
+
+    if(pids[w] == 0){
+      CreateVCD = false; // Waveforms belong to the caller
+
+      for(int i = w; i < amount; i += workers){
+        BatchResult* res = &results[i];
+        int start = cyclesDone;
+
+        // Counters of the worker are not used after it exits, they only count the run
+        profile = (VersatProfile){};
+        for(VersatDatabusProfile& d : databusProfile){
+          d = (VersatDatabusProfile){};
+        }
+
+        RunBatchEntry(&configs[i],&res->state);
+
+        res->cycles = cyclesDone - start;
+        res->profile = profile;
+        for(int k = 0; k < @{nIOs}; k++){
+          res->databusProfile[k] = databusProfile[k];
+        }
+        res->done = true;
+      }
+
+      fflush(stdout);
+      _exit(0); // Skip atexit handlers, the caller still owns everything else
+    }
+  }
+
+  for(int w = 0; w < workers; w++){
+    if(pids[w] > 0){
+      waitpid(pids[w],NULL,0);
+    }
+  }
+
+  for(int i = 0; i < amount; i++){
+    if(results[i].done){
+      states[i] = results[i].state;
+      cyclesDone += results[i].cycles;
+      AddProfile(&profile,results[i].profile);
+      for(int k = 0; k < @{nIOs}; k++){
+        AddDatabusProfile(&databusProfile[k],results[i].databusProfile[k]);
+      }
+    } else {
+      // Worker could not be forked or died before reaching this run
+      RunBatchEntry(&configs[i],&states[i]);
+    }
+  }
+
+  munmap(results,resultsSize);
+
+  // The last run already counted its configuration changes
+  configBuffer = configs[amount - 1];
+  memcpy(configSnapshot,&configBuffer,sizeof(configSnapshot));
 }
 
 void VersatMemoryCopy(volatile void* dest,volatile const void* data,int size){
@@ -1010,14 +1908,108 @@ VersatDebugState VersatDebugGetState(){
 }
 
 VersatProfile VersatProfileGet(){
-  return (VersatProfile){};
+  FirmwareAccess access;
+  return profile;
+}
+
+int VersatProfileDatabusInterfaces(){
+  return @{nIOs};
+}
+
+VersatDatabusProfile VersatProfileGetDatabus(int index){
+  if(index < 0 || index >= @{nIOs}){
+    return (VersatDatabusProfile){};
+  }
+
+  FirmwareAccess access;
+  VersatDatabusProfile res = databusProfile[index];
+  res.unitName = databusOwnerNames[index];
+  return res;
+}
+
+// 0 to 100
+static unsigned long long Percentage(uint64_t smaller,uint64_t bigger){
+  if(bigger == 0){
+    return 0;
+  }
+
+  return (unsigned long long) ((smaller * 100) / bigger);
 }
 
 void VersatPrintProfile(VersatProfile p){
+  PRINT("Runs profiled:%llu\n",(unsigned long long) p.runCount);
+  PRINT("Total cycles:%llu\n",(unsigned long long) p.cyclesSinceLastReset);
+  PRINT("  Cycles with accelerator running: %llu (%llu%%)\n",(unsigned long long) p.runningCycles,
+        Percentage(p.runningCycles,p.cyclesSinceLastReset));
+  PRINT("    Cycles databus valid: %llu (%llu%%)\n",(unsigned long long) p.databusValid,
+        Percentage(p.databusValid,p.runningCycles));
+  PRINT("    Cycles databus valid and ready: %llu (%llu%%)\n",(unsigned long long) p.databusValidAndReady,
+        Percentage(p.databusValidAndReady,p.runningCycles));
+  PRINT("      Databus efficiency: %llu%%\n",
+        Percentage(p.databusValidAndReady,p.databusValid));
+
+  // Per unit breakdown always reflects the current counters
+  for(int i = 0; i < VersatProfileDatabusInterfaces(); i++){
+    VersatDatabusProfile d = VersatProfileGetDatabus(i);
+    PRINT("      %s: valid %llu, valid and ready %llu (%llu%% efficiency), %llu bytes\n",d.unitName,
+          (unsigned long long) d.databusValid,(unsigned long long) d.databusValidAndReady,
+          Percentage(d.databusValidAndReady,d.databusValid),(unsigned long long) d.bytesTransferred);
+  }
+
+  PRINT("Configurations set: %llu\n",(unsigned long long) p.configurationsSet);
+  PRINT("  Configurations set while accel running: %llu\n",
+        (unsigned long long) p.configurationsSetWhileRunning);
+  PRINT("  Configurations efficiency: %llu%%\n",
+        Percentage(p.configurationsSetWhileRunning,p.configurationsSet));
 }
 
 void VersatProfileReset(){
-
+  FirmwareAccess access;
+  profile = (VersatProfile){};
+  for(VersatDatabusProfile& d : databusProfile){
+    d = (VersatDatabusProfile){};
+  }
 }
 
-#endif
\ No newline at end of file
+#endif
+
+#ifdef VERSAT_BENCHMARK
+#include <chrono>
+
+// Built by the benchmark target of the generated makefile. Keeps the accelerator running with the default configuration and reports how fast the model simulates, without any firmware overhead.
+int main(int argc,const char* argv[]){
+  int cycles = 1000000;
+  if(argc > 1){
+    cycles = atoi(argv[1]);
+  }
+
+  versatInitialized = true;
+  InitializeVerilator();
+  VersatAcceleratorCreate();
+  VersatLoadDelay(delayBuffer);
+
+  int runs = 0;
+  int startCycles = cyclesDone;
+  auto start = std::chrono::steady_clock::now();
+  while(cyclesDone - startCycles < cycles){
+    InternalStartAccelerator();
+    while(!IsDone() && cyclesDone - startCycles < cycles){
+      InternalUpdateAccelerator();
+    }
+    InternalEndAccelerator();
+    runs += 1;
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  int simulated = cyclesDone - startCycles;
+  double seconds = std::chrono::duration<double>(end - start).count();
+  printf("Simulated %d cycles (%d runs) in %.3f seconds: %.0f cycles per second\n",simulated,runs,seconds,simulated / seconds);
+
+  // Verilator writes the profile of --prof-pgo builds when the model is finalized
+  dut->final();
+  delete dut;
+  dut = NULL;
+
+  return 0;
+}
+#endif // VERSAT_BENCHMARK
\ No newline at end of file